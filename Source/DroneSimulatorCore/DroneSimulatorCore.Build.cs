@@ -6,7 +6,7 @@ public class DroneSimulatorCore : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "DroneSimulatorPhysics" });
 
 		var bWithDroneInput = true;
 		if (bWithDroneInput)
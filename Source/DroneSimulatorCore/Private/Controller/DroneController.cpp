@@ -5,3 +5,28 @@ FPropellerSetThrottle UDroneController::tick_controller(float delta_time, const
 {
 	return FPropellerSetThrottle { 0.0, 0.0, 0.0, 0.0 };
 }
+
+physics::FRotorSetThrottle UDroneController::tick_controller_rotors(float delta_time, const FDroneSetpoint& setpoint,
+	const FVector& current_angular_velocity, const physics::FMixerMatrix& mixer)
+{
+	physics::FRotorSetThrottle throttle;
+	throttle.count = mixer.count;
+	return throttle;
+}
+
+void UDroneController::prepare_substep(const physics::FSubstepBody& substep_body, const FDronePlayerInput& player_input,
+	bool is_armed, double simulation_time)
+{
+}
+
+void UDroneController::hash_state(physics::FStateHasher& hasher) const
+{
+}
+
+void UDroneController::save_state(physics::FDroneSimulationSnapshot& snapshot) const
+{
+}
+
+void UDroneController::restore_state(const physics::FDroneSimulationSnapshot& snapshot)
+{
+}
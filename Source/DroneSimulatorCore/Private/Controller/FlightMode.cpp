@@ -19,3 +19,11 @@ FDroneSetpoint UFlightModeBase::compute_setpoint(const FDronePlayerInput& player
 {
     return FDroneSetpoint(0.0, FVector::ZeroVector);
 }
+
+void UFlightModeBase::save_state(physics::FDroneSimulationSnapshot& snapshot) const
+{
+}
+
+void UFlightModeBase::restore_state(const physics::FDroneSimulationSnapshot& snapshot)
+{
+}
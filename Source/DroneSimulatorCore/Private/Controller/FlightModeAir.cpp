@@ -1,4 +1,5 @@
 #include "DroneSimulatorCore/Public/Controller/FlightModeAir.h"
+#include "DroneSimulatorCore/Public/Simulation/PhysicsConversion.h"
 
 
 ECameraTiltMode UFlightModeAir::get_camera_tilt_mode() const
@@ -13,11 +14,12 @@ EThrottleCalibrationSpace UFlightModeAir::get_throttle_calibration_space() const
 
 FDroneSetpoint UFlightModeAir::compute_setpoint(const FDronePlayerInput& player_input, const FFlightModeState& flight_state)
 {
-    const auto desired_angular_velocity = FVector(
-        player_input.roll * -FMath::DegreesToRadians(this->roll_rate_deg_per_second), // Roll stick right = Input.Roll >0 = drone rotates clockwise = rotator roll >0
-        player_input.pitch * -FMath::DegreesToRadians(this->pitch_rate_deg_per_second), // Pitch stick up = Input.Pitch >0 = look down = rotator pitch <0
-        player_input.yaw * FMath::DegreesToRadians(this->yaw_rate_deg_per_second) // Yaw stick right = Input.Yaw >0 = look right = rotator yaw >0
-    );
+    const auto flight_mode = physics::FFlightModeAir {
+        this->roll_rate_deg_per_second,
+        this->pitch_rate_deg_per_second,
+        this->yaw_rate_deg_per_second
+    };
 
-    return FDroneSetpoint(player_input.throttle, desired_angular_velocity);
+    const auto setpoint = physics::flight_mode::compute_air_setpoint(flight_mode, physics_conversion::to_physics(player_input));
+    return physics_conversion::to_unreal(setpoint);
 }
@@ -0,0 +1,109 @@
+﻿#include "DroneSimulatorCore/Public/Controller/SitlDroneController.h"
+#include "DroneSimulatorCore/Public/Simulation/PhysicsConversion.h"
+#include "DroneSimulatorCore/Private/DroneSimulatorCore.h"
+
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+
+
+FPropellerSetThrottle USitlDroneController::tick_controller(float delta_time, const FDroneSetpoint& setpoint, const FVector& current_angular_velocity)
+{
+	static const auto quad_x_mixer = physics::mixer::make_quad_x();
+	const auto throttle = this->tick_controller_rotors(delta_time, setpoint, current_angular_velocity, quad_x_mixer);
+
+	return physics_conversion::to_unreal(throttle.to_propeller_set());
+}
+
+physics::FRotorSetThrottle USitlDroneController::tick_controller_rotors(float delta_time, const FDroneSetpoint& setpoint,
+	const FVector& current_angular_velocity, const physics::FMixerMatrix& mixer)
+{
+	physics::FRotorSetThrottle stopped_throttle;
+	stopped_throttle.count = mixer.count;
+
+	if (!this->open_bridge())
+	{
+		return stopped_throttle;
+	}
+
+	// The sensors were filled in place by prepare_substep
+	const auto* motors = this->bridge.exchange();
+	if (this->bridge.is_connected() != this->was_connected)
+	{
+		this->was_connected = this->bridge.is_connected();
+		if (this->was_connected)
+		{
+			UE_LOG(LogDroneSimulator, Log, TEXT("SITL firmware answered again, motors resumed"));
+		}
+		else
+		{
+			UE_LOG(LogDroneSimulator, Warning, TEXT("SITL firmware didn't answer within %.3f s, motors stopped until it answers again"), this->timeout_seconds);
+		}
+	}
+
+	if (motors == nullptr)
+	{
+		return stopped_throttle;
+	}
+
+	return physics::sitl::get_rotor_throttle(*motors, mixer.count);
+}
+
+void USitlDroneController::prepare_substep(const physics::FSubstepBody& substep_body, const FDronePlayerInput& player_input,
+	bool is_armed, double simulation_time)
+{
+	if (!this->open_bridge())
+	{
+		return;
+	}
+
+	const auto elapsed_time = simulation_time - this->last_simulation_time;
+	const auto linear_acceleration_world = this->has_last_sample && elapsed_time > 0.0
+		? (substep_body.linear_velocity_world - this->last_linear_velocity_world) / elapsed_time
+		: physics::FVector3::zero();
+
+	this->last_linear_velocity_world = substep_body.linear_velocity_world;
+	this->last_simulation_time = simulation_time;
+	this->has_last_sample = true;
+
+	physics::sitl::fill_sensor_packet(this->bridge.get_sensor_packet(), substep_body, linear_acceleration_world,
+		physics_conversion::to_physics(player_input), is_armed, simulation_time);
+}
+
+double USitlDroneController::get_mean_round_trip_microseconds() const
+{
+	return this->get_round_trip_stats().get_mean_seconds() * 1e6;
+}
+
+double USitlDroneController::get_max_round_trip_microseconds() const
+{
+	return this->get_round_trip_stats().max_seconds * 1e6;
+}
+
+bool USitlDroneController::open_bridge()
+{
+	if (this->bridge.is_open())
+	{
+		return true;
+	}
+
+	if (this->has_failed_to_open)
+	{
+		return false;
+	}
+
+	physics::FSitlBridgeConfig config;
+	config.transport = this->transport == ESitlTransportType::SharedMemory ? physics::ESitlTransport::shared_memory : physics::ESitlTransport::udp;
+	config.address = TCHAR_TO_UTF8(*this->address);
+	config.sensor_port = static_cast<uint16>(this->sensor_port);
+	config.motor_port = static_cast<uint16>(this->motor_port);
+	config.shared_memory_name = TCHAR_TO_UTF8(*this->shared_memory_name);
+	config.timeout_seconds = this->timeout_seconds;
+
+	if (!this->bridge.open(config))
+	{
+		UE_LOG(LogDroneSimulator, Error, TEXT("Could not open the SITL bridge"));
+		this->has_failed_to_open = true;
+		return false;
+	}
+
+	return true;
+}
@@ -1,15 +1,22 @@
 #include "DroneSimulatorCore/Public/PropulsionModel/PropulsionModel.h"
 
 
-FPropulsionDroneSetup::FPropulsionDroneSetup(const FDroneFrame* in_frame, const FDroneMotor* in_motor,
-    const FDroneBattery* in_battery, const TDronePropeller* in_propeller)
-    : frame(in_frame), motor(in_motor), battery(in_battery), propeller(in_propeller)
+TOptional<physics::FDynamicsPropellerSetInfo> UPropulsionModel::tick_propulsion(double delta_time, physics::FSubstepBody* substep_body,
+    const FDroneSetpoint& drone_setpoint, const physics::FPropulsionDroneSetup& drone_setup,
+    const physics::FSimulationWorld* simulation_world, const physics::FSubstepStages& stages,
+    const physics::FVector3* gyro_angular_velocity)
 {
+    return {};
 }
 
-TOptional<FDynamicsPropellerSetInfo> UPropulsionModel::tick_propulsion(double delta_time, FSubstepBody* substep_body,
-    const FDroneSetpoint& drone_setpoint, const FPropulsionDroneSetup& drone_setup,
-    const USimulationWorld* simulation_world)
+void UPropulsionModel::hash_state(physics::FStateHasher& hasher) const
+{
+}
+
+void UPropulsionModel::save_state(physics::FDroneSimulationSnapshot& snapshot) const
+{
+}
+
+void UPropulsionModel::restore_state(const physics::FDroneSimulationSnapshot& snapshot)
 {
-    return {};
 }
@@ -1,58 +1,72 @@
-
-
 #include "DroneSimulatorCore/Public/PropulsionModel/PropulsionModelDynamics.h"
 #include "DroneSimulatorCore/Public/Controller/DroneController.h"
 #include "DroneSimulatorCore/Public/RotorModel/RotorModelBase.h"
-#include "DroneSimulatorCore/Public/Simulation/SubstepBody.h"
+#include "DroneSimulatorCore/Public/Simulation/PhysicsConversion.h"
+
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSnapshot.h"
+#include "DroneSimulatorPhysics/Public/Simulation/MultiRateSchedule.h"
+#include "DroneSimulatorPhysics/Public/Simulation/StateHash.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
 
-TOptional<FDynamicsPropellerSetInfo> UPropulsionModelDynamics::tick_propulsion(double delta_time,
-    FSubstepBody* substep_body, const FDroneSetpoint& drone_setpoint, const FPropulsionDroneSetup& drone_setup,
-    const USimulationWorld* simulation_world)
+TOptional<physics::FDynamicsPropellerSetInfo> UPropulsionModelDynamics::tick_propulsion(double delta_time,
+    physics::FSubstepBody* substep_body, const FDroneSetpoint& drone_setpoint, const physics::FPropulsionDroneSetup& drone_setup,
+    const physics::FSimulationWorld* simulation_world, const physics::FSubstepStages& stages,
+    const physics::FVector3* gyro_angular_velocity)
 {
     if (!drone_controller || !rotor_model)
     {
         return {};
     }
 
-    const auto component_angular_velocity = substep_body->transform_world.GetRotation().Inverse().RotateVector(substep_body->angular_velocity_radians_world);
-
-    const auto propeller_set_throttle = drone_controller->tick_controller(delta_time, drone_setpoint, component_angular_velocity);
-
-    const auto* propeller = drone_setup.propeller;
-    const auto* motor = drone_setup.motor;
-    const auto* battery = drone_setup.battery;
-    const auto* frame = drone_setup.frame;
-
-    const auto front_left_throttle = propeller_set_throttle.front_left;
-    const auto front_right_throttle = propeller_set_throttle.front_right;
-    const auto rear_left_throttle = propeller_set_throttle.rear_left;
-    const auto rear_right_throttle = propeller_set_throttle.rear_right;
-
-    // Extents are distances; normalize signs so front is +X and back is -X. In unreal units
-    const FVector props_extent_front = frame->props_extent_front.GetAbs();
-    const FVector props_extent_back = frame->props_extent_back.GetAbs();
-
-	// In unreal units
-    const FVector front_left_location(props_extent_front.X, -props_extent_front.Y, props_extent_front.Z);
-    const FVector front_right_location(props_extent_front.X, props_extent_front.Y, props_extent_front.Z);
-    const FVector rear_left_location(-props_extent_back.X, -props_extent_back.Y, props_extent_back.Z);
-    const FVector rear_right_location(-props_extent_back.X, props_extent_back.Y, props_extent_back.Z);
-
-    const auto result_front_left = rotor_model->simulate_propeller_rotor(substep_body, front_left_throttle, propeller,
-        motor, battery, front_left_location, true, simulation_world);
-    const auto result_front_right = rotor_model->simulate_propeller_rotor(substep_body, front_right_throttle, propeller,
-        motor, battery, front_right_location, false, simulation_world);
-    const auto result_rear_left = rotor_model->simulate_propeller_rotor(substep_body, rear_left_throttle, propeller,
-        motor, battery, rear_left_location, false, simulation_world);
-    const auto result_rear_right = rotor_model->simulate_propeller_rotor(substep_body, rear_right_throttle, propeller,
-        motor, battery, rear_right_location, true, simulation_world);
-
-    TOptional<FDynamicsPropellerSetInfo> return_data = {};
-    if (result_front_left.additional_data.IsSet() && result_front_right.additional_data.IsSet()
-        && result_rear_left.additional_data.IsSet() && result_rear_right.additional_data.IsSet())
+    // The controller and rotor model are UObjects, so that they can be edited inline. The sequence is shared with
+    // physics::propulsion::tick_dynamics, which runs it without Unreal
+    const auto result = physics::propulsion::tick_rotors(this->held_outputs, substep_body, drone_setup, stages,
+        gyro_angular_velocity,
+        [&](double controller_delta_time, const physics::FVector3& component_angular_velocity, const physics::FMixerMatrix& mixer)
+        {
+            return drone_controller->tick_controller_rotors(controller_delta_time, drone_setpoint,
+                physics_conversion::to_unreal(component_angular_velocity), mixer);
+        },
+        [&](double throttle, const physics::FRotorDescription& rotor)
+        {
+            return rotor_model->simulate_propeller_rotor(substep_body, throttle, drone_setup.propeller, drone_setup.motor,
+                drone_setup.battery, rotor, simulation_world);
+        });
+
+    if (!result.has_value())
     {
-        // TODO
+        return {};
     }
 
-    return return_data;
+    return *result;
+}
+
+void UPropulsionModelDynamics::hash_state(physics::FStateHasher& hasher) const
+{
+    hasher.add(this->held_outputs);
+
+    if (drone_controller)
+    {
+        drone_controller->hash_state(hasher);
+    }
+}
+
+void UPropulsionModelDynamics::save_state(physics::FDroneSimulationSnapshot& snapshot) const
+{
+    snapshot.propulsion_held_outputs = this->held_outputs;
+
+    if (drone_controller)
+    {
+        drone_controller->save_state(snapshot);
+    }
+}
+
+void UPropulsionModelDynamics::restore_state(const physics::FDroneSimulationSnapshot& snapshot)
+{
+    this->held_outputs = snapshot.propulsion_held_outputs;
+
+    if (drone_controller)
+    {
+        drone_controller->restore_state(snapshot);
+    }
 }
@@ -1,6 +1,6 @@
 ﻿#if WITH_DEV_AUTOMATION_TESTS
 
-#include "DroneSimulatorCore/Public/RotorModel/Bemt/PropellerThrust.h"
+#include "DroneSimulatorCore/Public/RotorModel/Bemt/ComputePropellerThrust.h"
 #include "DroneSimulatorCore/Public/Simulation/Math.h"
 
 #include "Runtime/Core/Public/Misc/AutomationTest.h"
@@ -1,12 +1,13 @@
 #include "DroneSimulatorCore/Public/RotorModel/RotorModelBase.h"
 
-FRotorSimulationResult URotorModelBase::simulate_propeller_rotor(FSubstepBody* substep_body, double throttle,
-    const TDronePropeller* propeller, const FDroneMotor* motor, const FDroneBattery* battery,
-    const FVector& propeller_location_local, bool is_clockwise, const USimulationWorld* simulation_world)
+physics::FRotorSimulationResult URotorModelBase::simulate_propeller_rotor(physics::FSubstepBody* substep_body, double throttle,
+    const physics::FDronePropeller* propeller, const physics::FDroneMotor* motor, const physics::FDroneBattery* battery,
+    const physics::FRotorDescription& rotor, const physics::FSimulationWorld* simulation_world)
 {
-    return FRotorSimulationResult(
-        FThrustSimValue(),
-        {},
-        FDebugLog()
-    );
+    return physics::FRotorSimulationResult();
+}
+
+TOptional<physics::FRotorModel> URotorModelBase::get_physics_rotor_model() const
+{
+    return TOptional<physics::FRotorModel>();
 }
@@ -1,7 +1,7 @@
 #if WITH_DEV_AUTOMATION_TESTS
 
 #include "DroneSimulatorCore/Public/Simulation/Math.h"
-#include "DroneSimulatorCore/Public/RotorModel/Bemt/PropellerThrust.h"
+#include "DroneSimulatorCore/Public/RotorModel/Bemt/ComputePropellerThrust.h"
 #include "Runtime/Core/Public/Misc/AutomationTest.h"
 
 BEGIN_DEFINE_SPEC(FMathSpec, "DroneSimulator.Math", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
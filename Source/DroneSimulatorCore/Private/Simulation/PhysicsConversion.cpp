@@ -0,0 +1,216 @@
+#include "DroneSimulatorCore/Public/Simulation/PhysicsConversion.h"
+
+#include "Utils/Variant.h"
+#include "PhysicsEngine/BodyInstance.h"
+
+physics::FVector3 physics_conversion::to_physics(const FVector& vector)
+{
+	return physics::FVector3(vector.X, vector.Y, vector.Z);
+}
+
+FVector physics_conversion::to_unreal(const physics::FVector3& vector)
+{
+	return FVector(vector.X, vector.Y, vector.Z);
+}
+
+physics::FQuaternion physics_conversion::to_physics(const FQuat& quaternion)
+{
+	return physics::FQuaternion(quaternion.X, quaternion.Y, quaternion.Z, quaternion.W);
+}
+
+FQuat physics_conversion::to_unreal(const physics::FQuaternion& quaternion)
+{
+	return FQuat(quaternion.X, quaternion.Y, quaternion.Z, quaternion.W);
+}
+
+physics::FRotation physics_conversion::to_physics(const FRotator& rotator)
+{
+	return physics::FRotation(rotator.Pitch, rotator.Yaw, rotator.Roll);
+}
+
+FRotator physics_conversion::to_unreal(const physics::FRotation& rotation)
+{
+	return FRotator(rotation.Pitch, rotation.Yaw, rotation.Roll);
+}
+
+physics::FRigidTransform physics_conversion::to_physics(const FTransform& transform)
+{
+	return physics::FRigidTransform(to_physics(transform.GetRotation()), to_physics(transform.GetLocation()));
+}
+
+FTransform physics_conversion::to_unreal(const physics::FRigidTransform& transform)
+{
+	return FTransform(to_unreal(transform.rotation), to_unreal(transform.location));
+}
+
+physics::FDroneAirfoil physics_conversion::to_physics(const FDroneAirfoil& airfoil)
+{
+	if (airfoil.HasSubtype<FDroneAirfoilTable>())
+	{
+		const auto& table = airfoil.GetSubtype<FDroneAirfoilTable>();
+
+		physics::FDroneAirfoilTable physics_table;
+		physics_table.reynolds_numbers.assign(table.reynolds_numbers.GetData(), table.reynolds_numbers.GetData() + table.reynolds_numbers.Num());
+		physics_table.reynolds_entries.reserve(table.reynolds_entries.Num());
+
+		for (const auto& entry : table.reynolds_entries)
+		{
+			physics::FDroneAirfoilTable::FReynoldsEntry physics_entry;
+			physics_entry.angles_of_attack.assign(entry.angles_of_attack.GetData(), entry.angles_of_attack.GetData() + entry.angles_of_attack.Num());
+			physics_entry.lift_coefficients.assign(entry.lift_coefficients.GetData(), entry.lift_coefficients.GetData() + entry.lift_coefficients.Num());
+			physics_entry.drag_coefficients.assign(entry.drag_coefficients.GetData(), entry.drag_coefficients.GetData() + entry.drag_coefficients.Num());
+			physics_table.reynolds_entries.push_back(MoveTemp(physics_entry));
+		}
+
+		return physics_table;
+	}
+
+	if (airfoil.HasSubtype<FDroneAirfoilSimplified>())
+	{
+		const auto& simplified = airfoil.GetSubtype<FDroneAirfoilSimplified>();
+		return physics::FDroneAirfoilSimplified { simplified.cl_k_rad, simplified.cd_0, simplified.cd_k };
+	}
+
+	return std::monostate();
+}
+
+physics::FDronePropellerBemt physics_conversion::to_physics(const FDronePropellerBemt& propeller)
+{
+	physics::FDronePropellerBemt physics_propeller;
+	physics_propeller.num_blades = propeller.num_blades;
+	physics_propeller.radius = propeller.radius;
+	physics_propeller.hub_radius = propeller.hub_radius;
+	physics_propeller.chord = propeller.chord;
+	physics_propeller.pitch = propeller.pitch;
+	physics_propeller.airfoil = to_physics(propeller.airfoil);
+	return physics_propeller;
+}
+
+physics::FDronePropeller physics_conversion::to_physics(const TDronePropeller& propeller)
+{
+	return match_variant(
+		propeller,
+
+		[](const FDronePropellerBemt& prop_bemt) -> physics::FDronePropeller
+		{
+			return to_physics(prop_bemt);
+		},
+
+		[](const FDronePropellerSimplified& prop_simplified) -> physics::FDronePropeller
+		{
+			return physics::FDronePropellerSimplified {
+				prop_simplified.blade_diameter,
+				prop_simplified.thrust_coefficient,
+				prop_simplified.torque_coefficient
+			};
+		}
+	);
+}
+
+physics::FRotorDescription physics_conversion::to_physics(const FRotorDescription& rotor)
+{
+	// The axis is typed in the editor, it may not be unit length
+	return physics::FRotorDescription {
+		to_physics(rotor.location),
+		to_physics(rotor.thrust_axis.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector)),
+		rotor.is_clockwise
+	};
+}
+
+physics::FDroneFrame physics_conversion::to_physics(const FDroneFrame& frame)
+{
+	auto result = physics::FDroneFrame {
+		to_physics(frame.props_extent_front),
+		to_physics(frame.props_extent_back),
+		to_physics(frame.drag_coefficient),
+		to_physics(frame.area),
+		frame.mass
+	};
+
+	result.rotors.reserve(frame.rotors.Num());
+	for (const auto& rotor : frame.rotors)
+	{
+		result.rotors.push_back(to_physics(rotor));
+	}
+
+	return result;
+}
+
+physics::FDroneMotor physics_conversion::to_physics(const FDroneMotor& motor)
+{
+	return physics::FDroneMotor { motor.kv, motor.mass };
+}
+
+physics::FDroneBattery physics_conversion::to_physics(const FDroneBattery& battery)
+{
+	return physics::FDroneBattery { battery.voltage, battery.mass };
+}
+
+physics::FDroneSetpoint physics_conversion::to_physics(const FDroneSetpoint& setpoint)
+{
+	return physics::FDroneSetpoint { setpoint.throttle, to_physics(setpoint.angular_velocity_radians) };
+}
+
+FDroneSetpoint physics_conversion::to_unreal(const physics::FDroneSetpoint& setpoint)
+{
+	return FDroneSetpoint(setpoint.throttle, to_unreal(setpoint.angular_velocity_radians));
+}
+
+physics::FPropellerSetThrottle physics_conversion::to_physics(const FPropellerSetThrottle& throttle)
+{
+	return physics::FPropellerSetThrottle(throttle.front_left, throttle.front_right, throttle.rear_left, throttle.rear_right);
+}
+
+FPropellerSetThrottle physics_conversion::to_unreal(const physics::FPropellerSetThrottle& throttle)
+{
+	return FPropellerSetThrottle(throttle.front_left, throttle.front_right, throttle.rear_left, throttle.rear_right);
+}
+
+physics::FDronePlayerInput physics_conversion::to_physics(const FDronePlayerInput& player_input)
+{
+	return physics::FDronePlayerInput { player_input.throttle, player_input.yaw, player_input.pitch, player_input.roll };
+}
+
+FDronePlayerInput physics_conversion::to_unreal(const physics::FDronePlayerInput& player_input)
+{
+	FDronePlayerInput unreal_player_input;
+	unreal_player_input.throttle = player_input.throttle;
+	unreal_player_input.yaw = player_input.yaw;
+	unreal_player_input.pitch = player_input.pitch;
+	unreal_player_input.roll = player_input.roll;
+	return unreal_player_input;
+}
+
+physics::FFlightModeState physics_conversion::to_physics(const FFlightModeState& flight_state)
+{
+	physics::FFlightModeState physics_flight_state;
+	physics_flight_state.linear_velocity_world = to_physics(flight_state.linear_velocity_world);
+	physics_flight_state.angular_velocity_world = to_physics(flight_state.angular_velocity_world);
+	physics_flight_state.rotation = to_physics(flight_state.rotation);
+	physics_flight_state.delta_time = flight_state.delta_time;
+	return physics_flight_state;
+}
+
+FDebugLog physics_conversion::to_unreal(const physics::FDebugLog& debug_log)
+{
+	FDebugLog unreal_debug_log;
+	unreal_debug_log.logs.Reserve(debug_log.logs.size());
+	for (const auto& log : debug_log.logs)
+	{
+		unreal_debug_log.logs.Add(UTF8_TO_TCHAR(log.c_str()));
+	}
+	return unreal_debug_log;
+}
+
+physics::FSubstepBody physics_conversion::substep_body_from_body_instance(const FBodyInstance* body_instance)
+{
+	const auto transform = body_instance->GetUnrealWorldTransform();
+	return physics::FSubstepBody(
+		to_physics(transform.GetLocation()),
+		to_physics(transform.GetRotation()),
+		body_instance->GetBodyMass(),
+		to_physics(body_instance->GetBodyInertiaTensor() / 10000.0),
+		to_physics(body_instance->GetUnrealWorldVelocity() / 100.0),
+		to_physics(body_instance->GetUnrealWorldAngularVelocityInRadians())
+	);
+}
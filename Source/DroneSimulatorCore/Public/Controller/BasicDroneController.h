@@ -2,6 +2,8 @@
 
 #include "DroneSimulatorCore/Public/Controller/DroneController.h"
 
+#include "DroneSimulatorPhysics/Public/Controller/DroneController.h"
+
 #include "BasicDroneController.generated.h"
 
 struct FDroneSetpoint;
@@ -27,4 +29,9 @@ public:
 
 	virtual FPropellerSetThrottle tick_controller(float delta_time, const FDroneSetpoint& setpoint, const FVector& current_angular_velocity) override;
 
+	virtual physics::FRotorSetThrottle tick_controller_rotors(float delta_time, const FDroneSetpoint& setpoint,
+		const FVector& current_angular_velocity, const physics::FMixerMatrix& mixer) override;
+
+	physics::FBasicDroneController get_physics_controller() const;
+
 };
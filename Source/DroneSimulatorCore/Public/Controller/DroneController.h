@@ -4,10 +4,20 @@
 
 #include "DroneSimulatorCore/Public/Controller/Throttle.h"
 
+#include "DroneSimulatorPhysics/Public/Controller/Mixer.h"
+
 #include "DroneController.generated.h"
 
+struct FDronePlayerInput;
 struct FDroneSetpoint;
 
+namespace physics
+{
+	struct FDroneSimulationSnapshot;
+	struct FStateHasher;
+	struct FSubstepBody;
+}
+
 UCLASS(Abstract, EditInlineNew, DefaultToInstanced)
 class UDroneController : public UObject
 {
@@ -19,4 +29,29 @@ public:
 	 */
 	UFUNCTION()
 	virtual FPropellerSetThrottle tick_controller(float delta_time, const FDroneSetpoint& setpoint, const FVector& current_angular_velocity);
+
+	/**
+	 * Same as tick_controller, for any number of rotors
+	 *
+	 * @param mixer Allocation of the roll, pitch and yaw commands to the rotors of the frame
+	 */
+	virtual physics::FRotorSetThrottle tick_controller_rotors(float delta_time, const FDroneSetpoint& setpoint,
+		const FVector& current_angular_velocity, const physics::FMixerMatrix& mixer);
+
+	/**
+	 * Called on every substep before the propulsion, for controllers that read the pilot input and the body themselves
+	 * instead of the setpoint, like flight controller firmware. Does nothing by default.
+	 *
+	 * @param simulation_time Start time of the substep, in seconds
+	 */
+	virtual void prepare_substep(const physics::FSubstepBody& substep_body, const FDronePlayerInput& player_input, bool is_armed,
+		double simulation_time);
+
+	// Adds the state carried from one substep to the next, for the deterministic mode
+	virtual void hash_state(physics::FStateHasher& hasher) const;
+
+	// Saves and restores the state carried from one substep to the next, see physics::FDroneSimulationSnapshot
+	virtual void save_state(physics::FDroneSimulationSnapshot& snapshot) const;
+
+	virtual void restore_state(const physics::FDroneSimulationSnapshot& snapshot);
 };
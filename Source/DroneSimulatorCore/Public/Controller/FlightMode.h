@@ -9,6 +9,11 @@
 
 #include "FlightMode.generated.h"
 
+namespace physics
+{
+    struct FDroneSimulationSnapshot;
+}
+
 USTRUCT(BlueprintType)
 struct FFlightModeState
 {
@@ -66,4 +71,9 @@ public:
      * @param player_input Input of the player controller, typically via the remote controller
      */
     virtual FDroneSetpoint compute_setpoint(const FDronePlayerInput& player_input, const FFlightModeState& flight_state);
+
+    // Saves and restores the state carried from one tick to the next, see physics::FDroneSimulationSnapshot
+    virtual void save_state(physics::FDroneSimulationSnapshot& snapshot) const;
+
+    virtual void restore_state(const physics::FDroneSimulationSnapshot& snapshot);
 };
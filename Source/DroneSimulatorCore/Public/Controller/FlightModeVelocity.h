@@ -2,6 +2,8 @@
 
 #include "DroneSimulatorCore/Public/Controller/FlightMode.h"
 
+#include "DroneSimulatorPhysics/Public/Controller/FlightMode.h"
+
 #include "FlightModeVelocity.generated.h"
 
 /**
@@ -22,7 +24,7 @@
  * This provides very stable, GPS-like flight behavior with altitude hold.
  */
 UCLASS(BlueprintType)
-class UFlightModeVelocity : public UFlightModeBase
+class DRONESIMULATORCORE_API UFlightModeVelocity : public UFlightModeBase
 {
     GENERATED_BODY()
 
@@ -86,13 +88,17 @@ public:
 
     virtual FDroneSetpoint compute_setpoint(const FDronePlayerInput& player_input, const FFlightModeState& flight_state) override;
 
-private:
-    // PI state (integral terms) for horizontal velocity
-    double velocity_x_integral = 0.0;
-    double velocity_y_integral = 0.0;
+    virtual void save_state(physics::FDroneSimulationSnapshot& snapshot) const override;
+
+    virtual void restore_state(const physics::FDroneSimulationSnapshot& snapshot) override;
 
-    // PID state for vertical velocity
-    double vertical_velocity_integral = 0.0;
-    double prev_vertical_velocity_error = 0.0;
+    physics::FFlightModeVelocityConfig get_physics_config() const;
+
+    // Sets the limits and the gains, for example from the auto-tuner. The integral terms are kept.
+    void set_physics_config(const physics::FFlightModeVelocityConfig& config);
+
+private:
+    // Integral and derivative terms, carried from one tick to the next
+    physics::FFlightModeVelocityState state;
 };
 
@@ -2,6 +2,8 @@
 
 #include "DroneSimulatorCore/Public/Controller/DroneController.h"
 
+#include "DroneSimulatorPhysics/Public/Controller/DroneController.h"
+
 #include "PidDroneController.generated.h"
 
 struct FDronePlayerInput;
@@ -24,7 +26,7 @@ public:
 };
 
 UCLASS()
-class UPidDroneController : public UDroneController
+class DRONESIMULATORCORE_API UPidDroneController : public UDroneController
 {
 	GENERATED_BODY()
 
@@ -47,14 +49,25 @@ public:
 
 protected:
 
-	UPROPERTY()
-	FVector last_angular_velocity_error;
-
-	UPROPERTY()
-	FVector integrated_angular_velocity_error;
+	// Error terms carried from one substep to the next
+	physics::FPidDroneControllerState state;
 
 public:
 
 	virtual FPropellerSetThrottle tick_controller(float delta_time, const FDroneSetpoint& setpoint, const FVector& current_angular_velocity) override;
 
+	virtual physics::FRotorSetThrottle tick_controller_rotors(float delta_time, const FDroneSetpoint& setpoint,
+		const FVector& current_angular_velocity, const physics::FMixerMatrix& mixer) override;
+
+	virtual void hash_state(physics::FStateHasher& hasher) const override;
+
+	virtual void save_state(physics::FDroneSimulationSnapshot& snapshot) const override;
+
+	virtual void restore_state(const physics::FDroneSimulationSnapshot& snapshot) override;
+
+	physics::FPidDroneControllerConfig get_physics_config() const;
+
+	// Sets the throttle limits and the gains, for example from the auto-tuner. The error terms are kept.
+	void set_physics_config(const physics::FPidDroneControllerConfig& config);
+
 };
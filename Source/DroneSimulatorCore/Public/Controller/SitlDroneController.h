@@ -0,0 +1,89 @@
+﻿#pragma once
+
+#include "DroneSimulatorCore/Public/Controller/DroneController.h"
+
+#include "DroneSimulatorPhysics/Public/Controller/SitlBridge.h"
+
+#include "SitlDroneController.generated.h"
+
+UENUM(BlueprintType)
+enum class ESitlTransportType : uint8
+{
+	Udp UMETA(DisplayName="UDP"),
+	SharedMemory UMETA(DisplayName="Shared memory"),
+};
+
+/**
+ * Flies flight controller firmware running as a native SITL process (Betaflight, PX4) on the same machine, see
+ * physics::FSitlBridge. Each run of the controller sends the IMU and the RC channels, then waits for the motor outputs
+ * of the firmware: the simulation and the firmware advance in lockstep.
+ *
+ * The firmware runs its own flight modes, so the setpoint is ignored and the sticks are sent as they are. Its state is
+ * in the other process, so it is neither hashed nor restored with the snapshots.
+ */
+UCLASS()
+class DRONESIMULATORCORE_API USitlDroneController : public UDroneController
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category="SITL")
+	ESitlTransportType transport = ESitlTransportType::Udp;
+
+	// Address of the firmware
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category="SITL", meta=(EditCondition="transport == ESitlTransportType::Udp"))
+	FString address = TEXT("127.0.0.1");
+
+	// The firmware receives the sensors on this port
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category="SITL", meta=(EditCondition="transport == ESitlTransportType::Udp"))
+	int32 sensor_port = 9003;
+
+	// The simulation receives the motors on this port
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category="SITL", meta=(EditCondition="transport == ESitlTransportType::Udp"))
+	int32 motor_port = 9002;
+
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category="SITL", meta=(EditCondition="transport == ESitlTransportType::SharedMemory"))
+	FString shared_memory_name = TEXT("drone_sitl");
+
+	// How long a substep waits for the firmware. The motors stop when it doesn't answer in time, and the next substeps don't
+	// wait until it answers again.
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category="SITL", meta=(Units="Seconds"))
+	double timeout_seconds = 0.005;
+
+	virtual FPropellerSetThrottle tick_controller(float delta_time, const FDroneSetpoint& setpoint, const FVector& current_angular_velocity) override;
+
+	virtual physics::FRotorSetThrottle tick_controller_rotors(float delta_time, const FDroneSetpoint& setpoint,
+		const FVector& current_angular_velocity, const physics::FMixerMatrix& mixer) override;
+
+	virtual void prepare_substep(const physics::FSubstepBody& substep_body, const FDronePlayerInput& player_input, bool is_armed,
+		double simulation_time) override;
+
+	// Time from sending the sensors to receiving the motors, over the exchanges so far
+	UFUNCTION(BlueprintCallable, Category="SITL")
+	double get_mean_round_trip_microseconds() const;
+
+	UFUNCTION(BlueprintCallable, Category="SITL")
+	double get_max_round_trip_microseconds() const;
+
+	const physics::FSitlRoundTripStats& get_round_trip_stats() const { return this->bridge.get_round_trip_stats(); }
+
+private:
+
+	// Opens the bridge on the first substep. A bridge that could not be opened isn't retried.
+	bool open_bridge();
+
+	physics::FSitlBridge bridge;
+
+	bool has_failed_to_open = false;
+
+	// Last connection state logged, the log follows the changes rather than each substep
+	bool was_connected = true;
+
+	// The body doesn't hold its acceleration, the accelerometer is the velocity change since the last substep
+	physics::FVector3 last_linear_velocity_world = physics::FVector3::zero();
+
+	double last_simulation_time = 0.0;
+
+	bool has_last_sample = false;
+};
@@ -18,7 +18,8 @@ public:
     UPROPERTY(EditAnywhere, meta=(DisplayName="Max vertical speed (m/s)"))
     double max_vertical_speed = 30.0;
 
-    virtual TOptional<FDynamicsPropellerSetInfo> tick_propulsion(double delta_time, FSubstepBody* substep_body,
-        const FDroneSetpoint& drone_setpoint, const FPropulsionDroneSetup& drone_setup,
-        const USimulationWorld* simulation_world);
+    virtual TOptional<physics::FDynamicsPropellerSetInfo> tick_propulsion(double delta_time, physics::FSubstepBody* substep_body,
+        const FDroneSetpoint& drone_setpoint, const physics::FPropulsionDroneSetup& drone_setup,
+        const physics::FSimulationWorld* simulation_world, const physics::FSubstepStages& stages,
+        const physics::FVector3* gyro_angular_velocity);
 };
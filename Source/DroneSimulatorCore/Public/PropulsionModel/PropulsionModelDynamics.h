@@ -8,7 +8,7 @@ class URotorModelBase;
 class UDroneController;
 
 UCLASS()
-class UPropulsionModelDynamics : public UPropulsionModel
+class DRONESIMULATORCORE_API UPropulsionModelDynamics : public UPropulsionModel
 {
     GENERATED_BODY()
 
@@ -20,7 +20,21 @@ public:
     UPROPERTY(Instanced, EditAnywhere, BlueprintReadOnly, Category="Drone", meta=(DisplayName="Rotor model"))
     URotorModelBase* rotor_model;
 
-    virtual TOptional<FDynamicsPropellerSetInfo> tick_propulsion(double delta_time, FSubstepBody* substep_body,
-        const FDroneSetpoint& drone_setpoint, const FPropulsionDroneSetup& drone_setup,
-        const USimulationWorld* simulation_world) override;
+    virtual TOptional<physics::FDynamicsPropellerSetInfo> tick_propulsion(double delta_time, physics::FSubstepBody* substep_body,
+        const FDroneSetpoint& drone_setpoint, const physics::FPropulsionDroneSetup& drone_setup,
+        const physics::FSimulationWorld* simulation_world, const physics::FSubstepStages& stages,
+        const physics::FVector3* gyro_angular_velocity) override;
+
+    virtual void hash_state(physics::FStateHasher& hasher) const override;
+
+    virtual void save_state(physics::FDroneSimulationSnapshot& snapshot) const override;
+
+    virtual void restore_state(const physics::FDroneSimulationSnapshot& snapshot) override;
+
+    const physics::FPropulsionHeldOutputs& get_held_outputs() const { return this->held_outputs; }
+
+private:
+
+    // Throttle and rotor outputs held between two runs of the controller and of the rotor aerodynamics
+    physics::FPropulsionHeldOutputs held_outputs;
 };
@@ -28,6 +28,10 @@ struct FPropThrustResult
     }
 };
 
+/**
+ * Unreal-typed entry points of the BEMT solver. The solver itself lives in DroneSimulatorPhysics, see
+ * physics::simulation_bemt.
+ */
 namespace simulation_bemt
 {
     /**
@@ -37,7 +41,7 @@ namespace simulation_bemt
      * @param propeller_velocity Velocity of the propeller object (not the air), in m/s
      * @return Axial velocity of the freestream, in m/s
      */
-    double compute_axial_velocity(const FVector& thrust_axis, const FVector& wind_velocity,
+    DRONESIMULATORCORE_API double compute_axial_velocity(const FVector& thrust_axis, const FVector& wind_velocity,
         const FVector& propeller_velocity);
 
     /**
@@ -50,7 +54,7 @@ namespace simulation_bemt
      * @param propeller Propeller info
      * @return Result of the simulation of thrust and torque. Adds additional info for displaying
      */
-    TTuple<FPropThrustResult, FDebugLog> compute_thrust_and_torque(double propeller_angular_speed, const FVector& thrust_axis,
-        const FVector& wind_velocity, const FVector& propeller_velocity, double air_density,
+    DRONESIMULATORCORE_API TTuple<FPropThrustResult, FDebugLog> compute_thrust_and_torque(double propeller_angular_speed,
+        const FVector& thrust_axis, const FVector& wind_velocity, const FVector& propeller_velocity, double air_density,
         const FDronePropellerBemt* propeller);
 }
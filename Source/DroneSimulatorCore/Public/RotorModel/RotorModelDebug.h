@@ -22,7 +22,9 @@ public:
 
 	URotorModelDebug();
 
-	virtual FRotorSimulationResult simulate_propeller_rotor(FSubstepBody* substep_body, double throttle,
-		const TDronePropeller* propeller, const FDroneMotor* motor, const FDroneBattery* battery,
-		const FVector& propeller_location_local, bool is_clockwise, const USimulationWorld* simulation_world) override;
+	virtual physics::FRotorSimulationResult simulate_propeller_rotor(physics::FSubstepBody* substep_body, double throttle,
+		const physics::FDronePropeller* propeller, const physics::FDroneMotor* motor, const physics::FDroneBattery* battery,
+		const physics::FRotorDescription& rotor, const physics::FSimulationWorld* simulation_world) override;
+
+	virtual TOptional<physics::FRotorModel> get_physics_rotor_model() const override;
 };
@@ -1,4 +1,4 @@
-﻿#pragma once
+#pragma once
 
 #include "CoreMinimal.h"
 #include "DroneSimulatorCore/Public/RotorModel/RotorModelBase.h"
@@ -12,7 +12,9 @@ class DRONESIMULATORCORE_API URotorModelSimplified : public URotorModelBase
 
 public:
 
-	virtual FRotorSimulationResult simulate_propeller_rotor(FSubstepBody* substep_body, double throttle,
-		const TDronePropeller* propeller, const FDroneMotor* motor, const FDroneBattery* battery,
-		const FVector& propeller_location_local, bool is_clockwise, const USimulationWorld* simulation_world) override;
+	virtual physics::FRotorSimulationResult simulate_propeller_rotor(physics::FSubstepBody* substep_body, double throttle,
+		const physics::FDronePropeller* propeller, const physics::FDroneMotor* motor, const physics::FDroneBattery* battery,
+		const physics::FRotorDescription& rotor, const physics::FSimulationWorld* simulation_world) override;
+
+	virtual TOptional<physics::FRotorModel> get_physics_rotor_model() const override;
 };
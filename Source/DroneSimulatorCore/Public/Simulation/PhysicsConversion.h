@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "DroneSimulatorCore/Public/Controller/ControllerInput.h"
+#include "DroneSimulatorCore/Public/Controller/FlightMode.h"
+#include "DroneSimulatorCore/Public/Controller/Setpoint.h"
+#include "DroneSimulatorCore/Public/Controller/Throttle.h"
+#include "DroneSimulatorCore/Public/Simulation/LogDebug.h"
+#include "DroneSimulatorCore/Public/Simulation/Structural.h"
+
+#include "DroneSimulatorPhysics/Public/Controller/FlightMode.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/Controller/Throttle.h"
+#include "DroneSimulatorPhysics/Public/Math/Transform.h"
+#include "DroneSimulatorPhysics/Public/Simulation/LogDebug.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+
+#include <optional>
+
+struct FBodyInstance;
+
+/**
+ * Conversions between the Unreal types and the engine-independent types of DroneSimulatorPhysics.
+ * Units are the same on both sides, only the containers change.
+ */
+namespace physics_conversion
+{
+	DRONESIMULATORCORE_API physics::FVector3 to_physics(const FVector& vector);
+	DRONESIMULATORCORE_API FVector to_unreal(const physics::FVector3& vector);
+
+	DRONESIMULATORCORE_API physics::FQuaternion to_physics(const FQuat& quaternion);
+	DRONESIMULATORCORE_API FQuat to_unreal(const physics::FQuaternion& quaternion);
+
+	DRONESIMULATORCORE_API physics::FRotation to_physics(const FRotator& rotator);
+	DRONESIMULATORCORE_API FRotator to_unreal(const physics::FRotation& rotation);
+
+	// The scale is dropped
+	DRONESIMULATORCORE_API physics::FRigidTransform to_physics(const FTransform& transform);
+	DRONESIMULATORCORE_API FTransform to_unreal(const physics::FRigidTransform& transform);
+
+	DRONESIMULATORCORE_API physics::FDroneAirfoil to_physics(const FDroneAirfoil& airfoil);
+	DRONESIMULATORCORE_API physics::FDronePropeller to_physics(const TDronePropeller& propeller);
+	DRONESIMULATORCORE_API physics::FDronePropellerBemt to_physics(const FDronePropellerBemt& propeller);
+	DRONESIMULATORCORE_API physics::FRotorDescription to_physics(const FRotorDescription& rotor);
+	DRONESIMULATORCORE_API physics::FDroneFrame to_physics(const FDroneFrame& frame);
+	DRONESIMULATORCORE_API physics::FDroneMotor to_physics(const FDroneMotor& motor);
+	DRONESIMULATORCORE_API physics::FDroneBattery to_physics(const FDroneBattery& battery);
+
+	DRONESIMULATORCORE_API physics::FDroneSetpoint to_physics(const FDroneSetpoint& setpoint);
+	DRONESIMULATORCORE_API FDroneSetpoint to_unreal(const physics::FDroneSetpoint& setpoint);
+
+	DRONESIMULATORCORE_API physics::FPropellerSetThrottle to_physics(const FPropellerSetThrottle& throttle);
+	DRONESIMULATORCORE_API FPropellerSetThrottle to_unreal(const physics::FPropellerSetThrottle& throttle);
+
+	DRONESIMULATORCORE_API physics::FDronePlayerInput to_physics(const FDronePlayerInput& player_input);
+	DRONESIMULATORCORE_API FDronePlayerInput to_unreal(const physics::FDronePlayerInput& player_input);
+
+	DRONESIMULATORCORE_API physics::FFlightModeState to_physics(const FFlightModeState& flight_state);
+
+	DRONESIMULATORCORE_API FDebugLog to_unreal(const physics::FDebugLog& debug_log);
+
+	template <typename T>
+	auto to_physics(const TOptional<T>& value) -> std::optional<decltype(to_physics(value.GetValue()))>
+	{
+		if (!value.IsSet())
+		{
+			return std::nullopt;
+		}
+		return to_physics(value.GetValue());
+	}
+
+	/**
+	 * Reads the body state for a substep. Inertia is converted from kg·cm² to kg·m², and velocity from cm/s to m/s.
+	 */
+	DRONESIMULATORCORE_API physics::FSubstepBody substep_body_from_body_instance(const FBodyInstance* body_instance);
+}
@@ -124,6 +124,36 @@ public:
 
 using TDronePropeller = TVariant<FDronePropellerBemt, FDronePropellerSimplified>;
 
+/**
+ * One rotor of the frame: a motor and its propeller.
+ */
+USTRUCT(BlueprintType)
+struct DRONESIMULATORCORE_API FRotorDescription
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Where the thrust is applied, relative to the center of the drone, in
+	 * unreal-units (centimeters).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector location = FVector::ZeroVector;
+
+	/**
+	 * Direction of the thrust in the drone frame. Tilted rotors lean away
+	 * from +Z.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector thrust_axis = FVector::UpVector;
+
+	/**
+	 * Seen from above.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool is_clockwise = false;
+};
+
 /**
  * Inside simulation, we want to work with SI units (meters, kilograms, seconds,
  * Newtons) and radians.
@@ -170,6 +200,13 @@ public:
 	 */
 	UPROPERTY(BlueprintReadWrite)
 	double mass = 0.0;
+
+	/**
+	 * Rotors of the frame, in the order of the mixer. When empty, the frame is
+	 * a quad X with its rotors at the props extents.
+	 */
+	UPROPERTY(BlueprintReadWrite)
+	TArray<FRotorDescription> rotors;
 };
 
 /**
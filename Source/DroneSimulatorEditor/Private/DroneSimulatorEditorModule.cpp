@@ -6,6 +6,7 @@
 #include "DroneSimulatorEditor/Private/TypeActions/AssetTypeActions_FlightRecord.h"
 #include "DroneSimulatorEditor/Private/TypeActions/AssetTypeActions_DroneAirfoil.h"
 #include "DroneSimulatorEditor/Private/TypeActions/AssetTypeActions_DroneAirfoilSimplified.h"
+#include "DroneSimulatorEditor/Private/TypeActions/AssetTypeActions_PidTuningPreset.h"
 #include "DroneSimulatorEditor/Private/Widgets/STimelinePanel.h"
 #include "DroneSimulatorEditor/Private/Playback/FlightPlaybackManager.h"
 #include "DroneSimulatorEditor/Private/Details/DroneAirfoilAssetDetails.h"
@@ -93,6 +94,10 @@ void FDroneSimulatorEditorModule::register_asset_tools()
 	registered_asset_type_actions.Add(airfoil_simplified_actions);
 	asset_tools.RegisterAssetTypeActions(airfoil_simplified_actions.ToSharedRef());
 
+	TSharedPtr<FAssetTypeActions_PidTuningPreset> pid_tuning_preset_actions = MakeShared<FAssetTypeActions_PidTuningPreset>();
+	registered_asset_type_actions.Add(pid_tuning_preset_actions);
+	asset_tools.RegisterAssetTypeActions(pid_tuning_preset_actions.ToSharedRef());
+
 	TSharedPtr<FAssetTypeActions_FlightRecord> flight_record_actions = MakeShared<FAssetTypeActions_FlightRecord>();
 	registered_asset_type_actions.Add(flight_record_actions);
 	asset_tools.RegisterAssetTypeActions(flight_record_actions.ToSharedRef());
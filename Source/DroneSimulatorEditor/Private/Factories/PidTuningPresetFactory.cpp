@@ -0,0 +1,33 @@
+#include "DroneSimulatorEditor/Private/Factories/PidTuningPresetFactory.h"
+
+#include "DroneSimulatorGame/Assets/PidTuningPresetAsset.h"
+#include "Developer/AssetTools/Public/IAssetTools.h"
+#include "Developer/AssetTools/Public/AssetToolsModule.h"
+
+
+#define LOCTEXT_NAMESPACE "PidTuningPresetFactory"
+
+UPidTuningPresetFactory::UPidTuningPresetFactory()
+{
+	SupportedClass = UPidTuningPresetAsset::StaticClass();
+	bCreateNew = true;
+	bEditAfterNew = true;
+}
+
+UObject* UPidTuningPresetFactory::FactoryCreateNew(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, UObject* Context, FFeedbackContext* Warn, FName CallingContext)
+{
+	return NewObject<UPidTuningPresetAsset>(InParent, InClass, InName, Flags);
+}
+
+uint32 UPidTuningPresetFactory::GetMenuCategories() const
+{
+	IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
+	return AssetTools.RegisterAdvancedAssetCategory("Drone", LOCTEXT("AssetCategoryName", "Drone"));
+}
+
+FText UPidTuningPresetFactory::GetDisplayName() const
+{
+	return LOCTEXT("PidTuningPresetFactoryDisplayName", "PID tuning preset");
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Runtime/Core/Public/CoreMinimal.h"
+#include "Editor/UnrealEd/Classes/Factories/Factory.h"
+
+#include "PidTuningPresetFactory.generated.h"
+
+UCLASS()
+class UPidTuningPresetFactory : public UFactory
+{
+	GENERATED_BODY()
+
+public:
+	UPidTuningPresetFactory();
+
+	virtual UObject* FactoryCreateNew(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, UObject* Context, FFeedbackContext* Warn, FName CallingContext) override;
+
+	virtual uint32 GetMenuCategories() const override;
+
+	virtual FText GetDisplayName() const override;
+};
@@ -2,6 +2,7 @@
 #include "DroneSimulatorEditor/Private/Playback/FlightPlaybackVisualizationActor.h"
 #include "DroneSimulatorGame/Assets/FlightRecordAsset.h"
 
+#include "Algo/BinarySearch.h"
 #include "Editor.h"
 #include "EditorViewportClient.h"
 #include "UnrealClient.h"
@@ -100,6 +101,39 @@ TStatId FFlightPlaybackManager::GetStatId() const
 void FFlightPlaybackManager::load_flight_record(UFlightRecordAsset* flight_record)
 {
 	current_flight_record = flight_record;
+	decoded_event_stream = INDEX_NONE;
+
+	// The samples are streamed to files next to the asset, they are read around the playback time only
+	record_reader = flight_record != nullptr ? flight_record->open_reader() : nullptr;
+	pawn_names.Reset();
+	if (record_reader.IsValid())
+	{
+		for (const std::string& stream_name : record_reader->get_stream_names())
+		{
+			pawn_names.Add(FName(UTF8_TO_TCHAR(stream_name.c_str())));
+		}
+	}
+
+	// The debug events are appended per frame, index them per pawn once
+	debug_event_indices.Reset();
+	debug_event_indices.SetNum(pawn_names.Num());
+	if (flight_record != nullptr)
+	{
+		const TArray<FFlightRecordDebugEvent>& debug_events = flight_record->debug_events;
+		for (int32 i = 0; i < debug_events.Num(); ++i)
+		{
+			const int32 stream_index = pawn_names.IndexOfByKey(debug_events[i].pawn_name);
+			if (stream_index != INDEX_NONE)
+			{
+				debug_event_indices[stream_index].Add(i);
+			}
+		}
+
+		for (TArray<int32>& indices : debug_event_indices)
+		{
+			indices.StableSort([&debug_events](int32 a, int32 b) { return debug_events[a].event_time < debug_events[b].event_time; });
+		}
+	}
 	
 	// Reset playback state and destroy visualization actor
 	playback_state = EPlaybackState::Stopped;
@@ -179,74 +213,90 @@ void FFlightPlaybackManager::seek_to_time(float time)
 
 void FFlightPlaybackManager::step_to_next_event()
 {
-	if (!current_flight_record.IsValid() || current_flight_record->events.Num() == 0)
+	if (!current_flight_record.IsValid() || !record_reader.IsValid())
 	{
 		return;
 	}
 
-	// Find the next event after current time
-	const TArray<FFlightRecordEvent>& events = current_flight_record->events;
-	
-	for (int32 i = 0; i < events.Num(); ++i)
+	// Find the first event after current time, over all the drones. If there is none, stay at the last one.
+	const double after_time = current_time + KINDA_SMALL_NUMBER;
+	double next_time = TNumericLimits<double>::Max();
+	double last_time = TNumericLimits<double>::Lowest();
+	for (int32 stream_index = 0; stream_index < record_reader->get_stream_count(); ++stream_index)
 	{
-		if (events[i].event_time > current_time + KINDA_SMALL_NUMBER)
+		// The samples bracketing after_time, the last one is the next event of this drone
+		if (!record_reader->read_samples(stream_index, after_time, after_time, sample_buffer) || sample_buffer.empty())
 		{
-			current_time = events[i].event_time;
-			return;
+			continue;
 		}
+
+		const double time = sample_buffer.back().time;
+		if (time > after_time)
+		{
+			next_time = FMath::Min(next_time, time);
+		}
+		last_time = FMath::Max(last_time, time);
 	}
 
-	// If no next event found, go to the last event
-	if (events.Num() > 0)
+	if (next_time != TNumericLimits<double>::Max())
+	{
+		current_time = next_time;
+	}
+	else if (last_time != TNumericLimits<double>::Lowest())
 	{
-		current_time = events.Last().event_time;
+		current_time = last_time;
 	}
 }
 
 void FFlightPlaybackManager::step_to_previous_event()
 {
-	if (!current_flight_record.IsValid() || current_flight_record->events.Num() == 0)
+	if (!current_flight_record.IsValid() || !record_reader.IsValid())
 	{
 		return;
 	}
 
-	// Find the previous event before current time
-	const TArray<FFlightRecordEvent>& events = current_flight_record->events;
-	
-	for (int32 i = events.Num() - 1; i >= 0; --i)
+	// Find the last event before current time, over all the drones. If there is none, stay at the first one.
+	const double before_time = current_time - KINDA_SMALL_NUMBER;
+	double previous_time = TNumericLimits<double>::Lowest();
+	double first_time = TNumericLimits<double>::Max();
+	for (int32 stream_index = 0; stream_index < record_reader->get_stream_count(); ++stream_index)
 	{
-		if (events[i].event_time < current_time - KINDA_SMALL_NUMBER)
+		// The samples bracketing before_time, the first one is the previous event of this drone
+		if (!record_reader->read_samples(stream_index, before_time, before_time, sample_buffer) || sample_buffer.empty())
+		{
+			continue;
+		}
+
+		const double time = sample_buffer[0].time;
+		if (time < before_time)
 		{
-			current_time = events[i].event_time;
-			return;
+			previous_time = FMath::Max(previous_time, time);
 		}
+		first_time = FMath::Min(first_time, time);
 	}
 
-	// If no previous event found, go to the first event
-	if (events.Num() > 0)
+	if (previous_time != TNumericLimits<double>::Lowest())
 	{
-		current_time = events[0].event_time;
+		current_time = previous_time;
+	}
+	else if (first_time != TNumericLimits<double>::Max())
+	{
+		current_time = first_time;
 	}
 }
 
 void FFlightPlaybackManager::update_time_bounds()
 {
-	if (!current_flight_record.IsValid() || current_flight_record->events.Num() == 0)
+	if (!current_flight_record.IsValid() || !record_reader.IsValid() || record_reader->get_first_time() == record_reader->get_last_time())
 	{
 		min_time = 0.0f;
 		max_time = 10.0f;
 		return;
 	}
 
-	// Find min and max times from events
-	min_time = current_flight_record->events[0].event_time;
-	max_time = current_flight_record->events.Last().event_time;
-
-	for (const FFlightRecordEvent& event : current_flight_record->events)
-	{
-		min_time = FMath::Min(min_time, static_cast<float>(event.event_time));
-		max_time = FMath::Max(max_time, static_cast<float>(event.event_time));
-	}
+	// From the index, the chunks know their time range
+	min_time = record_reader->get_first_time();
+	max_time = record_reader->get_last_time();
 
 	// Ensure we have at least some time range
 	if (FMath::IsNearlyEqual(min_time, max_time))
@@ -257,51 +307,74 @@ void FFlightPlaybackManager::update_time_bounds()
 
 const FFlightRecordEventData* FFlightPlaybackManager::get_current_event_data(const FName& drone_name) const
 {
-	if (!current_flight_record.IsValid() || current_flight_record->events.Num() == 0)
+	if (!current_flight_record.IsValid() || !record_reader.IsValid() || pawn_names.Num() == 0)
 	{
 		return nullptr;
 	}
 
-	const TArray<FFlightRecordEvent>& events = current_flight_record->events;
+	// Determine which drone to get data for, the first one if none specified
+	const int32 stream_index = drone_name == NAME_None ? 0 : pawn_names.IndexOfByKey(drone_name);
+	if (stream_index == INDEX_NONE)
+	{
+		return nullptr;
+	}
 
-	// Determine which drone to get data for
-	FName target_drone = drone_name;
-	if (target_drone == NAME_None)
+	// Same drone at the same time as the last call
+	if (stream_index == decoded_event_stream && current_time == decoded_for_time)
 	{
-		// Find the first drone in the events
-		if (events.Num() > 0)
-		{
-			target_drone = events[0].pawn_name;
-		}
-		else
-		{
-			return nullptr;
-		}
+		return &decoded_event_data;
+	}
+
+	// The samples bracketing current_time, take the closest one
+	if (!record_reader->read_samples(stream_index, current_time, current_time, sample_buffer) || sample_buffer.empty())
+	{
+		return nullptr;
 	}
 
-	// Filter events for the target drone and find the closest one to current_time
-	int32 closest_index = -1;
-	float closest_time_diff = FLT_MAX;
+	const physics::FTelemetrySample& sample = sample_buffer.size() > 1
+		&& FMath::Abs(sample_buffer.back().time - current_time) < FMath::Abs(sample_buffer[0].time - current_time)
+		? sample_buffer.back()
+		: sample_buffer[0];
 
-	for (int32 i = 0; i < events.Num(); ++i)
+	decoded_for_time = current_time;
+	if (stream_index != decoded_event_stream || sample.time != decoded_event_time)
 	{
-		if (events[i].pawn_name == target_drone)
+		decoded_event_data = FFlightRecordSample(sample).decode();
+		decoded_event_stream = stream_index;
+		decoded_event_time = sample.time;
+
+		// The debug logs and the full Reynolds numbers, when the pawn recorded them
+		const TArray<FFlightRecordDebugEvent>& debug_events = current_flight_record->debug_events;
+		const TArray<int32>& indices = debug_event_indices[stream_index];
+		const int32 found = Algo::LowerBoundBy(indices, sample.time, [&debug_events](int32 i) { return debug_events[i].event_time; });
+		if (found < indices.Num() && debug_events[indices[found]].event_time == sample.time)
 		{
-			float time_diff = FMath::Abs(events[i].event_time - current_time);
-			if (time_diff < closest_time_diff)
-			{
-				closest_time_diff = time_diff;
-				closest_index = i;
-			}
+			decoded_event_data.propulsion_info = debug_events[indices[found]].propulsion_info;
 		}
 	}
 
-	if (closest_index == -1)
+	return &decoded_event_data;
+}
+
+void FFlightPlaybackManager::get_event_times(float begin_time, float end_time, int32 max_count, TArray<float>& out_times) const
+{
+	out_times.Reset();
+	if (!current_flight_record.IsValid() || !record_reader.IsValid())
 	{
-		return nullptr;
+		return;
 	}
 
-	return &events[closest_index].event_data;
+	std::vector<double> times;
+	if (!record_reader->read_times(begin_time, end_time, max_count, times))
+	{
+		return;
+	}
+
+	out_times.Reserve(times.size());
+	for (const double time : times)
+	{
+		out_times.Add(time);
+	}
 }
 
 void FFlightPlaybackManager::spawn_visualization_actor()
@@ -383,10 +456,10 @@ void FFlightPlaybackManager::update_visualization_actor()
 	if (current_flight_record.IsValid())
 	{
 		bool is_playing = playback_state == EPlaybackState::Playing;
-		visualization_actor->update_playback(current_flight_record.Get(), current_time, is_playing);
+		visualization_actor->update_playback(record_reader.Get(), pawn_names, current_time, is_playing);
 		
 		// Draw debug visualization
-		visualization_actor->draw_debug_visualization(actor_world, current_time, is_playing);
+		visualization_actor->draw_debug_visualization(actor_world, record_reader.Get(), current_time, is_playing);
 	}
 }
 
@@ -2,10 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "Editor/UnrealEd/Public/TickableEditorObject.h"
+#include "DroneSimulatorGame/Gameplay/Recording/FlightRecord.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordReader.h"
 
-struct FFlightRecordEventData;
 class UFlightRecordAsset;
-struct FFlightRecordEvent;
 
 /**
  * Global manager for flight record playback in the editor
@@ -61,9 +61,12 @@ public:
 	/** Check if PIE is currently active */
 	bool is_pie_running() const { return is_pie_active; }
 
-	/** Get current event data for a specific drone (or first drone if none specified) */
+	/** Get current event data for a specific drone (or first drone if none specified). Valid until the next call. */
 	const FFlightRecordEventData* get_current_event_data(const FName& drone_name = NAME_None) const;
 
+	/** Sample times between begin_time and end_time, at most max_count of them, evenly spaced when there are more */
+	void get_event_times(float begin_time, float end_time, int32 max_count, TArray<float>& out_times) const;
+
 private:
 	/** Private constructor for singleton */
 	FFlightPlaybackManager();
@@ -78,6 +81,18 @@ private:
 	/** Current flight record */
 	TWeakObjectPtr<UFlightRecordAsset> current_flight_record;
 
+	/** Reads the samples of the current flight record on demand, records of long sessions don't fit in memory */
+	TUniquePtr<physics::FFlightRecordReader> record_reader;
+
+	/** Pawn of each stream of the reader */
+	TArray<FName> pawn_names;
+
+	/** Indices in the debug events of the current flight record, per stream and sorted by time, to binary search them */
+	TArray<TArray<int32>> debug_event_indices;
+
+	/** Samples of the last read, kept to reuse their memory */
+	mutable std::vector<physics::FTelemetrySample> sample_buffer;
+
 	/** Playback state */
 	EPlaybackState playback_state;
 
@@ -91,6 +106,12 @@ private:
 	/** Playback speed multiplier */
 	float playback_speed;
 
+	/** Last event decoded by get_current_event_data, the widgets ask for the same one several times per frame */
+	mutable int32 decoded_event_stream = INDEX_NONE;
+	mutable double decoded_event_time = 0.0;
+	mutable float decoded_for_time = 0.0f;
+	mutable FFlightRecordEventData decoded_event_data;
+
 	/** Whether PIE is currently active */
 	bool is_pie_active;
 
@@ -33,30 +33,37 @@ AFlightPlaybackVisualizationActor::AFlightPlaybackVisualizationActor()
 #endif
 }
 
-void AFlightPlaybackVisualizationActor::update_playback(UFlightRecordAsset* flight_record, float current_time, bool is_playing)
+void AFlightPlaybackVisualizationActor::update_playback(physics::FFlightRecordReader* record_reader, const TArray<FName>& pawn_names, float current_time,
+	bool is_playing)
 {
-	if (!flight_record || flight_record->events.Num() == 0)
+	if (!record_reader || !record_reader->is_open())
 	{
 		return;
 	}
 
-	// Cache the flight record for debug drawing
-	cached_flight_record = flight_record;
-
 	// Ensure actor stays at zero position
 	SetActorLocation(FVector::ZeroVector);
 	SetActorRotation(FRotator::ZeroRotator);
 
-	// Collect all unique drone names
+	// Collect the drones that recorded something
 	TSet<FName> drone_names;
-	for (const FFlightRecordEvent& event : flight_record->events)
+	for (int32 stream_index = 0; stream_index < pawn_names.Num(); ++stream_index)
 	{
-		drone_names.Add(event.pawn_name);
+		if (record_reader->get_sample_count(stream_index) > 0)
+		{
+			drone_names.Add(pawn_names[stream_index]);
+		}
 	}
 
 	// Update each drone
-	for (const FName& drone_name : drone_names)
+	for (int32 stream_index = 0; stream_index < pawn_names.Num(); ++stream_index)
 	{
+		const FName& drone_name = pawn_names[stream_index];
+		if (!drone_names.Contains(drone_name))
+		{
+			continue;
+		}
+
 		// Get or create component for this drone
 		UStaticMeshComponent* mesh_component = get_or_create_drone_component(drone_name);
 		
@@ -66,19 +73,20 @@ void AFlightPlaybackVisualizationActor::update_playback(UFlightRecordAsset* flig
 		}
 
 		// Get interpolated event for this drone at current time
-		FFlightRecordEvent interpolated_event;
-		get_interpolated_event(flight_record->events, drone_name, current_time, interpolated_event);
+		FFlightRecordEventData interpolated_event_data;
+		get_interpolated_event(*record_reader, stream_index, current_time, interpolated_event_data);
 
 		// Store in map
 		if (FDroneVisualizationComponent* comp = drone_components.Find(drone_name))
 		{
-			comp->current_event = interpolated_event;
+			comp->current_event_data = interpolated_event_data;
+			comp->stream_index = stream_index;
 		}
 
 		// Update mesh component position
 		mesh_component->SetWorldLocationAndRotation(
-			interpolated_event.event_data.location,
-			interpolated_event.event_data.rotation
+			interpolated_event_data.location,
+			interpolated_event_data.rotation
 		);
 	}
 
@@ -103,15 +111,10 @@ void AFlightPlaybackVisualizationActor::update_playback(UFlightRecordAsset* flig
 	MarkComponentsRenderStateDirty();
 }
 
-void AFlightPlaybackVisualizationActor::draw_debug_visualization(UWorld* world, float current_time, bool is_playing)
+void AFlightPlaybackVisualizationActor::draw_debug_visualization(UWorld* world, physics::FFlightRecordReader* record_reader, float current_time,
+	bool is_playing)
 {
-	if (!world || !cached_flight_record.IsValid())
-	{
-		return;
-	}
-
-	UFlightRecordAsset* flight_record = cached_flight_record.Get();
-	if (!flight_record || flight_record->events.Num() == 0)
+	if (!world || !record_reader || !record_reader->is_open())
 	{
 		return;
 	}
@@ -124,9 +127,9 @@ void AFlightPlaybackVisualizationActor::draw_debug_visualization(UWorld* world,
 	for (const auto& pair : drone_components)
 	{
 		const FName& drone_name = pair.Key;
-		const FFlightRecordEvent& event = pair.Value.current_event;
-		const FVector& location = event.event_data.location;
-		const FRotator& rotation = event.event_data.rotation;
+		const FFlightRecordEventData& event_data = pair.Value.current_event_data;
+		const FVector& location = event_data.location;
+		const FRotator& rotation = event_data.rotation;
 
 		// Draw the drone as a combination of shapes
 		// Draw central body (box)
@@ -162,7 +165,7 @@ void AFlightPlaybackVisualizationActor::draw_debug_visualization(UWorld* world,
 		DrawDebugLine(world, location, location + up * drone_size * 0.5f, FColor::Blue, false, -1.0f, 0, 2.0f);
 
 		// Draw velocity vector
-		const FVector& velocity = event.event_data.velocity;
+		const FVector& velocity = event_data.velocity;
 		// Scale velocity for visualization (convert from m/s to Unreal units: 1m = 100 units)
 		const float velocity_scale = 0.15f;
 		FVector velocity_visual = velocity * 100.f * velocity_scale;
@@ -182,111 +185,70 @@ void AFlightPlaybackVisualizationActor::draw_debug_visualization(UWorld* world,
 		}
 	}
 
-	// Draw flight path (trail) for each drone
-	TMap<FName, TArray<const FFlightRecordEvent*>> events_by_drone;
-	for (const FFlightRecordEvent& event : flight_record->events)
-	{
-		events_by_drone.FindOrAdd(event.pawn_name).Add(&event);
-	}
+	// Draw flight path (trail) for each drone, around the playback time only: a whole session is millions of samples
+	const float trail_duration = 10.0f;
+	const int32 max_trail_segments = 1000;
 
-	for (const auto& pair : events_by_drone)
+	for (auto& pair : drone_components)
 	{
-		const TArray<const FFlightRecordEvent*>& events = pair.Value;
-		
-		if (events.Num() > 1)
+		if (pair.Value.stream_index == INDEX_NONE
+			|| !record_reader->read_samples(pair.Value.stream_index, current_time - trail_duration, current_time + trail_duration, sample_buffer,
+				pair.Value.trail_cursor)
+			|| sample_buffer.size() < 2)
 		{
-			for (int32 i = 0; i < events.Num() - 1; ++i)
-			{
-				const FFlightRecordEvent* event1 = events[i];
-				const FFlightRecordEvent* event2 = events[i + 1];
-				
-				// Determine color based on whether we've passed this segment
-				FColor trail_color = event1->event_time <= current_time ? FColor::White : FColor(128, 128, 128, 128);
-				
-				DrawDebugLine(world, event1->event_data.location, event2->event_data.location, trail_color, false, -1.0f, 0, 1.0f);
-			}
+			continue;
 		}
-	}
-}
 
-void AFlightPlaybackVisualizationActor::get_interpolated_event(const TArray<FFlightRecordEvent>& events, const FName& pawn_name, float time, FFlightRecordEvent& out_event) const
-{
-	// Filter events for this specific drone
-	TArray<const FFlightRecordEvent*> drone_events;
-	for (const FFlightRecordEvent& event : events)
-	{
-		if (event.pawn_name == pawn_name)
+		// Skip samples rather than draw more segments than can be told apart, keeping the last one
+		const int32 last_index = static_cast<int32>(sample_buffer.size()) - 1;
+		const int32 stride = FMath::Max(1, FMath::DivideAndRoundUp(last_index, max_trail_segments));
+		for (int32 i = 0; i < last_index; i += stride)
 		{
-			drone_events.Add(&event);
-		}
-	}
-
-	if (drone_events.Num() == 0)
-	{
-		// No events for this drone
-		out_event = FFlightRecordEvent();
-		return;
-	}
+			const physics::FTelemetrySample& sample1 = sample_buffer[i];
+			const physics::FTelemetrySample& sample2 = sample_buffer[FMath::Min(i + stride, last_index)];
 
-	// Find the two events to interpolate between
-	int32 index_before = -1;
-	int32 index_after = -1;
+			// Determine color based on whether we've passed this segment
+			FColor trail_color = sample1.time <= current_time ? FColor::White : FColor(128, 128, 128, 128);
 
-	for (int32 i = 0; i < drone_events.Num(); ++i)
-	{
-		if (drone_events[i]->event_time <= time)
-		{
-			index_before = i;
-		}
-		if (drone_events[i]->event_time >= time)
-		{
-			index_after = i;
-			break;
+			DrawDebugLine(world, FFlightRecordSample(sample1).get_location(), FFlightRecordSample(sample2).get_location(), trail_color, false, -1.0f, 0,
+				1.0f);
 		}
 	}
+}
 
-	// Handle edge cases
-	if (index_before == -1)
-	{
-		// Before first event
-		out_event = *drone_events[0];
-		return;
-	}
-
-	if (index_after == -1)
+void AFlightPlaybackVisualizationActor::get_interpolated_event(physics::FFlightRecordReader& record_reader, int32 stream_index, float time,
+	FFlightRecordEventData& out_event_data)
+{
+	// The events to interpolate between: the last one at or before time and the first one at or after it
+	if (!record_reader.read_samples(stream_index, time, time, sample_buffer) || sample_buffer.empty())
 	{
-		// After last event
-		out_event = *drone_events.Last();
+		// No events for this drone
+		out_event_data = FFlightRecordEventData();
 		return;
 	}
 
-	// Same event or very close
-	if (index_before == index_after)
+	// Before the first event, after the last one, or on an event
+	const physics::FTelemetrySample& sample_before = sample_buffer[0];
+	const physics::FTelemetrySample& sample_after = sample_buffer.back();
+	if (sample_buffer.size() == 1 || sample_before.time >= time || sample_after.time <= time)
 	{
-		out_event = *drone_events[index_before];
+		out_event_data = FFlightRecordSample(sample_before.time >= time ? sample_before : sample_after).decode();
 		return;
 	}
 
 	// Interpolate between events
-	const FFlightRecordEvent* event_before = drone_events[index_before];
-	const FFlightRecordEvent* event_after = drone_events[index_after];
-
-	float time_before = event_before->event_time;
-	float time_after = event_after->event_time;
+	float time_before = sample_before.time;
+	float time_after = sample_after.time;
 	float alpha = (time - time_before) / (time_after - time_before);
 	alpha = FMath::Clamp(alpha, 0.0f, 1.0f);
 
-	// Create interpolated event
-	out_event.pawn_name = pawn_name;
-	out_event.event_time = time;
-	out_event.event_data.location = FMath::Lerp(event_before->event_data.location, event_after->event_data.location, alpha);
-	out_event.event_data.rotation = FMath::Lerp(event_before->event_data.rotation, event_after->event_data.rotation, alpha);
-	out_event.event_data.velocity = FMath::Lerp(event_before->event_data.velocity, event_after->event_data.velocity, alpha);
-	out_event.event_data.angular_velocity = FMath::Lerp(event_before->event_data.angular_velocity, event_after->event_data.angular_velocity, alpha);
-	
-	// For discrete data, use the "before" event's values
-	out_event.event_data.controller_input = event_before->event_data.controller_input;
-	out_event.event_data.propulsion_info = event_before->event_data.propulsion_info;
+	// Create interpolated event. For discrete data, use the "before" event's values
+	const FFlightRecordEventData data_after = FFlightRecordSample(sample_after).decode();
+	out_event_data = FFlightRecordSample(sample_before).decode();
+	out_event_data.location = FMath::Lerp(out_event_data.location, data_after.location, alpha);
+	out_event_data.rotation = FMath::Lerp(out_event_data.rotation, data_after.rotation, alpha);
+	out_event_data.velocity = FMath::Lerp(out_event_data.velocity, data_after.velocity, alpha);
+	out_event_data.angular_velocity = FMath::Lerp(out_event_data.angular_velocity, data_after.angular_velocity, alpha);
 }
 
 UStaticMeshComponent* AFlightPlaybackVisualizationActor::get_or_create_drone_component(const FName& pawn_name)
@@ -322,7 +284,7 @@ UStaticMeshComponent* AFlightPlaybackVisualizationActor::get_or_create_drone_com
 	// Add to map
 	FDroneVisualizationComponent& comp = drone_components.Add(pawn_name);
 	comp.mesh_component = new_component;
-	comp.current_event = FFlightRecordEvent();
+	comp.current_event_data = FFlightRecordEventData();
 
 	return new_component;
 }
@@ -4,6 +4,7 @@
 #include "GameFramework/Actor.h"
 #include "Components/StaticMeshComponent.h"
 #include "DroneSimulatorGame/Assets/FlightRecordAsset.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordReader.h"
 
 #include "FlightPlaybackVisualizationActor.generated.h"
 
@@ -22,11 +23,18 @@ struct FDroneVisualizationComponent
 	TObjectPtr<UStaticMeshComponent> mesh_component;
 
 	/** Current interpolated event data for this drone */
-	FFlightRecordEvent current_event;
+	FFlightRecordEventData current_event_data;
+
+	/** Stream of this drone in the flight record reader */
+	int32 stream_index;
+
+	/** Reads of the trail, which would otherwise move the cursor the playhead reads start from */
+	physics::FFlightRecordReader::FReadCursor trail_cursor;
 
 	FDroneVisualizationComponent()
 		: mesh_component(nullptr)
-		, current_event()
+		, current_event_data()
+		, stream_index(INDEX_NONE)
 	{
 	}
 };
@@ -43,15 +51,15 @@ class AFlightPlaybackVisualizationActor : public AActor
 public:
 	AFlightPlaybackVisualizationActor();
 
-	/** Update the actor with current flight record and playback time */
-	void update_playback(class UFlightRecordAsset* flight_record, float current_time, bool is_playing);
+	/** Update the actor with the flight record being played, pawn_names are those of the reader streams, and playback time */
+	void update_playback(physics::FFlightRecordReader* record_reader, const TArray<FName>& pawn_names, float current_time, bool is_playing);
 
 	/** Draw debug visualization for all drones */
-	void draw_debug_visualization(UWorld* world, float current_time, bool is_playing);
+	void draw_debug_visualization(UWorld* world, physics::FFlightRecordReader* record_reader, float current_time, bool is_playing);
 
 private:
 	/** Get interpolated event data at a specific time for a specific drone */
-	void get_interpolated_event(const TArray<FFlightRecordEvent>& events, const FName& pawn_name, float time, FFlightRecordEvent& out_event) const;
+	void get_interpolated_event(physics::FFlightRecordReader& record_reader, int32 stream_index, float time, FFlightRecordEventData& out_event_data);
 
 	/** Ensure we have a component for the given drone */
 	UStaticMeshComponent* get_or_create_drone_component(const FName& pawn_name);
@@ -60,9 +68,8 @@ private:
 	UPROPERTY()
 	TMap<FName, FDroneVisualizationComponent> drone_components;
 
-	/** Cached flight record for drawing paths */
-	UPROPERTY()
-	TWeakObjectPtr<UFlightRecordAsset> cached_flight_record;
+	/** Samples of the last read, kept to reuse their memory */
+	std::vector<physics::FTelemetrySample> sample_buffer;
 
 	/** Static mesh reference for drone */
 	UPROPERTY()
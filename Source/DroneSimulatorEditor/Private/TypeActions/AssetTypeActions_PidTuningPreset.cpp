@@ -0,0 +1,27 @@
+#include "TypeActions/AssetTypeActions_PidTuningPreset.h"
+#include "DroneSimulatorGame/Assets/PidTuningPresetAsset.h"
+
+#define LOCTEXT_NAMESPACE "AssetTypeActions"
+
+FText FAssetTypeActions_PidTuningPreset::GetName() const
+{
+	return LOCTEXT("FPidTuningPresetAssetName", "PID tuning preset");
+}
+
+FColor FAssetTypeActions_PidTuningPreset::GetTypeColor() const
+{
+	// oklch(0.827 0.078 305.000)
+	return FColor::FromHex("d0bdf2");
+}
+
+UClass* FAssetTypeActions_PidTuningPreset::GetSupportedClass() const
+{
+	return UPidTuningPresetAsset::StaticClass();
+}
+
+uint32 FAssetTypeActions_PidTuningPreset::GetCategories()
+{
+	return EAssetTypeCategories::Misc;
+}
+
+#undef LOCTEXT_NAMESPACE
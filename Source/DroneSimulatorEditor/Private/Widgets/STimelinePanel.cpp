@@ -887,8 +887,7 @@ void STimelinePanel::on_timeline_zoom(float wheel_delta)
 
 float STimelinePanel::snap_to_nearest_event(float time) const
 {
-	UFlightRecordAsset* flight_record = playback_manager->get_flight_record();
-	if (!flight_record || flight_record->events.Num() == 0)
+	if (!playback_manager->has_flight_record())
 	{
 		return time;
 	}
@@ -897,13 +896,15 @@ float STimelinePanel::snap_to_nearest_event(float time) const
 	float visible_duration = visible_end_time - visible_start_time;
 	float snap_threshold = visible_duration * 0.01f; // 1% of visible duration
 	
-	// Find nearest event
+	// Find nearest event. Only those within the threshold are read, when there are too many they are so dense that
+	// snapping to the evenly spaced times returned instead makes no visible difference.
 	float nearest_time = time;
 	float nearest_distance = snap_threshold;
 	
-	for (const FFlightRecordEvent& event : flight_record->events)
+	TArray<float> event_times;
+	playback_manager->get_event_times(time - snap_threshold, time + snap_threshold, max_event_ticks, event_times);
+	for (float event_time : event_times)
 	{
-		float event_time = static_cast<float>(event.event_time);
 		float distance = FMath::Abs(event_time - time);
 		
 		if (distance < nearest_distance)
@@ -920,14 +921,8 @@ TArray<float> STimelinePanel::get_event_times() const
 {
 	TArray<float> event_times;
 	
-	UFlightRecordAsset* flight_record = playback_manager->get_flight_record();
-	if (flight_record)
-	{
-		for (const FFlightRecordEvent& event : flight_record->events)
-		{
-			event_times.Add(static_cast<float>(event.event_time));
-		}
-	}
+	// Only the visible ones, and no more than can be drawn
+	playback_manager->get_event_times(visible_start_time, visible_end_time, max_event_ticks, event_times);
 	
 	return event_times;
 }
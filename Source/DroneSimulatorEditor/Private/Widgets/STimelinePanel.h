@@ -107,6 +107,7 @@ private:
 	bool is_zoom_out_enabled() const;
 	
 	/** Helper methods for event snapping */
+	static constexpr int32 max_event_ticks = 2048;
 	float snap_to_nearest_event(float time) const;
 	TArray<float> get_event_times() const;
 
@@ -123,6 +123,7 @@ FDroneFrame conversion::convert_frame_asset(const UDroneFrameAsset* asset)
 	result.area = asset->area_m2;
 	result.drag_coefficient = asset->drag_coefficient;
 	result.mass = asset->mass_kg;
+	result.rotors = asset->rotors;
 
 	return result;
 }
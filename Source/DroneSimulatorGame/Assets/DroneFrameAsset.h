@@ -3,6 +3,8 @@
 #include "Runtime/Core/Public/CoreMinimal.h"
 #include "Runtime/Engine/Classes/Engine/DataAsset.h"
 
+#include "DroneSimulatorCore/Public/Simulation/Structural.h"
+
 #include "DroneFrameAsset.generated.h"
 
 UCLASS(BlueprintType)
@@ -42,4 +44,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drone simulator", meta=(DisplayName="Frame mass (kg)"))
 	double mass_kg = 0.5;
 
+	/**
+	 * Location (cm), thrust axis and spin direction of each rotor, for hexa, octo, coaxial or tilted-rotor frames.
+	 * Leave empty for a quad X with its rotors at the propellers extents.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drone simulator", meta=(DisplayName="Rotors"))
+	TArray<FRotorDescription> rotors;
+
 };
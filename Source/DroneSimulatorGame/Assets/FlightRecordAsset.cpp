@@ -1 +1,22 @@
 ﻿#include "DroneSimulatorGame/Assets/FlightRecordAsset.h"
+#include "DroneSimulatorGame/DroneSimulatorGame.h"
+#include "DroneSimulatorGame/Gameplay/Recording/FlightRecordCompression.h"
+
+#include "Misc/Paths.h"
+
+TUniquePtr<physics::FFlightRecordReader> UFlightRecordAsset::open_reader() const
+{
+	const FString index_path = FPaths::ProjectSavedDir() / this->index_file;
+
+	physics::FFlightRecordReaderConfig config;
+	config.entropy_coder = flight_record_compression::make_oodle_coder();
+
+	auto reader = MakeUnique<physics::FFlightRecordReader>();
+	if (this->index_file.IsEmpty() || !reader->open(TCHAR_TO_UTF8(*index_path), config))
+	{
+		UE_LOG(LogDroneSimulatorGame, Warning, TEXT("Can't read the flight record index %s"), *index_path);
+		return nullptr;
+	}
+
+	return reader;
+}
@@ -1,47 +1,40 @@
 ﻿#pragma once
 
 #include "DroneSimulatorGame/Gameplay/Recording/FlightRecord.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordReader.h"
 #include "Runtime/Engine/Classes/Engine/DataAsset.h"
 
 #include "FlightRecordAsset.generated.h"
 
 
-USTRUCT(BlueprintType)
-struct FFlightRecordEvent
+/**
+ * Flight record info for a session. The samples are streamed to chunk files while flying, see
+ * physics::FFlightRecordWriter: the asset only references them, and open_reader reads them on demand.
+ */
+UCLASS(BlueprintType)
+class DRONESIMULATORGAME_API UFlightRecordAsset : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
 public:
 
+	// Relative to the project Saved directory
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
-	FName pawn_name;
+	FString index_file;
 
+	// Relative to the project Saved directory, as of the end of the session. The index lists the chunks written before
+	// a crash.
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
-	double event_time = 0.0;
+	TArray<FString> chunk_files;
 
+	// Samples the pawns dropped because the recorder didn't drain them in time, the streams have gaps
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
-	FFlightRecordEventData event_data;
-
-public:
-
-	FFlightRecordEvent() = default;
-
-	FFlightRecordEvent(const FName& in_pawn_name, double in_event_time, const FFlightRecordEventData& in_event_data)
-		: pawn_name(in_pawn_name), event_time(in_event_time), event_data(in_event_data)
-	{
-	}
-};
-
-/**
- * Flight record info for a session
- */
-UCLASS(BlueprintType)
-class DRONESIMULATORGAME_API UFlightRecordAsset : public UPrimaryDataAsset
-{
-	GENERATED_BODY()
-
-public:
+	int64 dropped_event_count = 0;
 
+	// Empty unless a pawn enabled its debug recording
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
-	TArray<FFlightRecordEvent> events;
+	TArray<FFlightRecordDebugEvent> debug_events;
+
+	// Opens the record files without loading them, for playback. Null if the index can't be read.
+	TUniquePtr<physics::FFlightRecordReader> open_reader() const;
 };
@@ -0,0 +1,52 @@
+﻿#include "DroneSimulatorGame/Assets/PidTuningPresetAsset.h"
+
+physics::FPidTuningGains UPidTuningPresetAsset::apply_to(physics::FPidTuningGains gains) const
+{
+	const auto to_physics_pid = [](const FPidConfig& pid)
+	{
+		return physics::FPidConfig { pid.proportional, pid.integral, pid.derivative };
+	};
+
+	gains.controller.roll_pid = to_physics_pid(this->roll_pid);
+	gains.controller.pitch_pid = to_physics_pid(this->pitch_pid);
+	gains.controller.yaw_pid = to_physics_pid(this->yaw_pid);
+
+	if (this->has_velocity_gains)
+	{
+		gains.velocity.velocity_p = this->velocity_p;
+		gains.velocity.velocity_i = this->velocity_i;
+		gains.velocity.vertical_velocity_p = this->vertical_velocity_p;
+		gains.velocity.vertical_velocity_i = this->vertical_velocity_i;
+		gains.velocity.vertical_velocity_d = this->vertical_velocity_d;
+	}
+
+	return gains;
+}
+
+void UPidTuningPresetAsset::store_tuning_result(const physics::FPidTuningResult& result, physics::EPidTuningTarget target)
+{
+	const auto to_unreal_pid = [](const physics::FPidConfig& pid)
+	{
+		return FPidConfig { pid.proportional, pid.integral, pid.derivative };
+	};
+
+	const auto& gains = result.gains;
+	if (target == physics::EPidTuningTarget::velocity_mode)
+	{
+		this->has_velocity_gains = true;
+		this->velocity_p = gains.velocity.velocity_p;
+		this->velocity_i = gains.velocity.velocity_i;
+		this->vertical_velocity_p = gains.velocity.vertical_velocity_p;
+		this->vertical_velocity_i = gains.velocity.vertical_velocity_i;
+		this->vertical_velocity_d = gains.velocity.vertical_velocity_d;
+	}
+	else
+	{
+		this->roll_pid = to_unreal_pid(gains.controller.roll_pid);
+		this->pitch_pid = to_unreal_pid(gains.controller.pitch_pid);
+		this->yaw_pid = to_unreal_pid(gains.controller.yaw_pid);
+	}
+
+	this->tuning_cost = result.score.cost;
+	this->initial_tuning_cost = result.initial_score.cost;
+}
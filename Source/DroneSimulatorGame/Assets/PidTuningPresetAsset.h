@@ -0,0 +1,64 @@
+﻿#pragma once
+
+#include "Runtime/Core/Public/CoreMinimal.h"
+#include "Runtime/Engine/Classes/Engine/DataAsset.h"
+
+#include "DroneSimulatorCore/Public/Controller/PidDroneController.h"
+
+#include "DroneSimulatorPhysics/Public/Controller/PidAutoTuner.h"
+
+#include "PidTuningPresetAsset.generated.h"
+
+/**
+ * Gains of the rate PID, and optionally of the velocity flight mode, written by the auto-tuner of
+ * UDroneMovementComponent. Drones using the preset get its gains on BeginPlay.
+ */
+UCLASS(BlueprintType)
+class DRONESIMULATORGAME_API UPidTuningPresetAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Rate PID", meta=(DisplayName="Roll PID"))
+	FPidConfig roll_pid = FPidConfig { 0.1, 0.0, 0.0 };
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Rate PID", meta=(DisplayName="Pitch PID"))
+	FPidConfig pitch_pid = FPidConfig { 0.1, 0.0, 0.0 };
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Rate PID", meta=(DisplayName="Yaw PID"))
+	FPidConfig yaw_pid = FPidConfig { 0.3, 0.0, 0.0 };
+
+	// Whether the velocity gains below are applied to the velocity flight mode
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Velocity mode", meta=(DisplayName="Has velocity gains"))
+	bool has_velocity_gains = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Velocity mode", meta=(DisplayName="Velocity P gain", EditCondition="has_velocity_gains"))
+	double velocity_p = 2.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Velocity mode", meta=(DisplayName="Velocity I gain", EditCondition="has_velocity_gains"))
+	double velocity_i = 0.5;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Velocity mode", meta=(DisplayName="Vertical Velocity P gain", EditCondition="has_velocity_gains"))
+	double vertical_velocity_p = 0.5;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Velocity mode", meta=(DisplayName="Vertical Velocity I gain", EditCondition="has_velocity_gains"))
+	double vertical_velocity_i = 0.5;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Velocity mode", meta=(DisplayName="Vertical Velocity D gain", EditCondition="has_velocity_gains"))
+	double vertical_velocity_d = 0.05;
+
+	// Score of the gains on the tuning manoeuvres, lower is better, see physics::FTuningScore
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Tuning", meta=(DisplayName="Cost"))
+	double tuning_cost = 0.0;
+
+	// Score of the gains the tuning started from
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Tuning", meta=(DisplayName="Initial cost"))
+	double initial_tuning_cost = 0.0;
+
+	// Replaces the gains of the preset in the given gains, the limits are left as-is
+	physics::FPidTuningGains apply_to(physics::FPidTuningGains gains) const;
+
+	// Stores the tuned gains of the target, the others are kept
+	void store_tuning_result(const physics::FPidTuningResult& result, physics::EPidTuningTarget target);
+};
@@ -7,7 +7,7 @@ public class DroneSimulatorGame : ModuleRules
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "PhysicsCore" });
-		PublicDependencyModuleNames.AddRange(new string[] { "DroneSimulatorInput", "DroneSimulatorCore" });
+		PublicDependencyModuleNames.AddRange(new string[] { "DroneSimulatorInput", "DroneSimulatorCore", "DroneSimulatorPhysics" });
 
 		// PrivateDependencyModuleNames.AddRange(new string[] { "DeveloperSettings" });
 
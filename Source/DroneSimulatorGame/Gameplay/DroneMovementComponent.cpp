@@ -1,15 +1,26 @@
 #include "DroneSimulatorGame/Gameplay/DroneMovementComponent.h"
+#include "DroneSimulatorGame/DroneSimulatorGame.h"
 #include "DroneSimulatorGame/Assets/Conversion.h"
+#include "DroneSimulatorGame/Assets/PidTuningPresetAsset.h"
 #include "DroneSimulatorGame/Gameplay/DronePawn.h"
 #include "DroneSimulatorCore/Public/PropulsionModel/PropulsionModel.h"
-#include "DroneSimulatorCore/Public/Simulation/Inertia.h"
-#include "DroneSimulatorCore/Public/Simulation/LinearDrag.h"
-#include "DroneSimulatorCore/Public/Simulation/RotationalDrag.h"
+#include "DroneSimulatorCore/Public/PropulsionModel/PropulsionModelDynamics.h"
+#include "DroneSimulatorCore/Public/RotorModel/RotorModelBase.h"
+#include "DroneSimulatorCore/Public/Simulation/PhysicsConversion.h"
 #include "DroneSimulatorCore/Public/Controller/FlightModeAir.h"
-#include "DroneSimulatorCore/Public/Simulation/SimulationWorld.h"
-#include "DroneSimulatorCore/Public/Simulation/SubstepBody.h"
+#include "DroneSimulatorCore/Public/Controller/FlightModeVelocity.h"
+#include "DroneSimulatorCore/Public/Controller/PidDroneController.h"
+#include "DroneSimulatorPhysics/Public/Controller/PidAutoTuner.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
 #include "DroneSimulatorInput/Public/DroneInputSubsystem.h"
 #include "DroneSimulatorInput/Public/DroneInputTypes.h"
+#include "Runtime/Engine/Classes/PhysicsEngine/PhysicsSettings.h"
+
+namespace
+{
+	// State hashes recorded between two game ticks, far more than the substeps of a few physics ticks
+	constexpr int32 state_hash_ring_capacity = 1024;
+}
 
 UDroneMovementComponent::UDroneMovementComponent()
 {
@@ -28,12 +39,67 @@ void UDroneMovementComponent::BeginPlay()
 	this->set_updated_component_mass();
 	this->set_updated_component_inertia();
 	this->ensure_default_flight_mode();
+	this->apply_pid_tuning_preset();
+	this->check_deterministic_step();
+
+	this->game_clock = physics::FSubstepClock();
+	this->substep_clock = physics::FSubstepClock();
+	this->recording_substep_index = 0;
+	this->substep_drone_controller = this->find_drone_controller();
+	this->simulation_clock_origin_substep = !this->is_deterministic && this->GetWorld() != nullptr
+		? FMath::RoundToInt64(this->GetWorld()->GetTimeSeconds() * this->tick_rate_hz)
+		: 0;
+	this->held_stage_outputs = physics::FHeldStageOutputs();
+	this->pilot_input_buffer.clear();
+	this->sleep_state = physics::FSleepState();
+	this->render_interpolator.clear();
+	this->imu.config.is_enabled = this->is_imu_enabled;
+	this->imu.config.seed = static_cast<uint64>(this->imu_seed);
+	physics::imu::reset(this->imu);
+	this->gyro_filter.config = this->get_gyro_filter_config();
+	this->gyro_filter.state = physics::FGyroFilterState();
+	this->low_rate_sensors.config = this->get_low_rate_sensors_config();
+	physics::low_rate_sensors::reset(this->low_rate_sensors);
+	this->ground_height_query = [this](const physics::FVector3& location_world) -> std::optional<double>
+	{
+		const auto start = FVector(location_world.X, location_world.Y, location_world.Z);
+		const auto end = start - FVector::UpVector * (this->rangefinder_max_range * 100.0);
+		const FCollisionQueryParams query_params(SCENE_QUERY_STAT(DroneRangefinder), false, this->GetOwner());
+
+		FHitResult hit;
+		if (this->GetWorld()->LineTraceSingleByChannel(hit, start, end, ECC_Visibility, query_params))
+		{
+			return hit.ImpactPoint.Z;
+		}
+		return std::nullopt;
+	};
+	this->state_hash_ring.reset(this->state_hash_interval > 0 ? state_hash_ring_capacity : 0);
+	this->state_hashes.clear();
+}
+
+void UDroneMovementComponent::EndPlay(const EEndPlayReason::Type end_play_reason)
+{
+	// Keeps the count of sleeping drones right when a sleeping drone is removed
+	if (this->sleep_state.is_asleep)
+	{
+		this->record_sleep_transition(physics::ESleepTransition::woken_by_reset);
+		this->sleep_state = physics::FSleepState();
+	}
+
+	Super::EndPlay(end_play_reason);
 }
 
 void UDroneMovementComponent::TickComponent(float delta_time, ELevelTick tick_type, FActorComponentTickFunction* this_tick_function)
 {
 	Super::TickComponent(delta_time, tick_type, this_tick_function);
 
+	const auto hash_spans = this->state_hash_ring.get_read_spans();
+	for (const auto& span : hash_spans)
+	{
+		this->state_hashes.insert(this->state_hashes.end(), span.begin(), span.end());
+	}
+	this->state_hash_ring.release(hash_spans[0].size() + hash_spans[1].size());
+
 	this->player_input = FDronePlayerInput::zero();
 
 	this->ensure_default_flight_mode();
@@ -41,22 +107,204 @@ void UDroneMovementComponent::TickComponent(float delta_time, ELevelTick tick_ty
 
 	this->player_input = this->read_player_input(active_mode);
 	this->controller_input = this->player_input;
+	this->pilot_input_buffer.push(this->get_input_time(), physics_conversion::to_physics(this->controller_input));
+
+	// Outputs of the last physics tick, all from the same substep
+	const auto* published_state = this->read_published_state();
+	if (published_state != nullptr)
+	{
+		this->setpoint = physics_conversion::to_unreal(published_state->setpoint);
+		this->angular_velocity = physics_conversion::to_unreal(published_state->angular_velocity_radians_world);
+
+		if (published_state->rotor_throttle.count == 4)
+		{
+			this->propeller_set_throttle = physics_conversion::to_unreal(published_state->rotor_throttle.to_propeller_set());
+		}
 
-	const auto flight_state = this->build_flight_mode_state(delta_time);
-	this->angular_velocity = flight_state.angular_velocity_world;
+		// Off the physics thread, samples due between two published states are taken on the newest one
+		physics::low_rate_sensors::update(this->low_rate_sensors, *published_state, this->ground_height_query);
+	}
 
-	this->setpoint = active_mode != nullptr
-		? active_mode->compute_setpoint(this->player_input, flight_state)
-		: FDroneSetpoint(0.0, FVector::ZeroVector);
+	this->update_render_interpolation(published_state, delta_time);
+
+	// The flight mode itself runs on every substep, see calculate_custom_physics
+	const auto flight_state = this->build_flight_mode_state(published_state, delta_time);
 
 	const auto vertical_speed = flight_state.linear_velocity_world.Z * 3.6;
 	const auto horizontal_speed = flight_state.linear_velocity_world.Size2D() * 3.6;
 
 	GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Red, FString::Printf(TEXT("Speed (km/h): Vertical=%.1f - Horizontal=%.1f"), vertical_speed, horizontal_speed));
 
+	// A sleeping drone doesn't wake its rigid body nor register its custom physics
+	if (this->update_sleep(flight_state, delta_time))
+	{
+		this->skip_sleeping_substeps(delta_time);
+
+		// No physics state while asleep, the first one after waking up starts a new interpolation
+		this->render_interpolator.clear();
+		return;
+	}
+
+	auto& pilot_command = this->state_exchange.pilot_command.get_write_slot();
+	pilot_command.pilot_input_buffer = this->pilot_input_buffer;
+	pilot_command.is_armed = this->is_armed;
+	pilot_command.clock = this->game_clock;
+	pilot_command.sleep_state = this->sleep_state;
+	this->state_exchange.pilot_command.publish();
+
 	this->enqueue_custom_physics();
 }
 
+void UDroneMovementComponent::set_interpolated_component(USceneComponent* component)
+{
+	this->interpolated_component = component;
+}
+
+void UDroneMovementComponent::update_render_interpolation(const physics::FPublishedDroneState* published_state, float delta_time)
+{
+	if (published_state != nullptr)
+	{
+		this->render_interpolator.push(published_state->simulation_time, published_state->transform_world);
+	}
+
+	if (this->is_render_interpolation_enabled && this->render_interpolator.count > 0)
+	{
+		this->interpolated_transform = physics_conversion::to_unreal(this->render_interpolator.advance(delta_time));
+	}
+	else if (this->UpdatedComponent != nullptr)
+	{
+		this->interpolated_transform = this->UpdatedComponent->GetComponentTransform();
+	}
+
+	if (this->interpolated_component != nullptr)
+	{
+		this->interpolated_component->SetWorldLocationAndRotation(this->interpolated_transform.GetLocation(),
+			this->interpolated_transform.GetRotation(), false, nullptr, ETeleportType::TeleportPhysics);
+	}
+}
+
+const physics::FPublishedDroneState* UDroneMovementComponent::read_published_state()
+{
+	const auto* published_state = physics::state_exchange::read_current(this->state_exchange.drone_state, this->is_published_state_stale,
+		this->sleep_state.is_asleep);
+
+	// The physics side owns the clock while it runs. A state from before the last hand-over is on the old clock.
+	if (published_state != nullptr && published_state->clock_revision == this->game_clock.revision)
+	{
+		this->game_clock.substep_index = published_state->substep_index;
+		this->game_clock.remaining_time_accumulator = published_state->remaining_time_accumulator;
+	}
+
+	return published_state;
+}
+
+void UDroneMovementComponent::publish_drone_state(const physics::FSubstepBody& substep_body, const FDroneSetpoint& substep_setpoint,
+	const UFlightModeBase* active_mode)
+{
+	// The propulsion model and the flight mode already know how to write their state to a snapshot
+	physics::FDroneSimulationSnapshot snapshot;
+	snapshot.transform_world = substep_body.transform_world;
+	snapshot.linear_velocity_world = substep_body.linear_velocity_world;
+	snapshot.angular_velocity_radians_world = substep_body.angular_velocity_radians_world;
+	snapshot.substep_index = this->substep_clock.substep_index;
+	snapshot.remaining_time_accumulator = this->substep_clock.remaining_time_accumulator;
+	snapshot.setpoint = physics_conversion::to_physics(substep_setpoint);
+
+	if (this->propulsion_model != nullptr)
+	{
+		this->propulsion_model->save_state(snapshot);
+	}
+
+	if (active_mode != nullptr)
+	{
+		active_mode->save_state(snapshot);
+	}
+
+	auto published_state = physics::state_exchange::from_snapshot(snapshot, this->tick_rate_hz);
+	published_state.clock_revision = this->substep_clock.revision;
+	this->state_exchange.drone_state.publish(published_state);
+}
+
+void UDroneMovementComponent::set_armed(bool in_is_armed)
+{
+	this->is_armed = in_is_armed;
+}
+
+int64 UDroneMovementComponent::get_num_sleeping_drones()
+{
+	return physics::FSleepStatistics::get().get_num_asleep();
+}
+
+physics::FSleepConfig UDroneMovementComponent::get_sleep_config() const
+{
+	physics::FSleepConfig config;
+	config.is_enabled = this->is_sleep_enabled;
+	config.max_linear_speed = this->sleep_max_linear_speed;
+	config.max_angular_speed = this->sleep_max_angular_speed;
+	config.time_to_sleep = this->time_to_sleep;
+	return config;
+}
+
+bool UDroneMovementComponent::update_sleep(const FFlightModeState& flight_state, float delta_time)
+{
+	auto linear_velocity = physics_conversion::to_physics(flight_state.linear_velocity_world);
+	auto angular_velocity_radians = physics_conversion::to_physics(flight_state.angular_velocity_world);
+
+	// Gravity is applied by the substeps: a drone that stays at rest for time_to_sleep is supported by something
+	const auto is_in_contact = true;
+
+	const auto transition = physics::sleep::update(this->sleep_state, this->get_sleep_config(), this->is_armed,
+		physics_conversion::to_physics(this->controller_input), is_in_contact, linear_velocity, angular_velocity_radians,
+		delta_time);
+	this->record_sleep_transition(transition);
+
+	if (transition == physics::ESleepTransition::fell_asleep)
+	{
+		if (auto* primitive_component = this->get_primitive_component())
+		{
+			primitive_component->SetPhysicsLinearVelocity(FVector::ZeroVector);
+			primitive_component->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector);
+			primitive_component->PutRigidBodyToSleep();
+		}
+	}
+
+	return this->sleep_state.is_asleep;
+}
+
+void UDroneMovementComponent::record_sleep_transition(physics::ESleepTransition transition)
+{
+	if (transition == physics::ESleepTransition::none)
+	{
+		return;
+	}
+
+	physics::FSleepStatistics::get().record(transition);
+
+	UE_LOG(LogDroneSimulatorGame, Verbose, TEXT("%s %s, %lld drones asleep"), *this->GetOwner()->GetName(),
+		UTF8_TO_TCHAR(physics::sleep::get_transition_name(transition)), physics::FSleepStatistics::get().get_num_asleep());
+}
+
+void UDroneMovementComponent::skip_sleeping_substeps(float delta_time)
+{
+	// The clock keeps running while asleep, so that the input timestamps and the recorded times stay valid. The physics
+	// side takes it over on waking up.
+	auto& clock = this->game_clock;
+	clock.revision++;
+
+	if (this->is_deterministic)
+	{
+		clock.substep_index += this->deterministic_substeps_per_physics_tick;
+		return;
+	}
+
+	const auto substep_duration = 1.0 / this->tick_rate_hz;
+	clock.remaining_time_accumulator += delta_time;
+	for (; clock.remaining_time_accumulator >= substep_duration; clock.remaining_time_accumulator -= substep_duration)
+	{
+		clock.substep_index++;
+	}
+}
+
 void UDroneMovementComponent::set_updated_component_mass()
 {
 	auto* primitive_component = get_primitive_component();
@@ -65,11 +313,7 @@ void UDroneMovementComponent::set_updated_component_mass()
 		return;
 	}
 
-	const double frame_mass = this->frame.IsSet() ? this->frame.GetValue().mass : 0.0;
-	const double battery_mass = this->battery.IsSet() ? this->battery.GetValue().mass : 0.0;
-	const double motor_mass = this->motor.IsSet() ? this->motor.GetValue().mass : 0.0;
-
-	const double total_mass = frame_mass + battery_mass + 4.0 * motor_mass;
+	const double total_mass = this->drone_model->total_mass;
 
 	primitive_component->SetMassOverrideInKg(NAME_None, total_mass);
 }
@@ -82,7 +326,8 @@ void UDroneMovementComponent::set_updated_component_inertia()
 		return;
 	}
 
-	const auto inertia = inertia::compute_inertia_uu(this->frame, this->motor, this->battery);
+	// The drone model is in kg·m², Chaos in kg·cm²
+	const FVector inertia = physics_conversion::to_unreal(this->drone_model->inertia_tensor) * 10000.0;
 
 	auto physics_handle = primitive_component->GetBodyInstance()->GetPhysicsActorHandle();
 	FPhysicsCommand::ExecuteWrite(physics_handle, [inertia](auto handle)
@@ -98,6 +343,28 @@ void UDroneMovementComponent::init_drone_parts()
 	this->motor = this->motor_asset == nullptr ? TOptional<FDroneMotor>() : conversion::convert_motor_asset(this->motor_asset);
 	this->battery = this->battery_asset == nullptr ? TOptional<FDroneBattery>() : conversion::convert_battery_asset(this->battery_asset);
 	this->propeller = this->propeller_asset == nullptr ? TOptional<TDronePropeller>() : conversion::convert_propeller_asset(this->propeller_asset);
+
+	const auto get_asset_path = [](const UObject* asset)
+	{
+		return asset != nullptr ? asset->GetPathName() : FString();
+	};
+
+	const auto model_key = FString::Join(TArray<FString> {
+		get_asset_path(this->frame_asset),
+		get_asset_path(this->motor_asset),
+		get_asset_path(this->battery_asset),
+		get_asset_path(this->propeller_asset),
+	}, TEXT("|"));
+
+	this->drone_model = physics::FDroneModelCache::get().find_or_compile(TCHAR_TO_UTF8(*model_key), [this]
+	{
+		physics::FDroneParts parts;
+		parts.frame = physics_conversion::to_physics(this->frame);
+		parts.motor = physics_conversion::to_physics(this->motor);
+		parts.battery = physics_conversion::to_physics(this->battery);
+		parts.propeller = physics_conversion::to_physics(this->propeller);
+		return parts;
+	});
 }
 
 void UDroneMovementComponent::enqueue_custom_physics()
@@ -114,103 +381,532 @@ void UDroneMovementComponent::enqueue_custom_physics()
 
 void UDroneMovementComponent::calculate_custom_physics(float delta_time, FBodyInstance* body_instance)
 {
-	auto substep_body = FSubstepBody::from_body_instance(body_instance);
+	auto substep_body = physics_conversion::substep_body_from_body_instance(body_instance);
+
+	// Everything the substeps read from the game thread is read once, before the first substep
+	const auto& pilot_command = this->state_exchange.pilot_command.read();
+	const auto& substep_input_buffer = pilot_command.pilot_input_buffer;
+	auto* active_mode = this->get_active_flight_mode();
+	auto* drone_pawn = Cast<ADronePawn>(this->GetPawnOwner());
+	const auto* world = this->GetWorld();
+	const auto world_time_seconds = world != nullptr ? world->GetTimeSeconds() : 0.0;
+
+	// The game side set the clock while the substeps didn't run. The recording follows it when it ran on while asleep,
+	// not when a restore rewound it.
+	auto& clock = this->substep_clock;
+	if (pilot_command.clock.revision != clock.revision)
+	{
+		this->recording_substep_index += FMath::Max<int64>(pilot_command.clock.substep_index - clock.substep_index, 0);
+		clock = pilot_command.clock;
+	}
 
 	const auto substep_duration = 1.0 / this->tick_rate_hz;
-	this->remaining_time_accumulator += delta_time;
+	const auto schedule = this->get_schedule();
 
-	bool has_ticked = false;
-	for (; this->remaining_time_accumulator >= substep_duration; this->remaining_time_accumulator -= substep_duration)
+	int32 substep_count = 0;
+	if (this->is_deterministic)
+	{
+		substep_count = this->deterministic_substeps_per_physics_tick;
+	}
+	else
+	{
+		clock.remaining_time_accumulator += delta_time;
+		for (; clock.remaining_time_accumulator >= substep_duration; clock.remaining_time_accumulator -= substep_duration)
+		{
+			substep_count++;
+		}
+	}
+
+	auto substep_setpoint = FDroneSetpoint(0.0, FVector::ZeroVector);
+
+	for (int32 substep = 0; substep < substep_count; substep++)
 	{
-		has_ticked = true;
 		const auto substep_delta_time = substep_duration;
+		const auto stages = schedule.get_stages(clock.substep_index, this->tick_rate_hz);
+
+		// World time the substep starts at. The substeps of a physics tick end at its world time, less what is left for
+		// the next tick.
+		const auto substep_world_time = world_time_seconds - (this->is_deterministic ? 0.0 : clock.remaining_time_accumulator)
+			- (substep_count - substep) * substep_duration;
+
+		// Start time of the substep, on the clock of the input buffer
+		const auto substep_start_time = this->is_deterministic ? this->get_substep_time() : substep_world_time;
+
+		const auto substep_controller_input = physics_conversion::to_unreal(substep_input_buffer.sample(substep_start_time));
+
+		// Outer loops (angle, velocity) run at the substep rate, on the substep body instead of the component state
+		substep_setpoint = active_mode != nullptr
+			? active_mode->compute_setpoint(substep_controller_input, this->build_flight_mode_state(substep_body, substep_delta_time))
+			: FDroneSetpoint(0.0, FVector::ZeroVector);
 
-		this->calculate_thrust_custom_physics(substep_delta_time, &substep_body);
+		physics::multi_rate::sample_environment(this->held_stage_outputs, this->simulation_world, stages);
+
+		// Controllers running their own flight modes, like SITL firmware, read the sticks and the body themselves
+		if (this->substep_drone_controller != nullptr)
+		{
+			this->substep_drone_controller->prepare_substep(substep_body, substep_controller_input, pilot_command.is_armed, substep_start_time);
+		}
+
+		this->propulsion_info.Reset();
+		if (pilot_command.is_armed)
+		{
+			this->calculate_thrust_custom_physics(substep_delta_time, &substep_body, substep_setpoint, stages);
+		}
 
 		// Apply gravity
-		substep_body.add_force(FVector(0.0, 0.0, -9.81 * substep_body.mass));
-		this->calculate_drag_custom_physics(substep_delta_time, &substep_body);
+		substep_body.add_force(physics::FVector3(0.0, 0.0, -9.81 * substep_body.mass));
+		this->calculate_drag_custom_physics(substep_delta_time, &substep_body, stages);
 
-		this->record_flight_data(&substep_body);
+		// Stamped with the recording clock, which advances by exactly one substep per substep and never goes back, so
+		// that recorded times are strictly increasing and evenly spaced even when a physics tick runs several substeps
+		// or a snapshot is restored
+		if (stages.recording)
+		{
+			const auto recorded_time = static_cast<double>(this->simulation_clock_origin_substep + this->recording_substep_index) / this->tick_rate_hz;
+			this->record_flight_data(drone_pawn, &substep_body, recorded_time, substep_world_time, substep_controller_input);
+		}
+
+		if (this->imu.config.is_enabled && stages.imu)
+		{
+			this->sample_imu(substep_body, pilot_command.is_armed, this->get_substep_time(), stages.imu_delta_time);
+		}
 
 		substep_body.consume_forces_and_torques(substep_delta_time);
+
+		// Chaos moves the body once per physics tick. The local transform only moves so that the next substeps see the
+		// attitude change.
+		substep_body.integrate_transform(substep_delta_time);
+
+		clock.substep_index++;
+		this->recording_substep_index++;
+		if (this->state_hash_interval > 0 && clock.substep_index % this->state_hash_interval == 0)
+		{
+			this->state_hash_ring.push(physics::FStateHashEntry { clock.substep_index,
+				this->compute_state_hash(substep_body, substep_setpoint, pilot_command) });
+		}
 	}
 
-	if (!has_ticked)
+	if (substep_count == 0)
 	{
 		return;
 	}
 
-	const auto linear_velocity_uu = substep_body.linear_velocity_world * 100.0;
-	const auto angular_velocity_uu = substep_body.angular_velocity_radians_world;
+	this->publish_drone_state(substep_body, substep_setpoint, active_mode);
+
+	const auto linear_velocity_uu = physics_conversion::to_unreal(substep_body.linear_velocity_world) * 100.0;
+	const auto angular_velocity_uu = physics_conversion::to_unreal(substep_body.angular_velocity_radians_world);
 
-	this->angular_velocity = substep_body.angular_velocity_radians_world;
 	body_instance->SetLinearVelocity(linear_velocity_uu, false);
 	body_instance->SetAngularVelocityInRadians(angular_velocity_uu, false);
 }
 
-void UDroneMovementComponent::calculate_thrust_custom_physics(float delta_time, FSubstepBody* substep_body)
+double UDroneMovementComponent::get_simulation_time() const
+{
+	return static_cast<double>(this->game_clock.substep_index) / this->tick_rate_hz;
+}
+
+void UDroneMovementComponent::check_deterministic_step() const
+{
+	if (!this->is_deterministic)
+	{
+		return;
+	}
+
+	const auto* physics_settings = UPhysicsSettings::Get();
+	const auto substeps_duration = this->deterministic_substeps_per_physics_tick / this->tick_rate_hz;
+
+	if (!physics_settings->bTickPhysicsAsync)
+	{
+		UE_LOG(LogDroneSimulatorGame, Error, TEXT("%s: deterministic mode needs a fixed physics step, tick the physics asynchronously with a fixed step of %.6f s"),
+			*this->GetName(), substeps_duration);
+		return;
+	}
+
+	if (!FMath::IsNearlyEqual(static_cast<double>(physics_settings->AsyncFixedTimeStepSize), substeps_duration, 1e-6))
+	{
+		UE_LOG(LogDroneSimulatorGame, Error, TEXT("%s: %d substeps at %.1f Hz last %.6f s but the physics step is %.6f s, the simulation clock drifts from the world"),
+			*this->GetName(), this->deterministic_substeps_per_physics_tick, this->tick_rate_hz, substeps_duration,
+			physics_settings->AsyncFixedTimeStepSize);
+	}
+}
+
+double UDroneMovementComponent::get_substep_time() const
+{
+	return static_cast<double>(this->substep_clock.substep_index) / this->tick_rate_hz;
+}
+
+physics::FGyroFilterConfig UDroneMovementComponent::get_gyro_filter_config() const
+{
+	physics::FGyroFilterConfig config;
+	config.is_enabled = this->is_gyro_filter_enabled;
+	config.lowpass_type = this->is_gyro_lowpass_second_order ? physics::EGyroLowpassType::biquad : physics::EGyroLowpassType::pt1;
+	config.lowpass_cutoff_hz = this->gyro_lowpass_cutoff_hz;
+	config.rpm_harmonic_count = this->rpm_filter_harmonic_count;
+	config.rpm_notch_q = this->rpm_filter_q;
+	return config;
+}
+
+bool UDroneMovementComponent::pop_sensor_sample(physics::FLowRateSensorSample& out_sample)
+{
+	return this->low_rate_sensors.samples.pop(out_sample);
+}
+
+physics::FLowRateSensorsConfig UDroneMovementComponent::get_low_rate_sensors_config() const
+{
+	physics::FLowRateSensorsConfig config;
+	config.seed = static_cast<uint64>(this->imu_seed);
+	config.barometer.timing = physics::FLowRateSensorTiming { this->is_barometer_enabled, this->barometer_rate_hz, this->barometer_latency };
+	config.barometer.altitude_noise = this->barometer_noise;
+	config.gps.timing = physics::FLowRateSensorTiming { this->is_gps_enabled, this->gps_rate_hz, this->gps_latency };
+	config.gps.horizontal_position_error = this->gps_position_error;
+	config.magnetometer.timing = physics::FLowRateSensorTiming { this->is_magnetometer_enabled, this->magnetometer_rate_hz, this->magnetometer_latency };
+	config.magnetometer.field_noise = this->magnetometer_noise;
+	config.rangefinder.timing = physics::FLowRateSensorTiming { this->is_rangefinder_enabled, this->rangefinder_rate_hz, this->rangefinder_latency };
+	config.rangefinder.max_range = this->rangefinder_max_range;
+	return config;
+}
+
+physics::FMultiRateSchedule UDroneMovementComponent::get_schedule() const
+{
+	physics::FMultiRateSchedule schedule;
+	schedule.controller_rate_hz = this->controller_rate_hz;
+	schedule.rotor_aerodynamics_rate_hz = this->rotor_aerodynamics_rate_hz;
+	schedule.drag_rate_hz = this->drag_rate_hz;
+	schedule.environment_sampling_rate_hz = this->environment_sampling_rate_hz;
+	schedule.recording_rate_hz = this->recording_rate_hz;
+	schedule.imu_rate_hz = this->imu_rate_hz;
+	return schedule;
+}
+
+void UDroneMovementComponent::sample_imu(const physics::FSubstepBody& substep_body, bool is_substep_armed, double time, double delta_time)
 {
-	if (this->propulsion_model == nullptr || !this->frame.IsSet() || !this->motor.IsSet() || !this->battery.IsSet() || !this->propeller.IsSet())
+	// The rotors only vibrate the frame while they spin. The count stays that of the frame, so that the RPM filter keeps
+	// its layout.
+	const auto* dynamics = Cast<UPropulsionModelDynamics>(this->propulsion_model);
+	auto rotor_throttle = dynamics != nullptr && is_substep_armed ? dynamics->get_held_outputs().throttle : physics::FRotorSetThrottle();
+	rotor_throttle.count = FMath::Min(static_cast<int32>(this->drone_model->rotors.size()), physics::max_rotor_count);
+
+	const auto& model = *this->drone_model;
+	const auto max_rotor_speed = model.has_propulsion() ? model.parts.motor->kv * model.parts.battery->voltage : 0.0;
+
+	const auto& sample = physics::imu::sample(this->imu, substep_body, rotor_throttle, max_rotor_speed, time, delta_time);
+
+	if (delta_time > 0.0)
 	{
+		physics::gyro_filter::retune(this->gyro_filter, rotor_throttle, max_rotor_speed, 1.0 / delta_time);
+		physics::gyro_filter::apply(this->gyro_filter, sample.angular_velocity);
+	}
+}
+
+const physics::FVector3* UDroneMovementComponent::get_gyro_angular_velocity() const
+{
+	return this->gyro_filter.state.has_output ? &this->gyro_filter.state.output : nullptr;
+}
+
+uint64 UDroneMovementComponent::compute_state_hash(const physics::FSubstepBody& substep_body, const FDroneSetpoint& substep_setpoint,
+	const physics::FPublishedPilotCommand& pilot_command) const
+{
+	physics::FStateHasher hasher;
+	hasher.add(substep_body);
+	hasher.add(physics_conversion::to_physics(substep_setpoint));
+	hasher.add(this->substep_clock.remaining_time_accumulator);
+	hasher.add(this->held_stage_outputs);
+	hasher.add(pilot_command.pilot_input_buffer);
+	hasher.add(pilot_command.sleep_state);
+	hasher.add(this->imu.state.gyro_bias);
+	hasher.add(this->imu.state.accel_bias);
+	hasher.add(static_cast<uint64>(this->imu.samples.sample_count));
+	hasher.add(this->gyro_filter.state.output);
+	for (int32 stage = 0; stage < this->gyro_filter.state.stage_count; stage++)
+	{
+		hasher.add(this->gyro_filter.state.stages[stage].z1);
+		hasher.add(this->gyro_filter.state.stages[stage].z2);
+	}
+
+	if (this->propulsion_model != nullptr)
+	{
+		this->propulsion_model->hash_state(hasher);
+	}
+
+	return hasher.value;
+}
+
+void UDroneMovementComponent::auto_tune_pid()
+{
+	auto* pid_controller = this->find_pid_controller();
+	auto* velocity_flight_mode = this->find_velocity_flight_mode();
+	if (pid_controller == nullptr || (this->is_tuning_velocity_mode && velocity_flight_mode == nullptr))
+	{
+		UE_LOG(LogDroneSimulatorGame, Warning, TEXT("%s: auto-tuning needs a PID controller, and a velocity flight mode to tune it"),
+			*this->GetName());
+		return;
+	}
+
+	const auto drone = this->build_tuning_simulation();
+	if (!drone.IsSet())
+	{
+		UE_LOG(LogDroneSimulatorGame, Warning, TEXT("%s: the drone parts or the rotor model can't be simulated headless"),
+			*this->GetName());
 		return;
 	}
 
-	const auto frame_value = this->frame.GetValue();
-	const auto motor_value = this->motor.GetValue();
-	const auto battery_value = this->battery.GetValue();
-	const auto propeller_value = this->propeller.GetValue();
+	physics::FPidTuningConfig config;
+	config.target = this->is_tuning_velocity_mode ? physics::EPidTuningTarget::velocity_mode : physics::EPidTuningTarget::rate_pid;
+	config.max_generations = this->tuning_generations;
+
+	const auto result = physics::FPidAutoTuner().tune(drone.GetValue(), config);
+	if (!result.has_value())
+	{
+		return;
+	}
+
+	UE_LOG(LogDroneSimulatorGame, Log, TEXT("%s: tuned in %d generations, %d evaluations, cost %f -> %f"), *this->GetName(),
+		result->generation_count, result->evaluation_count, result->initial_score.cost, result->score.cost);
+
+	if (this->pid_tuning_preset != nullptr)
+	{
+		this->pid_tuning_preset->Modify();
+		this->pid_tuning_preset->store_tuning_result(*result, config.target);
+		this->pid_tuning_preset->MarkPackageDirty();
+		return;
+	}
+
+	if (this->is_tuning_velocity_mode)
+	{
+		velocity_flight_mode->Modify();
+		velocity_flight_mode->set_physics_config(result->gains.velocity);
+	}
+	else
+	{
+		pid_controller->Modify();
+		pid_controller->set_physics_config(result->gains.controller);
+	}
+}
+
+UDroneController* UDroneMovementComponent::find_drone_controller() const
+{
+	const auto* dynamics = Cast<UPropulsionModelDynamics>(this->propulsion_model);
+	return dynamics != nullptr ? dynamics->drone_controller : nullptr;
+}
+
+UPidDroneController* UDroneMovementComponent::find_pid_controller() const
+{
+	return Cast<UPidDroneController>(this->find_drone_controller());
+}
+
+UFlightModeVelocity* UDroneMovementComponent::find_velocity_flight_mode() const
+{
+	for (const auto& [name, flight_mode] : this->flight_modes)
+	{
+		if (auto* velocity_flight_mode = Cast<UFlightModeVelocity>(flight_mode))
+		{
+			return velocity_flight_mode;
+		}
+	}
+	return nullptr;
+}
+
+TOptional<physics::FDroneSimulation> UDroneMovementComponent::build_tuning_simulation()
+{
+	const auto* dynamics = Cast<UPropulsionModelDynamics>(this->propulsion_model);
+	const auto* pid_controller = this->find_pid_controller();
+	if (dynamics == nullptr || dynamics->rotor_model == nullptr || pid_controller == nullptr)
+	{
+		return TOptional<physics::FDroneSimulation>();
+	}
+
+	const auto rotor_model = dynamics->rotor_model->get_physics_rotor_model();
+	if (!rotor_model.IsSet())
+	{
+		return TOptional<physics::FDroneSimulation>();
+	}
 
-	const auto drone_setup = FPropulsionDroneSetup(&frame_value, &motor_value, &battery_value, &propeller_value);
+	// Also called from the editor, before any BeginPlay
+	this->init_drone_parts();
+	if (!this->drone_model->has_propulsion())
+	{
+		return TOptional<physics::FDroneSimulation>();
+	}
 
-	auto* simulation_world = NewObject<USimulationWorld>();
+	physics::FDroneSimulation drone;
+	drone.model = this->drone_model;
+	drone.propulsion_model = physics::FPropulsionModelDynamics {
+		physics::FPidDroneController { pid_controller->get_physics_config() },
+		rotor_model.GetValue(),
+	};
+	drone.tick_rate_hz = this->tick_rate_hz;
+	drone.schedule = this->get_schedule();
+
+	const auto* velocity_flight_mode = this->find_velocity_flight_mode();
+	if (velocity_flight_mode != nullptr)
+	{
+		drone.flight_mode = physics::FFlightModeVelocity { velocity_flight_mode->get_physics_config() };
+	}
 
-	this->propulsion_model->tick_propulsion(delta_time, substep_body, this->setpoint, drone_setup, simulation_world);
+	// In open air: the headless simulation has no ground
+	drone.reset_body(physics::FVector3::zero(), physics::FQuaternion::identity());
+	return drone;
 }
 
-void UDroneMovementComponent::calculate_drag_custom_physics(float delta_time, FSubstepBody* substep_body)
+void UDroneMovementComponent::apply_pid_tuning_preset()
 {
-	if (!this->frame.IsSet() || !this->propeller.IsSet())
+	if (this->pid_tuning_preset == nullptr)
 	{
 		return;
 	}
 
-	const auto frame_value = this->frame.GetValue();
-	const auto propeller_value = this->propeller.GetValue();
-	auto* simulation_world = NewObject<USimulationWorld>();
+	auto* pid_controller = this->find_pid_controller();
+	auto* velocity_flight_mode = this->find_velocity_flight_mode();
+
+	physics::FPidTuningGains gains;
+	if (pid_controller != nullptr)
+	{
+		gains.controller = pid_controller->get_physics_config();
+	}
+	if (velocity_flight_mode != nullptr)
+	{
+		gains.velocity = velocity_flight_mode->get_physics_config();
+	}
+
+	gains = this->pid_tuning_preset->apply_to(gains);
+
+	if (pid_controller != nullptr)
+	{
+		pid_controller->set_physics_config(gains.controller);
+	}
+	if (velocity_flight_mode != nullptr)
+	{
+		velocity_flight_mode->set_physics_config(gains.velocity);
+	}
+}
+
+void UDroneMovementComponent::calculate_thrust_custom_physics(float delta_time, physics::FSubstepBody* substep_body,
+	const FDroneSetpoint& substep_setpoint, const physics::FSubstepStages& stages)
+{
+	const auto& model = *this->drone_model;
+	if (this->propulsion_model == nullptr || !model.has_propulsion())
+	{
+		return;
+	}
 
-	simulation::calculate_linear_drag(substep_body, frame_value, propeller_value, simulation_world);
+	const auto propeller_set_info = this->propulsion_model->tick_propulsion(delta_time, substep_body, substep_setpoint,
+		model.get_propulsion_setup(), &this->held_stage_outputs.sampled_world, stages, this->get_gyro_angular_velocity());
 
-	simulation::calculate_rotational_drag(substep_body, frame_value, simulation_world);
+	if (propeller_set_info.IsSet())
+	{
+		this->propulsion_info = FPropulsionInfo::from_simulation_output(propeller_set_info.GetValue());
+	}
 }
 
-void UDroneMovementComponent::record_flight_data(FSubstepBody* substep_body)
+void UDroneMovementComponent::calculate_drag_custom_physics(float delta_time, physics::FSubstepBody* substep_body,
+	const physics::FSubstepStages& stages)
 {
-	auto* pawn = this->GetPawnOwner();
-	auto* drone_pawn = Cast<ADronePawn>(pawn);
-	auto* world = this->GetWorld();
+	physics::multi_rate::apply_drag(this->held_stage_outputs, substep_body, *this->drone_model, stages);
+}
 
-	if (drone_pawn == nullptr || world == nullptr || substep_body == nullptr)
+void UDroneMovementComponent::record_flight_data(ADronePawn* drone_pawn, physics::FSubstepBody* substep_body, double time_seconds,
+	double world_time_seconds, const FDronePlayerInput& recorded_input)
+{
+	if (drone_pawn == nullptr || substep_body == nullptr)
 	{
 		return;
 	}
 
-	const auto time_seconds = world->GetTimeSeconds();
+	const auto sample = FFlightRecordSample::from_simulation(time_seconds, world_time_seconds, *substep_body, recorded_input,
+		this->propulsion_info);
+	drone_pawn->enqueue_flight_record(sample.telemetry);
 
-	const auto transform = substep_body->transform_world;
-	const auto velocity = substep_body->linear_velocity_world;
+	if (drone_pawn->enable_debug_recording && this->propulsion_info.IsSet())
+	{
+		drone_pawn->enqueue_flight_record_debug(FFlightRecordDebugEvent(NAME_None, time_seconds, this->propulsion_info.GetValue()));
+	}
+}
 
-	// Create event data with all properties
-	const auto event_data = FFlightRecordEventData(
-		transform.GetLocation(),
-		transform.GetRotation().Rotator(),
-		velocity,
-		this->angular_velocity,
-		this->controller_input,
-		this->propulsion_info
-	);
+physics::FDroneSimulationSnapshot UDroneMovementComponent::save_snapshot()
+{
+	physics::FDroneSimulationSnapshot snapshot;
 
-	drone_pawn->enqueue_flight_record({ FFlightRecordPawnEvent(time_seconds, event_data) });
+	if (auto* primitive_component = this->get_primitive_component())
+	{
+		const auto substep_body = physics_conversion::substep_body_from_body_instance(primitive_component->GetBodyInstance());
+		snapshot.transform_world = substep_body.transform_world;
+		snapshot.mass = substep_body.mass;
+		snapshot.inertia_tensor = substep_body.inertia_tensor;
+		snapshot.linear_velocity_world = substep_body.linear_velocity_world;
+		snapshot.angular_velocity_radians_world = substep_body.angular_velocity_radians_world;
+	}
+
+	snapshot.remaining_time_accumulator = this->game_clock.remaining_time_accumulator;
+	snapshot.substep_index = this->game_clock.substep_index;
+	snapshot.setpoint = physics_conversion::to_physics(this->setpoint);
+	snapshot.pilot_input_buffer = this->pilot_input_buffer;
+	snapshot.is_armed = this->is_armed;
+	snapshot.sleep_state = this->sleep_state;
+	snapshot.held_stage_outputs = this->held_stage_outputs;
+	snapshot.imu_gyro_bias = this->imu.state.gyro_bias;
+	snapshot.imu_accel_bias = this->imu.state.accel_bias;
+	snapshot.imu_rotor_angles = this->imu.state.rotor_angles;
+	snapshot.imu_sample_count = this->imu.samples.sample_count;
+	snapshot.gyro_filter_state = this->gyro_filter.state;
+
+	if (this->propulsion_model != nullptr)
+	{
+		this->propulsion_model->save_state(snapshot);
+	}
+
+	if (const auto* active_mode = this->get_active_flight_mode())
+	{
+		active_mode->save_state(snapshot);
+	}
+
+	return snapshot;
+}
+
+void UDroneMovementComponent::restore_snapshot(const physics::FDroneSimulationSnapshot& snapshot)
+{
+	if (auto* primitive_component = this->get_primitive_component())
+	{
+		auto* body_instance = primitive_component->GetBodyInstance();
+		body_instance->SetBodyTransform(physics_conversion::to_unreal(snapshot.transform_world), ETeleportType::TeleportPhysics);
+		body_instance->SetLinearVelocity(physics_conversion::to_unreal(snapshot.linear_velocity_world) * 100.0, false);
+		body_instance->SetAngularVelocityInRadians(physics_conversion::to_unreal(snapshot.angular_velocity_radians_world), false);
+	}
+
+	// Handed over to the physics side with the next pilot command
+	this->game_clock.substep_index = snapshot.substep_index;
+	this->game_clock.remaining_time_accumulator = snapshot.remaining_time_accumulator;
+	this->game_clock.revision++;
+	this->setpoint = physics_conversion::to_unreal(snapshot.setpoint);
+	this->pilot_input_buffer = snapshot.pilot_input_buffer;
+	this->is_armed = snapshot.is_armed;
+
+	if (this->sleep_state.is_asleep != snapshot.sleep_state.is_asleep)
+	{
+		this->record_sleep_transition(snapshot.sleep_state.is_asleep ? physics::ESleepTransition::fell_asleep : physics::ESleepTransition::woken_by_reset);
+	}
+	this->sleep_state = snapshot.sleep_state;
+	this->held_stage_outputs = snapshot.held_stage_outputs;
+	physics::imu::reset(this->imu);
+	this->imu.state.gyro_bias = snapshot.imu_gyro_bias;
+	this->imu.state.accel_bias = snapshot.imu_accel_bias;
+	this->imu.state.rotor_angles = snapshot.imu_rotor_angles;
+	this->imu.samples.sample_count = snapshot.imu_sample_count;
+	this->gyro_filter.state = snapshot.gyro_filter_state;
+	this->angular_velocity = physics_conversion::to_unreal(snapshot.angular_velocity_radians_world);
+
+	// What the physics side published last is from before the restore
+	this->is_published_state_stale = true;
+	this->render_interpolator.clear();
+
+	if (this->propulsion_model != nullptr)
+	{
+		this->propulsion_model->restore_state(snapshot);
+	}
+
+	if (auto* active_mode = this->get_active_flight_mode())
+	{
+		active_mode->restore_state(snapshot);
+	}
 }
 
 bool UDroneMovementComponent::set_active_flight_mode(FName flight_mode_name)
@@ -306,11 +1002,19 @@ FDronePlayerInput UDroneMovementComponent::read_player_input(const UFlightModeBa
 	return input;
 }
 
-FFlightModeState UDroneMovementComponent::build_flight_mode_state(float delta_time) const
+FFlightModeState UDroneMovementComponent::build_flight_mode_state(const physics::FPublishedDroneState* published_state, float delta_time) const
 {
 	FFlightModeState flight_state;
 	flight_state.delta_time = delta_time;
 
+	if (published_state != nullptr)
+	{
+		flight_state.linear_velocity_world = physics_conversion::to_unreal(published_state->linear_velocity_world);
+		flight_state.angular_velocity_world = physics_conversion::to_unreal(published_state->angular_velocity_radians_world);
+		flight_state.rotation = physics_conversion::to_unreal(published_state->transform_world.rotation).Rotator();
+		return flight_state;
+	}
+
 	if (const auto* primitive_component = this->get_primitive_component())
 	{
 		flight_state.linear_velocity_world = primitive_component->GetComponentVelocity() * 0.01;
@@ -328,6 +1032,27 @@ FFlightModeState UDroneMovementComponent::build_flight_mode_state(float delta_ti
 	return flight_state;
 }
 
+FFlightModeState UDroneMovementComponent::build_flight_mode_state(const physics::FSubstepBody& substep_body, double delta_time) const
+{
+	FFlightModeState flight_state;
+	flight_state.delta_time = delta_time;
+	flight_state.linear_velocity_world = physics_conversion::to_unreal(substep_body.linear_velocity_world);
+	flight_state.angular_velocity_world = physics_conversion::to_unreal(substep_body.angular_velocity_radians_world);
+	flight_state.rotation = physics_conversion::to_unreal(substep_body.transform_world.rotation).Rotator();
+	return flight_state;
+}
+
+double UDroneMovementComponent::get_input_time() const
+{
+	if (this->is_deterministic)
+	{
+		return static_cast<double>(this->game_clock.substep_index + this->deterministic_substeps_per_physics_tick) / this->tick_rate_hz;
+	}
+
+	const auto* world = this->GetWorld();
+	return world != nullptr ? world->GetTimeSeconds() : 0.0;
+}
+
 UPrimitiveComponent* UDroneMovementComponent::get_primitive_component() const
 {
 	if (this->UpdatedComponent == nullptr)
@@ -10,17 +10,31 @@
 #include "DroneSimulatorCore/Public/Controller/Setpoint.h"
 #include "DroneSimulatorCore/Public/Controller/FlightMode.h"
 #include "DroneSimulatorCore/Public/Simulation/Structural.h"
+#include "DroneSimulatorPhysics/Public/Controller/PilotInputBuffer.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSnapshot.h"
+#include "DroneSimulatorPhysics/Public/Simulation/LowRateSensors.h"
+#include "DroneSimulatorPhysics/Public/Simulation/MultiRateSchedule.h"
+#include "DroneSimulatorPhysics/Public/Simulation/RenderInterpolation.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SimulationWorld.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SleepState.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SpscRing.h"
+#include "DroneSimulatorPhysics/Public/Simulation/StateExchange.h"
+#include "DroneSimulatorPhysics/Public/Simulation/StateHash.h"
 
 #include "DroneMovementComponent.generated.h"
 
 class UPropulsionModel;
-struct FSubstepBody;
 class URotorModelBase;
 class UDroneController;
 class UDroneBatteryAsset;
 class UDronePropellerAsset;
 class UDroneMotorAsset;
 class UDroneFrameAsset;
+class UPidTuningPresetAsset;
+class UPidDroneController;
+class UFlightModeVelocity;
+class ADronePawn;
 struct FDroneFrame;
 
 UCLASS(ClassGroup=(Movement), BlueprintType, Blueprintable, meta=(BlueprintSpawnableComponent))
@@ -38,6 +52,8 @@ protected:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type end_play_reason) override;
+
 	virtual void TickComponent(float delta_time, ELevelTick tick_type, FActorComponentTickFunction* this_tick_function) override;
 
 	void set_updated_component_mass();
@@ -49,10 +65,308 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone", meta=(DisplayName="Tick rate (Hz)"))
 	double tick_rate_hz = 400.0;
 
+public:
+
+	// Rates of the stages of the substep loop, 0 runs the stage on every substep. Slower stages hold their output in
+	// between, see physics::FMultiRateSchedule.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Rates", meta=(DisplayName="Controller rate (Hz)", ClampMin=0))
+	double controller_rate_hz = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Rates", meta=(DisplayName="Rotor aerodynamics rate (Hz)", ClampMin=0))
+	double rotor_aerodynamics_rate_hz = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Rates", meta=(DisplayName="Drag rate (Hz)", ClampMin=0))
+	double drag_rate_hz = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Rates", meta=(DisplayName="Environment sampling rate (Hz)", ClampMin=0))
+	double environment_sampling_rate_hz = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Rates", meta=(DisplayName="Recording rate (Hz)", ClampMin=0))
+	double recording_rate_hz = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Rates", meta=(DisplayName="IMU rate (Hz)", ClampMin=0))
+	double imu_rate_hz = 0.0;
+
+public:
+
+	// Gyro and accelerometer sampled on the IMU stage, with noise, bias drift, motor vibration and quantization. Reach
+	// 4-8 kHz by raising the tick rate, and leaving the other stages at lower rates.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|IMU", meta=(DisplayName="Simulate IMU"))
+	bool is_imu_enabled = false;
+
+	// Drones with the same seed draw the same noise
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|IMU", meta=(DisplayName="Noise seed", EditCondition="is_imu_enabled"))
+	int64 imu_seed = 0;
+
+	// Physics thread only. Consumers keep the index of the next sample they want, see physics::FImuSampleRing.
+	const physics::FImuSampleRing& get_imu_samples() const { return this->imu.samples; }
+
+	// Lowpass and RPM notches of the firmware, on each gyro sample. The controller then flies on the filtered gyro
+	// instead of the angular velocity of the body.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|IMU", meta=(DisplayName="Filter gyro", EditCondition="is_imu_enabled"))
+	bool is_gyro_filter_enabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|IMU", meta=(DisplayName="Gyro lowpass cutoff (Hz)", EditCondition="is_gyro_filter_enabled", ClampMin=0))
+	double gyro_lowpass_cutoff_hz = 150.0;
+
+	// Biquad instead of PT1
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|IMU", meta=(DisplayName="Second order gyro lowpass", EditCondition="is_gyro_filter_enabled"))
+	bool is_gyro_lowpass_second_order = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|IMU", meta=(DisplayName="RPM filter harmonics", EditCondition="is_gyro_filter_enabled", ClampMin=0, ClampMax=3))
+	int32 rpm_filter_harmonic_count = 3;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|IMU", meta=(DisplayName="RPM filter Q", EditCondition="is_gyro_filter_enabled", ClampMin=0.1))
+	double rpm_filter_q = 5.0;
+
+private:
+
+	physics::FImuSensor imu;
+
+	physics::FGyroFilter gyro_filter;
+
+	physics::FGyroFilterConfig get_gyro_filter_config() const;
+
+	// Null before the first gyro sample, the controller reads the body instead
+	const physics::FVector3* get_gyro_angular_velocity() const;
+
+public:
+
+	// Barometer, GPS, magnetometer and rangefinder, sampled on the game thread from the published physics states at
+	// their own rates: they cost nothing to the substeps. They draw their noise from the IMU seed. Rates and latencies
+	// are clamped to physics::max_low_rate_sensor_rate_hz and physics::max_low_rate_sensor_latency.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Simulate barometer"))
+	bool is_barometer_enabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Barometer rate (Hz)", EditCondition="is_barometer_enabled", ClampMin=1, ClampMax=100))
+	double barometer_rate_hz = 50.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Barometer latency (s)", EditCondition="is_barometer_enabled", ClampMin=0, ClampMax=0.2))
+	double barometer_latency = 0.02;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Barometer noise (m)", EditCondition="is_barometer_enabled", ClampMin=0))
+	double barometer_noise = 0.3;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Simulate GPS"))
+	bool is_gps_enabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="GPS rate (Hz)", EditCondition="is_gps_enabled", ClampMin=1, ClampMax=100))
+	double gps_rate_hz = 10.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="GPS latency (s)", EditCondition="is_gps_enabled", ClampMin=0, ClampMax=0.2))
+	double gps_latency = 0.1;
+
+	// Standard deviation of the horizontal position error, which wanders slowly
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="GPS position error (m)", EditCondition="is_gps_enabled", ClampMin=0))
+	double gps_position_error = 1.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Simulate magnetometer"))
+	bool is_magnetometer_enabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Magnetometer rate (Hz)", EditCondition="is_magnetometer_enabled", ClampMin=1, ClampMax=100))
+	double magnetometer_rate_hz = 100.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Magnetometer latency (s)", EditCondition="is_magnetometer_enabled", ClampMin=0, ClampMax=0.2))
+	double magnetometer_latency = 0.005;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Magnetometer noise (gauss)", EditCondition="is_magnetometer_enabled", ClampMin=0))
+	double magnetometer_noise = 0.005;
+
+	// Downward, along the local -Z axis
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Simulate rangefinder"))
+	bool is_rangefinder_enabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Rangefinder rate (Hz)", EditCondition="is_rangefinder_enabled", ClampMin=1, ClampMax=100))
+	double rangefinder_rate_hz = 50.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Rangefinder latency (s)", EditCondition="is_rangefinder_enabled", ClampMin=0, ClampMax=0.2))
+	double rangefinder_latency = 0.01;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sensors", meta=(DisplayName="Rangefinder max range (m)", EditCondition="is_rangefinder_enabled", ClampMin=0))
+	double rangefinder_max_range = 8.0;
+
+	// Oldest first. A single consumer thread may pop, see physics::FLowRateSensorSuite.
+	bool pop_sensor_sample(physics::FLowRateSensorSample& out_sample);
+
+private:
+
+	physics::FLowRateSensorSuite low_rate_sensors;
+
+	// Line trace down from the drone, for the rangefinder
+	physics::FGroundHeightQuery ground_height_query;
+
+	physics::FLowRateSensorsConfig get_low_rate_sensors_config() const;
+
+public:
+
+	// Disarmed drones don't spin their motors, and can fall asleep
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sleep", meta=(DisplayName="Armed"))
+	bool is_armed = true;
+
+	UFUNCTION(BlueprintCallable, Category="Drone|Sleep")
+	void set_armed(bool in_is_armed);
+
+	// A disarmed drone at rest stops running its substeps and recording, until it is armed, the pilot moves a stick or
+	// something moves it
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sleep", meta=(DisplayName="Sleep when idle"))
+	bool is_sleep_enabled = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sleep", meta=(DisplayName="Max linear speed at rest (m/s)", EditCondition="is_sleep_enabled", ClampMin=0))
+	double sleep_max_linear_speed = 0.05;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sleep", meta=(DisplayName="Max angular speed at rest (rad/s)", EditCondition="is_sleep_enabled", ClampMin=0))
+	double sleep_max_angular_speed = 0.1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Sleep", meta=(DisplayName="Time to sleep (s)", EditCondition="is_sleep_enabled", ClampMin=0))
+	double time_to_sleep = 0.5;
+
+	UFUNCTION(BlueprintPure, Category="Drone|Sleep")
+	bool is_asleep() const { return this->sleep_state.is_asleep; }
+
+	// Sleeping drones in all the worlds, see physics::FSleepStatistics for the transition counts
+	UFUNCTION(BlueprintPure, Category="Drone|Sleep")
+	static int64 get_num_sleeping_drones();
+
+private:
+
+	physics::FSleepState sleep_state;
+
+	physics::FSleepConfig get_sleep_config() const;
+
+	// Runs the transition rules with the state of the body, returns whether the drone is asleep
+	bool update_sleep(const FFlightModeState& flight_state, float delta_time);
+
+	void record_sleep_transition(physics::ESleepTransition transition);
+
+	// Advances the simulation clock by the substeps a sleeping drone doesn't run
+	void skip_sleeping_substeps(float delta_time);
+
+	physics::FMultiRateSchedule get_schedule() const;
+
+	// Runs after the forces of the substep are accumulated, before they are consumed. The gyro sample is filtered for the
+	// controller of the next substeps.
+	void sample_imu(const physics::FSubstepBody& substep_body, bool is_substep_armed, double time, double delta_time);
+
+	// Sampled world and drag, carried between two runs of their stages
+	physics::FHeldStageOutputs held_stage_outputs;
+
+public:
+
+	// Renders the drone between the last two physics states, so that a physics rate lower than the frame rate doesn't
+	// judder. Only the interpolated component moves, the physics body is left where the physics put it.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Rendering", meta=(DisplayName="Interpolate rendering"))
+	bool is_render_interpolation_enabled = true;
+
+	// Usually the mesh, attached to the physics body with an absolute location and rotation
+	UFUNCTION(BlueprintCallable, Category="Drone|Rendering")
+	void set_interpolated_component(USceneComponent* component);
+
+	// Transform to render the drone at this frame, for cameras and effects that follow the drone
+	UFUNCTION(BlueprintPure, Category="Drone|Rendering")
+	FTransform get_interpolated_transform() const { return this->interpolated_transform; }
+
 private:
 
 	UPROPERTY()
-	double remaining_time_accumulator = 0.0;
+	TObjectPtr<USceneComponent> interpolated_component;
+
+	physics::FRenderInterpolator render_interpolator;
+
+	FTransform interpolated_transform;
+
+	void update_render_interpolation(const physics::FPublishedDroneState* published_state, float delta_time);
+
+public:
+
+	// Runs a fixed number of substeps per physics tick, and stamps recorded events with the simulation clock instead of
+	// the world time, so that the same inputs give the same trajectory. Needs the async physics tick, with a fixed step
+	// as long as the substeps of a tick: BeginPlay logs an error otherwise.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Determinism", meta=(DisplayName="Deterministic"))
+	bool is_deterministic = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Determinism", meta=(DisplayName="Substeps per physics tick", EditCondition="is_deterministic", ClampMin=1))
+	int32 deterministic_substeps_per_physics_tick = 8;
+
+	// Hashes the body and controller state every N substeps, 0 to disable. See physics::find_first_divergence.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Determinism", meta=(DisplayName="State hash interval", ClampMin=0))
+	int32 state_hash_interval = 0;
+
+	// Seconds of simulation since the beginning of play, counted in substeps, as of the last published physics state
+	UFUNCTION(BlueprintPure, Category="Drone|Determinism")
+	double get_simulation_time() const;
+
+	// Game thread. Every hash recorded so far, up to the last tick.
+	const std::vector<physics::FStateHashEntry>& get_state_hashes() const { return this->state_hashes; }
+
+private:
+
+	// Game thread copy of the substep clock: follows the published states, runs on while asleep and is set by restores
+	physics::FSubstepClock game_clock;
+
+	// Physics thread only. Taken from the pilot command when the game side hands a new revision over.
+	physics::FSubstepClock substep_clock;
+
+	// Physics thread only. Substeps recorded on the flight record, which restores don't rewind: FFlightRecordReader
+	// searches the recorded times, so they must keep increasing.
+	int64 recording_substep_index = 0;
+
+	// Physics thread: start time of the next substep
+	double get_substep_time() const;
+
+	// The substeps of a physics tick must cover the fixed Chaos step, or the simulation clock drifts from the world time
+	void check_deterministic_step() const;
+
+	// Substep of the world clock at the beginning of play, recorded times are offset by it so that the drones spawned
+	// later line up. 0 when deterministic, the world time at the beginning of play depends on the frame timing.
+	int64 simulation_clock_origin_substep = 0;
+
+	// The physics side pushes the hashes without allocating, the game side moves them to state_hashes each tick
+	physics::TSpscRing<physics::FStateHashEntry> state_hash_ring;
+
+	std::vector<physics::FStateHashEntry> state_hashes;
+
+	// Physics thread, with the pilot command of the physics tick
+	uint64 compute_state_hash(const physics::FSubstepBody& substep_body, const FDroneSetpoint& substep_setpoint,
+		const physics::FPublishedPilotCommand& pilot_command) const;
+
+public:
+
+	// Gains applied to the PID controller and to the velocity flight mode on BeginPlay, and written by auto_tune_pid
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Tuning", meta=(DisplayName="PID tuning preset"))
+	UPidTuningPresetAsset* pid_tuning_preset = nullptr;
+
+	// Tunes the gains of the velocity flight mode instead of the rate PID
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Tuning", meta=(DisplayName="Tune the velocity flight mode"))
+	bool is_tuning_velocity_mode = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Drone|Tuning", meta=(DisplayName="Tuning generations", ClampMin=1))
+	int32 tuning_generations = 30;
+
+	/**
+	 * Searches the gains on headless step, chirp and disturbance manoeuvres, on all cores, see physics::FPidAutoTuner.
+	 * The result is written to the tuning preset if there is one, to the defaults of the controller otherwise.
+	 * Blocks until the search is done.
+	 */
+	UFUNCTION(CallInEditor, BlueprintCallable, Category="Drone|Tuning")
+	void auto_tune_pid();
+
+private:
+
+	// Controller of the dynamics propulsion model, if the drone has one
+	UDroneController* find_drone_controller() const;
+
+	// Found on BeginPlay, so that the substeps don't look it up on the game objects
+	UPROPERTY()
+	TObjectPtr<UDroneController> substep_drone_controller;
+
+	UPidDroneController* find_pid_controller() const;
+
+	UFlightModeVelocity* find_velocity_flight_mode() const;
+
+	// Same drone in the headless simulation, unset if its rotor model or controller has no headless equivalent
+	TOptional<physics::FDroneSimulation> build_tuning_simulation();
+
+	void apply_pid_tuning_preset();
 
 public:
 
@@ -90,6 +404,12 @@ protected:
 
 	TOptional<TDronePropeller> propeller;
 
+	// Parts converted for DroneSimulatorPhysics with their derived constants, shared by the drones with the same assets.
+	// Built in init_drone_parts, then only read.
+	std::shared_ptr<const physics::FDroneModel> drone_model;
+
+	physics::FSimulationWorld simulation_world;
+
 	UFUNCTION()
 	void init_drone_parts();
 
@@ -103,9 +423,28 @@ protected:
 	UPROPERTY(BlueprintReadWrite)
 	FDronePlayerInput controller_input;
 
+	// Output of the active flight mode on the last substep
 	UPROPERTY(BlueprintReadWrite)
 	FDroneSetpoint setpoint;
 
+	// Player inputs of the last frames, timestamped with get_input_time. The flight mode runs on every substep, with the
+	// input interpolated at the substep time.
+	physics::FPilotInputBuffer pilot_input_buffer;
+
+	// Hand-off between the game thread and the physics thread: the substeps read the pilot command published by
+	// TickComponent, and TickComponent reads the state published by the last physics tick. Neither side waits.
+	physics::FDroneStateExchange state_exchange;
+
+	// Set by restore_snapshot and while asleep, until the physics side publishes again
+	bool is_published_state_stale = false;
+
+	// Game thread only. Null until the first physics tick, after a restore and while asleep, see state_exchange::read_current.
+	const physics::FPublishedDroneState* read_published_state();
+
+	// Physics thread only
+	void publish_drone_state(const physics::FSubstepBody& substep_body, const FDroneSetpoint& substep_setpoint,
+		const UFlightModeBase* active_mode);
+
 protected:
 
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
@@ -113,7 +452,8 @@ protected:
 
 protected:
 
-	// This is exposed for blueprints read. It is not used internally
+	// Per-propeller info of the last substep, recorded with the flight and exposed for blueprints read. Not set when the
+	// propulsion model doesn't report it
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
 	TOptional<FPropulsionInfo> propulsion_info;
 
@@ -128,6 +468,17 @@ public:
 	UFUNCTION(BlueprintPure, Category="Drone|Flight mode")
 	FName get_active_flight_mode_name() const;
 
+public:
+
+	/**
+	 * Captures the body, the substep clock and the controller and active flight mode integrators. Call it from the
+	 * game thread, between two physics ticks.
+	 */
+	physics::FDroneSimulationSnapshot save_snapshot();
+
+	// Teleports the body and restores the integrators, the drone then continues exactly from the snapshot
+	void restore_snapshot(const physics::FDroneSimulationSnapshot& snapshot);
+
 private:
 
 	UFUNCTION()
@@ -137,11 +488,14 @@ private:
 
 	void calculate_custom_physics(float delta_time, FBodyInstance* body_instance);
 
-	void calculate_thrust_custom_physics(float delta_time, FSubstepBody* substep_body);
+	void calculate_thrust_custom_physics(float delta_time, physics::FSubstepBody* substep_body, const FDroneSetpoint& substep_setpoint,
+		const physics::FSubstepStages& stages);
 
-	void calculate_drag_custom_physics(float delta_time, FSubstepBody* substep_body);
+	void calculate_drag_custom_physics(float delta_time, physics::FSubstepBody* substep_body, const physics::FSubstepStages& stages);
 
-	void record_flight_data(FSubstepBody* substep_body);
+	// time_seconds is the simulation time of the substep, world_time_seconds the world time it maps to
+	void record_flight_data(ADronePawn* drone_pawn, physics::FSubstepBody* substep_body, double time_seconds, double world_time_seconds,
+		const FDronePlayerInput& recorded_input);
 
 private:
 
@@ -153,7 +507,14 @@ private:
 
 	FDronePlayerInput read_player_input(const UFlightModeBase* active_mode);
 
-	FFlightModeState build_flight_mode_state(float delta_time) const;
+	// From the published state if there is one, from the component otherwise
+	FFlightModeState build_flight_mode_state(const physics::FPublishedDroneState* published_state, float delta_time) const;
+
+	FFlightModeState build_flight_mode_state(const physics::FSubstepBody& substep_body, double delta_time) const;
+
+	// Time at which the substeps reach the input read this frame: the simulation clock at the end of the next physics
+	// tick in deterministic mode, the world time otherwise
+	double get_input_time() const;
 
 private:
 
@@ -14,21 +14,37 @@ UPawnMovementComponent* ADronePawn::GetMovementComponent() const
 	return this->movement_component;
 }
 
-void ADronePawn::enqueue_flight_record(const TArray<FFlightRecordPawnEvent>& events)
+void ADronePawn::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Before the first physics tick, the movement component only enqueues its custom physics from its tick
+	this->flight_record.reset(this->flight_record_capacity);
+}
+
+void ADronePawn::enqueue_flight_record(const physics::FTelemetrySample& sample)
 {
 	if (!enable_recording)
 	{
 		return;
 	}
 
-	FScopeLock Lock(&this->temp_flight_record_mutex);
-	temp_flight_record.Append(events);
+	this->flight_record.push(sample);
+}
+
+void ADronePawn::enqueue_flight_record_debug(const FFlightRecordDebugEvent& event)
+{
+	if (!enable_recording || !enable_debug_recording)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&this->temp_flight_record_debug_mutex);
+	temp_flight_record_debug.Add(event);
 }
 
-TArray<FFlightRecordPawnEvent> ADronePawn::consume_flight_record()
+TArray<FFlightRecordDebugEvent> ADronePawn::consume_flight_record_debug()
 {
-	FScopeLock Lock(&this->temp_flight_record_mutex);
-	auto temp_flight_record_copy = temp_flight_record;
-	temp_flight_record = {};
-	return temp_flight_record_copy;
+	FScopeLock Lock(&this->temp_flight_record_debug_mutex);
+	return MoveTemp(temp_flight_record_debug);
 }
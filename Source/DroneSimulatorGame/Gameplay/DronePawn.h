@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DroneSimulatorGame/Gameplay/Recording/FlightRecord.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SpscRing.h"
 #include "Runtime/Engine/Classes/GameFramework/Pawn.h"
 
 #include "DronePawn.generated.h"
@@ -13,27 +14,6 @@ class UDroneMovementController;
 class UInputMappingContext;
 
 
-USTRUCT(BlueprintType)
-struct FFlightRecordPawnEvent
-{
-	GENERATED_BODY()
-
-public:
-
-	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
-	double event_time = 0.0;
-
-	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
-	FFlightRecordEventData event_tata;
-
-	FFlightRecordPawnEvent() = default;
-
-	FFlightRecordPawnEvent(double in_event_time, const FFlightRecordEventData& in_event_data)
-		: event_time(in_event_time), event_tata(in_event_data)
-	{
-	}
-};
-
 class UDroneInputSettings;
 
 
@@ -53,17 +33,35 @@ public:
 
 	virtual UPawnMovementComponent* GetMovementComponent() const override;
 
+protected:
+
+	virtual void BeginPlay() override;
+
 public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool enable_recording = true;
-	
-	FCriticalSection temp_flight_record_mutex;
-	TArray<FFlightRecordPawnEvent> temp_flight_record;
 
-	UFUNCTION()
-	void enqueue_flight_record(const TArray<FFlightRecordPawnEvent>& events);
+	// Samples kept between two drains of the recording manager, rounded up to a power of two. Allocated on BeginPlay,
+	// 4096 is 10 s at 400 Hz.
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0"))
+	int32 flight_record_capacity = 4096;
+
+	// Written by the physics thread, drained by ADroneFlightRecordingManager on the game thread
+	physics::TSpscRing<physics::FTelemetrySample> flight_record;
+
+	// Physics thread. Never locks nor allocates: when the ring is full, the sample is dropped and counted.
+	void enqueue_flight_record(const physics::FTelemetrySample& sample);
+
+	// Also records the debug logs and the Reynolds numbers of every blade element, which the samples leave out. These
+	// allocate, and go through a lock.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool enable_debug_recording = false;
+
+	FCriticalSection temp_flight_record_debug_mutex;
+	TArray<FFlightRecordDebugEvent> temp_flight_record_debug;
+
+	void enqueue_flight_record_debug(const FFlightRecordDebugEvent& event);
 
-	UFUNCTION()
-	[[nodiscard]] TArray<FFlightRecordPawnEvent> consume_flight_record();
+	[[nodiscard]] TArray<FFlightRecordDebugEvent> consume_flight_record_debug();
 };
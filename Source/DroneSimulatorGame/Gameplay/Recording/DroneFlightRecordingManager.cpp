@@ -1,9 +1,11 @@
 #include "DroneSimulatorGame/Gameplay/Recording/DroneFlightRecordingManager.h"
+#include "DroneSimulatorGame/Gameplay/Recording/FlightRecordCompression.h"
 #include "DroneSimulatorGame/Gameplay/DronePawn.h"
 #include "DroneSimulatorGame/Assets/FlightRecordAsset.h"
 #include "DroneSimulatorGame/DroneSimulatorGame.h"
 
 #include "EngineUtils.h"
+#include "Misc/Paths.h"
 #include "Runtime/AssetRegistry/Public/AssetRegistry/AssetRegistryModule.h"
 #include "Runtime/CoreUObject/Public/UObject/SavePackage.h"
 
@@ -11,6 +13,17 @@
 #include "Developer/AssetTools/Public/AssetToolsModule.h"
 #endif
 
+namespace
+{
+	// The asset references the record files relative to the Saved directory, so that the project can move
+	FString make_saved_relative_path(const std::string& path)
+	{
+		FString relative_path = UTF8_TO_TCHAR(path.c_str());
+		FPaths::MakePathRelativeTo(relative_path, *FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir()));
+		return relative_path;
+	}
+}
+
 ADroneFlightRecordingManager::ADroneFlightRecordingManager()
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -28,8 +41,28 @@ void ADroneFlightRecordingManager::BeginPlay()
 
 void ADroneFlightRecordingManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	// Save any remaining recorded data when PIE ends
+	// Writes the remaining samples, at most one open chunk per pawn plus the pending ones, however long the session was
 	this->record_flight_record_of_pawns();
+	if (this->flight_record_writer.IsValid())
+	{
+		this->flight_record_writer->close();
+		if (this->flight_record_writer->has_failed())
+		{
+			UE_LOG(LogDroneSimulatorGame, Warning, TEXT("Some flight record chunks could not be written to %s"),
+				UTF8_TO_TCHAR(this->flight_record_writer->get_index_path().c_str()));
+		}
+
+		if (this->flight_record_asset != nullptr)
+		{
+			this->flight_record_asset->chunk_files.Reset();
+			for (const auto& chunk_path : this->flight_record_writer->get_chunk_paths())
+			{
+				this->flight_record_asset->chunk_files.Add(make_saved_relative_path(chunk_path));
+			}
+		}
+
+		this->flight_record_writer.Reset();
+	}
 	this->save_flight_record_asset();
 
 	Super::EndPlay(EndPlayReason);
@@ -51,6 +84,23 @@ void ADroneFlightRecordingManager::setup_flight_record_asset()
 
 	FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").AssetCreated(flight_record_asset);
 
+	// The samples don't go in the asset, they are streamed next to it in the Saved directory
+	const FString record_directory = FPaths::ProjectSavedDir() / TEXT("FlightRecords") / asset_name;
+	physics::FFlightRecordWriterConfig writer_config;
+	writer_config.entropy_coder = flight_record_compression::make_oodle_coder();
+
+	this->flight_record_writer = MakeUnique<physics::FFlightRecordWriter>();
+	if (this->flight_record_writer->open(TCHAR_TO_UTF8(*FPaths::ConvertRelativePathToFull(record_directory)), TCHAR_TO_UTF8(*asset_name),
+		writer_config))
+	{
+		flight_record_asset->index_file = make_saved_relative_path(this->flight_record_writer->get_index_path());
+	}
+	else
+	{
+		UE_LOG(LogDroneSimulatorGame, Warning, TEXT("Can't create the flight record in %s, nothing will be recorded"), *record_directory);
+		this->flight_record_writer.Reset();
+	}
+
 	this->save_flight_record_asset();
 #endif
 }
@@ -89,23 +139,46 @@ void ADroneFlightRecordingManager::Tick(float delta_time)
 void ADroneFlightRecordingManager::record_flight_record_of_pawns()
 {
 	auto* world = GetWorld();
-	if (world == nullptr || this->flight_record_asset == nullptr)
+	if (world == nullptr || this->flight_record_asset == nullptr || !this->flight_record_writer.IsValid())
 	{
 		return;
 	}
 
 	for (TActorIterator<ADronePawn> actor_iterator(world); actor_iterator; ++actor_iterator)
 	{
-		auto pawn_flight_record = actor_iterator->consume_flight_record();
+		const auto pawn_name = actor_iterator->GetFName();
+		auto& flight_record = actor_iterator->flight_record;
 
-		TArray<FFlightRecordEvent> savable_flight_record;
-		savable_flight_record.Reserve(pawn_flight_record.Num());
-		for (const auto event : pawn_flight_record)
+		const int32* stream_index = this->stream_indices.Find(pawn_name);
+		if (stream_index == nullptr)
 		{
-			savable_flight_record.Push(FFlightRecordEvent(actor_iterator->GetFName(), event.event_time, event.event_tata));
+			stream_index = &this->stream_indices.Add(pawn_name, this->flight_record_writer->add_stream(TCHAR_TO_UTF8(*pawn_name.ToString())));
 		}
 
-		this->flight_record_asset->events.Append(savable_flight_record);
+		// Copied from the ring straight to the open chunk, then handed back to the physics thread
+		std::size_t read_count = 0;
+		for (const auto& span : flight_record.get_read_spans())
+		{
+			this->flight_record_writer->append(*stream_index, span);
+			read_count += span.size();
+		}
+		flight_record.release(read_count);
+
+		const auto dropped_count = static_cast<int64>(flight_record.get_dropped_count());
+		auto& reported_dropped_count = this->reported_dropped_counts.FindOrAdd(pawn_name, 0);
+		if (dropped_count > reported_dropped_count)
+		{
+			UE_LOG(LogDroneSimulatorGame, Warning, TEXT("Flight record of %s dropped %lld samples, its ring of %d is too small for a frame"),
+				*pawn_name.ToString(), dropped_count - reported_dropped_count, flight_record.get_capacity());
+			this->flight_record_asset->dropped_event_count += dropped_count - reported_dropped_count;
+			reported_dropped_count = dropped_count;
+		}
+
+		for (auto& debug_event : actor_iterator->consume_flight_record_debug())
+		{
+			debug_event.pawn_name = pawn_name;
+			this->flight_record_asset->debug_events.Add(MoveTemp(debug_event));
+		}
 	}
 }
 
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordWriter.h"
 #include "DroneFlightRecordingManager.generated.h"
 
 class UFlightRecordAsset;
@@ -37,4 +38,13 @@ protected:
 
 	void record_flight_record_of_pawns();
 
+	// Samples each pawn dropped that were already added to the asset
+	TMap<FName, int64> reported_dropped_counts;
+
+	// Writes the chunks on its own thread, while flying
+	TUniquePtr<physics::FFlightRecordWriter> flight_record_writer;
+
+	// Stream of each pawn in the writer
+	TMap<FName, int32> stream_indices;
+
 };
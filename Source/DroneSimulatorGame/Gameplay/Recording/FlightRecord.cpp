@@ -1 +1,91 @@
 ﻿#include "DroneSimulatorGame/Gameplay/Recording/FlightRecord.h"
+#include "DroneSimulatorCore/Public/Simulation/PhysicsConversion.h"
+
+namespace
+{
+	physics::FTelemetryRotorValues encode_propeller(const FPropellerPropulsionInfo& propeller)
+	{
+		physics::FTelemetryRotorValues rotor;
+		rotor.throttle = propeller.throttle;
+		rotor.angular_speed = propeller.angular_speed;
+		rotor.thrust = propeller.thrust;
+		rotor.torque = propeller.torque;
+		rotor.angle_of_attack = propeller.angle_of_attack;
+		if (propeller.reynolds.Num() > 0)
+		{
+			rotor.min_reynolds = FMath::Min(propeller.reynolds);
+			rotor.max_reynolds = FMath::Max(propeller.reynolds);
+		}
+		rotor.velocity_axial = propeller.velocity_axial;
+		rotor.velocity_induced = propeller.velocity_induced;
+		return rotor;
+	}
+
+	FPropellerPropulsionInfo decode_propeller(const physics::FTelemetryRotorValues& rotor)
+	{
+		return FPropellerPropulsionInfo(rotor.angular_speed, rotor.thrust, rotor.torque, rotor.angle_of_attack,
+			{ rotor.min_reynolds, rotor.max_reynolds }, rotor.throttle, rotor.velocity_axial, rotor.velocity_induced, FDebugLog());
+	}
+}
+
+FFlightRecordSample FFlightRecordSample::from_simulation(double time_seconds, double world_time_seconds, const physics::FSubstepBody& substep_body,
+	const FDronePlayerInput& player_input, const TOptional<FPropulsionInfo>& propulsion_info)
+{
+	physics::FTelemetryValues values;
+	values.time = time_seconds;
+	values.world_time = world_time_seconds;
+	values.transform_world = substep_body.transform_world;
+	values.linear_velocity_world = substep_body.linear_velocity_world;
+	values.angular_velocity_radians_world = substep_body.angular_velocity_radians_world;
+	values.player_input = physics_conversion::to_physics(player_input);
+
+	values.has_propulsion = propulsion_info.IsSet() && propulsion_info->is_valid;
+	if (values.has_propulsion)
+	{
+		values.rotors[0] = encode_propeller(propulsion_info->front_left);
+		values.rotors[1] = encode_propeller(propulsion_info->front_right);
+		values.rotors[2] = encode_propeller(propulsion_info->rear_left);
+		values.rotors[3] = encode_propeller(propulsion_info->rear_right);
+	}
+
+	return FFlightRecordSample(physics::telemetry::encode(values));
+}
+
+FFlightRecordEventData FFlightRecordSample::decode() const
+{
+	const auto values = physics::telemetry::decode(this->telemetry);
+	const auto transform = physics_conversion::to_unreal(values.transform_world);
+
+	TOptional<FPropulsionInfo> propulsion_info;
+	if (values.has_propulsion)
+	{
+		FPropulsionInfo decoded_propulsion_info;
+		decoded_propulsion_info.is_valid = true;
+		decoded_propulsion_info.front_left = decode_propeller(values.rotors[0]);
+		decoded_propulsion_info.front_right = decode_propeller(values.rotors[1]);
+		decoded_propulsion_info.rear_left = decode_propeller(values.rotors[2]);
+		decoded_propulsion_info.rear_right = decode_propeller(values.rotors[3]);
+		propulsion_info = decoded_propulsion_info;
+	}
+
+	return FFlightRecordEventData(
+		transform.GetLocation(),
+		transform.GetRotation().Rotator(),
+		physics_conversion::to_unreal(values.linear_velocity_world),
+		physics_conversion::to_unreal(values.angular_velocity_radians_world),
+		physics_conversion::to_unreal(values.player_input),
+		propulsion_info
+	);
+}
+
+FVector FFlightRecordSample::get_location() const
+{
+	return FVector(this->telemetry.location[0], this->telemetry.location[1], this->telemetry.location[2]);
+}
+
+bool FFlightRecordSample::Serialize(FArchive& archive)
+{
+	// Trivially copyable, the platforms we ship are all little endian
+	archive.Serialize(&this->telemetry, sizeof(this->telemetry));
+	return true;
+}
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "DroneSimulatorGame/Gameplay/DroneMovementComponent.h"
+#include "DroneSimulatorPhysics/Public/Simulation/TelemetrySample.h"
 
 #include "FlightRecord.generated.h"
 
@@ -46,3 +47,73 @@ public:
 	{
 	}
 };
+
+/**
+ * Single frame for a single pawn, as recorded: a fixed-size physics::FTelemetrySample, with no heap member, serialized
+ * as raw bytes. Decode it to read the values.
+ */
+USTRUCT(BlueprintType)
+struct DRONESIMULATORGAME_API FFlightRecordSample
+{
+	GENERATED_BODY()
+
+public:
+
+	physics::FTelemetrySample telemetry;
+
+	FFlightRecordSample() = default;
+
+	explicit FFlightRecordSample(const physics::FTelemetrySample& in_telemetry)
+		: telemetry(in_telemetry)
+	{
+	}
+
+	// time_seconds is on the simulation clock of the drone, world_time_seconds the world time the substep maps to
+	static FFlightRecordSample from_simulation(double time_seconds, double world_time_seconds, const physics::FSubstepBody& substep_body,
+		const FDronePlayerInput& player_input, const TOptional<FPropulsionInfo>& propulsion_info);
+
+	// The Reynolds numbers of each propeller are only their min and max, and the debug logs are empty
+	FFlightRecordEventData decode() const;
+
+	// In unreal units, without decoding the rest
+	FVector get_location() const;
+
+	bool Serialize(FArchive& archive);
+};
+
+template<>
+struct TStructOpsTypeTraits<FFlightRecordSample> : public TStructOpsTypeTraitsBase2<FFlightRecordSample>
+{
+	enum
+	{
+		WithSerializer = true,
+	};
+};
+
+/**
+ * What a sample leaves out: the debug logs and the Reynolds number of every blade element. Only recorded when the pawn
+ * enables it, see ADronePawn::enable_debug_recording.
+ */
+USTRUCT(BlueprintType)
+struct FFlightRecordDebugEvent
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	FName pawn_name;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	double event_time = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	FPropulsionInfo propulsion_info;
+
+	FFlightRecordDebugEvent() = default;
+
+	FFlightRecordDebugEvent(const FName& in_pawn_name, double in_event_time, const FPropulsionInfo& in_propulsion_info)
+		: pawn_name(in_pawn_name), event_time(in_event_time), propulsion_info(in_propulsion_info)
+	{
+	}
+};
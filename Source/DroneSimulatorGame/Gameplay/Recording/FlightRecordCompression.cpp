@@ -0,0 +1,38 @@
+#include "DroneSimulatorGame/Gameplay/Recording/FlightRecordCompression.h"
+
+#include "Misc/Compression.h"
+
+namespace
+{
+	constexpr uint8 oodle_coder_id = 1;
+}
+
+physics::FFlightRecordEntropyCoder flight_record_compression::make_oodle_coder()
+{
+	physics::FFlightRecordEntropyCoder coder;
+	coder.id = oodle_coder_id;
+
+	coder.compress = [](std::span<const std::uint8_t> bytes, std::vector<std::uint8_t>& out_compressed)
+	{
+		const int32 uncompressed_size = static_cast<int32>(bytes.size());
+		int32 compressed_size = FCompression::CompressMemoryBound(NAME_Oodle, uncompressed_size);
+		out_compressed.resize(compressed_size);
+
+		// Favors decompression speed, the editor decompresses blocks while scrubbing
+		if (!FCompression::CompressMemory(NAME_Oodle, out_compressed.data(), compressed_size, bytes.data(), uncompressed_size, COMPRESS_BiasSpeed))
+		{
+			return false;
+		}
+
+		out_compressed.resize(compressed_size);
+		return true;
+	};
+
+	coder.decompress = [](std::span<const std::uint8_t> compressed, std::span<std::uint8_t> out_bytes)
+	{
+		return FCompression::UncompressMemory(NAME_Oodle, out_bytes.data(), static_cast<int32>(out_bytes.size()), compressed.data(),
+			static_cast<int32>(compressed.size()));
+	};
+
+	return coder;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordFile.h"
+
+namespace flight_record_compression
+{
+	/**
+	 * The engine's Oodle, run on the encoded blocks of the flight records. Recording and loading must use the same coder,
+	 * the blocks remember its id.
+	 */
+	physics::FFlightRecordEntropyCoder make_oodle_coder();
+}
@@ -1,6 +1,8 @@
 #include "DroneSimulatorGame/Gameplay/Recording/PropulsionInfo.h"
 
-#include "DroneSimulatorCore/Public/RotorModel/Bemt/PropellerThrust.h"
+#include "DroneSimulatorCore/Public/Simulation/PhysicsConversion.h"
+#include "DroneSimulatorPhysics/Public/PropulsionModel/PropulsionModel.h"
+#include "DroneSimulatorPhysics/Public/RotorModel/Bemt/PropellerThrust.h"
 
 FPropellerPropulsionInfo::FPropellerPropulsionInfo(double in_angular_speed, double in_thrust, double in_torque,
                                                    double in_angle_of_attack, const TArray<double>& in_reynolds, double in_throttle, double in_velocity_axial,
@@ -16,17 +18,43 @@ FPropellerPropulsionInfo::FPropellerPropulsionInfo(double in_angular_speed, doub
     , debug_log(in_debug_log)
 {}
 
-FPropellerPropulsionInfo FPropellerPropulsionInfo::from_simulation_output(const FPropellerSimInfo& in_sim_info, double in_throttle, const FDebugLog& in_debug_log)
+FPropellerPropulsionInfo FPropellerPropulsionInfo::from_simulation_output(const physics::FPropellerSimInfo& in_sim_info, double in_throttle, const physics::FDebugLog& in_debug_log)
 {
     return FPropellerPropulsionInfo(
         in_sim_info.angular_speed,
         in_sim_info.thrust,
         in_sim_info.torque,
         in_sim_info.angle_of_attack,
-        in_sim_info.reynolds,
+        TArray<double>(in_sim_info.reynolds.data(), static_cast<int32>(in_sim_info.reynolds.size())),
         in_throttle,
         in_sim_info.v_axial,
         in_sim_info.v_induced,
-        in_debug_log
+        physics_conversion::to_unreal(in_debug_log)
     );
 }
+
+FPropellerPropulsionInfo FPropellerPropulsionInfo::from_simulation_output(const physics::FDynamicsPropellerInfo& in_propeller_info)
+{
+    return FPropellerPropulsionInfo(
+        in_propeller_info.angular_speed,
+        in_propeller_info.thrust,
+        in_propeller_info.torque,
+        in_propeller_info.angle_of_attack,
+        TArray<double>(in_propeller_info.reynolds.data(), static_cast<int32>(in_propeller_info.reynolds.size())),
+        in_propeller_info.throttle,
+        in_propeller_info.velocity_axial,
+        in_propeller_info.velocity_induced,
+        physics_conversion::to_unreal(in_propeller_info.debug_log)
+    );
+}
+
+FPropulsionInfo FPropulsionInfo::from_simulation_output(const physics::FDynamicsPropellerSetInfo& in_propeller_set_info)
+{
+    FPropulsionInfo propulsion_info;
+    propulsion_info.is_valid = true;
+    propulsion_info.front_left = FPropellerPropulsionInfo::from_simulation_output(in_propeller_set_info.front_left);
+    propulsion_info.front_right = FPropellerPropulsionInfo::from_simulation_output(in_propeller_set_info.front_right);
+    propulsion_info.rear_left = FPropellerPropulsionInfo::from_simulation_output(in_propeller_set_info.rear_left);
+    propulsion_info.rear_right = FPropellerPropulsionInfo::from_simulation_output(in_propeller_set_info.rear_right);
+    return propulsion_info;
+}
@@ -2,11 +2,16 @@
 
 #include "CoreMinimal.h"
 #include "DroneSimulatorCore/Public/Simulation/LogDebug.h"
+#include "DroneSimulatorPhysics/Public/Simulation/LogDebug.h"
 
 #include "PropulsionInfo.generated.h"
 
-
-struct FPropellerSimInfo;
+namespace physics
+{
+    struct FDynamicsPropellerInfo;
+    struct FDynamicsPropellerSetInfo;
+    struct FPropellerSimInfo;
+}
 
 /**
  * Information generated by the propulsion model, for a single propeller.
@@ -50,7 +55,9 @@ public:
         const TArray<double>& in_reynolds, double in_throttle, double in_velocity_axial, double in_velocity_induced,
         const FDebugLog& in_debug_log);
 
-    static FPropellerPropulsionInfo from_simulation_output(const FPropellerSimInfo&, double in_throttle, const FDebugLog& in_debug_log);
+    static FPropellerPropulsionInfo from_simulation_output(const physics::FPropellerSimInfo&, double in_throttle, const physics::FDebugLog& in_debug_log);
+
+    static FPropellerPropulsionInfo from_simulation_output(const physics::FDynamicsPropellerInfo& in_propeller_info);
 };
 
 /**
@@ -82,4 +89,6 @@ public:
 
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
     FPropellerPropulsionInfo rear_right;
+
+    static FPropulsionInfo from_simulation_output(const physics::FDynamicsPropellerSetInfo& in_propeller_set_info);
 };
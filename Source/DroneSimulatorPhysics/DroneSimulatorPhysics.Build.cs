@@ -0,0 +1,19 @@
+using UnrealBuildTool;
+
+public class DroneSimulatorPhysics : ModuleRules
+{
+	public DroneSimulatorPhysics(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// The simulation layer is plain C++, and also builds outside of Unreal with CMakeLists.txt.
+		// Only Core is needed for the module boilerplate.
+		PublicDependencyModuleNames.AddRange(new string[] { "Core" });
+
+		// The SITL bridge talks to the firmware over UDP
+		if (Target.Platform == UnrealTargetPlatform.Win64)
+		{
+			PublicSystemLibraries.Add("ws2_32.lib");
+		}
+	}
+}
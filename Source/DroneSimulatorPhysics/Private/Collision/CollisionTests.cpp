@@ -0,0 +1,170 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Private/Simulation/TestDrone.h"
+#include "DroneSimulatorPhysics/Public/Collision/CollisionWorld.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+
+namespace
+{
+	// Falls freely: a frame and a battery, no propulsion
+	physics::FDroneSimulation make_falling_drone(const physics::FCollisionGeometry& geometry, const physics::FVector3& location)
+	{
+		auto parts = physics::test_drone::make_parts();
+		parts.motor.reset();
+
+		physics::FDroneSimulation simulation;
+		simulation.model = physics::drone_model::compile(parts);
+		simulation.collision_world = physics::collision::compile(geometry);
+		simulation.reset_body(location, physics::FQuaternion::identity());
+		return simulation;
+	}
+
+	void fly_seconds(physics::FDroneSimulation& simulation, double seconds)
+	{
+		simulation.advance_substeps(static_cast<std::int32_t>(seconds * simulation.tick_rate_hz), physics::FDronePlayerInput::zero());
+	}
+}
+
+TEST_CASE("Collision world", "[collision]")
+{
+	SECTION("Drone shape covers the props")
+	{
+		const auto shape = physics::collision::make_drone_shape({ physics::FRotorDescription { physics::FVector3(10.0, 10.0, 0.0) } }, 0.05);
+
+		REQUIRE(shape.count == 2);
+		REQUIRE(shape.spheres[1].radius == Approx(5.0));
+		REQUIRE(shape.bounding_radius == Approx(std::sqrt(200.0) + 5.0));
+	}
+
+	SECTION("Grid only returns the shapes near the query")
+	{
+		physics::FCollisionGeometry geometry;
+		geometry.max_body_radius = 50.0;
+		geometry.shapes.push_back(physics::FCollisionSphere { physics::FVector3(0.0, 0.0, 0.0), 100.0 });
+		geometry.shapes.push_back(physics::FCollisionSphere { physics::FVector3(5000.0, 0.0, 0.0), 100.0 });
+
+		const auto world = physics::collision::compile(geometry);
+
+		const auto near_first = world->get_candidate_shapes(physics::FVector3(120.0, 0.0, 0.0));
+		REQUIRE(std::find(near_first.begin(), near_first.end(), 0) != near_first.end());
+		REQUIRE(std::find(near_first.begin(), near_first.end(), 1) == near_first.end());
+
+		REQUIRE(world->get_candidate_shapes(physics::FVector3(2500.0, 0.0, 0.0)).empty());
+		REQUIRE(world->get_candidate_shapes(physics::FVector3(-1e6, 0.0, 0.0)).empty());
+	}
+
+	SECTION("Heightfields without a cell are rejected")
+	{
+		physics::FCollisionHeightfield heightfield;
+		heightfield.num_samples_x = 1;
+		heightfield.num_samples_y = 4;
+		heightfield.heights.assign(4, 0.0);
+
+		physics::FCollisionGeometry geometry;
+		geometry.shapes.push_back(heightfield);
+		REQUIRE(physics::collision::compile(geometry) == nullptr);
+
+		// One height short
+		auto& grid = std::get<physics::FCollisionHeightfield>(geometry.shapes[0]);
+		grid.num_samples_x = 2;
+		REQUIRE(physics::collision::compile(geometry) == nullptr);
+
+		grid.heights.resize(8, 0.0);
+		REQUIRE(physics::collision::compile(geometry) != nullptr);
+	}
+
+	SECTION("Lands and rests on the ground")
+	{
+		physics::FCollisionGeometry geometry;
+		geometry.ground_height = 0.0;
+
+		auto simulation = make_falling_drone(geometry, physics::FVector3(0.0, 0.0, 100.0));
+		fly_seconds(simulation, 3.0);
+
+		// The props spheres sit on the ground, sunk by the weight on the springs
+		const auto prop_radius = simulation.model->collision_shape.spheres[0].radius;
+		REQUIRE(simulation.body.transform_world.location.Z == Approx(prop_radius).margin(3.0));
+		REQUIRE(simulation.body.linear_velocity_world.size() < 0.01);
+		REQUIRE(simulation.last_contact.num_contacts > 0);
+	}
+
+	SECTION("Reports the impact speed of a crash")
+	{
+		physics::FCollisionGeometry geometry;
+		geometry.ground_height = 0.0;
+
+		// About 4.4 m/s after a 1 m fall
+		auto simulation = make_falling_drone(geometry, physics::FVector3(0.0, 0.0, 107.0));
+		double max_impact_speed = 0.0;
+		for (int substep = 0; substep < 400; substep++)
+		{
+			simulation.advance_substeps(1, physics::FDronePlayerInput::zero());
+			max_impact_speed = std::max(max_impact_speed, simulation.last_contact.max_impact_speed);
+		}
+
+		REQUIRE(max_impact_speed == Approx(4.4).margin(0.3));
+	}
+
+	SECTION("Bounces off a wall")
+	{
+		physics::FCollisionGeometry geometry;
+		geometry.shapes.push_back(physics::FCollisionBox { physics::FRigidTransform(physics::FQuaternion::identity(),
+			physics::FVector3(100.0, 0.0, 0.0)), physics::FVector3(10.0, 500.0, 500.0) });
+
+		auto simulation = make_falling_drone(geometry, physics::FVector3::zero());
+		simulation.body.linear_velocity_world = physics::FVector3(3.0, 0.0, 0.0);
+		fly_seconds(simulation, 0.5);
+
+		REQUIRE(simulation.body.linear_velocity_world.X < -0.5);
+		REQUIRE(simulation.body.transform_world.location.X < 90.0);
+	}
+
+	SECTION("Hits the post of a gate")
+	{
+		physics::FCollisionGeometry geometry;
+		geometry.shapes.push_back(physics::FCollisionCapsule { physics::FVector3(100.0, 0.0, -500.0), physics::FVector3(100.0, 0.0, 500.0), 5.0 });
+
+		auto simulation = make_falling_drone(geometry, physics::FVector3::zero());
+		simulation.body.linear_velocity_world = physics::FVector3(3.0, 0.0, 0.0);
+		fly_seconds(simulation, 0.5);
+
+		REQUIRE(simulation.body.linear_velocity_world.X < 0.0);
+	}
+
+	SECTION("Rests on a heightfield")
+	{
+		// Gentle slope along X: 10 cm per meter
+		physics::FCollisionHeightfield heightfield;
+		heightfield.origin = physics::FVector3(-1000.0, -1000.0, 50.0);
+		heightfield.cell_size = 100.0;
+		heightfield.num_samples_x = 21;
+		heightfield.num_samples_y = 21;
+		for (int y = 0; y < heightfield.num_samples_y; y++)
+		{
+			for (int x = 0; x < heightfield.num_samples_x; x++)
+			{
+				heightfield.heights.push_back(x * 10.0);
+			}
+		}
+
+		REQUIRE(heightfield.get_height(0.0, 0.0) == Approx(100.0));
+		REQUIRE(heightfield.get_normal(0.0, 0.0).X < 0.0);
+
+		physics::FCollisionGeometry geometry;
+		geometry.shapes.push_back(heightfield);
+
+		auto simulation = make_falling_drone(geometry, physics::FVector3(0.0, 0.0, 250.0));
+		fly_seconds(simulation, 3.0);
+
+		const auto location = simulation.body.transform_world.location;
+		REQUIRE(location.Z > 150.0);
+		REQUIRE(location.Z < 175.0);
+		REQUIRE(simulation.body.linear_velocity_world.size() < 0.05);
+	}
+}
+
+#endif
@@ -0,0 +1,482 @@
+#include "DroneSimulatorPhysics/Public/Collision/CollisionWorld.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+#include "DroneSimulatorPhysics/Private/Utils/Variant.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+	// Above this, the grid cells are made larger, so that a huge heightfield doesn't allocate millions of cells
+	constexpr std::int64_t max_grid_cells = 1 << 22;
+
+	struct FSurfaceContact
+	{
+		// Unit normal, pointing out of the shape
+		physics::FVector3 normal;
+
+		// In unreal units
+		double penetration = 0.0;
+	};
+
+	struct FBoundsXY
+	{
+		double min_x = 0.0;
+		double min_y = 0.0;
+		double max_x = 0.0;
+		double max_y = 0.0;
+	};
+
+	// At least one cell, and one height per sample
+	bool is_heightfield_valid(const physics::FCollisionHeightfield& heightfield)
+	{
+		return heightfield.num_samples_x >= 2 && heightfield.num_samples_y >= 2 && heightfield.cell_size > 0.0
+			&& heightfield.heights.size() == static_cast<std::size_t>(heightfield.num_samples_x) * heightfield.num_samples_y;
+	}
+
+	FBoundsXY get_shape_bounds(const physics::FCollisionShape& shape)
+	{
+		const auto around = [](const physics::FVector3& min, const physics::FVector3& max, double margin)
+		{
+			return FBoundsXY { min.X - margin, min.Y - margin, max.X + margin, max.Y + margin };
+		};
+
+		return physics::match_variant(
+			shape,
+			[&](const physics::FCollisionSphere& sphere)
+			{
+				return around(sphere.center, sphere.center, sphere.radius);
+			},
+			[&](const physics::FCollisionCapsule& capsule)
+			{
+				const auto min = physics::FVector3(std::min(capsule.start.X, capsule.end.X), std::min(capsule.start.Y, capsule.end.Y), 0.0);
+				const auto max = physics::FVector3(std::max(capsule.start.X, capsule.end.X), std::max(capsule.start.Y, capsule.end.Y), 0.0);
+				return around(min, max, capsule.radius);
+			},
+			[&](const physics::FCollisionBox& box)
+			{
+				const auto& rotation = box.transform.rotation;
+				const auto extent = rotation.get_axis_x().get_abs() * box.half_extent.X
+					+ rotation.get_axis_y().get_abs() * box.half_extent.Y
+					+ rotation.get_axis_z().get_abs() * box.half_extent.Z;
+				return around(box.transform.location - extent, box.transform.location + extent, 0.0);
+			},
+			[&](const physics::FCollisionHeightfield& heightfield)
+			{
+				const auto size = physics::FVector3(std::max(0, heightfield.num_samples_x - 1) * heightfield.cell_size,
+					std::max(0, heightfield.num_samples_y - 1) * heightfield.cell_size, 0.0);
+				return around(heightfield.origin, heightfield.origin + size, 0.0);
+			}
+		);
+	}
+
+	std::optional<FSurfaceContact> find_point_contact(const physics::FVector3& surface_point, double surface_radius,
+		const physics::FVector3& center, double radius)
+	{
+		const auto delta = center - surface_point;
+		const auto distance = delta.size();
+		const auto penetration = radius + surface_radius - distance;
+		if (penetration <= 0.0)
+		{
+			return std::nullopt;
+		}
+
+		const auto normal = distance > 1e-9 ? delta / distance : physics::FVector3::up();
+		return FSurfaceContact { normal, penetration };
+	}
+
+	std::optional<FSurfaceContact> find_box_contact(const physics::FCollisionBox& box, const physics::FVector3& center,
+		double radius)
+	{
+		const auto& rotation = box.transform.rotation;
+		const auto& half_extent = box.half_extent;
+		const auto center_local = rotation.unrotate_vector(center - box.transform.location);
+
+		const auto closest_local = physics::FVector3(
+			physics::math::clamp(center_local.X, -half_extent.X, half_extent.X),
+			physics::math::clamp(center_local.Y, -half_extent.Y, half_extent.Y),
+			physics::math::clamp(center_local.Z, -half_extent.Z, half_extent.Z));
+
+		if (closest_local != center_local)
+		{
+			const auto delta_local = center_local - closest_local;
+			const auto distance = delta_local.size();
+			if (distance >= radius)
+			{
+				return std::nullopt;
+			}
+
+			return FSurfaceContact { rotation.rotate_vector(delta_local / distance), radius - distance };
+		}
+
+		// The center is inside: push out through the closest face
+		const auto depth = half_extent - center_local.get_abs();
+		auto normal_local = physics::FVector3(center_local.X >= 0.0 ? 1.0 : -1.0, 0.0, 0.0);
+		auto face_depth = depth.X;
+		if (depth.Y < face_depth)
+		{
+			normal_local = physics::FVector3(0.0, center_local.Y >= 0.0 ? 1.0 : -1.0, 0.0);
+			face_depth = depth.Y;
+		}
+		if (depth.Z < face_depth)
+		{
+			normal_local = physics::FVector3(0.0, 0.0, center_local.Z >= 0.0 ? 1.0 : -1.0);
+			face_depth = depth.Z;
+		}
+
+		return FSurfaceContact { rotation.rotate_vector(normal_local), radius + face_depth };
+	}
+
+	std::optional<FSurfaceContact> find_contact(const physics::FCollisionShape& shape, const physics::FVector3& center,
+		double radius)
+	{
+		return physics::match_variant(
+			shape,
+			[&](const physics::FCollisionSphere& sphere)
+			{
+				return find_point_contact(sphere.center, sphere.radius, center, radius);
+			},
+			[&](const physics::FCollisionCapsule& capsule)
+			{
+				const auto segment = capsule.end - capsule.start;
+				const auto segment_length_squared = segment.size_squared();
+				const auto alpha = segment_length_squared > 0.0
+					? physics::math::clamp((center - capsule.start).dot(segment) / segment_length_squared, 0.0, 1.0)
+					: 0.0;
+				return find_point_contact(capsule.start + segment * alpha, capsule.radius, center, radius);
+			},
+			[&](const physics::FCollisionBox& box)
+			{
+				return find_box_contact(box, center, radius);
+			},
+			[&](const physics::FCollisionHeightfield& heightfield) -> std::optional<FSurfaceContact>
+			{
+				if (!heightfield.contains(center.X, center.Y))
+				{
+					return std::nullopt;
+				}
+
+				// Distance to the plane tangent to the terrain below the center
+				const auto height = heightfield.origin.Z + heightfield.get_height(center.X, center.Y);
+				const auto normal = heightfield.get_normal(center.X, center.Y);
+				const auto penetration = radius - (center.Z - height) * normal.Z;
+				if (penetration <= 0.0)
+				{
+					return std::nullopt;
+				}
+
+				return FSurfaceContact { normal, penetration };
+			}
+		);
+	}
+
+	struct FContactSpring
+	{
+		// In N/m
+		double stiffness = 0.0;
+
+		// In N·s/m
+		double damping = 0.0;
+
+		double friction_coefficient = 0.0;
+	};
+
+	void apply_contact_force(physics::FSubstepBody* substep_body, const FContactSpring& spring,
+		const physics::FCollisionSphere& sphere, const FSurfaceContact& contact, physics::FContactResult& result)
+	{
+		// Deepest point of the sphere, in the drone frame
+		const auto point_location_local = sphere.center
+			+ substep_body->transform_world.rotation.unrotate_vector(contact.normal * -sphere.radius);
+
+		const auto velocity = substep_body->get_velocity_at_location(point_location_local);
+		const auto normal_speed = velocity.dot(contact.normal);
+
+		const auto penetration_m = contact.penetration / 100.0;
+		const auto normal_force = std::max(0.0, spring.stiffness * penetration_m - spring.damping * normal_speed);
+
+		// Viscous friction, up to the Coulomb limit
+		const auto tangent_velocity = velocity - contact.normal * normal_speed;
+		const auto tangent_speed = tangent_velocity.size();
+		const auto friction_force = tangent_speed > 1e-6
+			? tangent_velocity * (-std::min(spring.friction_coefficient * normal_force, spring.damping * tangent_speed) / tangent_speed)
+			: physics::FVector3::zero();
+
+		substep_body->add_force_at_point(contact.normal * normal_force + friction_force, point_location_local);
+
+		result.num_contacts++;
+		result.max_impact_speed = std::max(result.max_impact_speed, -normal_speed);
+	}
+}
+
+double physics::FCollisionHeightfield::get_height(double x, double y) const
+{
+	assert(this->num_samples_x >= 2 && this->num_samples_y >= 2);
+
+	const auto sample_x = (x - this->origin.X) / this->cell_size;
+	const auto sample_y = (y - this->origin.Y) / this->cell_size;
+	const auto index_x = std::clamp(static_cast<std::int32_t>(std::floor(sample_x)), 0, this->num_samples_x - 2);
+	const auto index_y = std::clamp(static_cast<std::int32_t>(std::floor(sample_y)), 0, this->num_samples_y - 2);
+	const auto alpha_x = sample_x - index_x;
+	const auto alpha_y = sample_y - index_y;
+
+	const auto* row = &this->heights[index_y * this->num_samples_x + index_x];
+	const auto* next_row = row + this->num_samples_x;
+
+	const auto height_low_y = row[0] + (row[1] - row[0]) * alpha_x;
+	const auto height_high_y = next_row[0] + (next_row[1] - next_row[0]) * alpha_x;
+	return height_low_y + (height_high_y - height_low_y) * alpha_y;
+}
+
+physics::FVector3 physics::FCollisionHeightfield::get_normal(double x, double y) const
+{
+	assert(this->num_samples_x >= 2 && this->num_samples_y >= 2);
+
+	const auto sample_x = (x - this->origin.X) / this->cell_size;
+	const auto sample_y = (y - this->origin.Y) / this->cell_size;
+	const auto index_x = std::clamp(static_cast<std::int32_t>(std::floor(sample_x)), 0, this->num_samples_x - 2);
+	const auto index_y = std::clamp(static_cast<std::int32_t>(std::floor(sample_y)), 0, this->num_samples_y - 2);
+	const auto alpha_x = sample_x - index_x;
+	const auto alpha_y = sample_y - index_y;
+
+	const auto* row = &this->heights[index_y * this->num_samples_x + index_x];
+	const auto* next_row = row + this->num_samples_x;
+
+	// Gradient of the bilinear interpolation
+	const auto slope_x = ((row[1] - row[0]) * (1.0 - alpha_y) + (next_row[1] - next_row[0]) * alpha_y) / this->cell_size;
+	const auto slope_y = ((next_row[0] - row[0]) * (1.0 - alpha_x) + (next_row[1] - row[1]) * alpha_x) / this->cell_size;
+
+	return FVector3(-slope_x, -slope_y, 1.0).get_safe_normal();
+}
+
+bool physics::FCollisionHeightfield::contains(double x, double y) const
+{
+	if (this->num_samples_x < 2 || this->num_samples_y < 2)
+	{
+		return false;
+	}
+
+	const auto sample_x = (x - this->origin.X) / this->cell_size;
+	const auto sample_y = (y - this->origin.Y) / this->cell_size;
+	return sample_x >= 0.0 && sample_y >= 0.0 && sample_x <= this->num_samples_x - 1 && sample_y <= this->num_samples_y - 1;
+}
+
+std::span<const std::int32_t> physics::FCollisionWorld::get_candidate_shapes(const FVector3& location) const
+{
+	const auto cell_x = static_cast<std::int64_t>(std::floor((location.X - this->grid_origin_x) / this->grid_cell_size));
+	const auto cell_y = static_cast<std::int64_t>(std::floor((location.Y - this->grid_origin_y) / this->grid_cell_size));
+	if (cell_x < 0 || cell_y < 0 || cell_x >= this->num_cells_x || cell_y >= this->num_cells_y)
+	{
+		return {};
+	}
+
+	const auto cell_index = cell_y * this->num_cells_x + cell_x;
+	const auto first = this->cell_starts[cell_index];
+	const auto last = this->cell_starts[cell_index + 1];
+	return std::span(this->shape_indices.data() + first, last - first);
+}
+
+std::shared_ptr<const physics::FCollisionWorld> physics::collision::compile(FCollisionGeometry geometry)
+{
+	for (const auto& shape : geometry.shapes)
+	{
+		const auto* heightfield = std::get_if<FCollisionHeightfield>(&shape);
+		if (heightfield != nullptr && !is_heightfield_valid(*heightfield))
+		{
+			return nullptr;
+		}
+	}
+
+	auto world = std::make_shared<FCollisionWorld>();
+	world->geometry = std::move(geometry);
+
+	const auto& shapes = world->geometry.shapes;
+	const auto num_shapes = static_cast<std::int32_t>(shapes.size());
+	if (num_shapes == 0)
+	{
+		return world;
+	}
+
+	// Shapes are inflated by the largest drone, so that a query only reads the cell of the drone center
+	const auto margin = world->geometry.max_body_radius;
+	std::vector<FBoundsXY> shape_bounds;
+	shape_bounds.reserve(num_shapes);
+
+	auto grid_bounds = get_shape_bounds(shapes[0]);
+	for (const auto& shape : shapes)
+	{
+		auto bounds = get_shape_bounds(shape);
+		bounds = FBoundsXY { bounds.min_x - margin, bounds.min_y - margin, bounds.max_x + margin, bounds.max_y + margin };
+		shape_bounds.push_back(bounds);
+
+		grid_bounds.min_x = std::min(grid_bounds.min_x, bounds.min_x);
+		grid_bounds.min_y = std::min(grid_bounds.min_y, bounds.min_y);
+		grid_bounds.max_x = std::max(grid_bounds.max_x, bounds.max_x);
+		grid_bounds.max_y = std::max(grid_bounds.max_y, bounds.max_y);
+	}
+
+	auto cell_size = std::max(world->geometry.grid_cell_size, 1.0);
+	const auto count_cells = [&](double size)
+	{
+		return static_cast<std::int64_t>(std::floor((grid_bounds.max_x - grid_bounds.min_x) / size)) + 1;
+	};
+	const auto count_cells_y = [&](double size)
+	{
+		return static_cast<std::int64_t>(std::floor((grid_bounds.max_y - grid_bounds.min_y) / size)) + 1;
+	};
+	while (count_cells(cell_size) * count_cells_y(cell_size) > max_grid_cells)
+	{
+		cell_size *= 2.0;
+	}
+
+	world->grid_cell_size = cell_size;
+	world->grid_origin_x = grid_bounds.min_x;
+	world->grid_origin_y = grid_bounds.min_y;
+	world->num_cells_x = static_cast<std::int32_t>(count_cells(cell_size));
+	world->num_cells_y = static_cast<std::int32_t>(count_cells_y(cell_size));
+
+	const auto get_cell_range = [&](const FBoundsXY& bounds)
+	{
+		return std::array<std::int32_t, 4> {
+			static_cast<std::int32_t>(std::floor((bounds.min_x - world->grid_origin_x) / cell_size)),
+			static_cast<std::int32_t>(std::floor((bounds.min_y - world->grid_origin_y) / cell_size)),
+			std::min(world->num_cells_x - 1, static_cast<std::int32_t>(std::floor((bounds.max_x - world->grid_origin_x) / cell_size))),
+			std::min(world->num_cells_y - 1, static_cast<std::int32_t>(std::floor((bounds.max_y - world->grid_origin_y) / cell_size))),
+		};
+	};
+
+	// Two passes: count the shapes of each cell, then fill the cells
+	const auto num_cells = static_cast<std::size_t>(world->num_cells_x) * world->num_cells_y;
+	world->cell_starts.assign(num_cells + 1, 0);
+	for (const auto& bounds : shape_bounds)
+	{
+		const auto [min_x, min_y, max_x, max_y] = get_cell_range(bounds);
+		for (auto cell_y = min_y; cell_y <= max_y; cell_y++)
+		{
+			for (auto cell_x = min_x; cell_x <= max_x; cell_x++)
+			{
+				world->cell_starts[cell_y * world->num_cells_x + cell_x + 1]++;
+			}
+		}
+	}
+
+	for (std::size_t cell_index = 0; cell_index < num_cells; cell_index++)
+	{
+		world->cell_starts[cell_index + 1] += world->cell_starts[cell_index];
+	}
+
+	world->shape_indices.resize(world->cell_starts[num_cells]);
+	auto cell_fill = std::vector<std::int32_t>(world->cell_starts.begin(), world->cell_starts.end() - 1);
+	for (std::int32_t shape_index = 0; shape_index < num_shapes; shape_index++)
+	{
+		const auto [min_x, min_y, max_x, max_y] = get_cell_range(shape_bounds[shape_index]);
+		for (auto cell_y = min_y; cell_y <= max_y; cell_y++)
+		{
+			for (auto cell_x = min_x; cell_x <= max_x; cell_x++)
+			{
+				world->shape_indices[cell_fill[cell_y * world->num_cells_x + cell_x]++] = shape_index;
+			}
+		}
+	}
+
+	return world;
+}
+
+physics::FDroneCollisionShape physics::collision::make_drone_shape(const std::vector<FRotorDescription>& rotors,
+	double propeller_radius)
+{
+	// Without propellers, the drone is a 10 cm ball
+	const auto sphere_radius = propeller_radius > 0.0 ? propeller_radius * 100.0 : 10.0;
+
+	FDroneCollisionShape shape;
+	shape.spheres[0] = FCollisionSphere { FVector3::zero(), sphere_radius };
+	shape.count = 1;
+
+	for (const auto& rotor : rotors)
+	{
+		if (shape.count == static_cast<std::int32_t>(shape.spheres.size()))
+		{
+			break;
+		}
+
+		shape.spheres[shape.count] = FCollisionSphere { rotor.location, sphere_radius };
+		shape.count++;
+	}
+
+	for (std::int32_t sphere_index = 0; sphere_index < shape.count; sphere_index++)
+	{
+		const auto& sphere = shape.spheres[sphere_index];
+		shape.bounding_radius = std::max(shape.bounding_radius, sphere.center.size() + sphere.radius);
+	}
+
+	return shape;
+}
+
+physics::FContactResult physics::collision::apply_contacts(const FCollisionWorld& world, FSubstepBody* substep_body,
+	const FDroneCollisionShape& drone_shape, double substep_delta_time)
+{
+	FContactResult result;
+
+	const auto& geometry = world.geometry;
+	const auto& transform = substep_body->transform_world;
+
+	// A larger drone would miss the shapes inserted in the neighbouring cells only
+	assert(drone_shape.bounding_radius <= geometry.max_body_radius);
+
+	// Open air is the common case: one comparison for the ground and one grid lookup
+	const auto is_near_ground = geometry.ground_height.has_value()
+		&& transform.location.Z - drone_shape.bounding_radius < *geometry.ground_height;
+	const auto candidate_shapes = world.get_candidate_shapes(transform.location);
+	if (!is_near_ground && candidate_shapes.empty())
+	{
+		return result;
+	}
+
+	// Each sphere carries an equal share of the mass. The frequency is clamped so that w·dt stays below 1, past which
+	// the explicit integration of a stiff spring diverges.
+	const auto& material = geometry.material;
+	const auto mass_share = substep_body->mass / drone_shape.count;
+	const auto angular_frequency = std::min(math::two_pi * material.stiffness_frequency_hz, 1.0 / substep_delta_time);
+
+	FContactSpring spring;
+	spring.stiffness = mass_share * math::square(angular_frequency);
+	spring.damping = 2.0 * material.damping_ratio * mass_share * angular_frequency;
+	spring.friction_coefficient = material.friction_coefficient;
+
+	if (is_near_ground)
+	{
+		for (std::int32_t sphere_index = 0; sphere_index < drone_shape.count; sphere_index++)
+		{
+			const auto& sphere = drone_shape.spheres[sphere_index];
+			const auto center = transform.transform_position(sphere.center);
+			const auto penetration = sphere.radius - (center.Z - *geometry.ground_height);
+			if (penetration > 0.0)
+			{
+				apply_contact_force(substep_body, spring, sphere, FSurfaceContact { FVector3::up(), penetration }, result);
+			}
+		}
+	}
+
+	for (const auto shape_index : candidate_shapes)
+	{
+		const auto& shape = geometry.shapes[shape_index];
+
+		// Whole drone first, most candidates are only near
+		if (!find_contact(shape, transform.location, drone_shape.bounding_radius).has_value())
+		{
+			continue;
+		}
+
+		for (std::int32_t sphere_index = 0; sphere_index < drone_shape.count; sphere_index++)
+		{
+			const auto& sphere = drone_shape.spheres[sphere_index];
+			if (const auto contact = find_contact(shape, transform.transform_position(sphere.center), sphere.radius))
+			{
+				apply_contact_force(substep_body, spring, sphere, *contact, result);
+			}
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,213 @@
+#include "DroneSimulatorPhysics/Public/Controller/ControllerBatch.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+
+void physics::FAxisColumns::resize(std::int32_t size)
+{
+	this->x.resize(size);
+	this->y.resize(size);
+	this->z.resize(size);
+}
+
+void physics::FSetpointColumns::resize(std::int32_t size)
+{
+	this->throttle.resize(size);
+	this->angular_velocity_radians.resize(size);
+}
+
+void physics::FFlightModeAirBatch::resize(std::int32_t size)
+{
+	this->roll_rate_deg_per_second.resize(size);
+	this->pitch_rate_deg_per_second.resize(size);
+	this->yaw_rate_deg_per_second.resize(size);
+	this->input_throttle.resize(size);
+	this->input_yaw.resize(size);
+	this->input_pitch.resize(size);
+	this->input_roll.resize(size);
+}
+
+void physics::FFlightModeAirBatch::set_flight_mode(std::int32_t index, const FFlightModeAir& flight_mode)
+{
+	this->roll_rate_deg_per_second[index] = flight_mode.roll_rate_deg_per_second;
+	this->pitch_rate_deg_per_second[index] = flight_mode.pitch_rate_deg_per_second;
+	this->yaw_rate_deg_per_second[index] = flight_mode.yaw_rate_deg_per_second;
+}
+
+void physics::FFlightModeAirBatch::set_input(std::int32_t index, const FDronePlayerInput& input)
+{
+	this->input_throttle[index] = input.throttle;
+	this->input_yaw[index] = input.yaw;
+	this->input_pitch[index] = input.pitch;
+	this->input_roll[index] = input.roll;
+}
+
+void physics::FPidControllerBatch::resize(std::int32_t size)
+{
+	this->proportional.resize(size);
+	this->integral.resize(size);
+	this->derivative.resize(size);
+	this->min_throttle.resize(size);
+	this->min_dynamic_throttle.resize(size);
+	this->last_angular_velocity_error.resize(size);
+	this->integrated_angular_velocity_error.resize(size);
+	this->current_angular_velocity.resize(size);
+	this->delta_time.resize(size);
+	this->is_active.resize(size);
+	this->mixers.resize(size);
+	this->delta_throttle_angular.resize(size);
+	this->throttle.resize(size);
+}
+
+void physics::FPidControllerBatch::set_controller(std::int32_t index, const FPidDroneController& controller)
+{
+	const auto& config = controller.config;
+	this->proportional.set(index, FVector3(config.roll_pid.proportional, config.pitch_pid.proportional, config.yaw_pid.proportional));
+	this->integral.set(index, FVector3(config.roll_pid.integral, config.pitch_pid.integral, config.yaw_pid.integral));
+	this->derivative.set(index, FVector3(config.roll_pid.derivative, config.pitch_pid.derivative, config.yaw_pid.derivative));
+	this->min_throttle[index] = config.min_throttle;
+	this->min_dynamic_throttle[index] = config.min_dynamic_throttle;
+	this->last_angular_velocity_error.set(index, controller.state.last_angular_velocity_error);
+	this->integrated_angular_velocity_error.set(index, controller.state.integrated_angular_velocity_error);
+}
+
+physics::FPidDroneControllerState physics::FPidControllerBatch::get_state(std::int32_t index) const
+{
+	FPidDroneControllerState state;
+	state.last_angular_velocity_error = this->last_angular_velocity_error.get(index);
+	state.integrated_angular_velocity_error = this->integrated_angular_velocity_error.get(index);
+	return state;
+}
+
+void physics::controller_batch::compute_air_setpoints(const FFlightModeAirBatch& flight_modes, FSetpointColumns& out_setpoints)
+{
+	const auto count = flight_modes.size();
+
+	const auto* __restrict roll_rate = flight_modes.roll_rate_deg_per_second.data();
+	const auto* __restrict pitch_rate = flight_modes.pitch_rate_deg_per_second.data();
+	const auto* __restrict yaw_rate = flight_modes.yaw_rate_deg_per_second.data();
+	const auto* __restrict input_throttle = flight_modes.input_throttle.data();
+	const auto* __restrict input_yaw = flight_modes.input_yaw.data();
+	const auto* __restrict input_pitch = flight_modes.input_pitch.data();
+	const auto* __restrict input_roll = flight_modes.input_roll.data();
+
+	auto* __restrict setpoint_throttle = out_setpoints.throttle.data();
+	auto* __restrict setpoint_x = out_setpoints.angular_velocity_radians.x.data();
+	auto* __restrict setpoint_y = out_setpoints.angular_velocity_radians.y.data();
+	auto* __restrict setpoint_z = out_setpoints.angular_velocity_radians.z.data();
+
+	// Same operations as compute_air_setpoint, in the same order
+	for (std::int32_t index = 0; index < count; index++)
+	{
+		setpoint_throttle[index] = input_throttle[index];
+		setpoint_x[index] = input_roll[index] * -math::degrees_to_radians(roll_rate[index]);
+		setpoint_y[index] = input_pitch[index] * -math::degrees_to_radians(pitch_rate[index]);
+		setpoint_z[index] = input_yaw[index] * math::degrees_to_radians(yaw_rate[index]);
+	}
+}
+
+void physics::controller_batch::tick_pid(FPidControllerBatch& controllers, const FSetpointColumns& setpoints)
+{
+	constexpr auto angular_velocity_clamp = math::degrees_to_radians(360.0);
+	constexpr auto error_interp_speed = 500.0;
+
+	const auto count = controllers.size();
+
+	const auto* __restrict setpoint_x = setpoints.angular_velocity_radians.x.data();
+	const auto* __restrict setpoint_y = setpoints.angular_velocity_radians.y.data();
+	const auto* __restrict setpoint_z = setpoints.angular_velocity_radians.z.data();
+	const auto* __restrict current_x = controllers.current_angular_velocity.x.data();
+	const auto* __restrict current_y = controllers.current_angular_velocity.y.data();
+	const auto* __restrict current_z = controllers.current_angular_velocity.z.data();
+	const auto* __restrict proportional_x = controllers.proportional.x.data();
+	const auto* __restrict proportional_y = controllers.proportional.y.data();
+	const auto* __restrict proportional_z = controllers.proportional.z.data();
+	const auto* __restrict integral_x = controllers.integral.x.data();
+	const auto* __restrict integral_y = controllers.integral.y.data();
+	const auto* __restrict integral_z = controllers.integral.z.data();
+	const auto* __restrict derivative_x = controllers.derivative.x.data();
+	const auto* __restrict derivative_y = controllers.derivative.y.data();
+	const auto* __restrict derivative_z = controllers.derivative.z.data();
+	const auto* __restrict delta_time = controllers.delta_time.data();
+	const auto* __restrict is_active = controllers.is_active.data();
+
+	auto* __restrict last_error_x = controllers.last_angular_velocity_error.x.data();
+	auto* __restrict last_error_y = controllers.last_angular_velocity_error.y.data();
+	auto* __restrict last_error_z = controllers.last_angular_velocity_error.z.data();
+	auto* __restrict integrated_error_x = controllers.integrated_angular_velocity_error.x.data();
+	auto* __restrict integrated_error_y = controllers.integrated_angular_velocity_error.y.data();
+	auto* __restrict integrated_error_z = controllers.integrated_angular_velocity_error.z.data();
+	auto* __restrict delta_throttle_x = controllers.delta_throttle_angular.x.data();
+	auto* __restrict delta_throttle_y = controllers.delta_throttle_angular.y.data();
+	auto* __restrict delta_throttle_z = controllers.delta_throttle_angular.z.data();
+
+	// Same as FVector3::bound_to_cube
+	const auto bound = [](double value)
+	{
+		return value < -angular_velocity_clamp ? -angular_velocity_clamp : (value > angular_velocity_clamp ? angular_velocity_clamp : value);
+	};
+
+	// Same operations as tick_pid_controller, in the same order, so that the results are the same bit for bit.
+	// Every controller is computed, the inactive ones keep their state
+	for (std::int32_t index = 0; index < count; index++)
+	{
+		const auto dt = delta_time[index];
+		const auto previous_error_x = last_error_x[index];
+		const auto previous_error_y = last_error_y[index];
+		const auto previous_error_z = last_error_z[index];
+		const auto previous_integrated_x = integrated_error_x[index];
+		const auto previous_integrated_y = integrated_error_y[index];
+		const auto previous_integrated_z = integrated_error_z[index];
+
+		const auto error_x = bound(setpoint_x[index] - current_x[index]);
+		const auto error_y = bound(setpoint_y[index] - current_y[index]);
+		const auto error_z = bound(setpoint_z[index] - current_z[index]);
+
+		const auto error_derivative_x = (error_x - previous_error_x) / dt;
+		const auto error_derivative_y = (error_y - previous_error_y) / dt;
+		const auto error_derivative_z = (error_z - previous_error_z) / dt;
+
+		// vector_interp_to of the last error towards the error
+		const auto distance_x = error_x - previous_error_x;
+		const auto distance_y = error_y - previous_error_y;
+		const auto distance_z = error_z - previous_error_z;
+		const auto is_close = distance_x * distance_x + distance_y * distance_y + distance_z * distance_z < 1e-4;
+		const auto interp_alpha = math::clamp(dt * error_interp_speed, 0.0, 1.0);
+		const auto interp_error_x = previous_error_x + distance_x * interp_alpha;
+		const auto interp_error_y = previous_error_y + distance_y * interp_alpha;
+		const auto interp_error_z = previous_error_z + distance_z * interp_alpha;
+		const auto next_error_x = is_close ? error_x : interp_error_x;
+		const auto next_error_y = is_close ? error_y : interp_error_y;
+		const auto next_error_z = is_close ? error_z : interp_error_z;
+
+		const auto next_integrated_x = previous_integrated_x + error_x * dt;
+		const auto next_integrated_y = previous_integrated_y + error_y * dt;
+		const auto next_integrated_z = previous_integrated_z + error_z * dt;
+
+		delta_throttle_x[index] = -(error_x * proportional_x[index] + error_derivative_x * derivative_x[index]
+			+ next_integrated_x * integral_x[index]);
+		delta_throttle_y[index] = -(error_y * proportional_y[index] + error_derivative_y * derivative_y[index]
+			+ next_integrated_y * integral_y[index]);
+		delta_throttle_z[index] = -(error_z * proportional_z[index] + error_derivative_z * derivative_z[index]
+			+ next_integrated_z * integral_z[index]);
+
+		const auto active = is_active[index] != 0;
+		last_error_x[index] = active ? next_error_x : previous_error_x;
+		last_error_y[index] = active ? next_error_y : previous_error_y;
+		last_error_z[index] = active ? next_error_z : previous_error_z;
+		integrated_error_x[index] = active ? next_integrated_x : previous_integrated_x;
+		integrated_error_y[index] = active ? next_integrated_y : previous_integrated_y;
+		integrated_error_z[index] = active ? next_integrated_z : previous_integrated_z;
+	}
+
+	// The allocation branches on the throttle of each rotor, it runs per drone
+	for (std::int32_t index = 0; index < count; index++)
+	{
+		if (is_active[index] == 0)
+		{
+			continue;
+		}
+
+		controllers.throttle[index] = controller::allocate_pid_throttle(controllers.min_throttle[index],
+			controllers.min_dynamic_throttle[index], setpoints.throttle[index], controllers.delta_throttle_angular.get(index),
+			*controllers.mixers[index]);
+	}
+}
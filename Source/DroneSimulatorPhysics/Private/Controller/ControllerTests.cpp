@@ -0,0 +1,278 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Public/Controller/ControllerBatch.h"
+#include "DroneSimulatorPhysics/Public/Controller/DroneController.h"
+#include "DroneSimulatorPhysics/Public/Controller/FlightMode.h"
+#include "DroneSimulatorPhysics/Public/Controller/Mixer.h"
+#include "DroneSimulatorPhysics/Public/Controller/PilotInputBuffer.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("PID controller", "[controller]")
+{
+	using physics::FVector3;
+
+	physics::FPidDroneController controller;
+	constexpr auto delta_time = 1.0 / 400.0;
+
+	SECTION("No angular velocity error gives the same throttle on each propeller")
+	{
+		const auto setpoint = physics::FDroneSetpoint { 0.5, FVector3::zero() };
+		const auto throttle = physics::controller::tick_pid_controller(controller.config, controller.state, delta_time,
+			setpoint, FVector3::zero());
+
+		REQUIRE(throttle.front_left == Approx(0.5));
+		REQUIRE(throttle.front_right == Approx(0.5));
+		REQUIRE(throttle.rear_left == Approx(0.5));
+		REQUIRE(throttle.rear_right == Approx(0.5));
+	}
+
+	SECTION("Throttle stays in the dynamic range")
+	{
+		const auto setpoint = physics::FDroneSetpoint { 1.0, FVector3(0.0, 0.0, 6.0) };
+		const auto throttle = physics::controller::tick_pid_controller(controller.config, controller.state, delta_time,
+			setpoint, FVector3::zero());
+
+		for (const double value : { throttle.front_left, throttle.front_right, throttle.rear_left, throttle.rear_right })
+		{
+			REQUIRE(value >= controller.config.min_dynamic_throttle);
+			REQUIRE(value <= 1.0);
+		}
+	}
+}
+
+TEST_CASE("Batched controllers", "[controller]")
+{
+	using physics::FVector3;
+
+	constexpr std::int32_t drone_count = 37;
+	const auto mixer = physics::mixer::make_quad_x();
+
+	// Gains, errors and setpoints that reach the clamps and both throttle corrections
+	std::vector<physics::FPidDroneController> controllers(drone_count);
+	std::vector<physics::FDroneSetpoint> setpoints(drone_count);
+	std::vector<FVector3> angular_velocities(drone_count);
+	for (std::int32_t index = 0; index < drone_count; index++)
+	{
+		const auto factor = static_cast<double>(index) / drone_count;
+		auto& config = controllers[index].config;
+		config.roll_pid = physics::FPidConfig { 0.05 + 0.1 * factor, 0.02 * factor, 0.001 * factor };
+		config.pitch_pid = physics::FPidConfig { 0.1 - 0.05 * factor, 0.01, 0.002 };
+		config.yaw_pid = physics::FPidConfig { 0.3, 0.05 * factor, 0.0 };
+		controllers[index].state.last_angular_velocity_error = FVector3(0.1 * factor, -0.2, 0.003);
+		controllers[index].state.integrated_angular_velocity_error = FVector3(-0.01, 0.02 * factor, 0.0);
+
+		setpoints[index] = physics::FDroneSetpoint { factor * 1.1, FVector3(std::sin(index) * 9.0, std::cos(index) * 3.0, factor - 0.5) };
+		angular_velocities[index] = FVector3(std::cos(index * 0.7), -std::sin(index * 1.3) * 4.0, 0.2 * factor);
+	}
+
+	physics::FPidControllerBatch batch;
+	physics::FSetpointColumns setpoint_columns;
+	batch.resize(drone_count);
+	setpoint_columns.resize(drone_count);
+
+	for (std::int32_t index = 0; index < drone_count; index++)
+	{
+		batch.set_controller(index, controllers[index]);
+		batch.mixers[index] = &mixer;
+	}
+
+	// Several ticks, so that the integrators and the last error carry over
+	for (std::int32_t tick = 0; tick < 5; tick++)
+	{
+		for (std::int32_t index = 0; index < drone_count; index++)
+		{
+			setpoint_columns.set(index, setpoints[index]);
+			batch.current_angular_velocity.set(index, angular_velocities[index] * (1.0 + tick));
+			batch.delta_time[index] = 1.0 / 400.0;
+			batch.is_active[index] = (index + tick) % 3 != 0 ? 1 : 0;
+		}
+
+		physics::controller_batch::tick_pid(batch, setpoint_columns);
+
+		for (std::int32_t index = 0; index < drone_count; index++)
+		{
+			if (batch.is_active[index] == 0)
+			{
+				continue;
+			}
+
+			auto& controller = controllers[index];
+			const auto throttle = physics::controller::tick_pid_controller(controller.config, controller.state, 1.0 / 400.0,
+				setpoints[index], angular_velocities[index] * (1.0 + tick), mixer);
+
+			REQUIRE(batch.throttle[index].count == throttle.count);
+			REQUIRE(batch.throttle[index].values == throttle.values);
+		}
+	}
+
+	for (std::int32_t index = 0; index < drone_count; index++)
+	{
+		const auto state = batch.get_state(index);
+		REQUIRE(state.last_angular_velocity_error == controllers[index].state.last_angular_velocity_error);
+		REQUIRE(state.integrated_angular_velocity_error == controllers[index].state.integrated_angular_velocity_error);
+	}
+
+	SECTION("Air flight modes")
+	{
+		physics::FFlightModeAirBatch flight_modes;
+		flight_modes.resize(drone_count);
+
+		for (std::int32_t index = 0; index < drone_count; index++)
+		{
+			const auto flight_mode = physics::FFlightModeAir { 300.0 + index, 500.0 - index, 200.0 };
+			const auto input = physics::FDronePlayerInput { 0.5, std::sin(index), std::cos(index), -0.3 };
+			flight_modes.set_flight_mode(index, flight_mode);
+			flight_modes.set_input(index, input);
+
+			physics::controller_batch::compute_air_setpoints(flight_modes, setpoint_columns);
+			const auto setpoint = physics::flight_mode::compute_air_setpoint(flight_mode, input);
+			REQUIRE(setpoint_columns.throttle[index] == setpoint.throttle);
+			REQUIRE(setpoint_columns.angular_velocity_radians.get(index) == setpoint.angular_velocity_radians);
+		}
+	}
+}
+
+TEST_CASE("Mixer", "[controller]")
+{
+	using physics::FVector3;
+
+	SECTION("A symmetric quad X compiles to the quad X mixer")
+	{
+		const auto rotors = std::vector<physics::FRotorDescription> {
+			{ FVector3(10.0, -10.0, 0.0), FVector3::up(), true },
+			{ FVector3(10.0, 10.0, 0.0), FVector3::up(), false },
+			{ FVector3(-10.0, -10.0, 0.0), FVector3::up(), false },
+			{ FVector3(-10.0, 10.0, 0.0), FVector3::up(), true },
+		};
+
+		const auto compiled = physics::mixer::compile(rotors);
+		const auto quad_x = physics::mixer::make_quad_x();
+
+		REQUIRE(compiled.count == 4);
+		for (int rotor_index = 0; rotor_index < 4; rotor_index++)
+		{
+			REQUIRE(compiled.axis_factors[rotor_index] == quad_x.axis_factors[rotor_index]);
+		}
+	}
+
+	SECTION("A hexa keeps its collective throttle when yawing")
+	{
+		std::vector<physics::FRotorDescription> rotors;
+		for (int rotor_index = 0; rotor_index < 6; rotor_index++)
+		{
+			const auto angle = physics::math::two_pi * rotor_index / 6.0;
+			rotors.push_back({ FVector3(std::cos(angle), std::sin(angle), 0.0) * 12.0, FVector3::up(), rotor_index % 2 == 0 });
+		}
+
+		const auto mixer = physics::mixer::compile(rotors);
+		const auto throttle = physics::mixer::mix(mixer, 0.5, FVector3(0.0, 0.0, 0.1));
+
+		REQUIRE(throttle.count == 6);
+
+		double total_throttle = 0.0;
+		for (int rotor_index = 0; rotor_index < 6; rotor_index++)
+		{
+			total_throttle += throttle.values[rotor_index];
+			REQUIRE(throttle.values[rotor_index] == Approx(rotors[rotor_index].is_clockwise ? 0.6 : 0.4));
+		}
+		REQUIRE(total_throttle == Approx(3.0));
+	}
+
+	SECTION("An empty rotor set has no throttle")
+	{
+		const physics::FRotorSetThrottle throttle;
+
+		REQUIRE(throttle.min() == 0.0);
+		REQUIRE(throttle.max() == 0.0);
+	}
+
+	SECTION("The N-rotor PID matches the quad PID on a quad")
+	{
+		physics::FPidDroneController quad_controller;
+		physics::FPidDroneController rotor_controller;
+
+		const auto setpoint = physics::FDroneSetpoint { 0.6, FVector3(1.0, -2.0, 3.0) };
+		const auto current_angular_velocity = FVector3(0.5, 0.2, -0.1);
+
+		const auto quad_throttle = physics::controller::tick_pid_controller(quad_controller.config, quad_controller.state,
+			1.0 / 400.0, setpoint, current_angular_velocity);
+		const auto rotor_throttle = physics::controller::tick_pid_controller(rotor_controller.config, rotor_controller.state,
+			1.0 / 400.0, setpoint, current_angular_velocity, physics::mixer::make_quad_x());
+
+		REQUIRE(rotor_throttle.count == 4);
+		REQUIRE(rotor_throttle.values[0] == quad_throttle.front_left);
+		REQUIRE(rotor_throttle.values[1] == quad_throttle.front_right);
+		REQUIRE(rotor_throttle.values[2] == quad_throttle.rear_left);
+		REQUIRE(rotor_throttle.values[3] == quad_throttle.rear_right);
+	}
+}
+
+TEST_CASE("Flight modes", "[controller]")
+{
+	using physics::FVector3;
+
+	SECTION("Air mode maps the sticks to angular velocity")
+	{
+		const auto input = physics::FDronePlayerInput { 0.4, 1.0, 0.0, 0.0 };
+		const auto setpoint = physics::flight_mode::compute_air_setpoint(physics::FFlightModeAir(), input);
+
+		REQUIRE(setpoint.throttle == Approx(0.4));
+		REQUIRE(setpoint.angular_velocity_radians.Z == Approx(physics::math::degrees_to_radians(500.0)));
+	}
+
+	SECTION("Velocity mode accumulates its integral in the state")
+	{
+		physics::FFlightMode flight_mode = physics::FFlightModeVelocity();
+
+		physics::FFlightModeState flight_state;
+		flight_state.delta_time = 0.1;
+
+		const auto input = physics::FDronePlayerInput { 0.0, 0.0, -1.0, 0.0 };
+		physics::flight_mode::compute_setpoint(flight_mode, input, flight_state);
+
+		REQUIRE(std::get<physics::FFlightModeVelocity>(flight_mode).state.velocity_x_integral > 0.0);
+	}
+}
+
+TEST_CASE("Pilot input buffer", "[controller]")
+{
+	physics::FPilotInputBuffer buffer;
+	REQUIRE(buffer.sample(1.0).throttle == 0.0);
+
+	buffer.push(1.0, physics::FDronePlayerInput { 0.2, 0.0, -1.0, 0.0 });
+	buffer.push(1.1, physics::FDronePlayerInput { 0.6, 0.0, 1.0, 0.0 });
+
+	SECTION("Interpolates between samples and holds outside")
+	{
+		REQUIRE(buffer.sample(0.5).throttle == Approx(0.2));
+		REQUIRE(buffer.sample(1.025).throttle == Approx(0.3));
+		REQUIRE(buffer.sample(1.05).pitch == Approx(0.0).margin(1e-12));
+		REQUIRE(buffer.sample(2.0).throttle == Approx(0.6));
+	}
+
+	SECTION("Drops the oldest samples")
+	{
+		for (int i = 0; i < physics::FPilotInputBuffer::capacity; i++)
+		{
+			buffer.push(2.0 + i, physics::FDronePlayerInput { 1.0, 0.0, 0.0, 0.0 });
+		}
+
+		REQUIRE(buffer.count == physics::FPilotInputBuffer::capacity);
+		REQUIRE(buffer.samples[0].time_seconds == 2.0);
+	}
+
+	SECTION("Restarts when the clock goes back")
+	{
+		buffer.push(0.0, physics::FDronePlayerInput { 1.0, 0.0, 0.0, 0.0 });
+
+		REQUIRE(buffer.count == 1);
+		REQUIRE(buffer.sample(1.05).throttle == 1.0);
+	}
+}
+
+#endif
@@ -0,0 +1,164 @@
+#include "DroneSimulatorPhysics/Public/Controller/DroneController.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Private/Utils/Variant.h"
+
+#include <algorithm>
+
+namespace
+{
+	// Same as FMath::VInterpTo
+	physics::FVector3 vector_interp_to(const physics::FVector3& current, const physics::FVector3& target, double delta_time,
+		double interp_speed)
+	{
+		if (interp_speed <= 0.0)
+		{
+			return target;
+		}
+
+		const auto distance = target - current;
+		if (distance.size_squared() < 1e-4)
+		{
+			return target;
+		}
+
+		return current + distance * physics::math::clamp(delta_time * interp_speed, 0.0, 1.0);
+	}
+}
+
+physics::FRotorSetThrottle physics::controller::tick_pid_controller(const FPidDroneControllerConfig& config,
+	FPidDroneControllerState& state, double delta_time, const FDroneSetpoint& setpoint, const FVector3& current_angular_velocity,
+	const FMixerMatrix& mixer)
+{
+	// Unreal has yaw the opposite sign from Euler angles for yaw, and the same ones for pitch and roll
+
+	constexpr auto angular_velocity_clamp_deg = 360.0;
+	constexpr auto angular_velocity_clamp = math::degrees_to_radians(angular_velocity_clamp_deg);
+	const auto angular_velocity_error = (setpoint.angular_velocity_radians - current_angular_velocity).bound_to_cube(angular_velocity_clamp);
+
+	const auto derivative_angular_velocity_error = (angular_velocity_error - state.last_angular_velocity_error) / delta_time;
+	state.last_angular_velocity_error = vector_interp_to(state.last_angular_velocity_error, angular_velocity_error, delta_time, 500.0);
+
+	state.integrated_angular_velocity_error += angular_velocity_error * delta_time;
+
+	const FVector3 proportional_pid = FVector3(config.roll_pid.proportional, config.pitch_pid.proportional, config.yaw_pid.proportional);
+	const FVector3 derivative_pid = FVector3(config.roll_pid.derivative, config.pitch_pid.derivative, config.yaw_pid.derivative);
+	const FVector3 integral_pid = FVector3(config.roll_pid.integral, config.pitch_pid.integral, config.yaw_pid.integral);
+
+	// X is roll, Y is pitch and Z is yaw, in the same layout as the rows of the mixer
+	const auto delta_throttle_angular = -(angular_velocity_error * proportional_pid + derivative_angular_velocity_error * derivative_pid
+		+ state.integrated_angular_velocity_error * integral_pid);
+
+	return allocate_pid_throttle(config.min_throttle, config.min_dynamic_throttle, setpoint.throttle, delta_throttle_angular, mixer);
+}
+
+physics::FRotorSetThrottle physics::controller::allocate_pid_throttle(double min_throttle, double min_dynamic_throttle,
+	double setpoint_throttle, const FVector3& delta_throttle_angular, const FMixerMatrix& mixer)
+{
+	// The min throttle is applied as a clamp of the input
+	const auto global_throttle = math::clamp(setpoint_throttle, min_throttle, 1.0);
+
+	// Throttle values are absolute, in the 0..1 range
+
+	// The ideal throttle is the throttle we would want to apply if negative throttle was possible, and props could spin
+	// at very low speeds without consequences
+	const auto ideal_throttle = mixer::mix(mixer, global_throttle, delta_throttle_angular);
+
+	const auto clamp_to_dynamic_range = [min_dynamic_throttle](FRotorSetThrottle throttle)
+	{
+		for (std::int32_t rotor_index = 0; rotor_index < throttle.count; rotor_index++)
+		{
+			throttle.values[rotor_index] = math::clamp(throttle.values[rotor_index], min_dynamic_throttle, 1.0);
+		}
+		return throttle;
+	};
+
+	if (ideal_throttle.count == 0)
+	{
+		return ideal_throttle;
+	}
+
+	// If any axis of the throttle is below the min dynamic throttle, then we try to "fix" it
+	const auto ideal_throttle_min_axis = ideal_throttle.min();
+	if (ideal_throttle_min_axis < min_dynamic_throttle)
+	{
+		constexpr auto max_throttle_boost = 0.2f;
+		const auto desired_throttle_boost = min_dynamic_throttle - ideal_throttle_min_axis;
+
+		// Shift the base throttle up to bring the minimum prop to min_dynamic_throttle
+		const auto throttle_boost = std::min(desired_throttle_boost, static_cast<double>(max_throttle_boost));
+		const auto shifted_throttle = mixer::mix(mixer, global_throttle + throttle_boost, delta_throttle_angular);
+
+		// Clamp each prop individually to [min_dynamic_throttle, 1.0] - preserve differential, don't scale it
+		return clamp_to_dynamic_range(shifted_throttle);
+	}
+
+	// If any axis of the throttle is above 1.0, shift the base throttle down to fit.
+	// Unlike the lower bound handling, we do NOT scale the delta here - we want to preserve
+	// full differential authority for fast axis response (yaw especially).
+	const auto ideal_throttle_max_axis = ideal_throttle.max();
+	if (ideal_throttle_max_axis > 1.0)
+	{
+		// Shift base throttle down so the max prop reaches 1.0
+		const auto throttle_shrink = ideal_throttle_max_axis - 1.0;
+		const auto shifted_throttle = mixer::mix(mixer, global_throttle - throttle_shrink, delta_throttle_angular);
+
+		return clamp_to_dynamic_range(shifted_throttle);
+	}
+
+	// If the ideal throttle is in the range, no correction to make, it can be returned as-is
+	return ideal_throttle;
+}
+
+physics::FPropellerSetThrottle physics::controller::tick_pid_controller(const FPidDroneControllerConfig& config,
+	FPidDroneControllerState& state, double delta_time, const FDroneSetpoint& setpoint, const FVector3& current_angular_velocity)
+{
+	static const auto quad_x_mixer = mixer::make_quad_x();
+	return tick_pid_controller(config, state, delta_time, setpoint, current_angular_velocity, quad_x_mixer).to_propeller_set();
+}
+
+physics::FRotorSetThrottle physics::controller::tick_basic_controller(const FBasicDroneController& controller,
+	const FDroneSetpoint& setpoint, const FMixerMatrix& mixer)
+{
+	const auto global_throttle = math::clamp(0.1 + 0.8 * setpoint.throttle, 0.0, 1.0);
+	const auto roll_throttle = setpoint.angular_velocity_radians.X * -controller.roll_throttle_rate;
+	const auto pitch_throttle = setpoint.angular_velocity_radians.Y * -controller.pitch_throttle_rate;
+	const auto yaw_throttle = setpoint.angular_velocity_radians.Z * -controller.yaw_throttle_rate;
+
+	auto throttle = mixer::mix(mixer, global_throttle, FVector3(roll_throttle, pitch_throttle, yaw_throttle));
+
+	const double throttle_min = throttle.count > 0 ? throttle.min() : 0.0;
+	for (std::int32_t rotor_index = 0; rotor_index < throttle.count; rotor_index++)
+	{
+		if (throttle_min < 0.0)
+		{
+			throttle.values[rotor_index] -= throttle_min;
+		}
+		throttle.values[rotor_index] *= controller.global_throttle_rate;
+	}
+
+	return throttle;
+}
+
+physics::FPropellerSetThrottle physics::controller::tick_basic_controller(const FBasicDroneController& controller,
+	const FDroneSetpoint& setpoint)
+{
+	static const auto quad_x_mixer = mixer::make_quad_x();
+	return tick_basic_controller(controller, setpoint, quad_x_mixer).to_propeller_set();
+}
+
+physics::FRotorSetThrottle physics::controller::tick_controller(FDroneController& controller, double delta_time,
+	const FDroneSetpoint& setpoint, const FVector3& current_angular_velocity, const FMixerMatrix& mixer)
+{
+	return match_variant(
+		controller,
+		[&](FPidDroneController& pid_controller)
+		{
+			return tick_pid_controller(pid_controller.config, pid_controller.state, delta_time, setpoint, current_angular_velocity,
+				mixer);
+		},
+		[&](const FBasicDroneController& basic_controller)
+		{
+			return tick_basic_controller(basic_controller, setpoint, mixer);
+		}
+	);
+}
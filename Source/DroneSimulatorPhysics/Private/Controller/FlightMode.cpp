@@ -0,0 +1,149 @@
+#include "DroneSimulatorPhysics/Public/Controller/FlightMode.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Private/Utils/Variant.h"
+
+#include <cmath>
+
+physics::FDroneSetpoint physics::flight_mode::compute_air_setpoint(const FFlightModeAir& flight_mode,
+	const FDronePlayerInput& player_input)
+{
+	const auto desired_angular_velocity = FVector3(
+		player_input.roll * -math::degrees_to_radians(flight_mode.roll_rate_deg_per_second), // Roll stick right = Input.Roll >0 = drone rotates clockwise = rotator roll >0
+		player_input.pitch * -math::degrees_to_radians(flight_mode.pitch_rate_deg_per_second), // Pitch stick up = Input.Pitch >0 = look down = rotator pitch <0
+		player_input.yaw * math::degrees_to_radians(flight_mode.yaw_rate_deg_per_second) // Yaw stick right = Input.Yaw >0 = look right = rotator yaw >0
+	);
+
+	return FDroneSetpoint { player_input.throttle, desired_angular_velocity };
+}
+
+physics::FDroneSetpoint physics::flight_mode::compute_angle_setpoint(const FFlightModeAngle& flight_mode,
+	const FDronePlayerInput& player_input, const FFlightModeState& flight_state)
+{
+	// Player input to target angles
+	const double target_roll_deg = player_input.roll * flight_mode.max_roll_angle_deg;
+	const double target_pitch_deg = player_input.pitch * flight_mode.max_pitch_angle_deg;
+
+	const double current_roll_deg = flight_state.rotation.Roll;
+	const double current_pitch_deg = flight_state.rotation.Pitch;
+
+	const double roll_error_deg = target_roll_deg - current_roll_deg;
+	const double pitch_error_deg = target_pitch_deg - current_pitch_deg;
+
+	// P controller: angle error -> angular velocity setpoint
+	const double desired_roll_rate_deg_s = roll_error_deg * flight_mode.angle_roll_p;
+	const double desired_pitch_rate_deg_s = pitch_error_deg * flight_mode.angle_pitch_p;
+
+	const FVector3 desired_angular_velocity = FVector3(
+		-math::degrees_to_radians(desired_roll_rate_deg_s),  // Negative because of Unreal's coordinate system
+		-math::degrees_to_radians(desired_pitch_rate_deg_s), // Negative because of Unreal's coordinate system
+		math::degrees_to_radians(player_input.yaw * flight_mode.yaw_rate_deg_per_second) // Yaw is still rate-controlled
+	);
+
+	return FDroneSetpoint { player_input.throttle, desired_angular_velocity };
+}
+
+physics::FDroneSetpoint physics::flight_mode::compute_velocity_setpoint(const FFlightModeVelocityConfig& config,
+	FFlightModeVelocityState& state, const FDronePlayerInput& player_input, const FFlightModeState& flight_state)
+{
+	// Player Input -> Target Velocity (in world frame)
+
+	const double current_yaw_rad = math::degrees_to_radians(flight_state.rotation.Yaw);
+	const double cos_yaw = std::cos(current_yaw_rad);
+	const double sin_yaw = std::sin(current_yaw_rad);
+
+	// Player input: X = forward/back, Y = left/right, rotated by the drone's yaw to get world frame velocities
+	const double input_x = -player_input.pitch;
+	const double input_y = player_input.roll;
+	const double target_velocity_x = (cos_yaw * input_x - sin_yaw * input_y) * config.max_horizontal_velocity_m_s;
+	const double target_velocity_y = (sin_yaw * input_x + cos_yaw * input_y) * config.max_horizontal_velocity_m_s;
+
+	// Velocity Error -> Target Angle (via PI controller)
+
+	const double velocity_error_x = target_velocity_x - flight_state.linear_velocity_world.X;
+	const double velocity_error_y = target_velocity_y - flight_state.linear_velocity_world.Y;
+
+	const double dt = flight_state.delta_time;
+	if (dt > 0.0)
+	{
+		state.velocity_x_integral += velocity_error_x * dt;
+		state.velocity_y_integral += velocity_error_y * dt;
+
+		// Anti-windup: clamp integral to prevent excessive buildup
+		const double velocity_integral_max = config.velocity_i_max_deg / config.velocity_i;
+		state.velocity_x_integral = math::clamp(state.velocity_x_integral, -velocity_integral_max, velocity_integral_max);
+		state.velocity_y_integral = math::clamp(state.velocity_y_integral, -velocity_integral_max, velocity_integral_max);
+	}
+
+	const double target_angle_x_deg = -(config.velocity_p * velocity_error_x) - (config.velocity_i * state.velocity_x_integral);
+	const double target_angle_y_deg = (config.velocity_p * velocity_error_y) + (config.velocity_i * state.velocity_y_integral);
+
+	const double clamped_angle_x_deg = math::clamp(target_angle_x_deg, -config.max_tilt_angle_deg, config.max_tilt_angle_deg);
+	const double clamped_angle_y_deg = math::clamp(target_angle_y_deg, -config.max_tilt_angle_deg, config.max_tilt_angle_deg);
+
+	// World frame angles to body frame (roll/pitch)
+	const double target_pitch_deg = (clamped_angle_x_deg * cos_yaw) - (clamped_angle_y_deg * sin_yaw);
+	const double target_roll_deg = (clamped_angle_x_deg * sin_yaw) + (clamped_angle_y_deg * cos_yaw);
+
+	// Angle Error -> Angular Velocity (via P controller)
+
+	const double roll_error_deg = target_roll_deg - flight_state.rotation.Roll;
+	const double pitch_error_deg = target_pitch_deg - flight_state.rotation.Pitch;
+
+	const double desired_roll_rate_deg_s = roll_error_deg * config.angle_roll_p;
+	const double desired_pitch_rate_deg_s = pitch_error_deg * config.angle_pitch_p;
+
+	const FVector3 desired_angular_velocity = FVector3(
+		-math::degrees_to_radians(desired_roll_rate_deg_s),  // Negative because of Unreal's coordinate system
+		-math::degrees_to_radians(desired_pitch_rate_deg_s), // Negative because of Unreal's coordinate system
+		math::degrees_to_radians(player_input.yaw * config.yaw_rate_deg_per_second) // Yaw is still rate-controlled
+	);
+
+	// Vertical Velocity Control (Throttle stick -> Vertical velocity -> Throttle)
+
+	const double target_vertical_velocity = player_input.throttle * config.max_vertical_velocity_m_s;
+	const double vertical_velocity_error = target_vertical_velocity - flight_state.linear_velocity_world.Z;
+
+	if (dt > 0.0)
+	{
+		state.vertical_velocity_integral += vertical_velocity_error * dt;
+		state.vertical_velocity_integral = math::clamp(state.vertical_velocity_integral,
+			-config.vertical_velocity_i_max / config.vertical_velocity_i,
+			config.vertical_velocity_i_max / config.vertical_velocity_i);
+	}
+
+	double vertical_velocity_derivative = 0.0;
+	if (dt > 0.0)
+	{
+		vertical_velocity_derivative = (vertical_velocity_error - state.prev_vertical_velocity_error) / dt;
+	}
+	state.prev_vertical_velocity_error = vertical_velocity_error;
+
+	const double throttle_adjustment =
+		(config.vertical_velocity_p * vertical_velocity_error) +
+		(config.vertical_velocity_i * state.vertical_velocity_integral) +
+		(config.vertical_velocity_d * vertical_velocity_derivative);
+
+	const double final_throttle = math::clamp(throttle_adjustment, 0.0, 1.0);
+
+	return FDroneSetpoint { final_throttle, desired_angular_velocity };
+}
+
+physics::FDroneSetpoint physics::flight_mode::compute_setpoint(FFlightMode& flight_mode, const FDronePlayerInput& player_input,
+	const FFlightModeState& flight_state)
+{
+	return match_variant(
+		flight_mode,
+		[&](const FFlightModeAir& flight_mode_air)
+		{
+			return compute_air_setpoint(flight_mode_air, player_input);
+		},
+		[&](const FFlightModeAngle& flight_mode_angle)
+		{
+			return compute_angle_setpoint(flight_mode_angle, player_input, flight_state);
+		},
+		[&](FFlightModeVelocity& flight_mode_velocity)
+		{
+			return compute_velocity_setpoint(flight_mode_velocity.config, flight_mode_velocity.state, player_input, flight_state);
+		}
+	);
+}
@@ -0,0 +1,303 @@
+#include "DroneSimulatorPhysics/Public/Controller/GyroFilter.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace
+{
+	// Second order filters are bypassed closer to the Nyquist frequency, their coefficients degenerate there
+	constexpr double max_center_sample_rate_ratio = 0.45;
+
+	constexpr double butterworth_q = 0.70710678118654752;
+
+	// Drones filtered through all the stages at once by the bank
+	constexpr std::int32_t gyro_filter_tile_size = 64;
+
+	physics::FBiquadCoefficients make_lowpass(const physics::FGyroFilterConfig& config, double sample_rate_hz)
+	{
+		if (config.lowpass_cutoff_hz <= 0.0)
+		{
+			return physics::FBiquadCoefficients();
+		}
+
+		return config.lowpass_type == physics::EGyroLowpassType::pt1
+			? physics::gyro_filter::make_pt1_lowpass(config.lowpass_cutoff_hz, sample_rate_hz)
+			: physics::gyro_filter::make_biquad_lowpass(config.lowpass_cutoff_hz, sample_rate_hz);
+	}
+
+	/**
+	 * One stage of the bank on one axis of a tile of drones, vectorized over the drones. Inactive drones keep their
+	 * state: the select is done on the bits, so that the loop has no branch.
+	 */
+	void filter_tile(std::int32_t tile_size, double* __restrict signal, const std::uint64_t* __restrict active_mask,
+		const double* __restrict b0, const double* __restrict b1, const double* __restrict b2, const double* __restrict a1,
+		const double* __restrict a2, double* __restrict z1, double* __restrict z2)
+	{
+		for (std::int32_t index = 0; index < tile_size; index++)
+		{
+			const auto input = signal[index];
+			const auto last_z1 = z1[index];
+			const auto last_z2 = z2[index];
+			const auto filtered = input * b0[index] + last_z1;
+			const auto next_z1 = input * b1[index] - filtered * a1[index] + last_z2;
+			const auto next_z2 = input * b2[index] - filtered * a2[index];
+
+			const auto mask = active_mask[index];
+			z1[index] = std::bit_cast<double>((std::bit_cast<std::uint64_t>(next_z1) & mask) | (std::bit_cast<std::uint64_t>(last_z1) & ~mask));
+			z2[index] = std::bit_cast<double>((std::bit_cast<std::uint64_t>(next_z2) & mask) | (std::bit_cast<std::uint64_t>(last_z2) & ~mask));
+			signal[index] = filtered;
+		}
+	}
+
+	// Audio EQ cookbook (R. Bristow-Johnson) denominator, shared by the lowpass and the notch
+	struct FSecondOrderTerms
+	{
+		double cos_w0;
+		double alpha;
+	};
+
+	FSecondOrderTerms get_second_order_terms(double center_hz, double q, double sample_rate_hz)
+	{
+		const auto w0 = physics::math::two_pi * center_hz / sample_rate_hz;
+		return FSecondOrderTerms { std::cos(w0), std::sin(w0) / (2.0 * q) };
+	}
+}
+
+void physics::FGyroFilterBank::resize(std::int32_t size, std::int32_t in_stage_count)
+{
+	this->stage_count = in_stage_count;
+
+	const auto column_size = static_cast<std::size_t>(size) * in_stage_count;
+	this->b0.assign(column_size, 1.0);
+	this->b1.assign(column_size, 0.0);
+	this->b2.assign(column_size, 0.0);
+	this->a1.assign(column_size, 0.0);
+	this->a2.assign(column_size, 0.0);
+	for (std::int32_t axis = 0; axis < 3; axis++)
+	{
+		this->z1[axis].assign(column_size, 0.0);
+		this->z2[axis].assign(column_size, 0.0);
+	}
+
+	this->input.resize(size);
+	this->output.resize(size);
+	this->is_active.assign(size, 0);
+}
+
+void physics::FGyroFilterBank::set_filter(std::int32_t index, const FGyroFilterState& state)
+{
+	this->set_coefficients(index, state);
+
+	for (std::int32_t stage = 0; stage < this->stage_count; stage++)
+	{
+		const auto column_index = stage * this->size() + index;
+		const auto stage_state = stage < state.stage_count ? state.stages[stage] : FBiquadState();
+		this->z1[0][column_index] = stage_state.z1.X;
+		this->z1[1][column_index] = stage_state.z1.Y;
+		this->z1[2][column_index] = stage_state.z1.Z;
+		this->z2[0][column_index] = stage_state.z2.X;
+		this->z2[1][column_index] = stage_state.z2.Y;
+		this->z2[2][column_index] = stage_state.z2.Z;
+	}
+}
+
+void physics::FGyroFilterBank::set_coefficients(std::int32_t index, const FGyroFilterState& state)
+{
+	for (std::int32_t stage = 0; stage < this->stage_count; stage++)
+	{
+		const auto column_index = stage * this->size() + index;
+		const auto coefficients = stage < state.stage_count ? state.coefficients[stage] : FBiquadCoefficients();
+		this->b0[column_index] = coefficients.b0;
+		this->b1[column_index] = coefficients.b1;
+		this->b2[column_index] = coefficients.b2;
+		this->a1[column_index] = coefficients.a1;
+		this->a2[column_index] = coefficients.a2;
+	}
+}
+
+void physics::FGyroFilterBank::get_state(std::int32_t index, FGyroFilterState& out_state) const
+{
+	for (std::int32_t stage = 0; stage < std::min(this->stage_count, out_state.stage_count); stage++)
+	{
+		const auto column_index = stage * this->size() + index;
+		auto& stage_state = out_state.stages[stage];
+		stage_state.z1 = FVector3(this->z1[0][column_index], this->z1[1][column_index], this->z1[2][column_index]);
+		stage_state.z2 = FVector3(this->z2[0][column_index], this->z2[1][column_index], this->z2[2][column_index]);
+	}
+}
+
+physics::FBiquadCoefficients physics::gyro_filter::make_pt1_lowpass(double cutoff_hz, double sample_rate_hz)
+{
+	// y += k * (x - y), the same as Betaflight's pt1FilterGain
+	const auto delta_time = 1.0 / sample_rate_hz;
+	const auto time_constant = 1.0 / (math::two_pi * cutoff_hz);
+	const auto gain = delta_time / (time_constant + delta_time);
+
+	FBiquadCoefficients coefficients;
+	coefficients.b0 = gain;
+	coefficients.a1 = gain - 1.0;
+	return coefficients;
+}
+
+physics::FBiquadCoefficients physics::gyro_filter::make_biquad_lowpass(double cutoff_hz, double sample_rate_hz)
+{
+	if (cutoff_hz >= max_center_sample_rate_ratio * sample_rate_hz)
+	{
+		return FBiquadCoefficients();
+	}
+
+	const auto [cos_w0, alpha] = get_second_order_terms(cutoff_hz, butterworth_q, sample_rate_hz);
+	const auto a0 = 1.0 + alpha;
+
+	FBiquadCoefficients coefficients;
+	coefficients.b0 = (1.0 - cos_w0) * 0.5 / a0;
+	coefficients.b1 = (1.0 - cos_w0) / a0;
+	coefficients.b2 = coefficients.b0;
+	coefficients.a1 = -2.0 * cos_w0 / a0;
+	coefficients.a2 = (1.0 - alpha) / a0;
+	return coefficients;
+}
+
+physics::FBiquadCoefficients physics::gyro_filter::make_notch(double center_hz, double q, double sample_rate_hz)
+{
+	if (center_hz <= 0.0 || center_hz >= max_center_sample_rate_ratio * sample_rate_hz)
+	{
+		return FBiquadCoefficients();
+	}
+
+	const auto [cos_w0, alpha] = get_second_order_terms(center_hz, q, sample_rate_hz);
+	const auto a0 = 1.0 + alpha;
+
+	FBiquadCoefficients coefficients;
+	coefficients.b0 = 1.0 / a0;
+	coefficients.b1 = -2.0 * cos_w0 / a0;
+	coefficients.b2 = coefficients.b0;
+	coefficients.a1 = coefficients.b1;
+	coefficients.a2 = (1.0 - alpha) / a0;
+	return coefficients;
+}
+
+std::int32_t physics::gyro_filter::get_stage_count(const FGyroFilterConfig& config, std::int32_t rotor_count)
+{
+	if (!config.is_enabled)
+	{
+		return 0;
+	}
+
+	return 1 + std::clamp(rotor_count, 0, max_rotor_count) * std::clamp(config.rpm_harmonic_count, 0, max_rpm_harmonic_count);
+}
+
+bool physics::gyro_filter::retune(FGyroFilter& filter, const FRotorSetThrottle& rotor_throttle, double max_rotor_speed,
+	double sample_rate_hz)
+{
+	const auto& config = filter.config;
+	auto& state = filter.state;
+
+	const auto stage_count = get_stage_count(config, rotor_throttle.count);
+	bool is_changed = false;
+
+	// New layout or new rate: every stage is computed again
+	if (stage_count != state.stage_count || sample_rate_hz != state.sample_rate_hz)
+	{
+		state.stage_count = stage_count;
+		state.sample_rate_hz = sample_rate_hz;
+		state.coefficients.fill(FBiquadCoefficients());
+		state.notch_center_hz.fill(0.0);
+		if (stage_count > 0)
+		{
+			state.coefficients[0] = make_lowpass(config, sample_rate_hz);
+		}
+		is_changed = true;
+	}
+
+	if (stage_count == 0)
+	{
+		return is_changed;
+	}
+
+	const auto harmonic_count = (stage_count - 1) / std::max(rotor_throttle.count, 1);
+	for (std::int32_t rotor_index = 0; rotor_index < rotor_throttle.count; rotor_index++)
+	{
+		const auto rotor_frequency_hz = rotor_throttle.values[rotor_index] * max_rotor_speed / math::two_pi;
+
+		for (std::int32_t harmonic = 0; harmonic < harmonic_count; harmonic++)
+		{
+			const auto stage = 1 + rotor_index * harmonic_count + harmonic;
+			const auto frequency_hz = rotor_frequency_hz * (harmonic + 1);
+			const auto is_bypassed = frequency_hz < config.rpm_notch_min_hz || frequency_hz >= max_center_sample_rate_ratio * sample_rate_hz;
+			const auto center_hz = is_bypassed ? 0.0 : frequency_hz;
+
+			auto& tuned_center_hz = state.notch_center_hz[stage];
+			const auto is_crossing = (center_hz == 0.0) != (tuned_center_hz == 0.0);
+			if (!is_crossing && std::abs(center_hz - tuned_center_hz) <= config.notch_retune_threshold_hz)
+			{
+				continue;
+			}
+
+			tuned_center_hz = center_hz;
+			state.coefficients[stage] = is_bypassed ? FBiquadCoefficients() : make_notch(center_hz, config.rpm_notch_q, sample_rate_hz);
+			is_changed = true;
+		}
+	}
+
+	return is_changed;
+}
+
+const physics::FVector3& physics::gyro_filter::apply(FGyroFilter& filter, const FVector3& angular_velocity)
+{
+	auto& state = filter.state;
+
+	auto signal = angular_velocity;
+	for (std::int32_t stage = 0; stage < state.stage_count; stage++)
+	{
+		const auto& coefficients = state.coefficients[stage];
+		auto& stage_state = state.stages[stage];
+
+		const auto filtered = signal * coefficients.b0 + stage_state.z1;
+		stage_state.z1 = signal * coefficients.b1 - filtered * coefficients.a1 + stage_state.z2;
+		stage_state.z2 = signal * coefficients.b2 - filtered * coefficients.a2;
+		signal = filtered;
+	}
+
+	state.output = signal;
+	state.has_output = true;
+	return state.output;
+}
+
+void physics::gyro_filter::apply_bank(FGyroFilterBank& bank)
+{
+	const auto count = bank.size();
+
+	// Same operations as apply, in the same order. Each stage depends on the last, so the drones are the lanes: the
+	// drones of a tile go through all the stages with their signal kept in the cache.
+	for (std::int32_t tile_start = 0; tile_start < count; tile_start += gyro_filter_tile_size)
+	{
+		const auto tile_size = std::min(gyro_filter_tile_size, count - tile_start);
+
+		std::uint64_t active_mask[gyro_filter_tile_size];
+		for (std::int32_t index = 0; index < tile_size; index++)
+		{
+			active_mask[index] = bank.is_active[tile_start + index] != 0 ? ~std::uint64_t(0) : 0;
+		}
+
+		const std::array<const std::vector<double>*, 3> inputs = { &bank.input.x, &bank.input.y, &bank.input.z };
+		const std::array<std::vector<double>*, 3> outputs = { &bank.output.x, &bank.output.y, &bank.output.z };
+
+		for (std::int32_t axis = 0; axis < 3; axis++)
+		{
+			double signal[gyro_filter_tile_size];
+			std::copy_n(inputs[axis]->data() + tile_start, tile_size, signal);
+
+			for (std::int32_t stage = 0; stage < bank.stage_count; stage++)
+			{
+				const auto offset = static_cast<std::size_t>(stage) * count + tile_start;
+				filter_tile(tile_size, signal, active_mask, bank.b0.data() + offset, bank.b1.data() + offset, bank.b2.data() + offset,
+					bank.a1.data() + offset, bank.a2.data() + offset, bank.z1[axis].data() + offset, bank.z2[axis].data() + offset);
+			}
+
+			std::copy_n(signal, tile_size, outputs[axis]->data() + tile_start);
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#if WITH_DRONE_PHYSICS_BENCHMARKS
+
+#include "DroneSimulatorPhysics/Public/Controller/GyroFilter.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+	// Quad with a lowpass and 3 harmonics per rotor: 13 cascaded biquads per axis
+	std::vector<physics::FGyroFilter> make_benchmark_filters(std::int32_t drone_count)
+	{
+		std::vector<physics::FGyroFilter> filters(drone_count);
+		for (std::int32_t index = 0; index < drone_count; index++)
+		{
+			physics::FRotorSetThrottle rotor_throttle;
+			rotor_throttle.count = 4;
+			std::fill_n(rotor_throttle.values.begin(), 4, 0.4 + 0.0001 * index);
+
+			filters[index].config.is_enabled = true;
+			filters[index].config.lowpass_type = physics::EGyroLowpassType::biquad;
+			physics::gyro_filter::retune(filters[index], rotor_throttle, 3000.0, 8000.0);
+		}
+		return filters;
+	}
+}
+
+// One gyro sample of every drone of a swarm, filtered one drone at a time. The argument is the number of drones.
+static void BM_GyroFilterScalar(benchmark::State& state)
+{
+	auto filters = make_benchmark_filters(static_cast<std::int32_t>(state.range(0)));
+	std::int32_t sample = 0;
+
+	for (auto _ : state)
+	{
+		const auto gyro = physics::FVector3(std::sin(sample * 0.1), 0.2, -0.3);
+		for (auto& filter : filters)
+		{
+			benchmark::DoNotOptimize(physics::gyro_filter::apply(filter, gyro));
+		}
+		sample++;
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GyroFilterScalar)->Arg(64)->Arg(1024);
+
+// Same, in the bank: each stage is one loop over the drones
+static void BM_GyroFilterBank(benchmark::State& state)
+{
+	const auto drone_count = static_cast<std::int32_t>(state.range(0));
+	const auto filters = make_benchmark_filters(drone_count);
+
+	physics::FGyroFilterBank bank;
+	bank.resize(drone_count, filters[0].state.stage_count);
+	for (std::int32_t index = 0; index < drone_count; index++)
+	{
+		bank.set_filter(index, filters[index].state);
+		bank.is_active[index] = 1;
+	}
+
+	std::int32_t sample = 0;
+	for (auto _ : state)
+	{
+		const auto gyro = physics::FVector3(std::sin(sample * 0.1), 0.2, -0.3);
+		for (std::int32_t index = 0; index < drone_count; index++)
+		{
+			bank.input.set(index, gyro);
+		}
+
+		physics::gyro_filter::apply_bank(bank);
+		benchmark::DoNotOptimize(bank.output.x.data());
+		sample++;
+	}
+
+	state.SetItemsProcessed(state.iterations() * drone_count);
+}
+BENCHMARK(BM_GyroFilterBank)->Arg(64)->Arg(1024);
+
+#endif
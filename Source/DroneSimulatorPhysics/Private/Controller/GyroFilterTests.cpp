@@ -0,0 +1,169 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Public/Controller/GyroFilter.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	constexpr double sample_rate_hz = 8000.0;
+
+	// 1 rad/s on X at frequency_hz, 0.5 rad/s constant on Y. Returns the largest X output after the filter settled.
+	double get_sine_amplitude(physics::FGyroFilter& filter, double frequency_hz)
+	{
+		double amplitude = 0.0;
+		for (std::int32_t index = 0; index < 8000; index++)
+		{
+			const auto time = index / sample_rate_hz;
+			const auto& output = physics::gyro_filter::apply(filter, physics::FVector3(std::sin(physics::math::two_pi * frequency_hz * time), 0.5, 0.0));
+			if (index >= 4000)
+			{
+				amplitude = std::max(amplitude, std::abs(output.X));
+				REQUIRE(output.Y == Approx(0.5).epsilon(1e-6));
+			}
+		}
+		return amplitude;
+	}
+
+	physics::FRotorSetThrottle make_throttle(double throttle)
+	{
+		physics::FRotorSetThrottle rotor_throttle;
+		rotor_throttle.count = 4;
+		std::fill_n(rotor_throttle.values.begin(), 4, throttle);
+		return rotor_throttle;
+	}
+
+	// 300 Hz rotors at half throttle
+	constexpr double max_rotor_speed = 600.0 * physics::math::two_pi;
+}
+
+TEST_CASE("Gyro filter", "[controller]")
+{
+	physics::FGyroFilter filter;
+	filter.config.is_enabled = true;
+
+	SECTION("The lowpass passes the rate and cuts the noise")
+	{
+		filter.config.rpm_harmonic_count = 0;
+
+		for (const auto lowpass_type : { physics::EGyroLowpassType::pt1, physics::EGyroLowpassType::biquad })
+		{
+			filter.config.lowpass_type = lowpass_type;
+			filter.state = physics::FGyroFilterState();
+			physics::gyro_filter::retune(filter, make_throttle(0.5), max_rotor_speed, sample_rate_hz);
+			REQUIRE(filter.state.stage_count == 1);
+
+			CHECK(get_sine_amplitude(filter, 10.0) > 0.95);
+			CHECK(get_sine_amplitude(filter, 1500.0) < 0.15);
+		}
+	}
+
+	SECTION("The RPM filter removes the rotor harmonics")
+	{
+		filter.config.lowpass_cutoff_hz = 0.0;
+		physics::gyro_filter::retune(filter, make_throttle(0.5), max_rotor_speed, sample_rate_hz);
+		REQUIRE(filter.state.stage_count == 1 + 4 * 3);
+		REQUIRE(filter.state.notch_center_hz[1] == Approx(300.0));
+		REQUIRE(filter.state.notch_center_hz[3] == Approx(900.0));
+
+		CHECK(get_sine_amplitude(filter, 300.0) < 0.01);
+		CHECK(get_sine_amplitude(filter, 600.0) < 0.01);
+		CHECK(get_sine_amplitude(filter, 30.0) > 0.95);
+	}
+
+	SECTION("Notches are only retuned past the threshold")
+	{
+		REQUIRE(physics::gyro_filter::retune(filter, make_throttle(0.5), max_rotor_speed, sample_rate_hz));
+		const auto tuned_coefficients = filter.state.coefficients[1];
+
+		// 0.6 Hz on the first harmonic, 1.8 Hz on the third
+		REQUIRE_FALSE(physics::gyro_filter::retune(filter, make_throttle(0.501), max_rotor_speed, sample_rate_hz));
+		REQUIRE(filter.state.coefficients[1].b1 == tuned_coefficients.b1);
+
+		REQUIRE(physics::gyro_filter::retune(filter, make_throttle(0.51), max_rotor_speed, sample_rate_hz));
+		REQUIRE(filter.state.coefficients[1].b1 != tuned_coefficients.b1);
+
+		// Idle rotors are under the minimum frequency
+		REQUIRE(physics::gyro_filter::retune(filter, make_throttle(0.05), max_rotor_speed, sample_rate_hz));
+		REQUIRE(filter.state.notch_center_hz[1] == 0.0);
+		REQUIRE(filter.state.coefficients[1].b0 == 1.0);
+	}
+
+	SECTION("A disabled filter passes the gyro through")
+	{
+		filter.config.is_enabled = false;
+		physics::gyro_filter::retune(filter, make_throttle(0.5), max_rotor_speed, sample_rate_hz);
+
+		REQUIRE(filter.state.stage_count == 0);
+		REQUIRE(physics::gyro_filter::apply(filter, physics::FVector3(1.0, 2.0, 3.0)) == physics::FVector3(1.0, 2.0, 3.0));
+		REQUIRE(filter.state.has_output);
+	}
+}
+
+TEST_CASE("Gyro filter bank", "[controller]")
+{
+	constexpr std::int32_t drone_count = 13;
+
+	std::vector<physics::FGyroFilter> filters(drone_count);
+	for (std::int32_t index = 0; index < drone_count; index++)
+	{
+		auto& filter = filters[index];
+		filter.config.is_enabled = index != 4;
+		filter.config.lowpass_type = index % 2 == 0 ? physics::EGyroLowpassType::pt1 : physics::EGyroLowpassType::biquad;
+		filter.config.rpm_harmonic_count = index % 4;
+		physics::gyro_filter::retune(filter, make_throttle(0.3 + 0.03 * index), max_rotor_speed, sample_rate_hz);
+	}
+
+	auto batched_filters = filters;
+	physics::FGyroFilterBank bank;
+	bank.resize(drone_count, physics::gyro_filter::get_stage_count(filters[3].config, 4));
+	for (std::int32_t index = 0; index < drone_count; index++)
+	{
+		bank.set_filter(index, batched_filters[index].state);
+	}
+
+	for (std::int32_t sample = 0; sample < 200; sample++)
+	{
+		for (std::int32_t index = 0; index < drone_count; index++)
+		{
+			const auto gyro = physics::FVector3(std::sin(sample * 0.3 + index), std::cos(sample * 0.7), 0.1 * index);
+
+			// Every third drone skips a sample now and then
+			const auto is_active = (sample + index) % 7 != 0 || index % 3 != 0;
+			bank.is_active[index] = is_active ? 1 : 0;
+			bank.input.set(index, gyro);
+			if (is_active)
+			{
+				physics::gyro_filter::apply(filters[index], gyro);
+			}
+		}
+
+		physics::gyro_filter::apply_bank(bank);
+
+		for (std::int32_t index = 0; index < drone_count; index++)
+		{
+			if (bank.is_active[index] != 0)
+			{
+				CAPTURE(sample, index);
+				REQUIRE(bank.output.get(index) == filters[index].state.output);
+			}
+		}
+	}
+
+	for (std::int32_t index = 0; index < drone_count; index++)
+	{
+		bank.get_state(index, batched_filters[index].state);
+		for (std::int32_t stage = 0; stage < filters[index].state.stage_count; stage++)
+		{
+			REQUIRE(batched_filters[index].state.stages[stage].z1 == filters[index].state.stages[stage].z1);
+			REQUIRE(batched_filters[index].state.stages[stage].z2 == filters[index].state.stages[stage].z2);
+		}
+	}
+}
+
+#endif
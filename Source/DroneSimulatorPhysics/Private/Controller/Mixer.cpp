@@ -0,0 +1,94 @@
+#include "DroneSimulatorPhysics/Public/Controller/Mixer.h"
+
+#include <algorithm>
+#include <cmath>
+
+double physics::FRotorSetThrottle::min() const
+{
+	if (this->count <= 0)
+	{
+		return 0.0;
+	}
+
+	return *std::min_element(this->values.begin(), this->values.begin() + this->count);
+}
+
+double physics::FRotorSetThrottle::max() const
+{
+	if (this->count <= 0)
+	{
+		return 0.0;
+	}
+
+	return *std::max_element(this->values.begin(), this->values.begin() + this->count);
+}
+
+physics::FPropellerSetThrottle physics::FRotorSetThrottle::to_propeller_set() const
+{
+	return FPropellerSetThrottle(this->values[0], this->values[1], this->values[2], this->values[3]);
+}
+
+physics::FRotorSetThrottle physics::FRotorSetThrottle::from_propeller_set(const FPropellerSetThrottle& throttle)
+{
+	FRotorSetThrottle result;
+	result.values = { throttle.front_left, throttle.front_right, throttle.rear_left, throttle.rear_right };
+	result.count = 4;
+	return result;
+}
+
+physics::FMixerMatrix physics::mixer::make_quad_x()
+{
+	FMixerMatrix mixer;
+	mixer.axis_factors[0] = FVector3(1.0, 1.0, 1.0);
+	mixer.axis_factors[1] = FVector3(-1.0, 1.0, -1.0);
+	mixer.axis_factors[2] = FVector3(1.0, -1.0, -1.0);
+	mixer.axis_factors[3] = FVector3(-1.0, -1.0, 1.0);
+	mixer.count = 4;
+	return mixer;
+}
+
+physics::FMixerMatrix physics::mixer::compile(const std::vector<FRotorDescription>& rotors)
+{
+	FMixerMatrix mixer;
+	mixer.count = std::min(static_cast<std::int32_t>(rotors.size()), max_rotor_count);
+
+	double max_offset_x = 0.0;
+	double max_offset_y = 0.0;
+	for (std::int32_t rotor_index = 0; rotor_index < mixer.count; rotor_index++)
+	{
+		max_offset_x = std::max(max_offset_x, std::abs(rotors[rotor_index].location.X));
+		max_offset_y = std::max(max_offset_y, std::abs(rotors[rotor_index].location.Y));
+	}
+
+	for (std::int32_t rotor_index = 0; rotor_index < mixer.count; rotor_index++)
+	{
+		const auto& rotor = rotors[rotor_index];
+
+		// Rotors on the left (-Y) roll right when sped up, rotors at the front (+X) pitch up
+		const auto roll_factor = max_offset_y > 0.0 ? -rotor.location.Y / max_offset_y : 0.0;
+		const auto pitch_factor = max_offset_x > 0.0 ? rotor.location.X / max_offset_x : 0.0;
+		const auto yaw_factor = rotor.is_clockwise ? 1.0 : -1.0;
+
+		mixer.axis_factors[rotor_index] = FVector3(roll_factor, pitch_factor, yaw_factor);
+	}
+
+	return mixer;
+}
+
+physics::FMixerMatrix physics::mixer::compile_for_frame(const FDroneFrame& frame)
+{
+	return frame.rotors.empty() ? make_quad_x() : compile(frame.rotors);
+}
+
+physics::FRotorSetThrottle physics::mixer::mix(const FMixerMatrix& mixer, double collective, const FVector3& axis_command)
+{
+	FRotorSetThrottle throttle;
+	throttle.count = mixer.count;
+
+	for (std::int32_t rotor_index = 0; rotor_index < mixer.count; rotor_index++)
+	{
+		throttle.values[rotor_index] = collective + mixer.axis_factors[rotor_index].dot(axis_command);
+	}
+
+	return throttle;
+}
@@ -0,0 +1,808 @@
+#include "DroneSimulatorPhysics/Public/Controller/PidAutoTuner.h"
+#include "DroneSimulatorPhysics/Private/Environment/WorkerPool.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <thread>
+
+namespace
+{
+	// Cost of a drone that diverged, above anything a flying drone scores
+	constexpr double diverged_cost = 1e6;
+
+	// Cost added per squared distance of a candidate outside of the bounds, so that the search comes back in
+	constexpr double out_of_bounds_penalty = 1e3;
+
+	double get_axis(const physics::FVector3& vector, std::int32_t axis)
+	{
+		return axis == 0 ? vector.X : (axis == 1 ? vector.Y : vector.Z);
+	}
+
+	physics::FVector3 make_axis(std::int32_t axis, double value)
+	{
+		return physics::FVector3(axis == 0 ? value : 0.0, axis == 1 ? value : 0.0, axis == 2 ? value : 0.0);
+	}
+
+	template<typename TDroneSimulation>
+	auto* find_pid_controller(TDroneSimulation& drone)
+	{
+		auto* dynamics = std::get_if<physics::FPropulsionModelDynamics>(&drone.propulsion_model);
+		return dynamics != nullptr ? std::get_if<physics::FPidDroneController>(&dynamics->controller) : nullptr;
+	}
+
+	// The gains searched for the target, in the order of the search vector
+	std::vector<double*> get_tuned_gains(physics::FPidTuningGains& gains, physics::EPidTuningTarget target)
+	{
+		if (target == physics::EPidTuningTarget::velocity_mode)
+		{
+			auto& velocity = gains.velocity;
+			return { &velocity.velocity_p, &velocity.velocity_i, &velocity.vertical_velocity_p, &velocity.vertical_velocity_i,
+				&velocity.vertical_velocity_d };
+		}
+
+		auto& controller = gains.controller;
+		return {
+			&controller.roll_pid.proportional, &controller.roll_pid.integral, &controller.roll_pid.derivative,
+			&controller.pitch_pid.proportional, &controller.pitch_pid.integral, &controller.pitch_pid.derivative,
+			&controller.yaw_pid.proportional, &controller.yaw_pid.integral, &controller.yaw_pid.derivative,
+		};
+	}
+
+	std::vector<double> get_gain_bounds(const physics::FPidTuningConfig& config)
+	{
+		if (config.target == physics::EPidTuningTarget::velocity_mode)
+		{
+			return { config.max_velocity_proportional, config.max_velocity_integral, config.max_vertical_velocity_proportional,
+				config.max_vertical_velocity_integral, config.max_vertical_velocity_derivative };
+		}
+
+		std::vector<double> bounds;
+		for (std::int32_t axis = 0; axis < 3; axis++)
+		{
+			bounds.insert(bounds.end(), { config.max_rate_proportional, config.max_rate_integral, config.max_rate_derivative });
+		}
+		return bounds;
+	}
+
+	// The search runs in [0, 1] on every gain, so that one step size fits gains of different magnitudes
+	std::vector<double> to_search_space(physics::FPidTuningGains gains, const physics::FPidTuningConfig& config)
+	{
+		const auto tuned_gains = get_tuned_gains(gains, config.target);
+		const auto bounds = get_gain_bounds(config);
+
+		std::vector<double> point(tuned_gains.size());
+		for (std::size_t index = 0; index < point.size(); index++)
+		{
+			point[index] = physics::math::clamp(*tuned_gains[index] / bounds[index], 0.0, 1.0);
+		}
+		return point;
+	}
+
+	physics::FPidTuningGains from_search_space(const std::vector<double>& point, const physics::FPidTuningGains& initial_gains,
+		const physics::FPidTuningConfig& config)
+	{
+		auto gains = initial_gains;
+		const auto tuned_gains = get_tuned_gains(gains, config.target);
+		const auto bounds = get_gain_bounds(config);
+
+		for (std::size_t index = 0; index < point.size(); index++)
+		{
+			*tuned_gains[index] = physics::math::clamp(point[index], 0.0, 1.0) * bounds[index];
+		}
+		return gains;
+	}
+
+	double get_out_of_bounds_distance_squared(const std::vector<double>& point)
+	{
+		double distance_squared = 0.0;
+		for (const auto value : point)
+		{
+			const auto distance = value - physics::math::clamp(value, 0.0, 1.0);
+			distance_squared += distance * distance;
+		}
+		return distance_squared;
+	}
+
+	/**
+	 * Eigendecomposition of a symmetric matrix, row-major, by cyclic Jacobi rotations. Small and exact enough for the
+	 * few gains of a controller.
+	 */
+	void decompose_symmetric(std::vector<double> matrix, std::int32_t size, std::vector<double>& out_eigenvalues,
+		std::vector<double>& out_eigenvectors)
+	{
+		out_eigenvectors.assign(size * size, 0.0);
+		for (std::int32_t index = 0; index < size; index++)
+		{
+			out_eigenvectors[index * size + index] = 1.0;
+		}
+
+		for (std::int32_t sweep = 0; sweep < 64; sweep++)
+		{
+			double off_diagonal = 0.0;
+			for (std::int32_t row = 0; row < size; row++)
+			{
+				for (std::int32_t column = row + 1; column < size; column++)
+				{
+					off_diagonal += matrix[row * size + column] * matrix[row * size + column];
+				}
+			}
+
+			if (off_diagonal < 1e-30)
+			{
+				break;
+			}
+
+			for (std::int32_t p = 0; p < size; p++)
+			{
+				for (std::int32_t q = p + 1; q < size; q++)
+				{
+					const auto apq = matrix[p * size + q];
+					if (std::abs(apq) < 1e-300)
+					{
+						continue;
+					}
+
+					const auto theta = (matrix[q * size + q] - matrix[p * size + p]) / (2.0 * apq);
+					const auto t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+					const auto c = 1.0 / std::sqrt(t * t + 1.0);
+					const auto s = t * c;
+
+					for (std::int32_t k = 0; k < size; k++)
+					{
+						const auto akp = matrix[k * size + p];
+						const auto akq = matrix[k * size + q];
+						matrix[k * size + p] = c * akp - s * akq;
+						matrix[k * size + q] = s * akp + c * akq;
+					}
+
+					for (std::int32_t k = 0; k < size; k++)
+					{
+						const auto apk = matrix[p * size + k];
+						const auto aqk = matrix[q * size + k];
+						matrix[p * size + k] = c * apk - s * aqk;
+						matrix[q * size + k] = s * apk + c * aqk;
+					}
+
+					for (std::int32_t k = 0; k < size; k++)
+					{
+						const auto vkp = out_eigenvectors[k * size + p];
+						const auto vkq = out_eigenvectors[k * size + q];
+						out_eigenvectors[k * size + p] = c * vkp - s * vkq;
+						out_eigenvectors[k * size + q] = s * vkp + c * vkq;
+					}
+				}
+			}
+		}
+
+		out_eigenvalues.resize(size);
+		for (std::int32_t index = 0; index < size; index++)
+		{
+			out_eigenvalues[index] = matrix[index * size + index];
+		}
+	}
+
+	/**
+	 * (mu/mu_w, lambda)-CMA-ES, as in Hansen's tutorial "The CMA Evolution Strategy". Samples are drawn on the calling
+	 * thread, so the search only depends on the seed.
+	 */
+	class FCmaEvolutionStrategy
+	{
+	public:
+
+		FCmaEvolutionStrategy(const std::vector<double>& initial_mean, double initial_step_size, std::int32_t in_population_size,
+			std::uint64_t seed)
+			: size(static_cast<std::int32_t>(initial_mean.size()))
+			, population_size(in_population_size > 0
+				? in_population_size
+				: 4 + static_cast<std::int32_t>(3.0 * std::log(static_cast<double>(initial_mean.size()))))
+			, mean(initial_mean)
+			, step_size(initial_step_size)
+			, random(seed)
+		{
+			const auto n = static_cast<double>(this->size);
+
+			const auto parent_count = std::max(1, this->population_size / 2);
+			for (std::int32_t rank = 0; rank < parent_count; rank++)
+			{
+				this->weights.push_back(std::log(parent_count + 0.5) - std::log(rank + 1.0));
+			}
+			const auto weight_sum = std::accumulate(this->weights.begin(), this->weights.end(), 0.0);
+			double weight_squared_sum = 0.0;
+			for (auto& weight : this->weights)
+			{
+				weight /= weight_sum;
+				weight_squared_sum += weight * weight;
+			}
+			this->effective_parent_count = 1.0 / weight_squared_sum;
+
+			const auto mu_eff = this->effective_parent_count;
+			this->cumulation_covariance = (4.0 + mu_eff / n) / (n + 4.0 + 2.0 * mu_eff / n);
+			this->cumulation_step_size = (mu_eff + 2.0) / (n + mu_eff + 5.0);
+			this->learning_rate_rank_one = 2.0 / ((n + 1.3) * (n + 1.3) + mu_eff);
+			this->learning_rate_rank_mu = std::min(1.0 - this->learning_rate_rank_one,
+				2.0 * (mu_eff - 2.0 + 1.0 / mu_eff) / ((n + 2.0) * (n + 2.0) + mu_eff));
+			this->step_size_damping = 1.0 + 2.0 * std::max(0.0, std::sqrt((mu_eff - 1.0) / (n + 1.0)) - 1.0)
+				+ this->cumulation_step_size;
+			this->expected_normal_length = std::sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+			this->evolution_path_covariance.assign(this->size, 0.0);
+			this->evolution_path_step_size.assign(this->size, 0.0);
+			this->covariance.assign(this->size * this->size, 0.0);
+			for (std::int32_t index = 0; index < this->size; index++)
+			{
+				this->covariance[index * this->size + index] = 1.0;
+			}
+			this->update_eigendecomposition();
+		}
+
+		std::int32_t get_population_size() const { return this->population_size; }
+
+		// Largest standard deviation of the search along one axis
+		double get_max_standard_deviation() const
+		{
+			double max_variance = 0.0;
+			for (std::int32_t index = 0; index < this->size; index++)
+			{
+				max_variance = std::max(max_variance, this->covariance[index * this->size + index]);
+			}
+			return this->step_size * std::sqrt(max_variance);
+		}
+
+		std::vector<std::vector<double>> sample()
+		{
+			std::normal_distribution<double> normal;
+			std::vector<std::vector<double>> candidates(this->population_size, std::vector<double>(this->size));
+
+			std::vector<double> z(this->size);
+			for (auto& candidate : candidates)
+			{
+				for (auto& value : z)
+				{
+					value = normal(this->random);
+				}
+
+				// mean + step_size * B * D * z
+				for (std::int32_t row = 0; row < this->size; row++)
+				{
+					double offset = 0.0;
+					for (std::int32_t column = 0; column < this->size; column++)
+					{
+						offset += this->eigenvectors[row * this->size + column] * this->axis_lengths[column] * z[column];
+					}
+					candidate[row] = this->mean[row] + this->step_size * offset;
+				}
+			}
+
+			return candidates;
+		}
+
+		void update(const std::vector<std::vector<double>>& candidates, const std::vector<double>& costs)
+		{
+			const auto n = this->size;
+			const auto mu_eff = this->effective_parent_count;
+
+			std::vector<std::int32_t> ranking(candidates.size());
+			std::iota(ranking.begin(), ranking.end(), 0);
+			std::stable_sort(ranking.begin(), ranking.end(), [&](std::int32_t a, std::int32_t b) { return costs[a] < costs[b]; });
+
+			// Steps of the parents from the old mean, in units of the step size
+			std::vector<std::vector<double>> parent_steps(this->weights.size(), std::vector<double>(n));
+			std::vector<double> mean_step(n, 0.0);
+			for (std::size_t rank = 0; rank < this->weights.size(); rank++)
+			{
+				const auto& candidate = candidates[ranking[rank]];
+				for (std::int32_t index = 0; index < n; index++)
+				{
+					parent_steps[rank][index] = (candidate[index] - this->mean[index]) / this->step_size;
+					mean_step[index] += this->weights[rank] * parent_steps[rank][index];
+				}
+			}
+
+			for (std::int32_t index = 0; index < n; index++)
+			{
+				this->mean[index] += this->step_size * mean_step[index];
+			}
+
+			// C^-1/2 * mean_step = B * D^-1 * B^T * mean_step
+			std::vector<double> whitened_step(n, 0.0);
+			for (std::int32_t column = 0; column < n; column++)
+			{
+				double projection = 0.0;
+				for (std::int32_t row = 0; row < n; row++)
+				{
+					projection += this->eigenvectors[row * n + column] * mean_step[row];
+				}
+				projection /= this->axis_lengths[column];
+				for (std::int32_t row = 0; row < n; row++)
+				{
+					whitened_step[row] += this->eigenvectors[row * n + column] * projection;
+				}
+			}
+
+			const auto step_size_factor = std::sqrt(this->cumulation_step_size * (2.0 - this->cumulation_step_size) * mu_eff);
+			double path_length_squared = 0.0;
+			for (std::int32_t index = 0; index < n; index++)
+			{
+				auto& path = this->evolution_path_step_size[index];
+				path = (1.0 - this->cumulation_step_size) * path + step_size_factor * whitened_step[index];
+				path_length_squared += path * path;
+			}
+			const auto path_length = std::sqrt(path_length_squared);
+
+			this->generation++;
+			const auto path_normalization = std::sqrt(1.0 - std::pow(1.0 - this->cumulation_step_size, 2.0 * this->generation));
+			const auto is_path_stalled = path_length / path_normalization
+				< (1.4 + 2.0 / (n + 1.0)) * this->expected_normal_length;
+			const auto stall = is_path_stalled ? 1.0 : 0.0;
+
+			const auto covariance_factor = std::sqrt(this->cumulation_covariance * (2.0 - this->cumulation_covariance) * mu_eff);
+			for (std::int32_t index = 0; index < n; index++)
+			{
+				auto& path = this->evolution_path_covariance[index];
+				path = (1.0 - this->cumulation_covariance) * path + stall * covariance_factor * mean_step[index];
+			}
+
+			const auto c1 = this->learning_rate_rank_one;
+			const auto cmu = this->learning_rate_rank_mu;
+			const auto stall_correction = (1.0 - stall) * this->cumulation_covariance * (2.0 - this->cumulation_covariance);
+			for (std::int32_t row = 0; row < n; row++)
+			{
+				for (std::int32_t column = 0; column < n; column++)
+				{
+					double rank_mu = 0.0;
+					for (std::size_t rank = 0; rank < this->weights.size(); rank++)
+					{
+						rank_mu += this->weights[rank] * parent_steps[rank][row] * parent_steps[rank][column];
+					}
+
+					auto& value = this->covariance[row * n + column];
+					const auto rank_one = this->evolution_path_covariance[row] * this->evolution_path_covariance[column];
+					value = (1.0 - c1 - cmu) * value + c1 * (rank_one + stall_correction * value) + cmu * rank_mu;
+				}
+			}
+
+			this->step_size *= std::exp((this->cumulation_step_size / this->step_size_damping)
+				* (path_length / this->expected_normal_length - 1.0));
+
+			this->update_eigendecomposition();
+		}
+
+	private:
+
+		void update_eigendecomposition()
+		{
+			std::vector<double> eigenvalues;
+			decompose_symmetric(this->covariance, this->size, eigenvalues, this->eigenvectors);
+
+			this->axis_lengths.resize(this->size);
+			for (std::int32_t index = 0; index < this->size; index++)
+			{
+				this->axis_lengths[index] = std::sqrt(std::max(eigenvalues[index], 1e-20));
+			}
+		}
+
+		std::int32_t size;
+
+		std::int32_t population_size;
+
+		std::vector<double> weights;
+
+		double effective_parent_count = 1.0;
+
+		double cumulation_covariance = 0.0;
+
+		double cumulation_step_size = 0.0;
+
+		double learning_rate_rank_one = 0.0;
+
+		double learning_rate_rank_mu = 0.0;
+
+		double step_size_damping = 1.0;
+
+		double expected_normal_length = 1.0;
+
+		std::vector<double> mean;
+
+		double step_size;
+
+		std::vector<double> evolution_path_covariance;
+
+		std::vector<double> evolution_path_step_size;
+
+		// Row-major
+		std::vector<double> covariance;
+
+		// Columns are the principal axes of the covariance, row-major
+		std::vector<double> eigenvectors;
+
+		// Square roots of the eigenvalues
+		std::vector<double> axis_lengths;
+
+		std::int32_t generation = 0;
+
+		std::mt19937_64 random;
+	};
+
+	physics::FTuningScore average_scores(const std::vector<physics::FTuningScore>& scores)
+	{
+		physics::FTuningScore average;
+		if (scores.empty())
+		{
+			return average;
+		}
+
+		for (const auto& score : scores)
+		{
+			average.tracking_error += score.tracking_error;
+			average.overshoot += score.overshoot;
+			average.settling_time += score.settling_time;
+			average.saturation += score.saturation;
+			average.oscillation += score.oscillation;
+			average.cost += score.cost;
+		}
+
+		const auto count = static_cast<double>(scores.size());
+		average.tracking_error /= count;
+		average.overshoot /= count;
+		average.settling_time /= count;
+		average.saturation /= count;
+		average.oscillation /= count;
+		average.cost /= count;
+		return average;
+	}
+
+	// Every manoeuvre of every candidate is one task, so that all the cores are busy even with a small population
+	std::vector<physics::FTuningScore> evaluate_candidates(physics::FWorkerPool& worker_pool, const physics::FDroneSimulation& drone,
+		const std::vector<physics::FPidTuningGains>& candidates, const std::vector<physics::FTuningManoeuvre>& manoeuvres,
+		const physics::FPidTuningConfig& config)
+	{
+		const auto manoeuvre_count = static_cast<std::int32_t>(manoeuvres.size());
+		const auto task_count = static_cast<std::int32_t>(candidates.size()) * manoeuvre_count;
+
+		std::vector<physics::FTuningScore> manoeuvre_scores(task_count);
+		worker_pool.parallel_for(task_count, [&](std::int32_t begin, std::int32_t end)
+		{
+			for (auto task_index = begin; task_index < end; task_index++)
+			{
+				const auto& gains = candidates[task_index / manoeuvre_count];
+				const auto& manoeuvre = manoeuvres[task_index % manoeuvre_count];
+				manoeuvre_scores[task_index] = physics::pid_tuning::run_manoeuvre(drone, gains, manoeuvre, config);
+			}
+		});
+
+		std::vector<physics::FTuningScore> scores;
+		scores.reserve(candidates.size());
+		for (std::size_t candidate_index = 0; candidate_index < candidates.size(); candidate_index++)
+		{
+			const auto first = manoeuvre_scores.begin() + candidate_index * manoeuvre_count;
+			scores.push_back(average_scores(std::vector<physics::FTuningScore>(first, first + manoeuvre_count)));
+		}
+		return scores;
+	}
+}
+
+physics::FPidAutoTuner::FPidAutoTuner(std::int32_t num_threads)
+	: worker_pool(std::make_unique<FWorkerPool>(num_threads > 0
+		? num_threads
+		: std::max(1, static_cast<std::int32_t>(std::thread::hardware_concurrency()))))
+{
+}
+
+physics::FPidAutoTuner::~FPidAutoTuner() = default;
+
+std::optional<physics::FPidTuningResult> physics::FPidAutoTuner::tune(const FDroneSimulation& drone, const FPidTuningConfig& config)
+{
+	const auto initial_gains = pid_tuning::get_gains(drone);
+	if (!initial_gains.has_value())
+	{
+		return std::nullopt;
+	}
+
+	const auto manoeuvres = config.manoeuvres.empty() ? pid_tuning::make_default_manoeuvres(config.target) : config.manoeuvres;
+
+	FPidTuningResult result;
+	result.gains = *initial_gains;
+	result.initial_score = evaluate_candidates(*this->worker_pool, drone, { *initial_gains }, manoeuvres, config).front();
+	result.score = result.initial_score;
+	result.evaluation_count = 1;
+
+	FCmaEvolutionStrategy strategy(to_search_space(*initial_gains, config), config.initial_step_size, config.population_size,
+		config.seed);
+
+	for (std::int32_t generation = 0; generation < config.max_generations; generation++)
+	{
+		const auto points = strategy.sample();
+
+		std::vector<FPidTuningGains> candidates;
+		candidates.reserve(points.size());
+		for (const auto& point : points)
+		{
+			candidates.push_back(from_search_space(point, *initial_gains, config));
+		}
+
+		const auto scores = evaluate_candidates(*this->worker_pool, drone, candidates, manoeuvres, config);
+
+		std::vector<double> costs(points.size());
+		for (std::size_t candidate_index = 0; candidate_index < points.size(); candidate_index++)
+		{
+			costs[candidate_index] = scores[candidate_index].cost
+				+ out_of_bounds_penalty * get_out_of_bounds_distance_squared(points[candidate_index]);
+
+			// Candidates are clamped into the bounds before being flown, so the best one is always valid
+			if (scores[candidate_index].cost < result.score.cost)
+			{
+				result.score = scores[candidate_index];
+				result.gains = candidates[candidate_index];
+			}
+		}
+
+		strategy.update(points, costs);
+
+		result.generation_count = generation + 1;
+		result.evaluation_count += static_cast<std::int32_t>(points.size());
+
+		if (strategy.get_max_standard_deviation() < config.min_step_size)
+		{
+			break;
+		}
+	}
+
+	return result;
+}
+
+physics::FTuningScore physics::FPidAutoTuner::evaluate(const FDroneSimulation& drone, const FPidTuningGains& gains,
+	const FPidTuningConfig& config)
+{
+	const auto manoeuvres = config.manoeuvres.empty() ? pid_tuning::make_default_manoeuvres(config.target) : config.manoeuvres;
+	return evaluate_candidates(*this->worker_pool, drone, { gains }, manoeuvres, config).front();
+}
+
+std::vector<physics::FTuningManoeuvre> physics::pid_tuning::make_default_manoeuvres(EPidTuningTarget target)
+{
+	std::vector<FTuningManoeuvre> manoeuvres;
+
+	for (std::int32_t axis = 0; axis < 3; axis++)
+	{
+		if (target == EPidTuningTarget::velocity_mode)
+		{
+			// The velocity loops are an order of magnitude slower than the rate loops
+			manoeuvres.push_back(FTuningManoeuvre { ETuningManoeuvreType::step, axis, 0.5, 3.0 });
+			manoeuvres.push_back(FTuningManoeuvre { ETuningManoeuvreType::chirp, axis, 0.3, 4.0, 0.1, 1.0 });
+			manoeuvres.push_back(FTuningManoeuvre { ETuningManoeuvreType::disturbance, axis, 2.0, 3.0 });
+		}
+		else
+		{
+			manoeuvres.push_back(FTuningManoeuvre { ETuningManoeuvreType::step, axis, 0.5, 0.5 });
+			manoeuvres.push_back(FTuningManoeuvre { ETuningManoeuvreType::chirp, axis, 0.3, 1.0, 1.0, 10.0 });
+			manoeuvres.push_back(FTuningManoeuvre { ETuningManoeuvreType::disturbance, axis, 3.0, 0.5 });
+		}
+	}
+
+	return manoeuvres;
+}
+
+std::optional<physics::FPidTuningGains> physics::pid_tuning::get_gains(const FDroneSimulation& drone)
+{
+	const auto* controller = find_pid_controller(drone);
+	if (controller == nullptr || !drone.model->has_propulsion() || drone.model->get_propulsion_setup().mixer == nullptr)
+	{
+		return std::nullopt;
+	}
+
+	FPidTuningGains gains;
+	gains.controller = controller->config;
+
+	const auto* velocity_flight_mode = std::get_if<FFlightModeVelocity>(&drone.flight_mode);
+	if (velocity_flight_mode != nullptr)
+	{
+		gains.velocity = velocity_flight_mode->config;
+	}
+
+	return gains;
+}
+
+void physics::pid_tuning::apply_gains(FDroneSimulation& drone, const FPidTuningGains& gains)
+{
+	auto* controller = find_pid_controller(drone);
+	if (controller != nullptr)
+	{
+		controller->config = gains.controller;
+	}
+
+	auto* velocity_flight_mode = std::get_if<FFlightModeVelocity>(&drone.flight_mode);
+	if (velocity_flight_mode != nullptr)
+	{
+		velocity_flight_mode->config = gains.velocity;
+	}
+}
+
+physics::FTuningScore physics::pid_tuning::run_manoeuvre(const FDroneSimulation& drone, const FPidTuningGains& gains,
+	const FTuningManoeuvre& manoeuvre, const FPidTuningConfig& config)
+{
+	const auto is_velocity_mode = config.target == EPidTuningTarget::velocity_mode;
+
+	auto simulation = drone;
+	simulation.is_armed = true;
+	simulation.sleep_config.is_enabled = false;
+	simulation.sleep_state = FSleepState();
+
+	auto* controller = find_pid_controller(simulation);
+	controller->config = gains.controller;
+	controller->state = FPidDroneControllerState();
+
+	if (is_velocity_mode)
+	{
+		simulation.flight_mode = FFlightModeVelocity { gains.velocity, FFlightModeVelocityState() };
+	}
+	else if (!std::holds_alternative<FFlightModeAir>(simulation.flight_mode))
+	{
+		simulation.flight_mode = FFlightModeAir();
+	}
+
+	if (manoeuvre.type == ETuningManoeuvreType::disturbance)
+	{
+		auto& body = simulation.body;
+		if (is_velocity_mode)
+		{
+			body.linear_velocity_world = body.linear_velocity_world + make_axis(manoeuvre.axis, manoeuvre.amplitude);
+		}
+		else
+		{
+			body.angular_velocity_radians_world = body.angular_velocity_radians_world
+				+ body.transform_world.rotation.rotate_vector(make_axis(manoeuvre.axis, manoeuvre.amplitude));
+		}
+	}
+
+	const auto substep_duration = 1.0 / simulation.tick_rate_hz;
+	const auto substep_count = std::max(1, static_cast<std::int32_t>(std::lround(manoeuvre.duration * simulation.tick_rate_hz)));
+
+	std::vector<double> references(substep_count);
+	std::vector<double> responses(substep_count);
+	std::int32_t saturated_substep_count = 0;
+
+	for (std::int32_t substep = 0; substep < substep_count; substep++)
+	{
+		const auto time = substep * substep_duration;
+
+		double stick = 0.0;
+		if (manoeuvre.type == ETuningManoeuvreType::step)
+		{
+			stick = manoeuvre.amplitude;
+		}
+		else if (manoeuvre.type == ETuningManoeuvreType::chirp)
+		{
+			// Linear sweep: the phase is the integral of the frequency
+			const auto sweep_rate = (manoeuvre.end_frequency_hz - manoeuvre.start_frequency_hz) / manoeuvre.duration;
+			const auto phase = math::two_pi * (manoeuvre.start_frequency_hz * time + 0.5 * sweep_rate * time * time);
+			stick = manoeuvre.amplitude * std::sin(phase);
+		}
+
+		auto input = FDronePlayerInput::zero();
+		if (is_velocity_mode)
+		{
+			// See compute_velocity_setpoint, the drone starts facing world X
+			input.pitch = manoeuvre.axis == 0 ? -stick : 0.0;
+			input.roll = manoeuvre.axis == 1 ? stick : 0.0;
+			input.throttle = manoeuvre.axis == 2 ? stick : 0.0;
+		}
+		else
+		{
+			input.throttle = config.rate_throttle;
+			input.roll = manoeuvre.axis == 0 ? stick : 0.0;
+			input.pitch = manoeuvre.axis == 1 ? stick : 0.0;
+			input.yaw = manoeuvre.axis == 2 ? stick : 0.0;
+		}
+
+		simulation.advance_substeps(1, input);
+
+		const auto& body = simulation.body;
+		if (is_velocity_mode)
+		{
+			const auto max_velocity = manoeuvre.axis == 2
+				? gains.velocity.max_vertical_velocity_m_s
+				: gains.velocity.max_horizontal_velocity_m_s;
+			references[substep] = stick * max_velocity;
+			responses[substep] = get_axis(body.linear_velocity_world, manoeuvre.axis);
+		}
+		else
+		{
+			references[substep] = get_axis(simulation.setpoint.angular_velocity_radians, manoeuvre.axis);
+			responses[substep] = get_axis(body.transform_world.rotation.unrotate_vector(body.angular_velocity_radians_world),
+				manoeuvre.axis);
+		}
+
+		const auto& throttle = std::get<FPropulsionModelDynamics>(simulation.propulsion_model).held_outputs.throttle;
+		if (throttle.count > 0 && (throttle.max() >= 1.0 - 1e-9 || throttle.min() <= gains.controller.min_dynamic_throttle + 1e-9))
+		{
+			saturated_substep_count++;
+		}
+	}
+
+	double amplitude = std::abs(manoeuvre.amplitude);
+	if (manoeuvre.type != ETuningManoeuvreType::disturbance)
+	{
+		amplitude = 0.0;
+		for (const auto reference : references)
+		{
+			amplitude = std::max(amplitude, std::abs(reference));
+		}
+	}
+	amplitude = std::max(amplitude, 1e-9);
+
+	FTuningScore score;
+
+	for (std::int32_t substep = 0; substep < substep_count; substep++)
+	{
+		if (!std::isfinite(responses[substep]) || std::abs(responses[substep]) > 100.0 * amplitude)
+		{
+			score.cost = diverged_cost;
+			return score;
+		}
+	}
+
+	double error_sum = 0.0;
+	double response_travel = 0.0;
+	double reference_travel = 0.0;
+	std::int32_t last_unsettled_substep = -1;
+
+	for (std::int32_t substep = 0; substep < substep_count; substep++)
+	{
+		const auto error = std::abs(references[substep] - responses[substep]);
+		error_sum += error;
+
+		if (error > config.weights.settling_band * amplitude)
+		{
+			last_unsettled_substep = substep;
+		}
+
+		if (substep > 0)
+		{
+			response_travel += std::abs(responses[substep] - responses[substep - 1]);
+			reference_travel += std::abs(references[substep] - references[substep - 1]);
+		}
+	}
+
+	score.tracking_error = error_sum / (substep_count * amplitude);
+	score.saturation = static_cast<double>(saturated_substep_count) / substep_count;
+
+	// Closing the initial error takes one amplitude of travel, anything above that or the reference's own travel is ringing
+	const auto initial_error = std::abs(responses.front() - references.front());
+	score.oscillation = std::max(0.0, response_travel - reference_travel - initial_error) / amplitude;
+
+	if (manoeuvre.type == ETuningManoeuvreType::step)
+	{
+		const auto final_reference = references.back();
+		const auto direction = final_reference >= 0.0 ? 1.0 : -1.0;
+		double peak_excursion = 0.0;
+		for (const auto response : responses)
+		{
+			peak_excursion = std::max(peak_excursion, direction * (response - final_reference));
+		}
+		score.overshoot = peak_excursion / amplitude;
+		score.settling_time = (last_unsettled_substep + 1) * substep_duration;
+	}
+	else if (manoeuvre.type == ETuningManoeuvreType::disturbance)
+	{
+		// Past zero, on the other side of the kick
+		const auto direction = manoeuvre.amplitude >= 0.0 ? 1.0 : -1.0;
+		double peak_excursion = 0.0;
+		for (const auto response : responses)
+		{
+			peak_excursion = std::max(peak_excursion, -direction * response);
+		}
+		score.overshoot = peak_excursion / amplitude;
+		score.settling_time = (last_unsettled_substep + 1) * substep_duration;
+	}
+
+	const auto& weights = config.weights;
+	score.cost = weights.tracking_error * score.tracking_error
+		+ weights.overshoot * score.overshoot
+		+ weights.settling_time * score.settling_time
+		+ weights.saturation * score.saturation
+		+ weights.oscillation * score.oscillation;
+
+	return score;
+}
@@ -0,0 +1,113 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Private/Simulation/TestDrone.h"
+#include "DroneSimulatorPhysics/Public/Controller/PidAutoTuner.h"
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+	physics::FDroneSimulation make_tuning_drone()
+	{
+		auto simulation = physics::test_drone::make_simulation(physics::FRotorModelDebug());
+		simulation.reset_body(physics::FVector3(0.0, 0.0, 100000.0), physics::FQuaternion::identity());
+
+		// Rate response within a few tens of milliseconds, so that the manoeuvres are short
+		simulation.body.inertia_tensor = physics::FVector3(0.02, 0.02, 0.04);
+		return simulation;
+	}
+
+	void set_rate_gains(physics::FDroneSimulation& drone, double proportional)
+	{
+		auto gains = *physics::pid_tuning::get_gains(drone);
+		gains.controller.roll_pid = physics::FPidConfig { proportional, 0.0, 0.0 };
+		gains.controller.pitch_pid = physics::FPidConfig { proportional, 0.0, 0.0 };
+		gains.controller.yaw_pid = physics::FPidConfig { proportional, 0.0, 0.0 };
+		physics::pid_tuning::apply_gains(drone, gains);
+	}
+}
+
+TEST_CASE("PID auto-tuner", "[controller][tuning]")
+{
+	auto drone = make_tuning_drone();
+
+	physics::FPidTuningConfig config;
+	config.rate_throttle = 0.15;
+
+	SECTION("Scores a controller that tracks better than one that doesn't")
+	{
+		physics::FPidAutoTuner tuner(2);
+
+		auto weak_drone = drone;
+		set_rate_gains(weak_drone, 0.001);
+
+		const auto score = tuner.evaluate(drone, *physics::pid_tuning::get_gains(drone), config);
+		const auto weak_score = tuner.evaluate(weak_drone, *physics::pid_tuning::get_gains(weak_drone), config);
+
+		CHECK(score.tracking_error < weak_score.tracking_error);
+		CHECK(score.cost < weak_score.cost);
+	}
+
+	SECTION("Scores the overshoot of a step")
+	{
+		const auto step = physics::FTuningManoeuvre { physics::ETuningManoeuvreType::step, 0, 0.5, 0.5 };
+
+		auto aggressive_gains = *physics::pid_tuning::get_gains(drone);
+		aggressive_gains.controller.roll_pid = physics::FPidConfig { 0.1, 1.0, 0.0 };
+
+		const auto score = physics::pid_tuning::run_manoeuvre(drone, *physics::pid_tuning::get_gains(drone), step, config);
+		const auto aggressive_score = physics::pid_tuning::run_manoeuvre(drone, aggressive_gains, step, config);
+
+		CHECK(aggressive_score.overshoot > score.overshoot);
+	}
+
+	SECTION("Improves on the initial gains, with the same result whatever the number of threads")
+	{
+		set_rate_gains(drone, 0.01);
+		config.max_generations = 6;
+
+		const auto result = physics::FPidAutoTuner(1).tune(drone, config);
+		const auto parallel_result = physics::FPidAutoTuner(4).tune(drone, config);
+
+		REQUIRE(result.has_value());
+		REQUIRE(parallel_result.has_value());
+
+		CHECK(result->generation_count == 6);
+		CHECK(result->score.cost < result->initial_score.cost);
+
+		CHECK(parallel_result->score.cost == result->score.cost);
+		CHECK(parallel_result->gains.controller.roll_pid.proportional == result->gains.controller.roll_pid.proportional);
+		CHECK(parallel_result->gains.controller.yaw_pid.derivative == result->gains.controller.yaw_pid.derivative);
+
+		// Not tuned
+		CHECK(result->gains.controller.min_throttle == physics::FPidDroneControllerConfig().min_throttle);
+	}
+
+	SECTION("Tunes the velocity flight mode")
+	{
+		drone.flight_mode = physics::FFlightModeVelocity();
+		std::get<physics::FFlightModeVelocity>(drone.flight_mode).config.hover_throttle = 0.1;
+
+		config.target = physics::EPidTuningTarget::velocity_mode;
+		config.max_generations = 2;
+
+		const auto result = physics::FPidAutoTuner(2).tune(drone, config);
+		REQUIRE(result.has_value());
+		CHECK(result->score.cost <= result->initial_score.cost);
+		CHECK(result->evaluation_count > 1);
+
+		// The rate PID is left as-is
+		CHECK(result->gains.controller.roll_pid.proportional == physics::FPidDroneControllerConfig().roll_pid.proportional);
+	}
+
+	SECTION("Needs a PID controller")
+	{
+		drone.propulsion_model = physics::FPropulsionModelDynamics { physics::FBasicDroneController(), physics::FRotorModelDebug(),
+			physics::FPropulsionHeldOutputs() };
+
+		CHECK_FALSE(physics::pid_tuning::get_gains(drone).has_value());
+		CHECK_FALSE(physics::FPidAutoTuner(1).tune(drone, config).has_value());
+	}
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "DroneSimulatorPhysics/Public/Controller/PilotInputBuffer.h"
+
+#include <algorithm>
+
+void physics::FPilotInputBuffer::push(double time_seconds, const FDronePlayerInput& input)
+{
+	if (this->count > 0)
+	{
+		const auto last_time_seconds = this->samples[this->count - 1].time_seconds;
+		if (time_seconds == last_time_seconds)
+		{
+			this->samples[this->count - 1].input = input;
+			return;
+		}
+
+		if (time_seconds < last_time_seconds)
+		{
+			this->count = 0;
+		}
+	}
+
+	if (this->count == capacity)
+	{
+		std::move(this->samples.begin() + 1, this->samples.end(), this->samples.begin());
+		this->count--;
+	}
+
+	this->samples[this->count] = FTimedPlayerInput { time_seconds, input };
+	this->count++;
+}
+
+physics::FDronePlayerInput physics::FPilotInputBuffer::sample(double time_seconds) const
+{
+	if (this->count == 0)
+	{
+		return FDronePlayerInput::zero();
+	}
+
+	if (time_seconds <= this->samples[0].time_seconds)
+	{
+		return this->samples[0].input;
+	}
+
+	for (std::int32_t sample_index = 1; sample_index < this->count; sample_index++)
+	{
+		const auto& next = this->samples[sample_index];
+		if (time_seconds >= next.time_seconds)
+		{
+			continue;
+		}
+
+		const auto& previous = this->samples[sample_index - 1];
+		const auto alpha = (time_seconds - previous.time_seconds) / (next.time_seconds - previous.time_seconds);
+		const auto lerp = [alpha](double from, double to)
+		{
+			return from + (to - from) * alpha;
+		};
+
+		return FDronePlayerInput {
+			lerp(previous.input.throttle, next.input.throttle),
+			lerp(previous.input.yaw, next.input.yaw),
+			lerp(previous.input.pitch, next.input.pitch),
+			lerp(previous.input.roll, next.input.roll),
+		};
+	}
+
+	return this->samples[this->count - 1].input;
+}
@@ -0,0 +1,60 @@
+#if WITH_DRONE_PHYSICS_BENCHMARKS
+
+#include "DroneSimulatorPhysics/Public/Controller/SitlBridge.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+// One lockstep exchange with a firmware that answers right away. 4 kHz lockstep needs it well under 20 µs, the rest
+// of the 250 µs substep being the simulation and the firmware. The argument is the transport.
+static void BM_SitlRoundTrip(benchmark::State& state)
+{
+	physics::FSitlBridgeConfig config;
+	config.transport = static_cast<physics::ESitlTransport>(state.range(0));
+	config.sensor_port = 39113;
+	config.motor_port = 39112;
+	config.shared_memory_name = "drone_sitl_benchmark";
+
+	physics::FSitlBridge bridge;
+	physics::FSitlFirmwareEndpoint firmware;
+	if (!bridge.open(config) || !firmware.open(config))
+	{
+		state.SkipWithError("Could not open the transport");
+		return;
+	}
+
+	std::atomic<bool> should_stop = false;
+	std::thread firmware_thread([&]
+	{
+		while (!should_stop.load(std::memory_order_relaxed))
+		{
+			if (firmware.receive_sensors(0.01) != nullptr)
+			{
+				firmware.get_motor_packet().motor_count = 4;
+				firmware.send_motors();
+			}
+		}
+	});
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(bridge.exchange());
+	}
+
+	should_stop = true;
+	firmware_thread.join();
+
+	const auto& stats = bridge.get_round_trip_stats();
+	state.counters["mean_us"] = stats.get_mean_seconds() * 1e6;
+	state.counters["max_us"] = stats.max_seconds * 1e6;
+	state.counters["timeouts"] = static_cast<double>(stats.timeout_count);
+}
+BENCHMARK(BM_SitlRoundTrip)
+	->Arg(static_cast<std::int64_t>(physics::ESitlTransport::udp))
+	->Arg(static_cast<std::int64_t>(physics::ESitlTransport::shared_memory))
+	->UseRealTime();
+
+#endif
@@ -0,0 +1,341 @@
+#include "DroneSimulatorPhysics/Public/Controller/SitlBridge.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+#include "DroneSimulatorPhysics/Private/Controller/UdpSocket.h"
+#include "DroneSimulatorPhysics/Private/Environment/SharedMemoryRegion.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <new>
+#include <thread>
+
+namespace
+{
+	using clock = std::chrono::steady_clock;
+
+	// Same as the gravity of the substep loop
+	constexpr double gravity = 9.81;
+
+	physics::FSitlSharedMemoryLayout* get_layout(const std::unique_ptr<physics::FSharedMemoryRegion>& region)
+	{
+		return static_cast<physics::FSitlSharedMemoryLayout*>(region->get_data());
+	}
+
+	clock::time_point get_deadline(double timeout_seconds)
+	{
+		return clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(timeout_seconds));
+	}
+
+	double get_remaining_seconds(clock::time_point deadline)
+	{
+		return std::chrono::duration<double>(deadline - clock::now()).count();
+	}
+
+	/**
+	 * Spins until the counter reaches the count. A lockstep exchange is a few microseconds, sleeping would cost more
+	 * than the exchange itself.
+	 */
+	bool wait_for_count(const std::atomic<std::uint64_t>& counter, std::uint64_t count, clock::time_point deadline)
+	{
+		while (counter.load(std::memory_order_acquire) < count)
+		{
+			if (clock::now() >= deadline)
+			{
+				return false;
+			}
+			std::this_thread::yield();
+		}
+		return true;
+	}
+
+	std::array<double, 3> to_array(const physics::FVector3& vector)
+	{
+		return { vector.X, vector.Y, vector.Z };
+	}
+}
+
+physics::FSitlBridge::FSitlBridge() = default;
+
+physics::FSitlBridge::~FSitlBridge() = default;
+
+bool physics::FSitlBridge::open(const FSitlBridgeConfig& in_config)
+{
+	this->config = in_config;
+	this->socket = nullptr;
+	this->region = nullptr;
+	this->next_sequence = 0;
+	this->is_firmware_connected = true;
+
+	if (this->config.transport == ESitlTransport::udp)
+	{
+		this->socket = FUdpSocket::open(this->config.motor_port, this->config.address, this->config.sensor_port);
+		return this->socket != nullptr;
+	}
+
+	this->region = FSharedMemoryRegion::create(this->config.shared_memory_name, sizeof(FSitlSharedMemoryLayout));
+	if (this->region == nullptr)
+	{
+		return false;
+	}
+
+	auto* layout = new (this->region->get_data()) FSitlSharedMemoryLayout();
+	layout->sensor_count.store(0, std::memory_order_relaxed);
+	layout->motor_count.store(0, std::memory_order_relaxed);
+	layout->version = FSitlSharedMemoryLayout::expected_version;
+
+	// The magic is written last, a firmware that sees it sees a complete layout
+	layout->magic.store(FSitlSharedMemoryLayout::expected_magic, std::memory_order_release);
+
+	return true;
+}
+
+bool physics::FSitlBridge::is_open() const
+{
+	return this->socket != nullptr || this->region != nullptr;
+}
+
+physics::FSitlSensorPacket& physics::FSitlBridge::get_sensor_packet()
+{
+	return this->region != nullptr ? get_layout(this->region)->sensors : this->sensor_packet;
+}
+
+const physics::FSitlMotorPacket* physics::FSitlBridge::exchange()
+{
+	if (!this->is_open())
+	{
+		return nullptr;
+	}
+
+	const auto sequence = this->next_sequence++;
+
+	auto& sensors = this->get_sensor_packet();
+	sensors.magic = FSitlSensorPacket::expected_magic;
+	sensors.sequence = sequence;
+
+	if (!this->is_firmware_connected)
+	{
+		// The answers to the probes are stale, the exchange after the one that sees the firmware waits again
+		this->is_firmware_connected = this->probe_firmware(sequence);
+		return nullptr;
+	}
+
+	const auto start_time = clock::now();
+	const auto deadline = get_deadline(this->config.timeout_seconds);
+	const FSitlMotorPacket* motors = nullptr;
+
+	if (this->socket != nullptr)
+	{
+		if (this->socket->send(&sensors, sizeof(FSitlSensorPacket)))
+		{
+			// Answers to earlier exchanges that timed out are dropped
+			for (auto remaining_seconds = this->config.timeout_seconds; remaining_seconds > 0.0;
+				remaining_seconds = get_remaining_seconds(deadline))
+			{
+				const auto size = this->socket->receive(&this->motor_packet, sizeof(FSitlMotorPacket), remaining_seconds);
+				if (size == sizeof(FSitlMotorPacket) && this->motor_packet.magic == FSitlMotorPacket::expected_magic
+					&& this->motor_packet.sequence == sequence)
+				{
+					motors = &this->motor_packet;
+					break;
+				}
+			}
+		}
+	}
+	else
+	{
+		auto* layout = get_layout(this->region);
+		layout->sensor_count.store(static_cast<std::uint64_t>(sequence) + 1, std::memory_order_release);
+
+		if (wait_for_count(layout->motor_count, static_cast<std::uint64_t>(sequence) + 1, deadline)
+			&& layout->motors.sequence == sequence)
+		{
+			motors = &layout->motors;
+		}
+	}
+
+	if (motors == nullptr)
+	{
+		this->round_trip_stats.timeout_count++;
+		this->is_firmware_connected = false;
+		this->first_probe_sequence = this->next_sequence;
+		return nullptr;
+	}
+
+	const auto round_trip_seconds = std::chrono::duration<double>(clock::now() - start_time).count();
+	this->round_trip_stats.exchange_count++;
+	this->round_trip_stats.total_seconds += round_trip_seconds;
+	this->round_trip_stats.max_seconds = std::max(this->round_trip_stats.max_seconds, round_trip_seconds);
+
+	return motors;
+}
+
+bool physics::FSitlBridge::probe_firmware(std::uint32_t sequence)
+{
+	const auto& sensors = this->get_sensor_packet();
+
+	if (this->socket != nullptr)
+	{
+		this->socket->send(&sensors, sizeof(FSitlSensorPacket));
+
+		// Drains what arrived without waiting, answers to the exchanges before the disconnection don't count
+		bool has_answered = false;
+		for (auto size = this->socket->receive(&this->motor_packet, sizeof(FSitlMotorPacket), 0.0); size >= 0;
+			size = this->socket->receive(&this->motor_packet, sizeof(FSitlMotorPacket), 0.0))
+		{
+			has_answered = has_answered || (size == sizeof(FSitlMotorPacket) && this->motor_packet.magic == FSitlMotorPacket::expected_magic
+				&& static_cast<std::int32_t>(this->motor_packet.sequence - this->first_probe_sequence) >= 0);
+		}
+		return has_answered;
+	}
+
+	// A late answer to the exchange that timed out doesn't count either
+	auto* layout = get_layout(this->region);
+	layout->sensor_count.store(static_cast<std::uint64_t>(sequence) + 1, std::memory_order_release);
+	return layout->motor_count.load(std::memory_order_acquire) > 0
+		&& static_cast<std::int32_t>(layout->motors.sequence - this->first_probe_sequence) >= 0;
+}
+
+void physics::FSitlBridge::reset_round_trip_stats()
+{
+	this->round_trip_stats = FSitlRoundTripStats();
+}
+
+physics::FSitlFirmwareEndpoint::FSitlFirmwareEndpoint() = default;
+
+physics::FSitlFirmwareEndpoint::~FSitlFirmwareEndpoint() = default;
+
+bool physics::FSitlFirmwareEndpoint::open(const FSitlBridgeConfig& in_config)
+{
+	this->config = in_config;
+	this->socket = nullptr;
+	this->region = nullptr;
+	this->received_count = 0;
+
+	if (this->config.transport == ESitlTransport::udp)
+	{
+		this->socket = FUdpSocket::open(this->config.sensor_port, this->config.address, this->config.motor_port);
+		return this->socket != nullptr;
+	}
+
+	this->region = FSharedMemoryRegion::open(this->config.shared_memory_name);
+	if (this->region == nullptr || this->region->get_size() < sizeof(FSitlSharedMemoryLayout))
+	{
+		this->region = nullptr;
+		return false;
+	}
+
+	const auto* layout = get_layout(this->region);
+	const auto is_valid = layout->magic.load(std::memory_order_acquire) == FSitlSharedMemoryLayout::expected_magic
+		&& layout->version == FSitlSharedMemoryLayout::expected_version;
+
+	if (!is_valid)
+	{
+		this->region = nullptr;
+		return false;
+	}
+
+	// When the simulation is already waiting, its sensors are the next ones received
+	this->received_count = layout->motor_count.load(std::memory_order_acquire);
+
+	return true;
+}
+
+const physics::FSitlSensorPacket* physics::FSitlFirmwareEndpoint::receive_sensors(double timeout_seconds)
+{
+	const auto deadline = get_deadline(timeout_seconds);
+
+	if (this->socket != nullptr)
+	{
+		for (auto remaining_seconds = timeout_seconds; remaining_seconds > 0.0; remaining_seconds = get_remaining_seconds(deadline))
+		{
+			const auto size = this->socket->receive(&this->sensor_packet, sizeof(FSitlSensorPacket), remaining_seconds);
+			if (size == sizeof(FSitlSensorPacket) && this->sensor_packet.magic == FSitlSensorPacket::expected_magic)
+			{
+				this->last_sequence = this->sensor_packet.sequence;
+				return &this->sensor_packet;
+			}
+		}
+		return nullptr;
+	}
+
+	if (this->region == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto* layout = get_layout(this->region);
+	if (!wait_for_count(layout->sensor_count, this->received_count + 1, deadline))
+	{
+		return nullptr;
+	}
+
+	this->received_count = layout->sensor_count.load(std::memory_order_acquire);
+	this->last_sequence = layout->sensors.sequence;
+	return &layout->sensors;
+}
+
+physics::FSitlMotorPacket& physics::FSitlFirmwareEndpoint::get_motor_packet()
+{
+	return this->region != nullptr ? get_layout(this->region)->motors : this->motor_packet;
+}
+
+void physics::FSitlFirmwareEndpoint::send_motors()
+{
+	auto& motors = this->get_motor_packet();
+	motors.magic = FSitlMotorPacket::expected_magic;
+	motors.sequence = this->last_sequence;
+
+	if (this->socket != nullptr)
+	{
+		this->socket->send(&motors, sizeof(FSitlMotorPacket));
+	}
+	else if (this->region != nullptr)
+	{
+		get_layout(this->region)->motor_count.store(static_cast<std::uint64_t>(this->last_sequence) + 1, std::memory_order_release);
+	}
+}
+
+void physics::sitl::fill_sensor_packet(FSitlSensorPacket& packet, const FSubstepBody& substep_body,
+	const FVector3& linear_acceleration_world, const FDronePlayerInput& player_input, bool is_armed, double simulation_time)
+{
+	const auto& rotation = substep_body.transform_world.rotation;
+
+	packet.time_us = static_cast<std::uint64_t>(std::llround(simulation_time * 1e6));
+	packet.angular_velocity = to_array(rotation.unrotate_vector(substep_body.angular_velocity_radians_world));
+
+	// An accelerometer measures everything but gravity
+	packet.specific_force = to_array(rotation.unrotate_vector(linear_acceleration_world + FVector3(0.0, 0.0, gravity)));
+
+	packet.orientation = { rotation.X, rotation.Y, rotation.Z, rotation.W };
+
+	// The transform is in unreal units
+	packet.location_world = to_array(substep_body.transform_world.location / 100.0);
+	packet.linear_velocity_world = to_array(substep_body.linear_velocity_world);
+
+	packet.rc_channels.fill(to_rc_pulse_width(0.0));
+	packet.rc_channels[0] = to_rc_pulse_width(player_input.roll);
+	packet.rc_channels[1] = to_rc_pulse_width(player_input.pitch);
+	packet.rc_channels[2] = to_rc_pulse_width(player_input.throttle * 2.0 - 1.0);
+	packet.rc_channels[3] = to_rc_pulse_width(player_input.yaw);
+	packet.rc_channels[4] = to_rc_pulse_width(is_armed ? 1.0 : -1.0);
+}
+
+std::uint16_t physics::sitl::to_rc_pulse_width(double value)
+{
+	return static_cast<std::uint16_t>(std::lround(1500.0 + 500.0 * math::clamp(value, -1.0, 1.0)));
+}
+
+physics::FRotorSetThrottle physics::sitl::get_rotor_throttle(const FSitlMotorPacket& packet, std::int32_t rotor_count)
+{
+	FRotorSetThrottle throttle;
+	throttle.count = rotor_count;
+
+	const auto motor_count = std::min(static_cast<std::int32_t>(packet.motor_count), std::min(rotor_count, max_rotor_count));
+	for (std::int32_t rotor_index = 0; rotor_index < motor_count; rotor_index++)
+	{
+		throttle.values[rotor_index] = math::clamp(static_cast<double>(packet.motors[rotor_index]), 0.0, 1.0);
+	}
+
+	return throttle;
+}
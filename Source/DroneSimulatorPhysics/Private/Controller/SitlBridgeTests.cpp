@@ -0,0 +1,208 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Public/Controller/SitlBridge.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace
+{
+	constexpr std::int32_t exchange_count = 100;
+
+	// Stands in for the firmware: answers each sensor packet with motors derived from its time
+	void run_echo_firmware(physics::FSitlFirmwareEndpoint& firmware, std::int32_t packet_count)
+	{
+		for (std::int32_t packet = 0; packet < packet_count; packet++)
+		{
+			const auto* sensors = firmware.receive_sensors(5.0);
+			if (sensors == nullptr)
+			{
+				return;
+			}
+
+			auto& motors = firmware.get_motor_packet();
+			motors.motor_count = 4;
+			motors.motors.fill(static_cast<float>(sensors->time_us) * 1e-6f);
+			firmware.send_motors();
+		}
+	}
+
+	void run_lockstep(const physics::FSitlBridgeConfig& config)
+	{
+		physics::FSitlBridge bridge;
+		REQUIRE(bridge.open(config));
+
+		physics::FSitlFirmwareEndpoint firmware;
+		REQUIRE(firmware.open(config));
+
+		std::thread firmware_thread([&] { run_echo_firmware(firmware, exchange_count); });
+
+		for (std::int32_t exchange = 0; exchange < exchange_count; exchange++)
+		{
+			bridge.get_sensor_packet().time_us = static_cast<std::uint64_t>(exchange) * 250;
+
+			const auto* motors = bridge.exchange();
+			REQUIRE(motors != nullptr);
+			CHECK(motors->sequence == static_cast<std::uint32_t>(exchange));
+			CHECK(motors->motors[3] == Approx(exchange * 250e-6));
+		}
+
+		firmware_thread.join();
+
+		const auto& stats = bridge.get_round_trip_stats();
+		CHECK(stats.exchange_count == exchange_count);
+		CHECK(stats.timeout_count == 0);
+		CHECK(stats.get_mean_seconds() > 0.0);
+		CHECK(stats.max_seconds >= stats.get_mean_seconds());
+	}
+}
+
+TEST_CASE("SITL bridge", "[controller][sitl]")
+{
+	physics::FSitlBridgeConfig config;
+	config.sensor_port = 39103;
+	config.motor_port = 39102;
+	config.timeout_seconds = 1.0;
+
+	SECTION("Exchanges in lockstep over UDP")
+	{
+		run_lockstep(config);
+	}
+
+#if !defined(_WIN32)
+	SECTION("Exchanges in lockstep over shared memory")
+	{
+		config.transport = physics::ESitlTransport::shared_memory;
+		config.shared_memory_name = "drone_sitl_test_" + std::to_string(reinterpret_cast<std::uintptr_t>(&config));
+		run_lockstep(config);
+	}
+#endif
+
+	SECTION("Times out without firmware")
+	{
+		config.timeout_seconds = 0.01;
+
+		physics::FSitlBridge bridge;
+		REQUIRE(bridge.open(config));
+
+		CHECK(bridge.exchange() == nullptr);
+		CHECK(bridge.get_round_trip_stats().timeout_count == 1);
+		CHECK(bridge.get_round_trip_stats().exchange_count == 0);
+		CHECK_FALSE(bridge.is_connected());
+	}
+
+	SECTION("Stops waiting for a firmware that is gone, until it answers again")
+	{
+		config.timeout_seconds = 0.05;
+
+		physics::FSitlBridge bridge;
+		REQUIRE(bridge.open(config));
+		CHECK(bridge.exchange() == nullptr);
+		REQUIRE_FALSE(bridge.is_connected());
+
+		// Far less than a timeout each
+		const auto start_time = std::chrono::steady_clock::now();
+		for (std::int32_t exchange = 0; exchange < 100; exchange++)
+		{
+			CHECK(bridge.exchange() == nullptr);
+		}
+		CHECK(std::chrono::steady_clock::now() - start_time < std::chrono::milliseconds(50));
+		CHECK(bridge.get_round_trip_stats().timeout_count == 1);
+
+		// The firmware starts and answers a probe, the bridge connects on the next one
+		physics::FSitlFirmwareEndpoint firmware;
+		REQUIRE(firmware.open(config));
+		CHECK(bridge.exchange() == nullptr);
+		run_echo_firmware(firmware, 1);
+		CHECK(bridge.exchange() == nullptr);
+		REQUIRE(bridge.is_connected());
+
+		// Answers the last probe, which is dropped, then the exchange
+		std::thread firmware_thread([&] { run_echo_firmware(firmware, 2); });
+		const auto* motors = bridge.exchange();
+		firmware_thread.join();
+		REQUIRE(motors != nullptr);
+		CHECK(bridge.get_round_trip_stats().exchange_count == 1);
+	}
+
+#if !defined(_WIN32)
+	SECTION("A late answer to the exchange that timed out doesn't reconnect over shared memory")
+	{
+		config.transport = physics::ESitlTransport::shared_memory;
+		config.shared_memory_name = "drone_sitl_test_" + std::to_string(reinterpret_cast<std::uintptr_t>(&config));
+		config.timeout_seconds = 0.01;
+
+		physics::FSitlBridge bridge;
+		REQUIRE(bridge.open(config));
+		physics::FSitlFirmwareEndpoint firmware;
+		REQUIRE(firmware.open(config));
+
+		CHECK(bridge.exchange() == nullptr);
+		REQUIRE_FALSE(bridge.is_connected());
+
+		// Answers the exchange that timed out, then the probe sees it
+		run_echo_firmware(firmware, 1);
+		CHECK(bridge.exchange() == nullptr);
+		CHECK_FALSE(bridge.is_connected());
+
+		// Answers that probe, the next one sees it
+		run_echo_firmware(firmware, 1);
+		CHECK(bridge.exchange() == nullptr);
+		CHECK(bridge.is_connected());
+	}
+#endif
+
+	SECTION("Fills the IMU and the RC channels")
+	{
+		physics::FSubstepBody body;
+		body.transform_world = physics::FRigidTransform(physics::FQuaternion::identity(), physics::FVector3(100.0, 0.0, 250.0));
+		body.angular_velocity_radians_world = physics::FVector3(0.5, 0.0, -1.0);
+
+		physics::FDronePlayerInput input;
+		input.throttle = 0.25;
+		input.roll = 1.0;
+		input.pitch = -0.5;
+
+		physics::FSitlSensorPacket packet;
+		physics::sitl::fill_sensor_packet(packet, body, physics::FVector3::zero(), input, true, 0.0125);
+
+		CHECK(packet.time_us == 12500);
+		CHECK(packet.angular_velocity[0] == Approx(0.5));
+		CHECK(packet.angular_velocity[2] == Approx(-1.0));
+
+		// Hovering: the accelerometer reads gravity, pointing up
+		CHECK(packet.specific_force[2] == Approx(9.81));
+		CHECK(packet.location_world[0] == Approx(1.0));
+		CHECK(packet.location_world[2] == Approx(2.5));
+
+		CHECK(packet.rc_channels[0] == 2000);
+		CHECK(packet.rc_channels[1] == 1250);
+		CHECK(packet.rc_channels[2] == 1250);
+		CHECK(packet.rc_channels[3] == 1500);
+		CHECK(packet.rc_channels[4] == 2000);
+		CHECK(packet.rc_channels[7] == 1500);
+	}
+
+	SECTION("Maps the motors to the rotors")
+	{
+		physics::FSitlMotorPacket packet;
+		packet.motor_count = 3;
+		packet.motors = { 0.5f, 1.5f, -0.5f, 0.75f };
+
+		const auto throttle = physics::sitl::get_rotor_throttle(packet, 4);
+		CHECK(throttle.count == 4);
+		CHECK(throttle.values[0] == Approx(0.5));
+		CHECK(throttle.values[1] == 1.0);
+		CHECK(throttle.values[2] == 0.0);
+
+		// Not in the packet
+		CHECK(throttle.values[3] == 0.0);
+	}
+}
+
+#endif
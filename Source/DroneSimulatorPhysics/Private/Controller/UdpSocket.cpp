@@ -0,0 +1,125 @@
+#include "DroneSimulatorPhysics/Private/Controller/UdpSocket.h"
+
+#include <cmath>
+#include <type_traits>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#if defined(_WIN32)
+	using socket_handle = SOCKET;
+	using socket_length = int;
+
+	bool is_valid(socket_handle handle) { return handle != INVALID_SOCKET; }
+
+	void close_socket(socket_handle handle) { closesocket(handle); }
+
+	int poll_sockets(pollfd* descriptors, int timeout_milliseconds) { return WSAPoll(descriptors, 1, timeout_milliseconds); }
+
+	bool start_sockets()
+	{
+		// Reference counted by Winsock, every socket keeps it started
+		WSADATA data;
+		return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+	}
+
+	void stop_sockets() { WSACleanup(); }
+#else
+	using socket_handle = int;
+	using socket_length = socklen_t;
+
+	bool is_valid(socket_handle handle) { return handle >= 0; }
+
+	void close_socket(socket_handle handle) { close(handle); }
+
+	int poll_sockets(pollfd* descriptors, int timeout_milliseconds) { return poll(descriptors, 1, timeout_milliseconds); }
+
+	bool start_sockets() { return true; }
+
+	void stop_sockets() {}
+#endif
+}
+
+std::unique_ptr<physics::FUdpSocket> physics::FUdpSocket::open(std::uint16_t local_port, const std::string& remote_address,
+	std::uint16_t remote_port)
+{
+	in_addr remote = {};
+	if (inet_pton(AF_INET, remote_address.c_str(), &remote) != 1 || !start_sockets())
+	{
+		return nullptr;
+	}
+
+	const auto handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (!is_valid(handle))
+	{
+		stop_sockets();
+		return nullptr;
+	}
+
+	sockaddr_in local = {};
+	local.sin_family = AF_INET;
+	local.sin_addr.s_addr = htonl(INADDR_ANY);
+	local.sin_port = htons(local_port);
+	if (bind(handle, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0)
+	{
+		close_socket(handle);
+		stop_sockets();
+		return nullptr;
+	}
+
+	auto udp_socket = std::unique_ptr<FUdpSocket>(new FUdpSocket());
+	udp_socket->handle = static_cast<std::intptr_t>(handle);
+	udp_socket->remote_address = remote.s_addr;
+	udp_socket->remote_port = htons(remote_port);
+	return udp_socket;
+}
+
+physics::FUdpSocket::~FUdpSocket()
+{
+	if (this->handle != -1)
+	{
+		close_socket(static_cast<socket_handle>(this->handle));
+		stop_sockets();
+	}
+}
+
+bool physics::FUdpSocket::send(const void* data, std::size_t size)
+{
+	// Not connected: on a connected socket, sending before the other side is bound makes the next receive fail
+	sockaddr_in remote = {};
+	remote.sin_family = AF_INET;
+	remote.sin_addr.s_addr = this->remote_address;
+	remote.sin_port = this->remote_port;
+
+	const auto sent_size = sendto(static_cast<socket_handle>(this->handle), static_cast<const char*>(data), static_cast<int>(size), 0,
+		reinterpret_cast<const sockaddr*>(&remote), static_cast<socket_length>(sizeof(remote)));
+	return sent_size == static_cast<std::remove_const_t<decltype(sent_size)>>(size);
+}
+
+std::int64_t physics::FUdpSocket::receive(void* data, std::size_t size, double timeout_seconds)
+{
+	pollfd descriptor = {};
+	descriptor.fd = static_cast<socket_handle>(this->handle);
+	descriptor.events = POLLIN;
+
+	const auto timeout_milliseconds = static_cast<int>(std::ceil(timeout_seconds * 1000.0));
+	if (poll_sockets(&descriptor, timeout_milliseconds) <= 0)
+	{
+		return -1;
+	}
+
+	const auto received_size = recv(static_cast<socket_handle>(this->handle), static_cast<char*>(data), static_cast<int>(size), 0);
+	return received_size < 0 ? -1 : static_cast<std::int64_t>(received_size);
+}
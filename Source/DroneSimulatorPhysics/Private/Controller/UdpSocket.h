@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace physics
+{
+	/**
+	 * UDP socket bound to a local port, sending to a fixed remote endpoint: BSD sockets, or Winsock on Windows.
+	 */
+	class FUdpSocket
+	{
+	public:
+
+		/**
+		 * Binds local_port on all interfaces, then sends to remote_address:remote_port.
+		 * @return nullptr if the socket could not be created or bound
+		 */
+		static std::unique_ptr<FUdpSocket> open(std::uint16_t local_port, const std::string& remote_address, std::uint16_t remote_port);
+
+		~FUdpSocket();
+
+		FUdpSocket(const FUdpSocket&) = delete;
+		FUdpSocket& operator=(const FUdpSocket&) = delete;
+
+		bool send(const void* data, std::size_t size);
+
+		/**
+		 * Waits for the next datagram, for up to timeout_seconds.
+		 * @return Its size, or -1 on timeout or error. Longer datagrams are truncated to size.
+		 */
+		std::int64_t receive(void* data, std::size_t size, double timeout_seconds);
+
+	private:
+
+		FUdpSocket() = default;
+
+		// SOCKET on Windows, file descriptor elsewhere
+		std::intptr_t handle = -1;
+
+		// Remote endpoint, as a sockaddr_in
+		std::uint32_t remote_address = 0;
+
+		std::uint16_t remote_port = 0;
+	};
+}
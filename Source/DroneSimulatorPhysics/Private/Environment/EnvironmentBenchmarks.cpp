@@ -0,0 +1,38 @@
+#if WITH_DRONE_PHYSICS_BENCHMARKS
+
+#include "DroneSimulatorPhysics/Private/Simulation/TestDrone.h"
+#include "DroneSimulatorPhysics/Public/Environment/VectorizedEnvironment.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+// One step (8 substeps at 400Hz) of many simplified drones. Arguments are the number of environments and of threads.
+static void BM_VectorizedStep(benchmark::State& state)
+{
+	const auto num_envs = static_cast<std::int32_t>(state.range(0));
+	const auto num_threads = static_cast<std::int32_t>(state.range(1));
+
+	physics::FVectorizedEnvironmentConfig config;
+	config.drone = physics::test_drone::make_simulation();
+	config.drone.reset_body(physics::FVector3(0.0, 0.0, 100000.0), physics::FQuaternion::identity());
+
+	physics::FVectorizedEnvironment environment(config, num_envs, num_threads);
+
+	std::vector<float> actions(physics::environment_action_count * num_envs, 0.5f);
+	std::vector<float> observations(physics::environment_observation_count * num_envs);
+	std::vector<float> rewards(num_envs);
+	std::vector<std::uint8_t> dones(num_envs);
+	environment.reset_all(observations.data());
+
+	for (auto _ : state)
+	{
+		environment.step(actions.data(), observations.data(), rewards.data(), dones.data());
+		benchmark::DoNotOptimize(observations.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * num_envs);
+}
+BENCHMARK(BM_VectorizedStep)->Args({ 1024, 1 })->Args({ 1024, 4 })->UseRealTime();
+
+#endif
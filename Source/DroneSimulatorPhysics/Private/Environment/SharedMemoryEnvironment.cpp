@@ -0,0 +1,213 @@
+#include "DroneSimulatorPhysics/Public/Environment/SharedMemoryEnvironment.h"
+#include "DroneSimulatorPhysics/Public/Environment/VectorizedEnvironment.h"
+#include "DroneSimulatorPhysics/Private/Environment/SharedMemoryRegion.h"
+
+#include <new>
+#include <thread>
+
+namespace
+{
+	constexpr std::uint64_t buffer_alignment = 64;
+
+	std::uint64_t align_up(std::uint64_t value)
+	{
+		return (value + buffer_alignment - 1) / buffer_alignment * buffer_alignment;
+	}
+
+	// The slots fit in the region, and the buffers of the header in a slot
+	bool does_layout_fit(const physics::FSharedEnvironmentHeader& header, std::uint64_t region_size)
+	{
+		if (header.slot_count <= 0 || header.num_envs < 0 || header.slots_offset < sizeof(physics::FSharedEnvironmentHeader)
+			|| header.slots_offset > region_size)
+		{
+			return false;
+		}
+
+		const auto num_envs = static_cast<std::uint64_t>(header.num_envs);
+		const auto slot_count = static_cast<std::uint64_t>(header.slot_count);
+		const auto are_buffers_in_slot = header.actions_offset >= sizeof(std::uint32_t)
+			&& header.actions_offset + num_envs * physics::environment_action_count * sizeof(float) <= header.observations_offset
+			&& header.observations_offset + num_envs * physics::environment_observation_count * sizeof(float) <= header.rewards_offset
+			&& header.rewards_offset + num_envs * sizeof(float) <= header.dones_offset
+			&& header.dones_offset + num_envs * sizeof(std::uint8_t) <= header.slot_size;
+
+		return are_buffers_in_slot && header.slot_size <= (region_size - header.slots_offset) / slot_count;
+	}
+
+	physics::FSharedEnvironmentSlot get_slot_at(void* region_data, std::uint64_t sequence)
+	{
+		auto* header = static_cast<physics::FSharedEnvironmentHeader*>(region_data);
+		auto* slot_data = static_cast<std::uint8_t*>(region_data) + header->slots_offset
+			+ (sequence % static_cast<std::uint64_t>(header->slot_count)) * header->slot_size;
+
+		return physics::FSharedEnvironmentSlot {
+			reinterpret_cast<std::uint32_t*>(slot_data),
+			reinterpret_cast<float*>(slot_data + header->actions_offset),
+			reinterpret_cast<float*>(slot_data + header->observations_offset),
+			reinterpret_cast<float*>(slot_data + header->rewards_offset),
+			slot_data + header->dones_offset,
+		};
+	}
+}
+
+physics::FSharedMemoryEnvironmentServer::FSharedMemoryEnvironmentServer(FVectorizedEnvironment& in_environment)
+	: environment(in_environment)
+{
+}
+
+physics::FSharedMemoryEnvironmentServer::~FSharedMemoryEnvironmentServer() = default;
+
+bool physics::FSharedMemoryEnvironmentServer::create(const std::string& name, std::int32_t slot_count)
+{
+	// Requests are spread over the slots by their sequence modulo slot_count
+	if (slot_count <= 0)
+	{
+		return false;
+	}
+
+	const auto num_envs = static_cast<std::uint64_t>(this->environment.get_num_envs());
+
+	FSharedEnvironmentHeader layout;
+	layout.num_envs = this->environment.get_num_envs();
+	layout.action_count = environment_action_count;
+	layout.observation_count = environment_observation_count;
+	layout.slot_count = slot_count;
+	layout.slots_offset = align_up(sizeof(FSharedEnvironmentHeader));
+	layout.actions_offset = align_up(sizeof(std::uint32_t));
+	layout.observations_offset = align_up(layout.actions_offset + num_envs * environment_action_count * sizeof(float));
+	layout.rewards_offset = align_up(layout.observations_offset + num_envs * environment_observation_count * sizeof(float));
+	layout.dones_offset = align_up(layout.rewards_offset + num_envs * sizeof(float));
+	layout.slot_size = align_up(layout.dones_offset + num_envs * sizeof(std::uint8_t));
+
+	this->region = FSharedMemoryRegion::create(name, layout.slots_offset + layout.slot_size * slot_count);
+	if (this->region == nullptr)
+	{
+		return false;
+	}
+
+	auto* header = new (this->region->get_data()) FSharedEnvironmentHeader();
+	header->num_envs = layout.num_envs;
+	header->action_count = layout.action_count;
+	header->observation_count = layout.observation_count;
+	header->slot_count = layout.slot_count;
+	header->slots_offset = layout.slots_offset;
+	header->slot_size = layout.slot_size;
+	header->actions_offset = layout.actions_offset;
+	header->observations_offset = layout.observations_offset;
+	header->rewards_offset = layout.rewards_offset;
+	header->dones_offset = layout.dones_offset;
+	header->submitted_count.store(0, std::memory_order_relaxed);
+	header->completed_count.store(0, std::memory_order_relaxed);
+	header->version = FSharedEnvironmentHeader::expected_version;
+
+	// The magic is written last, a client that sees it sees a complete header
+	header->magic.store(FSharedEnvironmentHeader::expected_magic, std::memory_order_release);
+
+	return true;
+}
+
+std::int32_t physics::FSharedMemoryEnvironmentServer::poll()
+{
+	if (this->region == nullptr)
+	{
+		return 0;
+	}
+
+	auto* header = static_cast<FSharedEnvironmentHeader*>(this->region->get_data());
+	const auto submitted_count = header->submitted_count.load(std::memory_order_acquire);
+	auto completed_count = header->completed_count.load(std::memory_order_relaxed);
+
+	std::int32_t request_count = 0;
+	for (; completed_count < submitted_count; completed_count++)
+	{
+		const auto slot = get_slot_at(header, completed_count);
+
+		if (static_cast<ESharedEnvironmentCommand>(*slot.command) == ESharedEnvironmentCommand::reset_all)
+		{
+			this->environment.reset_all(slot.observations);
+		}
+		else
+		{
+			this->environment.step(slot.actions, slot.observations, slot.rewards, slot.dones);
+		}
+
+		header->completed_count.store(completed_count + 1, std::memory_order_release);
+		request_count++;
+	}
+
+	return request_count;
+}
+
+void physics::FSharedMemoryEnvironmentServer::serve(const std::atomic<bool>& should_stop)
+{
+	while (!should_stop.load(std::memory_order_relaxed))
+	{
+		if (this->poll() == 0)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+physics::FSharedMemoryEnvironmentClient::FSharedMemoryEnvironmentClient() = default;
+
+physics::FSharedMemoryEnvironmentClient::~FSharedMemoryEnvironmentClient() = default;
+
+bool physics::FSharedMemoryEnvironmentClient::open(const std::string& name)
+{
+	this->region = FSharedMemoryRegion::open(name);
+	if (this->region == nullptr || this->region->get_size() < sizeof(FSharedEnvironmentHeader))
+	{
+		this->region = nullptr;
+		return false;
+	}
+
+	// The magic is read first, seeing it means seeing the complete header
+	const auto& header = this->get_header();
+	const auto is_valid = header.magic.load(std::memory_order_acquire) == FSharedEnvironmentHeader::expected_magic
+		&& header.version == FSharedEnvironmentHeader::expected_version
+		&& header.action_count == environment_action_count
+		&& header.observation_count == environment_observation_count
+		&& does_layout_fit(header, this->region->get_size());
+
+	if (!is_valid)
+	{
+		this->region = nullptr;
+	}
+
+	return is_valid;
+}
+
+const physics::FSharedEnvironmentHeader& physics::FSharedMemoryEnvironmentClient::get_header() const
+{
+	return *static_cast<const FSharedEnvironmentHeader*>(this->region->get_data());
+}
+
+physics::FSharedEnvironmentSlot physics::FSharedMemoryEnvironmentClient::get_next_slot() const
+{
+	return this->get_slot(this->get_header().submitted_count.load(std::memory_order_relaxed));
+}
+
+std::uint64_t physics::FSharedMemoryEnvironmentClient::submit(ESharedEnvironmentCommand command)
+{
+	auto* header = static_cast<FSharedEnvironmentHeader*>(this->region->get_data());
+	const auto sequence = header->submitted_count.load(std::memory_order_relaxed);
+
+	*get_slot_at(header, sequence).command = static_cast<std::uint32_t>(command);
+	header->submitted_count.store(sequence + 1, std::memory_order_release);
+
+	return sequence;
+}
+
+void physics::FSharedMemoryEnvironmentClient::wait(std::uint64_t sequence) const
+{
+	while (this->get_header().completed_count.load(std::memory_order_acquire) <= sequence)
+	{
+		std::this_thread::yield();
+	}
+}
+
+physics::FSharedEnvironmentSlot physics::FSharedMemoryEnvironmentClient::get_slot(std::uint64_t sequence) const
+{
+	return get_slot_at(this->region->get_data(), sequence);
+}
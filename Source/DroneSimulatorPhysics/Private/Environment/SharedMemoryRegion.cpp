@@ -0,0 +1,167 @@
+#include "DroneSimulatorPhysics/Private/Environment/SharedMemoryRegion.h"
+
+#include <cstdint>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+
+std::unique_ptr<physics::FSharedMemoryRegion> physics::FSharedMemoryRegion::create(const std::string& name, std::size_t size)
+{
+	const auto mapping_name = "Local\\" + name;
+	auto* handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<std::uint64_t>(size) >> 32),
+		static_cast<DWORD>(size & 0xFFFFFFFF), mapping_name.c_str());
+	if (handle == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto* data = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	if (data == nullptr)
+	{
+		CloseHandle(handle);
+		return nullptr;
+	}
+
+	auto region = std::unique_ptr<FSharedMemoryRegion>(new FSharedMemoryRegion());
+	region->name = name;
+	region->data = data;
+	region->size = size;
+	region->is_owner = true;
+	region->handle = handle;
+	return region;
+}
+
+std::unique_ptr<physics::FSharedMemoryRegion> physics::FSharedMemoryRegion::open(const std::string& name)
+{
+	const auto mapping_name = "Local\\" + name;
+	auto* handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mapping_name.c_str());
+	if (handle == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto* data = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+	if (data == nullptr)
+	{
+		CloseHandle(handle);
+		return nullptr;
+	}
+
+	MEMORY_BASIC_INFORMATION info;
+	VirtualQuery(data, &info, sizeof(info));
+
+	auto region = std::unique_ptr<FSharedMemoryRegion>(new FSharedMemoryRegion());
+	region->name = name;
+	region->data = data;
+	region->size = info.RegionSize;
+	region->handle = handle;
+	return region;
+}
+
+physics::FSharedMemoryRegion::~FSharedMemoryRegion()
+{
+	if (this->data != nullptr)
+	{
+		UnmapViewOfFile(this->data);
+	}
+
+	if (this->handle != nullptr)
+	{
+		CloseHandle(this->handle);
+	}
+}
+
+#else
+
+std::unique_ptr<physics::FSharedMemoryRegion> physics::FSharedMemoryRegion::create(const std::string& name, std::size_t size)
+{
+	const auto shm_name = "/" + name;
+
+	// A region left over by a crashed server would have the wrong size
+	shm_unlink(shm_name.c_str());
+
+	const int file_descriptor = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (file_descriptor < 0)
+	{
+		return nullptr;
+	}
+
+	if (ftruncate(file_descriptor, static_cast<off_t>(size)) != 0)
+	{
+		close(file_descriptor);
+		shm_unlink(shm_name.c_str());
+		return nullptr;
+	}
+
+	auto* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+	close(file_descriptor);
+	if (data == MAP_FAILED)
+	{
+		shm_unlink(shm_name.c_str());
+		return nullptr;
+	}
+
+	auto region = std::unique_ptr<FSharedMemoryRegion>(new FSharedMemoryRegion());
+	region->name = shm_name;
+	region->data = data;
+	region->size = size;
+	region->is_owner = true;
+	return region;
+}
+
+std::unique_ptr<physics::FSharedMemoryRegion> physics::FSharedMemoryRegion::open(const std::string& name)
+{
+	const auto shm_name = "/" + name;
+
+	const int file_descriptor = shm_open(shm_name.c_str(), O_RDWR, 0600);
+	if (file_descriptor < 0)
+	{
+		return nullptr;
+	}
+
+	struct stat file_stat;
+	if (fstat(file_descriptor, &file_stat) != 0 || file_stat.st_size <= 0)
+	{
+		close(file_descriptor);
+		return nullptr;
+	}
+
+	const auto size = static_cast<std::size_t>(file_stat.st_size);
+	auto* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+	close(file_descriptor);
+	if (data == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	auto region = std::unique_ptr<FSharedMemoryRegion>(new FSharedMemoryRegion());
+	region->name = shm_name;
+	region->data = data;
+	region->size = size;
+	return region;
+}
+
+physics::FSharedMemoryRegion::~FSharedMemoryRegion()
+{
+	if (this->data != nullptr)
+	{
+		munmap(this->data, this->size);
+	}
+
+	if (this->is_owner)
+	{
+		shm_unlink(this->name.c_str());
+	}
+}
+
+#endif
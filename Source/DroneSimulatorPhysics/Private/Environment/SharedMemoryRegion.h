@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace physics
+{
+	/**
+	 * Named memory region shared between processes: POSIX shared memory, or a pagefile-backed mapping on Windows.
+	 */
+	class FSharedMemoryRegion
+	{
+	public:
+
+		// Creates the region, and removes its name when destroyed
+		static std::unique_ptr<FSharedMemoryRegion> create(const std::string& name, std::size_t size);
+
+		// Maps a region created by another process
+		static std::unique_ptr<FSharedMemoryRegion> open(const std::string& name);
+
+		~FSharedMemoryRegion();
+
+		FSharedMemoryRegion(const FSharedMemoryRegion&) = delete;
+		FSharedMemoryRegion& operator=(const FSharedMemoryRegion&) = delete;
+
+		void* get_data() const { return this->data; }
+
+		std::size_t get_size() const { return this->size; }
+
+	private:
+
+		FSharedMemoryRegion() = default;
+
+		std::string name;
+
+		void* data = nullptr;
+
+		std::size_t size = 0;
+
+		bool is_owner = false;
+
+		// Mapping handle on Windows
+		void* handle = nullptr;
+	};
+}
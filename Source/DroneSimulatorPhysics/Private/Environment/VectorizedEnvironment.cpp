@@ -0,0 +1,186 @@
+#include "DroneSimulatorPhysics/Public/Environment/VectorizedEnvironment.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SimulationBatch.h"
+#include "DroneSimulatorPhysics/Private/Environment/WorkerPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+	// Stay at the spawn location, without spinning. Location is in unreal units.
+	float compute_hover_reward(const physics::FDroneSimulation& drone, const physics::FVector3& spawn_location)
+	{
+		const auto distance_m = (drone.body.transform_world.location - spawn_location).size() / 100.0;
+		const auto angular_speed = drone.body.angular_velocity_radians_world.size();
+		return static_cast<float>(-distance_m - 0.05 * angular_speed);
+	}
+
+	std::int32_t resolve_num_threads(std::int32_t num_threads)
+	{
+		if (num_threads > 0)
+		{
+			return num_threads;
+		}
+
+		return std::max(1, static_cast<std::int32_t>(std::thread::hardware_concurrency()));
+	}
+}
+
+physics::FVectorizedEnvironment::FVectorizedEnvironment(FVectorizedEnvironmentConfig in_config, std::int32_t in_num_envs,
+	std::int32_t num_threads)
+	: config(std::move(in_config))
+	, num_envs(in_num_envs)
+	, drones(in_num_envs, this->config.drone)
+	, episode_steps(in_num_envs, 0)
+	, reset_counters(in_num_envs, 0)
+	, worker_pool(std::make_unique<FWorkerPool>(std::min(resolve_num_threads(num_threads), std::max(1, in_num_envs))))
+{
+	if (!this->config.reward_function)
+	{
+		this->config.reward_function = compute_hover_reward;
+	}
+}
+
+physics::FVectorizedEnvironment::~FVectorizedEnvironment() = default;
+
+void physics::FVectorizedEnvironment::step(const float* actions, float* observations, float* rewards, std::uint8_t* dones)
+{
+	this->worker_pool->parallel_for(this->num_envs, [&](std::int32_t begin, std::int32_t end)
+	{
+		this->step_range(begin, end, actions, observations, rewards, dones);
+	});
+}
+
+void physics::FVectorizedEnvironment::reset_all(float* observations)
+{
+	this->worker_pool->parallel_for(this->num_envs, [&](std::int32_t begin, std::int32_t end)
+	{
+		for (auto env_index = begin; env_index < end; env_index++)
+		{
+			this->reset(env_index);
+			this->write_observation(env_index, observations);
+		}
+	});
+}
+
+void physics::FVectorizedEnvironment::reset(std::int32_t env_index)
+{
+	if (this->reset_snapshots.empty())
+	{
+		this->reset_from_snapshot(env_index, this->config.drone);
+		return;
+	}
+
+	const auto snapshot_index = (env_index + this->reset_counters[env_index]++) % this->reset_snapshots.size();
+	this->reset_from_snapshot(env_index, this->reset_snapshots[snapshot_index]);
+}
+
+void physics::FVectorizedEnvironment::reset_from_snapshot(std::int32_t env_index, const FDroneSimulation& snapshot)
+{
+	this->drones[env_index] = snapshot;
+	this->episode_steps[env_index] = 0;
+}
+
+void physics::FVectorizedEnvironment::set_reset_snapshots(std::vector<FDroneSimulation> snapshots)
+{
+	this->reset_snapshots = std::move(snapshots);
+}
+
+void physics::FVectorizedEnvironment::write_observations(float* observations) const
+{
+	for (std::int32_t env_index = 0; env_index < this->num_envs; env_index++)
+	{
+		this->write_observation(env_index, observations);
+	}
+}
+
+std::int32_t physics::FVectorizedEnvironment::count_asleep() const
+{
+	std::int32_t num_asleep = 0;
+	for (const auto& drone : this->drones)
+	{
+		num_asleep += drone.sleep_state.is_asleep ? 1 : 0;
+	}
+	return num_asleep;
+}
+
+void physics::FVectorizedEnvironment::step_range(std::int32_t begin, std::int32_t end, const float* actions, float* observations,
+	float* rewards, std::uint8_t* dones)
+{
+	const auto get_action = [this, actions](EEnvironmentAction action, std::int32_t env_index)
+	{
+		return static_cast<double>(actions[static_cast<std::int32_t>(action) * this->num_envs + env_index]);
+	};
+
+	const auto spawn_location = this->config.drone.body.transform_world.location;
+
+	// Reused by the steps that run on this thread
+	thread_local FSimulationBatch batch;
+	thread_local std::vector<FDronePlayerInput> player_inputs;
+	thread_local std::vector<std::int32_t> substep_counts;
+
+	player_inputs.clear();
+	substep_counts.clear();
+
+	for (auto env_index = begin; env_index < end; env_index++)
+	{
+		player_inputs.push_back(FDronePlayerInput {
+			get_action(EEnvironmentAction::throttle, env_index),
+			get_action(EEnvironmentAction::yaw, env_index),
+			get_action(EEnvironmentAction::pitch, env_index),
+			get_action(EEnvironmentAction::roll, env_index),
+		});
+
+		const auto tick_rate_hz = this->drones[env_index].tick_rate_hz;
+		substep_counts.push_back(std::max(1, static_cast<std::int32_t>(std::lround(this->config.step_duration * tick_rate_hz))));
+	}
+
+	// The flight modes and controllers of the range run as batched kernels
+	simulation_batch::advance_substeps(std::span(this->drones.data() + begin, end - begin), substep_counts, player_inputs, batch);
+
+	for (auto env_index = begin; env_index < end; env_index++)
+	{
+		auto& drone = this->drones[env_index];
+		this->episode_steps[env_index]++;
+
+		rewards[env_index] = this->config.reward_function(drone, spawn_location);
+
+		const auto is_done = this->episode_steps[env_index] >= this->config.max_episode_steps
+			|| drone.body.transform_world.location.Z < this->config.min_altitude;
+		dones[env_index] = is_done ? 1 : 0;
+
+		if (is_done)
+		{
+			this->reset(env_index);
+		}
+
+		this->write_observation(env_index, observations);
+	}
+}
+
+void physics::FVectorizedEnvironment::write_observation(std::int32_t env_index, float* observations) const
+{
+	const auto& body = this->drones[env_index].body;
+	const auto location_m = (body.transform_world.location - this->config.drone.body.transform_world.location) / 100.0;
+	const auto& rotation = body.transform_world.rotation;
+
+	const auto set_observation = [this, env_index, observations](EEnvironmentObservation observation, double value)
+	{
+		observations[static_cast<std::int32_t>(observation) * this->num_envs + env_index] = static_cast<float>(value);
+	};
+
+	set_observation(EEnvironmentObservation::location_x, location_m.X);
+	set_observation(EEnvironmentObservation::location_y, location_m.Y);
+	set_observation(EEnvironmentObservation::location_z, location_m.Z);
+	set_observation(EEnvironmentObservation::rotation_x, rotation.X);
+	set_observation(EEnvironmentObservation::rotation_y, rotation.Y);
+	set_observation(EEnvironmentObservation::rotation_z, rotation.Z);
+	set_observation(EEnvironmentObservation::rotation_w, rotation.W);
+	set_observation(EEnvironmentObservation::linear_velocity_x, body.linear_velocity_world.X);
+	set_observation(EEnvironmentObservation::linear_velocity_y, body.linear_velocity_world.Y);
+	set_observation(EEnvironmentObservation::linear_velocity_z, body.linear_velocity_world.Z);
+	set_observation(EEnvironmentObservation::angular_velocity_x, body.angular_velocity_radians_world.X);
+	set_observation(EEnvironmentObservation::angular_velocity_y, body.angular_velocity_radians_world.Y);
+	set_observation(EEnvironmentObservation::angular_velocity_z, body.angular_velocity_radians_world.Z);
+}
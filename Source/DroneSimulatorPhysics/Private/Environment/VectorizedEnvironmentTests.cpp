@@ -0,0 +1,152 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Private/Environment/SharedMemoryRegion.h"
+#include "DroneSimulatorPhysics/Private/Simulation/TestDrone.h"
+#include "DroneSimulatorPhysics/Public/Environment/SharedMemoryEnvironment.h"
+#include "DroneSimulatorPhysics/Public/Environment/VectorizedEnvironment.h"
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	physics::FVectorizedEnvironmentConfig make_test_config()
+	{
+		physics::FVectorizedEnvironmentConfig config;
+		config.drone = physics::test_drone::make_simulation();
+		config.max_episode_steps = 20;
+		return config;
+	}
+
+	// Each environment gets a different throttle, so that their trajectories differ
+	std::vector<float> make_test_actions(std::int32_t num_envs)
+	{
+		std::vector<float> actions(physics::environment_action_count * num_envs, 0.0f);
+		for (std::int32_t env_index = 0; env_index < num_envs; env_index++)
+		{
+			actions[static_cast<std::int32_t>(physics::EEnvironmentAction::throttle) * num_envs + env_index] =
+				static_cast<float>(env_index) / num_envs;
+		}
+		return actions;
+	}
+
+	std::vector<float> run_test_steps(std::int32_t num_envs, std::int32_t num_threads, std::int32_t num_steps)
+	{
+		physics::FVectorizedEnvironment environment(make_test_config(), num_envs, num_threads);
+		const auto actions = make_test_actions(num_envs);
+
+		std::vector<float> observations(physics::environment_observation_count * num_envs);
+		std::vector<float> rewards(num_envs);
+		std::vector<std::uint8_t> dones(num_envs);
+
+		environment.reset_all(observations.data());
+		for (std::int32_t step = 0; step < num_steps; step++)
+		{
+			environment.step(actions.data(), observations.data(), rewards.data(), dones.data());
+		}
+
+		return observations;
+	}
+}
+
+TEST_CASE("Vectorized environment", "[environment]")
+{
+	constexpr std::int32_t num_envs = 16;
+	const auto location_z_row = static_cast<std::int32_t>(physics::EEnvironmentObservation::location_z) * num_envs;
+
+	SECTION("Thread count doesn't change the result")
+	{
+		REQUIRE(run_test_steps(num_envs, 1, 10) == run_test_steps(num_envs, 4, 10));
+	}
+
+	SECTION("Higher throttle climbs higher")
+	{
+		const auto observations = run_test_steps(num_envs, 2, 10);
+		REQUIRE(observations[location_z_row + num_envs - 1] > observations[location_z_row]);
+	}
+
+	SECTION("Episodes end and reset from the snapshots")
+	{
+		auto config = make_test_config();
+		auto snapshot = config.drone;
+		snapshot.body.transform_world.location.Z += 500.0;
+
+		physics::FVectorizedEnvironment environment(config, num_envs, 2);
+		environment.set_reset_snapshots({ snapshot });
+
+		const auto actions = make_test_actions(num_envs);
+		std::vector<float> observations(physics::environment_observation_count * num_envs);
+		std::vector<float> rewards(num_envs);
+		std::vector<std::uint8_t> dones(num_envs);
+
+		environment.reset_all(observations.data());
+		REQUIRE(observations[location_z_row] == Approx(5.0));
+
+		for (std::int32_t step = 0; step < config.max_episode_steps; step++)
+		{
+			environment.step(actions.data(), observations.data(), rewards.data(), dones.data());
+		}
+
+		REQUIRE(dones[0] == 1);
+		REQUIRE(environment.get_episode_step(0) == 0);
+		REQUIRE(observations[location_z_row] == Approx(5.0));
+	}
+
+#if !defined(_WIN32)
+	SECTION("Shared memory round trip")
+	{
+		physics::FVectorizedEnvironment environment(make_test_config(), num_envs, 1);
+		physics::FSharedMemoryEnvironmentServer server(environment);
+		const auto name = "drone_physics_test_" + std::to_string(reinterpret_cast<std::uintptr_t>(&environment));
+		REQUIRE(server.create(name));
+
+		physics::FSharedMemoryEnvironmentClient client;
+		REQUIRE(client.open(name));
+		REQUIRE(client.get_header().num_envs == num_envs);
+
+		std::atomic<bool> should_stop = false;
+		std::thread server_thread([&] { server.serve(should_stop); });
+
+		client.wait(client.submit(physics::ESharedEnvironmentCommand::reset_all));
+
+		const auto actions = make_test_actions(num_envs);
+		std::uint64_t sequence = 0;
+		for (std::int32_t step = 0; step < 10; step++)
+		{
+			const auto slot = client.get_next_slot();
+			std::copy(actions.begin(), actions.end(), slot.actions);
+			sequence = client.submit(physics::ESharedEnvironmentCommand::step);
+			client.wait(sequence);
+		}
+
+		should_stop = true;
+		server_thread.join();
+
+		const auto slot = client.get_slot(sequence);
+		const auto expected = run_test_steps(num_envs, 1, 10);
+		REQUIRE(std::vector<float>(slot.observations, slot.observations + expected.size()) == expected);
+	}
+
+	SECTION("Shared memory layouts that don't fit are rejected")
+	{
+		physics::FVectorizedEnvironment environment(make_test_config(), num_envs, 1);
+		physics::FSharedMemoryEnvironmentServer server(environment);
+		const auto name = "drone_physics_test_" + std::to_string(reinterpret_cast<std::uintptr_t>(&environment));
+		REQUIRE_FALSE(server.create(name, 0));
+		REQUIRE(server.create(name));
+
+		// A header claiming more slots than the region holds
+		const auto region = physics::FSharedMemoryRegion::open(name);
+		REQUIRE(region != nullptr);
+		static_cast<physics::FSharedEnvironmentHeader*>(region->get_data())->slot_count = 3;
+
+		physics::FSharedMemoryEnvironmentClient client;
+		REQUIRE_FALSE(client.open(name));
+	}
+#endif
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "DroneSimulatorPhysics/Private/Environment/WorkerPool.h"
+
+#include <algorithm>
+
+physics::FWorkerPool::FWorkerPool(std::int32_t num_threads)
+{
+	for (std::int32_t worker_index = 1; worker_index < num_threads; worker_index++)
+	{
+		this->threads.emplace_back([this, worker_index] { this->worker_loop(worker_index); });
+	}
+}
+
+physics::FWorkerPool::~FWorkerPool()
+{
+	{
+		std::lock_guard lock(this->mutex);
+		this->is_stopping = true;
+	}
+	this->work_available.notify_all();
+
+	for (auto& thread : this->threads)
+	{
+		thread.join();
+	}
+}
+
+void physics::FWorkerPool::parallel_for(std::int32_t count, const std::function<void(std::int32_t begin, std::int32_t end)>& task)
+{
+	const auto num_chunks = this->get_num_threads();
+	if (num_chunks == 1 || count <= 1)
+	{
+		task(0, count);
+		return;
+	}
+
+	{
+		std::lock_guard lock(this->mutex);
+		this->work_task = &task;
+		this->work_count = count;
+		this->pending_workers = num_chunks - 1;
+		this->generation++;
+	}
+	this->work_available.notify_all();
+
+	run_chunk(0, num_chunks, count, task);
+
+	std::unique_lock lock(this->mutex);
+	this->work_done.wait(lock, [this] { return this->pending_workers == 0; });
+	this->work_task = nullptr;
+}
+
+void physics::FWorkerPool::worker_loop(std::int32_t worker_index)
+{
+	std::uint64_t seen_generation = 0;
+
+	while (true)
+	{
+		const std::function<void(std::int32_t, std::int32_t)>* task = nullptr;
+		std::int32_t count = 0;
+
+		{
+			std::unique_lock lock(this->mutex);
+			this->work_available.wait(lock, [this, seen_generation] { return this->is_stopping || this->generation != seen_generation; });
+			if (this->is_stopping)
+			{
+				return;
+			}
+
+			seen_generation = this->generation;
+			task = this->work_task;
+			count = this->work_count;
+		}
+
+		run_chunk(worker_index, this->get_num_threads(), count, *task);
+
+		bool is_last = false;
+		{
+			std::lock_guard lock(this->mutex);
+			this->pending_workers--;
+			is_last = this->pending_workers == 0;
+		}
+
+		if (is_last)
+		{
+			this->work_done.notify_one();
+		}
+	}
+}
+
+void physics::FWorkerPool::run_chunk(std::int32_t chunk_index, std::int32_t num_chunks, std::int32_t count,
+	const std::function<void(std::int32_t, std::int32_t)>& task)
+{
+	// Contiguous chunks, so that each thread works on its own part of the structure-of-arrays buffers
+	const auto chunk_size = (count + num_chunks - 1) / num_chunks;
+	const auto begin = std::min(count, chunk_index * chunk_size);
+	const auto end = std::min(count, begin + chunk_size);
+
+	if (begin < end)
+	{
+		task(begin, end);
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace physics
+{
+	/**
+	 * Fixed set of threads that split a range of work in contiguous chunks. The calling thread takes the first chunk.
+	 * Threads are kept alive between calls, so that dispatching a step costs a wake-up and not a thread creation.
+	 */
+	class FWorkerPool
+	{
+	public:
+
+		// Total number of threads, including the calling thread
+		explicit FWorkerPool(std::int32_t num_threads);
+
+		~FWorkerPool();
+
+		FWorkerPool(const FWorkerPool&) = delete;
+		FWorkerPool& operator=(const FWorkerPool&) = delete;
+
+		std::int32_t get_num_threads() const { return static_cast<std::int32_t>(this->threads.size()) + 1; }
+
+		/**
+		 * Calls task(begin, end) on every chunk of [0, count), and returns when all of them are done.
+		 */
+		void parallel_for(std::int32_t count, const std::function<void(std::int32_t begin, std::int32_t end)>& task);
+
+	private:
+
+		void worker_loop(std::int32_t worker_index);
+
+		static void run_chunk(std::int32_t chunk_index, std::int32_t num_chunks, std::int32_t count,
+			const std::function<void(std::int32_t, std::int32_t)>& task);
+
+		std::vector<std::thread> threads;
+
+		std::mutex mutex;
+
+		std::condition_variable work_available;
+
+		std::condition_variable work_done;
+
+		// Incremented on each parallel_for, the workers wait for it to change
+		std::uint64_t generation = 0;
+
+		std::int32_t pending_workers = 0;
+
+		std::int32_t work_count = 0;
+
+		const std::function<void(std::int32_t, std::int32_t)>* work_task = nullptr;
+
+		bool is_stopping = false;
+	};
+}
@@ -0,0 +1,159 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/Math/Quaternion.h"
+#include "DroneSimulatorPhysics/Public/Math/Random.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+#include "DroneSimulatorPhysics/Public/RotorModel/Bemt/ComputePropellerThrust.h"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+namespace
+{
+	void require_vector_near(const physics::FVector3& actual, const physics::FVector3& expected, double tolerance = 1e-9)
+	{
+		REQUIRE(actual.X == Approx(expected.X).margin(tolerance));
+		REQUIRE(actual.Y == Approx(expected.Y).margin(tolerance));
+		REQUIRE(actual.Z == Approx(expected.Z).margin(tolerance));
+	}
+}
+
+TEST_CASE("Vector", "[math]")
+{
+	using physics::FVector3;
+
+	SECTION("Cross product follows the left-handed Unreal axes")
+	{
+		require_vector_near(FVector3::forward().cross(FVector3::right()), FVector3::up());
+	}
+
+	SECTION("Bound to cube")
+	{
+		require_vector_near(FVector3(5.0, -5.0, 0.5).bound_to_cube(1.0), FVector3(1.0, -1.0, 0.5));
+	}
+
+	SECTION("Safe normal of a zero vector")
+	{
+		require_vector_near(FVector3::zero().get_safe_normal(), FVector3::zero());
+	}
+}
+
+TEST_CASE("Quaternion", "[math]")
+{
+	using physics::FQuaternion;
+	using physics::FRotation;
+	using physics::FVector3;
+
+	SECTION("Yaw of 90 degrees rotates forward to right")
+	{
+		const auto rotation = FQuaternion::from_rotation(FRotation(0.0, 90.0, 0.0));
+		require_vector_near(rotation.rotate_vector(FVector3::forward()), FVector3::right());
+	}
+
+	SECTION("Unrotate is the inverse of rotate")
+	{
+		const auto rotation = FQuaternion::from_rotation(FRotation(20.0, -35.0, 10.0));
+		const auto vector = FVector3(1.0, 2.0, 3.0);
+		require_vector_near(rotation.unrotate_vector(rotation.rotate_vector(vector)), vector);
+	}
+
+	SECTION("Rotation round trip")
+	{
+		const auto rotation = FQuaternion::from_rotation(FRotation(20.0, -35.0, 10.0)).to_rotation();
+		REQUIRE(rotation.Pitch == Approx(20.0));
+		REQUIRE(rotation.Yaw == Approx(-35.0));
+		REQUIRE(rotation.Roll == Approx(10.0));
+	}
+
+	SECTION("Slerp halfway is half the angle")
+	{
+		const auto rotation = FQuaternion::slerp(FQuaternion::identity(), FQuaternion::from_rotation(FRotation(0.0, 90.0, 0.0)), 0.5);
+		REQUIRE(rotation.to_rotation().Yaw == Approx(45.0));
+	}
+
+	SECTION("Slerp takes the shortest path")
+	{
+		const auto target = FQuaternion::from_rotation(FRotation(0.0, 90.0, 0.0));
+		const auto negated_target = FQuaternion(-target.X, -target.Y, -target.Z, -target.W);
+		const auto rotation = FQuaternion::slerp(FQuaternion::identity(), negated_target, 0.5);
+		REQUIRE(rotation.to_rotation().Yaw == Approx(45.0));
+	}
+}
+
+TEST_CASE("Axial velocity", "[bemt]")
+{
+	using physics::FVector3;
+	using physics::simulation_bemt::compute_axial_velocity;
+
+	SECTION("Zero air velocity")
+	{
+		REQUIRE(compute_axial_velocity(FVector3::up(), FVector3(0.0, 0.0, 0.0), FVector3(0.0, 0.0, 0.0)) == Approx(0.0));
+	}
+
+	SECTION("Downwind")
+	{
+		REQUIRE(compute_axial_velocity(FVector3::up(), FVector3(0.0, 0.0, -20.0), FVector3(0.0, 0.0, 0.0)) == Approx(20.0));
+	}
+
+	SECTION("Drone goes up")
+	{
+		REQUIRE(compute_axial_velocity(FVector3::up(), FVector3(0.0, 0.0, 0.0), FVector3(0.0, 0.0, 20.0)) == Approx(20.0));
+	}
+
+	SECTION("Drone goes up with wind")
+	{
+		REQUIRE(compute_axial_velocity(FVector3::up(), FVector3(0.0, 0.0, 30.0), FVector3(0.0, 0.0, 20.0)) == Approx(-10.0));
+	}
+}
+
+TEST_CASE("Counter-based random numbers", "[math]")
+{
+	SECTION("Philox4x32-10 known answers")
+	{
+		using words = std::array<std::uint32_t, 4>;
+		CHECK(physics::random::philox4x32(words { 0, 0, 0, 0 }, { 0, 0 }) == words { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 });
+		CHECK(physics::random::philox4x32(words { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff })
+			== words { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd });
+		CHECK(physics::random::philox4x32(words { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 })
+			== words { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 });
+	}
+
+	SECTION("A number doesn't depend on how the stream is split")
+	{
+		std::vector<double> whole(1000);
+		physics::random::fill_normal(42, 7, 0, whole);
+
+		std::vector<double> part(301);
+		physics::random::fill_normal(42, 7, 333, part);
+		for (std::size_t index = 0; index < part.size(); index++)
+		{
+			REQUIRE(part[index] == whole[333 + index]);
+		}
+
+		std::vector<double> other_stream(1000);
+		physics::random::fill_normal(42, 8, 0, other_stream);
+		CHECK(other_stream != whole);
+	}
+
+	SECTION("Standard normal distribution")
+	{
+		std::vector<double> numbers(100000);
+		physics::random::fill_normal(1, 0, 0, numbers);
+
+		double sum = 0.0;
+		double sum_squares = 0.0;
+		for (const auto number : numbers)
+		{
+			sum += number;
+			sum_squares += number * number;
+		}
+
+		const auto mean = sum / numbers.size();
+		CHECK(mean == Approx(0.0).margin(0.02));
+		CHECK(sum_squares / numbers.size() - mean * mean == Approx(1.0).epsilon(0.02));
+	}
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include "DroneSimulatorPhysics/Public/Math/Quaternion.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+
+#include <cmath>
+
+physics::FQuaternion physics::FQuaternion::from_axis_angle(const FVector3& axis, double angle_radians)
+{
+	const double half_angle = 0.5 * angle_radians;
+	const double half_sin = std::sin(half_angle);
+	return FQuaternion(axis.X * half_sin, axis.Y * half_sin, axis.Z * half_sin, std::cos(half_angle));
+}
+
+physics::FQuaternion physics::FQuaternion::from_rotation(const FRotation& rotation)
+{
+	// Same as FRotator::Quaternion
+	constexpr double half_degrees_to_radians = math::pi / 360.0;
+
+	const double pitch = std::fmod(rotation.Pitch, 360.0) * half_degrees_to_radians;
+	const double yaw = std::fmod(rotation.Yaw, 360.0) * half_degrees_to_radians;
+	const double roll = std::fmod(rotation.Roll, 360.0) * half_degrees_to_radians;
+
+	const double sp = std::sin(pitch), cp = std::cos(pitch);
+	const double sy = std::sin(yaw), cy = std::cos(yaw);
+	const double sr = std::sin(roll), cr = std::cos(roll);
+
+	return FQuaternion(
+		cr * sp * sy - sr * cp * cy,
+		-cr * sp * cy - sr * cp * sy,
+		cr * cp * sy - sr * sp * cy,
+		cr * cp * cy + sr * sp * sy
+	);
+}
+
+physics::FRotation physics::FQuaternion::to_rotation() const
+{
+	// Same as FQuat::Rotator
+	const double singularity_test = Z * X - W * Y;
+	const double yaw_y = 2.0 * (W * Z + X * Y);
+	const double yaw_x = 1.0 - 2.0 * (Y * Y + Z * Z);
+
+	constexpr double singularity_threshold = 0.4999995;
+
+	const double yaw = math::radians_to_degrees(std::atan2(yaw_y, yaw_x));
+
+	if (singularity_test < -singularity_threshold)
+	{
+		const double roll = math::normalize_axis_degrees(-yaw - 2.0 * math::radians_to_degrees(std::atan2(X, W)));
+		return FRotation(-90.0, yaw, roll);
+	}
+
+	if (singularity_test > singularity_threshold)
+	{
+		const double roll = math::normalize_axis_degrees(yaw - 2.0 * math::radians_to_degrees(std::atan2(X, W)));
+		return FRotation(90.0, yaw, roll);
+	}
+
+	const double pitch = math::radians_to_degrees(std::asin(2.0 * singularity_test));
+	const double roll = math::radians_to_degrees(std::atan2(-2.0 * (W * X + Y * Z), 1.0 - 2.0 * (X * X + Y * Y)));
+	return FRotation(pitch, yaw, roll);
+}
+
+physics::FQuaternion physics::FQuaternion::slerp(const FQuaternion& a, const FQuaternion& b, double alpha)
+{
+	// q and -q are the same rotation, flip b to take the short way
+	const double raw_cosine = a.X * b.X + a.Y * b.Y + a.Z * b.Z + a.W * b.W;
+	const double cosine = std::abs(raw_cosine);
+
+	double scale_a = 1.0 - alpha;
+	double scale_b = alpha;
+
+	// Nearly the same rotation: the sine below goes to zero, a linear interpolation is as good
+	if (cosine < 0.9999)
+	{
+		const double omega = std::acos(cosine);
+		const double inverse_sine = 1.0 / std::sin(omega);
+		scale_a = std::sin((1.0 - alpha) * omega) * inverse_sine;
+		scale_b = std::sin(alpha * omega) * inverse_sine;
+	}
+
+	scale_b = raw_cosine >= 0.0 ? scale_b : -scale_b;
+
+	return FQuaternion(
+		scale_a * a.X + scale_b * b.X,
+		scale_a * a.Y + scale_b * b.Y,
+		scale_a * a.Z + scale_b * b.Z,
+		scale_a * a.W + scale_b * b.W
+	).get_normalized();
+}
+
+physics::FQuaternion physics::FQuaternion::get_normalized() const
+{
+	const double square_sum = X * X + Y * Y + Z * Z + W * W;
+	if (square_sum < 1e-8)
+	{
+		return identity();
+	}
+
+	const double scale = 1.0 / std::sqrt(square_sum);
+	return FQuaternion(X * scale, Y * scale, Z * scale, W * scale);
+}
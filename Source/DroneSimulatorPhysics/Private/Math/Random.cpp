@@ -0,0 +1,127 @@
+#include "DroneSimulatorPhysics/Public/Math/Random.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	constexpr std::uint32_t philox_multiplier_0 = 0xD2511F53;
+	constexpr std::uint32_t philox_multiplier_1 = 0xCD9E8D57;
+	constexpr std::uint32_t philox_weyl_0 = 0x9E3779B9;
+	constexpr std::uint32_t philox_weyl_1 = 0xBB67AE85;
+	constexpr std::int32_t philox_round_count = 10;
+
+	// Counters drawn together, each one gives four numbers
+	constexpr std::int32_t counter_block_size = 64;
+
+	/**
+	 * Philox rounds on counter_block_size counters at once, in columns so that the loop is vectorized. The counters only
+	 * differ by their first word.
+	 */
+	void philox_block(std::uint64_t first_counter, std::uint64_t stream, std::uint32_t key_0, std::uint32_t key_1,
+		std::uint32_t (&out_words)[4][counter_block_size])
+	{
+		auto* __restrict word_0 = out_words[0];
+		auto* __restrict word_1 = out_words[1];
+		auto* __restrict word_2 = out_words[2];
+		auto* __restrict word_3 = out_words[3];
+
+		for (std::int32_t index = 0; index < counter_block_size; index++)
+		{
+			const auto counter = first_counter + static_cast<std::uint64_t>(index);
+			word_0[index] = static_cast<std::uint32_t>(counter);
+			word_1[index] = static_cast<std::uint32_t>(counter >> 32);
+			word_2[index] = static_cast<std::uint32_t>(stream);
+			word_3[index] = static_cast<std::uint32_t>(stream >> 32);
+		}
+
+		auto round_key_0 = key_0;
+		auto round_key_1 = key_1;
+		for (std::int32_t round = 0; round < philox_round_count; round++)
+		{
+			for (std::int32_t index = 0; index < counter_block_size; index++)
+			{
+				const auto product_0 = static_cast<std::uint64_t>(philox_multiplier_0) * word_0[index];
+				const auto product_1 = static_cast<std::uint64_t>(philox_multiplier_1) * word_2[index];
+
+				const auto next_0 = static_cast<std::uint32_t>(product_1 >> 32) ^ word_1[index] ^ round_key_0;
+				const auto next_2 = static_cast<std::uint32_t>(product_0 >> 32) ^ word_3[index] ^ round_key_1;
+				word_1[index] = static_cast<std::uint32_t>(product_1);
+				word_3[index] = static_cast<std::uint32_t>(product_0);
+				word_0[index] = next_0;
+				word_2[index] = next_2;
+			}
+
+			round_key_0 += philox_weyl_0;
+			round_key_1 += philox_weyl_1;
+		}
+	}
+
+	// In (0, 1), never 0 so that its log is finite
+	double to_open_unit(std::uint32_t word)
+	{
+		return (static_cast<double>(word) + 0.5) * (1.0 / 4294967296.0);
+	}
+}
+
+std::array<std::uint32_t, 4> physics::random::philox4x32(const std::array<std::uint32_t, 4>& counter,
+	const std::array<std::uint32_t, 2>& key)
+{
+	auto words = counter;
+	auto round_key = key;
+
+	for (std::int32_t round = 0; round < philox_round_count; round++)
+	{
+		const auto product_0 = static_cast<std::uint64_t>(philox_multiplier_0) * words[0];
+		const auto product_1 = static_cast<std::uint64_t>(philox_multiplier_1) * words[2];
+
+		words = {
+			static_cast<std::uint32_t>(product_1 >> 32) ^ words[1] ^ round_key[0],
+			static_cast<std::uint32_t>(product_1),
+			static_cast<std::uint32_t>(product_0 >> 32) ^ words[3] ^ round_key[1],
+			static_cast<std::uint32_t>(product_0),
+		};
+
+		round_key[0] += philox_weyl_0;
+		round_key[1] += philox_weyl_1;
+	}
+
+	return words;
+}
+
+void physics::random::fill_normal(std::uint64_t key, std::uint64_t stream, std::uint64_t first_index, std::span<double> out_numbers)
+{
+	const auto key_0 = static_cast<std::uint32_t>(key);
+	const auto key_1 = static_cast<std::uint32_t>(key >> 32);
+
+	std::uint32_t words[4][counter_block_size];
+	double normals[4 * counter_block_size];
+
+	const auto end_index = first_index + out_numbers.size();
+	auto index = first_index;
+	while (index < end_index)
+	{
+		const auto first_counter = index / 4;
+		philox_block(first_counter, stream, key_0, key_1, words);
+
+		const auto block_end_index = std::min(end_index, (first_counter + counter_block_size) * 4);
+		const auto used_counter_count = static_cast<std::int32_t>((block_end_index - first_counter * 4 + 3) / 4);
+
+		// Numbers 4 * counter to 4 * counter + 3 are the two Box-Muller pairs of the counter
+		for (std::int32_t counter_offset = 0; counter_offset < used_counter_count; counter_offset++)
+		{
+			for (std::int32_t pair = 0; pair < 2; pair++)
+			{
+				const auto radius = std::sqrt(-2.0 * std::log(to_open_unit(words[pair * 2][counter_offset])));
+				const auto angle = math::two_pi * to_open_unit(words[pair * 2 + 1][counter_offset]);
+				normals[counter_offset * 4 + pair * 2] = radius * std::cos(angle);
+				normals[counter_offset * 4 + pair * 2 + 1] = radius * std::sin(angle);
+			}
+		}
+
+		std::copy(normals + (index - first_counter * 4), normals + (block_end_index - first_counter * 4),
+			out_numbers.begin() + static_cast<std::ptrdiff_t>(index - first_index));
+		index = block_end_index;
+	}
+}
@@ -0,0 +1,133 @@
+#include "DroneSimulatorPhysics/Public/PropulsionModel/PropulsionModel.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+#include "DroneSimulatorPhysics/Private/Utils/Variant.h"
+
+#include <algorithm>
+
+physics::FPropellerSetLocations physics::propulsion::compute_propeller_locations(const FDroneFrame& frame)
+{
+	const FVector3 props_extent_front = frame.props_extent_front.get_abs();
+	const FVector3 props_extent_back = frame.props_extent_back.get_abs();
+
+	return FPropellerSetLocations {
+		FVector3(props_extent_front.X, -props_extent_front.Y, props_extent_front.Z),
+		FVector3(props_extent_front.X, props_extent_front.Y, props_extent_front.Z),
+		FVector3(-props_extent_back.X, -props_extent_back.Y, props_extent_back.Z),
+		FVector3(-props_extent_back.X, props_extent_back.Y, props_extent_back.Z),
+	};
+}
+
+std::vector<physics::FRotorDescription> physics::propulsion::compute_rotors(const FDroneFrame& frame)
+{
+	if (!frame.rotors.empty())
+	{
+		return frame.rotors;
+	}
+
+	const auto locations = compute_propeller_locations(frame);
+
+	return std::vector<FRotorDescription> {
+		FRotorDescription { locations.front_left, FVector3::up(), true },
+		FRotorDescription { locations.front_right, FVector3::up(), false },
+		FRotorDescription { locations.rear_left, FVector3::up(), false },
+		FRotorDescription { locations.rear_right, FVector3::up(), true },
+	};
+}
+
+physics::FVector3 physics::propulsion::get_component_angular_velocity(const FSubstepBody& substep_body,
+	const FVector3* gyro_angular_velocity)
+{
+	return gyro_angular_velocity != nullptr
+		? *gyro_angular_velocity
+		: substep_body.transform_world.rotation.unrotate_vector(substep_body.angular_velocity_radians_world);
+}
+
+void physics::propulsion::hold_rotor_output(FPropulsionHeldOutputs& held_outputs, std::int32_t rotor_index, double throttle,
+	const FThrustSimValue& value)
+{
+	// At zero throttle, keep the previous ratios rather than dividing by zero
+	const auto throttle_squared = math::square(throttle);
+	if (throttle_squared < 1e-6)
+	{
+		return;
+	}
+
+	held_outputs.thrust_per_throttle_squared[rotor_index] = value.thrust / throttle_squared;
+	held_outputs.torque_per_throttle_squared[rotor_index] = value.torque / throttle_squared;
+}
+
+void physics::propulsion::apply_held_rotor_output(const FPropulsionHeldOutputs& held_outputs, FSubstepBody* substep_body,
+	const FRotorDescription& rotor, std::int32_t rotor_index, double throttle)
+{
+	// Thrust and torque go with the angular speed squared, and the angular speed with the throttle
+	const auto throttle_squared = math::square(throttle);
+	rotor_model::apply_rotor_forces(substep_body, rotor, held_outputs.thrust_per_throttle_squared[rotor_index] * throttle_squared,
+		held_outputs.torque_per_throttle_squared[rotor_index] * throttle_squared);
+}
+
+physics::FDynamicsPropellerInfo physics::propulsion::get_held_rotor_info(const FPropulsionHeldOutputs& held_outputs,
+	const FPropulsionDroneSetup& drone_setup, std::int32_t rotor_index, double throttle)
+{
+	const auto throttle_squared = math::square(throttle);
+
+	FDynamicsPropellerInfo rotor_info;
+	rotor_info.angular_speed = throttle * drone_setup.battery->voltage * drone_setup.motor->kv;
+	rotor_info.thrust = held_outputs.thrust_per_throttle_squared[rotor_index] * throttle_squared;
+	rotor_info.torque = held_outputs.torque_per_throttle_squared[rotor_index] * throttle_squared;
+	rotor_info.throttle = throttle;
+	return rotor_info;
+}
+
+std::optional<physics::FDynamicsPropellerSetInfo> physics::propulsion::tick_dynamics(FPropulsionModelDynamics& propulsion_model,
+	FSubstepBody* substep_body, const FDroneSetpoint& drone_setpoint, const FPropulsionDroneSetup& drone_setup,
+	const FSimulationWorld* simulation_world, const FSubstepStages& stages, const FVector3* gyro_angular_velocity)
+{
+	return tick_rotors(propulsion_model.held_outputs, substep_body, drone_setup, stages, gyro_angular_velocity,
+		[&](double controller_delta_time, const FVector3& component_angular_velocity, const FMixerMatrix& mixer)
+		{
+			return controller::tick_controller(propulsion_model.controller, controller_delta_time, drone_setpoint,
+				component_angular_velocity, mixer);
+		},
+		[&](double throttle, const FRotorDescription& rotor)
+		{
+			return rotor_model::simulate_propeller_rotor(propulsion_model.rotor_model, substep_body, throttle, drone_setup.propeller,
+				drone_setup.motor, drone_setup.battery, rotor, simulation_world);
+		});
+}
+
+std::optional<physics::FDynamicsPropellerSetInfo> physics::propulsion::tick_direct_setpoint(
+	const FPropulsionModelDirectSetpoint& propulsion_model, FSubstepBody* substep_body,
+	const FDroneSetpoint& drone_setpoint)
+{
+	substep_body->angular_velocity_radians_world = substep_body->transform_world.transform_vector(drone_setpoint.angular_velocity_radians);
+
+	const auto drone_up_axis = substep_body->transform_world.get_unit_axis_z();
+
+	const auto drone_vertical_velocity = drone_up_axis.dot(substep_body->linear_velocity_world);
+	const auto max_speed_factor = std::max(0.0, 1.0 - drone_vertical_velocity / propulsion_model.max_vertical_speed);
+
+	const auto force_to_apply = drone_up_axis * drone_setpoint.throttle * max_speed_factor * propulsion_model.max_throttle_force;
+	substep_body->add_force(force_to_apply);
+
+	return {};
+}
+
+std::optional<physics::FDynamicsPropellerSetInfo> physics::propulsion::tick_propulsion(FPropulsionModel& propulsion_model,
+	FSubstepBody* substep_body, const FDroneSetpoint& drone_setpoint, const FPropulsionDroneSetup& drone_setup,
+	const FSimulationWorld* simulation_world, const FSubstepStages& stages, const FVector3* gyro_angular_velocity)
+{
+	return match_variant(
+		propulsion_model,
+		[&](FPropulsionModelDynamics& propulsion_model_dynamics)
+		{
+			return tick_dynamics(propulsion_model_dynamics, substep_body, drone_setpoint, drone_setup, simulation_world, stages,
+				gyro_angular_velocity);
+		},
+		[&](const FPropulsionModelDirectSetpoint& propulsion_model_direct)
+		{
+			return tick_direct_setpoint(propulsion_model_direct, substep_body, drone_setpoint);
+		}
+	);
+}
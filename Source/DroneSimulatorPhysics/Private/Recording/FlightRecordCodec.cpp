@@ -0,0 +1,726 @@
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordCodec.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+	// The bit reader loads 8 bytes at a time, in native order
+	static_assert(std::endian::native == std::endian::little, "The flight record codec assumes a little endian platform");
+
+	// Zero bytes after the bit stream, so that the reader can always load 8 bytes
+	constexpr std::size_t padding_bytes = 8;
+
+	class FBitWriter
+	{
+	public:
+
+		explicit FBitWriter(std::vector<std::uint8_t>& in_bytes)
+			: bytes(in_bytes)
+		{
+		}
+
+		// Up to 32 bits, least significant first
+		void write(std::uint32_t value, std::int32_t bit_count)
+		{
+			const auto mask = bit_count >= 32 ? ~std::uint64_t(0) : (std::uint64_t(1) << bit_count) - 1;
+			this->buffer |= (value & mask) << this->buffer_bit_count;
+			this->buffer_bit_count += bit_count;
+			while (this->buffer_bit_count >= 8)
+			{
+				this->bytes.push_back(static_cast<std::uint8_t>(this->buffer));
+				this->buffer >>= 8;
+				this->buffer_bit_count -= 8;
+			}
+		}
+
+		void write_64(std::uint64_t value)
+		{
+			this->write(static_cast<std::uint32_t>(value), 32);
+			this->write(static_cast<std::uint32_t>(value >> 32), 32);
+		}
+
+		void align_to_byte()
+		{
+			if (this->buffer_bit_count > 0)
+			{
+				this->write(0, 8 - this->buffer_bit_count);
+			}
+		}
+
+		void finish()
+		{
+			if (this->buffer_bit_count > 0)
+			{
+				this->bytes.push_back(static_cast<std::uint8_t>(this->buffer));
+			}
+			this->bytes.insert(this->bytes.end(), padding_bytes, 0);
+		}
+
+	private:
+
+		std::vector<std::uint8_t>& bytes;
+
+		std::uint64_t buffer = 0;
+
+		std::int32_t buffer_bit_count = 0;
+	};
+
+	// Up to 32 bits, from a stream followed by its padding
+	std::uint32_t read_bits(const std::uint8_t* data, std::uint64_t bit_position, std::int32_t bit_count)
+	{
+		std::uint64_t word;
+		std::memcpy(&word, data + (bit_position >> 3), sizeof(word));
+		word >>= bit_position & 7;
+		return static_cast<std::uint32_t>(word & ((std::uint64_t(1) << bit_count) - 1));
+	}
+
+	class FBitReader
+	{
+	public:
+
+		explicit FBitReader(std::span<const std::uint8_t> bytes)
+			: data(bytes.data())
+			, bit_limit(bytes.size() >= padding_bytes ? (bytes.size() - padding_bytes) * 8 : 0)
+			, is_valid(bytes.size() >= padding_bytes)
+		{
+		}
+
+		// Up to 32 bits. Past the end of the stream, reads zeros and the reader is no longer valid.
+		std::uint32_t read(std::int32_t bit_count)
+		{
+			if (!this->has_bits(bit_count))
+			{
+				this->is_valid = false;
+				return 0;
+			}
+
+			return this->read_unchecked(bit_count);
+		}
+
+		std::uint64_t read_64()
+		{
+			const auto low = this->read(32);
+			return low | (static_cast<std::uint64_t>(this->read(32)) << 32);
+		}
+
+		// Once has_bits said the bits are there
+		std::uint32_t read_unchecked(std::int32_t bit_count)
+		{
+			const auto value = read_bits(this->data, this->bit_position, bit_count);
+			this->bit_position += bit_count;
+			return value;
+		}
+
+		bool align_to_byte()
+		{
+			return this->skip((8 - (this->bit_position & 7)) & 7);
+		}
+
+		bool skip(std::uint64_t bit_count)
+		{
+			if (!this->has_bits(bit_count))
+			{
+				this->is_valid = false;
+				return false;
+			}
+
+			this->bit_position += bit_count;
+			return true;
+		}
+
+		bool has_bits(std::uint64_t bit_count) const
+		{
+			return this->is_valid && this->bit_position + bit_count <= this->bit_limit;
+		}
+
+		bool get_is_valid() const
+		{
+			return this->is_valid;
+		}
+
+		const std::uint8_t* get_data() const
+		{
+			return this->data;
+		}
+
+		std::uint64_t get_bit_position() const
+		{
+			return this->bit_position;
+		}
+
+	private:
+
+		const std::uint8_t* data = nullptr;
+
+		std::uint64_t bit_position = 0;
+
+		std::uint64_t bit_limit = 0;
+
+		bool is_valid = true;
+	};
+
+	// A quantized channel: 1 or 2 bytes at an offset of FTelemetrySample
+	struct FColumn
+	{
+		std::uint16_t offset = 0;
+		std::uint8_t size = 0;
+	};
+
+	constexpr std::int32_t quantized_column_count = 4 + 3 + 3 + 4 + 1 + physics::telemetry_rotor_count * 9;
+
+	constexpr auto quantized_columns = []
+	{
+		using physics::FTelemetryRotor;
+		using physics::FTelemetrySample;
+
+		std::array<FColumn, quantized_column_count> columns {};
+		std::int32_t count = 0;
+		const auto add = [&columns, &count](std::size_t offset, std::size_t size)
+		{
+			columns[count] = FColumn { static_cast<std::uint16_t>(offset), static_cast<std::uint8_t>(size) };
+			count++;
+		};
+
+		for (std::size_t index = 0; index < 4; index++)
+		{
+			add(offsetof(FTelemetrySample, rotation) + index * 2, 2);
+		}
+		for (std::size_t index = 0; index < 3; index++)
+		{
+			add(offsetof(FTelemetrySample, linear_velocity) + index * 2, 2);
+		}
+		for (std::size_t index = 0; index < 3; index++)
+		{
+			add(offsetof(FTelemetrySample, angular_velocity) + index * 2, 2);
+		}
+		for (std::size_t index = 0; index < 4; index++)
+		{
+			add(offsetof(FTelemetrySample, player_input) + index * 2, 2);
+		}
+		add(offsetof(FTelemetrySample, has_propulsion), 1);
+
+		for (std::size_t rotor_index = 0; rotor_index < physics::telemetry_rotor_count; rotor_index++)
+		{
+			const auto rotor_offset = offsetof(FTelemetrySample, rotors) + rotor_index * sizeof(FTelemetryRotor);
+			add(rotor_offset + offsetof(FTelemetryRotor, throttle), 2);
+			add(rotor_offset + offsetof(FTelemetryRotor, angular_speed), 2);
+			add(rotor_offset + offsetof(FTelemetryRotor, thrust), 2);
+			add(rotor_offset + offsetof(FTelemetryRotor, torque), 2);
+			add(rotor_offset + offsetof(FTelemetryRotor, angle_of_attack), 2);
+			add(rotor_offset + offsetof(FTelemetryRotor, min_reynolds), 2);
+			add(rotor_offset + offsetof(FTelemetryRotor, max_reynolds), 2);
+			add(rotor_offset + offsetof(FTelemetryRotor, velocity_axial), 2);
+			add(rotor_offset + offsetof(FTelemetryRotor, velocity_induced), 2);
+		}
+
+		return columns;
+	}();
+
+	template <typename T>
+	T read_field(const physics::FTelemetrySample& sample, std::size_t offset)
+	{
+		T value;
+		std::memcpy(&value, reinterpret_cast<const std::uint8_t*>(&sample) + offset, sizeof(T));
+		return value;
+	}
+
+	template <typename T>
+	void write_field(physics::FTelemetrySample& sample, std::size_t offset, T value)
+	{
+		std::memcpy(reinterpret_cast<std::uint8_t*>(&sample) + offset, &value, sizeof(T));
+	}
+
+	std::uint64_t zigzag_64(std::uint64_t delta)
+	{
+		const auto value = static_cast<std::int64_t>(delta);
+		return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+	}
+
+	std::uint64_t unzigzag_64(std::uint64_t value)
+	{
+		return (value >> 1) ^ (0 - (value & 1));
+	}
+
+	std::int32_t get_bit_width(std::uint32_t value)
+	{
+		return 32 - std::countl_zero(value);
+	}
+
+	// Bit patterns of positive doubles grow with the value, and evenly spaced times have nearly constant deltas
+	void encode_times(FBitWriter& writer, std::span<const physics::FTelemetrySample> samples)
+	{
+		auto previous = std::bit_cast<std::uint64_t>(samples[0].time);
+		writer.write_64(previous);
+		if (samples.size() == 1)
+		{
+			return;
+		}
+
+		auto delta = std::bit_cast<std::uint64_t>(samples[1].time) - previous;
+		previous += delta;
+		writer.write_64(zigzag_64(delta));
+
+		for (std::size_t index = 2; index < samples.size(); index++)
+		{
+			const auto bits = std::bit_cast<std::uint64_t>(samples[index].time);
+			const auto next_delta = bits - previous;
+			const auto value = zigzag_64(next_delta - delta);
+			delta = next_delta;
+			previous = bits;
+
+			// 0, 10, 110, 1110, 1111 then 0, 7, 12, 20 or 64 bits
+			if (value == 0)
+			{
+				writer.write(0, 1);
+			}
+			else if (value < (std::uint64_t(1) << 7))
+			{
+				writer.write(0b01, 2);
+				writer.write(static_cast<std::uint32_t>(value), 7);
+			}
+			else if (value < (std::uint64_t(1) << 12))
+			{
+				writer.write(0b011, 3);
+				writer.write(static_cast<std::uint32_t>(value), 12);
+			}
+			else if (value < (std::uint64_t(1) << 20))
+			{
+				writer.write(0b0111, 4);
+				writer.write(static_cast<std::uint32_t>(value), 20);
+			}
+			else
+			{
+				writer.write(0b1111, 4);
+				writer.write_64(value);
+			}
+		}
+	}
+
+	bool decode_times(FBitReader& reader, std::span<physics::FTelemetrySample> samples)
+	{
+		auto bits = reader.read_64();
+		samples[0].time = std::bit_cast<double>(bits);
+		if (samples.size() == 1)
+		{
+			return reader.get_is_valid();
+		}
+
+		auto delta = unzigzag_64(reader.read_64());
+		bits += delta;
+		samples[1].time = std::bit_cast<double>(bits);
+
+		for (std::size_t index = 2; index < samples.size(); index++)
+		{
+			if (reader.read(1) != 0)
+			{
+				std::uint64_t value;
+				if (reader.read(1) == 0)
+				{
+					value = reader.read(7);
+				}
+				else if (reader.read(1) == 0)
+				{
+					value = reader.read(12);
+				}
+				else if (reader.read(1) == 0)
+				{
+					value = reader.read(20);
+				}
+				else
+				{
+					value = reader.read_64();
+				}
+				delta += unzigzag_64(value);
+			}
+
+			bits += delta;
+			samples[index].time = std::bit_cast<double>(bits);
+		}
+
+		return reader.get_is_valid();
+	}
+
+	// Gorilla XOR: only the bits that changed, within the window of leading and trailing zeros of the last change
+	void encode_floats(FBitWriter& writer, std::span<const physics::FTelemetrySample> samples, std::size_t offset)
+	{
+		auto previous = read_field<std::uint32_t>(samples[0], offset);
+		writer.write(previous, 32);
+
+		std::int32_t window_leading = -1;
+		std::int32_t window_trailing = 0;
+		for (std::size_t index = 1; index < samples.size(); index++)
+		{
+			const auto bits = read_field<std::uint32_t>(samples[index], offset);
+			const auto difference = bits ^ previous;
+			previous = bits;
+
+			if (difference == 0)
+			{
+				writer.write(0, 1);
+				continue;
+			}
+
+			const auto leading = std::min(std::countl_zero(difference), 31);
+			const auto trailing = std::countr_zero(difference);
+			if (window_leading >= 0 && leading >= window_leading && trailing >= window_trailing)
+			{
+				writer.write(0b01, 2);
+				writer.write(difference >> window_trailing, 32 - window_leading - window_trailing);
+			}
+			else
+			{
+				const auto length = 32 - leading - trailing;
+				writer.write(0b11, 2);
+				writer.write(static_cast<std::uint32_t>(leading), 5);
+				writer.write(static_cast<std::uint32_t>(length - 1), 5);
+				writer.write(difference >> trailing, length);
+				window_leading = leading;
+				window_trailing = trailing;
+			}
+		}
+	}
+
+	bool decode_floats(FBitReader& reader, std::span<physics::FTelemetrySample> samples, std::size_t offset)
+	{
+		auto bits = reader.read(32);
+		write_field(samples[0], offset, bits);
+
+		std::int32_t window_leading = -1;
+		std::int32_t window_trailing = 0;
+		for (std::size_t index = 1; index < samples.size(); index++)
+		{
+			if (reader.read(1) != 0)
+			{
+				if (reader.read(1) != 0)
+				{
+					window_leading = static_cast<std::int32_t>(reader.read(5));
+					const auto length = static_cast<std::int32_t>(reader.read(5)) + 1;
+					if (window_leading + length > 32)
+					{
+						return false;
+					}
+					window_trailing = 32 - window_leading - length;
+				}
+				else if (window_leading < 0)
+				{
+					return false;
+				}
+
+				bits ^= reader.read(32 - window_leading - window_trailing) << window_trailing;
+			}
+
+			write_field(samples[index], offset, bits);
+		}
+
+		return reader.get_is_valid();
+	}
+
+	void encode_quantized(FBitWriter& writer, std::span<const physics::FTelemetrySample> samples, const FColumn& column,
+		std::vector<std::uint16_t>& deltas, std::vector<std::uint16_t>& second_deltas)
+	{
+		const auto read_value = [&column](const physics::FTelemetrySample& sample) -> std::uint16_t
+		{
+			return column.size == 1 ? read_field<std::uint8_t>(sample, column.offset) : read_field<std::uint16_t>(sample, column.offset);
+		};
+
+		const auto count = samples.size();
+		auto previous = read_value(samples[0]);
+		writer.write(previous, 16);
+		if (count == 1)
+		{
+			return;
+		}
+
+		// Wrapping around 16 bits, so that any value round trips
+		deltas.resize(count);
+		second_deltas.resize(count);
+		std::int32_t min_delta = 0x7fff;
+		std::int32_t max_delta = -0x8000;
+		std::int32_t min_second_delta = 0x7fff;
+		std::int32_t max_second_delta = -0x8000;
+		for (std::size_t index = 1; index < count; index++)
+		{
+			const auto value = read_value(samples[index]);
+			deltas[index] = static_cast<std::uint16_t>(value - previous);
+			previous = value;
+
+			const auto delta = static_cast<std::int16_t>(deltas[index]);
+			min_delta = std::min<std::int32_t>(min_delta, delta);
+			max_delta = std::max<std::int32_t>(max_delta, delta);
+			if (index >= 2)
+			{
+				second_deltas[index] = static_cast<std::uint16_t>(deltas[index] - deltas[index - 1]);
+				const auto second_delta = static_cast<std::int16_t>(second_deltas[index]);
+				min_second_delta = std::min<std::int32_t>(min_second_delta, second_delta);
+				max_second_delta = std::max<std::int32_t>(max_second_delta, second_delta);
+			}
+		}
+
+		// Packed as offsets from the smallest one, so that decoding is an add
+		const auto write_packed = [&writer, count](const std::vector<std::uint16_t>& values, std::size_t first_index, std::int32_t min_value,
+			std::int32_t width)
+		{
+			writer.write(static_cast<std::uint16_t>(min_value), 16);
+			writer.write(static_cast<std::uint32_t>(width), 5);
+			writer.align_to_byte();
+			for (std::size_t index = first_index; index < count; index++)
+			{
+				writer.write(static_cast<std::uint16_t>(values[index] - static_cast<std::uint16_t>(min_value)), width);
+			}
+		};
+
+		const auto delta_width = get_bit_width(static_cast<std::uint32_t>(max_delta - min_delta));
+		const auto second_delta_width = get_bit_width(static_cast<std::uint32_t>(max_second_delta - min_second_delta));
+		if (count >= 3 && second_delta_width < delta_width)
+		{
+			writer.write(1, 1);
+			writer.write(deltas[1], 16);
+			write_packed(second_deltas, 2, min_second_delta, second_delta_width);
+		}
+		else
+		{
+			writer.write(0, 1);
+			write_packed(deltas, 1, min_delta, delta_width);
+		}
+	}
+
+	// A quantized column being decoded, a group of 8 packed values at a time
+	struct FPackedColumn
+	{
+		using FDecodeGroups = void (*)(FPackedColumn& column, std::span<physics::FTelemetrySample> samples, std::size_t group_count);
+
+		FDecodeGroups decode_groups = nullptr;
+
+		// Next group, byte aligned
+		const std::uint8_t* bytes = nullptr;
+
+		std::uint16_t offset = 0;
+		std::int32_t width = 0;
+		bool is_second_order = false;
+		std::uint16_t min_step = 0;
+
+		// Next sample, and the values it follows
+		std::size_t index = 0;
+		std::uint16_t value = 0;
+		std::uint16_t delta = 0;
+	};
+
+	constexpr std::size_t packed_group_size = 8;
+
+	// With the width known at compile time, the 8 values of a group are 8 loads at constant offsets and constant shifts
+	template <typename T, bool is_second_order, std::int32_t width>
+	void decode_packed_groups(FPackedColumn& column, std::span<physics::FTelemetrySample> samples, std::size_t group_count)
+	{
+		constexpr auto mask = (std::uint64_t(1) << width) - 1;
+
+		// In locals, the stores to the samples could otherwise alias them
+		const auto offset = column.offset;
+		const auto min_step = column.min_step;
+		const auto* bytes = column.bytes;
+		auto index = column.index;
+		auto value = column.value;
+		auto delta = column.delta;
+		for (std::size_t group = 0; group < group_count; group++)
+		{
+			for (std::int32_t position = 0; position < static_cast<std::int32_t>(packed_group_size); position++)
+			{
+				std::uint64_t word;
+				std::memcpy(&word, bytes + position * width / 8, sizeof(word));
+				const auto step = static_cast<std::uint16_t>(((word >> (position * width % 8)) & mask) + min_step);
+				if constexpr (is_second_order)
+				{
+					delta = static_cast<std::uint16_t>(delta + step);
+					value = static_cast<std::uint16_t>(value + delta);
+				}
+				else
+				{
+					value = static_cast<std::uint16_t>(value + step);
+				}
+				write_field(samples[index + position], offset, static_cast<T>(value));
+			}
+
+			bytes += width;
+			index += packed_group_size;
+		}
+
+		column.bytes = bytes;
+		column.index = index;
+		column.value = value;
+		column.delta = delta;
+	}
+
+	template <typename T, bool is_second_order, std::size_t... widths>
+	constexpr auto make_decode_groups_table(std::index_sequence<widths...>)
+	{
+		return std::array<FPackedColumn::FDecodeGroups, sizeof...(widths)> {
+			&decode_packed_groups<T, is_second_order, static_cast<std::int32_t>(widths)>...
+		};
+	}
+
+	// By width, from 0 to 16 bits
+	template <typename T, bool is_second_order>
+	constexpr auto decode_groups_table = make_decode_groups_table<T, is_second_order>(std::make_index_sequence<17>());
+
+	// The values after the last whole group
+	template <typename T>
+	void decode_packed_tail(FPackedColumn& column, std::span<physics::FTelemetrySample> samples)
+	{
+		std::uint64_t bit_position = 0;
+		for (; column.index < samples.size(); column.index++)
+		{
+			const auto step = static_cast<std::uint16_t>(read_bits(column.bytes, bit_position, column.width) + column.min_step);
+			bit_position += column.width;
+			if (column.is_second_order)
+			{
+				column.delta = static_cast<std::uint16_t>(column.delta + step);
+				column.value = static_cast<std::uint16_t>(column.value + column.delta);
+			}
+			else
+			{
+				column.value = static_cast<std::uint16_t>(column.value + step);
+			}
+			write_field(samples[column.index], column.offset, static_cast<T>(column.value));
+		}
+	}
+
+	// Reads the values before the packed ones, and skips the packed ones
+	template <typename T>
+	bool decode_quantized_header(FBitReader& reader, std::span<physics::FTelemetrySample> samples, std::uint16_t offset,
+		FPackedColumn& out_column)
+	{
+		const auto count = samples.size();
+		out_column.offset = offset;
+		out_column.value = static_cast<std::uint16_t>(reader.read(16));
+		write_field(samples[0], offset, static_cast<T>(out_column.value));
+		out_column.index = count;
+		if (count == 1)
+		{
+			return reader.get_is_valid();
+		}
+
+		out_column.is_second_order = reader.read(1) != 0;
+		out_column.index = 1;
+		if (out_column.is_second_order)
+		{
+			out_column.delta = static_cast<std::uint16_t>(reader.read(16));
+			out_column.value = static_cast<std::uint16_t>(out_column.value + out_column.delta);
+			write_field(samples[1], offset, static_cast<T>(out_column.value));
+			out_column.index = 2;
+		}
+
+		out_column.min_step = static_cast<std::uint16_t>(reader.read(16));
+		out_column.width = static_cast<std::int32_t>(reader.read(5));
+		if (out_column.width > 16 || !reader.align_to_byte())
+		{
+			return false;
+		}
+
+		out_column.decode_groups = out_column.is_second_order
+			? decode_groups_table<T, true>[out_column.width]
+			: decode_groups_table<T, false>[out_column.width];
+		out_column.bytes = reader.get_data() + reader.get_bit_position() / 8;
+		return reader.skip(static_cast<std::uint64_t>(count - out_column.index) * out_column.width);
+	}
+
+	// Groups decoded by all the quantized columns before moving on, so that the samples stay in the L1 cache
+	constexpr std::size_t decode_tile_group_count = 8;
+}
+
+void physics::flight_record_codec::encode_block(std::span<const FTelemetrySample> samples, std::vector<std::uint8_t>& out_bytes)
+{
+	out_bytes.clear();
+	FBitWriter writer(out_bytes);
+	writer.write(static_cast<std::uint32_t>(samples.size()), 32);
+
+	if (!samples.empty())
+	{
+		encode_times(writer, samples);
+		encode_floats(writer, samples, offsetof(FTelemetrySample, world_time_offset));
+		for (std::size_t index = 0; index < 3; index++)
+		{
+			encode_floats(writer, samples, offsetof(FTelemetrySample, location) + index * sizeof(float));
+		}
+
+		std::vector<std::uint16_t> deltas;
+		std::vector<std::uint16_t> second_deltas;
+		for (const auto& column : quantized_columns)
+		{
+			encode_quantized(writer, samples, column, deltas, second_deltas);
+		}
+	}
+
+	writer.finish();
+}
+
+bool physics::flight_record_codec::decode_block(std::span<const std::uint8_t> bytes, std::span<FTelemetrySample> out_samples)
+{
+	FBitReader reader(bytes);
+	if (reader.read(32) != out_samples.size() || !reader.get_is_valid())
+	{
+		return false;
+	}
+
+	if (out_samples.empty())
+	{
+		return true;
+	}
+
+	if (!decode_times(reader, out_samples) || !decode_floats(reader, out_samples, offsetof(FTelemetrySample, world_time_offset)))
+	{
+		return false;
+	}
+
+	for (std::size_t index = 0; index < 3; index++)
+	{
+		if (!decode_floats(reader, out_samples, offsetof(FTelemetrySample, location) + index * sizeof(float)))
+		{
+			return false;
+		}
+	}
+
+	std::array<FPackedColumn, quantized_column_count> packed_columns;
+	for (std::int32_t index = 0; index < quantized_column_count; index++)
+	{
+		const auto& column = quantized_columns[index];
+		const auto is_decoded = column.size == 1
+			? decode_quantized_header<std::uint8_t>(reader, out_samples, column.offset, packed_columns[index])
+			: decode_quantized_header<std::uint16_t>(reader, out_samples, column.offset, packed_columns[index]);
+		if (!is_decoded)
+		{
+			return false;
+		}
+	}
+
+	// Each column starts at sample 1 or 2, tiles are counted in groups rather than in samples
+	const auto group_count = (out_samples.size() - 1) / packed_group_size;
+	for (std::size_t first_group = 0; first_group < group_count; first_group += decode_tile_group_count)
+	{
+		for (auto& column : packed_columns)
+		{
+			const auto column_group_count = (out_samples.size() - column.index) / packed_group_size;
+			if (column.decode_groups != nullptr && column_group_count > 0)
+			{
+				column.decode_groups(column, out_samples, std::min(decode_tile_group_count, column_group_count));
+			}
+		}
+	}
+
+	for (std::int32_t index = 0; index < quantized_column_count; index++)
+	{
+		if (quantized_columns[index].size == 1)
+		{
+			decode_packed_tail<std::uint8_t>(packed_columns[index], out_samples);
+		}
+		else
+		{
+			decode_packed_tail<std::uint16_t>(packed_columns[index], out_samples);
+		}
+	}
+
+	return reader.get_is_valid();
+}
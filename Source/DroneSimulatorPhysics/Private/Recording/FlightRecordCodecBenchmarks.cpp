@@ -0,0 +1,90 @@
+#if WITH_DRONE_PHYSICS_BENCHMARKS
+
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordCodec.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	// A drone circling at 400 Hz with some turbulence, one block of samples
+	std::vector<physics::FTelemetrySample> make_benchmark_flight(std::int32_t count)
+	{
+		std::vector<physics::FTelemetrySample> samples(count);
+		std::uint32_t noise = 12345;
+		double turbulence = 0.0;
+		for (std::int32_t index = 0; index < count; index++)
+		{
+			// Low passed noise, gusts last a few tens of milliseconds
+			noise = noise * 1664525u + 1013904223u;
+			turbulence += 0.05 * ((static_cast<double>(noise >> 8) / (1 << 24) - 0.5) * 0.2 - turbulence);
+			const auto time = 60.0 + index / 400.0;
+
+			physics::FTelemetryValues values;
+			values.time = time;
+			values.world_time = time + 42.0;
+			values.transform_world = physics::FRigidTransform(
+				physics::FQuaternion::from_rotation(physics::FRotation(10.0 * std::sin(time), 30.0 * time, 5.0 * std::cos(time))),
+				physics::FVector3(1500.0 * std::cos(0.5 * time), 1500.0 * std::sin(0.5 * time), 500.0 + 20.0 * time));
+			values.linear_velocity_world = physics::FVector3(-7.5 * std::sin(0.5 * time), 7.5 * std::cos(0.5 * time), 0.2);
+			values.angular_velocity_radians_world = physics::FVector3(0.1 * std::cos(time) + turbulence, 0.52, turbulence);
+			values.player_input = physics::FDronePlayerInput { 0.55, 0.1, 0.0, 0.0 };
+			values.has_propulsion = true;
+			for (std::int32_t rotor_index = 0; rotor_index < physics::telemetry_rotor_count; rotor_index++)
+			{
+				auto& rotor = values.rotors[rotor_index];
+				const auto throttle = 0.55 + 0.05 * std::sin(time + rotor_index) + 0.1 * turbulence;
+				rotor.throttle = throttle;
+				rotor.angular_speed = 4000.0 * throttle;
+				rotor.thrust = 6.0 * throttle * throttle;
+				rotor.torque = 0.08 * throttle * throttle;
+				rotor.angle_of_attack = 0.1 + 0.02 * throttle;
+				rotor.min_reynolds = 20000.0 * throttle;
+				rotor.max_reynolds = 120000.0 * throttle;
+				rotor.velocity_axial = 0.2;
+				rotor.velocity_induced = 10.0 * throttle;
+			}
+
+			samples[index] = physics::telemetry::encode(values);
+		}
+		return samples;
+	}
+}
+
+// Bytes are those of the raw samples. The argument is the number of samples per block.
+static void BM_FlightRecordEncode(benchmark::State& state)
+{
+	const auto samples = make_benchmark_flight(static_cast<std::int32_t>(state.range(0)));
+	std::vector<std::uint8_t> bytes;
+
+	for (auto _ : state)
+	{
+		physics::flight_record_codec::encode_block(samples, bytes);
+		benchmark::DoNotOptimize(bytes.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(samples.size() * sizeof(physics::FTelemetrySample)));
+	state.counters["ratio"] = static_cast<double>(samples.size() * sizeof(physics::FTelemetrySample)) / static_cast<double>(bytes.size());
+}
+BENCHMARK(BM_FlightRecordEncode)->Arg(1024);
+
+static void BM_FlightRecordDecode(benchmark::State& state)
+{
+	const auto samples = make_benchmark_flight(static_cast<std::int32_t>(state.range(0)));
+	std::vector<std::uint8_t> bytes;
+	physics::flight_record_codec::encode_block(samples, bytes);
+	std::vector<physics::FTelemetrySample> decoded(samples.size());
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(physics::flight_record_codec::decode_block(bytes, decoded));
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(samples.size() * sizeof(physics::FTelemetrySample)));
+}
+BENCHMARK(BM_FlightRecordDecode)->Arg(256)->Arg(1024);
+
+#endif
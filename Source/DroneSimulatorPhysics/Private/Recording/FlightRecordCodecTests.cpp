@@ -0,0 +1,150 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordCodec.h"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+	// A drone circling at 400 Hz, with some turbulence on the rates, and the pilot holding the sticks
+	std::vector<physics::FTelemetrySample> make_flight(std::int32_t count, double first_time)
+	{
+		std::vector<physics::FTelemetrySample> samples(count);
+		std::uint32_t noise = 12345;
+		double turbulence = 0.0;
+		for (std::int32_t index = 0; index < count; index++)
+		{
+			// Low passed noise, gusts last a few tens of milliseconds
+			noise = noise * 1664525u + 1013904223u;
+			turbulence += 0.05 * ((static_cast<double>(noise >> 8) / (1 << 24) - 0.5) * 0.2 - turbulence);
+			const auto time = first_time + index / 400.0;
+
+			physics::FTelemetryValues values;
+			values.time = time;
+			// Spawned 42 s into the session, the simulation falls one substep behind the world halfway
+			values.world_time = time + 42.0 + (index >= count / 2 ? 0.0025 : 0.0);
+			values.transform_world = physics::FRigidTransform(
+				physics::FQuaternion::from_rotation(physics::FRotation(10.0 * std::sin(time), 30.0 * time, 5.0 * std::cos(time))),
+				physics::FVector3(1500.0 * std::cos(0.5 * time), 1500.0 * std::sin(0.5 * time), 500.0 + 20.0 * time));
+			values.linear_velocity_world = physics::FVector3(-7.5 * std::sin(0.5 * time), 7.5 * std::cos(0.5 * time), 0.2);
+			values.angular_velocity_radians_world = physics::FVector3(0.1 * std::cos(time) + turbulence, 0.52, turbulence);
+			values.player_input = physics::FDronePlayerInput { 0.55, 0.1, 0.0, 0.2 * (index / 400) };
+			values.has_propulsion = true;
+			for (std::int32_t rotor_index = 0; rotor_index < physics::telemetry_rotor_count; rotor_index++)
+			{
+				auto& rotor = values.rotors[rotor_index];
+				const auto throttle = 0.55 + 0.05 * std::sin(time + rotor_index) + 0.1 * turbulence;
+				rotor.throttle = throttle;
+				rotor.angular_speed = 4000.0 * throttle;
+				rotor.thrust = 6.0 * throttle * throttle;
+				rotor.torque = 0.08 * throttle * throttle;
+				rotor.angle_of_attack = 0.1 + 0.02 * throttle;
+				rotor.min_reynolds = 20000.0 * throttle;
+				rotor.max_reynolds = 120000.0 * throttle;
+				rotor.velocity_axial = 0.2;
+				rotor.velocity_induced = 10.0 * throttle;
+			}
+
+			samples[index] = physics::telemetry::encode(values);
+		}
+		return samples;
+	}
+
+	bool is_bit_exact(const physics::FTelemetrySample& a, const physics::FTelemetrySample& b)
+	{
+		return std::memcmp(&a, &b, sizeof(physics::FTelemetrySample)) == 0;
+	}
+
+	std::vector<physics::FTelemetrySample> round_trip(const std::vector<physics::FTelemetrySample>& samples)
+	{
+		std::vector<std::uint8_t> bytes;
+		physics::flight_record_codec::encode_block(samples, bytes);
+
+		std::vector<physics::FTelemetrySample> decoded(samples.size());
+		REQUIRE(physics::flight_record_codec::decode_block(bytes, decoded));
+		return decoded;
+	}
+}
+
+TEST_CASE("Flight record codec", "[recording]")
+{
+	SECTION("A flight round trips bit exact, several times smaller")
+	{
+		const auto samples = make_flight(1024, 120.0);
+
+		std::vector<std::uint8_t> bytes;
+		physics::flight_record_codec::encode_block(samples, bytes);
+		CHECK(bytes.size() * 3 < samples.size() * sizeof(physics::FTelemetrySample));
+
+		std::vector<physics::FTelemetrySample> decoded(samples.size());
+		REQUIRE(physics::flight_record_codec::decode_block(bytes, decoded));
+		for (std::size_t index = 0; index < samples.size(); index++)
+		{
+			REQUIRE(is_bit_exact(decoded[index], samples[index]));
+		}
+	}
+
+	SECTION("Extreme values, NaN and irregular times round trip bit exact")
+	{
+		auto samples = make_flight(64, 0.0);
+		samples[3].time = 1e9;
+		samples[4].time = -0.0;
+		samples[5].time = std::numeric_limits<double>::quiet_NaN();
+		samples[6].world_time_offset = -std::numeric_limits<float>::infinity();
+		samples[10].location = { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(), -0.0f };
+		samples[11].location = { std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::max(), 1.0f };
+		samples[20].rotation = { -32768, 32767, 0, -1 };
+		samples[21].rotors[2].throttle = 65535;
+		samples[22].rotors[2].throttle = 0;
+		samples[30].has_propulsion = 0;
+
+		const auto decoded = round_trip(samples);
+		for (std::size_t index = 0; index < samples.size(); index++)
+		{
+			REQUIRE(is_bit_exact(decoded[index], samples[index]));
+		}
+	}
+
+	SECTION("Constant samples take a few bits per sample")
+	{
+		const std::vector<physics::FTelemetrySample> samples(1024, make_flight(1, 3.0).front());
+
+		std::vector<std::uint8_t> bytes;
+		physics::flight_record_codec::encode_block(samples, bytes);
+		CHECK(bytes.size() < 1024);
+
+		const auto decoded = round_trip(samples);
+		CHECK(is_bit_exact(decoded.back(), samples.back()));
+	}
+
+	SECTION("Blocks of one and two samples")
+	{
+		const auto samples = make_flight(2, 0.5);
+		CHECK(is_bit_exact(round_trip({ samples[0] }).front(), samples[0]));
+
+		const auto decoded = round_trip(samples);
+		CHECK(is_bit_exact(decoded[0], samples[0]));
+		CHECK(is_bit_exact(decoded[1], samples[1]));
+	}
+
+	SECTION("Wrong sample counts and truncated blocks are rejected")
+	{
+		const auto samples = make_flight(100, 0.0);
+		std::vector<std::uint8_t> bytes;
+		physics::flight_record_codec::encode_block(samples, bytes);
+
+		std::vector<physics::FTelemetrySample> decoded(99);
+		CHECK_FALSE(physics::flight_record_codec::decode_block(bytes, decoded));
+
+		decoded.resize(100);
+		CHECK_FALSE(physics::flight_record_codec::decode_block(std::span(bytes).first(bytes.size() / 2), decoded));
+		CHECK_FALSE(physics::flight_record_codec::decode_block(std::span(bytes).first(4), decoded));
+	}
+}
+
+#endif
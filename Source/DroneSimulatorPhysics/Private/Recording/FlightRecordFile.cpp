@@ -0,0 +1,288 @@
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordFile.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordCodec.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace
+{
+	template <typename T>
+	void write_value(std::ofstream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	bool read_value(std::ifstream& stream, T& out_value)
+	{
+		return static_cast<bool>(stream.read(reinterpret_cast<char*>(&out_value), sizeof(T)));
+	}
+
+	// Long enough for any record of a session
+	constexpr std::uint32_t max_stream_name_length = 4096;
+
+	// Encoded blocks are smaller than the raw samples, this only keeps a corrupted size from allocating gigabytes
+	std::uint64_t get_max_encoded_size(std::uint32_t sample_count)
+	{
+		return 64 + static_cast<std::uint64_t>(sample_count) * sizeof(physics::FTelemetrySample) * 2;
+	}
+}
+
+std::string physics::flight_record_file::get_index_path(const std::string& directory, const std::string& name)
+{
+	return (std::filesystem::path(directory) / (name + ".frindex")).string();
+}
+
+std::string physics::flight_record_file::get_chunk_path(const std::string& index_path, std::uint32_t chunk_number)
+{
+	char suffix[32];
+	std::snprintf(suffix, sizeof(suffix), ".%06u.frchunk", chunk_number);
+
+	auto path = std::filesystem::path(index_path);
+	path.replace_extension();
+	return path.string() + suffix;
+}
+
+bool physics::flight_record_file::write_index(const std::string& index_path, const FFlightRecordIndex& index)
+{
+	const auto temporary_path = index_path + ".tmp";
+	{
+		std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+		if (!stream)
+		{
+			return false;
+		}
+
+		FFlightRecordIndexHeader header;
+		header.samples_per_chunk = static_cast<std::uint32_t>(index.samples_per_chunk);
+		header.stream_count = static_cast<std::uint32_t>(index.stream_names.size());
+		header.chunk_count = static_cast<std::uint32_t>(index.chunks.size());
+		write_value(stream, header);
+
+		for (const auto& stream_name : index.stream_names)
+		{
+			write_value(stream, static_cast<std::uint32_t>(stream_name.size()));
+			stream.write(stream_name.data(), static_cast<std::streamsize>(stream_name.size()));
+		}
+
+		stream.write(reinterpret_cast<const char*>(index.chunks.data()),
+			static_cast<std::streamsize>(index.chunks.size() * sizeof(FFlightRecordChunkInfo)));
+
+		if (!stream.flush())
+		{
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporary_path, index_path, error);
+	return !error;
+}
+
+bool physics::flight_record_file::read_index(const std::string& index_path, FFlightRecordIndex& out_index)
+{
+	std::ifstream stream(index_path, std::ios::binary);
+
+	FFlightRecordIndexHeader header;
+	if (!read_value(stream, header) || header.magic != FFlightRecordIndexHeader::expected_magic
+		|| header.version != FFlightRecordIndexHeader::expected_version)
+	{
+		return false;
+	}
+
+	// Each stream name takes at least its length, and each chunk its info: this keeps corrupted counts from allocating
+	// gigabytes
+	std::error_code error;
+	const auto file_size = std::filesystem::file_size(index_path, error);
+	const auto min_size = sizeof(FFlightRecordIndexHeader) + static_cast<std::uint64_t>(header.stream_count) * sizeof(std::uint32_t)
+		+ static_cast<std::uint64_t>(header.chunk_count) * sizeof(FFlightRecordChunkInfo);
+	if (error || min_size > file_size)
+	{
+		return false;
+	}
+
+	out_index.samples_per_chunk = static_cast<std::int32_t>(header.samples_per_chunk);
+	out_index.stream_names.resize(header.stream_count);
+	for (auto& stream_name : out_index.stream_names)
+	{
+		std::uint32_t length = 0;
+		if (!read_value(stream, length) || length > max_stream_name_length)
+		{
+			return false;
+		}
+
+		stream_name.resize(length);
+		if (!stream.read(stream_name.data(), length))
+		{
+			return false;
+		}
+	}
+
+	out_index.chunks.resize(header.chunk_count);
+	return static_cast<bool>(stream.read(reinterpret_cast<char*>(out_index.chunks.data()),
+		static_cast<std::streamsize>(out_index.chunks.size() * sizeof(FFlightRecordChunkInfo))));
+}
+
+bool physics::flight_record_file::write_chunk(const std::string& chunk_path, std::uint32_t stream_index,
+	std::span<const FTelemetrySample> samples, std::int32_t samples_per_block, const FFlightRecordEntropyCoder* entropy_coder)
+{
+	const auto block_size = static_cast<std::size_t>(std::max(samples_per_block, 1));
+	const auto block_count = (samples.size() + block_size - 1) / block_size;
+
+	FFlightRecordChunkHeader header;
+	header.stream_index = stream_index;
+	header.sample_count = static_cast<std::uint32_t>(samples.size());
+	header.block_count = static_cast<std::uint32_t>(block_count);
+	if (!samples.empty())
+	{
+		header.first_time = samples.front().time;
+		header.last_time = samples.back().time;
+	}
+
+	const auto first_block_offset = sizeof(FFlightRecordChunkHeader) + block_count * sizeof(FFlightRecordBlockInfo);
+	std::vector<FFlightRecordBlockInfo> blocks(block_count);
+	std::vector<std::uint8_t> stored_blocks;
+	std::vector<std::uint8_t> encoded;
+	std::vector<std::uint8_t> compressed;
+	for (std::size_t block_index = 0; block_index < block_count; block_index++)
+	{
+		const auto block_samples = samples.subspan(block_index * block_size, std::min(block_size, samples.size() - block_index * block_size));
+		flight_record_codec::encode_block(block_samples, encoded);
+
+		auto& block = blocks[block_index];
+		block.first_time = block_samples.front().time;
+		block.last_time = block_samples.back().time;
+		block.offset = first_block_offset + stored_blocks.size();
+		block.sample_count = static_cast<std::uint32_t>(block_samples.size());
+		block.encoded_size = static_cast<std::uint32_t>(encoded.size());
+
+		const std::vector<std::uint8_t>* stored = &encoded;
+		if (entropy_coder != nullptr && entropy_coder->compress)
+		{
+			compressed.clear();
+			if (entropy_coder->compress(encoded, compressed) && compressed.size() < encoded.size())
+			{
+				stored = &compressed;
+				block.entropy_coder = entropy_coder->id;
+			}
+		}
+
+		block.stored_size = static_cast<std::uint32_t>(stored->size());
+		stored_blocks.insert(stored_blocks.end(), stored->begin(), stored->end());
+	}
+
+	std::ofstream stream(chunk_path, std::ios::binary | std::ios::trunc);
+	if (!stream)
+	{
+		return false;
+	}
+
+	write_value(stream, header);
+	stream.write(reinterpret_cast<const char*>(blocks.data()), static_cast<std::streamsize>(blocks.size() * sizeof(FFlightRecordBlockInfo)));
+	stream.write(reinterpret_cast<const char*>(stored_blocks.data()), static_cast<std::streamsize>(stored_blocks.size()));
+	return static_cast<bool>(stream.flush());
+}
+
+bool physics::flight_record_file::parse_chunk(std::span<const std::uint8_t> chunk_bytes, FFlightRecordChunkHeader& out_header,
+	std::vector<FFlightRecordBlockInfo>& out_blocks)
+{
+	if (chunk_bytes.size() < sizeof(FFlightRecordChunkHeader))
+	{
+		return false;
+	}
+
+	std::memcpy(&out_header, chunk_bytes.data(), sizeof(FFlightRecordChunkHeader));
+	if (out_header.magic != FFlightRecordChunkHeader::expected_magic || out_header.version != FFlightRecordChunkHeader::expected_version)
+	{
+		return false;
+	}
+
+	const auto first_block_offset = sizeof(FFlightRecordChunkHeader)
+		+ static_cast<std::uint64_t>(out_header.block_count) * sizeof(FFlightRecordBlockInfo);
+	if (first_block_offset > chunk_bytes.size())
+	{
+		return false;
+	}
+
+	out_blocks.resize(out_header.block_count);
+	std::memcpy(out_blocks.data(), chunk_bytes.data() + sizeof(FFlightRecordChunkHeader), out_blocks.size() * sizeof(FFlightRecordBlockInfo));
+
+	std::uint64_t sample_count = 0;
+	for (const auto& block : out_blocks)
+	{
+		if (block.offset < first_block_offset || block.offset > chunk_bytes.size() || block.stored_size > chunk_bytes.size() - block.offset
+			|| block.encoded_size > get_max_encoded_size(block.sample_count))
+		{
+			return false;
+		}
+		sample_count += block.sample_count;
+	}
+
+	return sample_count == out_header.sample_count;
+}
+
+bool physics::flight_record_file::decode_block(std::span<const std::uint8_t> chunk_bytes, const FFlightRecordBlockInfo& block,
+	const FFlightRecordEntropyCoder* entropy_coder, std::vector<std::uint8_t>& scratch, std::span<FTelemetrySample> out_samples)
+{
+	if (out_samples.size() != block.sample_count || block.offset > chunk_bytes.size() || block.stored_size > chunk_bytes.size() - block.offset)
+	{
+		return false;
+	}
+
+	const auto stored = chunk_bytes.subspan(block.offset, block.stored_size);
+	if (block.entropy_coder == 0)
+	{
+		return flight_record_codec::decode_block(stored, out_samples);
+	}
+
+	if (entropy_coder == nullptr || entropy_coder->id != block.entropy_coder || !entropy_coder->decompress
+		|| block.encoded_size > get_max_encoded_size(block.sample_count))
+	{
+		return false;
+	}
+
+	scratch.resize(block.encoded_size);
+	return entropy_coder->decompress(stored, scratch) && flight_record_codec::decode_block(scratch, out_samples);
+}
+
+bool physics::flight_record_file::read_chunk(const std::string& chunk_path, FFlightRecordChunkHeader& out_header,
+	std::vector<FTelemetrySample>& out_samples, const FFlightRecordEntropyCoder* entropy_coder)
+{
+	std::error_code error;
+	const auto file_size = std::filesystem::file_size(chunk_path, error);
+	if (error)
+	{
+		return false;
+	}
+
+	std::ifstream stream(chunk_path, std::ios::binary);
+	std::vector<std::uint8_t> chunk_bytes(file_size);
+	if (!stream.read(reinterpret_cast<char*>(chunk_bytes.data()), static_cast<std::streamsize>(chunk_bytes.size())))
+	{
+		return false;
+	}
+
+	std::vector<FFlightRecordBlockInfo> blocks;
+	if (!parse_chunk(chunk_bytes, out_header, blocks))
+	{
+		return false;
+	}
+
+	out_samples.resize(out_header.sample_count);
+	std::vector<std::uint8_t> scratch;
+	std::size_t first_sample = 0;
+	for (const auto& block : blocks)
+	{
+		if (!decode_block(chunk_bytes, block, entropy_coder, scratch, std::span(out_samples).subspan(first_sample, block.sample_count)))
+		{
+			return false;
+		}
+		first_sample += block.sample_count;
+	}
+
+	return true;
+}
@@ -0,0 +1,327 @@
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordReader.h"
+#include "DroneSimulatorPhysics/Private/Recording/MappedFile.h"
+
+#include <algorithm>
+
+namespace
+{
+	std::uint64_t make_block_key(std::int32_t chunk_position, std::int32_t block_index)
+	{
+		return (static_cast<std::uint64_t>(chunk_position) << 32) | static_cast<std::uint32_t>(block_index);
+	}
+
+	/**
+	 * Index of the last of count items starting at or before time, 0 if none. The hint, then the item after it, are
+	 * checked first: sequential reads mostly stay in the same item or move to the next one.
+	 */
+	template <typename TGetFirstTime>
+	std::size_t find_last_starting_at_or_before(std::size_t count, double time, std::size_t hint, const TGetFirstTime& get_first_time)
+	{
+		for (auto candidate = hint; candidate < count && candidate <= hint + 1; candidate++)
+		{
+			if ((candidate == 0 || get_first_time(candidate) <= time) && (candidate + 1 == count || time < get_first_time(candidate + 1)))
+			{
+				return candidate;
+			}
+		}
+
+		std::size_t low = 0;
+		std::size_t high = count;
+		while (low < high)
+		{
+			const auto middle = low + (high - low) / 2;
+			if (time < get_first_time(middle))
+			{
+				high = middle;
+			}
+			else
+			{
+				low = middle + 1;
+			}
+		}
+		return low == 0 ? 0 : low - 1;
+	}
+
+	// Drops the least recently used entry once there are more than max_count
+	template <typename TMap>
+	void evict_least_recently_used(TMap& map, std::int32_t max_count)
+	{
+		while (static_cast<std::int32_t>(map.size()) > max_count)
+		{
+			const auto oldest = std::min_element(map.begin(), map.end(), [](const auto& a, const auto& b)
+			{
+				return a.second.last_use < b.second.last_use;
+			});
+			map.erase(oldest);
+		}
+	}
+}
+
+physics::FFlightRecordReader::FFlightRecordReader() = default;
+
+physics::FFlightRecordReader::~FFlightRecordReader() = default;
+
+bool physics::FFlightRecordReader::open(const std::string& in_index_path, const FFlightRecordReaderConfig& in_config)
+{
+	this->close();
+
+	this->config = in_config;
+	this->config.max_cached_blocks = std::max(this->config.max_cached_blocks, 1);
+	this->config.max_mapped_chunks = std::max(this->config.max_mapped_chunks, 1);
+
+	if (!flight_record_file::read_index(in_index_path, this->index))
+	{
+		return false;
+	}
+
+	this->index_path = in_index_path;
+	this->streams.resize(this->index.stream_names.size());
+	this->stream_cursors.resize(this->index.stream_names.size());
+	bool has_samples = false;
+	for (std::int32_t chunk_position = 0; chunk_position < static_cast<std::int32_t>(this->index.chunks.size()); chunk_position++)
+	{
+		const auto& chunk = this->index.chunks[chunk_position];
+		if (chunk.stream_index >= this->streams.size() || chunk.sample_count == 0)
+		{
+			continue;
+		}
+
+		this->streams[chunk.stream_index].push_back(chunk_position);
+		this->first_time = has_samples ? std::min(this->first_time, chunk.first_time) : chunk.first_time;
+		this->last_time = has_samples ? std::max(this->last_time, chunk.last_time) : chunk.last_time;
+		has_samples = true;
+	}
+
+	// The writer lists the chunks as they are written, which is in time order within a stream
+	for (auto& stream_chunks : this->streams)
+	{
+		std::stable_sort(stream_chunks.begin(), stream_chunks.end(), [this](std::int32_t a, std::int32_t b)
+		{
+			return this->index.chunks[a].first_time < this->index.chunks[b].first_time;
+		});
+	}
+
+	this->is_index_read = true;
+	return true;
+}
+
+void physics::FFlightRecordReader::close()
+{
+	this->index_path.clear();
+	this->index = FFlightRecordIndex();
+	this->is_index_read = false;
+	this->streams.clear();
+	this->stream_cursors.clear();
+	this->first_time = 0.0;
+	this->last_time = 0.0;
+	this->mapped_chunks.clear();
+	this->decoded_blocks.clear();
+}
+
+std::uint64_t physics::FFlightRecordReader::get_sample_count(std::int32_t stream_index) const
+{
+	if (stream_index < 0 || stream_index >= this->get_stream_count())
+	{
+		return 0;
+	}
+
+	std::uint64_t sample_count = 0;
+	for (const auto chunk_position : this->streams[stream_index])
+	{
+		sample_count += this->index.chunks[chunk_position].sample_count;
+	}
+	return sample_count;
+}
+
+bool physics::FFlightRecordReader::read_samples(std::int32_t stream_index, double begin_time, double end_time,
+	std::vector<FTelemetrySample>& out_samples)
+{
+	if (stream_index < 0 || stream_index >= this->get_stream_count())
+	{
+		out_samples.clear();
+		return false;
+	}
+
+	return this->read_samples(stream_index, begin_time, end_time, out_samples, this->stream_cursors[stream_index]);
+}
+
+bool physics::FFlightRecordReader::read_samples(std::int32_t stream_index, double begin_time, double end_time,
+	std::vector<FTelemetrySample>& out_samples, FReadCursor& cursor)
+{
+	out_samples.clear();
+	if (stream_index < 0 || stream_index >= this->get_stream_count() || this->streams[stream_index].empty())
+	{
+		return stream_index >= 0 && stream_index < this->get_stream_count();
+	}
+
+	// The chunk, then the block, holding the last sample at or before begin_time
+	const auto& stream_chunks = this->streams[stream_index];
+	const auto first_chunk = find_last_starting_at_or_before(stream_chunks.size(), begin_time, cursor.chunk_index,
+		[this, &stream_chunks](std::size_t chunk_index) { return this->index.chunks[stream_chunks[chunk_index]].first_time; });
+
+	for (auto chunk_index = first_chunk; chunk_index < stream_chunks.size(); chunk_index++)
+	{
+		const auto chunk_position = stream_chunks[chunk_index];
+		const auto* mapped_chunk = this->map_chunk(chunk_position);
+		if (mapped_chunk == nullptr)
+		{
+			return false;
+		}
+
+		std::size_t first_block = 0;
+		if (chunk_index == first_chunk)
+		{
+			const auto& blocks = mapped_chunk->blocks;
+			first_block = find_last_starting_at_or_before(blocks.size(), begin_time, cursor.chunk_index == first_chunk ? cursor.block_index : 0,
+				[&blocks](std::size_t block_index) { return blocks[block_index].first_time; });
+			cursor.chunk_index = first_chunk;
+			cursor.block_index = first_block;
+		}
+
+		const auto block_count = mapped_chunk->blocks.size();
+		for (auto block_index = first_block; block_index < block_count; block_index++)
+		{
+			const auto* samples = this->decode_block(chunk_position, static_cast<std::int32_t>(block_index));
+			if (samples == nullptr)
+			{
+				return false;
+			}
+
+			auto begin = samples->begin();
+			if (out_samples.empty())
+			{
+				const auto sample_after = std::upper_bound(samples->begin(), samples->end(), begin_time,
+					[](double time, const FTelemetrySample& sample) { return time < sample.time; });
+				begin = sample_after == samples->begin() ? sample_after : sample_after - 1;
+			}
+
+			const auto end = std::lower_bound(begin, samples->end(), end_time,
+				[](const FTelemetrySample& sample, double time) { return sample.time < time; });
+			if (end != samples->end())
+			{
+				out_samples.insert(out_samples.end(), begin, end + 1);
+				return true;
+			}
+			out_samples.insert(out_samples.end(), begin, end);
+		}
+	}
+
+	return true;
+}
+
+bool physics::FFlightRecordReader::read_times(double begin_time, double end_time, std::int32_t max_count, std::vector<double>& out_times)
+{
+	out_times.clear();
+	if (end_time < begin_time || max_count <= 0)
+	{
+		return true;
+	}
+
+	// Estimated from the chunks overlapping the range, as if their samples were evenly spaced
+	double sample_count = 0.0;
+	for (const auto& chunk : this->index.chunks)
+	{
+		const auto overlap = std::min(chunk.last_time, end_time) - std::max(chunk.first_time, begin_time);
+		if (overlap >= 0.0)
+		{
+			const auto duration = chunk.last_time - chunk.first_time;
+			sample_count += duration > 0.0 ? chunk.sample_count * overlap / duration : chunk.sample_count;
+		}
+	}
+
+	if (sample_count > max_count)
+	{
+		const auto step = (end_time - begin_time) / max_count;
+		for (std::int32_t index = 0; index < max_count; index++)
+		{
+			const auto time = begin_time + (index + 0.5) * step;
+			const auto is_covered = std::any_of(this->streams.begin(), this->streams.end(), [this, time](const std::vector<std::int32_t>& stream_chunks)
+			{
+				const auto chunk_after = std::upper_bound(stream_chunks.begin(), stream_chunks.end(), time,
+					[this](double value, std::int32_t chunk_position) { return value < this->index.chunks[chunk_position].first_time; });
+				return chunk_after != stream_chunks.begin() && time <= this->index.chunks[*(chunk_after - 1)].last_time;
+			});
+			if (is_covered)
+			{
+				out_times.push_back(time);
+			}
+		}
+		return true;
+	}
+
+	std::vector<FTelemetrySample> samples;
+	for (std::int32_t stream_index = 0; stream_index < this->get_stream_count(); stream_index++)
+	{
+		if (!this->read_samples(stream_index, begin_time, end_time, samples))
+		{
+			return false;
+		}
+
+		for (const auto& sample : samples)
+		{
+			if (sample.time >= begin_time && sample.time <= end_time)
+			{
+				out_times.push_back(sample.time);
+			}
+		}
+	}
+
+	std::sort(out_times.begin(), out_times.end());
+	return true;
+}
+
+const physics::FFlightRecordReader::FMappedChunk* physics::FFlightRecordReader::map_chunk(std::int32_t chunk_position)
+{
+	this->use_count++;
+
+	if (const auto found = this->mapped_chunks.find(chunk_position); found != this->mapped_chunks.end())
+	{
+		found->second.last_use = this->use_count;
+		return &found->second;
+	}
+
+	FMappedChunk mapped_chunk;
+	mapped_chunk.file = FMappedFile::open(flight_record_file::get_chunk_path(this->index_path, this->index.chunks[chunk_position].chunk_number));
+	if (mapped_chunk.file == nullptr
+		|| !flight_record_file::parse_chunk(mapped_chunk.file->get_bytes(), mapped_chunk.header, mapped_chunk.blocks))
+	{
+		return nullptr;
+	}
+
+	// Before inserting, so that the new chunk is never the one evicted
+	evict_least_recently_used(this->mapped_chunks, this->config.max_mapped_chunks - 1);
+
+	mapped_chunk.last_use = this->use_count;
+	return &this->mapped_chunks.emplace(chunk_position, std::move(mapped_chunk)).first->second;
+}
+
+const std::vector<physics::FTelemetrySample>* physics::FFlightRecordReader::decode_block(std::int32_t chunk_position, std::int32_t block_index)
+{
+	const auto key = make_block_key(chunk_position, block_index);
+	if (const auto found = this->decoded_blocks.find(key); found != this->decoded_blocks.end())
+	{
+		this->use_count++;
+		found->second.last_use = this->use_count;
+		return &found->second.samples;
+	}
+
+	const auto* mapped_chunk = this->map_chunk(chunk_position);
+	if (mapped_chunk == nullptr || block_index >= static_cast<std::int32_t>(mapped_chunk->blocks.size()))
+	{
+		return nullptr;
+	}
+
+	const auto& block = mapped_chunk->blocks[block_index];
+	FDecodedBlock decoded_block;
+	decoded_block.samples.resize(block.sample_count);
+	if (!flight_record_file::decode_block(mapped_chunk->file->get_bytes(), block, this->config.entropy_coder ? &*this->config.entropy_coder : nullptr,
+		this->decode_scratch, decoded_block.samples))
+	{
+		return nullptr;
+	}
+
+	evict_least_recently_used(this->decoded_blocks, this->config.max_cached_blocks - 1);
+
+	decoded_block.last_use = this->use_count;
+	return &this->decoded_blocks.emplace(key, std::move(decoded_block)).first->second.samples;
+}
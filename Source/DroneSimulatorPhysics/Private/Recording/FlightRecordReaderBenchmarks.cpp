@@ -0,0 +1,86 @@
+#if WITH_DRONE_PHYSICS_BENCHMARKS
+
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordReader.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordWriter.h"
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+	// One drone for about 40 minutes at 400 Hz, one million samples
+	struct FBenchmarkRecord
+	{
+		std::filesystem::path directory = std::filesystem::temp_directory_path() / "DroneSimulatorPhysicsBenchmarks_FlightRecordReader";
+
+		std::string index_path;
+
+		FBenchmarkRecord()
+		{
+			std::filesystem::remove_all(this->directory);
+
+			physics::FFlightRecordWriter writer;
+			writer.open(this->directory.string(), "Session");
+			const auto stream = writer.add_stream("DronePawn_0");
+
+			std::vector<physics::FTelemetrySample> samples(4096);
+			for (std::int32_t chunk = 0; chunk < 256; chunk++)
+			{
+				for (std::int32_t index = 0; index < static_cast<std::int32_t>(samples.size()); index++)
+				{
+					const auto sample_index = chunk * static_cast<std::int32_t>(samples.size()) + index;
+					samples[index].time = sample_index / 400.0;
+					samples[index].location = { static_cast<float>(sample_index), 0.0f, 100.0f };
+				}
+				writer.append(stream, samples);
+			}
+			writer.close();
+
+			this->index_path = writer.get_index_path();
+		}
+
+		~FBenchmarkRecord()
+		{
+			std::filesystem::remove_all(this->directory);
+		}
+	};
+}
+
+// One read per editor frame at 60 Hz, playing at real time, as the playback does for each drone
+static void BM_FlightRecordReaderPlayback(benchmark::State& state)
+{
+	static const FBenchmarkRecord record;
+	physics::FFlightRecordReader reader;
+	reader.open(record.index_path);
+	std::vector<physics::FTelemetrySample> samples;
+
+	double time = 0.0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(reader.read_samples(0, time, time, samples));
+		time = time + 1.0 / 60.0 < reader.get_last_time() ? time + 1.0 / 60.0 : 0.0;
+	}
+}
+BENCHMARK(BM_FlightRecordReaderPlayback);
+
+// Scrubbing the timeline: reads at times far apart, decoding a block each
+static void BM_FlightRecordReaderScrub(benchmark::State& state)
+{
+	static const FBenchmarkRecord record;
+	physics::FFlightRecordReader reader;
+	reader.open(record.index_path);
+	std::vector<physics::FTelemetrySample> samples;
+
+	std::uint32_t noise = 12345;
+	for (auto _ : state)
+	{
+		noise = noise * 1664525u + 1013904223u;
+		const auto time = static_cast<double>(noise >> 8) / (1 << 24) * reader.get_last_time();
+		benchmark::DoNotOptimize(reader.read_samples(0, time, time, samples));
+	}
+}
+BENCHMARK(BM_FlightRecordReaderScrub);
+
+#endif
@@ -0,0 +1,176 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Private/Recording/TestFlightRecord.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordReader.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordWriter.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+	using physics::test_flight_record::FTemporaryDirectory;
+	using physics::test_flight_record::make_samples;
+
+	// 1000 samples of DronePawn_0 from 0 s, 100 of DronePawn_1 from 1 s, in chunks of 100 and blocks of 16
+	std::string write_record(const FTemporaryDirectory& directory)
+	{
+		physics::FFlightRecordWriterConfig config;
+		config.samples_per_chunk = 100;
+		config.samples_per_block = 16;
+
+		physics::FFlightRecordWriter writer;
+		REQUIRE(writer.open(directory.path.string(), "Session", config));
+		const auto first = writer.add_stream("DronePawn_0");
+		const auto second = writer.add_stream("DronePawn_1");
+		writer.append(first, make_samples(1000, 0.0));
+		writer.append(second, make_samples(100, 1.0));
+		writer.close();
+		REQUIRE_FALSE(writer.has_failed());
+		return writer.get_index_path();
+	}
+}
+
+TEST_CASE("Flight record reader", "[recording]")
+{
+	FTemporaryDirectory directory("DroneSimulatorPhysicsTests_FlightRecordReader");
+	const auto index_path = write_record(directory);
+
+	physics::FFlightRecordReaderConfig config;
+	config.max_cached_blocks = 2;
+	config.max_mapped_chunks = 2;
+
+	physics::FFlightRecordReader reader;
+	REQUIRE(reader.open(index_path, config));
+	REQUIRE(reader.get_stream_count() == 2);
+	CHECK(reader.get_stream_names()[1] == "DronePawn_1");
+	CHECK(reader.get_first_time() == 0.0);
+	CHECK(reader.get_last_time() == 999 / 400.0);
+	CHECK(reader.get_sample_count(0) == 1000);
+	CHECK(reader.get_sample_count(1) == 100);
+
+	SECTION("Reads bracket the time range, across blocks and chunks")
+	{
+		std::vector<physics::FTelemetrySample> samples;
+		REQUIRE(reader.read_samples(0, 90.5 / 400.0, 250.5 / 400.0, samples));
+		REQUIRE(samples.size() == 162);
+		CHECK(samples.front().location[0] == 90.0f);
+		CHECK(samples.back().location[0] == 251.0f);
+		for (std::size_t index = 1; index < samples.size(); index++)
+		{
+			REQUIRE(samples[index].location[0] == samples[index - 1].location[0] + 1.0f);
+		}
+
+		// A single time gives the samples to interpolate between, or the exact one
+		REQUIRE(reader.read_samples(0, 99.5 / 400.0, 99.5 / 400.0, samples));
+		REQUIRE(samples.size() == 2);
+		CHECK(samples[0].location[0] == 99.0f);
+		CHECK(samples[1].location[0] == 100.0f);
+
+		REQUIRE(reader.read_samples(0, 512 / 400.0, 512 / 400.0, samples));
+		REQUIRE(samples.size() == 1);
+		CHECK(samples[0].location[0] == 512.0f);
+	}
+
+	SECTION("Sequential, backward and jumping reads find the same samples")
+	{
+		// Stepping at a time not aligned with the samples, forward through the whole stream and back
+		std::vector<double> read_times;
+		for (std::int32_t step = 0; step < 700; step++)
+		{
+			read_times.push_back(-0.1 + step * 1.5 / 400.0);
+		}
+		for (std::int32_t step = 700; step > 0; step--)
+		{
+			read_times.push_back(step * 1.5 / 400.0);
+		}
+		read_times.insert(read_times.end(), { 2.2, 0.01, 1.3, 1.31, 0.4 });
+
+		// Expected by scanning all the written samples
+		const auto written = make_samples(1000, 0.0);
+		const auto is_before = [](const physics::FTelemetrySample& sample, double time) { return sample.time < time; };
+
+		std::vector<physics::FTelemetrySample> samples;
+		for (const auto time : read_times)
+		{
+			REQUIRE(reader.read_samples(0, time, time, samples));
+			REQUIRE_FALSE(samples.empty());
+
+			const auto after = std::min<std::ptrdiff_t>(std::lower_bound(written.begin(), written.end(), time, is_before) - written.begin(), 999);
+			const auto before = written[after].time <= time ? after : std::max<std::ptrdiff_t>(after - 1, 0);
+			CHECK(samples.front().location[0] == static_cast<float>(before));
+			CHECK(samples.back().location[0] == static_cast<float>(after));
+		}
+	}
+
+	SECTION("Reads with their own cursor interleave with the playback")
+	{
+		// A trail around the playhead, read between two playhead reads
+		physics::FFlightRecordReader::FReadCursor trail_cursor;
+
+		std::vector<physics::FTelemetrySample> samples;
+		std::vector<physics::FTelemetrySample> trail_samples;
+		for (std::int32_t step = 0; step < 300; step++)
+		{
+			const auto time = step * 3.0 / 400.0;
+			REQUIRE(reader.read_samples(0, (step * 3 - 199.5) / 400.0, (step * 3 + 199.5) / 400.0, trail_samples, trail_cursor));
+			REQUIRE(reader.read_samples(0, time, time, samples));
+
+			REQUIRE_FALSE(samples.empty());
+			CHECK(samples.front().location[0] == static_cast<float>(step * 3));
+			CHECK(trail_samples.front().location[0] == static_cast<float>(std::max(step * 3 - 200, 0)));
+		}
+	}
+
+	SECTION("Reads past the ends stop at the first or last sample")
+	{
+		std::vector<physics::FTelemetrySample> samples;
+		REQUIRE(reader.read_samples(1, -5.0, 0.5, samples));
+		REQUIRE(samples.size() == 1);
+		CHECK(samples[0].time == 1.0);
+
+		REQUIRE(reader.read_samples(1, 10.0, 20.0, samples));
+		REQUIRE(samples.size() == 1);
+		CHECK(samples[0].location[0] == 99.0f);
+
+		CHECK_FALSE(reader.read_samples(2, 0.0, 1.0, samples));
+	}
+
+	SECTION("Only the chunks that are read are opened")
+	{
+		// Chunks are numbered in the order they were written, chunk 0 holds the first 100 samples of DronePawn_0
+		std::filesystem::remove(physics::flight_record_file::get_chunk_path(index_path, 0));
+
+		physics::FFlightRecordReader other_reader;
+		REQUIRE(other_reader.open(index_path, config));
+
+		std::vector<physics::FTelemetrySample> samples;
+		CHECK(other_reader.read_samples(0, 2.0, 2.1, samples));
+		CHECK_FALSE(other_reader.read_samples(0, 0.1, 0.2, samples));
+	}
+
+	SECTION("Times are those of the samples, or evenly spaced when there are too many")
+	{
+		std::vector<double> times;
+		REQUIRE(reader.read_times(1.0, 1.1, 1000, times));
+		CHECK(times.size() == 2 * 41);
+		CHECK(std::is_sorted(times.begin(), times.end()));
+
+		REQUIRE(reader.read_times(-10.0, 10.0, 100, times));
+		CHECK(times.size() == 12);
+		CHECK(times.front() > 0.0);
+		CHECK(times.back() < reader.get_last_time());
+	}
+
+	SECTION("A missing index can't be opened")
+	{
+		physics::FFlightRecordReader other_reader;
+		CHECK_FALSE(other_reader.open((directory.path / "Missing.frindex").string()));
+		CHECK_FALSE(other_reader.is_open());
+	}
+}
+
+#endif
@@ -0,0 +1,193 @@
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordWriter.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+physics::FFlightRecordWriter::~FFlightRecordWriter()
+{
+	this->close();
+}
+
+bool physics::FFlightRecordWriter::open(const std::string& directory, const std::string& name, const FFlightRecordWriterConfig& in_config)
+{
+	this->close();
+
+	this->config = in_config;
+	this->config.samples_per_chunk = std::max(this->config.samples_per_chunk, 1);
+	this->config.samples_per_block = std::max(this->config.samples_per_block, 1);
+	this->config.max_pending_chunks = std::max(this->config.max_pending_chunks, 1);
+
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+
+	this->index_path = flight_record_file::get_index_path(directory, name);
+	this->index = FFlightRecordIndex();
+	this->index.samples_per_chunk = this->config.samples_per_chunk;
+	if (!flight_record_file::write_index(this->index_path, this->index))
+	{
+		return false;
+	}
+
+	this->open_chunks.clear();
+	this->next_chunk_number = 0;
+	this->pending_chunks.clear();
+	this->free_buffers.clear();
+	this->is_closing = false;
+	this->has_write_failed.store(false, std::memory_order_relaxed);
+
+	this->writer_thread = std::thread([this] { this->run(); });
+	return true;
+}
+
+std::int32_t physics::FFlightRecordWriter::add_stream(const std::string& stream_name)
+{
+	std::vector<FTelemetrySample> chunk;
+	chunk.reserve(this->config.samples_per_chunk);
+	this->open_chunks.push_back(std::move(chunk));
+
+	std::lock_guard lock(this->mutex);
+	this->index.stream_names.push_back(stream_name);
+	return static_cast<std::int32_t>(this->index.stream_names.size()) - 1;
+}
+
+void physics::FFlightRecordWriter::append(std::int32_t stream_index, std::span<const FTelemetrySample> samples)
+{
+	if (!this->is_open() || stream_index < 0 || stream_index >= static_cast<std::int32_t>(this->open_chunks.size()))
+	{
+		return;
+	}
+
+	while (!samples.empty())
+	{
+		auto& chunk = this->open_chunks[stream_index];
+		const auto count = std::min(samples.size(), static_cast<std::size_t>(this->config.samples_per_chunk) - chunk.size());
+		chunk.insert(chunk.end(), samples.begin(), samples.begin() + count);
+		samples = samples.subspan(count);
+
+		if (chunk.size() >= static_cast<std::size_t>(this->config.samples_per_chunk))
+		{
+			this->hand_off(stream_index);
+		}
+	}
+}
+
+void physics::FFlightRecordWriter::close()
+{
+	if (!this->is_open())
+	{
+		return;
+	}
+
+	for (std::int32_t stream_index = 0; stream_index < static_cast<std::int32_t>(this->open_chunks.size()); stream_index++)
+	{
+		if (!this->open_chunks[stream_index].empty())
+		{
+			this->hand_off(stream_index);
+		}
+	}
+
+	{
+		std::lock_guard lock(this->mutex);
+		this->is_closing = true;
+	}
+	this->chunk_pending.notify_one();
+	this->writer_thread.join();
+
+	this->open_chunks.clear();
+	this->free_buffers.clear();
+}
+
+std::vector<std::string> physics::FFlightRecordWriter::get_chunk_paths() const
+{
+	std::lock_guard lock(this->mutex);
+
+	std::vector<std::string> paths;
+	paths.reserve(this->index.chunks.size());
+	for (const auto& chunk : this->index.chunks)
+	{
+		paths.push_back(flight_record_file::get_chunk_path(this->index_path, chunk.chunk_number));
+	}
+	return paths;
+}
+
+void physics::FFlightRecordWriter::hand_off(std::int32_t stream_index)
+{
+	FPendingChunk pending_chunk;
+	pending_chunk.stream_index = static_cast<std::uint32_t>(stream_index);
+	pending_chunk.chunk_number = this->next_chunk_number;
+	this->next_chunk_number++;
+
+	{
+		std::unique_lock lock(this->mutex);
+		this->chunk_written.wait(lock, [this]
+		{
+			return static_cast<std::int32_t>(this->pending_chunks.size()) < this->config.max_pending_chunks;
+		});
+
+		pending_chunk.samples = std::move(this->open_chunks[stream_index]);
+		if (!this->free_buffers.empty())
+		{
+			this->open_chunks[stream_index] = std::move(this->free_buffers.back());
+			this->free_buffers.pop_back();
+		}
+		else
+		{
+			this->open_chunks[stream_index] = std::vector<FTelemetrySample>();
+			this->open_chunks[stream_index].reserve(this->config.samples_per_chunk);
+		}
+
+		this->pending_chunks.push_back(std::move(pending_chunk));
+	}
+
+	this->chunk_pending.notify_one();
+}
+
+void physics::FFlightRecordWriter::run()
+{
+	while (true)
+	{
+		FPendingChunk chunk;
+		{
+			std::unique_lock lock(this->mutex);
+			this->chunk_pending.wait(lock, [this] { return !this->pending_chunks.empty() || this->is_closing; });
+			if (this->pending_chunks.empty())
+			{
+				return;
+			}
+
+			chunk = std::move(this->pending_chunks.front());
+			this->pending_chunks.pop_front();
+		}
+
+		const auto chunk_path = flight_record_file::get_chunk_path(this->index_path, chunk.chunk_number);
+		const auto is_written = flight_record_file::write_chunk(chunk_path, chunk.stream_index, chunk.samples, this->config.samples_per_block,
+			this->config.entropy_coder ? &*this->config.entropy_coder : nullptr);
+
+		FFlightRecordIndex index_copy;
+		{
+			std::lock_guard lock(this->mutex);
+			if (is_written)
+			{
+				FFlightRecordChunkInfo info;
+				info.stream_index = chunk.stream_index;
+				info.chunk_number = chunk.chunk_number;
+				info.sample_count = static_cast<std::uint32_t>(chunk.samples.size());
+				info.first_time = chunk.samples.front().time;
+				info.last_time = chunk.samples.back().time;
+				this->index.chunks.push_back(info);
+				index_copy = this->index;
+			}
+
+			chunk.samples.clear();
+			this->free_buffers.push_back(std::move(chunk.samples));
+		}
+		this->chunk_written.notify_one();
+
+		// Outside of the lock, the index is only ever written by this thread
+		if (!is_written || !flight_record_file::write_index(this->index_path, index_copy))
+		{
+			this->has_write_failed.store(true, std::memory_order_relaxed);
+		}
+	}
+}
@@ -0,0 +1,201 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Private/Recording/TestFlightRecord.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordFile.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordWriter.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	using physics::test_flight_record::FTemporaryDirectory;
+	using physics::test_flight_record::make_samples;
+
+	// Drops the trailing zeros, enough to tell whether the coder ran
+	physics::FFlightRecordEntropyCoder make_trimming_coder()
+	{
+		physics::FFlightRecordEntropyCoder coder;
+		coder.id = 7;
+		coder.compress = [](std::span<const std::uint8_t> bytes, std::vector<std::uint8_t>& out_compressed)
+		{
+			auto end = bytes.end();
+			while (end != bytes.begin() && *(end - 1) == 0)
+			{
+				--end;
+			}
+			out_compressed.assign(bytes.begin(), end);
+			return true;
+		};
+		coder.decompress = [](std::span<const std::uint8_t> compressed, std::span<std::uint8_t> out_bytes)
+		{
+			if (compressed.size() > out_bytes.size())
+			{
+				return false;
+			}
+			std::fill(std::copy(compressed.begin(), compressed.end(), out_bytes.begin()), out_bytes.end(), 0);
+			return true;
+		};
+		return coder;
+	}
+}
+
+TEST_CASE("Flight record writer", "[recording]")
+{
+	FTemporaryDirectory directory("DroneSimulatorPhysicsTests_FlightRecord");
+
+	SECTION("Streams are split in chunks, the index lists them")
+	{
+		physics::FFlightRecordWriterConfig config;
+		config.samples_per_chunk = 100;
+		config.samples_per_block = 32;
+		config.max_pending_chunks = 2;
+
+		physics::FFlightRecordWriter writer;
+		REQUIRE(writer.open(directory.path.string(), "Session", config));
+		const auto first = writer.add_stream("DronePawn_0");
+		const auto second = writer.add_stream("DronePawn_1");
+
+		// Uneven batches, like the frames of the game thread
+		const auto first_samples = make_samples(250, 0.0);
+		for (std::size_t begin = 0; begin < first_samples.size(); begin += 7)
+		{
+			writer.append(first, std::span(first_samples).subspan(begin, std::min<std::size_t>(7, first_samples.size() - begin)));
+		}
+		const auto second_samples = make_samples(30, 1.0);
+		writer.append(second, second_samples);
+		writer.close();
+		CHECK_FALSE(writer.has_failed());
+
+		physics::FFlightRecordIndex index;
+		REQUIRE(physics::flight_record_file::read_index(writer.get_index_path(), index));
+		CHECK(index.samples_per_chunk == 100);
+		CHECK(index.stream_names == std::vector<std::string> { "DronePawn_0", "DronePawn_1" });
+		REQUIRE(index.chunks.size() == 4);
+		CHECK(writer.get_chunk_paths().size() == 4);
+
+		std::vector<physics::FTelemetrySample> read_samples;
+		for (const auto& chunk : index.chunks)
+		{
+			if (chunk.stream_index != static_cast<std::uint32_t>(first))
+			{
+				CHECK(chunk.sample_count == 30);
+				CHECK(chunk.first_time == 1.0);
+				continue;
+			}
+
+			physics::FFlightRecordChunkHeader header;
+			std::vector<physics::FTelemetrySample> samples;
+			REQUIRE(physics::flight_record_file::read_chunk(physics::flight_record_file::get_chunk_path(writer.get_index_path(),
+				chunk.chunk_number), header, samples));
+			CHECK(header.sample_count == chunk.sample_count);
+			CHECK(header.first_time == chunk.first_time);
+			CHECK(header.block_count == (chunk.sample_count + 31) / 32);
+			read_samples.insert(read_samples.end(), samples.begin(), samples.end());
+		}
+
+		REQUIRE(read_samples.size() == first_samples.size());
+		for (std::size_t index_in_stream = 0; index_in_stream < read_samples.size(); index_in_stream++)
+		{
+			REQUIRE(read_samples[index_in_stream].time == first_samples[index_in_stream].time);
+			REQUIRE(read_samples[index_in_stream].location == first_samples[index_in_stream].location);
+		}
+	}
+
+	SECTION("The index on disk always lists whole chunks")
+	{
+		physics::FFlightRecordWriterConfig config;
+		config.samples_per_chunk = 10;
+
+		physics::FFlightRecordWriter writer;
+		REQUIRE(writer.open(directory.path.string(), "Crash", config));
+		const auto stream = writer.add_stream("DronePawn_0");
+		writer.append(stream, make_samples(25, 0.0));
+
+		// Without closing, as after a crash: the full chunks show up once written, the open one doesn't
+		physics::FFlightRecordIndex index;
+		for (std::int32_t attempt = 0; attempt < 5000 && index.chunks.size() < 2; attempt++)
+		{
+			REQUIRE(physics::flight_record_file::read_index(writer.get_index_path(), index));
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		CHECK(index.chunks.size() == 2);
+
+		writer.close();
+		REQUIRE(physics::flight_record_file::read_index(writer.get_index_path(), index));
+		REQUIRE(index.chunks.size() == 3);
+		CHECK(index.chunks[2].sample_count == 5);
+	}
+
+	SECTION("Blocks compressed by an entropy coder need that coder to be read")
+	{
+		physics::FFlightRecordWriterConfig config;
+		config.entropy_coder = make_trimming_coder();
+
+		physics::FFlightRecordWriter writer;
+		REQUIRE(writer.open(directory.path.string(), "Compressed", config));
+		const auto samples = make_samples(50, 0.0);
+		writer.append(writer.add_stream("DronePawn_0"), samples);
+		writer.close();
+
+		const auto chunk_path = writer.get_chunk_paths().front();
+		physics::FFlightRecordChunkHeader header;
+		std::vector<physics::FTelemetrySample> read_samples;
+		CHECK_FALSE(physics::flight_record_file::read_chunk(chunk_path, header, read_samples));
+
+		const auto coder = make_trimming_coder();
+		REQUIRE(physics::flight_record_file::read_chunk(chunk_path, header, read_samples, &coder));
+		REQUIRE(read_samples.size() == samples.size());
+		CHECK(read_samples.back().time == samples.back().time);
+		CHECK(read_samples.back().location == samples.back().location);
+	}
+
+	SECTION("Truncated chunks are rejected")
+	{
+		physics::FFlightRecordWriter writer;
+		REQUIRE(writer.open(directory.path.string(), "Truncated"));
+		writer.append(writer.add_stream("DronePawn_0"), make_samples(20, 0.0));
+		writer.close();
+
+		const auto chunk_path = writer.get_chunk_paths().front();
+		std::filesystem::resize_file(chunk_path, std::filesystem::file_size(chunk_path) - 64);
+
+		physics::FFlightRecordChunkHeader header;
+		std::vector<physics::FTelemetrySample> samples;
+		CHECK_FALSE(physics::flight_record_file::read_chunk(chunk_path, header, samples));
+	}
+
+	SECTION("Index counts past the end of the file are rejected")
+	{
+		physics::FFlightRecordWriter writer;
+		REQUIRE(writer.open(directory.path.string(), "Corrupted"));
+		writer.append(writer.add_stream("DronePawn_0"), make_samples(20, 0.0));
+		writer.close();
+
+		const auto patch_count = [&](std::size_t offset, std::uint32_t count)
+		{
+			std::fstream stream(writer.get_index_path(), std::ios::binary | std::ios::in | std::ios::out);
+			stream.seekp(static_cast<std::streamoff>(offset));
+			stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+		};
+
+		physics::FFlightRecordIndex index;
+		REQUIRE(physics::flight_record_file::read_index(writer.get_index_path(), index));
+
+		patch_count(offsetof(physics::FFlightRecordIndexHeader, chunk_count), 0x40000000);
+		CHECK_FALSE(physics::flight_record_file::read_index(writer.get_index_path(), index));
+
+		patch_count(offsetof(physics::FFlightRecordIndexHeader, chunk_count), 1);
+		patch_count(offsetof(physics::FFlightRecordIndexHeader, stream_count), 0xFFFFFFFF);
+		CHECK_FALSE(physics::flight_record_file::read_index(writer.get_index_path(), index));
+	}
+}
+
+#endif
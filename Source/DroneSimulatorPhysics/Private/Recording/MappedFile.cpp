@@ -0,0 +1,105 @@
+#include "DroneSimulatorPhysics/Private/Recording/MappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+
+std::unique_ptr<physics::FMappedFile> physics::FMappedFile::open(const std::string& path)
+{
+	auto* file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return nullptr;
+	}
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	// The mapping keeps the file open
+	auto* handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (handle == nullptr)
+	{
+		return nullptr;
+	}
+
+	const auto* data = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr)
+	{
+		CloseHandle(handle);
+		return nullptr;
+	}
+
+	auto mapped_file = std::unique_ptr<FMappedFile>(new FMappedFile());
+	mapped_file->data = data;
+	mapped_file->size = static_cast<std::size_t>(file_size.QuadPart);
+	mapped_file->handle = handle;
+	return mapped_file;
+}
+
+physics::FMappedFile::~FMappedFile()
+{
+	if (this->data != nullptr)
+	{
+		UnmapViewOfFile(this->data);
+	}
+
+	if (this->handle != nullptr)
+	{
+		CloseHandle(this->handle);
+	}
+}
+
+#else
+
+std::unique_ptr<physics::FMappedFile> physics::FMappedFile::open(const std::string& path)
+{
+	const int file_descriptor = ::open(path.c_str(), O_RDONLY);
+	if (file_descriptor < 0)
+	{
+		return nullptr;
+	}
+
+	struct stat file_stat;
+	if (fstat(file_descriptor, &file_stat) != 0 || file_stat.st_size <= 0)
+	{
+		close(file_descriptor);
+		return nullptr;
+	}
+
+	const auto size = static_cast<std::size_t>(file_stat.st_size);
+	auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+	close(file_descriptor);
+	if (data == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	auto mapped_file = std::unique_ptr<FMappedFile>(new FMappedFile());
+	mapped_file->data = data;
+	mapped_file->size = size;
+	return mapped_file;
+}
+
+physics::FMappedFile::~FMappedFile()
+{
+	if (this->data != nullptr)
+	{
+		munmap(const_cast<void*>(this->data), this->size);
+	}
+}
+
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace physics
+{
+	/**
+	 * Read-only memory mapping of a whole file. Pages are read from disk when first touched, and the system can drop them
+	 * again under memory pressure.
+	 */
+	class FMappedFile
+	{
+	public:
+
+		// @return null if the file is missing or empty
+		static std::unique_ptr<FMappedFile> open(const std::string& path);
+
+		~FMappedFile();
+
+		FMappedFile(const FMappedFile&) = delete;
+		FMappedFile& operator=(const FMappedFile&) = delete;
+
+		std::span<const std::uint8_t> get_bytes() const { return { static_cast<const std::uint8_t*>(this->data), this->size }; }
+
+	private:
+
+		FMappedFile() = default;
+
+		const void* data = nullptr;
+
+		std::size_t size = 0;
+
+		// Mapping handle on Windows
+		void* handle = nullptr;
+	};
+}
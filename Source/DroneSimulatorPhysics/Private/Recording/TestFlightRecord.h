@@ -0,0 +1,44 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/Simulation/TelemetrySample.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Samples and files of the flight record tests
+namespace physics::test_flight_record
+{
+	// count samples at 400 Hz from first_time, each at x = its index
+	inline std::vector<FTelemetrySample> make_samples(std::int32_t count, double first_time)
+	{
+		std::vector<FTelemetrySample> samples(count);
+		for (std::int32_t index = 0; index < count; index++)
+		{
+			samples[index].time = first_time + index / 400.0;
+			samples[index].location = { static_cast<float>(index), 0.0f, 100.0f };
+		}
+		return samples;
+	}
+
+	// Emptied when created and removed when destroyed. Each test file uses its own name, test files can run in parallel.
+	struct FTemporaryDirectory
+	{
+		std::filesystem::path path;
+
+		explicit FTemporaryDirectory(const std::string& name)
+			: path(std::filesystem::temp_directory_path() / name)
+		{
+			std::filesystem::remove_all(this->path);
+		}
+
+		~FTemporaryDirectory()
+		{
+			std::filesystem::remove_all(this->path);
+		}
+
+		FTemporaryDirectory(const FTemporaryDirectory&) = delete;
+		FTemporaryDirectory& operator=(const FTemporaryDirectory&) = delete;
+	};
+}
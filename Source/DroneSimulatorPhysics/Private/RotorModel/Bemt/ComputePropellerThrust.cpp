@@ -0,0 +1,275 @@
+#include "DroneSimulatorPhysics/Public/RotorModel/Bemt/ComputePropellerThrust.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/RotorModel/Bemt/AirfoilCoefficients.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace physics
+{
+namespace
+{
+	/**
+	 * Gets the pitch (in rad) at a given radius (in meters)
+	 */
+	double get_pitch_angle_at_radius(double radius, const FDronePropellerBemt* propeller)
+	{
+		const double pitch = std::atan2(propeller->pitch, radius * math::two_pi);
+		return pitch;
+	}
+
+	constexpr int blade_elements_count = 5;
+
+	constexpr int integrations = 6;
+	constexpr double integration_relaxation = 0.8;
+
+	constexpr int a_prime_integrations = 4;
+	constexpr double a_prime_relaxation = 0.7;
+
+	struct FIntegrationResult
+	{
+		double thrust = 0.0; // In Newtons
+		double torque = 0.0; // In N.m
+		double angle_of_attack = 0.0; // In radians
+		std::vector<double> reynolds = {};
+
+		FDebugLog debug_log;
+	};
+
+	double compute_prandtl_factor(int B, double r, double R, double Rhub, double phi)
+	{
+		const double sinphi = std::max(1e-6, std::sin(std::abs(phi)));
+
+		// Tip and root factors
+		const double f_tip  = (B * 0.5) * (R - r)   / (r * sinphi);
+		const double f_root = (B * 0.5) * (r - Rhub)/ (r * sinphi);
+
+		const double F_tip  = (2.0 / math::pi) * std::acos(math::clamp(std::exp(-f_tip),  0.0, 1.0));
+		const double F_root = (2.0 / math::pi) * std::acos(math::clamp(std::exp(-f_root), 0.0, 1.0));
+
+		// Combine & clamp for numerical safety
+		return math::clamp(F_tip * F_root, 1e-3, 1.0);
+	}
+
+	/**
+	 * @param v_axial Axial velocity in the airflow tube, in m/s. Positive when air velocity is downstream.
+	 * @param v_induced Estimate of the velocity induced by the propeller disk, in m/s. Positive when air velocity is downstream.
+	 * @param propeller Properties of the propeller
+	 * @param air_density Air density, in kg/m^3
+	 * @param propeller_angular_speed Angular velocity of the propeller, in rad/s
+	 */
+	FIntegrationResult integrate_with_v_induced(double v_axial, double v_induced, const FDronePropellerBemt* propeller,
+		double air_density, double propeller_angular_speed)
+	{
+		FIntegrationResult result;
+
+		const double element_width = (propeller->radius - propeller->hub_radius) / static_cast<double>(blade_elements_count);
+		double angle_of_attack_accumulator = 0.0;
+
+		// Axial component at the disk (global for this pass; local a' inside)
+		const double Vx_disk = v_axial + v_induced; // downstream-positive
+
+		const int representative_index = math::round_to_int(0.7 * blade_elements_count);
+
+		result.reynolds.reserve(blade_elements_count);
+
+		for (int i = 0; i < blade_elements_count; ++i)
+		{
+			// 1/2 offset quadrature
+			const double element_radius = propeller->hub_radius + (i + 0.5) * element_width;
+
+			// Solve local tangential induction a'(r) with a few relaxed iterations
+			double a_prime = 0.0;
+			for (int k = 0; k < a_prime_integrations; ++k)
+			{
+				const double Vtheta = propeller_angular_speed * element_radius * (1.0 + a_prime);
+				const double wind_speed = std::sqrt(math::square(Vx_disk) + math::square(Vtheta));
+				const double inflow_angle = std::atan2(Vx_disk, Vtheta); // inflow angle, often named phi
+
+				const double theta_b = get_pitch_angle_at_radius(element_radius, propeller);
+				const double aoa = theta_b - inflow_angle;
+
+				// Aerodynamics
+
+				constexpr double kinematic_viscosity = 1.5e-5; // m^2/s
+				const double reynolds = (wind_speed * propeller->chord) / kinematic_viscosity;
+
+				const auto coefficients_result = simulation_bemt::interpolate_airfoil_coefficients(reynolds, aoa, propeller->airfoil);
+
+				// If interpolation failed, use sensible defaults
+				const auto coefficients = coefficients_result.value_or(FAirfoilCoefficients::get_sensible_defaults());
+
+				const auto lift_coefficient = coefficients.lift;
+				const auto drag_coefficient = coefficients.drag;
+
+				const double dynamic_pressure = 0.5 * air_density * wind_speed * wind_speed;
+
+				// Per-blade element forces
+				const double dL = dynamic_pressure * propeller->chord * lift_coefficient * element_width;
+				const double dD = dynamic_pressure * propeller->chord * drag_coefficient * element_width;
+
+				// Resolve to thrust/torque (sum over blades)
+				const double s = std::sin(inflow_angle);
+				const double c = std::cos(inflow_angle);
+
+				const double dQ_BE = propeller->num_blades * (dL * s + dD * c) * element_radius;
+
+				// Prandtl factor
+				const double prandtl_factor = compute_prandtl_factor(propeller->num_blades, element_radius, propeller->radius, propeller->hub_radius, inflow_angle);
+
+				// Momentum torque model: dQ_MT = 4πρ F r^3 Vx Ω a' dr  =>  a' = dQ_BE / (4πρ F r^3 Vx Ω dr)
+				const double denom = 4.0 * math::pi * air_density * prandtl_factor * std::max(1e-6, Vx_disk)
+					* propeller_angular_speed * element_radius * element_radius * element_radius * std::max(1e-9, element_width);
+
+				const double a_prime_new = math::clamp(dQ_BE / denom, -0.5, 0.5);
+
+				// Light relaxation for stability
+				a_prime = a_prime_relaxation * a_prime + (1.0 - a_prime_relaxation) * a_prime_new;
+
+				// Optional: early exit if converged
+				if (std::abs(a_prime_new - a_prime) < 1e-4)
+				{
+					break;
+				}
+			}
+
+			// Final pass to accumulate loads with converged a'
+			const double Vtheta = propeller_angular_speed * element_radius * (1.0 + a_prime);
+			const double wind_speed = std::sqrt(math::square(Vx_disk) + math::square(Vtheta));
+			const double inflow_angle = std::atan2(Vx_disk, Vtheta);  // inflow angle, often named phi
+
+			const double element_pitch_angle = get_pitch_angle_at_radius(element_radius, propeller);
+			const double angle_of_attack = element_pitch_angle - inflow_angle;
+			angle_of_attack_accumulator += angle_of_attack;
+
+			// Calculate Reynolds number: Re = (density * velocity * chord) / dynamic_viscosity
+			// For air at sea level, kinematic viscosity is approximately 1.5e-5 m^2/s
+			constexpr double kinematic_viscosity = 1.5e-5; // m^2/s
+			const double reynolds = (wind_speed * propeller->chord) / kinematic_viscosity;
+
+			const auto coefficients_result = simulation_bemt::interpolate_airfoil_coefficients(reynolds, angle_of_attack, propeller->airfoil);
+
+			// If interpolation failed, use sensible defaults
+			const auto coefficients = coefficients_result.value_or(FAirfoilCoefficients::get_sensible_defaults());
+
+			const double lift_coefficient = coefficients.lift;
+			const double drag_coefficient = coefficients.drag;
+
+			const double dynamic_pressure  = 0.5 * air_density * wind_speed * wind_speed;
+			const double element_lift = dynamic_pressure * propeller->chord * lift_coefficient * element_width;
+			const double element_drag = dynamic_pressure * propeller->chord * drag_coefficient * element_width;
+
+			const double inflow_angle_sin = std::sin(inflow_angle);
+			const double inflow_angle_cos = std::cos(inflow_angle);
+
+			const double element_thrust = propeller->num_blades * (element_lift * inflow_angle_cos - element_drag * inflow_angle_sin);
+			const double element_torque = propeller->num_blades * (element_lift * inflow_angle_sin + element_drag * inflow_angle_cos) * element_radius;
+
+			result.thrust += element_thrust;
+			result.torque += element_torque;
+
+			if (i == representative_index)
+			{
+				char buffer[64];
+				std::snprintf(buffer, sizeof(buffer), "i=%d -> aoa_d=%f", i, math::radians_to_degrees(angle_of_attack));
+				result.debug_log.log(buffer);
+			}
+
+			result.reynolds.push_back(reynolds);
+		}
+
+		result.angle_of_attack = angle_of_attack_accumulator / blade_elements_count;
+
+		return result;
+	}
+
+	double compute_induced_velocity_from_thrust(double thrust, double v_axial, double air_density, double area)
+	{
+		// Guard against badly configured values
+		if (air_density <= 0.0 || area <= 0.0)
+		{
+			return 0.0;
+		}
+
+		/*
+		 * Momentum theory:
+		 * thrust = air density * area * (v axial + v induced) * 2 * v induced
+		 * v induced ^ 2 + v induced * v axial - thrust / (2 * air density * area) = 0
+		 *
+		 * This is a polynomial of the 2nd degree for v induced, with discriminant
+		 * delta = v axial ^ 2 + 2 * thrust / (air density * area)
+		 * and roots r1 = 0.5 * (-v axial + sqrt(delta)), r2 = 0.5 * (-v axial - sqrt(delta))
+		 */
+
+		const double discriminant = v_axial * v_axial + 2.0 * thrust / (air_density * area);
+
+		if (discriminant < 0.0)
+		{
+			return -0.5 * v_axial; // complex roots, return something reasonable
+		}
+
+		const auto discriminant_root = std::sqrt(discriminant);
+		const auto root_1 = 0.5 * (-v_axial + discriminant_root);
+		const auto root_2 = 0.5 * (-v_axial - discriminant_root);
+
+		return v_axial >= 0.0 ? root_2 : root_1;
+	}
+}
+}
+
+double physics::simulation_bemt::compute_axial_velocity(const FVector3& thrust_axis, const FVector3& wind_velocity,
+	const FVector3& propeller_velocity)
+{
+	const auto freestream_velocity = wind_velocity - propeller_velocity;
+	return freestream_velocity.dot(-thrust_axis);
+}
+
+std::tuple<physics::FPropThrustResult, physics::FDebugLog> physics::simulation_bemt::compute_thrust_and_torque(double propeller_angular_speed,
+	const FVector3& thrust_axis, const FVector3& wind_velocity, const FVector3& propeller_velocity, double air_density,
+	const FDronePropellerBemt* propeller)
+{
+	FDebugLog debug_log;
+
+	if (propeller->radius <= propeller->hub_radius || propeller->num_blades <= 0 || std::abs(propeller_angular_speed) <= 1e-3)
+	{
+		return { FPropThrustResult(), FDebugLog() };
+	}
+
+	// v_axial is the free-stream velocity of the air, far away from the propeller in the air tube
+	// Downstream-positive, which means that v_axial is positive when air velocity goes toward the propeller from above the propeller
+	const double v_axial = compute_axial_velocity(thrust_axis, wind_velocity, propeller_velocity);
+
+	// Disk area
+	const double area = math::pi * propeller->radius * propeller->radius;
+
+	// Fixed-point induced inflow (momentum theory): T ≈ 2*rho*A*vi*(Vaxial + vi)
+	double v_induced = 0.0; // start guess (>=0, into disk)
+
+	FIntegrationResult last_integration_result;
+
+	for (int i = 0; i < integrations; i += 1)
+	{
+		last_integration_result = integrate_with_v_induced(v_axial, v_induced, propeller, air_density, propeller_angular_speed);
+		debug_log.append_debug_log(last_integration_result.debug_log);
+
+		const double thrust = last_integration_result.thrust;
+
+		// Update v_induced from momentum (into disk, non-negative)
+
+		const double new_v_induced = compute_induced_velocity_from_thrust(thrust, v_axial, air_density, area);
+
+		v_induced = (1.0 - integration_relaxation) * v_induced + integration_relaxation * new_v_induced;
+	}
+
+	FPropThrustResult result;
+	result.thrust = last_integration_result.thrust;
+	result.torque = last_integration_result.torque; // magnitude; sign applied at call site using sign(Omega)
+	result.angle_of_attack = last_integration_result.angle_of_attack;
+	result.reynolds = std::move(last_integration_result.reynolds);
+	result.v_induced = v_induced;
+	result.v_axial = v_axial;
+
+	return { std::move(result), std::move(debug_log) };
+}
@@ -0,0 +1,58 @@
+#include "DroneSimulatorPhysics/Public/RotorModel/Bemt/PropellerThrust.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SimulationWorld.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+
+#include <cmath>
+
+namespace
+{
+	double compute_motor_angular_speed(double throttle, const physics::FDroneMotor* motor, const physics::FDroneBattery* battery)
+	{
+		const double motor_voltage = physics::math::clamp(throttle, 0.0, 1.0) * battery->voltage;
+		constexpr auto motor_load = 0.7;
+
+		// Motor.Kv is in radians per second per volt, not in RPM per volt
+		return motor->kv * motor_voltage * motor_load;
+	}
+}
+
+std::tuple<physics::FPropellerSimInfo, physics::FDebugLog> physics::simulation_bemt::simulate_propeller_thrust(
+	FSubstepBody* substep_body, double throttle, const FDronePropellerBemt* propeller, const FDroneMotor* motor,
+	const FDroneBattery* battery, const FRotorDescription& rotor, const FSimulationWorld* simulation_world)
+{
+	FDebugLog debug_log;
+
+	const double angular_speed_load = 0.8;
+	const double angular_speed = compute_motor_angular_speed(throttle, motor, battery) * angular_speed_load;
+
+	const auto& transform = substep_body->transform_world;
+
+	const auto [air_density, wind_velocity] = simulation_world->get_wind_and_air_density();
+
+	// World-space prop axis (unit)
+	const FVector3 thrust_axis = transform.transform_vector(rotor.thrust_axis).get_safe_normal();
+
+	// Body linear velocity at hub
+	const FVector3 component_velocity = substep_body->get_velocity_at_location(rotor.location); // m/s
+
+	// Solve in SI
+	const auto [result, result_log] = compute_thrust_and_torque(angular_speed, thrust_axis, wind_velocity, component_velocity,
+		air_density, propeller);
+	debug_log.append_debug_log(result_log);
+
+	const FVector3 force = thrust_axis * result.thrust;
+	substep_body->add_force_at_point(force, rotor.location);
+
+	const auto clockwise_factor = rotor.is_clockwise ? -1.0 : 1.0;
+	const auto final_torque_value = clockwise_factor * std::abs(result.torque);
+	const FVector3 torque = thrust_axis * final_torque_value;
+
+	if (torque.size_squared() > 0.0)
+	{
+		substep_body->add_torque(torque);
+	}
+
+	return { FPropellerSimInfo(result, angular_speed, final_torque_value), debug_log };
+}
@@ -0,0 +1,67 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/RotorModel/Bemt/ComputePropellerThrust.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+	physics::FDronePropellerBemt make_five_inch_propeller()
+	{
+		physics::FDronePropellerBemt propeller;
+		propeller.num_blades = 3;
+		propeller.radius = 0.0635; // 0.0635 is 5 inch prop
+		propeller.hub_radius = 0.015;
+		propeller.chord = 0.02;
+		propeller.pitch = 0.0762; // 0.0762 is 3 inch pitch
+		propeller.airfoil = physics::FDroneAirfoilSimplified();
+		return propeller;
+	}
+}
+
+TEST_CASE("Propeller thrust", "[bemt]")
+{
+	using physics::FVector3;
+	using physics::simulation_bemt::compute_thrust_and_torque;
+
+	const auto propeller = make_five_inch_propeller();
+	constexpr auto air_density = 1.225;
+	const auto wind_velocity = FVector3::zero();
+
+	SECTION("Zero air velocity")
+	{
+		constexpr auto angular_speed = physics::math::rpm_to_rad_per_sec(10000.0);
+		const auto [result, _] = compute_thrust_and_torque(angular_speed, FVector3::up(), wind_velocity, FVector3::zero(),
+			air_density, &propeller);
+
+		REQUIRE(result.thrust > 0.0);
+		REQUIRE(physics::math::radians_to_degrees(result.angle_of_attack) > 0.0);
+	}
+
+	SECTION("Thrust increases with the angular speed")
+	{
+		double last_thrust = 0.0;
+		for (double rpm = 5000.0; rpm <= 30000.0; rpm += 5000.0)
+		{
+			const auto [result, _] = compute_thrust_and_torque(physics::math::rpm_to_rad_per_sec(rpm), FVector3::up(),
+				wind_velocity, FVector3::zero(), air_density, &propeller);
+			REQUIRE(result.thrust > last_thrust);
+			last_thrust = result.thrust;
+		}
+	}
+
+	SECTION("Climbing reduces the thrust")
+	{
+		constexpr auto angular_speed = physics::math::rpm_to_rad_per_sec(20000.0);
+		const auto [hover_result, hover_log] = compute_thrust_and_torque(angular_speed, FVector3::up(), wind_velocity,
+			FVector3::zero(), air_density, &propeller);
+		const auto [climb_result, climb_log] = compute_thrust_and_torque(angular_speed, FVector3::up(), wind_velocity,
+			FVector3(0.0, 0.0, 10.0), air_density, &propeller);
+
+		REQUIRE(climb_result.thrust < hover_result.thrust);
+	}
+}
+
+#endif
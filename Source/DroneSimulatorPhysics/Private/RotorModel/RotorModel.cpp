@@ -0,0 +1,103 @@
+#include "DroneSimulatorPhysics/Public/RotorModel/RotorModel.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/RotorModel/Bemt/PropellerThrust.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SimulationWorld.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+#include "DroneSimulatorPhysics/Private/Utils/Variant.h"
+
+#include <cmath>
+
+physics::FRotorSimulationResult physics::rotor_model::simulate_propeller_rotor(const FRotorModel& rotor_model,
+	FSubstepBody* substep_body, double throttle, const FDronePropeller* propeller, const FDroneMotor* motor,
+	const FDroneBattery* battery, const FRotorDescription& rotor, const FSimulationWorld* simulation_world)
+{
+	return match_variant(
+		rotor_model,
+		[&](const FRotorModelBemt&)
+		{
+			return simulate_bemt_rotor(substep_body, throttle, propeller, motor, battery, rotor, simulation_world);
+		},
+		[&](const FRotorModelSimplified&)
+		{
+			return simulate_simplified_rotor(substep_body, throttle, propeller, motor, battery, rotor, simulation_world);
+		},
+		[&](const FRotorModelDebug& rotor_model_debug)
+		{
+			return simulate_debug_rotor(rotor_model_debug, substep_body, throttle, rotor);
+		}
+	);
+}
+
+physics::FRotorSimulationResult physics::rotor_model::simulate_bemt_rotor(FSubstepBody* substep_body, double throttle,
+	const FDronePropeller* propeller, const FDroneMotor* motor, const FDroneBattery* battery,
+	const FRotorDescription& rotor, const FSimulationWorld* simulation_world)
+{
+	const auto* propeller_bemt = std::get_if<FDronePropellerBemt>(propeller);
+	if (propeller_bemt == nullptr)
+	{
+		return FRotorSimulationResult();
+	}
+
+	const auto [simulation_output, debug_log] = simulation_bemt::simulate_propeller_thrust(substep_body, throttle,
+		propeller_bemt, motor, battery, rotor, simulation_world);
+
+	return FRotorSimulationResult { FThrustSimValue(simulation_output.thrust, simulation_output.torque), debug_log };
+}
+
+physics::FRotorSimulationResult physics::rotor_model::simulate_simplified_rotor(FSubstepBody* substep_body, double throttle,
+	const FDronePropeller* propeller, const FDroneMotor* motor, const FDroneBattery* battery,
+	const FRotorDescription& rotor, const FSimulationWorld* simulation_world)
+{
+	const auto* propeller_simplified = std::get_if<FDronePropellerSimplified>(propeller);
+	if (propeller_simplified == nullptr)
+	{
+		return FRotorSimulationResult();
+	}
+
+	const auto [air_density, wind_velocity] = simulation_world->get_wind_and_air_density();
+
+	const auto rotor_angular_speed = throttle * battery->voltage * motor->kv; // in rad/s
+	const auto rotor_rps = rotor_angular_speed / math::two_pi; // In rev/s
+
+	const auto diameter = propeller_simplified->blade_diameter;
+
+	const auto diameter_pow_4 = diameter * diameter * diameter * diameter;
+	const auto thrust = propeller_simplified->thrust_coefficient * air_density * math::square(rotor_rps) * diameter_pow_4;
+
+	const auto diameter_pow_5 = diameter_pow_4 * diameter;
+	const auto torque = propeller_simplified->torque_coefficient * air_density * math::square(rotor_rps) * diameter_pow_5;
+
+	apply_rotor_forces(substep_body, rotor, thrust, torque);
+
+	return FRotorSimulationResult { FThrustSimValue(thrust, torque), FDebugLog() };
+}
+
+physics::FRotorSimulationResult physics::rotor_model::simulate_debug_rotor(const FRotorModelDebug& rotor_model,
+	FSubstepBody* substep_body, double throttle, const FRotorDescription& rotor)
+{
+	const double throttle_clamped = math::clamp(throttle, 0.0, 1.0);
+	const double thrust = rotor_model.max_thrust * throttle_clamped;
+	const double torque = rotor_model.max_torque * throttle_clamped;
+
+	apply_rotor_forces(substep_body, rotor, thrust, torque);
+
+	return FRotorSimulationResult { FThrustSimValue(thrust, torque), FDebugLog() };
+}
+
+void physics::rotor_model::apply_rotor_forces(FSubstepBody* substep_body, const FRotorDescription& rotor, double thrust,
+	double torque)
+{
+	// World-space prop axis (unit)
+	const FVector3 thrust_axis = substep_body->transform_world.transform_vector(rotor.thrust_axis).get_safe_normal();
+	const FVector3 force = thrust_axis * thrust;
+	substep_body->add_force_at_point(force, rotor.location);
+
+	const auto clockwise_factor = rotor.is_clockwise ? -1.0 : 1.0;
+	const auto final_torque_value = clockwise_factor * std::abs(torque);
+	const FVector3 torque_vector = thrust_axis * final_torque_value;
+
+	if (torque_vector.size_squared() > 0.0)
+	{
+		substep_body->add_torque(torque_vector);
+	}
+}
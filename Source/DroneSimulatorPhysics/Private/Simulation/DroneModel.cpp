@@ -0,0 +1,77 @@
+#include "DroneSimulatorPhysics/Public/Simulation/DroneModel.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Inertia.h"
+#include "DroneSimulatorPhysics/Public/Simulation/LinearDrag.h"
+
+#include <algorithm>
+
+double physics::FDroneParts::compute_total_mass() const
+{
+	const double frame_mass = this->frame.has_value() ? this->frame->mass : 0.0;
+	const double battery_mass = this->battery.has_value() ? this->battery->mass : 0.0;
+	const double motor_mass = this->motor.has_value() ? this->motor->mass : 0.0;
+	const auto num_motors = this->frame.has_value() ? this->frame->get_num_motors() : 4;
+
+	return frame_mass + battery_mass + static_cast<double>(num_motors) * motor_mass;
+}
+
+physics::FPropulsionDroneSetup physics::FDroneModel::get_propulsion_setup() const
+{
+	return FPropulsionDroneSetup { &*parts.frame, &*parts.motor, &*parts.battery, &*parts.propeller, &rotors, &mixer };
+}
+
+std::shared_ptr<const physics::FDroneModel> physics::drone_model::compile(FDroneParts parts)
+{
+	auto model = std::make_shared<FDroneModel>();
+	model->parts = std::move(parts);
+
+	const auto& compiled_parts = model->parts;
+	model->total_mass = compiled_parts.compute_total_mass();
+	model->inertia_tensor = inertia::compute_inertia_si(compiled_parts.frame, compiled_parts.motor, compiled_parts.battery);
+
+	if (compiled_parts.frame.has_value())
+	{
+		model->rotors = propulsion::compute_rotors(*compiled_parts.frame);
+		model->mixer = mixer::compile_for_frame(*compiled_parts.frame);
+	}
+
+	const auto propeller_radius = compiled_parts.propeller.has_value() ? simulation::get_props_radius(*compiled_parts.propeller) : 0.0;
+	model->collision_shape = collision::make_drone_shape(model->rotors, propeller_radius);
+
+	if (model->has_drag())
+	{
+		const auto frame_cda = compiled_parts.frame->area * compiled_parts.frame->drag_coefficient;
+		model->total_cda = frame_cda + simulation::calculate_props_cda(*compiled_parts.propeller);
+	}
+
+	return model;
+}
+
+physics::FDroneModelCache& physics::FDroneModelCache::get()
+{
+	static FDroneModelCache cache;
+	return cache;
+}
+
+std::shared_ptr<const physics::FDroneModel> physics::FDroneModelCache::find_or_compile(const std::string& key,
+	const std::function<FDroneParts()>& make_parts)
+{
+	std::lock_guard lock(this->mutex);
+
+	auto& cached_model = this->models[key];
+	if (auto model = cached_model.lock())
+	{
+		return model;
+	}
+
+	auto model = drone_model::compile(make_parts());
+	cached_model = model;
+	return model;
+}
+
+std::size_t physics::FDroneModelCache::get_num_live_models()
+{
+	std::lock_guard lock(this->mutex);
+
+	std::erase_if(this->models, [](const auto& entry) { return entry.second.expired(); });
+	return this->models.size();
+}
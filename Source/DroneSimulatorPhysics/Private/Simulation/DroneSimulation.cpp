@@ -0,0 +1,212 @@
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+
+#include <algorithm>
+
+void physics::FDroneSimulation::reset_body(const FVector3& location_world, const FQuaternion& rotation_world)
+{
+	this->body = FSubstepBody(location_world, rotation_world, this->model->total_mass, this->model->inertia_tensor,
+		FVector3::zero(), FVector3::zero());
+	this->remaining_time_accumulator = 0.0;
+	this->setpoint = FDroneSetpoint();
+	this->pilot_input_buffer.clear();
+	this->held_stage_outputs = FHeldStageOutputs();
+	this->last_contact = FContactResult();
+	this->sleep_state = FSleepState();
+	imu::reset(this->imu);
+	this->gyro_filter.state = FGyroFilterState();
+	this->substep_index = 0;
+	this->state_hash_log.entries.clear();
+}
+
+std::int32_t physics::FDroneSimulation::advance(double delta_time, const FDronePlayerInput& player_input)
+{
+	const auto frame_end_time = this->get_simulation_time() + this->remaining_time_accumulator + delta_time;
+	this->pilot_input_buffer.push(frame_end_time, player_input);
+
+	const auto is_asleep = this->update_sleep(player_input, delta_time);
+
+	const auto substep_duration = 1.0 / this->tick_rate_hz;
+	this->remaining_time_accumulator += delta_time;
+
+	std::int32_t substep_count = 0;
+	for (; this->remaining_time_accumulator >= substep_duration; this->remaining_time_accumulator -= substep_duration)
+	{
+		// The clock keeps running while asleep, so that the input timestamps stay valid
+		if (is_asleep)
+		{
+			this->substep_index++;
+			continue;
+		}
+
+		this->update_setpoint(substep_duration);
+		this->simulate_substep(substep_duration);
+		substep_count++;
+	}
+
+	return substep_count;
+}
+
+void physics::FDroneSimulation::advance_substeps(std::int32_t substep_count, const FDronePlayerInput& player_input)
+{
+	const auto substep_duration = 1.0 / this->tick_rate_hz;
+
+	// Timestamped at the first substep, so that it is held instead of interpolated
+	this->pilot_input_buffer.push(this->get_simulation_time(), player_input);
+
+	if (this->update_sleep(player_input, substep_count * substep_duration))
+	{
+		this->substep_index += substep_count;
+		return;
+	}
+
+	for (std::int32_t substep_index = 0; substep_index < substep_count; substep_index++)
+	{
+		this->update_setpoint(substep_duration);
+		this->simulate_substep(substep_duration);
+	}
+}
+
+void physics::FDroneSimulation::simulate_substep(double substep_delta_time)
+{
+	this->simulate_substep(substep_delta_time, this->schedule.get_stages(this->substep_index, this->tick_rate_hz));
+	this->record_state_hash();
+}
+
+void physics::FDroneSimulation::simulate_substep(double substep_delta_time, const FSubstepStages& stages)
+{
+	const auto& compiled_model = *this->model;
+	auto* substep_body = &this->body;
+
+	multi_rate::sample_environment(this->held_stage_outputs, this->simulation_world, stages);
+
+	if (compiled_model.has_propulsion() && this->is_armed)
+	{
+		propulsion::tick_propulsion(this->propulsion_model, substep_body, this->setpoint,
+			compiled_model.get_propulsion_setup(), &this->held_stage_outputs.sampled_world, stages, this->get_gyro_angular_velocity());
+	}
+
+	// Apply gravity
+	substep_body->add_force(FVector3(0.0, 0.0, -9.81 * substep_body->mass));
+
+	multi_rate::apply_drag(this->held_stage_outputs, substep_body, compiled_model, stages);
+
+	if (this->collision_world != nullptr)
+	{
+		this->last_contact = collision::apply_contacts(*this->collision_world, substep_body, compiled_model.collision_shape,
+			substep_delta_time);
+	}
+
+	if (this->imu.config.is_enabled && stages.imu)
+	{
+		imu::sample(this->imu, *substep_body, this->get_rotor_throttle(), this->get_max_rotor_speed(), this->get_simulation_time(),
+			stages.imu_delta_time);
+
+		if (stages.gyro_filter && stages.imu_delta_time > 0.0)
+		{
+			this->filter_gyro(1.0 / stages.imu_delta_time);
+		}
+	}
+
+	substep_body->consume_forces_and_torques(substep_delta_time);
+	substep_body->integrate_transform(substep_delta_time);
+
+	this->substep_index++;
+}
+
+void physics::FDroneSimulation::record_state_hash()
+{
+	if (this->state_hash_log.should_hash(this->substep_index))
+	{
+		this->state_hash_log.record(this->substep_index, this->compute_state_hash());
+	}
+}
+
+std::uint64_t physics::FDroneSimulation::compute_state_hash() const
+{
+	FStateHasher hasher;
+	hasher.add(this->body);
+	hasher.add(this->setpoint);
+	hasher.add(this->remaining_time_accumulator);
+	hasher.add(static_cast<std::uint64_t>(this->substep_index));
+	hasher.add(this->held_stage_outputs);
+	hasher.add(this->pilot_input_buffer);
+	hasher.add(this->sleep_state);
+	hasher.add(this->imu.state.gyro_bias);
+	hasher.add(this->imu.state.accel_bias);
+	hasher.add(static_cast<std::uint64_t>(this->imu.samples.sample_count));
+	hasher.add(this->gyro_filter.state.output);
+	for (std::int32_t stage = 0; stage < this->gyro_filter.state.stage_count; stage++)
+	{
+		hasher.add(this->gyro_filter.state.stages[stage].z1);
+		hasher.add(this->gyro_filter.state.stages[stage].z2);
+	}
+
+	if (const auto* dynamics = std::get_if<FPropulsionModelDynamics>(&this->propulsion_model))
+	{
+		hasher.add(dynamics->held_outputs);
+
+		if (const auto* pid_controller = std::get_if<FPidDroneController>(&dynamics->controller))
+		{
+			hasher.add(pid_controller->state);
+		}
+	}
+
+	if (const auto* velocity_flight_mode = std::get_if<FFlightModeVelocity>(&this->flight_mode))
+	{
+		hasher.add(velocity_flight_mode->state);
+	}
+
+	return hasher.value;
+}
+
+bool physics::FDroneSimulation::update_sleep(const FDronePlayerInput& player_input, double delta_time)
+{
+	sleep::update(this->sleep_state, this->sleep_config, this->is_armed, player_input, this->last_contact.num_contacts > 0,
+		this->body.linear_velocity_world, this->body.angular_velocity_radians_world, delta_time);
+	return this->sleep_state.is_asleep;
+}
+
+void physics::FDroneSimulation::update_setpoint(double substep_delta_time)
+{
+	const auto player_input = this->pilot_input_buffer.sample(this->get_simulation_time());
+	this->setpoint = flight_mode::compute_setpoint(this->flight_mode, player_input, this->build_flight_mode_state(substep_delta_time));
+}
+
+physics::FFlightModeState physics::FDroneSimulation::build_flight_mode_state(double delta_time) const
+{
+	FFlightModeState flight_state;
+	flight_state.delta_time = delta_time;
+	flight_state.linear_velocity_world = this->body.linear_velocity_world;
+	flight_state.angular_velocity_world = this->body.angular_velocity_radians_world;
+	flight_state.rotation = this->body.transform_world.rotation.to_rotation();
+	return flight_state;
+}
+
+const physics::FVector3* physics::FDroneSimulation::get_gyro_angular_velocity() const
+{
+	return this->gyro_filter.state.has_output ? &this->gyro_filter.state.output : nullptr;
+}
+
+void physics::FDroneSimulation::filter_gyro(double sample_rate_hz)
+{
+	if (const auto* sample = this->imu.samples.get_latest())
+	{
+		gyro_filter::retune(this->gyro_filter, this->get_rotor_throttle(), this->get_max_rotor_speed(), sample_rate_hz);
+		gyro_filter::apply(this->gyro_filter, sample->angular_velocity);
+	}
+}
+
+physics::FRotorSetThrottle physics::FDroneSimulation::get_rotor_throttle() const
+{
+	// Disarmed rotors don't spin, the count stays that of the frame so that the RPM filter keeps its layout
+	const auto* dynamics = std::get_if<FPropulsionModelDynamics>(&this->propulsion_model);
+	auto throttle = dynamics != nullptr && this->is_armed ? dynamics->held_outputs.throttle : FRotorSetThrottle();
+	throttle.count = std::min(static_cast<std::int32_t>(this->model->rotors.size()), max_rotor_count);
+	return throttle;
+}
+
+double physics::FDroneSimulation::get_max_rotor_speed() const
+{
+	// In rad/s, unloaded motor at full battery
+	return this->model->has_propulsion() ? this->model->parts.motor->kv * this->model->parts.battery->voltage : 0.0;
+}
@@ -0,0 +1,452 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Private/Simulation/TestDrone.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSnapshot.h"
+#include "DroneSimulatorPhysics/Public/Simulation/LinearDrag.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SimulationBatch.h"
+
+#include <catch2/catch.hpp>
+
+#include <optional>
+#include <vector>
+
+TEST_CASE("Drone simulation", "[simulation]")
+{
+	SECTION("Runs one substep per tick period")
+	{
+		auto simulation = physics::test_drone::make_simulation(physics::FRotorModelDebug(), std::nullopt);
+		REQUIRE(simulation.advance(0.011, physics::FDronePlayerInput::zero()) == 4);
+		REQUIRE(simulation.remaining_time_accumulator == Approx(0.001));
+	}
+
+	SECTION("Flight mode runs at the substep rate")
+	{
+		// The angle mode loop closes on the attitude: it must not depend on the frame rate
+		const auto fly = [](double frame_rate_hz)
+		{
+			auto simulation = physics::test_drone::make_simulation();
+			simulation.flight_mode = physics::FFlightModeAngle();
+
+			// Periods exact in binary, so that both runs have the same substeps
+			simulation.tick_rate_hz = 256.0;
+			for (int frame = 0; frame < frame_rate_hz; frame++)
+			{
+				simulation.advance(1.0 / frame_rate_hz, physics::FDronePlayerInput { 0.6, 0.0, 0.5, 0.2 });
+			}
+			return simulation;
+		};
+
+		const auto slow_frames = fly(32.0);
+		const auto fast_frames = fly(128.0);
+
+		REQUIRE(slow_frames.substep_index == fast_frames.substep_index);
+		REQUIRE(slow_frames.body.transform_world.location.X == Approx(fast_frames.body.transform_world.location.X));
+		REQUIRE(slow_frames.body.transform_world.location.Y == Approx(fast_frames.body.transform_world.location.Y));
+		REQUIRE(slow_frames.body.angular_velocity_radians_world.X == Approx(fast_frames.body.angular_velocity_radians_world.X));
+	}
+
+	SECTION("Pilot input is interpolated between frames")
+	{
+		auto simulation = physics::test_drone::make_simulation(physics::FRotorModelDebug(), std::nullopt);
+		simulation.tick_rate_hz = 256.0;
+		simulation.advance(1.0 / 64.0, physics::FDronePlayerInput { 0.0, 0.0, 0.0, 0.0 });
+
+		// 4 substeps per frame: the throttle ramps from 0 to 1 over the frame, the last substep starts at 3/4
+		simulation.advance(1.0 / 64.0, physics::FDronePlayerInput { 1.0, 0.0, 0.0, 0.0 });
+		REQUIRE(simulation.setpoint.throttle == Approx(0.75));
+	}
+
+	SECTION("Falls without parts")
+	{
+		physics::FDroneParts parts;
+		parts.frame = physics::FDroneFrame();
+		parts.frame->mass = 1.0;
+
+		physics::FDroneSimulation simulation;
+		simulation.model = physics::drone_model::compile(parts);
+		simulation.reset_body(physics::FVector3::zero(), physics::FQuaternion::identity());
+
+		for (int i = 0; i < 100; i++)
+		{
+			simulation.advance(1.0 / 100.0, physics::FDronePlayerInput::zero());
+		}
+
+		REQUIRE(simulation.body.linear_velocity_world.Z == Approx(-9.81).epsilon(0.01));
+		REQUIRE(simulation.body.transform_world.location.Z < -400.0);
+	}
+
+	SECTION("Full throttle climbs")
+	{
+		auto simulation = physics::test_drone::make_simulation(physics::FRotorModelDebug());
+
+		const auto input = physics::FDronePlayerInput { 1.0, 0.0, 0.0, 0.0 };
+		for (int i = 0; i < 100; i++)
+		{
+			simulation.advance(1.0 / 100.0, input);
+		}
+
+		REQUIRE(simulation.body.linear_velocity_world.Z > 0.0);
+		REQUIRE(simulation.body.transform_world.location.Z > 1000.0);
+	}
+
+	SECTION("A coaxial X8 climbs without rotating")
+	{
+		auto simulation = physics::test_drone::make_simulation(physics::FRotorModelDebug());
+
+		// Each arm has an upper and a lower rotor, spinning in opposite directions
+		auto parts = simulation.model->parts;
+		for (const auto& location : { physics::FVector3(10.0, -10.0, 0.0), physics::FVector3(10.0, 10.0, 0.0),
+			physics::FVector3(-10.0, -10.0, 0.0), physics::FVector3(-10.0, 10.0, 0.0) })
+		{
+			parts.frame->rotors.push_back({ location + physics::FVector3(0.0, 0.0, 2.0), physics::FVector3::up(), true });
+			parts.frame->rotors.push_back({ location - physics::FVector3(0.0, 0.0, 2.0), physics::FVector3::up(), false });
+		}
+		simulation.model = physics::drone_model::compile(parts);
+		REQUIRE(simulation.model->mixer.count == 8);
+		REQUIRE(simulation.model->total_mass == Approx(0.3 + 0.2 + 8 * 0.03));
+
+		const auto input = physics::FDronePlayerInput { 1.0, 0.0, 0.0, 0.0 };
+		for (int i = 0; i < 100; i++)
+		{
+			simulation.advance(1.0 / 100.0, input);
+		}
+
+		REQUIRE(simulation.body.transform_world.location.Z > 1000.0);
+		REQUIRE(simulation.body.angular_velocity_radians_world.size() < 1e-6);
+	}
+
+	SECTION("Same inputs give the same state hashes")
+	{
+		const auto run = [](double throttle_at_step_30)
+		{
+			auto simulation = physics::test_drone::make_simulation(physics::FRotorModelDebug());
+			simulation.state_hash_log.hash_interval = 4;
+
+			for (int i = 0; i < 50; i++)
+			{
+				const auto throttle = i == 30 ? throttle_at_step_30 : 0.5;
+				simulation.advance_substeps(4, physics::FDronePlayerInput { throttle, 0.0, 0.1, 0.0 });
+			}
+			return simulation.state_hash_log.entries;
+		};
+
+		const auto reference = run(0.5);
+		REQUIRE(reference.size() == 50);
+		REQUIRE(reference.back().substep_index == 200);
+		REQUIRE_FALSE(physics::find_first_divergence(reference, run(0.5)).has_value());
+
+		// Step 30 runs substeps 121 to 124, the first hash after it is at 124
+		REQUIRE(physics::find_first_divergence(reference, run(0.6)) == 124);
+	}
+}
+
+TEST_CASE("Sleep", "[simulation]")
+{
+	// Disarmed drone dropped on a pad
+	auto simulation = physics::test_drone::make_simulation(physics::FRotorModelDebug());
+	physics::FCollisionGeometry geometry;
+	geometry.ground_height = 0.0;
+	simulation.collision_world = physics::collision::compile(geometry);
+	simulation.reset_body(physics::FVector3(0.0, 0.0, 20.0), physics::FQuaternion::identity());
+	simulation.is_armed = false;
+	simulation.sleep_config.is_enabled = true;
+
+	for (int frame = 0; frame < 200; frame++)
+	{
+		simulation.advance(0.01, physics::FDronePlayerInput::zero());
+	}
+
+	REQUIRE(simulation.sleep_state.is_asleep);
+
+	SECTION("Stops substepping but keeps the clock")
+	{
+		const auto location = simulation.body.transform_world.location;
+		const auto substep_index = simulation.substep_index;
+
+		REQUIRE(simulation.advance(0.01, physics::FDronePlayerInput::zero()) == 0);
+		REQUIRE(simulation.substep_index == substep_index + 4);
+		REQUIRE(simulation.body.transform_world.location == location);
+	}
+
+	SECTION("Wakes on input")
+	{
+		REQUIRE(simulation.advance(0.01, physics::FDronePlayerInput { 0.0, 0.0, 0.5, 0.0 }) == 4);
+		REQUIRE_FALSE(simulation.sleep_state.is_asleep);
+	}
+
+	SECTION("Wakes when armed")
+	{
+		simulation.is_armed = true;
+		simulation.advance(0.01, physics::FDronePlayerInput::zero());
+		REQUIRE_FALSE(simulation.sleep_state.is_asleep);
+	}
+
+	SECTION("Wakes when pushed")
+	{
+		simulation.body.linear_velocity_world = physics::FVector3(1.0, 0.0, 0.0);
+		simulation.advance(0.01, physics::FDronePlayerInput::zero());
+		REQUIRE_FALSE(simulation.sleep_state.is_asleep);
+	}
+
+	SECTION("Doesn't sleep in the air")
+	{
+		auto falling = physics::test_drone::make_simulation(physics::FRotorModelDebug(), std::nullopt);
+		falling.is_armed = false;
+		falling.sleep_config.is_enabled = true;
+		falling.advance(1.0, physics::FDronePlayerInput::zero());
+		REQUIRE_FALSE(falling.sleep_state.is_asleep);
+	}
+
+	SECTION("Statistics count the transitions")
+	{
+		physics::FSleepStatistics statistics;
+		statistics.record(physics::ESleepTransition::fell_asleep);
+		statistics.record(physics::ESleepTransition::fell_asleep);
+		statistics.record(physics::ESleepTransition::woken_by_input);
+		statistics.record(physics::ESleepTransition::none);
+
+		REQUIRE(statistics.get_num_asleep() == 1);
+		REQUIRE(statistics.get_transition_count(physics::ESleepTransition::fell_asleep) == 2);
+		REQUIRE(statistics.get_transition_count(physics::ESleepTransition::woken_by_input) == 1);
+	}
+}
+
+TEST_CASE("Simulation batch", "[simulation]")
+{
+	// A mixed swarm: the batched path must give the same drones as stepping them one by one
+	std::vector<physics::FDroneSimulation> drones;
+	for (std::int32_t drone_index = 0; drone_index < 12; drone_index++)
+	{
+		auto drone = physics::test_drone::make_simulation();
+
+		auto& pid_controller = std::get<physics::FPidDroneController>(std::get<physics::FPropulsionModelDynamics>(drone.propulsion_model).controller);
+		pid_controller.config.roll_pid.integral = 0.01 * drone_index;
+		pid_controller.config.pitch_pid.derivative = 0.001 * drone_index;
+
+		switch (drone_index % 4)
+		{
+		case 1:
+			drone.flight_mode = physics::FFlightModeAngle();
+			break;
+		case 2:
+			drone.flight_mode = physics::FFlightModeVelocity();
+			break;
+		case 3:
+			drone.propulsion_model = physics::FPropulsionModelDynamics { physics::FBasicDroneController(), physics::FRotorModelSimplified(),
+				physics::FPropulsionHeldOutputs() };
+			break;
+		default:
+			break;
+		}
+
+		if (drone_index == 5)
+		{
+			drone.is_armed = false;
+		}
+
+		if (drone_index % 3 == 0)
+		{
+			drone.schedule.controller_rate_hz = 100.0;
+		}
+
+		// Some controllers fly on the filtered gyro, and some on the raw gyro
+		if (drone_index % 2 == 1)
+		{
+			drone.imu.config.is_enabled = true;
+			drone.imu.config.seed = drone_index;
+			drone.gyro_filter.config.is_enabled = drone_index != 7;
+			drone.gyro_filter.config.rpm_harmonic_count = drone_index % 4;
+			drone.schedule.imu_rate_hz = drone_index == 9 ? 200.0 : 0.0;
+		}
+
+		// Hashed on every substep for some, so that the states the batch holds while it runs are compared too
+		drone.state_hash_log.hash_interval = 1 + drone_index % 3;
+
+		// Drones out of phase with each other, so that their controller stages run on different substeps
+		drone.advance_substeps(drone_index % 5, physics::FDronePlayerInput::zero());
+		drones.push_back(drone);
+	}
+
+	auto batched_drones = drones;
+	physics::FSimulationBatch batch;
+
+	for (std::int32_t step = 0; step < 20; step++)
+	{
+		std::vector<physics::FDronePlayerInput> inputs;
+		std::vector<std::int32_t> substep_counts;
+		for (std::int32_t drone_index = 0; drone_index < static_cast<std::int32_t>(drones.size()); drone_index++)
+		{
+			inputs.push_back(physics::FDronePlayerInput { 0.6, 0.1 * std::sin(step + drone_index), 0.3 * std::cos(step), -0.2 });
+			substep_counts.push_back(8 + drone_index % 2);
+
+			drones[drone_index].advance_substeps(substep_counts.back(), inputs.back());
+		}
+
+		physics::simulation_batch::advance_substeps(batched_drones, substep_counts, inputs, batch);
+	}
+
+	for (std::size_t drone_index = 0; drone_index < drones.size(); drone_index++)
+	{
+		CAPTURE(drone_index);
+		REQUIRE(batched_drones[drone_index].substep_index == drones[drone_index].substep_index);
+		REQUIRE(batched_drones[drone_index].compute_state_hash() == drones[drone_index].compute_state_hash());
+		REQUIRE_FALSE(batched_drones[drone_index].state_hash_log.entries.empty());
+		REQUIRE(batched_drones[drone_index].state_hash_log.entries == drones[drone_index].state_hash_log.entries);
+	}
+
+	// The drones moved, so that the comparison is not between drones at rest
+	REQUIRE(drones[0].body.transform_world.location.Z != 1000.0);
+}
+
+TEST_CASE("Multi-rate schedule", "[simulation]")
+{
+	SECTION("Stages run every N substeps")
+	{
+		physics::FMultiRateSchedule schedule;
+		schedule.rotor_aerodynamics_rate_hz = 1000.0;
+		schedule.recording_rate_hz = 3000.0;
+
+		REQUIRE(physics::FMultiRateSchedule::get_substep_interval(1000.0, 8000.0) == 8);
+		REQUIRE(physics::FMultiRateSchedule::get_substep_interval(3000.0, 8000.0) == 3);
+		REQUIRE(physics::FMultiRateSchedule::get_substep_interval(0.0, 8000.0) == 1);
+		REQUIRE(physics::FMultiRateSchedule::get_substep_interval(16000.0, 8000.0) == 1);
+
+		const auto first_stages = schedule.get_stages(0, 8000.0);
+		REQUIRE(first_stages.rotor_aerodynamics);
+		REQUIRE(first_stages.recording);
+		REQUIRE(first_stages.controller_delta_time == Approx(1.0 / 8000.0));
+
+		const auto stages = schedule.get_stages(3, 8000.0);
+		REQUIRE(stages.controller);
+		REQUIRE(stages.drag);
+		REQUIRE_FALSE(stages.rotor_aerodynamics);
+		REQUIRE(stages.recording);
+		REQUIRE(schedule.get_stages(8, 8000.0).rotor_aerodynamics);
+	}
+
+	SECTION("Held rotor outputs follow the throttle")
+	{
+		// Thrust of the simplified model goes exactly with the throttle squared, so holding it loses nothing
+		const auto run = [](double rotor_aerodynamics_rate_hz)
+		{
+			auto simulation = physics::test_drone::make_simulation();
+			simulation.tick_rate_hz = 8000.0;
+			simulation.schedule.rotor_aerodynamics_rate_hz = rotor_aerodynamics_rate_hz;
+
+			for (int i = 0; i < 100; i++)
+			{
+				simulation.advance_substeps(80, physics::FDronePlayerInput { 0.7, 0.0, 0.3, 0.2 });
+			}
+			return simulation.body;
+		};
+
+		const auto reference = run(0.0);
+		const auto held = run(1000.0);
+
+		REQUIRE(reference.transform_world.location.Z > 1000.0);
+		REQUIRE(held.transform_world.location.X == Approx(reference.transform_world.location.X).epsilon(1e-6));
+		REQUIRE(held.transform_world.location.Z == Approx(reference.transform_world.location.Z).epsilon(1e-6));
+		REQUIRE(held.angular_velocity_radians_world.Y == Approx(reference.angular_velocity_radians_world.Y).epsilon(1e-6));
+	}
+
+	SECTION("Each propeller of a quad is reported, held or simulated")
+	{
+		auto simulation = physics::test_drone::make_simulation();
+		auto& propulsion_model = std::get<physics::FPropulsionModelDynamics>(simulation.propulsion_model);
+		const auto drone_setup = simulation.model->get_propulsion_setup();
+		const auto setpoint = physics::FDroneSetpoint { 0.5, physics::FVector3(0.0, 0.0, 0.0) };
+
+		physics::FSubstepStages stages;
+		stages.controller_delta_time = 1.0 / simulation.tick_rate_hz;
+		const auto simulated = physics::propulsion::tick_dynamics(propulsion_model, &simulation.body, setpoint, drone_setup,
+			&simulation.simulation_world, stages);
+
+		stages.rotor_aerodynamics = false;
+		const auto held = physics::propulsion::tick_dynamics(propulsion_model, &simulation.body, setpoint, drone_setup,
+			&simulation.simulation_world, stages);
+
+		REQUIRE(simulated.has_value());
+		REQUIRE(held.has_value());
+		REQUIRE(simulated->front_left.thrust > 0.0);
+		REQUIRE(simulated->front_left.angular_speed > 0.0);
+		REQUIRE(held->rear_right.throttle == Approx(simulated->rear_right.throttle).epsilon(0.05));
+		REQUIRE(held->rear_right.thrust == Approx(simulated->rear_right.thrust).epsilon(0.1));
+	}
+
+	SECTION("Snapshots keep the held outputs")
+	{
+		auto simulation = physics::test_drone::make_simulation(physics::FRotorModelDebug());
+		simulation.schedule.rotor_aerodynamics_rate_hz = 100.0;
+		simulation.schedule.drag_rate_hz = 100.0;
+		simulation.advance_substeps(6, physics::FDronePlayerInput { 0.8, 0.0, 0.0, 0.0 });
+
+		// Mid-interval: the next substeps use the held outputs
+		const auto snapshot = physics::snapshot::capture(simulation);
+		simulation.advance_substeps(3, physics::FDronePlayerInput { 0.8, 0.0, 0.0, 0.0 });
+		const auto expected_hash = simulation.compute_state_hash();
+
+		auto restored = physics::test_drone::make_simulation(physics::FRotorModelDebug());
+		restored.schedule = simulation.schedule;
+		physics::snapshot::restore(restored, snapshot);
+		restored.advance_substeps(3, physics::FDronePlayerInput { 0.8, 0.0, 0.0, 0.0 });
+
+		REQUIRE(restored.compute_state_hash() == expected_hash);
+	}
+}
+
+TEST_CASE("Drone model", "[simulation]")
+{
+	const auto make_parts = []
+	{
+		physics::FDroneParts parts;
+		parts.frame = physics::FDroneFrame();
+		parts.frame->area = physics::FVector3(0.01, 0.01, 0.02);
+		parts.frame->drag_coefficient = physics::FVector3::one();
+		parts.frame->mass = 0.3;
+		parts.propeller = physics::FDronePropellerSimplified { 0.127, 0.1, 0.01 };
+		return parts;
+	};
+
+	SECTION("Derived constants")
+	{
+		const auto model = physics::drone_model::compile(make_parts());
+		REQUIRE(model->total_mass == Approx(0.3));
+		REQUIRE(model->has_drag());
+		REQUIRE_FALSE(model->has_propulsion());
+		REQUIRE(model->total_cda == physics::FVector3(0.01, 0.01, 0.02) + physics::simulation::calculate_props_cda(*model->parts.propeller));
+		REQUIRE(model->rotors.size() == 4);
+		REQUIRE(model->rotors[0].location == physics::FVector3(10.0, -10.0, 0.0));
+		REQUIRE(model->rotors[0].is_clockwise);
+		REQUIRE(model->mixer.count == 4);
+	}
+
+	SECTION("Identical drones share one model")
+	{
+		auto& cache = physics::FDroneModelCache::get();
+		int compile_count = 0;
+		const auto counting_make_parts = [&]
+		{
+			compile_count++;
+			return make_parts();
+		};
+
+		auto model_a = cache.find_or_compile("test/drone", counting_make_parts);
+		auto model_b = cache.find_or_compile("test/drone", counting_make_parts);
+		REQUIRE(model_a == model_b);
+		REQUIRE(compile_count == 1);
+
+		physics::FDroneSimulation simulation;
+		simulation.model = model_a;
+		const auto simulation_copy = simulation;
+		REQUIRE(simulation_copy.model.get() == model_a.get());
+
+		// The cache doesn't keep unused models alive
+		model_a.reset();
+		model_b.reset();
+		simulation.model.reset();
+		REQUIRE(simulation_copy.model.use_count() == 1);
+	}
+}
+
+#endif
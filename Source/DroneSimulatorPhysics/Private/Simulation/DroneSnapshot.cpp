@@ -0,0 +1,104 @@
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSnapshot.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+
+#include <cstring>
+
+physics::FDroneSimulationSnapshot physics::snapshot::capture(const FDroneSimulation& simulation)
+{
+	FDroneSimulationSnapshot snapshot;
+	snapshot.transform_world = simulation.body.transform_world;
+	snapshot.mass = simulation.body.mass;
+	snapshot.inertia_tensor = simulation.body.inertia_tensor;
+	snapshot.linear_velocity_world = simulation.body.linear_velocity_world;
+	snapshot.angular_velocity_radians_world = simulation.body.angular_velocity_radians_world;
+	snapshot.remaining_time_accumulator = simulation.remaining_time_accumulator;
+	snapshot.substep_index = simulation.substep_index;
+	snapshot.setpoint = simulation.setpoint;
+	snapshot.pilot_input_buffer = simulation.pilot_input_buffer;
+	snapshot.is_armed = simulation.is_armed;
+	snapshot.sleep_state = simulation.sleep_state;
+	snapshot.last_contact = simulation.last_contact;
+	snapshot.held_stage_outputs = simulation.held_stage_outputs;
+	snapshot.imu_gyro_bias = simulation.imu.state.gyro_bias;
+	snapshot.imu_accel_bias = simulation.imu.state.accel_bias;
+	snapshot.imu_rotor_angles = simulation.imu.state.rotor_angles;
+	snapshot.imu_sample_count = simulation.imu.samples.sample_count;
+	snapshot.gyro_filter_state = simulation.gyro_filter.state;
+
+	if (const auto* dynamics = std::get_if<FPropulsionModelDynamics>(&simulation.propulsion_model))
+	{
+		snapshot.propulsion_held_outputs = dynamics->held_outputs;
+
+		if (const auto* pid_controller = std::get_if<FPidDroneController>(&dynamics->controller))
+		{
+			snapshot.controller_state = pid_controller->state;
+		}
+	}
+
+	if (const auto* velocity_flight_mode = std::get_if<FFlightModeVelocity>(&simulation.flight_mode))
+	{
+		snapshot.flight_mode_state = velocity_flight_mode->state;
+	}
+
+	return snapshot;
+}
+
+void physics::snapshot::restore(FDroneSimulation& simulation, const FDroneSimulationSnapshot& snapshot)
+{
+	// Forces are accumulated within a substep only, a snapshot is always taken between two substeps
+	simulation.body = FSubstepBody();
+	simulation.body.transform_world = snapshot.transform_world;
+	simulation.body.mass = snapshot.mass;
+	simulation.body.inertia_tensor = snapshot.inertia_tensor;
+	simulation.body.linear_velocity_world = snapshot.linear_velocity_world;
+	simulation.body.angular_velocity_radians_world = snapshot.angular_velocity_radians_world;
+	simulation.remaining_time_accumulator = snapshot.remaining_time_accumulator;
+	simulation.substep_index = snapshot.substep_index;
+	simulation.setpoint = snapshot.setpoint;
+	simulation.pilot_input_buffer = snapshot.pilot_input_buffer;
+	simulation.is_armed = snapshot.is_armed;
+	simulation.sleep_state = snapshot.sleep_state;
+	simulation.last_contact = snapshot.last_contact;
+	simulation.held_stage_outputs = snapshot.held_stage_outputs;
+
+	imu::reset(simulation.imu);
+	simulation.imu.state.gyro_bias = snapshot.imu_gyro_bias;
+	simulation.imu.state.accel_bias = snapshot.imu_accel_bias;
+	simulation.imu.state.rotor_angles = snapshot.imu_rotor_angles;
+	simulation.imu.samples.sample_count = snapshot.imu_sample_count;
+	simulation.gyro_filter.state = snapshot.gyro_filter_state;
+
+	if (auto* dynamics = std::get_if<FPropulsionModelDynamics>(&simulation.propulsion_model))
+	{
+		dynamics->held_outputs = snapshot.propulsion_held_outputs;
+
+		if (auto* pid_controller = std::get_if<FPidDroneController>(&dynamics->controller))
+		{
+			pid_controller->state = snapshot.controller_state;
+		}
+	}
+
+	if (auto* velocity_flight_mode = std::get_if<FFlightModeVelocity>(&simulation.flight_mode))
+	{
+		velocity_flight_mode->state = snapshot.flight_mode_state;
+	}
+}
+
+bool physics::snapshot::from_bytes(std::span<const std::byte> bytes, FDroneSimulationSnapshot& out_snapshot)
+{
+	if (bytes.size() != sizeof(FDroneSimulationSnapshot))
+	{
+		return false;
+	}
+
+	FDroneSimulationSnapshot snapshot;
+	std::memcpy(&snapshot, bytes.data(), sizeof(FDroneSimulationSnapshot));
+
+	if (snapshot.magic != FDroneSimulationSnapshot::expected_magic || snapshot.version != FDroneSimulationSnapshot::expected_version)
+	{
+		return false;
+	}
+
+	out_snapshot = snapshot;
+	return true;
+}
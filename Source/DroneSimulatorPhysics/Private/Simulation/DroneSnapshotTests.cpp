@@ -0,0 +1,95 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Private/Simulation/TestDrone.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSnapshot.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Rollout.h"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+namespace
+{
+	physics::FDroneSimulation make_test_drone()
+	{
+		auto simulation = physics::test_drone::make_simulation();
+		simulation.flight_mode = physics::FFlightModeVelocity();
+		return simulation;
+	}
+
+	const auto test_input = physics::FDronePlayerInput { 0.2, 0.1, 0.3, -0.2 };
+}
+
+TEST_CASE("Drone snapshot", "[simulation]")
+{
+	SECTION("Restoring continues the same trajectory")
+	{
+		auto reference = make_test_drone();
+		for (int i = 0; i < 25; i++)
+		{
+			reference.advance_substeps(8, test_input);
+		}
+
+		const auto snapshot = physics::snapshot::capture(reference);
+		REQUIRE(snapshot.controller_state.integrated_angular_velocity_error != physics::FVector3::zero());
+		REQUIRE(snapshot.flight_mode_state.vertical_velocity_integral != 0.0);
+
+		for (int i = 0; i < 25; i++)
+		{
+			reference.advance_substeps(8, test_input);
+		}
+
+		auto restored = make_test_drone();
+		physics::snapshot::restore(restored, snapshot);
+		for (int i = 0; i < 25; i++)
+		{
+			restored.advance_substeps(8, test_input);
+		}
+
+		REQUIRE(restored.substep_index == reference.substep_index);
+		REQUIRE(restored.compute_state_hash() == reference.compute_state_hash());
+	}
+
+	SECTION("Blob round trip")
+	{
+		auto drone = make_test_drone();
+		drone.advance_substeps(8, test_input);
+
+		const auto snapshot = physics::snapshot::capture(drone);
+		const auto bytes = physics::snapshot::as_bytes(snapshot);
+
+		physics::FDroneSimulationSnapshot loaded;
+		REQUIRE(physics::snapshot::from_bytes(bytes, loaded));
+		REQUIRE(loaded.linear_velocity_world == snapshot.linear_velocity_world);
+		REQUIRE_FALSE(physics::snapshot::from_bytes(bytes.subspan(1), loaded));
+
+		auto corrupted = snapshot;
+		corrupted.version++;
+		REQUIRE_FALSE(physics::snapshot::from_bytes(physics::snapshot::as_bytes(corrupted), loaded));
+	}
+
+	SECTION("Branching rollouts")
+	{
+		auto drone = make_test_drone();
+		drone.advance_substeps(8, test_input);
+		const auto snapshot = physics::snapshot::capture(drone);
+
+		const auto hover_inputs = std::vector<physics::FDronePlayerInput>(20, physics::FDronePlayerInput::zero());
+		const auto climb_inputs = std::vector<physics::FDronePlayerInput>(20, physics::FDronePlayerInput { 1.0, 0.0, 0.0, 0.0 });
+
+		physics::FRolloutBrancher brancher(2);
+		const auto trajectories = brancher.run(drone, snapshot, { hover_inputs, climb_inputs, hover_inputs }, 8);
+
+		REQUIRE(trajectories.size() == 3);
+		REQUIRE(trajectories[0].samples.size() == 20);
+		REQUIRE(trajectories[0].samples.back().simulation_time == Approx(21 * 8 / 400.0));
+		REQUIRE(trajectories[1].samples.back().location_world.Z > trajectories[0].samples.back().location_world.Z);
+
+		// Same inputs from the same snapshot give the same trajectory, whatever the thread that ran it
+		REQUIRE(trajectories[0].samples.back().location_world == trajectories[2].samples.back().location_world);
+		REQUIRE(trajectories[0].final_snapshot.flight_mode_state.vertical_velocity_integral
+			== trajectories[2].final_snapshot.flight_mode_state.vertical_velocity_integral);
+	}
+}
+
+#endif
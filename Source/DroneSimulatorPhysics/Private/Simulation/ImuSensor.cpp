@@ -0,0 +1,123 @@
+#include "DroneSimulatorPhysics/Public/Simulation/ImuSensor.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/Math/Random.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// Same as the gravity of the substep loop
+	constexpr double gravity = 9.81;
+
+	// The vibration of a rotor shakes each axis with a different phase
+	constexpr double vibration_axis_phase = physics::math::two_pi / 3.0;
+
+	physics::FVector3 get_normals(const physics::FImuState& state, std::int64_t sample_index, std::int32_t offset)
+	{
+		const auto base = (sample_index - state.noise_block_start) * physics::imu_normals_per_sample + offset;
+		return physics::FVector3(state.noise_block[base], state.noise_block[base + 1], state.noise_block[base + 2]);
+	}
+
+	// Saturates at the range, then rounds to a whole number of counts
+	double digitize(double value, double range, double resolution)
+	{
+		const auto saturated = physics::math::clamp(value, -range, range);
+		return resolution > 0.0 ? std::round(saturated / resolution) * resolution : saturated;
+	}
+
+	physics::FVector3 digitize(const physics::FVector3& vector, double range, double resolution)
+	{
+		return physics::FVector3(digitize(vector.X, range, resolution), digitize(vector.Y, range, resolution),
+			digitize(vector.Z, range, resolution));
+	}
+}
+
+void physics::FImuSampleRing::push(const FImuSample& sample)
+{
+	this->samples[this->sample_count % imu_ring_capacity] = sample;
+	this->sample_count++;
+}
+
+const physics::FImuSample* physics::FImuSampleRing::get_latest() const
+{
+	return this->sample_count > 0 ? &this->samples[(this->sample_count - 1) % imu_ring_capacity] : nullptr;
+}
+
+std::int32_t physics::FImuSampleRing::read_since(std::int64_t first_sample_index, std::span<FImuSample> out_samples) const
+{
+	const auto oldest_index = std::max(first_sample_index, this->sample_count - imu_ring_capacity);
+	const auto count = static_cast<std::int32_t>(std::clamp<std::int64_t>(this->sample_count - oldest_index, 0,
+		static_cast<std::int64_t>(out_samples.size())));
+
+	for (std::int32_t offset = 0; offset < count; offset++)
+	{
+		out_samples[offset] = this->samples[(oldest_index + offset) % imu_ring_capacity];
+	}
+
+	return count;
+}
+
+const physics::FImuSample& physics::imu::sample(FImuSensor& imu, const FSubstepBody& substep_body, const FRotorSetThrottle& rotor_throttle,
+	double max_rotor_speed, double time, double delta_time)
+{
+	const auto& config = imu.config;
+	auto& state = imu.state;
+	const auto sample_index = imu.samples.sample_count;
+
+	// One call to the generator every imu_noise_block_samples samples
+	if (state.noise_block_start < 0 || sample_index >= state.noise_block_start + imu_noise_block_samples)
+	{
+		state.noise_block_start = sample_index;
+		random::fill_normal(config.seed, 0, static_cast<std::uint64_t>(sample_index) * imu_normals_per_sample, state.noise_block);
+	}
+
+	const auto sample_rate_root = delta_time > 0.0 ? std::sqrt(1.0 / delta_time) : 0.0;
+	const auto delta_time_root = std::sqrt(std::max(delta_time, 0.0));
+
+	state.gyro_bias += get_normals(state, sample_index, 6) * (config.gyro_bias_random_walk * delta_time_root);
+	state.accel_bias += get_normals(state, sample_index, 9) * (config.accel_bias_random_walk * delta_time_root);
+
+	FVector3 gyro_vibration = FVector3::zero();
+	FVector3 accel_vibration = FVector3::zero();
+	for (std::int32_t rotor_index = 0; rotor_index < rotor_throttle.count; rotor_index++)
+	{
+		const auto throttle = rotor_throttle.values[rotor_index];
+		auto& angle = state.rotor_angles[rotor_index];
+		angle = std::fmod(angle + throttle * max_rotor_speed * delta_time, math::two_pi);
+
+		const auto shake = FVector3(std::sin(angle), std::sin(angle + vibration_axis_phase), std::sin(angle + 2.0 * vibration_axis_phase))
+			* (throttle * throttle);
+		gyro_vibration += shake * config.vibration_gyro_amplitude;
+		accel_vibration += shake * config.vibration_accel_amplitude;
+	}
+
+	const auto& rotation = substep_body.transform_world.rotation;
+	const auto true_angular_velocity = rotation.unrotate_vector(substep_body.angular_velocity_radians_world);
+
+	// Gravity is the only force an accelerometer doesn't measure
+	const auto true_specific_force = substep_body.mass > 0.0
+		? rotation.unrotate_vector(substep_body.accumulated_force_world / substep_body.mass + FVector3(0.0, 0.0, gravity))
+		: FVector3::zero();
+
+	const auto angular_velocity = true_angular_velocity + state.gyro_bias + gyro_vibration
+		+ get_normals(state, sample_index, 0) * (config.gyro_noise_density * sample_rate_root);
+	const auto specific_force = true_specific_force + state.accel_bias + accel_vibration
+		+ get_normals(state, sample_index, 3) * (config.accel_noise_density * sample_rate_root);
+
+	FImuSample sample;
+	sample.sample_index = sample_index;
+	sample.time = time;
+	sample.angular_velocity = digitize(angular_velocity, config.gyro_range, config.gyro_resolution);
+	sample.specific_force = digitize(specific_force, config.accel_range, config.accel_resolution);
+
+	imu.samples.push(sample);
+	return *imu.samples.get_latest();
+}
+
+void physics::imu::reset(FImuSensor& imu)
+{
+	imu.state = FImuState();
+	imu.samples = FImuSampleRing();
+}
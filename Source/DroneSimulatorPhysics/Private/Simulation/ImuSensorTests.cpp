@@ -0,0 +1,171 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Private/Simulation/TestDrone.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSnapshot.h"
+#include "DroneSimulatorPhysics/Public/Simulation/ImuSensor.h"
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <vector>
+
+namespace
+{
+	constexpr double imu_delta_time = 1.0 / 4000.0;
+
+	physics::FSubstepBody make_hovering_body()
+	{
+		physics::FSubstepBody body;
+		body.mass = 0.5;
+		body.transform_world.rotation = physics::FQuaternion::identity();
+
+		// The thrust cancels gravity
+		body.accumulated_force_world = physics::FVector3::zero();
+		return body;
+	}
+
+	std::vector<physics::FImuSample> take_samples(physics::FImuSensor& imu, const physics::FSubstepBody& body, std::int32_t count)
+	{
+		std::vector<physics::FImuSample> samples;
+		for (std::int32_t index = 0; index < count; index++)
+		{
+			samples.push_back(physics::imu::sample(imu, body, physics::FRotorSetThrottle(), 0.0, index * imu_delta_time,
+				imu_delta_time));
+		}
+		return samples;
+	}
+
+	physics::FDroneSimulation make_test_drone()
+	{
+		auto simulation = physics::test_drone::make_simulation();
+		simulation.flight_mode = physics::FFlightModeVelocity();
+		simulation.tick_rate_hz = 8000.0;
+		simulation.schedule.imu_rate_hz = 4000.0;
+		simulation.imu.config.is_enabled = true;
+		simulation.imu.config.seed = 3;
+
+		// Seeds the IMU noise from the config
+		simulation.reset_body(physics::FVector3(0.0, 0.0, 1000.0), physics::FQuaternion::identity());
+		return simulation;
+	}
+
+	const auto test_input = physics::FDronePlayerInput { 0.2, 0.1, 0.3, -0.2 };
+}
+
+TEST_CASE("IMU sensor", "[simulation][imu]")
+{
+	SECTION("A hovering drone measures 1 g up, a falling drone measures nothing")
+	{
+		physics::FImuSensor imu;
+		imu.config.vibration_accel_amplitude = 0.0;
+		imu.config.vibration_gyro_amplitude = 0.0;
+
+		const auto hovering = take_samples(imu, make_hovering_body(), 200);
+		double mean_specific_force = 0.0;
+		for (const auto& sample : hovering)
+		{
+			mean_specific_force += sample.specific_force.Z / hovering.size();
+			REQUIRE(sample.specific_force.X == Approx(0.0).margin(0.7));
+			REQUIRE(sample.angular_velocity.X == Approx(0.0).margin(0.05));
+		}
+		CHECK(mean_specific_force == Approx(9.81).margin(0.02));
+
+		physics::imu::reset(imu);
+		auto falling_body = make_hovering_body();
+		falling_body.accumulated_force_world = physics::FVector3(0.0, 0.0, -9.81 * falling_body.mass);
+		for (const auto& sample : take_samples(imu, falling_body, 200))
+		{
+			REQUIRE(sample.specific_force.Z == Approx(0.0).margin(0.7));
+		}
+	}
+
+	SECTION("The noise is a function of the seed and the sample index")
+	{
+		physics::FImuSensor first;
+		physics::FImuSensor second;
+		physics::FImuSensor other_seed;
+		other_seed.config.seed = 1;
+
+		const auto first_samples = take_samples(first, make_hovering_body(), 100);
+		const auto second_samples = take_samples(second, make_hovering_body(), 100);
+		const auto other_samples = take_samples(other_seed, make_hovering_body(), 100);
+
+		bool has_difference = false;
+		for (std::size_t index = 0; index < first_samples.size(); index++)
+		{
+			REQUIRE(first_samples[index].specific_force == second_samples[index].specific_force);
+			REQUIRE(first_samples[index].angular_velocity == second_samples[index].angular_velocity);
+			has_difference |= first_samples[index].specific_force != other_samples[index].specific_force;
+		}
+		CHECK(has_difference);
+	}
+
+	SECTION("Range and resolution")
+	{
+		physics::FImuSensor imu;
+		imu.config.accel_noise_density = 0.0;
+		imu.config.accel_bias_random_walk = 0.0;
+		imu.config.vibration_accel_amplitude = 0.0;
+
+		auto body = make_hovering_body();
+		body.accumulated_force_world = physics::FVector3(0.0, 1.0, 100.0);
+		const auto& sample = physics::imu::sample(imu, body, physics::FRotorSetThrottle(), 0.0, 0.0, imu_delta_time);
+
+		CHECK(sample.specific_force.Z == Approx(imu.config.accel_range));
+
+		const auto counts = sample.specific_force.Y / imu.config.accel_resolution;
+		CHECK(counts == Approx(std::round(counts)).margin(1e-9));
+		CHECK(sample.specific_force.Y == Approx(2.0).margin(imu.config.accel_resolution));
+	}
+
+	SECTION("Reading the ring at a lower rate")
+	{
+		physics::FImuSensor imu;
+		take_samples(imu, make_hovering_body(), 10);
+
+		std::array<physics::FImuSample, physics::imu_ring_capacity> read;
+		REQUIRE(imu.samples.read_since(4, read) == 6);
+		CHECK(read[0].sample_index == 4);
+		CHECK(read[5].sample_index == 9);
+		CHECK(imu.samples.get_latest()->sample_index == 9);
+
+		// Samples that were overwritten are skipped
+		take_samples(imu, make_hovering_body(), physics::imu_ring_capacity + 20);
+		REQUIRE(imu.samples.read_since(4, read) == physics::imu_ring_capacity);
+		CHECK(read[0].sample_index == imu.samples.sample_count - physics::imu_ring_capacity);
+		CHECK(read[physics::imu_ring_capacity - 1].sample_index == imu.samples.sample_count - 1);
+
+		CHECK(imu.samples.read_since(imu.samples.sample_count, read) == 0);
+	}
+
+	SECTION("Sampled at the rate of its stage")
+	{
+		auto drone = make_test_drone();
+		drone.advance_substeps(80, test_input);
+
+		CHECK(drone.imu.samples.sample_count == 40);
+		CHECK(drone.imu.samples.get_latest()->time == Approx(78.0 / 8000.0));
+	}
+
+	SECTION("Restoring a snapshot continues the same samples")
+	{
+		auto reference = make_test_drone();
+		reference.gyro_filter.config.is_enabled = true;
+		reference.advance_substeps(100, test_input);
+		REQUIRE(reference.gyro_filter.state.has_output);
+		const auto snapshot = physics::snapshot::capture(reference);
+		reference.advance_substeps(100, test_input);
+
+		auto restored = make_test_drone();
+		restored.gyro_filter.config.is_enabled = true;
+		physics::snapshot::restore(restored, snapshot);
+		restored.advance_substeps(100, test_input);
+
+		REQUIRE(restored.imu.samples.sample_count == reference.imu.samples.sample_count);
+		CHECK(restored.imu.samples.get_latest()->specific_force == reference.imu.samples.get_latest()->specific_force);
+		CHECK(restored.compute_state_hash() == reference.compute_state_hash());
+	}
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "DroneSimulatorPhysics/Public/Simulation/Inertia.h"
+
+#include "DroneSimulatorPhysics/Private/Simulation/InertiaInternal.h"
+#include "DroneSimulatorPhysics/Private/Utils/Variant.h"
+
+// ------------------------------------------------------------------
+// Tunable "good-enough" constants (SI units: meters, kilograms)
+// ------------------------------------------------------------------
+
+namespace
+{
+	// Central box half-extents (distance from CoM to side) for a 5" freestyle quad, in meters
+	// This represents a ~10cm x 10cm x 5cm main body box
+	constexpr physics::FVector3 default_extent = physics::FVector3(0.05, 0.05, 0.0);
+
+	// Mass defaults (typical 5" freestyle, ~600 g total), in kg
+	constexpr double default_motor_mass = 0.030; // per motor (≈30 g)
+	constexpr double default_frame_mass = 0.3; // ≈300 g
+	constexpr double default_battery_mass = 0.18; // ≈180 g (e.g., 6S ~1100–1300 mAh)
+}
+
+physics::FVector3 physics::inertia::compute_frame_inertia(const std::optional<FDroneFrame>& frame_opt)
+{
+	const double mass_frame = frame_opt.has_value() ? frame_opt->mass : default_frame_mass;
+	const auto front_extent = frame_opt.has_value() ? frame_opt->props_extent_front : default_extent;
+	const auto back_extent = frame_opt.has_value() ? frame_opt->props_extent_back : (default_extent * FVector3(-1.0, 0.0, 0.0));
+	return compute_frame_inertia_primitive(mass_frame, front_extent, back_extent);
+}
+
+physics::FVector3 physics::inertia::compute_motors_inertia(const std::optional<FDroneMotor>& motor_opt, const std::optional<FDroneFrame>& frame_opt)
+{
+	const double motor_mass = motor_opt.has_value() ? motor_opt->mass : default_motor_mass;
+
+	// Frames that describe their rotors have one motor at each of them, in the same units as the props extents
+	if (frame_opt.has_value() && !frame_opt->rotors.empty())
+	{
+		auto motors_inertia = FVector3::zero();
+		for (const auto& rotor : frame_opt->rotors)
+		{
+			motors_inertia += compute_point_mass_inertia(motor_mass, rotor.location);
+		}
+		return motors_inertia;
+	}
+
+	const auto front_extent = frame_opt.has_value() ? frame_opt->props_extent_front : default_extent;
+	const auto back_extent = frame_opt.has_value() ? frame_opt->props_extent_back : (default_extent * FVector3(-1.0, 0.0, 0.0));
+	return compute_motors_inertia_primitive(motor_mass, front_extent, back_extent);
+}
+
+physics::FVector3 physics::inertia::compute_battery_inertia(const std::optional<FDroneBattery>& battery_opt)
+{
+	const double battery_mass = battery_opt.has_value() ? battery_opt->mass : default_battery_mass;
+	return compute_battery_inertia_primitive(battery_mass);
+}
+
+physics::FVector3 physics::inertia::compute_inertia_si(const std::optional<FDroneFrame>& frame_opt,
+	const std::optional<FDroneMotor>& motor_opt, const std::optional<FDroneBattery>& battery_opt)
+{
+	// Neglect propeller
+
+	return (
+		compute_frame_inertia(frame_opt) +
+		compute_motors_inertia(motor_opt, frame_opt) +
+		compute_battery_inertia(battery_opt)
+	);
+}
+
+physics::FVector3 physics::inertia::compute_inertia_uu(const std::optional<FDroneFrame>& frame_opt,
+	const std::optional<FDroneMotor>& motor_opt, const std::optional<FDroneBattery>& battery_opt)
+{
+	return kgm2_to_kgcm2(compute_inertia_si(frame_opt, motor_opt, battery_opt));
+}
@@ -1,73 +1,76 @@
-﻿#include "DroneSimulatorCore/Private/Simulation/InertiaInternal.h"
+#include "DroneSimulatorPhysics/Private/Simulation/InertiaInternal.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
 
-double inertia::uu_to_meters(double uu)
+#include <cmath>
+
+double physics::inertia::uu_to_meters(double uu)
 {
 	return uu * 0.01;
 }
 
-FVector inertia::kgm2_to_kgcm2(const FVector& inertia_si)
+physics::FVector3 physics::inertia::kgm2_to_kgcm2(const FVector3& inertia_si)
 {
 	return inertia_si * 10000.0; // 1 m² = 10,000 cm²
 }
 
-FVector inertia::compute_box_inertia(double mass, const FVector& extent)
+physics::FVector3 physics::inertia::compute_box_inertia(double mass, const FVector3& extent)
 {
 	if (mass <= 0.0)
 	{
-		return FVector::ZeroVector;
+		return FVector3::zero();
 	}
 
 	const double x = extent.X;
 	const double y = extent.Y;
 	const double z = extent.Z;
-	return FVector(
+	return FVector3(
 		(1.0 / 3.0) * mass * (y * y + z * z),
 		(1.0 / 3.0) * mass * (x * x + z * z),
 		(1.0 / 3.0) * mass * (x * x + y * y)
 	);
 }
 
-FVector inertia::compute_point_mass_inertia(double mass, const FVector& offset)
+physics::FVector3 physics::inertia::compute_point_mass_inertia(double mass, const FVector3& offset)
 {
-	if (mass <= 0.0) return FVector::ZeroVector;
-	
+	if (mass <= 0.0) return FVector3::zero();
+
 	const double x2 = offset.X * offset.X;
 	const double y2 = offset.Y * offset.Y;
 	const double z2 = offset.Z * offset.Z;
-	
-	return FVector(
+
+	return FVector3(
 		mass * (y2 + z2),
 		mass * (x2 + z2),
 		mass * (x2 + y2)
 	);
 }
 
-FVector inertia::compute_rotated_box_inertia(double mass, const FVector& extent, const FRotator& rotation)
+physics::FVector3 physics::inertia::compute_rotated_box_inertia(double mass, const FVector3& extent, const FRotation& rotation)
 {
-	const FVector I_diag = compute_box_inertia(mass, extent);
+	const FVector3 I_diag = compute_box_inertia(mass, extent);
 
 	// The inertia tensor I is diagonal in local space: diag(I_diag.X, I_diag.Y, I_diag.Z).
 	// When rotated by R, the new tensor is R * I * R^T.
 	// We only need the diagonal elements of the resulting matrix.
-	
-	const FQuat quat = rotation.Quaternion();
-	const FVector axis_x = quat.GetAxisX();
-	const FVector axis_y = quat.GetAxisY();
-	const FVector axis_z = quat.GetAxisZ();
 
-	return FVector(
+	const FQuaternion quat = FQuaternion::from_rotation(rotation);
+	const FVector3 axis_x = quat.get_axis_x();
+	const FVector3 axis_y = quat.get_axis_y();
+	const FVector3 axis_z = quat.get_axis_z();
+
+	return FVector3(
 		I_diag.X * axis_x.X * axis_x.X + I_diag.Y * axis_y.X * axis_y.X + I_diag.Z * axis_z.X * axis_z.X,
 		I_diag.X * axis_x.Y * axis_x.Y + I_diag.Y * axis_y.Y * axis_y.Y + I_diag.Z * axis_z.Y * axis_z.Y,
 		I_diag.X * axis_x.Z * axis_x.Z + I_diag.Y * axis_y.Z * axis_y.Z + I_diag.Z * axis_z.Z * axis_z.Z
 	);
 }
 
-FVector inertia::compute_frame_inertia_primitive(double mass_frame, const FVector& front_extent, const FVector& back_extent)
+physics::FVector3 physics::inertia::compute_frame_inertia_primitive(double mass_frame, const FVector3& front_extent, const FVector3& back_extent)
 {
-	const auto average_extent = (front_extent.GetAbs() + back_extent.GetAbs()) * 0.5;
-	
+	const auto average_extent = (front_extent.get_abs() + back_extent.get_abs()) * 0.5;
+
 	// Reference frame that we know (a Kayouloin)
-	const auto reference_frame_box_size = FVector(0.2, 0.045, 0.03);
+	const auto reference_frame_box_size = FVector3(0.2, 0.045, 0.03);
 	const auto frame_box_mass_fraction = 0.5;
 
 	// Compute the inertia of the central box
@@ -78,39 +81,39 @@ FVector inertia::compute_frame_inertia_primitive(double mass_frame, const FVecto
 	auto inertia = compute_box_inertia(frame_box_mass, frame_box_size * 0.5);
 
 	// Compute the inertia of the arms
-	const auto reference_arm_size = FVector(0.16, 0.015, 0.008);
+	const auto reference_arm_size = FVector3(0.16, 0.015, 0.008);
 
-	const auto arm_length = (front_extent.Length() + back_extent.Length()) * 0.5;
+	const auto arm_length = (front_extent.size() + back_extent.size()) * 0.5;
 	const auto arm_size = reference_arm_size * (arm_length / reference_arm_size.X);
 	const auto arm_mass = (1.0 - frame_box_mass_fraction) * mass_frame * 0.25;
 
-	const auto yaw = FMath::RadiansToDegrees(FMath::Atan2(average_extent.Y, average_extent.X));
-	
+	const auto yaw = math::radians_to_degrees(std::atan2(average_extent.Y, average_extent.X));
+
 	// Two diagonal arms, each carrying half the arms mass
-	inertia += compute_rotated_box_inertia(arm_mass * 2.0, arm_size * 0.5, FRotator(0, 90.0 - yaw, 0));
-	inertia += compute_rotated_box_inertia(arm_mass * 2.0, arm_size * 0.5, FRotator(0, 90.0 + yaw, 0));
+	inertia += compute_rotated_box_inertia(arm_mass * 2.0, arm_size * 0.5, FRotation(0, 90.0 - yaw, 0));
+	inertia += compute_rotated_box_inertia(arm_mass * 2.0, arm_size * 0.5, FRotation(0, 90.0 + yaw, 0));
 
 	return inertia;
 }
 
-FVector inertia::compute_motors_inertia_primitive(double mass_motors, const FVector& front_extent, const FVector& back_extent)
+physics::FVector3 physics::inertia::compute_motors_inertia_primitive(double mass_motors, const FVector3& front_extent, const FVector3& back_extent)
 {
 	return (
 		compute_point_mass_inertia(mass_motors, front_extent) +
-		compute_point_mass_inertia(mass_motors, front_extent * FVector(1.0, -1.0, 1.0)) +
+		compute_point_mass_inertia(mass_motors, front_extent * FVector3(1.0, -1.0, 1.0)) +
 		compute_point_mass_inertia(mass_motors, back_extent) +
-		compute_point_mass_inertia(mass_motors, back_extent * FVector(1.0, -1.0, 1.0))
+		compute_point_mass_inertia(mass_motors, back_extent * FVector3(1.0, -1.0, 1.0))
 	);
 }
 
-FVector inertia::compute_battery_inertia_primitive(double mass_battery)
+physics::FVector3 physics::inertia::compute_battery_inertia_primitive(double mass_battery)
 {
 	// OVONIC 6S 100C 1000mAh is 75 * 36 * 35 mm and 171g
 	const auto reference_battery_mass = 0.171;
-	const auto reference_battery_size = FVector(0.075, 0.036, 0.035);
+	const auto reference_battery_size = FVector3(0.075, 0.036, 0.035);
 
-	const double battery_size_scale = FMath::Pow(mass_battery / reference_battery_mass, 1.0 / 3.0);
-	const FVector extent = (battery_size_scale * reference_battery_size) * 0.5;
+	const double battery_size_scale = std::pow(mass_battery / reference_battery_mass, 1.0 / 3.0);
+	const FVector3 extent = (reference_battery_size * battery_size_scale) * 0.5;
 
 	return compute_box_inertia(mass_battery, extent);
 }
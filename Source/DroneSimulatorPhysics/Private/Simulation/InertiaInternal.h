@@ -0,0 +1,18 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/Math/Quaternion.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+namespace physics::inertia
+{
+	double uu_to_meters(double uu);
+	FVector3 kgm2_to_kgcm2(const FVector3& inertia_si);
+	FVector3 compute_box_inertia(double mass, const FVector3& extent);
+	FVector3 compute_point_mass_inertia(double mass, const FVector3& offset);
+	FVector3 compute_rotated_box_inertia(double mass, const FVector3& extent, const FRotation& rotation);
+
+	// Primitive part-specific inertia functions
+	FVector3 compute_frame_inertia_primitive(double mass_frame, const FVector3& front_extent, const FVector3& back_extent);
+	FVector3 compute_motors_inertia_primitive(double mass_motors, const FVector3& front_extent, const FVector3& back_extent);
+	FVector3 compute_battery_inertia_primitive(double mass_battery);
+}
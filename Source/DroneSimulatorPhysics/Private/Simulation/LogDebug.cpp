@@ -0,0 +1,11 @@
+#include "DroneSimulatorPhysics/Public/Simulation/LogDebug.h"
+
+void physics::FDebugLog::log(const std::string& log)
+{
+	this->logs.push_back(log);
+}
+
+void physics::FDebugLog::append_debug_log(const FDebugLog& other)
+{
+	this->logs.insert(this->logs.end(), other.logs.begin(), other.logs.end());
+}
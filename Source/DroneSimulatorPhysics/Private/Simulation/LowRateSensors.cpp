@@ -0,0 +1,249 @@
+#include "DroneSimulatorPhysics/Public/Simulation/LowRateSensors.h"
+#include "DroneSimulatorPhysics/Public/Collision/CollisionWorld.h"
+#include "DroneSimulatorPhysics/Public/Math/Random.h"
+#include "DroneSimulatorPhysics/Public/Simulation/StateExchange.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// Stream 0 is the IMU
+	constexpr std::uint64_t first_noise_stream = 1;
+
+	// The GPS draws the most: three for the position, three for the velocity
+	constexpr std::int32_t normals_per_sample = 6;
+
+	using FNormals = std::array<double, normals_per_sample>;
+
+	const physics::FLowRateSensorTiming& get_timing(const physics::FLowRateSensorsConfig& config, std::int32_t sensor_index)
+	{
+		switch (static_cast<physics::ELowRateSensor>(sensor_index))
+		{
+		case physics::ELowRateSensor::barometer: return config.barometer.timing;
+		case physics::ELowRateSensor::gps: return config.gps.timing;
+		case physics::ELowRateSensor::magnetometer: return config.magnetometer.timing;
+		default: return config.rangefinder.timing;
+		}
+	}
+
+	// International standard atmosphere, troposphere
+	double get_pressure(double altitude, double sea_level_pressure)
+	{
+		return sea_level_pressure * std::pow(1.0 - 2.25577e-5 * altitude, 5.25588);
+	}
+
+	void measure_barometer(physics::FLowRateSensorSample& sample, physics::FLowRateSensorsState& state,
+		const physics::FBarometerConfig& config, const physics::FVector3& location_world, double delta_time, const FNormals& normals)
+	{
+		state.barometer_bias += normals[1] * config.altitude_bias_random_walk * std::sqrt(delta_time);
+
+		sample.altitude = config.origin_altitude + location_world.Z / 100.0 + state.barometer_bias + normals[0] * config.altitude_noise;
+		sample.pressure = get_pressure(sample.altitude, config.sea_level_pressure);
+	}
+
+	void measure_gps(physics::FLowRateSensorSample& sample, physics::FLowRateSensorsState& state, const physics::FGpsConfig& config,
+		const physics::FVector3& location_world, const physics::FVector3& velocity_world, double delta_time, const FNormals& normals)
+	{
+		// First order Gauss-Markov, the first sample draws from the steady state
+		const auto decay = sample.sample_index > 0 && config.position_error_time_constant > 0.0
+			? std::exp(-delta_time / config.position_error_time_constant)
+			: 0.0;
+		const auto innovation = std::sqrt(1.0 - decay * decay);
+
+		auto& error = state.gps_position_error;
+		error.X = error.X * decay + normals[0] * config.horizontal_position_error * innovation;
+		error.Y = error.Y * decay + normals[1] * config.horizontal_position_error * innovation;
+		error.Z = error.Z * decay + normals[2] * config.vertical_position_error * innovation;
+
+		sample.position = location_world / 100.0 + error;
+
+		// The velocity comes from the Doppler shift, its noise is white
+		sample.velocity = velocity_world + physics::FVector3(normals[3], normals[4], normals[5]) * config.velocity_noise;
+	}
+
+	void measure_magnetometer(physics::FLowRateSensorSample& sample, const physics::FMagnetometerConfig& config,
+		const physics::FQuaternion& rotation_world, const FNormals& normals)
+	{
+		sample.magnetic_field = rotation_world.unrotate_vector(config.field_world)
+			+ physics::FVector3(normals[0], normals[1], normals[2]) * config.field_noise;
+	}
+
+	void measure_rangefinder(physics::FLowRateSensorSample& sample, const physics::FRangefinderConfig& config,
+		const physics::FRigidTransform& transform_world, const physics::FGroundHeightQuery& ground_height, const FNormals& normals)
+	{
+		sample.is_valid = false;
+
+		// The ground is taken as flat under the drone: the beam along -Z hits it at the height over the cosine of the tilt
+		const auto beam_world = -transform_world.rotation.get_axis_z();
+		const auto height = ground_height ? ground_height(transform_world.location) : std::nullopt;
+		if (!height.has_value() || beam_world.Z >= -1e-3)
+		{
+			return;
+		}
+
+		const auto range = (transform_world.location.Z - *height) / 100.0 / -beam_world.Z;
+		if (range < 0.0 || range > config.max_range)
+		{
+			return;
+		}
+
+		sample.is_valid = true;
+		sample.range = std::max(range + normals[0] * config.range_noise, 0.0);
+	}
+
+	void add_pending(physics::FLowRateSensorSuite& suite, const physics::FLowRateSensorSample& sample)
+	{
+		// Can't be full within the timing limits, see max_pending_low_rate_samples
+		auto& state = suite.state;
+		if (state.pending_count >= physics::max_pending_low_rate_samples)
+		{
+			suite.dropped_pending_count++;
+			return;
+		}
+
+		state.pending_samples[state.pending_count] = sample;
+		state.pending_count++;
+	}
+
+	// In the order they were measured, so the samples of each sensor stay in order
+	void publish_due_samples(physics::FLowRateSensorSuite& suite, double time)
+	{
+		auto& state = suite.state;
+
+		std::int32_t kept_count = 0;
+		for (std::int32_t index = 0; index < state.pending_count; index++)
+		{
+			const auto& sample = state.pending_samples[index];
+			if (sample.publish_time <= time)
+			{
+				suite.samples.push(sample);
+			}
+			else
+			{
+				state.pending_samples[kept_count] = sample;
+				kept_count++;
+			}
+		}
+
+		state.pending_count = kept_count;
+	}
+}
+
+void physics::low_rate_sensors::update(FLowRateSensorSuite& suite, const FPublishedDroneState& drone_state,
+	const FGroundHeightQuery& ground_height)
+{
+	const auto& config = suite.config;
+	auto& state = suite.state;
+	const auto time = drone_state.simulation_time;
+
+	if (state.is_started && time < state.last_update_time)
+	{
+		reset(suite);
+	}
+
+	if (!state.is_started)
+	{
+		state.is_started = true;
+		state.next_sample_times.fill(time);
+	}
+
+	state.last_update_time = time;
+
+	for (std::int32_t sensor_index = 0; sensor_index < low_rate_sensor_count; sensor_index++)
+	{
+		const auto& timing = get_timing(config, sensor_index);
+		if (!timing.is_enabled || timing.rate_hz <= 0.0)
+		{
+			continue;
+		}
+
+		const auto period = 1.0 / std::min(timing.rate_hz, max_low_rate_sensor_rate_hz);
+		const auto latency = std::clamp(timing.latency, 0.0, max_low_rate_sensor_latency);
+		auto& next_sample_time = state.next_sample_times[sensor_index];
+		auto& sample_count = state.sample_counts[sensor_index];
+
+		// After a long hitch, or a nap of the drone, the sensor resumes from the current state instead of catching up
+		if (next_sample_time < time - max_low_rate_catch_up_time)
+		{
+			next_sample_time += std::floor((time - next_sample_time) / period) * period;
+		}
+
+		while (next_sample_time <= time)
+		{
+			FLowRateSensorSample sample;
+			sample.sensor = static_cast<ELowRateSensor>(sensor_index);
+			sample.sample_index = sample_count;
+			sample.time = next_sample_time;
+			sample.publish_time = next_sample_time + latency;
+
+			FNormals normals;
+			random::fill_normal(config.seed, first_noise_stream + sensor_index, static_cast<std::uint64_t>(sample_count) * normals_per_sample,
+				normals);
+
+			// Moved back along the velocity to the time of the sample. The rotation is held, the sample is at most one
+			// physics tick older than the state.
+			auto transform_world = drone_state.transform_world;
+			transform_world.location -= drone_state.linear_velocity_world * (100.0 * (time - next_sample_time));
+
+			switch (sample.sensor)
+			{
+			case ELowRateSensor::barometer:
+				measure_barometer(sample, state, config.barometer, transform_world.location, period, normals);
+				break;
+			case ELowRateSensor::gps:
+				measure_gps(sample, state, config.gps, transform_world.location, drone_state.linear_velocity_world, period, normals);
+				break;
+			case ELowRateSensor::magnetometer:
+				measure_magnetometer(sample, config.magnetometer, transform_world.rotation, normals);
+				break;
+			case ELowRateSensor::rangefinder:
+				measure_rangefinder(sample, config.rangefinder, transform_world, ground_height, normals);
+				break;
+			}
+
+			add_pending(suite, sample);
+			sample_count++;
+			next_sample_time += period;
+		}
+	}
+
+	publish_due_samples(suite, time);
+}
+
+void physics::low_rate_sensors::reset(FLowRateSensorSuite& suite)
+{
+	suite.state = FLowRateSensorsState();
+}
+
+physics::FGroundHeightQuery physics::low_rate_sensors::make_ground_height_query(const FCollisionWorld& collision_world)
+{
+	return [&collision_world](const FVector3& location_world) -> std::optional<double>
+	{
+		const auto& geometry = collision_world.geometry;
+
+		// Highest surface below the location
+		std::optional<double> height;
+		if (geometry.ground_height.has_value() && *geometry.ground_height <= location_world.Z)
+		{
+			height = geometry.ground_height;
+		}
+
+		for (const auto shape_index : collision_world.get_candidate_shapes(location_world))
+		{
+			const auto* heightfield = std::get_if<FCollisionHeightfield>(&geometry.shapes[shape_index]);
+			if (heightfield == nullptr || !heightfield->contains(location_world.X, location_world.Y))
+			{
+				continue;
+			}
+
+			const auto terrain_height = heightfield->origin.Z + heightfield->get_height(location_world.X, location_world.Y);
+			if (terrain_height <= location_world.Z && (!height.has_value() || terrain_height > *height))
+			{
+				height = terrain_height;
+			}
+		}
+
+		return height;
+	};
+}
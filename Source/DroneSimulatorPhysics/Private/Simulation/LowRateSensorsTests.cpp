@@ -0,0 +1,316 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Public/Collision/CollisionWorld.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/Simulation/LowRateSensors.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SpscQueue.h"
+#include "DroneSimulatorPhysics/Public/Simulation/StateExchange.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// Published like the physics side of the game does, at 60 Hz
+	constexpr double publish_rate_hz = 60.0;
+
+	physics::FPublishedDroneState make_state(double time, const physics::FVector3& location = physics::FVector3(0.0, 0.0, 300.0),
+		const physics::FQuaternion& rotation = physics::FQuaternion::identity())
+	{
+		physics::FPublishedDroneState state;
+		state.is_valid = true;
+		state.simulation_time = time;
+		state.transform_world = physics::FRigidTransform(rotation, location);
+		return state;
+	}
+
+	std::vector<physics::FLowRateSensorSample> pop_all(physics::FLowRateSensorSuite& suite)
+	{
+		std::vector<physics::FLowRateSensorSample> samples;
+		physics::FLowRateSensorSample sample;
+		while (suite.samples.pop(sample))
+		{
+			samples.push_back(sample);
+		}
+		return samples;
+	}
+
+	void enable_noiseless_sensors(physics::FLowRateSensorSuite& suite)
+	{
+		auto& config = suite.config;
+		config.barometer.timing.is_enabled = true;
+		config.barometer.altitude_noise = 0.0;
+		config.barometer.altitude_bias_random_walk = 0.0;
+		config.gps.timing.is_enabled = true;
+		config.gps.horizontal_position_error = 0.0;
+		config.gps.vertical_position_error = 0.0;
+		config.gps.velocity_noise = 0.0;
+		config.magnetometer.timing.is_enabled = true;
+		config.magnetometer.field_noise = 0.0;
+		config.rangefinder.timing.is_enabled = true;
+		config.rangefinder.range_noise = 0.0;
+	}
+
+	// Flat ground at Z = 0
+	const auto flat_ground = physics::FGroundHeightQuery([](const physics::FVector3&) { return std::optional<double>(0.0); });
+}
+
+TEST_CASE("Low rate sensors", "[simulation][sensors]")
+{
+	SECTION("Each sensor samples at its own rate and publishes after its latency")
+	{
+		physics::FLowRateSensorSuite suite;
+		enable_noiseless_sensors(suite);
+
+		std::vector<physics::FLowRateSensorSample> samples;
+		for (std::int32_t frame = 0; frame <= 64; frame++)
+		{
+			const auto time = frame / publish_rate_hz;
+			physics::low_rate_sensors::update(suite, make_state(time), flat_ground);
+
+			for (const auto& sample : pop_all(suite))
+			{
+				REQUIRE(sample.publish_time <= time);
+				samples.push_back(sample);
+			}
+		}
+
+		std::array<std::vector<double>, physics::low_rate_sensor_count> times;
+		for (const auto& sample : samples)
+		{
+			times[static_cast<std::int32_t>(sample.sensor)].push_back(sample.time);
+		}
+
+		// Over 1.067 s, minus the samples still waiting for their latency
+		CHECK(times[static_cast<std::int32_t>(physics::ELowRateSensor::barometer)].size() == 53);
+		CHECK(times[static_cast<std::int32_t>(physics::ELowRateSensor::gps)].size() == 10);
+		CHECK(times[static_cast<std::int32_t>(physics::ELowRateSensor::magnetometer)].size() == 107);
+		CHECK(times[static_cast<std::int32_t>(physics::ELowRateSensor::rangefinder)].size() == 53);
+
+		// Evenly spaced, whatever the rate of the published states
+		const auto& gps_times = times[static_cast<std::int32_t>(physics::ELowRateSensor::gps)];
+		for (std::size_t index = 0; index < gps_times.size(); index++)
+		{
+			REQUIRE(gps_times[index] == Approx(index * 0.1).margin(1e-9));
+		}
+		CHECK(suite.state.pending_count > 0);
+	}
+
+	SECTION("Measurements of a tilted drone")
+	{
+		physics::FLowRateSensorSuite suite;
+		enable_noiseless_sensors(suite);
+		const auto rotation = physics::FQuaternion::from_rotation(physics::FRotation(30.0, 0.0, 0.0));
+		auto state = make_state(0.0, physics::FVector3(100.0, 200.0, 300.0), rotation);
+		state.linear_velocity_world = physics::FVector3(1.0, 0.0, 0.0);
+
+		// The latency is a whole frame at most
+		physics::low_rate_sensors::update(suite, state, flat_ground);
+		state.simulation_time = 0.2;
+		state.transform_world.location.X += 20.0;
+		physics::low_rate_sensors::update(suite, state, flat_ground);
+
+		bool has_sensor[physics::low_rate_sensor_count] = {};
+		for (const auto& sample : pop_all(suite))
+		{
+			if (sample.sample_index != 0)
+			{
+				continue;
+			}
+
+			has_sensor[static_cast<std::int32_t>(sample.sensor)] = true;
+			switch (sample.sensor)
+			{
+			case physics::ELowRateSensor::barometer:
+				CHECK(sample.altitude == Approx(3.0));
+				CHECK(sample.pressure == Approx(101325.0 - 3.0 * 12.0).margin(1.0));
+				break;
+			case physics::ELowRateSensor::gps:
+				CHECK(sample.position.X == Approx(1.0));
+				CHECK(sample.position.Y == Approx(2.0));
+				CHECK(sample.velocity.X == Approx(1.0));
+				break;
+			case physics::ELowRateSensor::magnetometer:
+				CHECK(sample.magnetic_field.size() == Approx(suite.config.magnetometer.field_world.size()));
+				CHECK(sample.magnetic_field.Z != Approx(suite.config.magnetometer.field_world.Z));
+				break;
+			case physics::ELowRateSensor::rangefinder:
+				REQUIRE(sample.is_valid);
+				CHECK(sample.range == Approx(3.0 / std::cos(physics::math::degrees_to_radians(30.0))));
+				break;
+			}
+		}
+
+		for (const auto has_samples : has_sensor)
+		{
+			CHECK(has_samples);
+		}
+	}
+
+	SECTION("Out of range and without ground, the rangefinder has no sample")
+	{
+		physics::FLowRateSensorSuite suite;
+		suite.config.rangefinder.timing.is_enabled = true;
+		suite.config.rangefinder.timing.latency = 0.0;
+
+		physics::low_rate_sensors::update(suite, make_state(0.0, physics::FVector3(0.0, 0.0, 1000.0)), flat_ground);
+		physics::low_rate_sensors::update(suite, make_state(0.02), physics::FGroundHeightQuery());
+
+		const auto samples = pop_all(suite);
+		REQUIRE(samples.size() == 2);
+		CHECK_FALSE(samples[0].is_valid);
+		CHECK_FALSE(samples[1].is_valid);
+	}
+
+	SECTION("The ground of a collision world")
+	{
+		physics::FCollisionGeometry geometry;
+		geometry.ground_height = -50.0;
+		physics::FCollisionHeightfield heightfield;
+		heightfield.origin = physics::FVector3(0.0, 0.0, 10.0);
+		heightfield.num_samples_x = 2;
+		heightfield.num_samples_y = 2;
+		heightfield.heights = { 0.0, 0.0, 0.0, 0.0 };
+		geometry.shapes.push_back(heightfield);
+		const auto collision_world = physics::collision::compile(geometry);
+
+		const auto query = physics::low_rate_sensors::make_ground_height_query(*collision_world);
+		CHECK(query(physics::FVector3(50.0, 50.0, 100.0)) == 10.0);
+		CHECK(query(physics::FVector3(500.0, 500.0, 100.0)) == -50.0);
+		CHECK_FALSE(query(physics::FVector3(500.0, 500.0, -100.0)).has_value());
+	}
+
+	SECTION("The noise is a function of the seed and the sample index")
+	{
+		physics::FLowRateSensorSuite first;
+		first.config.gps.timing.is_enabled = true;
+		first.config.gps.timing.latency = 0.0;
+		physics::FLowRateSensorSuite second;
+		second.config = first.config;
+
+		// Different publish rates, same samples
+		for (std::int32_t frame = 0; frame <= 31; frame++)
+		{
+			physics::low_rate_sensors::update(first, make_state(frame / 30.0), flat_ground);
+		}
+		for (std::int32_t frame = 0; frame <= 124; frame++)
+		{
+			physics::low_rate_sensors::update(second, make_state(frame / 120.0), flat_ground);
+		}
+
+		const auto first_samples = pop_all(first);
+		const auto second_samples = pop_all(second);
+		REQUIRE(first_samples.size() == 11);
+		REQUIRE(second_samples.size() == 11);
+		for (std::size_t index = 0; index < first_samples.size(); index++)
+		{
+			REQUIRE(first_samples[index].position == second_samples[index].position);
+		}
+		CHECK(first_samples[3].position != first_samples[4].position);
+	}
+
+	SECTION("A hitch skips the samples instead of catching up, going back in time restarts")
+	{
+		physics::FLowRateSensorSuite suite;
+		suite.config.magnetometer.timing.is_enabled = true;
+
+		physics::low_rate_sensors::update(suite, make_state(0.0), flat_ground);
+		physics::low_rate_sensors::update(suite, make_state(5.0), flat_ground);
+		CHECK(suite.state.sample_counts[static_cast<std::int32_t>(physics::ELowRateSensor::magnetometer)] <= 12);
+
+		physics::low_rate_sensors::update(suite, make_state(1.0), flat_ground);
+		CHECK(suite.state.sample_counts[static_cast<std::int32_t>(physics::ELowRateSensor::magnetometer)] == 1);
+	}
+
+	SECTION("Timings past the limits are clamped, so that no pending sample is dropped")
+	{
+		physics::FLowRateSensorSuite suite;
+		enable_noiseless_sensors(suite);
+		for (auto* timing : { &suite.config.barometer.timing, &suite.config.gps.timing, &suite.config.magnetometer.timing,
+			&suite.config.rangefinder.timing })
+		{
+			timing->rate_hz = 10000.0;
+			timing->latency = 10.0;
+		}
+
+		// Updates at 60 Hz with hitches just under the catch up time
+		double time = 0.0;
+		for (std::int32_t frame = 0; frame < 100; frame++)
+		{
+			time += frame % 5 == 0 ? physics::max_low_rate_catch_up_time * 0.99 : 1.0 / publish_rate_hz;
+			physics::low_rate_sensors::update(suite, make_state(time), flat_ground);
+			pop_all(suite);
+		}
+
+		CHECK(suite.dropped_pending_count == 0);
+		CHECK(suite.state.sample_counts[static_cast<std::int32_t>(physics::ELowRateSensor::gps)]
+			<= static_cast<std::int64_t>(time * physics::max_low_rate_sensor_rate_hz) + 1);
+	}
+}
+
+TEST_CASE("SPSC queue", "[simulation][sensors]")
+{
+	SECTION("First in, first out, drops when full")
+	{
+		physics::TSpscQueue<std::int32_t, 4> queue;
+		for (std::int32_t value = 0; value < 6; value++)
+		{
+			CHECK(queue.push(value) == (value < 4));
+		}
+		CHECK(queue.get_dropped_count() == 2);
+		CHECK(queue.size() == 4);
+
+		std::int32_t value = -1;
+		REQUIRE(queue.pop(value));
+		CHECK(value == 0);
+		REQUIRE(queue.push(10));
+
+		std::vector<std::int32_t> values;
+		while (queue.pop(value))
+		{
+			values.push_back(value);
+		}
+		CHECK(values == std::vector<std::int32_t> { 1, 2, 3, 10 });
+	}
+
+	SECTION("Reader on another thread gets every value, in order")
+	{
+		constexpr std::int32_t count = 200000;
+		physics::TSpscQueue<std::int32_t, 64> queue;
+
+		std::thread writer([&queue]
+		{
+			for (std::int32_t value = 0; value < count; value++)
+			{
+				while (!queue.push(value))
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		std::int32_t expected = 0;
+		bool is_in_order = true;
+		while (expected < count)
+		{
+			std::int32_t value;
+			if (queue.pop(value))
+			{
+				is_in_order &= value == expected;
+				expected++;
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+		writer.join();
+
+		CHECK(is_in_order);
+	}
+}
+
+#endif
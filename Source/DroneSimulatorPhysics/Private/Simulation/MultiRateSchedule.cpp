@@ -0,0 +1,72 @@
+#include "DroneSimulatorPhysics/Public/Simulation/MultiRateSchedule.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneModel.h"
+#include "DroneSimulatorPhysics/Public/Simulation/LinearDrag.h"
+#include "DroneSimulatorPhysics/Public/Simulation/RotationalDrag.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+
+#include <algorithm>
+#include <cmath>
+
+std::int32_t physics::FMultiRateSchedule::get_substep_interval(double rate_hz, double tick_rate_hz)
+{
+	if (rate_hz <= 0.0 || rate_hz >= tick_rate_hz)
+	{
+		return 1;
+	}
+
+	return std::max(1, static_cast<std::int32_t>(std::lround(tick_rate_hz / rate_hz)));
+}
+
+physics::FSubstepStages physics::FMultiRateSchedule::get_stages(std::int64_t substep_index, double tick_rate_hz) const
+{
+	const auto runs_on_substep = [substep_index, tick_rate_hz](double rate_hz)
+	{
+		return substep_index % get_substep_interval(rate_hz, tick_rate_hz) == 0;
+	};
+
+	FSubstepStages stages;
+	stages.controller = runs_on_substep(this->controller_rate_hz);
+	stages.rotor_aerodynamics = runs_on_substep(this->rotor_aerodynamics_rate_hz);
+	stages.drag = runs_on_substep(this->drag_rate_hz);
+	stages.environment_sampling = runs_on_substep(this->environment_sampling_rate_hz);
+	stages.recording = runs_on_substep(this->recording_rate_hz);
+	stages.imu = runs_on_substep(this->imu_rate_hz);
+	stages.controller_delta_time = get_substep_interval(this->controller_rate_hz, tick_rate_hz) / tick_rate_hz;
+	stages.imu_delta_time = get_substep_interval(this->imu_rate_hz, tick_rate_hz) / tick_rate_hz;
+	return stages;
+}
+
+void physics::multi_rate::sample_environment(FHeldStageOutputs& held_outputs, const FSimulationWorld& simulation_world,
+	const FSubstepStages& stages)
+{
+	if (stages.environment_sampling)
+	{
+		held_outputs.sampled_world = simulation_world;
+	}
+}
+
+void physics::multi_rate::apply_drag(FHeldStageOutputs& held_outputs, FSubstepBody* substep_body, const FDroneModel& model,
+	const FSubstepStages& stages)
+{
+	if (!model.has_drag())
+	{
+		return;
+	}
+
+	if (!stages.drag)
+	{
+		substep_body->add_force(held_outputs.drag_force_world);
+		substep_body->add_torque(held_outputs.drag_torque_world);
+		return;
+	}
+
+	// The drag functions add to the accumulators, the difference is what they added
+	const auto force_before_drag = substep_body->accumulated_force_world;
+	const auto torque_before_drag = substep_body->accumulated_torque_world;
+
+	simulation::calculate_linear_drag(substep_body, model.total_cda, &held_outputs.sampled_world);
+	simulation::calculate_rotational_drag(substep_body);
+
+	held_outputs.drag_force_world = substep_body->accumulated_force_world - force_before_drag;
+	held_outputs.drag_torque_world = substep_body->accumulated_torque_world - torque_before_drag;
+}
@@ -0,0 +1,51 @@
+#include "DroneSimulatorPhysics/Public/Simulation/RenderInterpolation.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+
+void physics::FRenderInterpolator::push(double time_seconds, const FRigidTransform& transform)
+{
+	if (this->count > 0 && time_seconds <= this->latest.time_seconds)
+	{
+		return;
+	}
+
+	// The first state is both ends, so that the drone is rendered where it spawned until the second one
+	this->previous = this->count > 0 ? this->latest : FTimedTransform { time_seconds, transform };
+	this->latest = FTimedTransform { time_seconds, transform };
+	this->count = this->count > 0 ? 2 : 1;
+	this->time_since_latest = 0.0;
+}
+
+physics::FRigidTransform physics::FRenderInterpolator::advance(double render_delta_time)
+{
+	this->time_since_latest += render_delta_time;
+	return this->sample(this->previous.time_seconds + this->time_since_latest);
+}
+
+physics::FRigidTransform physics::FRenderInterpolator::sample(double time_seconds) const
+{
+	if (this->count == 0)
+	{
+		return FRigidTransform();
+	}
+
+	const auto interval = this->latest.time_seconds - this->previous.time_seconds;
+	if (interval <= 0.0 || time_seconds >= this->latest.time_seconds)
+	{
+		return this->latest.transform;
+	}
+
+	if (time_seconds <= this->previous.time_seconds)
+	{
+		return this->previous.transform;
+	}
+
+	const auto alpha = (time_seconds - this->previous.time_seconds) / interval;
+	const auto& from = this->previous.transform;
+	const auto& to = this->latest.transform;
+
+	return FRigidTransform(
+		FQuaternion::slerp(from.rotation, to.rotation, alpha),
+		FVector3(math::lerp(from.location.X, to.location.X, alpha), math::lerp(from.location.Y, to.location.Y, alpha),
+			math::lerp(from.location.Z, to.location.Z, alpha))
+	);
+}
@@ -0,0 +1,72 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Public/Simulation/RenderInterpolation.h"
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Render interpolation", "[physics][render]")
+{
+	using physics::FQuaternion;
+	using physics::FRigidTransform;
+	using physics::FRotation;
+	using physics::FVector3;
+
+	// Physics at 32 Hz, rendering at 128 Hz: binary-exact times
+	constexpr double physics_interval = 1.0 / 32.0;
+	constexpr double render_interval = 1.0 / 128.0;
+
+	const auto from = FRigidTransform(FQuaternion::identity(), FVector3(0.0, 0.0, 0.0));
+	const auto to = FRigidTransform(FQuaternion::from_rotation(FRotation(0.0, 90.0, 0.0)), FVector3(400.0, 0.0, 100.0));
+
+	physics::FRenderInterpolator interpolator;
+
+	SECTION("Holds the first state")
+	{
+		interpolator.push(0.0, from);
+		CHECK(interpolator.advance(render_interval).location == from.location);
+	}
+
+	SECTION("Moves from the previous state to the latest one over a physics interval")
+	{
+		interpolator.push(0.0, from);
+		interpolator.push(physics_interval, to);
+
+		const auto quarter = interpolator.advance(render_interval);
+		CHECK(quarter.location.X == Approx(100.0));
+		CHECK(quarter.location.Z == Approx(25.0));
+		CHECK(quarter.rotation.to_rotation().Yaw == Approx(22.5));
+
+		interpolator.advance(render_interval);
+		const auto three_quarters = interpolator.advance(render_interval);
+		CHECK(three_quarters.location.X == Approx(300.0));
+		CHECK(three_quarters.rotation.to_rotation().Yaw == Approx(67.5));
+	}
+
+	SECTION("Holds the latest state when the physics is late")
+	{
+		interpolator.push(0.0, from);
+		interpolator.push(physics_interval, to);
+
+		for (int frame = 0; frame < 10; frame++)
+		{
+			interpolator.advance(render_interval);
+		}
+
+		CHECK(interpolator.advance(render_interval).location == to.location);
+	}
+
+	SECTION("Ignores states that are not newer")
+	{
+		interpolator.push(physics_interval, to);
+		interpolator.push(physics_interval, from);
+		interpolator.push(0.0, from);
+		CHECK(interpolator.count == 1);
+		CHECK(interpolator.latest.transform.location == to.location);
+
+		interpolator.clear();
+		interpolator.push(0.0, from);
+		CHECK(interpolator.latest.transform.location == from.location);
+	}
+}
+
+#endif
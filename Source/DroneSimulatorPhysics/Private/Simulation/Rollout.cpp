@@ -0,0 +1,52 @@
+#include "DroneSimulatorPhysics/Public/Simulation/Rollout.h"
+#include "DroneSimulatorPhysics/Private/Environment/WorkerPool.h"
+
+#include <algorithm>
+#include <thread>
+
+physics::FRolloutBrancher::FRolloutBrancher(std::int32_t num_threads)
+	: worker_pool(std::make_unique<FWorkerPool>(num_threads > 0
+		? num_threads
+		: std::max(1, static_cast<std::int32_t>(std::thread::hardware_concurrency()))))
+{
+}
+
+physics::FRolloutBrancher::~FRolloutBrancher() = default;
+
+std::vector<physics::FRolloutTrajectory> physics::FRolloutBrancher::run(const FDroneSimulation& drone,
+	const FDroneSimulationSnapshot& snapshot, const std::vector<std::vector<FDronePlayerInput>>& branch_inputs,
+	std::int32_t substeps_per_input)
+{
+	std::vector<FRolloutTrajectory> trajectories(branch_inputs.size());
+
+	this->worker_pool->parallel_for(static_cast<std::int32_t>(branch_inputs.size()), [&](std::int32_t begin, std::int32_t end)
+	{
+		for (auto branch_index = begin; branch_index < end; branch_index++)
+		{
+			// Each branch has its own copy, so that the branches don't share controller or flight mode state
+			auto branch_drone = drone;
+			snapshot::restore(branch_drone, snapshot);
+
+			auto& trajectory = trajectories[branch_index];
+			trajectory.samples.reserve(branch_inputs[branch_index].size());
+
+			for (const auto& input : branch_inputs[branch_index])
+			{
+				branch_drone.advance_substeps(substeps_per_input, input);
+
+				const auto& body = branch_drone.body;
+				trajectory.samples.push_back(FRolloutSample {
+					branch_drone.get_simulation_time(),
+					body.transform_world.location,
+					body.transform_world.rotation,
+					body.linear_velocity_world,
+					body.angular_velocity_radians_world,
+				});
+			}
+
+			trajectory.final_snapshot = snapshot::capture(branch_drone);
+		}
+	});
+
+	return trajectories;
+}
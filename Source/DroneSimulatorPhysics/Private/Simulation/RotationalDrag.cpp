@@ -0,0 +1,24 @@
+#include "DroneSimulatorPhysics/Public/Simulation/RotationalDrag.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+
+#include <cmath>
+
+
+void physics::simulation::calculate_rotational_drag(FSubstepBody* substep_body)
+{
+	const auto& transform = substep_body->transform_world;
+
+	// Rotational aero drag (yaw/pitch/roll), quadratic in angular speed
+	const FVector3 omega_ws = substep_body->angular_velocity_radians_world;
+	const FVector3 omega_ls = transform.inverse_transform_vector(omega_ws);
+	const FVector3 k_omega(0.00010, 0.00010, 0.00005); // tune per axis (N·m per rad/s^2-ish)
+
+	const FVector3 tau_aero_ls(
+		-k_omega.X * omega_ls.X * std::abs(omega_ls.X),
+		-k_omega.Y * omega_ls.Y * std::abs(omega_ls.Y),
+		-k_omega.Z * omega_ls.Z * std::abs(omega_ls.Z)
+	);
+
+	const auto torque = transform.transform_vector(tau_aero_ls);
+	substep_body->add_torque(torque);
+}
@@ -0,0 +1,250 @@
+#include "DroneSimulatorPhysics/Public/Simulation/SimulationBatch.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+
+#include <algorithm>
+
+namespace
+{
+	// The PID of the drone runs in the batch if the drone would run it itself
+	physics::FPidDroneController* find_batched_controller(physics::FDroneSimulation& drone)
+	{
+		if (!drone.is_armed || !drone.model->has_propulsion() || drone.model->get_propulsion_setup().mixer == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto* dynamics = std::get_if<physics::FPropulsionModelDynamics>(&drone.propulsion_model);
+		return dynamics != nullptr ? std::get_if<physics::FPidDroneController>(&dynamics->controller) : nullptr;
+	}
+
+	// The gyro filter only runs on the samples of the IMU
+	bool has_gyro_filter(const physics::FDroneSimulation& drone)
+	{
+		return drone.imu.config.is_enabled && drone.gyro_filter.config.is_enabled;
+	}
+
+	// The batch holds the controller and gyro filter states while it runs, the drone gets them back before being hashed
+	void write_back_states(physics::FDroneSimulation& drone, const physics::FSimulationBatch& batch, std::int32_t drone_index)
+	{
+		if (batch.has_batched_controller[drone_index] != 0)
+		{
+			find_batched_controller(drone)->state = batch.controllers.get_state(drone_index);
+		}
+
+		if (batch.has_batched_gyro_filter[drone_index] != 0)
+		{
+			batch.gyro_filters.get_state(drone_index, drone.gyro_filter.state);
+		}
+	}
+}
+
+void physics::FSimulationBatch::resize(std::int32_t size)
+{
+	this->air_flight_modes.resize(size);
+	this->setpoints.resize(size);
+	this->controllers.resize(size);
+	this->is_awake.resize(size);
+	this->has_air_flight_mode.resize(size);
+	this->has_batched_controller.resize(size);
+	this->has_batched_gyro_filter.resize(size);
+	this->stages.resize(size);
+}
+
+void physics::simulation_batch::advance_substeps(std::span<FDroneSimulation> drones, std::span<const std::int32_t> substep_counts,
+	std::span<const FDronePlayerInput> player_inputs, FSimulationBatch& batch)
+{
+	const auto drone_count = static_cast<std::int32_t>(drones.size());
+	batch.resize(drone_count);
+
+	std::int32_t max_substep_count = 0;
+	std::int32_t max_gyro_filter_stage_count = 0;
+
+	for (std::int32_t drone_index = 0; drone_index < drone_count; drone_index++)
+	{
+		auto& drone = drones[drone_index];
+		const auto substep_count = substep_counts[drone_index];
+
+		// Same as the start of FDroneSimulation::advance_substeps
+		drone.pilot_input_buffer.push(drone.get_simulation_time(), player_inputs[drone_index]);
+		const auto substep_duration = 1.0 / drone.tick_rate_hz;
+		const auto is_asleep = drone.update_sleep(player_inputs[drone_index], substep_count * substep_duration);
+		if (is_asleep)
+		{
+			drone.substep_index += substep_count;
+		}
+
+		batch.is_awake[drone_index] = is_asleep ? 0 : 1;
+		max_substep_count = std::max(max_substep_count, is_asleep ? 0 : substep_count);
+
+		const auto* air_flight_mode = std::get_if<FFlightModeAir>(&drone.flight_mode);
+		batch.has_air_flight_mode[drone_index] = air_flight_mode != nullptr ? 1 : 0;
+		if (air_flight_mode != nullptr)
+		{
+			batch.air_flight_modes.set_flight_mode(drone_index, *air_flight_mode);
+		}
+
+		const auto* controller = find_batched_controller(drone);
+		batch.has_batched_controller[drone_index] = controller != nullptr ? 1 : 0;
+		batch.controllers.is_active[drone_index] = 0;
+		if (controller != nullptr)
+		{
+			batch.controllers.set_controller(drone_index, *controller);
+			batch.controllers.mixers[drone_index] = drone.model->get_propulsion_setup().mixer;
+		}
+
+		batch.has_batched_gyro_filter[drone_index] = has_gyro_filter(drone) ? 1 : 0;
+		if (has_gyro_filter(drone))
+		{
+			const auto rotor_count = static_cast<std::int32_t>(drone.model->rotors.size());
+			max_gyro_filter_stage_count = std::max(max_gyro_filter_stage_count, gyro_filter::get_stage_count(drone.gyro_filter.config, rotor_count));
+		}
+	}
+
+	batch.gyro_filters.resize(drone_count, max_gyro_filter_stage_count);
+	for (std::int32_t drone_index = 0; drone_index < drone_count; drone_index++)
+	{
+		if (batch.has_batched_gyro_filter[drone_index] != 0)
+		{
+			batch.gyro_filters.set_filter(drone_index, drones[drone_index].gyro_filter.state);
+		}
+	}
+
+	for (std::int32_t substep = 0; substep < max_substep_count; substep++)
+	{
+		const auto is_running = [&](std::int32_t drone_index)
+		{
+			return batch.is_awake[drone_index] != 0 && substep < substep_counts[drone_index];
+		};
+
+		// Flight modes: the input of the air modes is gathered, the other modes run per drone
+		for (std::int32_t drone_index = 0; drone_index < drone_count; drone_index++)
+		{
+			if (!is_running(drone_index))
+			{
+				continue;
+			}
+
+			auto& drone = drones[drone_index];
+			const auto player_input = drone.pilot_input_buffer.sample(drone.get_simulation_time());
+
+			if (batch.has_air_flight_mode[drone_index] != 0)
+			{
+				batch.air_flight_modes.set_input(drone_index, player_input);
+			}
+			else
+			{
+				const auto substep_duration = 1.0 / drone.tick_rate_hz;
+				drone.setpoint = flight_mode::compute_setpoint(drone.flight_mode, player_input, drone.build_flight_mode_state(substep_duration));
+			}
+		}
+
+		controller_batch::compute_air_setpoints(batch.air_flight_modes, batch.setpoints);
+
+		// Controllers: the drones whose controller stage runs on this substep are active
+		for (std::int32_t drone_index = 0; drone_index < drone_count; drone_index++)
+		{
+			if (!is_running(drone_index))
+			{
+				batch.controllers.is_active[drone_index] = 0;
+				continue;
+			}
+
+			auto& drone = drones[drone_index];
+			if (batch.has_air_flight_mode[drone_index] != 0)
+			{
+				drone.setpoint = batch.setpoints.get(drone_index);
+			}
+			else
+			{
+				batch.setpoints.set(drone_index, drone.setpoint);
+			}
+
+			auto& stages = batch.stages[drone_index];
+			stages = drone.schedule.get_stages(drone.substep_index, drone.tick_rate_hz);
+
+			if (batch.has_batched_controller[drone_index] != 0)
+			{
+				const auto& rotation = drone.body.transform_world.rotation;
+				const auto* gyro_angular_velocity = drone.get_gyro_angular_velocity();
+				batch.controllers.current_angular_velocity.set(drone_index, gyro_angular_velocity != nullptr
+					? *gyro_angular_velocity
+					: rotation.unrotate_vector(drone.body.angular_velocity_radians_world));
+				batch.controllers.delta_time[drone_index] = stages.controller_delta_time;
+				batch.controllers.is_active[drone_index] = stages.controller ? 1 : 0;
+			}
+		}
+
+		controller_batch::tick_pid(batch.controllers, batch.setpoints);
+
+		// The rest of the substep runs per drone, with the throttle of the batched controllers held
+		for (std::int32_t drone_index = 0; drone_index < drone_count; drone_index++)
+		{
+			batch.gyro_filters.is_active[drone_index] = 0;
+			if (!is_running(drone_index))
+			{
+				continue;
+			}
+
+			auto& drone = drones[drone_index];
+			auto stages = batch.stages[drone_index];
+
+			if (batch.has_batched_controller[drone_index] != 0)
+			{
+				if (batch.controllers.is_active[drone_index] != 0)
+				{
+					std::get<FPropulsionModelDynamics>(drone.propulsion_model).held_outputs.throttle = batch.controllers.throttle[drone_index];
+				}
+				stages.controller = false;
+			}
+
+			if (batch.has_batched_gyro_filter[drone_index] != 0)
+			{
+				stages.gyro_filter = false;
+			}
+
+			drone.simulate_substep(1.0 / drone.tick_rate_hz, stages);
+
+			// Gyro filters: the drones that took an IMU sample on this substep are active. Retuning is per drone, and
+			// rare, only the coefficients that moved are copied to the bank.
+			const auto* imu_sample = drone.imu.samples.get_latest();
+			if (batch.has_batched_gyro_filter[drone_index] != 0 && stages.imu && stages.imu_delta_time > 0.0 && imu_sample != nullptr)
+			{
+				if (gyro_filter::retune(drone.gyro_filter, drone.get_rotor_throttle(), drone.get_max_rotor_speed(), 1.0 / stages.imu_delta_time))
+				{
+					batch.gyro_filters.set_coefficients(drone_index, drone.gyro_filter.state);
+				}
+
+				batch.gyro_filters.input.set(drone_index, imu_sample->angular_velocity);
+				batch.gyro_filters.is_active[drone_index] = 1;
+			}
+		}
+
+		gyro_filter::apply_bank(batch.gyro_filters);
+
+		for (std::int32_t drone_index = 0; drone_index < drone_count; drone_index++)
+		{
+			if (batch.gyro_filters.is_active[drone_index] != 0)
+			{
+				auto& gyro_filter_state = drones[drone_index].gyro_filter.state;
+				gyro_filter_state.output = batch.gyro_filters.output.get(drone_index);
+				gyro_filter_state.has_output = true;
+			}
+		}
+
+		// Same entries as FDroneSimulation::simulate_substep records
+		for (std::int32_t drone_index = 0; drone_index < drone_count; drone_index++)
+		{
+			auto& drone = drones[drone_index];
+			if (is_running(drone_index) && drone.state_hash_log.should_hash(drone.substep_index))
+			{
+				write_back_states(drone, batch, drone_index);
+				drone.record_state_hash();
+			}
+		}
+	}
+
+	for (std::int32_t drone_index = 0; drone_index < drone_count; drone_index++)
+	{
+		write_back_states(drones[drone_index], batch, drone_index);
+	}
+}
@@ -0,0 +1,310 @@
+#if WITH_DRONE_PHYSICS_BENCHMARKS
+
+#include "DroneSimulatorPhysics/Private/Simulation/TestDrone.h"
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/Math/Random.h"
+#include "DroneSimulatorPhysics/Public/RotorModel/Bemt/ComputePropellerThrust.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSnapshot.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SimulationBatch.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <random>
+
+namespace
+{
+	physics::FDronePropellerBemt make_benchmark_propeller()
+	{
+		physics::FDronePropellerBemt propeller;
+		propeller.num_blades = 3;
+		propeller.radius = 0.0635;
+		propeller.hub_radius = 0.015;
+		propeller.chord = 0.02;
+		propeller.pitch = 0.0762;
+		propeller.airfoil = physics::FDroneAirfoilSimplified();
+		return propeller;
+	}
+}
+
+static void BM_ComputeThrustAndTorque(benchmark::State& state)
+{
+	const auto propeller = make_benchmark_propeller();
+	const auto angular_speed = physics::math::rpm_to_rad_per_sec(20000.0);
+
+	for (auto _ : state)
+	{
+		auto result = physics::simulation_bemt::compute_thrust_and_torque(angular_speed, physics::FVector3::up(),
+			physics::FVector3::zero(), physics::FVector3::zero(), 1.225, &propeller);
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_ComputeThrustAndTorque);
+
+// One substep of a full drone, with each rotor model
+static void BM_SubstepBemt(benchmark::State& state)
+{
+	auto simulation = physics::test_drone::make_simulation(physics::FRotorModelBemt(), make_benchmark_propeller());
+	simulation.setpoint = physics::FDroneSetpoint { 0.5, physics::FVector3::zero() };
+
+	for (auto _ : state)
+	{
+		simulation.simulate_substep(1.0 / simulation.tick_rate_hz);
+		benchmark::DoNotOptimize(simulation.body);
+	}
+}
+BENCHMARK(BM_SubstepBemt);
+
+static void BM_SubstepSimplified(benchmark::State& state)
+{
+	auto simulation = physics::test_drone::make_simulation();
+	simulation.setpoint = physics::FDroneSetpoint { 0.5, physics::FVector3::zero() };
+
+	for (auto _ : state)
+	{
+		simulation.simulate_substep(1.0 / simulation.tick_rate_hz);
+		benchmark::DoNotOptimize(simulation.body);
+	}
+}
+BENCHMARK(BM_SubstepSimplified);
+
+// Contacts of a drone flying through a course of gates, to compare with the cost of a whole substep
+static void BM_ContactsOpenAir(benchmark::State& state)
+{
+	physics::FCollisionGeometry geometry;
+	geometry.ground_height = 0.0;
+	for (int gate_x = -10; gate_x <= 10; gate_x++)
+	{
+		for (int gate_y = -10; gate_y <= 10; gate_y++)
+		{
+			// 2 m wide gates every 10 m, the drone flies between them
+			const auto gate_location = physics::FVector3(gate_x * 1000.0 + 300.0, gate_y * 1000.0, 0.0);
+			geometry.shapes.push_back(physics::FCollisionCapsule { gate_location + physics::FVector3(0.0, -100.0, 0.0),
+				gate_location + physics::FVector3(0.0, -100.0, 200.0), 5.0 });
+			geometry.shapes.push_back(physics::FCollisionCapsule { gate_location + physics::FVector3(0.0, 100.0, 0.0),
+				gate_location + physics::FVector3(0.0, 100.0, 200.0), 5.0 });
+			geometry.shapes.push_back(physics::FCollisionCapsule { gate_location + physics::FVector3(0.0, -100.0, 200.0),
+				gate_location + physics::FVector3(0.0, 100.0, 200.0), 5.0 });
+		}
+	}
+	const auto collision_world = physics::collision::compile(geometry);
+
+	auto simulation = physics::test_drone::make_simulation();
+	simulation.reset_body(physics::FVector3(0.0, 0.0, 150.0), physics::FQuaternion::identity());
+
+	for (auto _ : state)
+	{
+		auto result = physics::collision::apply_contacts(*collision_world, &simulation.body, simulation.model->collision_shape,
+			1.0 / simulation.tick_rate_hz);
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_ContactsOpenAir);
+
+// Drone resting on its props on the ground
+static void BM_ContactsOnGround(benchmark::State& state)
+{
+	physics::FCollisionGeometry geometry;
+	geometry.ground_height = 0.0;
+	const auto collision_world = physics::collision::compile(geometry);
+
+	auto simulation = physics::test_drone::make_simulation();
+	simulation.reset_body(physics::FVector3(0.0, 0.0, 6.0), physics::FQuaternion::identity());
+
+	for (auto _ : state)
+	{
+		auto result = physics::collision::apply_contacts(*collision_world, &simulation.body, simulation.model->collision_shape,
+			1.0 / simulation.tick_rate_hz);
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_ContactsOnGround);
+
+// 8 kHz substeps for the controller, with BEMT at 1 kHz: compare with BM_SubstepBemt, which runs BEMT on every substep
+static void BM_SubstepBemtMultiRate(benchmark::State& state)
+{
+	auto simulation = physics::test_drone::make_simulation(physics::FRotorModelBemt(), make_benchmark_propeller());
+	simulation.tick_rate_hz = 8000.0;
+	simulation.schedule.rotor_aerodynamics_rate_hz = 1000.0;
+	simulation.schedule.drag_rate_hz = 1000.0;
+	simulation.setpoint = physics::FDroneSetpoint { 0.5, physics::FVector3::zero() };
+
+	for (auto _ : state)
+	{
+		simulation.simulate_substep(1.0 / simulation.tick_rate_hz);
+		benchmark::DoNotOptimize(simulation.body);
+	}
+}
+BENCHMARK(BM_SubstepBemtMultiRate);
+
+// Time to build a simulation from scratch, which is the startup cost of an offline tool
+static void BM_Startup(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		auto simulation = physics::test_drone::make_simulation(physics::FRotorModelBemt(), make_benchmark_propeller());
+		benchmark::DoNotOptimize(simulation);
+	}
+}
+BENCHMARK(BM_Startup);
+
+// Saving then restoring the state, which is the cost of an episode reset or of a branch
+static void BM_SnapshotCaptureRestore(benchmark::State& state)
+{
+	auto simulation = physics::test_drone::make_simulation(physics::FRotorModelBemt(), make_benchmark_propeller());
+
+	for (auto _ : state)
+	{
+		const auto snapshot = physics::snapshot::capture(simulation);
+		benchmark::DoNotOptimize(snapshot);
+		physics::snapshot::restore(simulation, snapshot);
+	}
+}
+BENCHMARK(BM_SnapshotCaptureRestore);
+
+// Flight mode and PID of a swarm, per drone then batched, over one step of 8 substeps
+static void BM_SwarmControllersPerDrone(benchmark::State& state)
+{
+	const auto mixer = physics::mixer::make_quad_x();
+	std::vector<physics::FPidDroneController> controllers(state.range(0));
+	std::vector<physics::FSubstepBody> bodies(state.range(0));
+	const auto flight_mode = physics::FFlightModeAir();
+	const auto input = physics::FDronePlayerInput { 0.5, 0.1, 0.2, -0.1 };
+
+	for (auto _ : state)
+	{
+		for (std::size_t index = 0; index < controllers.size(); index++)
+		{
+			const auto setpoint = physics::flight_mode::compute_air_setpoint(flight_mode, input);
+			const auto angular_velocity = bodies[index].transform_world.rotation.unrotate_vector(bodies[index].angular_velocity_radians_world);
+			auto throttle = physics::controller::tick_pid_controller(controllers[index].config, controllers[index].state,
+				1.0 / 400.0, setpoint, angular_velocity, mixer);
+			benchmark::DoNotOptimize(throttle);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SwarmControllersPerDrone)->Arg(1024);
+
+static void BM_SwarmControllersBatched(benchmark::State& state)
+{
+	const auto drone_count = static_cast<std::int32_t>(state.range(0));
+	const auto mixer = physics::mixer::make_quad_x();
+
+	physics::FFlightModeAirBatch flight_modes;
+	physics::FSetpointColumns setpoints;
+	physics::FPidControllerBatch controllers;
+	flight_modes.resize(drone_count);
+	setpoints.resize(drone_count);
+	controllers.resize(drone_count);
+
+	for (std::int32_t index = 0; index < drone_count; index++)
+	{
+		flight_modes.set_flight_mode(index, physics::FFlightModeAir());
+		flight_modes.set_input(index, physics::FDronePlayerInput { 0.5, 0.1, 0.2, -0.1 });
+		controllers.set_controller(index, physics::FPidDroneController());
+		controllers.delta_time[index] = 1.0 / 400.0;
+		controllers.is_active[index] = 1;
+		controllers.mixers[index] = &mixer;
+	}
+
+	for (auto _ : state)
+	{
+		physics::controller_batch::compute_air_setpoints(flight_modes, setpoints);
+		physics::controller_batch::tick_pid(controllers, setpoints);
+		benchmark::DoNotOptimize(controllers.throttle.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SwarmControllersBatched)->Arg(1024);
+
+// Full substeps of a swarm, one drone at a time then in lockstep
+static void BM_SwarmStepPerDrone(benchmark::State& state)
+{
+	auto drone = physics::test_drone::make_simulation();
+	std::vector<physics::FDroneSimulation> drones(state.range(0), drone);
+
+	for (auto _ : state)
+	{
+		for (auto& swarm_drone : drones)
+		{
+			swarm_drone.advance_substeps(8, physics::FDronePlayerInput { 0.5, 0.0, 0.0, 0.0 });
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0) * 8);
+}
+BENCHMARK(BM_SwarmStepPerDrone)->Arg(1024);
+
+static void BM_SwarmStepBatched(benchmark::State& state)
+{
+	auto drone = physics::test_drone::make_simulation();
+	std::vector<physics::FDroneSimulation> drones(state.range(0), drone);
+	const std::vector<std::int32_t> substep_counts(drones.size(), 8);
+	const std::vector<physics::FDronePlayerInput> inputs(drones.size(), physics::FDronePlayerInput { 0.5, 0.0, 0.0, 0.0 });
+	physics::FSimulationBatch batch;
+
+	for (auto _ : state)
+	{
+		physics::simulation_batch::advance_substeps(drones, substep_counts, inputs, batch);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0) * 8);
+}
+BENCHMARK(BM_SwarmStepBatched)->Arg(1024);
+
+// IMU noise of one sample (12 normals), drawn one by one with a scalar generator, or in blocks from Philox
+static void BM_ImuNoiseScalar(benchmark::State& state)
+{
+	std::mt19937_64 generator(1);
+	std::normal_distribution<double> distribution;
+	std::array<double, physics::imu_normals_per_sample> normals;
+
+	for (auto _ : state)
+	{
+		for (auto& normal : normals)
+		{
+			normal = distribution(generator);
+		}
+		benchmark::DoNotOptimize(normals.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * physics::imu_normals_per_sample);
+}
+BENCHMARK(BM_ImuNoiseScalar);
+
+static void BM_ImuNoiseBlocks(benchmark::State& state)
+{
+	std::array<double, physics::imu_normals_per_sample * physics::imu_noise_block_samples> normals;
+	std::uint64_t first_index = 0;
+
+	for (auto _ : state)
+	{
+		physics::random::fill_normal(1, 0, first_index, normals);
+		first_index += normals.size();
+		benchmark::DoNotOptimize(normals.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * normals.size());
+}
+BENCHMARK(BM_ImuNoiseBlocks);
+
+// One substep with the IMU sampled
+static void BM_SubstepSimplifiedImu(benchmark::State& state)
+{
+	auto simulation = physics::test_drone::make_simulation();
+	simulation.setpoint = physics::FDroneSetpoint { 0.5, physics::FVector3::zero() };
+	simulation.imu.config.is_enabled = true;
+
+	for (auto _ : state)
+	{
+		simulation.simulate_substep(1.0 / simulation.tick_rate_hz);
+		benchmark::DoNotOptimize(simulation.imu.samples);
+	}
+}
+BENCHMARK(BM_SubstepSimplifiedImu);
+
+#endif
@@ -0,0 +1,109 @@
+#include "DroneSimulatorPhysics/Public/Simulation/SleepState.h"
+
+#include <cmath>
+
+physics::FSleepStatistics& physics::FSleepStatistics::get()
+{
+	static FSleepStatistics statistics;
+	return statistics;
+}
+
+void physics::FSleepStatistics::record(ESleepTransition transition)
+{
+	if (transition == ESleepTransition::none)
+	{
+		return;
+	}
+
+	this->transition_counts[static_cast<std::size_t>(transition)].fetch_add(1, std::memory_order_relaxed);
+	this->num_asleep.fetch_add(transition == ESleepTransition::fell_asleep ? 1 : -1, std::memory_order_relaxed);
+}
+
+std::int64_t physics::FSleepStatistics::get_transition_count(ESleepTransition transition) const
+{
+	return this->transition_counts[static_cast<std::size_t>(transition)].load(std::memory_order_relaxed);
+}
+
+void physics::FSleepStatistics::reset()
+{
+	this->num_asleep.store(0, std::memory_order_relaxed);
+	for (auto& transition_count : this->transition_counts)
+	{
+		transition_count.store(0, std::memory_order_relaxed);
+	}
+}
+
+bool physics::sleep::is_input_idle(const FDronePlayerInput& player_input, double deadzone)
+{
+	return std::abs(player_input.throttle) <= deadzone && std::abs(player_input.yaw) <= deadzone
+		&& std::abs(player_input.pitch) <= deadzone && std::abs(player_input.roll) <= deadzone;
+}
+
+physics::ESleepTransition physics::sleep::update(FSleepState& state, const FSleepConfig& config, bool is_armed,
+	const FDronePlayerInput& player_input, bool is_in_contact, FVector3& linear_velocity_world,
+	FVector3& angular_velocity_radians_world, double delta_time)
+{
+	const auto is_at_rest = linear_velocity_world.size() <= config.max_linear_speed
+		&& angular_velocity_radians_world.size() <= config.max_angular_speed;
+	const auto is_input_idle = sleep::is_input_idle(player_input, config.input_deadzone);
+
+	if (state.is_asleep)
+	{
+		auto transition = ESleepTransition::none;
+		if (is_armed)
+		{
+			transition = ESleepTransition::woken_by_arming;
+		}
+		else if (!is_input_idle)
+		{
+			transition = ESleepTransition::woken_by_input;
+		}
+		else if (!is_at_rest)
+		{
+			transition = ESleepTransition::woken_by_motion;
+		}
+
+		if (transition != ESleepTransition::none)
+		{
+			state = FSleepState();
+		}
+		return transition;
+	}
+
+	if (!config.is_enabled || is_armed || !is_input_idle || !is_in_contact || !is_at_rest)
+	{
+		state.rest_time = 0.0;
+		return ESleepTransition::none;
+	}
+
+	state.rest_time += delta_time;
+	if (state.rest_time < config.time_to_sleep)
+	{
+		return ESleepTransition::none;
+	}
+
+	state.is_asleep = true;
+	state.rest_time = 0.0;
+	linear_velocity_world = FVector3::zero();
+	angular_velocity_radians_world = FVector3::zero();
+	return ESleepTransition::fell_asleep;
+}
+
+const char* physics::sleep::get_transition_name(ESleepTransition transition)
+{
+	switch (transition)
+	{
+	case ESleepTransition::fell_asleep:
+		return "fell asleep";
+	case ESleepTransition::woken_by_arming:
+		return "woken by arming";
+	case ESleepTransition::woken_by_input:
+		return "woken by input";
+	case ESleepTransition::woken_by_motion:
+		return "woken by motion";
+	case ESleepTransition::woken_by_reset:
+		return "woken by reset";
+	default:
+		return "none";
+	}
+}
@@ -0,0 +1,118 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Public/Simulation/SpscRing.h"
+#include "DroneSimulatorPhysics/Public/Simulation/TelemetrySample.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	std::vector<std::int32_t> drain(physics::TSpscRing<std::int32_t>& ring)
+	{
+		std::vector<std::int32_t> values;
+		std::size_t count = 0;
+		for (const auto& span : ring.get_read_spans())
+		{
+			values.insert(values.end(), span.begin(), span.end());
+			count += span.size();
+		}
+		ring.release(count);
+		return values;
+	}
+}
+
+TEST_CASE("SPSC ring", "[simulation][recording]")
+{
+	SECTION("The capacity is rounded up to a power of two, drops are counted")
+	{
+		physics::TSpscRing<std::int32_t> ring(5);
+		REQUIRE(ring.get_capacity() == 8);
+
+		for (std::int32_t value = 0; value < 10; value++)
+		{
+			CHECK(ring.push(value) == (value < 8));
+		}
+		CHECK(ring.get_dropped_count() == 2);
+		CHECK(ring.size() == 8);
+
+		ring.reset(0);
+		CHECK_FALSE(ring.push(0));
+		CHECK(ring.get_dropped_count() == 1);
+	}
+
+	SECTION("Bulk reads hand out the values in place, in two spans across the end of the ring")
+	{
+		physics::TSpscRing<std::int32_t> ring(8);
+		for (std::int32_t value = 0; value < 6; value++)
+		{
+			ring.push(value);
+		}
+
+		CHECK(drain(ring) == std::vector<std::int32_t> { 0, 1, 2, 3, 4, 5 });
+		for (std::int32_t value = 6; value < 12; value++)
+		{
+			ring.push(value);
+		}
+
+		const auto spans = ring.get_read_spans();
+		CHECK(spans[0].size() == 2);
+		CHECK(spans[1].size() == 4);
+		CHECK(spans[1].front() == 8);
+
+		// Only what is released goes back to the writer
+		ring.release(3);
+		CHECK(ring.size() == 3);
+		CHECK(drain(ring) == std::vector<std::int32_t> { 9, 10, 11 });
+		CHECK(ring.get_read_spans()[0].empty());
+	}
+
+	SECTION("Telemetry samples drained on another thread arrive in order")
+	{
+		constexpr std::int32_t count = 100000;
+		physics::TSpscRing<physics::FTelemetrySample> ring(256);
+
+		std::thread writer([&ring]
+		{
+			for (std::int32_t index = 0; index < count; index++)
+			{
+				physics::FTelemetrySample sample;
+				sample.time = index;
+				while (!ring.push(sample))
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		std::int32_t expected = 0;
+		bool is_in_order = true;
+		while (expected < count)
+		{
+			std::size_t read_count = 0;
+			for (const auto& span : ring.get_read_spans())
+			{
+				for (const auto& sample : span)
+				{
+					is_in_order &= sample.time == expected;
+					expected++;
+				}
+				read_count += span.size();
+			}
+
+			if (read_count == 0)
+			{
+				std::this_thread::yield();
+			}
+			ring.release(read_count);
+		}
+		writer.join();
+
+		CHECK(is_in_order);
+	}
+}
+
+#endif
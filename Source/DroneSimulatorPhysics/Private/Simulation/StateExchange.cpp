@@ -0,0 +1,46 @@
+#include "DroneSimulatorPhysics/Public/Simulation/StateExchange.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSnapshot.h"
+
+physics::FPublishedDroneState physics::state_exchange::from_snapshot(const FDroneSimulationSnapshot& snapshot, double tick_rate_hz)
+{
+	FPublishedDroneState state;
+	state.is_valid = true;
+	state.substep_index = snapshot.substep_index;
+	state.simulation_time = static_cast<double>(snapshot.substep_index) / tick_rate_hz;
+	state.transform_world = snapshot.transform_world;
+	state.linear_velocity_world = snapshot.linear_velocity_world;
+	state.angular_velocity_radians_world = snapshot.angular_velocity_radians_world;
+	state.setpoint = snapshot.setpoint;
+	state.rotor_throttle = snapshot.propulsion_held_outputs.throttle;
+	state.controller_state = snapshot.controller_state;
+	state.flight_mode_state = snapshot.flight_mode_state;
+	state.is_asleep = snapshot.sleep_state.is_asleep;
+	state.remaining_time_accumulator = snapshot.remaining_time_accumulator;
+	return state;
+}
+
+physics::FPublishedDroneState physics::state_exchange::capture(const FDroneSimulation& simulation)
+{
+	auto state = from_snapshot(snapshot::capture(simulation), simulation.tick_rate_hz);
+	state.last_contact = simulation.last_contact;
+	return state;
+}
+
+const physics::FPublishedDroneState* physics::state_exchange::read_current(TTripleBuffer<FPublishedDroneState>& drone_state, bool& is_stale,
+	bool is_asleep)
+{
+	if (drone_state.has_new_value())
+	{
+		is_stale = false;
+	}
+
+	// Stays stale after waking up, until the physics side publishes again
+	if (is_asleep)
+	{
+		is_stale = true;
+	}
+
+	const auto& published_state = drone_state.read();
+	return published_state.is_valid && !is_stale ? &published_state : nullptr;
+}
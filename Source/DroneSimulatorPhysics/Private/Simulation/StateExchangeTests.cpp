@@ -0,0 +1,200 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Private/Simulation/TestDrone.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+#include "DroneSimulatorPhysics/Public/Simulation/StateExchange.h"
+#include "DroneSimulatorPhysics/Public/Simulation/TripleBuffer.h"
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+
+namespace
+{
+	// Torn if the fields differ
+	struct FTestValue
+	{
+		std::array<std::int64_t, 32> fields = {};
+
+		explicit FTestValue(std::int64_t value = 0)
+		{
+			this->fields.fill(value);
+		}
+
+		bool is_coherent() const
+		{
+			for (const auto field : this->fields)
+			{
+				if (field != this->fields[0])
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+}
+
+TEST_CASE("Triple buffer", "[physics][state_exchange]")
+{
+	SECTION("Reads the default value until the first publish")
+	{
+		physics::TTripleBuffer<FTestValue> buffer;
+		CHECK_FALSE(buffer.has_new_value());
+		CHECK(buffer.read().fields[0] == 0);
+	}
+
+	SECTION("Reads the latest published value")
+	{
+		physics::TTripleBuffer<FTestValue> buffer;
+		buffer.publish(FTestValue(1));
+		buffer.publish(FTestValue(2));
+		buffer.publish(FTestValue(3));
+
+		CHECK(buffer.has_new_value());
+		CHECK(buffer.read().fields[0] == 3);
+		CHECK_FALSE(buffer.has_new_value());
+
+		// Nothing new: the last value is read again
+		CHECK(buffer.read().fields[0] == 3);
+	}
+
+	SECTION("Writing doesn't touch the value being read")
+	{
+		physics::TTripleBuffer<FTestValue> buffer;
+		buffer.publish(FTestValue(1));
+		const auto& read_value = buffer.read();
+
+		buffer.get_write_slot() = FTestValue(2);
+		CHECK(read_value.fields[0] == 1);
+
+		buffer.publish();
+		buffer.get_write_slot() = FTestValue(3);
+		CHECK(read_value.fields[0] == 1);
+		CHECK(buffer.read().fields[0] == 2);
+	}
+
+	SECTION("Reader on another thread never sees a torn or older value")
+	{
+		constexpr std::int64_t last_value = 200000;
+
+		physics::TTripleBuffer<FTestValue> buffer;
+
+		std::thread writer([&buffer]
+		{
+			for (std::int64_t value = 1; value <= last_value; value++)
+			{
+				auto& slot = buffer.get_write_slot();
+				for (auto& field : slot.fields)
+				{
+					field = value;
+				}
+				buffer.publish();
+			}
+		});
+
+		bool is_coherent = true;
+		bool is_monotonic = true;
+		std::int64_t previous_value = 0;
+		while (previous_value != last_value)
+		{
+			const auto& value = buffer.read();
+			is_coherent = is_coherent && value.is_coherent();
+			is_monotonic = is_monotonic && value.fields[0] >= previous_value;
+			previous_value = value.fields[0];
+		}
+
+		writer.join();
+
+		CHECK(is_coherent);
+		CHECK(is_monotonic);
+	}
+}
+
+TEST_CASE("Drone state exchange", "[physics][state_exchange]")
+{
+	auto simulation = physics::test_drone::make_simulation();
+
+	physics::FDroneStateExchange exchange;
+	CHECK_FALSE(exchange.drone_state.read().is_valid);
+
+	SECTION("Game side reads the state of the last substep")
+	{
+		simulation.advance_substeps(40, physics::FDronePlayerInput { 0.6, 0.1, 0.0, 0.0 });
+		exchange.drone_state.publish(physics::state_exchange::capture(simulation));
+
+		const auto& state = exchange.drone_state.read();
+		CHECK(state.is_valid);
+		CHECK(state.substep_index == 40);
+		CHECK(state.simulation_time == simulation.get_simulation_time());
+		CHECK(state.transform_world.location == simulation.body.transform_world.location);
+		CHECK(state.linear_velocity_world == simulation.body.linear_velocity_world);
+		CHECK(state.setpoint.throttle == simulation.setpoint.throttle);
+
+		const auto& dynamics = std::get<physics::FPropulsionModelDynamics>(simulation.propulsion_model);
+		CHECK(state.rotor_throttle.count == dynamics.held_outputs.throttle.count);
+		CHECK(state.rotor_throttle.values == dynamics.held_outputs.throttle.values);
+		CHECK(state.controller_state.integrated_angular_velocity_error
+			== std::get<physics::FPidDroneController>(dynamics.controller).state.integrated_angular_velocity_error);
+	}
+
+	SECTION("A sleeping drone is read from its body, and wakes when something moves it")
+	{
+		// Disarmed drone dropped on a pad
+		auto sleeping = physics::test_drone::make_simulation(physics::FRotorModelDebug());
+		physics::FCollisionGeometry geometry;
+		geometry.ground_height = 0.0;
+		sleeping.collision_world = physics::collision::compile(geometry);
+		sleeping.reset_body(physics::FVector3(0.0, 0.0, 20.0), physics::FQuaternion::identity());
+		sleeping.is_armed = false;
+		sleeping.sleep_config.is_enabled = true;
+
+		// As on the physics thread: a tick that runs no substep publishes nothing
+		bool is_stale = false;
+		const auto run_frame = [&]
+		{
+			if (sleeping.advance(0.01, physics::FDronePlayerInput::zero()) > 0)
+			{
+				exchange.drone_state.publish(physics::state_exchange::capture(sleeping));
+			}
+			return physics::state_exchange::read_current(exchange.drone_state, is_stale, sleeping.sleep_state.is_asleep);
+		};
+
+		const physics::FPublishedDroneState* state = nullptr;
+		for (int frame = 0; frame < 200 && !sleeping.sleep_state.is_asleep; frame++)
+		{
+			state = run_frame();
+			CHECK((state != nullptr) != sleeping.sleep_state.is_asleep);
+		}
+		REQUIRE(sleeping.sleep_state.is_asleep);
+
+		// Asleep, the last published state stays at rest while a collision pushes the body
+		CHECK(run_frame() == nullptr);
+		sleeping.body.linear_velocity_world = physics::FVector3(2.0, 0.0, 0.0);
+		CHECK(exchange.drone_state.read().linear_velocity_world.size() < sleeping.sleep_config.max_linear_speed);
+
+		// The body wakes the drone, and the state is read again once the physics side published
+		state = run_frame();
+		CHECK_FALSE(sleeping.sleep_state.is_asleep);
+		REQUIRE(state != nullptr);
+		CHECK(state->linear_velocity_world.X > 0.0);
+		CHECK_FALSE(state->is_asleep);
+	}
+
+	SECTION("Physics side reads the pilot command")
+	{
+		auto& command = exchange.pilot_command.get_write_slot();
+		command.pilot_input_buffer.push(0.25, physics::FDronePlayerInput { 0.5, 0.0, 0.0, 0.0 });
+		command.is_armed = false;
+		exchange.pilot_command.publish();
+
+		const auto& read_command = exchange.pilot_command.read();
+		CHECK_FALSE(read_command.is_armed);
+		CHECK(read_command.pilot_input_buffer.count == 1);
+		CHECK(read_command.pilot_input_buffer.sample(0.25).throttle == 0.5);
+	}
+}
+
+#endif
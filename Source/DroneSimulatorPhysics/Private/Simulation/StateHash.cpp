@@ -0,0 +1,133 @@
+#include "DroneSimulatorPhysics/Public/Simulation/StateHash.h"
+#include "DroneSimulatorPhysics/Public/Controller/DroneController.h"
+#include "DroneSimulatorPhysics/Public/Controller/FlightMode.h"
+#include "DroneSimulatorPhysics/Public/Controller/PilotInputBuffer.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/PropulsionModel/PropulsionModel.h"
+#include "DroneSimulatorPhysics/Public/Simulation/MultiRateSchedule.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SleepState.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+
+#include <algorithm>
+#include <bit>
+
+void physics::FStateHasher::add(std::uint64_t bits)
+{
+	constexpr std::uint64_t fnv_prime = 1099511628211ull;
+
+	for (std::int32_t byte_index = 0; byte_index < 8; byte_index++)
+	{
+		this->value ^= (bits >> (byte_index * 8)) & 0xFF;
+		this->value *= fnv_prime;
+	}
+}
+
+void physics::FStateHasher::add(double number)
+{
+	this->add(std::bit_cast<std::uint64_t>(number));
+}
+
+void physics::FStateHasher::add(const FVector3& vector)
+{
+	this->add(vector.X);
+	this->add(vector.Y);
+	this->add(vector.Z);
+}
+
+void physics::FStateHasher::add(const FQuaternion& quaternion)
+{
+	this->add(quaternion.X);
+	this->add(quaternion.Y);
+	this->add(quaternion.Z);
+	this->add(quaternion.W);
+}
+
+void physics::FStateHasher::add(const FSubstepBody& body)
+{
+	this->add(body.transform_world.location);
+	this->add(body.transform_world.rotation);
+	this->add(body.mass);
+	this->add(body.inertia_tensor);
+	this->add(body.linear_velocity_world);
+	this->add(body.angular_velocity_radians_world);
+	this->add(body.accumulated_force_world);
+	this->add(body.accumulated_torque_world);
+}
+
+void physics::FStateHasher::add(const FPidDroneControllerState& state)
+{
+	this->add(state.last_angular_velocity_error);
+	this->add(state.integrated_angular_velocity_error);
+}
+
+void physics::FStateHasher::add(const FFlightModeVelocityState& state)
+{
+	this->add(state.velocity_x_integral);
+	this->add(state.velocity_y_integral);
+	this->add(state.vertical_velocity_integral);
+	this->add(state.prev_vertical_velocity_error);
+}
+
+void physics::FStateHasher::add(const FDroneSetpoint& setpoint)
+{
+	this->add(setpoint.throttle);
+	this->add(setpoint.angular_velocity_radians);
+}
+
+void physics::FStateHasher::add(const FPilotInputBuffer& input_buffer)
+{
+	for (std::int32_t sample_index = 0; sample_index < input_buffer.count; sample_index++)
+	{
+		const auto& sample = input_buffer.samples[sample_index];
+		this->add(sample.time_seconds);
+		this->add(sample.input.throttle);
+		this->add(sample.input.yaw);
+		this->add(sample.input.pitch);
+		this->add(sample.input.roll);
+	}
+}
+
+void physics::FStateHasher::add(const FSleepState& sleep_state)
+{
+	this->add(static_cast<std::uint64_t>(sleep_state.is_asleep));
+	this->add(sleep_state.rest_time);
+}
+
+void physics::FStateHasher::add(const FPropulsionHeldOutputs& held_outputs)
+{
+	for (std::int32_t rotor_index = 0; rotor_index < held_outputs.throttle.count; rotor_index++)
+	{
+		this->add(held_outputs.throttle.values[rotor_index]);
+		this->add(held_outputs.thrust_per_throttle_squared[rotor_index]);
+		this->add(held_outputs.torque_per_throttle_squared[rotor_index]);
+	}
+}
+
+void physics::FStateHasher::add(const FHeldStageOutputs& held_outputs)
+{
+	this->add(held_outputs.sampled_world.air_density);
+	this->add(held_outputs.sampled_world.wind_velocity);
+	this->add(held_outputs.drag_force_world);
+	this->add(held_outputs.drag_torque_world);
+}
+
+std::optional<std::int64_t> physics::find_first_divergence(const std::vector<FStateHashEntry>& entries_a,
+	const std::vector<FStateHashEntry>& entries_b)
+{
+	const auto common_count = std::min(entries_a.size(), entries_b.size());
+	for (std::size_t entry_index = 0; entry_index < common_count; entry_index++)
+	{
+		if (entries_a[entry_index] != entries_b[entry_index])
+		{
+			return std::min(entries_a[entry_index].substep_index, entries_b[entry_index].substep_index);
+		}
+	}
+
+	if (entries_a.size() != entries_b.size())
+	{
+		const auto& longer_entries = entries_a.size() > entries_b.size() ? entries_a : entries_b;
+		return longer_entries[common_count].substep_index;
+	}
+
+	return std::nullopt;
+}
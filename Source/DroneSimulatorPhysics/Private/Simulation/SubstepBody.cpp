@@ -0,0 +1,81 @@
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+
+
+void physics::FSubstepBody::add_force(const FVector3& force)
+{
+	this->accumulated_force_world += force;
+}
+
+void physics::FSubstepBody::add_torque(const FVector3& torque)
+{
+	this->accumulated_torque_world += torque;
+}
+
+void physics::FSubstepBody::add_force_at_point(const FVector3& force_world, const FVector3& point_location_local)
+{
+	const FVector3 point_location_world = this->transform_world.transform_position(point_location_local);
+	const FVector3 torque_world = ((point_location_world - this->transform_world.location) / 100.0).cross(force_world);
+
+	this->accumulated_force_world += force_world;
+	this->accumulated_torque_world += torque_world;
+}
+
+void physics::FSubstepBody::consume_forces_and_torques(double substep_delta_time)
+{
+	const auto& rotation_world = this->transform_world.rotation;
+	const auto accumulated_torque_local = rotation_world.unrotate_vector(this->accumulated_torque_world);
+	const auto angular_velocity_acceleration_local = (accumulated_torque_local - get_gyroscopic_torque_local()) / this->inertia_tensor;
+	const auto angular_velocity_acceleration_world = rotation_world.rotate_vector(angular_velocity_acceleration_local);
+
+	this->linear_velocity_world += (this->accumulated_force_world / this->mass) * substep_delta_time;
+	this->angular_velocity_radians_world += angular_velocity_acceleration_world * substep_delta_time;
+
+	this->accumulated_force_world = FVector3::zero();
+	this->accumulated_torque_world = FVector3::zero();
+}
+
+void physics::FSubstepBody::integrate_transform(double substep_delta_time)
+{
+	// Velocity is in m/s, location in unreal units
+	this->transform_world.location += this->linear_velocity_world * (100.0 * substep_delta_time);
+
+	// q' = q + 0.5 * dt * (ω, 0) * q, like Chaos does
+	const auto& omega = this->angular_velocity_radians_world;
+	const auto& rotation = this->transform_world.rotation;
+	const auto spin = FQuaternion(omega.X, omega.Y, omega.Z, 0.0) * rotation;
+	const double half_delta_time = 0.5 * substep_delta_time;
+
+	this->transform_world.rotation = FQuaternion(
+		rotation.X + spin.X * half_delta_time,
+		rotation.Y + spin.Y * half_delta_time,
+		rotation.Z + spin.Z * half_delta_time,
+		rotation.W + spin.W * half_delta_time
+	).get_normalized();
+}
+
+physics::FVector3 physics::FSubstepBody::get_gyroscopic_torque_local() const
+{
+	// Convert to body space where the inertia tensor is diagonal
+	const FVector3 omega_body = this->transform_world.rotation.unrotate_vector(this->angular_velocity_radians_world);
+
+	// Euler rigid-body equation (body frame): I * ω_dot = τ - ω × (Iω)
+	// Gyroscopic term: G = ω × (Iω); then ω_dot = (τ - G) / I (component-wise because I is diagonal in body frame)
+	return omega_body.cross(this->inertia_tensor * omega_body);
+}
+
+physics::FVector3 physics::FSubstepBody::get_velocity_at_location(const FVector3& location_local) const
+{
+	const FVector3 location_world = this->transform_world.rotation.rotate_vector(location_local);
+	const FVector3 rotational_velocity = this->angular_velocity_radians_world.cross(location_world / 100.0);
+	return this->linear_velocity_world + rotational_velocity;
+}
+
+physics::FSubstepBody::FSubstepBody(const FVector3& location_world, const FQuaternion& rotation_world, double in_mass,
+	const FVector3& in_inertia_tensor, const FVector3& in_linear_velocity_world, const FVector3& in_angular_velocity_radians_world)
+	: transform_world(FRigidTransform(rotation_world, location_world))
+	, mass(in_mass)
+	, inertia_tensor(in_inertia_tensor)
+	, linear_velocity_world(in_linear_velocity_world)
+	, angular_velocity_radians_world(in_angular_velocity_radians_world)
+{
+}
@@ -0,0 +1,134 @@
+#include "DroneSimulatorPhysics/Public/Simulation/TelemetrySample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	// Step of each quantized channel, and so its range: ±32767 steps for the signed ones, 0 to 65535 for the others
+	constexpr double linear_velocity_step = 0.01;
+	constexpr double angular_velocity_step = 0.002;
+	constexpr double unit_step = 1.0 / 32767.0;
+	constexpr double throttle_step = 1.0 / 65535.0;
+	constexpr double rotor_speed_step = 0.5;
+	constexpr double thrust_step = 0.002;
+	constexpr double torque_step = 2e-5;
+	constexpr double angle_of_attack_step = 1e-4;
+	constexpr double reynolds_step = 10.0;
+	constexpr double rotor_velocity_step = 0.01;
+
+	template <typename T>
+	T quantize(double value, double step)
+	{
+		const auto steps = std::round(value / step);
+		if (std::isnan(steps))
+		{
+			return 0;
+		}
+		return static_cast<T>(std::clamp(steps, static_cast<double>(std::numeric_limits<T>::min()),
+			static_cast<double>(std::numeric_limits<T>::max())));
+	}
+
+	std::array<std::int16_t, 3> quantize(const physics::FVector3& vector, double step)
+	{
+		return { quantize<std::int16_t>(vector.X, step), quantize<std::int16_t>(vector.Y, step), quantize<std::int16_t>(vector.Z, step) };
+	}
+
+	physics::FVector3 dequantize(const std::array<std::int16_t, 3>& vector, double step)
+	{
+		return physics::FVector3(vector[0] * step, vector[1] * step, vector[2] * step);
+	}
+
+	physics::FTelemetryRotor encode_rotor(const physics::FTelemetryRotorValues& values)
+	{
+		physics::FTelemetryRotor rotor;
+		rotor.throttle = quantize<std::uint16_t>(values.throttle, throttle_step);
+		rotor.angular_speed = quantize<std::uint16_t>(values.angular_speed, rotor_speed_step);
+		rotor.thrust = quantize<std::int16_t>(values.thrust, thrust_step);
+		rotor.torque = quantize<std::int16_t>(values.torque, torque_step);
+		rotor.angle_of_attack = quantize<std::int16_t>(values.angle_of_attack, angle_of_attack_step);
+		rotor.min_reynolds = quantize<std::uint16_t>(values.min_reynolds, reynolds_step);
+		rotor.max_reynolds = quantize<std::uint16_t>(values.max_reynolds, reynolds_step);
+		rotor.velocity_axial = quantize<std::int16_t>(values.velocity_axial, rotor_velocity_step);
+		rotor.velocity_induced = quantize<std::int16_t>(values.velocity_induced, rotor_velocity_step);
+		return rotor;
+	}
+
+	physics::FTelemetryRotorValues decode_rotor(const physics::FTelemetryRotor& rotor)
+	{
+		physics::FTelemetryRotorValues values;
+		values.throttle = rotor.throttle * throttle_step;
+		values.angular_speed = rotor.angular_speed * rotor_speed_step;
+		values.thrust = rotor.thrust * thrust_step;
+		values.torque = rotor.torque * torque_step;
+		values.angle_of_attack = rotor.angle_of_attack * angle_of_attack_step;
+		values.min_reynolds = rotor.min_reynolds * reynolds_step;
+		values.max_reynolds = rotor.max_reynolds * reynolds_step;
+		values.velocity_axial = rotor.velocity_axial * rotor_velocity_step;
+		values.velocity_induced = rotor.velocity_induced * rotor_velocity_step;
+		return values;
+	}
+}
+
+physics::FTelemetrySample physics::telemetry::encode(const FTelemetryValues& values)
+{
+	FTelemetrySample sample;
+	sample.time = values.time;
+	sample.world_time_offset = static_cast<float>(values.world_time - values.time);
+
+	const auto& location = values.transform_world.location;
+	sample.location = { static_cast<float>(location.X), static_cast<float>(location.Y), static_cast<float>(location.Z) };
+
+	// Same rotation for q and -q, W is kept positive
+	auto rotation = values.transform_world.rotation.get_normalized();
+	if (rotation.W < 0.0)
+	{
+		rotation = FQuaternion(-rotation.X, -rotation.Y, -rotation.Z, -rotation.W);
+	}
+	sample.rotation = { quantize<std::int16_t>(rotation.X, unit_step), quantize<std::int16_t>(rotation.Y, unit_step),
+		quantize<std::int16_t>(rotation.Z, unit_step), quantize<std::int16_t>(rotation.W, unit_step) };
+
+	sample.linear_velocity = quantize(values.linear_velocity_world, linear_velocity_step);
+	sample.angular_velocity = quantize(values.angular_velocity_radians_world, angular_velocity_step);
+
+	const auto& input = values.player_input;
+	sample.player_input = { quantize<std::int16_t>(input.throttle, unit_step), quantize<std::int16_t>(input.yaw, unit_step),
+		quantize<std::int16_t>(input.pitch, unit_step), quantize<std::int16_t>(input.roll, unit_step) };
+
+	sample.has_propulsion = values.has_propulsion ? 1 : 0;
+	if (values.has_propulsion)
+	{
+		for (std::int32_t rotor_index = 0; rotor_index < telemetry_rotor_count; rotor_index++)
+		{
+			sample.rotors[rotor_index] = encode_rotor(values.rotors[rotor_index]);
+		}
+	}
+
+	return sample;
+}
+
+physics::FTelemetryValues physics::telemetry::decode(const FTelemetrySample& sample)
+{
+	FTelemetryValues values;
+	values.time = sample.time;
+	values.world_time = sample.time + sample.world_time_offset;
+	values.transform_world.location = FVector3(sample.location[0], sample.location[1], sample.location[2]);
+	values.transform_world.rotation = FQuaternion(sample.rotation[0] * unit_step, sample.rotation[1] * unit_step,
+		sample.rotation[2] * unit_step, sample.rotation[3] * unit_step).get_normalized();
+	values.linear_velocity_world = dequantize(sample.linear_velocity, linear_velocity_step);
+	values.angular_velocity_radians_world = dequantize(sample.angular_velocity, angular_velocity_step);
+	values.player_input = FDronePlayerInput { sample.player_input[0] * unit_step, sample.player_input[1] * unit_step,
+		sample.player_input[2] * unit_step, sample.player_input[3] * unit_step };
+
+	values.has_propulsion = sample.has_propulsion != 0;
+	if (values.has_propulsion)
+	{
+		for (std::int32_t rotor_index = 0; rotor_index < telemetry_rotor_count; rotor_index++)
+		{
+			values.rotors[rotor_index] = decode_rotor(sample.rotors[rotor_index]);
+		}
+	}
+
+	return values;
+}
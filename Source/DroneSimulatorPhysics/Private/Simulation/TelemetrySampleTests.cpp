@@ -0,0 +1,101 @@
+#if WITH_DRONE_PHYSICS_TESTS
+
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/Simulation/TelemetrySample.h"
+
+#include <catch2/catch.hpp>
+
+#include <limits>
+
+namespace
+{
+	physics::FTelemetryValues make_values()
+	{
+		physics::FTelemetryValues values;
+		values.time = 12.3456789;
+		values.world_time = 1812.3456789;
+		values.transform_world = physics::FRigidTransform(physics::FQuaternion::from_rotation(physics::FRotation(10.0, -120.0, 35.0)),
+			physics::FVector3(12345.6, -789.1, 4321.0));
+		values.linear_velocity_world = physics::FVector3(12.34, -5.67, 0.5);
+		values.angular_velocity_radians_world = physics::FVector3(-20.0, 3.5, 0.01);
+		values.player_input = physics::FDronePlayerInput { 0.6, -0.25, 0.125, -1.0 };
+		values.has_propulsion = true;
+		for (std::int32_t rotor_index = 0; rotor_index < physics::telemetry_rotor_count; rotor_index++)
+		{
+			auto& rotor = values.rotors[rotor_index];
+			rotor.throttle = 0.4 + 0.1 * rotor_index;
+			rotor.angular_speed = 2500.0 + 10.0 * rotor_index;
+			rotor.thrust = 3.21;
+			rotor.torque = 0.0456;
+			rotor.angle_of_attack = 0.12;
+			rotor.min_reynolds = 12000.0;
+			rotor.max_reynolds = 85000.0;
+			rotor.velocity_axial = -1.5;
+			rotor.velocity_induced = 8.25;
+		}
+		return values;
+	}
+}
+
+TEST_CASE("Telemetry sample", "[simulation][recording]")
+{
+	SECTION("Round trip within the quantization steps")
+	{
+		const auto values = make_values();
+		const auto decoded = physics::telemetry::decode(physics::telemetry::encode(values));
+
+		CHECK(decoded.time == values.time);
+		CHECK(decoded.world_time == Approx(values.world_time).margin(1e-4));
+		CHECK(decoded.transform_world.location.X == Approx(values.transform_world.location.X).margin(1e-3));
+		CHECK(decoded.transform_world.location.Z == Approx(values.transform_world.location.Z).margin(1e-3));
+
+		// Angle between the two rotations
+		const auto difference = decoded.transform_world.rotation * values.transform_world.rotation.inverse();
+		CHECK(2.0 * std::acos(std::min(std::abs(difference.W), 1.0)) < physics::math::degrees_to_radians(0.01));
+
+		CHECK(decoded.linear_velocity_world.X == Approx(values.linear_velocity_world.X).margin(0.005));
+		CHECK(decoded.angular_velocity_radians_world.X == Approx(values.angular_velocity_radians_world.X).margin(0.001));
+		CHECK(decoded.angular_velocity_radians_world.Z == Approx(values.angular_velocity_radians_world.Z).margin(0.001));
+		CHECK(decoded.player_input.throttle == Approx(values.player_input.throttle).margin(1e-4));
+		CHECK(decoded.player_input.roll == -1.0);
+
+		REQUIRE(decoded.has_propulsion);
+		for (std::int32_t rotor_index = 0; rotor_index < physics::telemetry_rotor_count; rotor_index++)
+		{
+			const auto& rotor = decoded.rotors[rotor_index];
+			const auto& expected = values.rotors[rotor_index];
+			CHECK(rotor.throttle == Approx(expected.throttle).margin(1e-4));
+			CHECK(rotor.angular_speed == Approx(expected.angular_speed).margin(0.25));
+			CHECK(rotor.thrust == Approx(expected.thrust).margin(0.001));
+			CHECK(rotor.torque == Approx(expected.torque).margin(1e-5));
+			CHECK(rotor.angle_of_attack == Approx(expected.angle_of_attack).margin(1e-4));
+			CHECK(rotor.max_reynolds == Approx(expected.max_reynolds).margin(5.0));
+			CHECK(rotor.velocity_induced == Approx(expected.velocity_induced).margin(0.005));
+		}
+	}
+
+	SECTION("Out of range values saturate, NaN reads as 0")
+	{
+		auto values = make_values();
+		values.linear_velocity_world = physics::FVector3(1000.0, -1000.0, std::numeric_limits<double>::quiet_NaN());
+		values.rotors[0].throttle = -0.5;
+
+		const auto decoded = physics::telemetry::decode(physics::telemetry::encode(values));
+		CHECK(decoded.linear_velocity_world.X == Approx(327.67));
+		CHECK(decoded.linear_velocity_world.Y == Approx(-327.68));
+		CHECK(decoded.linear_velocity_world.Z == 0.0);
+		CHECK(decoded.rotors[0].throttle == 0.0);
+	}
+
+	SECTION("Without propulsion, the rotors are left at zero")
+	{
+		auto values = make_values();
+		values.has_propulsion = false;
+
+		const auto sample = physics::telemetry::encode(values);
+		CHECK(sample.rotors[2].thrust == 0);
+		CHECK_FALSE(physics::telemetry::decode(sample).has_propulsion);
+	}
+}
+
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/Math/MathUtils.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+
+#include <optional>
+
+// The quad flown by the tests and the benchmarks. Each of them changes only what it is about on the result.
+namespace physics::test_drone
+{
+	inline FDronePropeller make_propeller()
+	{
+		return FDronePropellerSimplified { 0.127, 0.1, 0.01 };
+	}
+
+	inline FDroneParts make_parts(const std::optional<FDronePropeller>& propeller = make_propeller())
+	{
+		FDroneParts parts;
+		parts.frame = FDroneFrame { FVector3(10.0, 10.0, 0.0), FVector3(-10.0, 10.0, 0.0), FVector3(1.0, 1.0, 1.0),
+			FVector3(0.01, 0.01, 0.02), 0.3, {} };
+		parts.motor = FDroneMotor { 1900.0 * math::two_pi / 60.0, 0.03 };
+		parts.battery = FDroneBattery { 16.8, 0.2 };
+		parts.propeller = propeller;
+		return parts;
+	}
+
+	// Rate controller on the given rotor model, at rest 10 m up
+	inline FDroneSimulation make_simulation(const FRotorModel& rotor_model = FRotorModelSimplified(),
+		const std::optional<FDronePropeller>& propeller = make_propeller())
+	{
+		FDroneSimulation simulation;
+		simulation.model = drone_model::compile(make_parts(propeller));
+		simulation.propulsion_model = FPropulsionModelDynamics { FPidDroneController(), rotor_model, FPropulsionHeldOutputs() };
+		simulation.reset_body(FVector3(0.0, 0.0, 1000.0), FQuaternion::identity());
+		return simulation;
+	}
+}
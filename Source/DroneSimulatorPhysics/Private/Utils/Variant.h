@@ -0,0 +1,26 @@
+#pragma once
+
+#include <utility>
+#include <variant>
+
+namespace physics
+{
+	template <class... Fs>
+	struct TVariantMatch : Fs... { using Fs::operator()...; };
+	template <class... Fs>
+	TVariantMatch(Fs...) -> TVariantMatch<Fs...>;
+
+	/**
+	 * Matches the provided std::variant with one of the functions.
+	 * Same as the Unreal match_variant of DroneSimulatorCore: if all variant types are not handled, this generates a
+	 * compile error.
+	 */
+	template <typename VariantT, typename... Fs>
+	decltype(auto) match_variant(VariantT&& variant, Fs&&... arms)
+	{
+		return std::visit(
+			TVariantMatch{ std::forward<Fs>(arms)... },
+			std::forward<VariantT>(variant)
+		);
+	}
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/Mixer.h"
+#include "DroneSimulatorPhysics/Public/Math/Transform.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <variant>
+#include <vector>
+
+namespace physics
+{
+	struct FSubstepBody;
+
+	// All the static shapes are in world space, in unreal units (centimeters)
+	struct FCollisionSphere
+	{
+		FVector3 center = FVector3::zero();
+
+		double radius = 0.0;
+	};
+
+	// Segment with a radius, for example the bars of a gate
+	struct FCollisionCapsule
+	{
+		FVector3 start = FVector3::zero();
+
+		FVector3 end = FVector3::zero();
+
+		double radius = 0.0;
+	};
+
+	struct FCollisionBox
+	{
+		// Center and orientation of the box
+		FRigidTransform transform;
+
+		// Half size along each local axis
+		FVector3 half_extent = FVector3::zero();
+	};
+
+	/**
+	 * Grid of heights over the XY plane, interpolated bilinearly. Outside of the grid, there is no terrain.
+	 */
+	struct FCollisionHeightfield
+	{
+		// World location of the sample (0, 0)
+		FVector3 origin = FVector3::zero();
+
+		// Distance between two samples along X and Y
+		double cell_size = 100.0;
+
+		std::int32_t num_samples_x = 0;
+
+		std::int32_t num_samples_y = 0;
+
+		// Relative to origin.Z, row-major: heights[y * num_samples_x + x]
+		std::vector<double> heights;
+
+		// Need at least 2 samples along each axis, which collision::compile checks
+		double get_height(double x, double y) const;
+
+		// Unit normal of the surface below the point
+		FVector3 get_normal(double x, double y) const;
+
+		bool contains(double x, double y) const;
+	};
+
+	using FCollisionShape = std::variant<FCollisionSphere, FCollisionCapsule, FCollisionBox, FCollisionHeightfield>;
+
+	/**
+	 * Spring-damper contact: contacts push the drone out with a force that grows with the penetration, and slow it
+	 * down along the surface up to the Coulomb friction limit.
+	 */
+	struct FContactMaterial
+	{
+		// Natural frequency of the drone on its contacts. Clamped to the substep rate to keep the integration stable.
+		double stiffness_frequency_hz = 20.0;
+
+		// 1 doesn't bounce, lower values bounce more
+		double damping_ratio = 0.5;
+
+		double friction_coefficient = 0.6;
+	};
+
+	/**
+	 * Static geometry of a scene, as authored.
+	 */
+	struct FCollisionGeometry
+	{
+		// Infinite horizontal plane at this height, in unreal units
+		std::optional<double> ground_height;
+
+		std::vector<FCollisionShape> shapes;
+
+		FContactMaterial material;
+
+		// Size of the broadphase grid cells, in unreal units
+		double grid_cell_size = 500.0;
+
+		// Largest drone that queries the grid, see FDroneCollisionShape::bounding_radius. Shapes are inserted in all the
+		// cells within this distance, so that a query only reads the cell of the drone center.
+		double max_body_radius = 100.0;
+	};
+
+	/**
+	 * Geometry with its broadphase, built once by collision::compile. Like FDroneModel, it is immutable after
+	 * compilation, and all the drones of a batch share it.
+	 */
+	struct DRONESIMULATORPHYSICS_API FCollisionWorld
+	{
+		FCollisionGeometry geometry;
+
+		// Uniform grid over XY. The shapes of cell (x, y) are shape_indices[cell_starts[i]..cell_starts[i + 1]], with
+		// i = y * num_cells_x + x. The cell size is larger than requested when the grid would be too large.
+		double grid_cell_size = 500.0;
+		double grid_origin_x = 0.0;
+		double grid_origin_y = 0.0;
+		std::int32_t num_cells_x = 0;
+		std::int32_t num_cells_y = 0;
+		std::vector<std::int32_t> cell_starts;
+		std::vector<std::int32_t> shape_indices;
+
+		// Shapes that may touch a drone centered on this point, empty outside of the grid
+		std::span<const std::int32_t> get_candidate_shapes(const FVector3& location) const;
+	};
+
+	/**
+	 * Collision proxy of a drone: a sphere around the center, and one around each propeller.
+	 */
+	struct FDroneCollisionShape
+	{
+		// In the drone frame, in unreal units
+		std::array<FCollisionSphere, max_rotor_count + 1> spheres = {};
+
+		std::int32_t count = 0;
+
+		// Distance from the drone center to the furthest point of the spheres
+		double bounding_radius = 0.0;
+	};
+
+	struct FContactResult
+	{
+		std::int32_t num_contacts = 0;
+
+		// Fastest approach speed along a contact normal, in m/s. Large values are crashes.
+		double max_impact_speed = 0.0;
+	};
+}
+
+namespace physics::collision
+{
+	/**
+	 * @return null if a heightfield has fewer than 2 samples along an axis, or not one height per sample
+	 */
+	DRONESIMULATORPHYSICS_API std::shared_ptr<const FCollisionWorld> compile(FCollisionGeometry geometry);
+
+	/**
+	 * @param rotors See FDroneModel::rotors, may be empty
+	 * @param propeller_radius In meters, 0 if there is no propeller
+	 */
+	DRONESIMULATORPHYSICS_API FDroneCollisionShape make_drone_shape(const std::vector<FRotorDescription>& rotors,
+		double propeller_radius);
+
+	/**
+	 * Adds the contact forces of the drone against the ground and the shapes near it to the body accumulators. Call it
+	 * once per substep, before consuming the forces. The drone must fit in FCollisionGeometry::max_body_radius.
+	 */
+	DRONESIMULATORPHYSICS_API FContactResult apply_contacts(const FCollisionWorld& world, FSubstepBody* substep_body,
+		const FDroneCollisionShape& drone_shape, double substep_delta_time);
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/DroneController.h"
+#include "DroneSimulatorPhysics/Public/Controller/FlightMode.h"
+#include "DroneSimulatorPhysics/Public/Controller/Mixer.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace physics
+{
+	// One column per axis: X is roll, Y is pitch and Z is yaw
+	struct DRONESIMULATORPHYSICS_API FAxisColumns
+	{
+		std::vector<double> x;
+		std::vector<double> y;
+		std::vector<double> z;
+
+		void resize(std::int32_t size);
+
+		FVector3 get(std::int32_t index) const { return FVector3(this->x[index], this->y[index], this->z[index]); }
+
+		void set(std::int32_t index, const FVector3& value)
+		{
+			this->x[index] = value.X;
+			this->y[index] = value.Y;
+			this->z[index] = value.Z;
+		}
+	};
+
+	// FDroneSetpoint of many drones
+	struct DRONESIMULATORPHYSICS_API FSetpointColumns
+	{
+		std::vector<double> throttle;
+
+		// Local, in rad/s
+		FAxisColumns angular_velocity_radians;
+
+		void resize(std::int32_t size);
+
+		FDroneSetpoint get(std::int32_t index) const
+		{
+			return FDroneSetpoint { this->throttle[index], this->angular_velocity_radians.get(index) };
+		}
+
+		void set(std::int32_t index, const FDroneSetpoint& setpoint)
+		{
+			this->throttle[index] = setpoint.throttle;
+			this->angular_velocity_radians.set(index, setpoint.angular_velocity_radians);
+		}
+	};
+
+	/**
+	 * FFlightModeAir of many drones, with the pilot input of the substep.
+	 */
+	struct DRONESIMULATORPHYSICS_API FFlightModeAirBatch
+	{
+		std::vector<double> roll_rate_deg_per_second;
+		std::vector<double> pitch_rate_deg_per_second;
+		std::vector<double> yaw_rate_deg_per_second;
+
+		// Input of the substep, see FDronePlayerInput
+		std::vector<double> input_throttle;
+		std::vector<double> input_yaw;
+		std::vector<double> input_pitch;
+		std::vector<double> input_roll;
+
+		std::int32_t size() const { return static_cast<std::int32_t>(this->input_throttle.size()); }
+
+		void resize(std::int32_t size);
+
+		void set_flight_mode(std::int32_t index, const FFlightModeAir& flight_mode);
+
+		void set_input(std::int32_t index, const FDronePlayerInput& input);
+	};
+
+	/**
+	 * PID controllers of many drones, as structure of arrays. Gains, integrators and the inputs of the substep are
+	 * columns, so that one kernel steps every drone with vector instructions, instead of one call per drone reading
+	 * state scattered in memory. Same results as tick_pid_controller, bit for bit.
+	 */
+	struct DRONESIMULATORPHYSICS_API FPidControllerBatch
+	{
+		// Gains, see FPidDroneControllerConfig
+		FAxisColumns proportional;
+		FAxisColumns integral;
+		FAxisColumns derivative;
+		std::vector<double> min_throttle;
+		std::vector<double> min_dynamic_throttle;
+
+		// State, see FPidDroneControllerState
+		FAxisColumns last_angular_velocity_error;
+		FAxisColumns integrated_angular_velocity_error;
+
+		// Local angular velocity of the body, in rad/s
+		FAxisColumns current_angular_velocity;
+
+		// In seconds, time covered by this run of each controller
+		std::vector<double> delta_time;
+
+		// 0 for the controllers that don't run on this substep. Their state is left as-is, and they have no output.
+		std::vector<std::uint8_t> is_active;
+
+		// Mixer of the frame of each drone, pointing into its model
+		std::vector<const FMixerMatrix*> mixers;
+
+		// Output of the PID before the allocation to the rotors
+		FAxisColumns delta_throttle_angular;
+
+		// Output, only written for the active controllers
+		std::vector<FRotorSetThrottle> throttle;
+
+		std::int32_t size() const { return static_cast<std::int32_t>(this->delta_time.size()); }
+
+		// New controllers are inactive, with zero gains and state
+		void resize(std::int32_t size);
+
+		// Loads the gains and the state of a controller
+		void set_controller(std::int32_t index, const FPidDroneController& controller);
+
+		FPidDroneControllerState get_state(std::int32_t index) const;
+	};
+}
+
+namespace physics::controller_batch
+{
+	// compute_air_setpoint for every drone of the batch
+	DRONESIMULATORPHYSICS_API void compute_air_setpoints(const FFlightModeAirBatch& flight_modes, FSetpointColumns& out_setpoints);
+
+	// tick_pid_controller for every active controller of the batch
+	DRONESIMULATORPHYSICS_API void tick_pid(FPidControllerBatch& controllers, const FSetpointColumns& setpoints);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/Mixer.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/Controller/Throttle.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+#include <variant>
+
+namespace physics
+{
+	struct FPidConfig
+	{
+		double proportional = 0.0;
+		double integral = 0.0;
+		double derivative = 0.0;
+	};
+
+	struct FPidDroneControllerConfig
+	{
+		double min_throttle = 0.05;
+
+		double min_dynamic_throttle = 0.02;
+
+		FPidConfig pitch_pid = FPidConfig { 0.1, 0.0, 0.0 };
+
+		FPidConfig yaw_pid = FPidConfig { 0.3, 0.0, 0.0 };
+
+		FPidConfig roll_pid = FPidConfig { 0.1, 0.0, 0.0 };
+	};
+
+	/**
+	 * Mutable state of the PID controller, carried from one substep to the next.
+	 */
+	struct FPidDroneControllerState
+	{
+		// In rad/s
+		FVector3 last_angular_velocity_error = FVector3::zero();
+
+		// In rad
+		FVector3 integrated_angular_velocity_error = FVector3::zero();
+	};
+
+	struct FPidDroneController
+	{
+		FPidDroneControllerConfig config;
+
+		FPidDroneControllerState state;
+	};
+
+	struct FBasicDroneController
+	{
+		double global_throttle_rate = 0.6;
+
+		double roll_throttle_rate = 0.01;
+
+		double pitch_throttle_rate = 0.01;
+
+		double yaw_throttle_rate = 0.08;
+	};
+
+	using FDroneController = std::variant<FPidDroneController, FBasicDroneController>;
+}
+
+namespace physics::controller
+{
+	/**
+	 * @param current_angular_velocity Local angular velocity, in rad per second, around each axis
+	 * @param mixer Allocation of the roll, pitch and yaw commands to the rotors of the frame
+	 */
+	DRONESIMULATORPHYSICS_API FRotorSetThrottle tick_pid_controller(const FPidDroneControllerConfig& config,
+		FPidDroneControllerState& state, double delta_time, const FDroneSetpoint& setpoint, const FVector3& current_angular_velocity,
+		const FMixerMatrix& mixer);
+
+	/**
+	 * Second half of the PID controller: mixes the collective throttle and the roll, pitch and yaw commands, then shifts
+	 * the collective so that every rotor stays in the dynamic range.
+	 * @param delta_throttle_angular Output of the PID, X is roll, Y is pitch and Z is yaw
+	 */
+	DRONESIMULATORPHYSICS_API FRotorSetThrottle allocate_pid_throttle(double min_throttle, double min_dynamic_throttle,
+		double setpoint_throttle, const FVector3& delta_throttle_angular, const FMixerMatrix& mixer);
+
+	// Quad X frames
+	DRONESIMULATORPHYSICS_API FPropellerSetThrottle tick_pid_controller(const FPidDroneControllerConfig& config,
+		FPidDroneControllerState& state, double delta_time, const FDroneSetpoint& setpoint, const FVector3& current_angular_velocity);
+
+	DRONESIMULATORPHYSICS_API FRotorSetThrottle tick_basic_controller(const FBasicDroneController& controller,
+		const FDroneSetpoint& setpoint, const FMixerMatrix& mixer);
+
+	// Quad X frames
+	DRONESIMULATORPHYSICS_API FPropellerSetThrottle tick_basic_controller(const FBasicDroneController& controller,
+		const FDroneSetpoint& setpoint);
+
+	DRONESIMULATORPHYSICS_API FRotorSetThrottle tick_controller(FDroneController& controller, double delta_time,
+		const FDroneSetpoint& setpoint, const FVector3& current_angular_velocity, const FMixerMatrix& mixer);
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/Math/Quaternion.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+#include <variant>
+
+namespace physics
+{
+	struct FFlightModeState
+	{
+		// World linear velocity in m/s
+		FVector3 linear_velocity_world = FVector3::zero();
+
+		// World angular velocity in rad/s
+		FVector3 angular_velocity_world = FVector3::zero();
+
+		// World rotation
+		FRotation rotation;
+
+		// Delta time used for the current tick
+		double delta_time = 0.0;
+	};
+
+	/** Acro (rate) mode: sticks control the angular velocity */
+	struct FFlightModeAir
+	{
+		double roll_rate_deg_per_second = 500.0;
+		double pitch_rate_deg_per_second = 500.0;
+		double yaw_rate_deg_per_second = 500.0;
+	};
+
+	/** Stabilized mode: sticks control the pitch and roll angles, and the yaw rate */
+	struct FFlightModeAngle
+	{
+		double max_roll_angle_deg = 45.0;
+		double max_pitch_angle_deg = 45.0;
+		double yaw_rate_deg_per_second = 200.0;
+		double angle_roll_p = 6.0;
+		double angle_pitch_p = 6.0;
+	};
+
+	struct FFlightModeVelocityConfig
+	{
+		double max_horizontal_velocity_m_s = 10.0;
+		double max_vertical_velocity_m_s = 5.0;
+		double max_tilt_angle_deg = 30.0;
+		double yaw_rate_deg_per_second = 120.0;
+		double velocity_p = 2.0;
+		double velocity_i = 0.5;
+		double velocity_i_max_deg = 10.0;
+		double angle_roll_p = 6.0;
+		double angle_pitch_p = 6.0;
+		double vertical_velocity_p = 0.5;
+		double vertical_velocity_i = 0.5;
+		double vertical_velocity_d = 0.05;
+		double vertical_velocity_i_max = 2.0;
+		double hover_throttle = 0.5;
+	};
+
+	/**
+	 * Mutable state of the velocity flight mode, carried from one tick to the next.
+	 */
+	struct FFlightModeVelocityState
+	{
+		// PI state (integral terms) for horizontal velocity
+		double velocity_x_integral = 0.0;
+		double velocity_y_integral = 0.0;
+
+		// PID state for vertical velocity
+		double vertical_velocity_integral = 0.0;
+		double prev_vertical_velocity_error = 0.0;
+	};
+
+	/** Position mode: sticks control the horizontal and vertical velocities */
+	struct FFlightModeVelocity
+	{
+		FFlightModeVelocityConfig config;
+
+		FFlightModeVelocityState state;
+	};
+
+	using FFlightMode = std::variant<FFlightModeAir, FFlightModeAngle, FFlightModeVelocity>;
+}
+
+namespace physics::flight_mode
+{
+	DRONESIMULATORPHYSICS_API FDroneSetpoint compute_air_setpoint(const FFlightModeAir& flight_mode,
+		const FDronePlayerInput& player_input);
+
+	DRONESIMULATORPHYSICS_API FDroneSetpoint compute_angle_setpoint(const FFlightModeAngle& flight_mode,
+		const FDronePlayerInput& player_input, const FFlightModeState& flight_state);
+
+	DRONESIMULATORPHYSICS_API FDroneSetpoint compute_velocity_setpoint(const FFlightModeVelocityConfig& config,
+		FFlightModeVelocityState& state, const FDronePlayerInput& player_input, const FFlightModeState& flight_state);
+
+	/**
+	 * Target setpoint, that the controller will try to reach using the motors and its PID.
+	 */
+	DRONESIMULATORPHYSICS_API FDroneSetpoint compute_setpoint(FFlightMode& flight_mode, const FDronePlayerInput& player_input,
+		const FFlightModeState& flight_state);
+}
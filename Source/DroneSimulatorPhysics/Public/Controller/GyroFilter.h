@@ -0,0 +1,167 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/ControllerBatch.h"
+#include "DroneSimulatorPhysics/Public/Controller/Mixer.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace physics
+{
+	enum class EGyroLowpassType : std::uint8_t
+	{
+		// First order, the default of most firmwares
+		pt1,
+
+		// Second order Butterworth
+		biquad,
+	};
+
+	/**
+	 * Gyro filtering of the flight controller firmware: a lowpass, then notches at the first harmonics of each rotor
+	 * frequency (the RPM filter). The notches follow the rotor speeds, which the simulation knows exactly, so they
+	 * also take the place of the dynamic notches that firmwares center on the peaks of a gyro FFT.
+	 */
+	struct FGyroFilterConfig
+	{
+		bool is_enabled = false;
+
+		EGyroLowpassType lowpass_type = EGyroLowpassType::pt1;
+
+		// 0 to disable the lowpass
+		double lowpass_cutoff_hz = 150.0;
+
+		// Notches at 1x, 2x... the rotor frequency, 0 to disable the RPM filter
+		std::int32_t rpm_harmonic_count = 3;
+
+		double rpm_notch_q = 5.0;
+
+		// Notches under this frequency are bypassed, the rotors barely vibrate that slow
+		double rpm_notch_min_hz = 100.0;
+
+		// The coefficients of a notch are only computed again when its center moves by more than this
+		double notch_retune_threshold_hz = 2.0;
+	};
+
+	inline constexpr std::int32_t max_rpm_harmonic_count = 3;
+
+	// The lowpass, then rotor 0 harmonics 1 to N, rotor 1 harmonics 1 to N...
+	inline constexpr std::int32_t max_gyro_filter_stages = 1 + max_rotor_count * max_rpm_harmonic_count;
+
+	// Normalized by a0. The default passes the signal through.
+	struct FBiquadCoefficients
+	{
+		double b0 = 1.0;
+		double b1 = 0.0;
+		double b2 = 0.0;
+		double a1 = 0.0;
+		double a2 = 0.0;
+	};
+
+	// Transposed direct form II, one filter per axis
+	struct FBiquadState
+	{
+		FVector3 z1 = FVector3::zero();
+		FVector3 z2 = FVector3::zero();
+	};
+
+	struct FGyroFilterState
+	{
+		std::array<FBiquadCoefficients, max_gyro_filter_stages> coefficients = {};
+
+		std::array<FBiquadState, max_gyro_filter_stages> stages = {};
+
+		// In Hz, center each notch is tuned for, 0 while bypassed
+		std::array<double, max_gyro_filter_stages> notch_center_hz = {};
+
+		// Stages in use, from the number of rotors and harmonics
+		std::int32_t stage_count = 0;
+
+		// Sample rate the coefficients were computed for
+		double sample_rate_hz = 0.0;
+
+		// Filtered angular velocity the controller flies on, in rad/s around the local axes
+		FVector3 output = FVector3::zero();
+
+		// False until the first gyro sample, the controller reads the body in the meantime
+		bool has_output = false;
+	};
+
+	struct FGyroFilter
+	{
+		FGyroFilterConfig config;
+
+		FGyroFilterState state;
+	};
+
+	/**
+	 * Gyro filters of many drones, as structure of arrays: the coefficients and the state of stage S of every drone are
+	 * contiguous, so that each stage runs as one loop over the drones and the three axes, in vector lanes. The stages
+	 * themselves run one after the other. Same results as gyro_filter::apply, bit for bit.
+	 */
+	struct DRONESIMULATORPHYSICS_API FGyroFilterBank
+	{
+		// Column of stage S of drone D at S * size() + D
+		std::vector<double> b0;
+		std::vector<double> b1;
+		std::vector<double> b2;
+		std::vector<double> a1;
+		std::vector<double> a2;
+		std::array<std::vector<double>, 3> z1;
+		std::array<std::vector<double>, 3> z2;
+
+		// Gyro sample of each drone, then its filtered value
+		FAxisColumns input;
+		FAxisColumns output;
+
+		// 0 for the drones without a gyro sample on this substep. Their state is left as-is.
+		std::vector<std::uint8_t> is_active;
+
+		std::int32_t stage_count = 0;
+
+		std::int32_t size() const { return static_cast<std::int32_t>(this->is_active.size()); }
+
+		// Clears the bank. Drones with fewer stages pass the signal through the extra ones.
+		void resize(std::int32_t size, std::int32_t in_stage_count);
+
+		// Loads the coefficients and the state of a filter
+		void set_filter(std::int32_t index, const FGyroFilterState& state);
+
+		// After a retune, the state stays in the bank
+		void set_coefficients(std::int32_t index, const FGyroFilterState& state);
+
+		// Writes the state of the stages back to the filter
+		void get_state(std::int32_t index, FGyroFilterState& out_state) const;
+	};
+}
+
+namespace physics::gyro_filter
+{
+	DRONESIMULATORPHYSICS_API FBiquadCoefficients make_pt1_lowpass(double cutoff_hz, double sample_rate_hz);
+
+	DRONESIMULATORPHYSICS_API FBiquadCoefficients make_biquad_lowpass(double cutoff_hz, double sample_rate_hz);
+
+	DRONESIMULATORPHYSICS_API FBiquadCoefficients make_notch(double center_hz, double q, double sample_rate_hz);
+
+	// 0 when the filter is disabled
+	DRONESIMULATORPHYSICS_API std::int32_t get_stage_count(const FGyroFilterConfig& config, std::int32_t rotor_count);
+
+	/**
+	 * Moves the notches to the harmonics of the rotor speeds. A notch is only computed again when its center moves by
+	 * more than the threshold of the config, or crosses the minimum frequency.
+	 * @param rotor_throttle Throttle of each rotor, the rotor speed is the throttle times max_rotor_speed
+	 * @param max_rotor_speed In rad/s
+	 * @return Whether a coefficient changed
+	 */
+	DRONESIMULATORPHYSICS_API bool retune(FGyroFilter& filter, const FRotorSetThrottle& rotor_throttle, double max_rotor_speed,
+		double sample_rate_hz);
+
+	// Runs the gyro sample through the stages, and keeps the result as the output
+	DRONESIMULATORPHYSICS_API const FVector3& apply(FGyroFilter& filter, const FVector3& angular_velocity);
+
+	// apply for every active drone of the bank
+	DRONESIMULATORPHYSICS_API void apply_bank(FGyroFilterBank& bank);
+}
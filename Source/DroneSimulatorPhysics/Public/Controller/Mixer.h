@@ -0,0 +1,70 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/Throttle.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace physics
+{
+	// Rotors past this count are ignored, so that the throttle of a whole frame fits on the stack
+	inline constexpr std::int32_t max_rotor_count = 16;
+
+	/**
+	 * Throttle for each rotor of the frame, in the order of FDroneFrame::rotors. In [0..1] range
+	 */
+	struct DRONESIMULATORPHYSICS_API FRotorSetThrottle
+	{
+		std::array<double, max_rotor_count> values = {};
+
+		std::int32_t count = 0;
+
+		// 0 when there is no rotor
+		double min() const;
+
+		// 0 when there is no rotor
+		double max() const;
+
+		// Only valid for 4 rotors, in the quad X order
+		FPropellerSetThrottle to_propeller_set() const;
+
+		static FRotorSetThrottle from_propeller_set(const FPropellerSetThrottle& throttle);
+	};
+
+	/**
+	 * Allocation of the collective throttle and of the roll, pitch and yaw commands to each rotor:
+	 * throttle[i] = collective + axis_factors[i] · (roll, pitch, yaw)
+	 */
+	struct FMixerMatrix
+	{
+		// X is roll, Y is pitch and Z is yaw, like the angular velocity
+		std::array<FVector3, max_rotor_count> axis_factors = {};
+
+		std::int32_t count = 0;
+	};
+}
+
+namespace physics::mixer
+{
+	// Front left, front right, rear left, rear right. The front left and rear right props spin clockwise.
+	DRONESIMULATORPHYSICS_API FMixerMatrix make_quad_x();
+
+	/**
+	 * Roll and pitch factors are the rotor offsets from the center, normalized so that the furthest rotor has a factor
+	 * of 1 on each axis. Yaw factors are +1 for clockwise rotors and -1 for the others. The tilt of the rotors is not
+	 * taken into account.
+	 */
+	DRONESIMULATORPHYSICS_API FMixerMatrix compile(const std::vector<FRotorDescription>& rotors);
+
+	// The quad X mixer if the frame has no rotors, so that the existing frames fly exactly as before
+	DRONESIMULATORPHYSICS_API FMixerMatrix compile_for_frame(const FDroneFrame& frame);
+
+	/**
+	 * @param axis_command Delta throttle around each axis, X is roll, Y is pitch and Z is yaw
+	 */
+	DRONESIMULATORPHYSICS_API FRotorSetThrottle mix(const FMixerMatrix& mixer, double collective, const FVector3& axis_command);
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/DroneController.h"
+#include "DroneSimulatorPhysics/Public/Controller/FlightMode.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace physics
+{
+	class FWorkerPool;
+
+	enum class EPidTuningTarget : std::uint8_t
+	{
+		// Roll, pitch and yaw PIDs of the rate controller, flown in air mode
+		rate_pid,
+
+		// Horizontal and vertical velocity gains of the velocity flight mode, on top of the rate controller
+		velocity_mode,
+	};
+
+	enum class ETuningManoeuvreType : std::uint8_t
+	{
+		// The stick jumps to the amplitude and is held
+		step,
+
+		// Sine on the stick, its frequency sweeping from start_frequency_hz to end_frequency_hz
+		chirp,
+
+		// Sticks centered, the body is kicked at the start and the controller brings it back
+		disturbance,
+	};
+
+	struct FTuningManoeuvre
+	{
+		ETuningManoeuvreType type = ETuningManoeuvreType::step;
+
+		// Rate PID: 0 is roll, 1 is pitch and 2 is yaw. Velocity mode: 0 is world X, 1 is world Y and 2 is world Z.
+		std::int32_t axis = 0;
+
+		// Stick deflection in -1..1 for steps and chirps. For disturbances, the kick: in rad/s around the axis for the
+		// rate PID, in m/s along the axis for the velocity mode.
+		double amplitude = 0.5;
+
+		// In seconds
+		double duration = 1.0;
+
+		double start_frequency_hz = 1.0;
+
+		double end_frequency_hz = 10.0;
+	};
+
+	/**
+	 * Score of a response, lower is better. Each term is normalized by the amplitude of the manoeuvre, so that axes and
+	 * manoeuvres of different magnitudes weigh the same.
+	 */
+	struct FTuningScore
+	{
+		// Mean absolute error between the reference and the response, as a fraction of the amplitude
+		double tracking_error = 0.0;
+
+		// Peak excursion past the reference, as a fraction of the amplitude
+		double overshoot = 0.0;
+
+		// In seconds, after which the error stays within the settling band
+		double settling_time = 0.0;
+
+		// Fraction of the substeps with a rotor at min or max throttle
+		double saturation = 0.0;
+
+		// Travel of the response beyond what following the reference needs, as a multiple of the amplitude
+		double oscillation = 0.0;
+
+		// Weighted sum of the terms. Very large when the drone diverged.
+		double cost = 0.0;
+	};
+
+	struct FTuningScoreWeights
+	{
+		double tracking_error = 1.0;
+		double overshoot = 1.0;
+		double settling_time = 1.0;
+		double saturation = 1.0;
+		double oscillation = 0.5;
+
+		// The error is settled within this fraction of the amplitude
+		double settling_band = 0.05;
+	};
+
+	// Everything the tuner can change
+	struct FPidTuningGains
+	{
+		FPidDroneControllerConfig controller;
+
+		FFlightModeVelocityConfig velocity;
+	};
+
+	struct FPidTuningConfig
+	{
+		EPidTuningTarget target = EPidTuningTarget::rate_pid;
+
+		// Empty to use pid_tuning::make_default_manoeuvres
+		std::vector<FTuningManoeuvre> manoeuvres;
+
+		FTuningScoreWeights weights;
+
+		// Collective throttle of the rate PID manoeuvres, flown in air mode
+		double rate_throttle = 0.5;
+
+		// Upper bound of each gain, the lower bound is 0
+		double max_rate_proportional = 0.5;
+		double max_rate_integral = 1.0;
+		double max_rate_derivative = 0.01;
+		double max_velocity_proportional = 10.0;
+		double max_velocity_integral = 5.0;
+		double max_vertical_velocity_proportional = 2.0;
+		double max_vertical_velocity_integral = 2.0;
+		double max_vertical_velocity_derivative = 0.5;
+
+		std::int32_t max_generations = 30;
+
+		// Candidates per generation, 0 for the CMA-ES default of 4 + 3 ln(number of gains)
+		std::int32_t population_size = 0;
+
+		// Initial standard deviation of the search, as a fraction of the range of each gain
+		double initial_step_size = 0.2;
+
+		// The search stops when the step size falls below this fraction of the range
+		double min_step_size = 1e-4;
+
+		// Same seed, same result, whatever the number of threads
+		std::uint64_t seed = 1;
+	};
+
+	struct FPidTuningResult
+	{
+		// Best gains found, the ones that weren't tuned are the initial ones
+		FPidTuningGains gains;
+
+		FTuningScore score;
+
+		// Score of the initial gains
+		FTuningScore initial_score;
+
+		std::int32_t generation_count = 0;
+
+		std::int32_t evaluation_count = 0;
+	};
+
+	/**
+	 * Searches the gains of the rate PID or of the velocity flight mode with CMA-ES, scoring every candidate on headless
+	 * step, chirp and disturbance manoeuvres. The manoeuvres of a generation run in parallel on all cores.
+	 *
+	 * Not reentrant: the manoeuvres run on the threads of the tuner, so it takes one tune or evaluate at a time.
+	 */
+	class DRONESIMULATORPHYSICS_API FPidAutoTuner
+	{
+	public:
+
+		/**
+		 * @param num_threads Number of threads running the manoeuvres, including the calling thread. 0 to use all cores.
+		 */
+		explicit FPidAutoTuner(std::int32_t num_threads = 0);
+
+		~FPidAutoTuner();
+
+		/**
+		 * @param drone Drone to tune, from its current state. Its gains are the starting point of the search.
+		 * @return Nothing if the drone doesn't have a PID controller driving its rotors
+		 */
+		std::optional<FPidTuningResult> tune(const FDroneSimulation& drone, const FPidTuningConfig& config);
+
+		// Score of the gains on the manoeuvres of the config, averaged over the manoeuvres
+		FTuningScore evaluate(const FDroneSimulation& drone, const FPidTuningGains& gains, const FPidTuningConfig& config);
+
+	private:
+
+		std::unique_ptr<FWorkerPool> worker_pool;
+	};
+}
+
+namespace physics::pid_tuning
+{
+	// Step, chirp and disturbance on each of the three axes
+	DRONESIMULATORPHYSICS_API std::vector<FTuningManoeuvre> make_default_manoeuvres(EPidTuningTarget target);
+
+	// Nothing if the drone doesn't have a PID controller driving its rotors
+	DRONESIMULATORPHYSICS_API std::optional<FPidTuningGains> get_gains(const FDroneSimulation& drone);
+
+	// Sets the PID config, and the velocity config if the drone flies in velocity mode
+	DRONESIMULATORPHYSICS_API void apply_gains(FDroneSimulation& drone, const FPidTuningGains& gains);
+
+	/**
+	 * Flies one manoeuvre on a copy of the drone, with the gains and the flight mode of the target of the config.
+	 * Controller and flight mode states start from zero. The drone must have a PID controller driving its rotors.
+	 */
+	DRONESIMULATORPHYSICS_API FTuningScore run_manoeuvre(const FDroneSimulation& drone, const FPidTuningGains& gains,
+		const FTuningManoeuvre& manoeuvre, const FPidTuningConfig& config);
+}
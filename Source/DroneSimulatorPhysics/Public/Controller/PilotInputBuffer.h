@@ -0,0 +1,47 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+
+#include <array>
+#include <cstdint>
+
+namespace physics
+{
+	struct FTimedPlayerInput
+	{
+		// In seconds, on the clock of the buffer owner
+		double time_seconds = 0.0;
+
+		FDronePlayerInput input;
+	};
+
+	/**
+	 * Last pilot inputs with their timestamp, so that the flight mode can run on every substep with the input at the
+	 * substep time instead of the input of the last game frame. Fixed capacity and plain data, so that it fits in a
+	 * snapshot.
+	 */
+	struct DRONESIMULATORPHYSICS_API FPilotInputBuffer
+	{
+		static constexpr std::int32_t capacity = 8;
+
+		// Oldest first
+		std::array<FTimedPlayerInput, capacity> samples = {};
+
+		std::int32_t count = 0;
+
+		/**
+		 * Drops the oldest sample when full. A sample at the time of the last one replaces it, and a sample older than
+		 * the last one (the clock was reset) clears the buffer.
+		 */
+		void push(double time_seconds, const FDronePlayerInput& input);
+
+		/**
+		 * Linear interpolation between the two samples around the time. Before the first sample and after the last one,
+		 * the closest sample is held. Zero input if the buffer is empty.
+		 */
+		FDronePlayerInput sample(double time_seconds) const;
+
+		void clear() { this->count = 0; }
+	};
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+namespace physics
+{
+	/**
+	 * Target of the drone controller, computed by the flight mode.
+	 */
+	struct FDroneSetpoint
+	{
+		// In 0..1 range
+		double throttle = 0.0;
+
+		// Local angular velocity, in rad/s around each axis
+		FVector3 angular_velocity_radians = FVector3::zero();
+	};
+
+	/**
+	 * Input of the pilot. See FDronePlayerInput in DroneSimulatorCore for the sign conventions.
+	 */
+	struct FDronePlayerInput
+	{
+		// 0..1 range, or -1..1 for flight modes that control the vertical velocity
+		double throttle = 0.0;
+
+		// -1..1 range
+		double yaw = 0.0;
+
+		// -1..1 range
+		double pitch = 0.0;
+
+		// -1..1 range
+		double roll = 0.0;
+
+		static constexpr FDronePlayerInput zero()
+		{
+			return FDronePlayerInput { 0.0, 0.0, 0.0, 0.0 };
+		}
+	};
+}
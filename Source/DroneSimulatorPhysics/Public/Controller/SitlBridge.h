@@ -0,0 +1,293 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/Mixer.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace physics
+{
+	class FSharedMemoryRegion;
+	class FUdpSocket;
+	struct FSubstepBody;
+
+	/**
+	 * Software-in-the-loop protocol, to fly flight controller firmware built as a native binary (Betaflight SITL, PX4
+	 * SITL) instead of the controllers of the simulation. The firmware runs behind a small shim that maps these packets
+	 * to its own simulator interface.
+	 *
+	 * Each run of the controller is one lockstep exchange: the simulation sends a FSitlSensorPacket with sequence N,
+	 * then waits for the FSitlMotorPacket with sequence N. The firmware advances its clock to the time of the sensors,
+	 * and no further, before answering. Neither side ever runs ahead of the other.
+	 *
+	 * The packets are the wire format, sent as-is over UDP and written in place in shared memory. Both sides must run on
+	 * the same machine, the layout is the native one.
+	 */
+	enum class ESitlTransport : std::uint8_t
+	{
+		// The simulation sends the sensors to sensor_port, and receives the motors on motor_port
+		udp,
+
+		// The simulation creates the region, see FSitlSharedMemoryLayout
+		shared_memory,
+	};
+
+	// Roll, pitch, throttle and yaw (AETR order), then the arm switch. The remaining channels are centered.
+	inline constexpr std::int32_t sitl_rc_channel_count = 8;
+
+	/**
+	 * Sensors of one controller run. Vectors are in the frame of the simulation: X forward, Y right, Z up, see
+	 * FVector3. The shim converts them to the frame of the firmware.
+	 */
+	struct FSitlSensorPacket
+	{
+		static constexpr std::uint32_t expected_magic = 0x53534453; // "SDSS"
+
+		std::uint32_t magic = expected_magic;
+
+		// The motor packet answering this one has the same sequence
+		std::uint32_t sequence = 0;
+
+		// Simulation time at the start of the substep, in microseconds
+		std::uint64_t time_us = 0;
+
+		// Gyro, in rad/s around the local axes
+		std::array<double, 3> angular_velocity = {};
+
+		// Accelerometer, in m/s² along the local axes. About +9.81 on Z when hovering.
+		std::array<double, 3> specific_force = {};
+
+		// Local to world rotation, as X, Y, Z, W
+		std::array<double, 4> orientation = { 0.0, 0.0, 0.0, 1.0 };
+
+		// In m
+		std::array<double, 3> location_world = {};
+
+		// In m/s
+		std::array<double, 3> linear_velocity_world = {};
+
+		// Pulse widths in microseconds, 1000 to 2000
+		std::array<std::uint16_t, sitl_rc_channel_count> rc_channels = {};
+	};
+
+	struct FSitlMotorPacket
+	{
+		static constexpr std::uint32_t expected_magic = 0x4D534453; // "SDSM"
+
+		std::uint32_t magic = expected_magic;
+
+		// Sequence of the sensor packet this one answers
+		std::uint32_t sequence = 0;
+
+		std::uint32_t motor_count = 0;
+
+		// Throttle of each motor, 0 to 1, in the order of the rotors of the frame
+		std::array<float, max_rotor_count> motors = {};
+	};
+
+	static_assert(std::is_trivially_copyable_v<FSitlSensorPacket> && std::is_trivially_copyable_v<FSitlMotorPacket>,
+		"The packets are sent as raw bytes");
+
+	/**
+	 * Shared memory region of the shared_memory transport. The simulation writes the sensors in place, then publishes them
+	 * by setting sensor_count to their sequence + 1 (release). The firmware writes the motors in place, then sets
+	 * motor_count to the same value (release).
+	 */
+	struct FSitlSharedMemoryLayout
+	{
+		static constexpr std::uint32_t expected_magic = 0x4C534453; // "SDSL"
+		static constexpr std::uint32_t expected_version = 1;
+
+		// Written last by the simulation (release), read first by the firmware (acquire)
+		std::atomic<std::uint32_t> magic;
+		std::uint32_t version = 0;
+
+		// Each counter is on its own cache line, as each one is written by a single process
+		alignas(64) std::atomic<std::uint64_t> sensor_count;
+		alignas(64) std::atomic<std::uint64_t> motor_count;
+
+		alignas(64) FSitlSensorPacket sensors;
+		alignas(64) FSitlMotorPacket motors;
+	};
+
+	static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+		"The counters and the magic must be usable across processes");
+
+	struct FSitlBridgeConfig
+	{
+		ESitlTransport transport = ESitlTransport::udp;
+
+		// The firmware side, UDP only
+		std::string address = "127.0.0.1";
+
+		std::uint16_t sensor_port = 9003;
+
+		std::uint16_t motor_port = 9002;
+
+		std::string shared_memory_name = "drone_sitl";
+
+		// How long an exchange waits for the firmware, in seconds. A lockstep exchange takes microseconds, a firmware that
+		// misses this is stalled or gone.
+		double timeout_seconds = 0.005;
+	};
+
+	// Time from sending the sensors to receiving the motors, measured on every exchange
+	struct FSitlRoundTripStats
+	{
+		std::int64_t exchange_count = 0;
+
+		std::int64_t timeout_count = 0;
+
+		// In seconds, over the exchanges that didn't time out
+		double total_seconds = 0.0;
+
+		double max_seconds = 0.0;
+
+		double get_mean_seconds() const
+		{
+			return this->exchange_count > 0 ? this->total_seconds / static_cast<double>(this->exchange_count) : 0.0;
+		}
+	};
+
+	/**
+	 * Simulation side of the protocol. The packets are allocated once, exchanges don't allocate.
+	 *
+	 * The first timeout disconnects the bridge: the next exchanges still send the sensors but don't wait, and only check
+	 * whether the firmware answered any of them since. The bridge connects again once it has, so that a firmware that
+	 * isn't running costs a single timeout rather than one per substep.
+	 */
+	class DRONESIMULATORPHYSICS_API FSitlBridge
+	{
+	public:
+
+		FSitlBridge();
+
+		~FSitlBridge();
+
+		/**
+		 * Binds the motor port, or creates the shared memory region. The firmware can start before or after.
+		 * @return false if the socket or the region could not be created
+		 */
+		bool open(const FSitlBridgeConfig& in_config);
+
+		bool is_open() const;
+
+		/**
+		 * Packet of the next exchange, to fill in place. Its magic and sequence are set by exchange. With shared memory,
+		 * this is the packet in the region.
+		 */
+		FSitlSensorPacket& get_sensor_packet();
+
+		/**
+		 * Sends the sensor packet, then waits for the motors answering it. Stale motor packets are dropped.
+		 * @return The motors, valid until the next exchange, or nullptr if the firmware didn't answer in time or the
+		 * bridge is disconnected
+		 */
+		const FSitlMotorPacket* exchange();
+
+		// False from a timeout until the firmware answers again
+		bool is_connected() const { return this->is_firmware_connected; }
+
+		const FSitlRoundTripStats& get_round_trip_stats() const { return this->round_trip_stats; }
+
+		void reset_round_trip_stats();
+
+	private:
+
+		FSitlBridgeConfig config;
+
+		std::unique_ptr<FUdpSocket> socket;
+
+		std::unique_ptr<FSharedMemoryRegion> region;
+
+		// Packets of the UDP transport, sent and received without copies
+		FSitlSensorPacket sensor_packet;
+
+		FSitlMotorPacket motor_packet;
+
+		std::uint32_t next_sequence = 0;
+
+		FSitlRoundTripStats round_trip_stats;
+
+		bool is_firmware_connected = true;
+
+		// While disconnected, the first sensor packet sent since. Only answers to it or to a later one count.
+		std::uint32_t first_probe_sequence = 0;
+
+		// Sends the sensors without waiting, true if the firmware answered any of them since the disconnection
+		bool probe_firmware(std::uint32_t sequence);
+	};
+
+	/**
+	 * Firmware side of the protocol, for shims written in C++. Other languages map the same layout.
+	 */
+	class DRONESIMULATORPHYSICS_API FSitlFirmwareEndpoint
+	{
+	public:
+
+		FSitlFirmwareEndpoint();
+
+		~FSitlFirmwareEndpoint();
+
+		/**
+		 * Binds the sensor port, or opens the region created by the simulation.
+		 * @return false if the socket could not be created, or the region doesn't exist or has an unexpected layout
+		 */
+		bool open(const FSitlBridgeConfig& in_config);
+
+		/**
+		 * Waits for the next sensor packet.
+		 * @return The sensors, valid until the next call, or nullptr on timeout
+		 */
+		const FSitlSensorPacket* receive_sensors(double timeout_seconds);
+
+		// Packet of the answer, to fill in place
+		FSitlMotorPacket& get_motor_packet();
+
+		// Answers the last sensors received, with the same sequence
+		void send_motors();
+
+	private:
+
+		FSitlBridgeConfig config;
+
+		std::unique_ptr<FUdpSocket> socket;
+
+		std::unique_ptr<FSharedMemoryRegion> region;
+
+		FSitlSensorPacket sensor_packet;
+
+		FSitlMotorPacket motor_packet;
+
+		std::uint32_t last_sequence = 0;
+
+		// Sensor packets received so far, shared memory only
+		std::uint64_t received_count = 0;
+	};
+}
+
+namespace physics::sitl
+{
+	/**
+	 * Fills the sensors, IMU included, from the state of the body. The sequence is left to FSitlBridge::exchange.
+	 * @param linear_acceleration_world In m/s², the body doesn't hold its acceleration
+	 * @param is_armed Sent on the arm switch channel
+	 */
+	DRONESIMULATORPHYSICS_API void fill_sensor_packet(FSitlSensorPacket& packet, const FSubstepBody& substep_body,
+		const FVector3& linear_acceleration_world, const FDronePlayerInput& player_input, bool is_armed, double simulation_time);
+
+	// -1..1 to 1000..2000 microseconds
+	DRONESIMULATORPHYSICS_API std::uint16_t to_rc_pulse_width(double value);
+
+	/**
+	 * Throttle of the rotors of the frame, clamped to 0..1. Rotors without a motor in the packet are stopped.
+	 */
+	DRONESIMULATORPHYSICS_API FRotorSetThrottle get_rotor_throttle(const FSitlMotorPacket& packet, std::int32_t rotor_count);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+namespace physics
+{
+	/**
+	 * Throttle for each propeller. In [0..1] range
+	 */
+	struct FPropellerSetThrottle
+	{
+		double front_left = 0.0;
+
+		double front_right = 0.0;
+
+		double rear_left = 0.0;
+
+		double rear_right = 0.0;
+
+	public:
+
+		constexpr FPropellerSetThrottle() = default;
+
+		constexpr FPropellerSetThrottle(double in_front_left, double in_front_right, double in_rear_left, double in_rear_right)
+			: front_left(in_front_left), front_right(in_front_right), rear_left(in_rear_left), rear_right(in_rear_right)
+		{
+		}
+
+		static constexpr FPropellerSetThrottle from_real(double real)
+		{
+			return FPropellerSetThrottle(real, real, real, real);
+		}
+
+	public:
+
+		constexpr FPropellerSetThrottle operator+(const FPropellerSetThrottle& other) const
+		{
+			return FPropellerSetThrottle(front_left + other.front_left, front_right + other.front_right,
+				rear_left + other.rear_left, rear_right + other.rear_right);
+		}
+
+		constexpr FPropellerSetThrottle operator-(const FPropellerSetThrottle& other) const
+		{
+			return FPropellerSetThrottle(front_left - other.front_left, front_right - other.front_right,
+				rear_left - other.rear_left, rear_right - other.rear_right);
+		}
+
+		constexpr FPropellerSetThrottle operator*(double other) const
+		{
+			return FPropellerSetThrottle(front_left * other, front_right * other, rear_left * other, rear_right * other);
+		}
+	};
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+// Unreal defines the export macro of the module. Standalone (CMake) builds link the library statically.
+#ifndef DRONESIMULATORPHYSICS_API
+#define DRONESIMULATORPHYSICS_API
+#endif
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace physics
+{
+	class FVectorizedEnvironment;
+	class FSharedMemoryRegion;
+
+	/**
+	 * Protocol to drive a FVectorizedEnvironment from another process on the same machine, without copies.
+	 *
+	 * The region starts with FSharedEnvironmentHeader, followed by slot_count slots of slot_size bytes. Request number
+	 * N (starting at 0) uses the slot N % slot_count. A slot holds, at the offsets given by the header:
+	 * - the command (ESharedEnvironmentCommand, uint32)
+	 * - the actions, float[action_count * num_envs], written by the client
+	 * - the observations, float[observation_count * num_envs], written by the server
+	 * - the rewards, float[num_envs], written by the server
+	 * - the dones, uint8[num_envs], written by the server
+	 *
+	 * The client fills the slot, then publishes it by incrementing submitted_count (release). The server steps the
+	 * environment straight into the slot, then increments completed_count (release). The client can have up to
+	 * slot_count requests in flight. The buffers use the layout of EEnvironmentAction and EEnvironmentObservation.
+	 */
+	enum class ESharedEnvironmentCommand : std::uint32_t
+	{
+		step = 0,
+		reset_all = 1,
+	};
+
+	struct FSharedEnvironmentHeader
+	{
+		static constexpr std::uint32_t expected_magic = 0x56455344; // "DSEV"
+		static constexpr std::uint32_t expected_version = 1;
+
+		// Written last by the server (release), read first by the client (acquire)
+		std::atomic<std::uint32_t> magic;
+		std::uint32_t version = 0;
+		std::int32_t num_envs = 0;
+		std::int32_t action_count = 0;
+		std::int32_t observation_count = 0;
+		std::int32_t slot_count = 0;
+
+		// All in bytes. Offsets are relative to the start of a slot, and the first slot starts at slots_offset.
+		std::uint64_t slots_offset = 0;
+		std::uint64_t slot_size = 0;
+		std::uint64_t actions_offset = 0;
+		std::uint64_t observations_offset = 0;
+		std::uint64_t rewards_offset = 0;
+		std::uint64_t dones_offset = 0;
+
+		// Each counter is on its own cache line, as each one is written by a single process
+		alignas(64) std::atomic<std::uint64_t> submitted_count;
+		alignas(64) std::atomic<std::uint64_t> completed_count;
+	};
+
+	static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+		"The counters and the magic must be usable across processes");
+
+	struct FSharedEnvironmentSlot
+	{
+		std::uint32_t* command = nullptr;
+		float* actions = nullptr;
+		float* observations = nullptr;
+		float* rewards = nullptr;
+		std::uint8_t* dones = nullptr;
+	};
+
+	/**
+	 * Owns the shared memory region, and answers the requests of the client with the environment.
+	 */
+	class DRONESIMULATORPHYSICS_API FSharedMemoryEnvironmentServer
+	{
+	public:
+
+		explicit FSharedMemoryEnvironmentServer(FVectorizedEnvironment& in_environment);
+
+		~FSharedMemoryEnvironmentServer();
+
+		/**
+		 * Creates the named region, replacing any region left over with the same name.
+		 * @return false if the region could not be created, or slot_count isn't positive
+		 */
+		bool create(const std::string& name, std::int32_t slot_count = 2);
+
+		/**
+		 * Runs all the submitted requests.
+		 * @return The number of requests that were run
+		 */
+		std::int32_t poll();
+
+		/**
+		 * Polls until should_stop is set, yielding the thread while there is nothing to do.
+		 */
+		void serve(const std::atomic<bool>& should_stop);
+
+	private:
+
+		FVectorizedEnvironment& environment;
+
+		std::unique_ptr<FSharedMemoryRegion> region;
+	};
+
+	/**
+	 * Client side of the protocol, for C++ programs. Other languages map the same layout.
+	 */
+	class DRONESIMULATORPHYSICS_API FSharedMemoryEnvironmentClient
+	{
+	public:
+
+		FSharedMemoryEnvironmentClient();
+
+		~FSharedMemoryEnvironmentClient();
+
+		/**
+		 * @return false if the region doesn't exist, has an unexpected layout, or is smaller than its layout
+		 */
+		bool open(const std::string& name);
+
+		const FSharedEnvironmentHeader& get_header() const;
+
+		/**
+		 * Slot of the next request. Wait for the request slot_count requests before it before writing the actions.
+		 */
+		FSharedEnvironmentSlot get_next_slot() const;
+
+		/**
+		 * Publishes the next slot to the server.
+		 * @return The sequence number of the request
+		 */
+		std::uint64_t submit(ESharedEnvironmentCommand command);
+
+		// Spins until the request is completed, after which its slot can be read
+		void wait(std::uint64_t sequence) const;
+
+		FSharedEnvironmentSlot get_slot(std::uint64_t sequence) const;
+
+	private:
+
+		std::unique_ptr<FSharedMemoryRegion> region;
+	};
+}
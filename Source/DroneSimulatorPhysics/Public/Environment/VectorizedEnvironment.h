@@ -0,0 +1,155 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace physics
+{
+	class FWorkerPool;
+
+	/**
+	 * Rows of the action buffer. Actions are stored as structure of arrays: actions[field * num_envs + env_index].
+	 */
+	enum class EEnvironmentAction : std::int32_t
+	{
+		throttle,
+		yaw,
+		pitch,
+		roll,
+
+		count,
+	};
+
+	/**
+	 * Rows of the observation buffer, stored like the actions: observations[field * num_envs + env_index].
+	 * Location is in meters relative to the spawn location, velocities in m/s and rad/s, rotation is a quaternion.
+	 */
+	enum class EEnvironmentObservation : std::int32_t
+	{
+		location_x,
+		location_y,
+		location_z,
+		rotation_x,
+		rotation_y,
+		rotation_z,
+		rotation_w,
+		linear_velocity_x,
+		linear_velocity_y,
+		linear_velocity_z,
+		angular_velocity_x,
+		angular_velocity_y,
+		angular_velocity_z,
+
+		count,
+	};
+
+	constexpr std::int32_t environment_action_count = static_cast<std::int32_t>(EEnvironmentAction::count);
+	constexpr std::int32_t environment_observation_count = static_cast<std::int32_t>(EEnvironmentObservation::count);
+
+	struct FVectorizedEnvironmentConfig
+	{
+		// Drone every environment starts from. Its body is used as the reset state when there is no reset snapshot.
+		FDroneSimulation drone;
+
+		// Duration of one step, during which the action is held. The drone runs drone.tick_rate_hz substeps per second.
+		double step_duration = 1.0 / 50.0;
+
+		// An episode ends after this many steps
+		std::int32_t max_episode_steps = 1000;
+
+		// An episode also ends when the drone goes below this altitude, in unreal units
+		double min_altitude = 0.0;
+
+		// Reward of one step, called after the step, from the worker threads. Defaults to staying at the spawn location.
+		std::function<float(const FDroneSimulation& drone, const FVector3& spawn_location)> reward_function;
+	};
+
+	/**
+	 * Many independent drone simulations, stepped together on worker threads, for reinforcement learning.
+	 *
+	 * Inputs and outputs are flat structure-of-arrays buffers (see EEnvironmentAction and EEnvironmentObservation), so
+	 * they can live in memory shared with the training process. Environments whose episode ends are reset right away,
+	 * and the observation returned for them is the first observation of the new episode.
+	 */
+	class DRONESIMULATORPHYSICS_API FVectorizedEnvironment
+	{
+	public:
+
+		/**
+		 * @param num_threads Number of threads stepping the environments, including the calling thread. 0 to use all cores.
+		 */
+		FVectorizedEnvironment(FVectorizedEnvironmentConfig in_config, std::int32_t in_num_envs, std::int32_t num_threads = 0);
+
+		~FVectorizedEnvironment();
+
+		FVectorizedEnvironment(const FVectorizedEnvironment&) = delete;
+		FVectorizedEnvironment& operator=(const FVectorizedEnvironment&) = delete;
+
+		std::int32_t get_num_envs() const { return this->num_envs; }
+
+		/**
+		 * Steps every environment with its action.
+		 * @param actions environment_action_count * num_envs values
+		 * @param observations Written, environment_observation_count * num_envs values
+		 * @param rewards Written, num_envs values
+		 * @param dones Written, num_envs values, 1 if the episode ended during this step
+		 */
+		void step(const float* actions, float* observations, float* rewards, std::uint8_t* dones);
+
+		/**
+		 * Resets every environment, and writes their first observation.
+		 */
+		void reset_all(float* observations);
+
+		/**
+		 * Resets one environment. The reset snapshots are used in turn, or the initial drone if there are none.
+		 */
+		void reset(std::int32_t env_index);
+
+		/**
+		 * Resets one environment to a saved drone, for example a state captured in the middle of a flight.
+		 */
+		void reset_from_snapshot(std::int32_t env_index, const FDroneSimulation& snapshot);
+
+		/**
+		 * Drones used to reset the environments, in turn. Copying a drone is all a reset costs.
+		 */
+		void set_reset_snapshots(std::vector<FDroneSimulation> snapshots);
+
+		const FDroneSimulation& get_drone(std::int32_t env_index) const { return this->drones[env_index]; }
+
+		std::int32_t get_episode_step(std::int32_t env_index) const { return this->episode_steps[env_index]; }
+
+		void write_observations(float* observations) const;
+
+		// Drones that are asleep, see FSleepConfig
+		std::int32_t count_asleep() const;
+
+	private:
+
+		void step_range(std::int32_t begin, std::int32_t end, const float* actions, float* observations, float* rewards,
+			std::uint8_t* dones);
+
+		void write_observation(std::int32_t env_index, float* observations) const;
+
+		FVectorizedEnvironmentConfig config;
+
+		std::int32_t num_envs = 0;
+
+		std::vector<FDroneSimulation> drones;
+
+		std::vector<std::int32_t> episode_steps;
+
+		std::vector<FDroneSimulation> reset_snapshots;
+
+		// Next reset snapshot, per environment, so that resets don't depend on the order in which threads run
+		std::vector<std::uint32_t> reset_counters;
+
+		std::unique_ptr<FWorkerPool> worker_pool;
+	};
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace physics::math
+{
+	constexpr double pi = 3.141592653589793238462643383279502884;
+	constexpr double two_pi = 2.0 * pi;
+
+	constexpr double degrees_to_radians(double degrees)
+	{
+		return degrees * (pi / 180.0);
+	}
+
+	constexpr double radians_to_degrees(double radians)
+	{
+		return radians * (180.0 / pi);
+	}
+
+	constexpr double rpm_to_rad_per_sec(double rpm)
+	{
+		return rpm * (two_pi / 60.0);
+	}
+
+	constexpr double square(double value)
+	{
+		return value * value;
+	}
+
+	constexpr double clamp(double value, double min_value, double max_value)
+	{
+		return value < min_value ? min_value : (value > max_value ? max_value : value);
+	}
+
+	constexpr double lerp(double a, double b, double alpha)
+	{
+		return a + alpha * (b - a);
+	}
+
+	inline double min4(double a, double b, double c, double d)
+	{
+		return std::min(std::min(a, b), std::min(c, d));
+	}
+
+	inline double max4(double a, double b, double c, double d)
+	{
+		return std::max(std::max(a, b), std::max(c, d));
+	}
+
+	// Same rounding as FMath::RoundToInt32, halves are rounded up
+	inline int round_to_int(double value)
+	{
+		return static_cast<int>(std::floor(value + 0.5));
+	}
+
+	/** Wraps an angle in degrees to the ]-180, 180] range */
+	inline double normalize_axis_degrees(double angle_degrees)
+	{
+		double angle = std::fmod(angle_degrees, 360.0);
+		if (angle < 0.0)
+		{
+			angle += 360.0;
+		}
+		if (angle > 180.0)
+		{
+			angle -= 360.0;
+		}
+		return angle;
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+namespace physics
+{
+	/**
+	 * Euler angles in degrees, with the same conventions as Unreal's FRotator.
+	 */
+	struct FRotation
+	{
+		double Pitch = 0.0;
+		double Yaw = 0.0;
+		double Roll = 0.0;
+
+		constexpr FRotation() = default;
+
+		constexpr FRotation(double in_pitch, double in_yaw, double in_roll)
+			: Pitch(in_pitch), Yaw(in_yaw), Roll(in_roll)
+		{
+		}
+	};
+
+	/**
+	 * Rotation quaternion, with the same conventions as Unreal's FQuat.
+	 * a * b is the rotation b, followed by the rotation a.
+	 */
+	struct DRONESIMULATORPHYSICS_API FQuaternion
+	{
+		double X = 0.0;
+		double Y = 0.0;
+		double Z = 0.0;
+		double W = 1.0;
+
+		constexpr FQuaternion() = default;
+
+		constexpr FQuaternion(double in_x, double in_y, double in_z, double in_w)
+			: X(in_x), Y(in_y), Z(in_z), W(in_w)
+		{
+		}
+
+		static constexpr FQuaternion identity() { return FQuaternion(0.0, 0.0, 0.0, 1.0); }
+
+		/**
+		 * @param axis Unit vector
+		 * @param angle_radians Rotation around the axis, in radians
+		 */
+		static FQuaternion from_axis_angle(const FVector3& axis, double angle_radians);
+
+		static FQuaternion from_rotation(const FRotation& rotation);
+
+		FRotation to_rotation() const;
+
+	public:
+
+		constexpr FQuaternion operator*(const FQuaternion& other) const
+		{
+			return FQuaternion(
+				W * other.X + X * other.W + Y * other.Z - Z * other.Y,
+				W * other.Y - X * other.Z + Y * other.W + Z * other.X,
+				W * other.Z + X * other.Y - Y * other.X + Z * other.W,
+				W * other.W - X * other.X - Y * other.Y - Z * other.Z
+			);
+		}
+
+		constexpr bool operator==(const FQuaternion& other) const
+		{
+			return X == other.X && Y == other.Y && Z == other.Z && W == other.W;
+		}
+
+		constexpr FQuaternion inverse() const
+		{
+			return FQuaternion(-X, -Y, -Z, W);
+		}
+
+		FQuaternion get_normalized() const;
+
+		/**
+		 * Spherical interpolation along the shortest path, at constant angular speed. Same as FQuat::Slerp.
+		 * @param alpha 0 gives a, 1 gives b
+		 */
+		static FQuaternion slerp(const FQuaternion& a, const FQuaternion& b, double alpha);
+
+		constexpr FVector3 rotate_vector(const FVector3& vector) const
+		{
+			const FVector3 q(X, Y, Z);
+			const FVector3 t = q.cross(vector) * 2.0;
+			return vector + (t * W) + q.cross(t);
+		}
+
+		constexpr FVector3 unrotate_vector(const FVector3& vector) const
+		{
+			const FVector3 q(-X, -Y, -Z);
+			const FVector3 t = q.cross(vector) * 2.0;
+			return vector + (t * W) + q.cross(t);
+		}
+
+		constexpr FVector3 get_axis_x() const { return rotate_vector(FVector3::forward()); }
+		constexpr FVector3 get_axis_y() const { return rotate_vector(FVector3::right()); }
+		constexpr FVector3 get_axis_z() const { return rotate_vector(FVector3::up()); }
+	};
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace physics::random
+{
+	/**
+	 * Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", 2011). Counter-based: the output
+	 * is a pure function of the counter and the key, so any number of a stream can be drawn on any thread, in any order.
+	 */
+	DRONESIMULATORPHYSICS_API std::array<std::uint32_t, 4> philox4x32(const std::array<std::uint32_t, 4>& counter,
+		const std::array<std::uint32_t, 2>& key);
+
+	/**
+	 * Standard normal numbers first_index to first_index + out_numbers.size() - 1 of a stream. A number only depends on
+	 * the key, the stream and its index, not on how the numbers are split into calls. The counters are drawn in blocks
+	 * that the compiler vectorizes, then turned into normals with Box-Muller, four numbers per counter.
+	 */
+	DRONESIMULATORPHYSICS_API void fill_normal(std::uint64_t key, std::uint64_t stream, std::uint64_t first_index,
+		std::span<double> out_numbers);
+}
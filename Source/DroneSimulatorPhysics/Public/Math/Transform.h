@@ -0,0 +1,44 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/Math/Quaternion.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+namespace physics
+{
+	/**
+	 * Rotation and translation, without scale. Equivalent to an FTransform with a unit scale.
+	 */
+	struct FRigidTransform
+	{
+		FQuaternion rotation = FQuaternion::identity();
+
+		FVector3 location = FVector3::zero();
+
+		constexpr FRigidTransform() = default;
+
+		constexpr FRigidTransform(const FQuaternion& in_rotation, const FVector3& in_location)
+			: rotation(in_rotation), location(in_location)
+		{
+		}
+
+		constexpr FVector3 transform_position(const FVector3& position_local) const
+		{
+			return rotation.rotate_vector(position_local) + location;
+		}
+
+		constexpr FVector3 transform_vector(const FVector3& vector_local) const
+		{
+			return rotation.rotate_vector(vector_local);
+		}
+
+		constexpr FVector3 inverse_transform_vector(const FVector3& vector_world) const
+		{
+			return rotation.unrotate_vector(vector_world);
+		}
+
+		constexpr FVector3 get_unit_axis_z() const
+		{
+			return rotation.get_axis_z();
+		}
+	};
+}
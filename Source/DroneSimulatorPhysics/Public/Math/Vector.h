@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cmath>
+
+namespace physics
+{
+	/**
+	 * Double precision 3D vector, with Unreal's axis conventions: X is forward, Y is right, Z is up.
+	 * Unit depends on the usage, and is documented where the vector is stored.
+	 */
+	struct FVector3
+	{
+		double X = 0.0;
+		double Y = 0.0;
+		double Z = 0.0;
+
+		constexpr FVector3() = default;
+
+		constexpr FVector3(double in_x, double in_y, double in_z)
+			: X(in_x), Y(in_y), Z(in_z)
+		{
+		}
+
+		static constexpr FVector3 zero() { return FVector3(0.0, 0.0, 0.0); }
+		static constexpr FVector3 one() { return FVector3(1.0, 1.0, 1.0); }
+		static constexpr FVector3 forward() { return FVector3(1.0, 0.0, 0.0); }
+		static constexpr FVector3 right() { return FVector3(0.0, 1.0, 0.0); }
+		static constexpr FVector3 up() { return FVector3(0.0, 0.0, 1.0); }
+
+	public:
+
+		constexpr FVector3 operator+(const FVector3& other) const { return FVector3(X + other.X, Y + other.Y, Z + other.Z); }
+		constexpr FVector3 operator-(const FVector3& other) const { return FVector3(X - other.X, Y - other.Y, Z - other.Z); }
+		constexpr FVector3 operator-() const { return FVector3(-X, -Y, -Z); }
+
+		// Component-wise
+		constexpr FVector3 operator*(const FVector3& other) const { return FVector3(X * other.X, Y * other.Y, Z * other.Z); }
+		constexpr FVector3 operator/(const FVector3& other) const { return FVector3(X / other.X, Y / other.Y, Z / other.Z); }
+
+		constexpr FVector3 operator*(double scale) const { return FVector3(X * scale, Y * scale, Z * scale); }
+		constexpr FVector3 operator/(double scale) const { return FVector3(X / scale, Y / scale, Z / scale); }
+
+		constexpr FVector3& operator+=(const FVector3& other) { X += other.X; Y += other.Y; Z += other.Z; return *this; }
+		constexpr FVector3& operator-=(const FVector3& other) { X -= other.X; Y -= other.Y; Z -= other.Z; return *this; }
+		constexpr FVector3& operator*=(double scale) { X *= scale; Y *= scale; Z *= scale; return *this; }
+
+		constexpr bool operator==(const FVector3& other) const { return X == other.X && Y == other.Y && Z == other.Z; }
+		constexpr bool operator!=(const FVector3& other) const { return !(*this == other); }
+
+	public:
+
+		constexpr double dot(const FVector3& other) const
+		{
+			return X * other.X + Y * other.Y + Z * other.Z;
+		}
+
+		constexpr FVector3 cross(const FVector3& other) const
+		{
+			return FVector3(
+				Y * other.Z - Z * other.Y,
+				Z * other.X - X * other.Z,
+				X * other.Y - Y * other.X
+			);
+		}
+
+		constexpr double size_squared() const { return X * X + Y * Y + Z * Z; }
+		double size() const { return std::sqrt(size_squared()); }
+		double size_2d() const { return std::sqrt(X * X + Y * Y); }
+
+		FVector3 get_abs() const { return FVector3(std::abs(X), std::abs(Y), std::abs(Z)); }
+
+		// Same semantics as FVector::GetSafeNormal
+		FVector3 get_safe_normal(double tolerance = 1e-8) const
+		{
+			const double square_sum = size_squared();
+			if (square_sum == 1.0)
+			{
+				return *this;
+			}
+			if (square_sum < tolerance)
+			{
+				return zero();
+			}
+			return *this * (1.0 / std::sqrt(square_sum));
+		}
+
+		// Same semantics as FVector::GetClampedToMaxSize
+		FVector3 get_clamped_to_max_size(double max_size) const
+		{
+			if (max_size < 1e-4)
+			{
+				return zero();
+			}
+
+			const double square_size = size_squared();
+			if (square_size > max_size * max_size)
+			{
+				return *this * (max_size / std::sqrt(square_size));
+			}
+			return *this;
+		}
+
+		// Same semantics as FVector::BoundToCube
+		FVector3 bound_to_cube(double radius) const
+		{
+			const auto bound = [radius](double value)
+			{
+				return value < -radius ? -radius : (value > radius ? radius : value);
+			};
+			return FVector3(bound(X), bound(Y), bound(Z));
+		}
+	};
+
+	constexpr FVector3 operator*(double scale, const FVector3& vector)
+	{
+		return vector * scale;
+	}
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/DroneController.h"
+#include "DroneSimulatorPhysics/Public/Controller/Mixer.h"
+#include "DroneSimulatorPhysics/Public/RotorModel/Bemt/PropellerThrust.h"
+#include "DroneSimulatorPhysics/Public/RotorModel/RotorModel.h"
+#include "DroneSimulatorPhysics/Public/Simulation/LogDebug.h"
+#include "DroneSimulatorPhysics/Public/Simulation/MultiRateSchedule.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace physics
+{
+	struct FDroneSetpoint;
+	struct FSimulationWorld;
+	struct FSubstepBody;
+
+	struct FDynamicsPropellerInfo
+	{
+		// In rad/s
+		double angular_speed = 0.0;
+
+		// In N
+		double thrust = 0.0;
+
+		// In N/m
+		double torque = 0.0;
+
+		// In radians
+		double angle_of_attack = 0.0;
+
+		// No unit
+		std::vector<double> reynolds = {};
+
+		// 0..1
+		double throttle = 0.0;
+
+		// m/s
+		double velocity_axial = 0.0;
+
+		// m/s
+		double velocity_induced = 0.0;
+
+		FDebugLog debug_log;
+
+		FDynamicsPropellerInfo() = default;
+
+		FDynamicsPropellerInfo(const FPropellerSimInfo& sim_info, const FDebugLog& in_debug_log, double in_throttle)
+			: angular_speed(sim_info.angular_speed)
+			, thrust(sim_info.thrust)
+			, torque(sim_info.torque)
+			, angle_of_attack(sim_info.angle_of_attack)
+			, reynolds(sim_info.reynolds)
+			, throttle(in_throttle)
+			, velocity_axial(sim_info.v_axial)
+			, velocity_induced(sim_info.v_induced)
+			, debug_log(in_debug_log)
+		{}
+	};
+
+	/**
+	 * Info for each propeller
+	 */
+	struct FDynamicsPropellerSetInfo
+	{
+		FDynamicsPropellerInfo front_left;
+
+		FDynamicsPropellerInfo front_right;
+
+		FDynamicsPropellerInfo rear_left;
+
+		FDynamicsPropellerInfo rear_right;
+
+		// In the quad X order of FRotorSetThrottle::to_propeller_set
+		FDynamicsPropellerInfo& get(std::int32_t rotor_index)
+		{
+			FDynamicsPropellerInfo* propellers[] = { &front_left, &front_right, &rear_left, &rear_right };
+			return *propellers[rotor_index];
+		}
+	};
+
+	/**
+	 * Location of each propeller relative to the frame, in unreal units
+	 */
+	struct FPropellerSetLocations
+	{
+		FVector3 front_left;
+		FVector3 front_right;
+		FVector3 rear_left;
+		FVector3 rear_right;
+	};
+
+	struct FPropulsionDroneSetup
+	{
+		const FDroneFrame* frame = nullptr;
+		const FDroneMotor* motor = nullptr;
+		const FDroneBattery* battery = nullptr;
+		const FDronePropeller* propeller = nullptr;
+
+		// Compiled once by FDroneModel. The dynamics propulsion doesn't run without them.
+		const std::vector<FRotorDescription>* rotors = nullptr;
+		const FMixerMatrix* mixer = nullptr;
+	};
+
+	/**
+	 * Outputs of the controller and of the rotor aerodynamics, held between two runs of these stages, see
+	 * FMultiRateSchedule.
+	 */
+	struct FPropulsionHeldOutputs
+	{
+		FRotorSetThrottle throttle;
+
+		// In N, thrust of each rotor divided by its throttle squared at the last aerodynamics update
+		std::array<double, max_rotor_count> thrust_per_throttle_squared = {};
+
+		// In N·m, same for the torque
+		std::array<double, max_rotor_count> torque_per_throttle_squared = {};
+	};
+
+	/** Controller driving a rotor model for each propeller */
+	struct FPropulsionModelDynamics
+	{
+		FDroneController controller;
+
+		FRotorModel rotor_model;
+
+		FPropulsionHeldOutputs held_outputs;
+	};
+
+	/** Applies the setpoint directly to the body, without simulating the propellers */
+	struct FPropulsionModelDirectSetpoint
+	{
+		double max_throttle_force = 50.0;
+
+		// In m/s
+		double max_vertical_speed = 30.0;
+	};
+
+	using FPropulsionModel = std::variant<FPropulsionModelDynamics, FPropulsionModelDirectSetpoint>;
+}
+
+namespace physics::propulsion
+{
+	// Extents are distances; signs are normalized so front is +X and back is -X
+	DRONESIMULATORPHYSICS_API FPropellerSetLocations compute_propeller_locations(const FDroneFrame& frame);
+
+	// The rotors of the frame, or a quad X at the props extents if it has none
+	DRONESIMULATORPHYSICS_API std::vector<FRotorDescription> compute_rotors(const FDroneFrame& frame);
+
+	/**
+	 * @param stages The controller and the rotor aerodynamics only run when their stage does, see FMultiRateSchedule
+	 * @param gyro_angular_velocity Filtered gyro the controller flies on, in rad/s around the local axes. Null to read
+	 * the angular velocity of the body.
+	 */
+	DRONESIMULATORPHYSICS_API std::optional<FDynamicsPropellerSetInfo> tick_dynamics(FPropulsionModelDynamics& propulsion_model,
+		FSubstepBody* substep_body, const FDroneSetpoint& drone_setpoint, const FPropulsionDroneSetup& drone_setup,
+		const FSimulationWorld* simulation_world, const FSubstepStages& stages, const FVector3* gyro_angular_velocity = nullptr);
+
+	// The gyro if there is one, the angular velocity of the body around its local axes otherwise
+	DRONESIMULATORPHYSICS_API FVector3 get_component_angular_velocity(const FSubstepBody& substep_body,
+		const FVector3* gyro_angular_velocity);
+
+	// Keeps the thrust and torque of a rotor after an aerodynamics update, relative to its throttle squared
+	DRONESIMULATORPHYSICS_API void hold_rotor_output(FPropulsionHeldOutputs& held_outputs, std::int32_t rotor_index,
+		double throttle, const FThrustSimValue& value);
+
+	// Between two aerodynamics updates, applies the held thrust and torque of a rotor at its current throttle
+	DRONESIMULATORPHYSICS_API void apply_held_rotor_output(const FPropulsionHeldOutputs& held_outputs, FSubstepBody* substep_body,
+		const FRotorDescription& rotor, std::int32_t rotor_index, double throttle);
+
+	// Info of a rotor spinning at its throttle, with the thrust and torque it gets from the held outputs
+	DRONESIMULATORPHYSICS_API FDynamicsPropellerInfo get_held_rotor_info(const FPropulsionHeldOutputs& held_outputs,
+		const FPropulsionDroneSetup& drone_setup, std::int32_t rotor_index, double throttle);
+
+	/**
+	 * Substep of a controller driving a rotor model: the controller on its stage, then each rotor, simulated on its stage
+	 * and applied from the held outputs otherwise. tick_dynamics and the editable propulsion model of the engine both
+	 * run it, with their own controller and rotor model.
+	 * @return The info of each propeller on a quad, nothing on other frames
+	 * @param tick_controller (double delta_time, const FVector3& component_angular_velocity, const FMixerMatrix& mixer) -> FRotorSetThrottle
+	 * @param simulate_rotor (double throttle, const FRotorDescription& rotor) -> FRotorSimulationResult
+	 */
+	template <typename FTickController, typename FSimulateRotor>
+	std::optional<FDynamicsPropellerSetInfo> tick_rotors(FPropulsionHeldOutputs& held_outputs, FSubstepBody* substep_body,
+		const FPropulsionDroneSetup& drone_setup, const FSubstepStages& stages, const FVector3* gyro_angular_velocity,
+		FTickController&& tick_controller, FSimulateRotor&& simulate_rotor)
+	{
+		if (drone_setup.rotors == nullptr || drone_setup.mixer == nullptr)
+		{
+			return {};
+		}
+
+		if (stages.controller)
+		{
+			held_outputs.throttle = tick_controller(stages.controller_delta_time,
+				get_component_angular_velocity(*substep_body, gyro_angular_velocity), *drone_setup.mixer);
+		}
+
+		const auto& rotor_set_throttle = held_outputs.throttle;
+
+		std::optional<FDynamicsPropellerSetInfo> propeller_set_info;
+		if (rotor_set_throttle.count == 4)
+		{
+			propeller_set_info.emplace();
+		}
+
+		for (std::int32_t rotor_index = 0; rotor_index < rotor_set_throttle.count; rotor_index++)
+		{
+			const auto throttle = rotor_set_throttle.values[rotor_index];
+			const auto& rotor = (*drone_setup.rotors)[rotor_index];
+
+			FDebugLog debug_log;
+			if (stages.rotor_aerodynamics)
+			{
+				auto result = simulate_rotor(throttle, rotor);
+				hold_rotor_output(held_outputs, rotor_index, throttle, result.value);
+				debug_log = std::move(result.debug_log);
+			}
+			else
+			{
+				apply_held_rotor_output(held_outputs, substep_body, rotor, rotor_index, throttle);
+			}
+
+			if (propeller_set_info.has_value())
+			{
+				auto& propeller_info = propeller_set_info->get(rotor_index);
+				propeller_info = get_held_rotor_info(held_outputs, drone_setup, rotor_index, throttle);
+				propeller_info.debug_log = std::move(debug_log);
+			}
+		}
+
+		return propeller_set_info;
+	}
+
+	DRONESIMULATORPHYSICS_API std::optional<FDynamicsPropellerSetInfo> tick_direct_setpoint(
+		const FPropulsionModelDirectSetpoint& propulsion_model, FSubstepBody* substep_body,
+		const FDroneSetpoint& drone_setpoint);
+
+	DRONESIMULATORPHYSICS_API std::optional<FDynamicsPropellerSetInfo> tick_propulsion(FPropulsionModel& propulsion_model,
+		FSubstepBody* substep_body, const FDroneSetpoint& drone_setpoint, const FPropulsionDroneSetup& drone_setup,
+		const FSimulationWorld* simulation_world, const FSubstepStages& stages, const FVector3* gyro_angular_velocity = nullptr);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Simulation/TelemetrySample.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace physics::flight_record_codec
+{
+	/**
+	 * Encodes consecutive samples of one drone column by column, losslessly, into one bit stream:
+	 * - the time as delta-of-delta of its bit pattern, with Gorilla-style variable-length buckets. Evenly spaced
+	 *   samples take a bit each.
+	 * - the world time offset and the location floats with Gorilla XOR against the previous value
+	 * - every quantized channel bit packed, as deltas or deltas of deltas, whichever is narrower over the block, offset
+	 *   from the smallest one. Constant channels and steady ramps take no bits at all.
+	 *
+	 * A block doesn't depend on any other one. An entropy coder can run on top, see FFlightRecordEntropyCoder.
+	 */
+	DRONESIMULATORPHYSICS_API void encode_block(std::span<const FTelemetrySample> samples, std::vector<std::uint8_t>& out_bytes);
+
+	/**
+	 * @param out_samples Sized to the number of samples of the block
+	 * @return false if the bytes are not a block of that many samples
+	 */
+	DRONESIMULATORPHYSICS_API bool decode_block(std::span<const std::uint8_t> bytes, std::span<FTelemetrySample> out_samples);
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Simulation/TelemetrySample.h"
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace physics
+{
+	/**
+	 * A streamed flight record is a small index file, <name>.frindex, next to chunk files <name>.<chunk number>.frchunk.
+	 * Each chunk holds consecutive samples of one stream (one drone), and is written once, whole. The index lists the
+	 * streams and the chunks written so far: it is replaced after every chunk, so a crash loses the chunks that were not
+	 * written yet, never the record.
+	 *
+	 * A chunk is a header, a table of FFlightRecordBlockInfo, then the blocks: runs of samples encoded by
+	 * flight_record_codec::encode_block, and optionally compressed by an FFlightRecordEntropyCoder. Each block decodes on
+	 * its own, so a reader can seek to a time without decoding the whole chunk.
+	 *
+	 * All the values are little endian.
+	 */
+	struct FFlightRecordChunkHeader
+	{
+		static constexpr std::uint32_t expected_magic = 0x43465344; // "DSFC"
+		static constexpr std::uint32_t expected_version = 3;
+
+		std::uint32_t magic = expected_magic;
+		std::uint32_t version = expected_version;
+		std::uint32_t stream_index = 0;
+		std::uint32_t sample_count = 0;
+
+		// In seconds, times of the first and last sample
+		double first_time = 0.0;
+		double last_time = 0.0;
+
+		std::uint32_t block_count = 0;
+
+		std::uint32_t reserved = 0;
+	};
+
+	struct FFlightRecordBlockInfo
+	{
+		double first_time = 0.0;
+		double last_time = 0.0;
+
+		// From the start of the chunk file
+		std::uint64_t offset = 0;
+
+		std::uint32_t sample_count = 0;
+
+		// Size in the file, and size once the entropy coder is undone
+		std::uint32_t stored_size = 0;
+		std::uint32_t encoded_size = 0;
+
+		// FFlightRecordEntropyCoder::id, 0 if stored as encoded
+		std::uint8_t entropy_coder = 0;
+
+		std::uint8_t reserved[3] = {};
+	};
+
+	/**
+	 * A general purpose compressor run on top of the encoded blocks, the engine's Oodle for example. The id is written
+	 * in the blocks it compressed, and reading them needs a coder with the same id.
+	 */
+	struct FFlightRecordEntropyCoder
+	{
+		// Not 0, that is blocks stored as encoded
+		std::uint8_t id = 0;
+
+		// @return false if the bytes could not be compressed, the block is then stored as encoded
+		std::function<bool(std::span<const std::uint8_t> bytes, std::vector<std::uint8_t>& out_compressed)> compress;
+
+		// @param out_bytes Sized to the encoded size
+		std::function<bool(std::span<const std::uint8_t> compressed, std::span<std::uint8_t> out_bytes)> decompress;
+	};
+
+	struct FFlightRecordChunkInfo
+	{
+		std::uint32_t stream_index = 0;
+
+		// Names the chunk file, see flight_record_file::get_chunk_path
+		std::uint32_t chunk_number = 0;
+
+		std::uint32_t sample_count = 0;
+
+		std::uint32_t reserved = 0;
+
+		double first_time = 0.0;
+		double last_time = 0.0;
+	};
+
+	struct FFlightRecordIndexHeader
+	{
+		static constexpr std::uint32_t expected_magic = 0x49465344; // "DSFI"
+		static constexpr std::uint32_t expected_version = 1;
+
+		std::uint32_t magic = expected_magic;
+		std::uint32_t version = expected_version;
+		std::uint32_t samples_per_chunk = 0;
+		std::uint32_t stream_count = 0;
+		std::uint32_t chunk_count = 0;
+
+		std::uint32_t reserved = 0;
+	};
+
+	/**
+	 * Contents of an index file. On disk, the header is followed by the stream names, each one a uint32 length and its
+	 * bytes, then by the chunk infos.
+	 */
+	struct FFlightRecordIndex
+	{
+		std::int32_t samples_per_chunk = 0;
+
+		std::vector<std::string> stream_names;
+
+		// In the order they were written. The chunks of a stream are in time order.
+		std::vector<FFlightRecordChunkInfo> chunks;
+	};
+}
+
+namespace physics::flight_record_file
+{
+	DRONESIMULATORPHYSICS_API std::string get_index_path(const std::string& directory, const std::string& name);
+
+	DRONESIMULATORPHYSICS_API std::string get_chunk_path(const std::string& index_path, std::uint32_t chunk_number);
+
+	// Writes to a temporary file first, then replaces the index with it
+	DRONESIMULATORPHYSICS_API bool write_index(const std::string& index_path, const FFlightRecordIndex& index);
+
+	// @return false if the file is missing, or isn't an index
+	DRONESIMULATORPHYSICS_API bool read_index(const std::string& index_path, FFlightRecordIndex& out_index);
+
+	// @param entropy_coder Optional, compresses the blocks it makes smaller
+	DRONESIMULATORPHYSICS_API bool write_chunk(const std::string& chunk_path, std::uint32_t stream_index,
+		std::span<const FTelemetrySample> samples, std::int32_t samples_per_block,
+		const FFlightRecordEntropyCoder* entropy_coder = nullptr);
+
+	/**
+	 * Checks the header and the block table of a chunk in memory, without decoding any block.
+	 * @return false if the bytes are truncated, or aren't a chunk
+	 */
+	DRONESIMULATORPHYSICS_API bool parse_chunk(std::span<const std::uint8_t> chunk_bytes, FFlightRecordChunkHeader& out_header,
+		std::vector<FFlightRecordBlockInfo>& out_blocks);
+
+	/**
+	 * Decodes one block of a chunk parsed by parse_chunk.
+	 * @param scratch Reused across calls, holds the block once the entropy coder is undone
+	 * @param out_samples Sized to the sample count of the block
+	 * @return false if the block is corrupted, or compressed by another coder
+	 */
+	DRONESIMULATORPHYSICS_API bool decode_block(std::span<const std::uint8_t> chunk_bytes, const FFlightRecordBlockInfo& block,
+		const FFlightRecordEntropyCoder* entropy_coder, std::vector<std::uint8_t>& scratch, std::span<FTelemetrySample> out_samples);
+
+	// @return false if the file is missing, truncated, corrupted, or isn't a chunk
+	DRONESIMULATORPHYSICS_API bool read_chunk(const std::string& chunk_path, FFlightRecordChunkHeader& out_header,
+		std::vector<FTelemetrySample>& out_samples, const FFlightRecordEntropyCoder* entropy_coder = nullptr);
+}
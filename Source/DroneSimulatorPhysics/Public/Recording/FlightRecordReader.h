@@ -0,0 +1,139 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordFile.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace physics
+{
+	class FMappedFile;
+
+	struct FFlightRecordReaderConfig
+	{
+		// Decoded blocks kept for the next reads, 128 KB each with the default 1024 samples per block
+		std::int32_t max_cached_blocks = 64;
+
+		// Chunk files kept mapped
+		std::int32_t max_mapped_chunks = 64;
+
+		// Needed for the blocks the writer compressed
+		std::optional<FFlightRecordEntropyCoder> entropy_coder;
+	};
+
+	/**
+	 * Random access to a streamed flight record, see FFlightRecordIndex, without loading it. Opening only reads the
+	 * index: the chunk files are memory mapped when a read first needs them, and only the blocks overlapping the read
+	 * time range are decoded. Memory is bounded by the caches of the config, however long the record is.
+	 *
+	 * Lookups are binary searches over the chunks, then the blocks, then the samples. Each stream remembers where its last
+	 * read started, so that sequential playback finds its block in constant time. Readers of a stream at another time,
+	 * like a trail around the playhead, pass their own FReadCursor so that they don't move the one of the playback.
+	 *
+	 * Not thread safe, reads update the caches.
+	 */
+	class DRONESIMULATORPHYSICS_API FFlightRecordReader
+	{
+	public:
+
+		// Where a read of a stream started, tried first by the next one. Only a hint, any value is valid.
+		struct FReadCursor
+		{
+			std::size_t chunk_index = 0;
+			std::size_t block_index = 0;
+		};
+
+		FFlightRecordReader();
+
+		~FFlightRecordReader();
+
+		FFlightRecordReader(const FFlightRecordReader&) = delete;
+		FFlightRecordReader& operator=(const FFlightRecordReader&) = delete;
+
+		// @return false if the index could not be read
+		bool open(const std::string& index_path, const FFlightRecordReaderConfig& in_config = {});
+
+		void close();
+
+		bool is_open() const { return this->is_index_read; }
+
+		const std::vector<std::string>& get_stream_names() const { return this->index.stream_names; }
+
+		std::int32_t get_stream_count() const { return static_cast<std::int32_t>(this->streams.size()); }
+
+		// From the index, without reading the chunks. 0 if there is no sample.
+		double get_first_time() const { return this->first_time; }
+		double get_last_time() const { return this->last_time; }
+
+		std::uint64_t get_sample_count(std::int32_t stream_index) const;
+
+		/**
+		 * Samples of a stream, in time order, from the last one at or before begin_time to the first one at or after
+		 * end_time, so that both ends can be interpolated. Past either end of the stream, starts or stops at its first or
+		 * last sample.
+		 * @return false if a chunk could not be read
+		 */
+		bool read_samples(std::int32_t stream_index, double begin_time, double end_time, std::vector<FTelemetrySample>& out_samples);
+
+		// Same, starting from the given cursor rather than from the one of the stream
+		bool read_samples(std::int32_t stream_index, double begin_time, double end_time, std::vector<FTelemetrySample>& out_samples,
+			FReadCursor& cursor);
+
+		/**
+		 * Times of the samples of all the streams between begin_time and end_time, to draw them. When there would be more
+		 * than max_count, max_count evenly spaced times where some stream has samples instead, without decoding anything.
+		 */
+		bool read_times(double begin_time, double end_time, std::int32_t max_count, std::vector<double>& out_times);
+
+	private:
+
+		struct FMappedChunk
+		{
+			std::unique_ptr<FMappedFile> file;
+			FFlightRecordChunkHeader header;
+			std::vector<FFlightRecordBlockInfo> blocks;
+			std::uint64_t last_use = 0;
+		};
+
+		struct FDecodedBlock
+		{
+			std::vector<FTelemetrySample> samples;
+			std::uint64_t last_use = 0;
+		};
+
+		// Chunk positions are indices in index.chunks
+		const FMappedChunk* map_chunk(std::int32_t chunk_position);
+
+		const std::vector<FTelemetrySample>* decode_block(std::int32_t chunk_position, std::int32_t block_index);
+
+		FFlightRecordReaderConfig config;
+
+		std::string index_path;
+
+		FFlightRecordIndex index;
+
+		bool is_index_read = false;
+
+		// Chunk positions of each stream, in time order
+		std::vector<std::vector<std::int32_t>> streams;
+
+		std::vector<FReadCursor> stream_cursors;
+
+		double first_time = 0.0;
+		double last_time = 0.0;
+
+		std::unordered_map<std::int32_t, FMappedChunk> mapped_chunks;
+
+		// By chunk position and block index
+		std::unordered_map<std::uint64_t, FDecodedBlock> decoded_blocks;
+
+		std::vector<std::uint8_t> decode_scratch;
+
+		std::uint64_t use_count = 0;
+	};
+}
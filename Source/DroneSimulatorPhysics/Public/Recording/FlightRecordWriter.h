@@ -0,0 +1,113 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Recording/FlightRecordFile.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace physics
+{
+	struct FFlightRecordWriterConfig
+	{
+		// 8192 samples is 1 MB, 20 s at 400 Hz
+		std::int32_t samples_per_chunk = 8192;
+
+		// The unit of random access when reading, 2.5 s at 400 Hz. Larger blocks compress a little better.
+		std::int32_t samples_per_block = 1024;
+
+		// Runs on the encoded blocks, on the writer thread
+		std::optional<FFlightRecordEntropyCoder> entropy_coder;
+
+		// Full chunks waiting for the writer thread. If the disk falls that far behind, append waits for it.
+		std::int32_t max_pending_chunks = 8;
+	};
+
+	/**
+	 * Streams a flight record to disk while flying, see FFlightRecordIndex for the files. The recording thread appends
+	 * the samples of each stream to its open chunk, and hands full chunks to a background thread that writes them, then
+	 * replaces the index. The writer thread also encodes the chunks, see FFlightRecordChunkHeader.
+	 *
+	 * Memory is bounded by the open chunks plus max_pending_chunks, the buffers are reused. Closing only writes what is
+	 * still open or pending, however long the session was.
+	 */
+	class DRONESIMULATORPHYSICS_API FFlightRecordWriter
+	{
+	public:
+
+		FFlightRecordWriter() = default;
+
+		~FFlightRecordWriter();
+
+		FFlightRecordWriter(const FFlightRecordWriter&) = delete;
+		FFlightRecordWriter& operator=(const FFlightRecordWriter&) = delete;
+
+		/**
+		 * Creates the directory if needed, writes an empty index, and starts the writer thread.
+		 * @return false if the index could not be written
+		 */
+		bool open(const std::string& directory, const std::string& name, const FFlightRecordWriterConfig& in_config = {});
+
+		bool is_open() const { return this->writer_thread.joinable(); }
+
+		// Recording thread. Adds a stream, a drone for example, and returns its index.
+		std::int32_t add_stream(const std::string& stream_name);
+
+		// Recording thread. Samples of one stream, in time order.
+		void append(std::int32_t stream_index, std::span<const FTelemetrySample> samples);
+
+		// Recording thread. Writes the open chunks, waits for the pending ones, and stops the writer thread.
+		void close();
+
+		const std::string& get_index_path() const { return this->index_path; }
+
+		// Paths of the chunks written so far
+		std::vector<std::string> get_chunk_paths() const;
+
+		// Whether a chunk or the index could not be written. The writer keeps going with the next chunks.
+		bool has_failed() const { return this->has_write_failed.load(std::memory_order_relaxed); }
+
+	private:
+
+		struct FPendingChunk
+		{
+			std::uint32_t stream_index = 0;
+			std::uint32_t chunk_number = 0;
+			std::vector<FTelemetrySample> samples;
+		};
+
+		void hand_off(std::int32_t stream_index);
+
+		void run();
+
+		FFlightRecordWriterConfig config;
+
+		std::string index_path;
+
+		// Recording thread only
+		std::vector<std::vector<FTelemetrySample>> open_chunks;
+		std::uint32_t next_chunk_number = 0;
+
+		mutable std::mutex mutex;
+		std::condition_variable chunk_pending;
+		std::condition_variable chunk_written;
+
+		// Under the mutex
+		std::deque<FPendingChunk> pending_chunks;
+		std::vector<std::vector<FTelemetrySample>> free_buffers;
+		FFlightRecordIndex index;
+		bool is_closing = false;
+
+		std::atomic<bool> has_write_failed { false };
+
+		std::thread writer_thread;
+	};
+}
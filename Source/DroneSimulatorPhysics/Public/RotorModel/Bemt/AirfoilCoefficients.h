@@ -0,0 +1,33 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+
+#include <optional>
+
+namespace physics
+{
+	struct FAirfoilCoefficients
+	{
+		double lift;
+		double drag;
+
+	public:
+
+		FAirfoilCoefficients(double in_lift, double in_drag)
+			: lift(in_lift), drag(in_drag)
+		{
+		}
+
+		static FAirfoilCoefficients get_sensible_defaults()
+		{
+			return FAirfoilCoefficients(0.0, 0.1);
+		}
+	};
+}
+
+namespace physics::simulation_bemt
+{
+	DRONESIMULATORPHYSICS_API std::optional<FAirfoilCoefficients> interpolate_airfoil_coefficients(double reynolds,
+		double angle_of_attack, const FDroneAirfoil& airfoil);
+}
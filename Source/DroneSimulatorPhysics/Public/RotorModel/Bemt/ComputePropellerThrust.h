@@ -0,0 +1,49 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+#include "DroneSimulatorPhysics/Public/Simulation/LogDebug.h"
+
+#include <tuple>
+#include <vector>
+
+namespace physics
+{
+	struct FDronePropellerBemt;
+
+	struct FPropThrustResult
+	{
+		double thrust = 0.0; // In Newtons
+		double torque = 0.0; // In N·m
+		double angle_of_attack = 0.0; // In radians
+		std::vector<double> reynolds = {};
+		double v_induced = 0.0; // In m/s
+		double v_axial = 0.0; // In m/s
+	};
+}
+
+namespace physics::simulation_bemt
+{
+	/**
+	 * Computes the axial velocity of the air for a given propeller
+	 * @param thrust_axis Unit vector, which direction is the up axis of the propeller
+	 * @param wind_velocity Velocity of the global wind, in the surrounding of the propeller, in m/s
+	 * @param propeller_velocity Velocity of the propeller object (not the air), in m/s
+	 * @return Axial velocity of the freestream, in m/s
+	 */
+	DRONESIMULATORPHYSICS_API double compute_axial_velocity(const FVector3& thrust_axis, const FVector3& wind_velocity,
+		const FVector3& propeller_velocity);
+
+	/**
+	 * @param propeller_angular_speed Angular speed of the propeller, in rad/s
+	 * @param thrust_axis Axis of the propeller
+	 * @param wind_velocity Velocity of the wind, in m/s
+	 * @param propeller_velocity Velocity of the propeller object, in m/s
+	 * @param air_density Density of the air
+	 * @param propeller Propeller info
+	 * @return Result of the simulation of thrust and torque. Adds additional info for displaying
+	 */
+	DRONESIMULATORPHYSICS_API std::tuple<FPropThrustResult, FDebugLog> compute_thrust_and_torque(double propeller_angular_speed,
+		const FVector3& thrust_axis, const FVector3& wind_velocity, const FVector3& propeller_velocity, double air_density,
+		const FDronePropellerBemt* propeller);
+}
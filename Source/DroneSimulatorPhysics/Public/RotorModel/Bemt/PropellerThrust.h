@@ -0,0 +1,62 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/RotorModel/Bemt/ComputePropellerThrust.h"
+#include "DroneSimulatorPhysics/Public/Simulation/LogDebug.h"
+
+#include <tuple>
+#include <vector>
+
+namespace physics
+{
+	struct FDroneBattery;
+	struct FDroneMotor;
+	struct FDronePropellerBemt;
+	struct FRotorDescription;
+	struct FSimulationWorld;
+	struct FSubstepBody;
+
+	struct FPropellerSimInfo
+	{
+		double angular_speed = 0.0; // rad/s
+		double thrust = 0.0; // Newtons
+		double torque = 0.0; // N.m
+		double angle_of_attack = 0.0; // In radians
+		std::vector<double> reynolds = {};
+		double v_induced = 0.0; // In m/s
+		double v_axial = 0.0; // In m/s
+
+		FPropellerSimInfo() = default;
+
+		FPropellerSimInfo(const FPropThrustResult& sim_result, double in_angular_speed, double torque_override)
+			: angular_speed(in_angular_speed)
+			, thrust(sim_result.thrust)
+			, torque(torque_override)
+			, angle_of_attack(sim_result.angle_of_attack)
+			, reynolds(sim_result.reynolds)
+			, v_induced(sim_result.v_induced)
+			, v_axial(sim_result.v_axial)
+		{
+		}
+	};
+}
+
+namespace physics::simulation_bemt
+{
+	/**
+	 * Computes and applies the thrust of the propeller to the body
+	 *
+	 * @param substep_body Body to apply the propeller thrust to
+	 * @param throttle Propeller throttle, in a 0..1 range
+	 * @param propeller Propeller info
+	 * @param motor Motor info. Kv is in rad/s
+	 * @param battery Battery info
+	 * @param rotor Location, thrust axis and spin direction of the propeller, relative to the frame
+	 * @param simulation_world World
+	 *
+	 * @return Useful information for displaying. The function already applies the changes to the body
+	 */
+	DRONESIMULATORPHYSICS_API std::tuple<FPropellerSimInfo, FDebugLog> simulate_propeller_thrust(FSubstepBody* substep_body,
+		double throttle, const FDronePropellerBemt* propeller, const FDroneMotor* motor, const FDroneBattery* battery,
+		const FRotorDescription& rotor, const FSimulationWorld* simulation_world);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+#include "DroneSimulatorPhysics/Public/Simulation/LogDebug.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+
+#include <variant>
+
+namespace physics
+{
+	struct FSimulationWorld;
+	struct FSubstepBody;
+
+	struct FThrustSimValue
+	{
+		double thrust = 0.0; // In Newtons
+		double torque = 0.0; // In N·m
+
+		FThrustSimValue() = default;
+
+		FThrustSimValue(double in_thrust, double in_torque)
+			: thrust(in_thrust), torque(in_torque) {}
+	};
+
+	struct FRotorSimulationResult
+	{
+		FThrustSimValue value;
+		FDebugLog debug_log;
+	};
+
+	/** Blade element momentum theory, needs a FDronePropellerBemt */
+	struct FRotorModelBemt
+	{
+	};
+
+	/** Thrust and torque coefficients, needs a FDronePropellerSimplified */
+	struct FRotorModelSimplified
+	{
+	};
+
+	/** Linear in throttle, ignores the drone parts */
+	struct FRotorModelDebug
+	{
+		// In Newtons, assuming drone AUW = 600g, with a 10:1 thrust to weight ratio, and 4 propellers
+		double max_thrust = 15.0;
+
+		// In N·m
+		double max_torque = 0.25;
+	};
+
+	using FRotorModel = std::variant<FRotorModelBemt, FRotorModelSimplified, FRotorModelDebug>;
+}
+
+namespace physics::rotor_model
+{
+	/**
+	 * Computes the thrust and torque of one propeller, and applies them to the body.
+	 *
+	 * @param throttle Propeller throttle, in a 0..1 range
+	 * @param rotor Location, thrust axis and spin direction of the propeller, relative to the frame
+	 */
+	DRONESIMULATORPHYSICS_API FRotorSimulationResult simulate_propeller_rotor(const FRotorModel& rotor_model,
+		FSubstepBody* substep_body, double throttle, const FDronePropeller* propeller, const FDroneMotor* motor,
+		const FDroneBattery* battery, const FRotorDescription& rotor, const FSimulationWorld* simulation_world);
+
+	DRONESIMULATORPHYSICS_API FRotorSimulationResult simulate_bemt_rotor(FSubstepBody* substep_body, double throttle,
+		const FDronePropeller* propeller, const FDroneMotor* motor, const FDroneBattery* battery,
+		const FRotorDescription& rotor, const FSimulationWorld* simulation_world);
+
+	DRONESIMULATORPHYSICS_API FRotorSimulationResult simulate_simplified_rotor(FSubstepBody* substep_body, double throttle,
+		const FDronePropeller* propeller, const FDroneMotor* motor, const FDroneBattery* battery,
+		const FRotorDescription& rotor, const FSimulationWorld* simulation_world);
+
+	/**
+	 * Applies the thrust along the rotor axis at the rotor location, and the torque around the rotor axis, opposite
+	 * to the spin direction.
+	 *
+	 * @param thrust In N
+	 * @param torque In N·m, only its magnitude is used
+	 */
+	DRONESIMULATORPHYSICS_API void apply_rotor_forces(FSubstepBody* substep_body, const FRotorDescription& rotor, double thrust,
+		double torque);
+
+	DRONESIMULATORPHYSICS_API FRotorSimulationResult simulate_debug_rotor(const FRotorModelDebug& rotor_model,
+		FSubstepBody* substep_body, double throttle, const FRotorDescription& rotor);
+}
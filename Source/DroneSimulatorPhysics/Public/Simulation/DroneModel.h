@@ -0,0 +1,99 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Collision/CollisionWorld.h"
+#include "DroneSimulatorPhysics/Public/PropulsionModel/PropulsionModel.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace physics
+{
+	struct FDroneParts
+	{
+		std::optional<FDroneFrame> frame;
+		std::optional<FDroneMotor> motor;
+		std::optional<FDroneBattery> battery;
+		std::optional<FDronePropeller> propeller;
+
+		// Frame, battery and one motor per rotor, in kg
+		double compute_total_mass() const;
+	};
+
+	/**
+	 * The parts of a drone and the constants derived from them, computed once. A model is immutable after
+	 * compilation: drones share it through a std::shared_ptr<const FDroneModel>, and the substeps only read it.
+	 */
+	struct DRONESIMULATORPHYSICS_API FDroneModel
+	{
+		FDroneParts parts;
+
+		// In kg
+		double total_mass = 0.0;
+
+		// In kg·m², diagonal of the local inertia tensor
+		FVector3 inertia_tensor = FVector3::zero();
+
+		// Drag area of the frame and the props, in m², per local axis. Zero if the frame or the propeller is missing.
+		FVector3 total_cda = FVector3::zero();
+
+		// Rotors of the frame, see physics::propulsion::compute_rotors. Empty if the frame is missing.
+		std::vector<FRotorDescription> rotors;
+
+		// Allocation of the controller commands to the rotors, in the same order
+		FMixerMatrix mixer;
+
+		// Spheres around the center and the props, for collision::apply_contacts
+		FDroneCollisionShape collision_shape;
+
+		bool has_propulsion() const
+		{
+			return parts.frame.has_value() && parts.motor.has_value() && parts.battery.has_value() && parts.propeller.has_value();
+		}
+
+		bool has_drag() const
+		{
+			return parts.frame.has_value() && parts.propeller.has_value();
+		}
+
+		// Only valid if has_propulsion(). Points into this model.
+		FPropulsionDroneSetup get_propulsion_setup() const;
+	};
+
+	/**
+	 * Deduplicates compiled models, so that identical drones share one instance. Models are held weakly: a model is
+	 * freed when the last drone using it goes away, and compiled again the next time it is requested.
+	 */
+	class DRONESIMULATORPHYSICS_API FDroneModelCache
+	{
+	public:
+
+		static FDroneModelCache& get();
+
+		/**
+		 * @param key Identifies the parts, for example the paths of the assets they come from
+		 * @param make_parts Only called when there is no live model for this key
+		 */
+		std::shared_ptr<const FDroneModel> find_or_compile(const std::string& key, const std::function<FDroneParts()>& make_parts);
+
+		// Number of models that are still used by a drone
+		std::size_t get_num_live_models();
+
+	private:
+
+		std::mutex mutex;
+
+		std::unordered_map<std::string, std::weak_ptr<const FDroneModel>> models;
+	};
+}
+
+namespace physics::drone_model
+{
+	DRONESIMULATORPHYSICS_API std::shared_ptr<const FDroneModel> compile(FDroneParts parts);
+}
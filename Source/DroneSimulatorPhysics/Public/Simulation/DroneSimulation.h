@@ -0,0 +1,137 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Collision/CollisionWorld.h"
+#include "DroneSimulatorPhysics/Public/Controller/FlightMode.h"
+#include "DroneSimulatorPhysics/Public/Controller/GyroFilter.h"
+#include "DroneSimulatorPhysics/Public/Controller/PilotInputBuffer.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/PropulsionModel/PropulsionModel.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneModel.h"
+#include "DroneSimulatorPhysics/Public/Simulation/ImuSensor.h"
+#include "DroneSimulatorPhysics/Public/Simulation/MultiRateSchedule.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SimulationWorld.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SleepState.h"
+#include "DroneSimulatorPhysics/Public/Simulation/StateHash.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SubstepBody.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace physics
+{
+	/**
+	 * Headless drone simulation: same substep loop as UDroneMovementComponent, but the transform is integrated here
+	 * instead of by Chaos. Used by offline tools, tests and benchmarks, without booting the engine.
+	 */
+	struct DRONESIMULATORPHYSICS_API FDroneSimulation
+	{
+		// Shared between the drones with the same parts, see FDroneModelCache. Copying a drone doesn't copy the model.
+		std::shared_ptr<const FDroneModel> model = drone_model::compile(FDroneParts());
+
+		FPropulsionModel propulsion_model = FPropulsionModelDynamics { FPidDroneController(), FRotorModelBemt(), FPropulsionHeldOutputs() };
+
+		FFlightMode flight_mode = FFlightModeAir();
+
+		FSimulationWorld simulation_world;
+
+		// Static geometry the drone collides with, shared by the drones of a batch. Null flies in open air.
+		std::shared_ptr<const FCollisionWorld> collision_world;
+
+		// Contacts of the last substep, for example to end an episode on a crash
+		FContactResult last_contact;
+
+		// Disarmed drones don't run their propulsion
+		bool is_armed = true;
+
+		// Disabled by default. Only drones that rest on a collision world can fall asleep.
+		FSleepConfig sleep_config;
+
+		FSleepState sleep_state;
+
+		double tick_rate_hz = 400.0;
+
+		// Rate of each stage of the substep, all stages run on every substep by default
+		FMultiRateSchedule schedule;
+
+		FHeldStageOutputs held_stage_outputs;
+
+		// Disabled by default. Sampled on the IMU stage of the schedule.
+		FImuSensor imu;
+
+		// Disabled by default. Filters each gyro sample of the IMU, the controller then flies on the filtered gyro.
+		FGyroFilter gyro_filter;
+
+		double remaining_time_accumulator = 0.0;
+
+		FSubstepBody body;
+
+		// Pilot inputs timestamped on the simulation clock, read by the flight mode on every substep
+		FPilotInputBuffer pilot_input_buffer;
+
+		// Output of the flight mode on the last substep
+		FDroneSetpoint setpoint;
+
+		// Number of substeps run since the last reset. This is the simulation clock: it doesn't depend on frame times.
+		std::int64_t substep_index = 0;
+
+		FStateHashLog state_hash_log;
+
+		double get_simulation_time() const { return static_cast<double>(this->substep_index) / this->tick_rate_hz; }
+
+		// Hash of the body, the setpoint and the controller and flight mode states
+		std::uint64_t compute_state_hash() const;
+
+		/**
+		 * Places the body at rest, with the mass and inertia of the model.
+		 * @param location_world In unreal units
+		 */
+		void reset_body(const FVector3& location_world, const FQuaternion& rotation_world);
+
+		/**
+		 * Runs as many substeps as fit in the accumulated time. The player input is timestamped at the end of the frame,
+		 * and each substep runs the flight mode with the input interpolated from the previous frame.
+		 * A sleeping drone only advances its clock.
+		 * @return The number of substeps that were run
+		 */
+		std::int32_t advance(double delta_time, const FDronePlayerInput& player_input);
+
+		/**
+		 * Runs exactly substep_count substeps, with the player input held during all of them. The accumulator is not
+		 * used, so the number of substeps doesn't depend on rounding of the delta time.
+		 */
+		void advance_substeps(std::int32_t substep_count, const FDronePlayerInput& player_input);
+
+		// Propulsion, gravity, drag, contacts, IMU, then integration of the velocities and of the transform. Each stage runs
+		// or holds its output according to the schedule.
+		void simulate_substep(double substep_delta_time);
+
+		// Same, with the stages of the substep given, and without recording the state hash. A batch that already ran the
+		// controller turns its stage off, and records the hash once it has written its states back to the drone.
+		void simulate_substep(double substep_delta_time, const FSubstepStages& stages);
+
+		// Records the hash of the last substep, if the log hashes it
+		void record_state_hash();
+
+		// Runs the sleep transition rules for a frame, returns whether the drone is asleep
+		bool update_sleep(const FDronePlayerInput& player_input, double delta_time);
+
+		// Runs the flight mode with the body state and the pilot input at the start of the next substep
+		void update_setpoint(double substep_delta_time);
+
+		FFlightModeState build_flight_mode_state(double delta_time) const;
+
+		// Last gyro reading of the controller, null before the first IMU sample: the controller reads the body instead
+		const FVector3* get_gyro_angular_velocity() const;
+
+		// Moves the notches to the rotor speeds, and filters the latest gyro sample
+		void filter_gyro(double sample_rate_hz);
+
+		// Throttle the rotors spin at, for the IMU vibration and the RPM filter
+		FRotorSetThrottle get_rotor_throttle() const;
+
+		// In rad/s
+		double get_max_rotor_speed() const;
+	};
+}
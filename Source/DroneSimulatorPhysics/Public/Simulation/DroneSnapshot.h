@@ -0,0 +1,97 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Collision/CollisionWorld.h"
+#include "DroneSimulatorPhysics/Public/Controller/DroneController.h"
+#include "DroneSimulatorPhysics/Public/Controller/FlightMode.h"
+#include "DroneSimulatorPhysics/Public/Controller/GyroFilter.h"
+#include "DroneSimulatorPhysics/Public/Controller/PilotInputBuffer.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/Math/Transform.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+#include "DroneSimulatorPhysics/Public/PropulsionModel/PropulsionModel.h"
+#include "DroneSimulatorPhysics/Public/Simulation/ImuSensor.h"
+#include "DroneSimulatorPhysics/Public/Simulation/MultiRateSchedule.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SleepState.h"
+
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace physics
+{
+	struct FDroneSimulation;
+
+	/**
+	 * Everything that changes while a drone flies, as plain data: no pointers and no heap allocations, so a snapshot
+	 * is copied with a memcpy, can be written to disk or shared memory as-is, and shares pages well after a fork().
+	 * The configuration (parts, gains) is not included, a snapshot is restored on a drone with the same configuration.
+	 *
+	 * Rotor models don't keep state between substeps, so there is no rotor cache to save. The outputs held by the slow
+	 * stages of the substep loop are saved, so that a restored drone continues mid-interval exactly.
+	 */
+	struct FDroneSimulationSnapshot
+	{
+		static constexpr std::uint32_t expected_magic = 0x504E5344; // "DSNP"
+		static constexpr std::uint32_t expected_version = 7;
+
+		std::uint32_t magic = expected_magic;
+		std::uint32_t version = expected_version;
+
+		// Body, see FSubstepBody
+		FRigidTransform transform_world;
+		double mass = 0.0;
+		FVector3 inertia_tensor = FVector3::zero();
+		FVector3 linear_velocity_world = FVector3::zero();
+		FVector3 angular_velocity_radians_world = FVector3::zero();
+
+		double remaining_time_accumulator = 0.0;
+		std::int64_t substep_index = 0;
+		FDroneSetpoint setpoint;
+
+		// Pilot inputs the flight mode interpolates between
+		FPilotInputBuffer pilot_input_buffer;
+
+		// Integrators, only used by the PID controller and the velocity flight mode
+		FPidDroneControllerState controller_state;
+		FFlightModeVelocityState flight_mode_state;
+
+		// See FMultiRateSchedule
+		FPropulsionHeldOutputs propulsion_held_outputs;
+		FHeldStageOutputs held_stage_outputs;
+
+		bool is_armed = true;
+		FSleepState sleep_state;
+
+		// Contacts of the last substep, which keep a landed drone falling asleep
+		FContactResult last_contact;
+
+		// IMU drift and vibration. The noise is drawn again from the sample count, the past samples are not kept.
+		FVector3 imu_gyro_bias = FVector3::zero();
+		FVector3 imu_accel_bias = FVector3::zero();
+		std::array<double, max_rotor_count> imu_rotor_angles = {};
+		std::int64_t imu_sample_count = 0;
+
+		// Stages of the gyro filter and the gyro the controller flies on
+		FGyroFilterState gyro_filter_state;
+	};
+
+	static_assert(std::is_trivially_copyable_v<FDroneSimulationSnapshot>, "Snapshots must be copyable with memcpy");
+}
+
+namespace physics::snapshot
+{
+	DRONESIMULATORPHYSICS_API FDroneSimulationSnapshot capture(const FDroneSimulation& simulation);
+
+	DRONESIMULATORPHYSICS_API void restore(FDroneSimulation& simulation, const FDroneSimulationSnapshot& snapshot);
+
+	inline std::span<const std::byte> as_bytes(const FDroneSimulationSnapshot& snapshot)
+	{
+		return std::as_bytes(std::span(&snapshot, 1));
+	}
+
+	/**
+	 * @return false if the blob is not a snapshot of the current version
+	 */
+	DRONESIMULATORPHYSICS_API bool from_bytes(std::span<const std::byte> bytes, FDroneSimulationSnapshot& out_snapshot);
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/Mixer.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace physics
+{
+	struct FSubstepBody;
+
+	/**
+	 * Gyro and accelerometer errors. The defaults are those of a typical 16 bit flight controller IMU, at ±2000 deg/s
+	 * and ±16 g.
+	 */
+	struct FImuConfig
+	{
+		bool is_enabled = false;
+
+		// Drones with the same seed draw the same noise
+		std::uint64_t seed = 0;
+
+		// White noise, in rad/s/√Hz
+		double gyro_noise_density = 1.5e-4;
+
+		// Bias drift, in rad/s/√s
+		double gyro_bias_random_walk = 2e-5;
+
+		// In rad/s
+		double gyro_range = 34.9;
+
+		// In rad/s per count, 0 to disable the quantization
+		double gyro_resolution = 34.9 / 32768.0;
+
+		// White noise, in m/s²/√Hz
+		double accel_noise_density = 2e-3;
+
+		// Bias drift, in m/s²/√s
+		double accel_bias_random_walk = 3e-4;
+
+		// In m/s²
+		double accel_range = 156.9;
+
+		// In m/s² per count, 0 to disable the quantization
+		double accel_resolution = 156.9 / 32768.0;
+
+		// Frame vibration of each rotor at full speed, in rad/s and m/s². It scales with the rotor speed squared, at
+		// the rotor frequency.
+		double vibration_gyro_amplitude = 0.02;
+
+		double vibration_accel_amplitude = 1.0;
+	};
+
+	struct FImuSample
+	{
+		// Samples taken since the last reset, before this one
+		std::int64_t sample_index = 0;
+
+		// Simulation time, in seconds
+		double time = 0.0;
+
+		// In rad/s, around the local axes
+		FVector3 angular_velocity = FVector3::zero();
+
+		// In m/s², along the local axes: the acceleration without gravity, +9.81 on Z when hovering
+		FVector3 specific_force = FVector3::zero();
+	};
+
+	inline constexpr std::int32_t imu_ring_capacity = 64;
+
+	/**
+	 * Last imu_ring_capacity samples of an IMU. Consumers keep the index of the next sample they want, and read at their
+	 * own rate: a 500 Hz consumer of a 4 kHz IMU reads 8 samples at a time.
+	 */
+	struct DRONESIMULATORPHYSICS_API FImuSampleRing
+	{
+		std::array<FImuSample, imu_ring_capacity> samples = {};
+
+		// Samples pushed since the last reset
+		std::int64_t sample_count = 0;
+
+		void push(const FImuSample& sample);
+
+		// Null before the first sample
+		const FImuSample* get_latest() const;
+
+		/**
+		 * Copies the samples from first_sample_index on, oldest first. Samples already overwritten are skipped, the
+		 * sample_index of each sample tells which ones were read.
+		 * @return The number of samples copied
+		 */
+		std::int32_t read_since(std::int64_t first_sample_index, std::span<FImuSample> out_samples) const;
+	};
+
+	// Gyro and accelerometer white noise, then gyro and accelerometer bias drift
+	inline constexpr std::int32_t imu_normals_per_sample = 12;
+
+	// Noise is drawn for this many samples at once
+	inline constexpr std::int32_t imu_noise_block_samples = 32;
+
+	struct FImuState
+	{
+		// In rad/s
+		FVector3 gyro_bias = FVector3::zero();
+
+		// In m/s²
+		FVector3 accel_bias = FVector3::zero();
+
+		// In rad, angle of each rotor for the vibration
+		std::array<double, max_rotor_count> rotor_angles = {};
+
+		// Normals of the samples noise_block_start to noise_block_start + imu_noise_block_samples - 1
+		std::array<double, imu_normals_per_sample * imu_noise_block_samples> noise_block = {};
+
+		std::int64_t noise_block_start = -1;
+	};
+
+	struct FImuSensor
+	{
+		FImuConfig config;
+
+		FImuState state;
+
+		FImuSampleRing samples;
+	};
+}
+
+namespace physics::imu
+{
+	/**
+	 * Samples the IMU, and pushes the sample in its ring. Runs after all the forces of the substep are accumulated, and
+	 * before they are consumed: the specific force is the accumulated force without gravity, divided by the mass.
+	 *
+	 * The noise of sample N is a pure function of the seed and N, drawn from a counter-based generator, see
+	 * random::fill_normal. It doesn't depend on the thread, nor on the other drones.
+	 *
+	 * @param rotor_throttle Throttle of each rotor, the rotor speed is the throttle times max_rotor_speed
+	 * @param max_rotor_speed In rad/s
+	 * @param delta_time Time since the last sample, in seconds
+	 */
+	DRONESIMULATORPHYSICS_API const FImuSample& sample(FImuSensor& imu, const FSubstepBody& substep_body,
+		const FRotorSetThrottle& rotor_throttle, double max_rotor_speed, double time, double delta_time);
+
+	// Clears the state and the samples, the config is kept
+	DRONESIMULATORPHYSICS_API void reset(FImuSensor& imu);
+}
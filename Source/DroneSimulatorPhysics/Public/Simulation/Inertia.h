@@ -0,0 +1,20 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+
+#include <optional>
+
+namespace physics::inertia
+{
+	DRONESIMULATORPHYSICS_API FVector3 compute_frame_inertia(const std::optional<FDroneFrame>& frame_opt);
+	DRONESIMULATORPHYSICS_API FVector3 compute_motors_inertia(const std::optional<FDroneMotor>& motor_opt, const std::optional<FDroneFrame>& frame_opt);
+	DRONESIMULATORPHYSICS_API FVector3 compute_battery_inertia(const std::optional<FDroneBattery>& battery_opt);
+
+	DRONESIMULATORPHYSICS_API FVector3 compute_inertia_si(const std::optional<FDroneFrame>& frame_opt,
+		const std::optional<FDroneMotor>& motor_opt, const std::optional<FDroneBattery>& battery_opt);
+
+	// Convenience: UE units (kg·cm²)
+	DRONESIMULATORPHYSICS_API FVector3 compute_inertia_uu(const std::optional<FDroneFrame>& frame_opt,
+		const std::optional<FDroneMotor>& motor_opt, const std::optional<FDroneBattery>& battery_opt);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Simulation/Structural.h"
+
+namespace physics
+{
+	struct FSimulationWorld;
+	struct FSubstepBody;
+}
+
+namespace physics::simulation
+{
+	// In meters
+	DRONESIMULATORPHYSICS_API double get_props_radius(const FDronePropeller& propeller);
+
+	DRONESIMULATORPHYSICS_API FVector3 calculate_props_cda(const FDronePropeller& propeller);
+
+	DRONESIMULATORPHYSICS_API void calculate_linear_drag(FSubstepBody* substep_body, const FDroneFrame& frame,
+		const FDronePropeller& propeller, const FSimulationWorld* simulation_world);
+
+	// Same, with the drag area of the frame and the props already summed, see FDroneModel::total_cda
+	DRONESIMULATORPHYSICS_API void calculate_linear_drag(FSubstepBody* substep_body, const FVector3& total_cda,
+		const FSimulationWorld* simulation_world);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+
+#include <string>
+#include <vector>
+
+namespace physics
+{
+	struct DRONESIMULATORPHYSICS_API FDebugLog
+	{
+		std::vector<std::string> logs;
+
+		void log(const std::string& log);
+
+		void append_debug_log(const FDebugLog& other);
+	};
+}
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SpscQueue.h"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace physics
+{
+	struct FCollisionWorld;
+	struct FPublishedDroneState;
+
+	enum class ELowRateSensor : std::uint8_t
+	{
+		barometer,
+		gps,
+		magnetometer,
+		rangefinder,
+	};
+
+	inline constexpr std::int32_t low_rate_sensor_count = 4;
+
+	// Highest rate and latency of a low rate sensor, larger values are clamped. They bound the pending samples.
+	inline constexpr double max_low_rate_sensor_rate_hz = 100.0;
+	inline constexpr double max_low_rate_sensor_latency = 0.2;
+
+	struct FLowRateSensorTiming
+	{
+		bool is_enabled = false;
+
+		// In Hz, up to max_low_rate_sensor_rate_hz
+		double rate_hz = 50.0;
+
+		// In seconds, between the measurement and the moment the sample is published. Up to max_low_rate_sensor_latency.
+		double latency = 0.0;
+	};
+
+	struct FBarometerConfig
+	{
+		FLowRateSensorTiming timing { false, 50.0, 0.02 };
+
+		// White noise on the altitude, in m
+		double altitude_noise = 0.3;
+
+		// Drift of the altitude, in m/√s
+		double altitude_bias_random_walk = 0.02;
+
+		// In m, altitude above sea level of Z = 0
+		double origin_altitude = 0.0;
+
+		// In Pa
+		double sea_level_pressure = 101325.0;
+	};
+
+	struct FGpsConfig
+	{
+		FLowRateSensorTiming timing { false, 10.0, 0.1 };
+
+		// Standard deviation of the position error, in m. The error wanders slowly, it isn't white.
+		double horizontal_position_error = 1.0;
+
+		double vertical_position_error = 2.0;
+
+		// In seconds, correlation time of the position error
+		double position_error_time_constant = 60.0;
+
+		// White noise on the velocity, in m/s
+		double velocity_noise = 0.1;
+	};
+
+	struct FMagnetometerConfig
+	{
+		FLowRateSensorTiming timing { false, 100.0, 0.005 };
+
+		// In gauss, Earth field in the world frame
+		FVector3 field_world = FVector3(0.22, 0.0, -0.42);
+
+		// White noise, in gauss
+		double field_noise = 0.005;
+	};
+
+	struct FRangefinderConfig
+	{
+		FLowRateSensorTiming timing { false, 50.0, 0.01 };
+
+		// In m, further away the sample is not valid
+		double max_range = 8.0;
+
+		// White noise, in m
+		double range_noise = 0.01;
+	};
+
+	/**
+	 * Sensors that firmwares read at 10 to 100 Hz. They are not part of the substep loop: see low_rate_sensors::update.
+	 */
+	struct FLowRateSensorsConfig
+	{
+		// Drones with the same seed draw the same noise
+		std::uint64_t seed = 0;
+
+		FBarometerConfig barometer;
+
+		FGpsConfig gps;
+
+		FMagnetometerConfig magnetometer;
+
+		FRangefinderConfig rangefinder;
+	};
+
+	/**
+	 * One measurement of one sensor. Only the fields of that sensor are set.
+	 */
+	struct FLowRateSensorSample
+	{
+		ELowRateSensor sensor = ELowRateSensor::barometer;
+
+		// False when the sensor has nothing to measure, for example a rangefinder out of range
+		bool is_valid = true;
+
+		// Samples of this sensor taken since the last reset, before this one
+		std::int64_t sample_index = 0;
+
+		// Simulation time of the measurement, in seconds
+		double time = 0.0;
+
+		// Simulation time from which the sample is published: time plus the latency of the sensor
+		double publish_time = 0.0;
+
+		// Barometer, in m above sea level and in Pa
+		double altitude = 0.0;
+		double pressure = 0.0;
+
+		// GPS, in m and m/s in the world frame
+		FVector3 position = FVector3::zero();
+		FVector3 velocity = FVector3::zero();
+
+		// Magnetometer, in gauss along the local axes
+		FVector3 magnetic_field = FVector3::zero();
+
+		// Rangefinder, in m along the local -Z axis
+		double range = 0.0;
+	};
+
+	inline constexpr std::int32_t low_rate_sensor_queue_capacity = 64;
+
+	// In seconds. After a longer gap between two updates, the samples older than this are skipped.
+	inline constexpr double max_low_rate_catch_up_time = 0.1;
+
+	// Samples measured but not published yet, because of the latency. Enough for every sensor at the highest rate and
+	// latency to catch up on max_low_rate_catch_up_time.
+	inline constexpr std::int32_t max_pending_low_rate_samples = 128;
+
+	static_assert(low_rate_sensor_count * (max_low_rate_sensor_rate_hz * (max_low_rate_sensor_latency + max_low_rate_catch_up_time) + 1)
+		<= max_pending_low_rate_samples, "The pending samples must hold every sensor at its limits");
+
+	struct FLowRateSensorsState
+	{
+		// False until the first update, which takes the first sample of every sensor
+		bool is_started = false;
+
+		// Simulation time of the last update, in seconds
+		double last_update_time = 0.0;
+
+		std::array<std::int64_t, low_rate_sensor_count> sample_counts = {};
+
+		// In seconds, on the simulation clock
+		std::array<double, low_rate_sensor_count> next_sample_times = {};
+
+		// In m
+		double barometer_bias = 0.0;
+
+		// In m
+		FVector3 gps_position_error = FVector3::zero();
+
+		// Oldest first
+		std::array<FLowRateSensorSample, max_pending_low_rate_samples> pending_samples = {};
+
+		std::int32_t pending_count = 0;
+	};
+
+	/**
+	 * Low rate sensors of one drone, and the queue their samples are published to. The thread that calls update is the
+	 * only writer of the queue, and one consumer thread pops it.
+	 */
+	struct FLowRateSensorSuite
+	{
+		FLowRateSensorsConfig config;
+
+		FLowRateSensorsState state;
+
+		TSpscQueue<FLowRateSensorSample, low_rate_sensor_queue_capacity> samples;
+
+		// Samples dropped because the pending samples were full, like the queue counts those dropped because it was
+		// full. Stays 0 within the timing limits. Not cleared by reset.
+		std::int64_t dropped_pending_count = 0;
+	};
+
+	/**
+	 * Height of the ground below a world location, in unreal units. Empty when there is no ground below.
+	 */
+	using FGroundHeightQuery = std::function<std::optional<double>(const FVector3& location_world)>;
+}
+
+namespace physics::low_rate_sensors
+{
+	/**
+	 * Takes the samples due since the last update, and publishes those whose latency elapsed. Runs on the game thread or
+	 * on a worker, from the states the physics side publishes (see FDroneStateExchange), so the substep loop doesn't pay
+	 * for these sensors at all, however many there are.
+	 *
+	 * The samples are taken at their own rate on the simulation clock, not at the rate of the published states: a sample
+	 * due between two states is measured on the newest one, moved back to the sample time along its velocity. The noise
+	 * of sample N of a sensor is a pure function of the seed and N, see random::fill_normal.
+	 *
+	 * A state older than the last one restarts the sensors, after a reset or a snapshot restore for example.
+	 *
+	 * @param ground_height Only queried by the rangefinder, may be empty
+	 */
+	DRONESIMULATORPHYSICS_API void update(FLowRateSensorSuite& suite, const FPublishedDroneState& drone_state,
+		const FGroundHeightQuery& ground_height);
+
+	// Clears the state, the config is kept. Samples already in the queue stay there.
+	DRONESIMULATORPHYSICS_API void reset(FLowRateSensorSuite& suite);
+
+	// Ground plane and heightfields of a collision world. The world must outlive the query.
+	DRONESIMULATORPHYSICS_API FGroundHeightQuery make_ground_height_query(const FCollisionWorld& collision_world);
+}
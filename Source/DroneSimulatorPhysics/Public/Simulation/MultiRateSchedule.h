@@ -0,0 +1,102 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SimulationWorld.h"
+
+#include <cstdint>
+
+namespace physics
+{
+	struct FDroneModel;
+	struct FSubstepBody;
+
+	/**
+	 * Which stages run on a given substep. A stage that doesn't run holds its last output.
+	 */
+	struct FSubstepStages
+	{
+		bool controller = true;
+
+		bool rotor_aerodynamics = true;
+
+		bool drag = true;
+
+		bool environment_sampling = true;
+
+		bool recording = true;
+
+		bool imu = true;
+
+		// Off when a batch filters the gyro of the drone, see FGyroFilterBank
+		bool gyro_filter = true;
+
+		// Time covered by one run of the controller, in seconds
+		double controller_delta_time = 0.0;
+
+		// Time between two IMU samples, in seconds
+		double imu_delta_time = 0.0;
+	};
+
+	/**
+	 * Rate of each stage of the substep loop. The substep rate (tick_rate_hz) is the fastest rate: stages run every N
+	 * substeps, N being the rate rounded to a whole number of substeps, and always on the first substep after a reset.
+	 * For example, a 8000 Hz substep rate with the rotor aerodynamics at 1000 Hz runs the PID on every substep and
+	 * BEMT once every 8 substeps.
+	 */
+	struct DRONESIMULATORPHYSICS_API FMultiRateSchedule
+	{
+		// In Hz, 0 runs the stage on every substep
+		double controller_rate_hz = 0.0;
+
+		// In Hz, 0 runs the stage on every substep. In between, the thrust and torque of each rotor follow the
+		// throttle squared.
+		double rotor_aerodynamics_rate_hz = 0.0;
+
+		// In Hz, 0 runs the stage on every substep. In between, the drag force and torque are held.
+		double drag_rate_hz = 0.0;
+
+		// In Hz, 0 runs the stage on every substep. Air density and wind are read from the world at this rate.
+		double environment_sampling_rate_hz = 0.0;
+
+		// In Hz, 0 runs the stage on every substep
+		double recording_rate_hz = 0.0;
+
+		// In Hz, 0 samples the IMU on every substep, see FImuSensor
+		double imu_rate_hz = 0.0;
+
+		/**
+		 * @param substep_index Index of the substep about to run, counted from the last reset
+		 */
+		FSubstepStages get_stages(std::int64_t substep_index, double tick_rate_hz) const;
+
+		// Number of substeps between two runs of a stage, at least 1
+		static std::int32_t get_substep_interval(double rate_hz, double tick_rate_hz);
+	};
+
+	/**
+	 * Outputs of the slow stages that are not tied to the propulsion model, carried from one substep to the next.
+	 */
+	struct FHeldStageOutputs
+	{
+		// Copy of the world, taken by the environment sampling stage
+		FSimulationWorld sampled_world;
+
+		// In N, from the last drag update
+		FVector3 drag_force_world = FVector3::zero();
+
+		// In N·m, from the last drag update
+		FVector3 drag_torque_world = FVector3::zero();
+	};
+}
+
+namespace physics::multi_rate
+{
+	// Copies the world if the environment sampling stage runs
+	DRONESIMULATORPHYSICS_API void sample_environment(FHeldStageOutputs& held_outputs, const FSimulationWorld& simulation_world,
+		const FSubstepStages& stages);
+
+	// Linear and rotational drag in the sampled world if the drag stage runs, the held drag otherwise
+	DRONESIMULATORPHYSICS_API void apply_drag(FHeldStageOutputs& held_outputs, FSubstepBody* substep_body, const FDroneModel& model,
+		const FSubstepStages& stages);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Math/Transform.h"
+
+#include <cstdint>
+
+namespace physics
+{
+	struct FTimedTransform
+	{
+		// In seconds, on the simulation clock
+		double time_seconds = 0.0;
+
+		FRigidTransform transform;
+	};
+
+	/**
+	 * Transform to render between the last two physics states, so that rendering at any frame rate doesn't stutter when
+	 * the physics runs at a fixed, lower rate. The render runs one physics interval behind the latest physics state:
+	 * each render frame moves from the previous state towards the latest one, and holds the latest one if the next
+	 * physics state is late. Constant cost, whatever the rates.
+	 */
+	struct DRONESIMULATORPHYSICS_API FRenderInterpolator
+	{
+		FTimedTransform previous;
+
+		FTimedTransform latest;
+
+		// 0, 1 or 2
+		std::int32_t count = 0;
+
+		// Render time elapsed since the latest state was pushed, in seconds
+		double time_since_latest = 0.0;
+
+		/**
+		 * Adds a physics state. States that are not newer than the latest one are ignored, call clear after a
+		 * teleport or a restore.
+		 */
+		void push(double time_seconds, const FRigidTransform& transform);
+
+		// Advances the render clock by a render frame and returns the transform to render
+		FRigidTransform advance(double render_delta_time);
+
+		// Location lerp and rotation slerp between the two states, the closest state is held outside of them
+		FRigidTransform sample(double time_seconds) const;
+
+		void clear()
+		{
+			this->count = 0;
+			this->time_since_latest = 0.0;
+		}
+	};
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSimulation.h"
+#include "DroneSimulatorPhysics/Public/Simulation/DroneSnapshot.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace physics
+{
+	class FWorkerPool;
+
+	struct FRolloutSample
+	{
+		// Seconds since the last reset of the drone, see FDroneSimulation::get_simulation_time
+		double simulation_time = 0.0;
+
+		// In unreal units
+		FVector3 location_world = FVector3::zero();
+
+		FQuaternion rotation_world = FQuaternion::identity();
+
+		// In m/s
+		FVector3 linear_velocity_world = FVector3::zero();
+
+		// In rad/s
+		FVector3 angular_velocity_radians_world = FVector3::zero();
+	};
+
+	struct FRolloutTrajectory
+	{
+		// One sample after each input
+		std::vector<FRolloutSample> samples;
+
+		// State at the end of the rollout, to continue or branch again from there
+		FDroneSimulationSnapshot final_snapshot;
+	};
+
+	/**
+	 * Forks one snapshot into several "what if" rollouts, each with its own input sequence, run in parallel.
+	 */
+	class DRONESIMULATORPHYSICS_API FRolloutBrancher
+	{
+	public:
+
+		/**
+		 * @param num_threads Number of threads running the rollouts, including the calling thread. 0 to use all cores.
+		 */
+		explicit FRolloutBrancher(std::int32_t num_threads = 0);
+
+		~FRolloutBrancher();
+
+		/**
+		 * @param drone Configuration of the drone, its state is replaced by the snapshot
+		 * @param branch_inputs Input sequence of each branch, each input is held during substeps_per_input substeps
+		 * @return One trajectory per branch, in the same order
+		 *
+		 * Not reentrant: the branches run on the threads of the brancher, so it takes one call at a time.
+		 */
+		std::vector<FRolloutTrajectory> run(const FDroneSimulation& drone, const FDroneSimulationSnapshot& snapshot,
+			const std::vector<std::vector<FDronePlayerInput>>& branch_inputs, std::int32_t substeps_per_input);
+
+	private:
+
+		std::unique_ptr<FWorkerPool> worker_pool;
+	};
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+
+namespace physics
+{
+	struct FSubstepBody;
+}
+
+namespace physics::simulation
+{
+	DRONESIMULATORPHYSICS_API void calculate_rotational_drag(FSubstepBody* substep_body);
+}
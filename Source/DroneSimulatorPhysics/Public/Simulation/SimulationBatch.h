@@ -0,0 +1,53 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/ControllerBatch.h"
+#include "DroneSimulatorPhysics/Public/Controller/GyroFilter.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/Simulation/MultiRateSchedule.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace physics
+{
+	struct FDroneSimulation;
+
+	/**
+	 * Columns of the flight modes and controllers of a swarm, reused from one call to the next so that stepping doesn't
+	 * allocate. One per thread.
+	 */
+	struct DRONESIMULATORPHYSICS_API FSimulationBatch
+	{
+		FFlightModeAirBatch air_flight_modes;
+
+		FSetpointColumns setpoints;
+
+		FPidControllerBatch controllers;
+
+		FGyroFilterBank gyro_filters;
+
+		// Per drone, for the current call
+		std::vector<std::uint8_t> is_awake;
+		std::vector<std::uint8_t> has_air_flight_mode;
+		std::vector<std::uint8_t> has_batched_controller;
+		std::vector<std::uint8_t> has_batched_gyro_filter;
+		std::vector<FSubstepStages> stages;
+
+		void resize(std::int32_t size);
+	};
+}
+
+namespace physics::simulation_batch
+{
+	/**
+	 * Same as drones[i].advance_substeps(substep_counts[i], player_inputs[i]) on each drone, bit for bit, but the drones
+	 * run their substeps in lockstep: on each substep, the air flight modes, the PID controllers and the gyro filters
+	 * of all the drones run as one kernel over columns. Other flight modes and controllers run per drone.
+	 * The controller and gyro filter states are loaded into the batch at the start of the call and written back at the
+	 * end.
+	 */
+	DRONESIMULATORPHYSICS_API void advance_substeps(std::span<FDroneSimulation> drones, std::span<const std::int32_t> substep_counts,
+		std::span<const FDronePlayerInput> player_inputs, FSimulationBatch& batch);
+}
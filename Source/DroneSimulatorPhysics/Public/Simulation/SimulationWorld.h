@@ -0,0 +1,28 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+#include <tuple>
+
+namespace physics
+{
+	/**
+	 * Environment the drones fly in. Plain data, so it can be shared by all the substeps and drones of a simulation.
+	 */
+	struct FSimulationWorld
+	{
+		// In kg/m^3
+		double air_density = 1.225;
+
+		// In m/s
+		FVector3 wind_velocity = FVector3::zero();
+
+		/**
+		 * Gets the air density (in kg/m^3) and wind velocity (in m/s)
+		 */
+		std::tuple<double, FVector3> get_wind_and_air_density() const
+		{
+			return { this->air_density, this->wind_velocity };
+		}
+	};
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace physics
+{
+	/**
+	 * When a drone that is disarmed, in contact and at rest stops being simulated. A sleeping drone doesn't run its
+	 * substeps, and wakes up when it is armed, when the pilot moves a stick, or when something else moves it.
+	 */
+	struct FSleepConfig
+	{
+		bool is_enabled = false;
+
+		// In m/s
+		double max_linear_speed = 0.05;
+
+		// In rad/s
+		double max_angular_speed = 0.1;
+
+		// Time at rest before falling asleep, in seconds
+		double time_to_sleep = 0.5;
+
+		// Sticks within this range of zero are idle
+		double input_deadzone = 0.05;
+	};
+
+	enum class ESleepTransition : std::uint8_t
+	{
+		none,
+		fell_asleep,
+		woken_by_arming,
+		woken_by_input,
+		woken_by_motion,
+		woken_by_reset,
+
+		count,
+	};
+
+	struct FSleepState
+	{
+		bool is_asleep = false;
+
+		// Time the drone has been at rest while awake, in seconds
+		double rest_time = 0.0;
+	};
+
+	/**
+	 * Process-wide count of the sleeping drones and of each transition, fed by the drones of the game scenes. Thread-safe.
+	 */
+	class DRONESIMULATORPHYSICS_API FSleepStatistics
+	{
+	public:
+
+		static FSleepStatistics& get();
+
+		void record(ESleepTransition transition);
+
+		std::int64_t get_num_asleep() const { return this->num_asleep.load(std::memory_order_relaxed); }
+
+		std::int64_t get_transition_count(ESleepTransition transition) const;
+
+		void reset();
+
+	private:
+
+		std::atomic<std::int64_t> num_asleep = 0;
+
+		std::array<std::atomic<std::int64_t>, static_cast<std::size_t>(ESleepTransition::count)> transition_counts = {};
+	};
+}
+
+namespace physics::sleep
+{
+	DRONESIMULATORPHYSICS_API bool is_input_idle(const FDronePlayerInput& player_input, double deadzone);
+
+	/**
+	 * Runs the transition rules once per frame, before the substeps. Falling asleep zeroes the velocities.
+	 * @param is_in_contact Whether something supports the drone, a drone at rest in the air would fall asleep otherwise
+	 */
+	DRONESIMULATORPHYSICS_API ESleepTransition update(FSleepState& state, const FSleepConfig& config, bool is_armed,
+		const FDronePlayerInput& player_input, bool is_in_contact, FVector3& linear_velocity_world,
+		FVector3& angular_velocity_radians_world, double delta_time);
+
+	DRONESIMULATORPHYSICS_API const char* get_transition_name(ESleepTransition transition);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/Simulation/SpscRing.h"
+
+#include <cstdint>
+
+namespace physics
+{
+	/**
+	 * TSpscRing with its capacity fixed at compile time, for queues that are members of other types and never resized.
+	 */
+	template <typename T, std::int32_t Capacity>
+	class TSpscQueue : private TSpscRing<T>
+	{
+		static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "The capacity is a power of two");
+
+	public:
+
+		TSpscQueue()
+			: TSpscRing<T>(Capacity)
+		{
+		}
+
+		using TSpscRing<T>::push;
+		using TSpscRing<T>::pop;
+		using TSpscRing<T>::size;
+		using TSpscRing<T>::get_dropped_count;
+	};
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace physics
+{
+	/**
+	 * FIFO from one writer thread to one reader thread, with its capacity chosen at runtime. Both sides are wait-free: a
+	 * push or a pop is a copy and one atomic store, no lock and no allocation, the slots are allocated once by reset.
+	 * Unlike TTripleBuffer, every value is kept until it is read, as long as the ring isn't full. Pushing to a full ring
+	 * drops the value, and counts it. The reader may also read in bulk: it gets the values in place, as at most two
+	 * contiguous spans of the ring, and releases them once it is done with them.
+	 */
+	template <typename T>
+	class TSpscRing
+	{
+	public:
+
+		// Up to two spans, the second one starts at the beginning of the ring. Oldest first.
+		using FReadSpans = std::array<std::span<const T>, 2>;
+
+		TSpscRing() = default;
+
+		explicit TSpscRing(std::int32_t capacity)
+		{
+			this->reset(capacity);
+		}
+
+		TSpscRing(const TSpscRing&) = delete;
+		TSpscRing& operator=(const TSpscRing&) = delete;
+
+		/**
+		 * Allocates the slots, for at least the given capacity rounded up to a power of two, and empties the ring. Neither
+		 * side may be running. A capacity of 0 frees the slots, every push is then dropped.
+		 */
+		void reset(std::int32_t capacity)
+		{
+			std::int32_t rounded_capacity = capacity > 0 ? 1 : 0;
+			while (rounded_capacity < capacity)
+			{
+				rounded_capacity *= 2;
+			}
+
+			this->slots = std::vector<T>(rounded_capacity);
+			this->slots.shrink_to_fit();
+			this->index_mask = rounded_capacity > 0 ? static_cast<std::uint64_t>(rounded_capacity - 1) : 0;
+			this->write_count.store(0, std::memory_order_relaxed);
+			this->cached_read_count = 0;
+			this->dropped_count.store(0, std::memory_order_relaxed);
+			this->read_count.store(0, std::memory_order_relaxed);
+			this->cached_write_count = 0;
+		}
+
+		// Writer side. False if the ring was full, the value is dropped.
+		bool push(const T& value)
+		{
+			const auto capacity = this->slots.size();
+			const auto write_count = this->write_count.load(std::memory_order_relaxed);
+			if (write_count - this->cached_read_count >= capacity)
+			{
+				this->cached_read_count = this->read_count.load(std::memory_order_acquire);
+				if (write_count - this->cached_read_count >= capacity)
+				{
+					this->dropped_count.store(this->dropped_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+					return false;
+				}
+			}
+
+			this->slots[write_count & this->index_mask] = value;
+			this->write_count.store(write_count + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Reader side. False if the ring was empty.
+		bool pop(T& out_value)
+		{
+			const auto read_count = this->read_count.load(std::memory_order_relaxed);
+			if (read_count == this->cached_write_count)
+			{
+				this->cached_write_count = this->write_count.load(std::memory_order_acquire);
+				if (read_count == this->cached_write_count)
+				{
+					return false;
+				}
+			}
+
+			out_value = this->slots[read_count & this->index_mask];
+			this->read_count.store(read_count + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * Reader side: every value pushed so far and not released, without copying them. The writer doesn't touch these
+		 * slots until they are released.
+		 */
+		FReadSpans get_read_spans()
+		{
+			const auto read_count = this->read_count.load(std::memory_order_relaxed);
+			this->cached_write_count = this->write_count.load(std::memory_order_acquire);
+
+			const auto count = static_cast<std::size_t>(this->cached_write_count - read_count);
+			if (count == 0)
+			{
+				return {};
+			}
+
+			const auto first_index = static_cast<std::size_t>(read_count & this->index_mask);
+			const auto first_count = std::min(count, this->slots.size() - first_index);
+			return {
+				std::span<const T>(this->slots.data() + first_index, first_count),
+				std::span<const T>(this->slots.data(), count - first_count),
+			};
+		}
+
+		// Reader side: gives the oldest values back to the writer, at most as many as the last get_read_spans returned
+		void release(std::size_t count)
+		{
+			const auto read_count = this->read_count.load(std::memory_order_relaxed);
+			const auto released_count = std::min<std::uint64_t>(count, this->cached_write_count - read_count);
+			this->read_count.store(read_count + released_count, std::memory_order_release);
+		}
+
+		// Either side, approximate while the other side is running
+		std::int32_t size() const
+		{
+			return static_cast<std::int32_t>(this->write_count.load(std::memory_order_acquire) - this->read_count.load(std::memory_order_acquire));
+		}
+
+		std::int32_t get_capacity() const
+		{
+			return static_cast<std::int32_t>(this->slots.size());
+		}
+
+		// Values dropped because the ring was full, since the last reset
+		std::uint64_t get_dropped_count() const
+		{
+			return this->dropped_count.load(std::memory_order_relaxed);
+		}
+
+	private:
+
+		std::vector<T> slots;
+
+		std::uint64_t index_mask = 0;
+
+		// Only written by the writer. Its copy of read_count is only refreshed when the ring looks full.
+		alignas(64) std::atomic<std::uint64_t> write_count { 0 };
+		std::uint64_t cached_read_count = 0;
+		std::atomic<std::uint64_t> dropped_count { 0 };
+
+		// Only written by the reader. Its copy of write_count is refreshed when the ring looks empty, and by get_read_spans.
+		alignas(64) std::atomic<std::uint64_t> read_count { 0 };
+		std::uint64_t cached_write_count = 0;
+	};
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Collision/CollisionWorld.h"
+#include "DroneSimulatorPhysics/Public/Controller/DroneController.h"
+#include "DroneSimulatorPhysics/Public/Controller/FlightMode.h"
+#include "DroneSimulatorPhysics/Public/Controller/Mixer.h"
+#include "DroneSimulatorPhysics/Public/Controller/PilotInputBuffer.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/Math/Transform.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+#include "DroneSimulatorPhysics/Public/Simulation/SleepState.h"
+#include "DroneSimulatorPhysics/Public/Simulation/TripleBuffer.h"
+
+#include <cstdint>
+
+namespace physics
+{
+	struct FDroneSimulation;
+	struct FDroneSimulationSnapshot;
+
+	/**
+	 * Substep clock of a drone whose substeps run on the physics thread. The physics side advances it. The game side
+	 * only sets it while the substeps don't run, asleep or when restoring a snapshot, and hands it over in the pilot
+	 * command with a new revision.
+	 */
+	struct FSubstepClock
+	{
+		// Number of substeps run since the beginning of play
+		std::int64_t substep_index = 0;
+
+		// Time carried to the next physics tick, less than a substep
+		double remaining_time_accumulator = 0.0;
+
+		// Incremented by each hand-over from the game side
+		std::int64_t revision = 0;
+	};
+
+	/**
+	 * State of a drone at the end of a physics tick, published by the physics side for gameplay, HUD and recording.
+	 * All the fields are from the same substep.
+	 */
+	struct FPublishedDroneState
+	{
+		// False until the physics side published once
+		bool is_valid = false;
+
+		std::int64_t substep_index = 0;
+
+		// In seconds, on the simulation clock
+		double simulation_time = 0.0;
+
+		FRigidTransform transform_world;
+
+		// In m/s
+		FVector3 linear_velocity_world = FVector3::zero();
+
+		FVector3 angular_velocity_radians_world = FVector3::zero();
+
+		// Output of the flight mode on the last substep
+		FDroneSetpoint setpoint;
+
+		// Output of the controller on the last substep
+		FRotorSetThrottle rotor_throttle;
+
+		FPidDroneControllerState controller_state;
+		FFlightModeVelocityState flight_mode_state;
+
+		FContactResult last_contact;
+
+		bool is_asleep = false;
+
+		// Clock after the last substep, on the revision the physics side ran on
+		double remaining_time_accumulator = 0.0;
+		std::int64_t clock_revision = 0;
+	};
+
+	/**
+	 * What the game side hands to the next physics tick.
+	 */
+	struct FPublishedPilotCommand
+	{
+		// Pilot inputs timestamped on the clock of the substeps, see FPilotInputBuffer
+		FPilotInputBuffer pilot_input_buffer;
+
+		bool is_armed = true;
+
+		// The physics side takes the clock when its revision changed
+		FSubstepClock clock;
+
+		// Only hashed by the physics side, the game side runs the sleep rules
+		FSleepState sleep_state;
+	};
+
+	/**
+	 * Both directions of the hand-off between the game thread and the physics thread of one drone. Neither side takes a
+	 * lock nor waits for the other, and each reads a coherent copy of what the other side published last.
+	 */
+	struct FDroneStateExchange
+	{
+		// Written by the physics side, read by the game side
+		TTripleBuffer<FPublishedDroneState> drone_state;
+
+		// Written by the game side, read by the physics side
+		TTripleBuffer<FPublishedPilotCommand> pilot_command;
+	};
+}
+
+namespace physics::state_exchange
+{
+	// Body, setpoint and controller state of a snapshot. The contacts are not part of a snapshot and are left empty.
+	DRONESIMULATORPHYSICS_API FPublishedDroneState from_snapshot(const FDroneSimulationSnapshot& snapshot, double tick_rate_hz);
+
+	DRONESIMULATORPHYSICS_API FPublishedDroneState capture(const FDroneSimulation& simulation);
+
+	/**
+	 * The state the game side runs its per-frame checks on, or null if the body itself has to be read instead: before
+	 * the first publish, while is_stale, and while the drone sleeps. Nothing is published while asleep, the last state is
+	 * the one the drone fell asleep in, and a collision or an impulse may have moved the body since. The next publish
+	 * clears is_stale.
+	 */
+	DRONESIMULATORPHYSICS_API const FPublishedDroneState* read_current(TTripleBuffer<FPublishedDroneState>& drone_state, bool& is_stale,
+		bool is_asleep);
+}
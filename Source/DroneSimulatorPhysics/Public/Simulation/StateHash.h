@@ -0,0 +1,82 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Math/Quaternion.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace physics
+{
+	struct FSubstepBody;
+	struct FPidDroneControllerState;
+	struct FFlightModeVelocityState;
+	struct FDroneSetpoint;
+	struct FPilotInputBuffer;
+	struct FSleepState;
+	struct FPropulsionHeldOutputs;
+	struct FHeldStageOutputs;
+
+	/**
+	 * FNV-1a hash of the exact bits of the simulation state. Two runs with the same hashes have the same state, down
+	 * to the last bit of every double.
+	 */
+	struct DRONESIMULATORPHYSICS_API FStateHasher
+	{
+		std::uint64_t value = 14695981039346656037ull;
+
+		void add(std::uint64_t bits);
+		void add(double number);
+		void add(const FVector3& vector);
+		void add(const FQuaternion& quaternion);
+		void add(const FSubstepBody& body);
+		void add(const FPidDroneControllerState& state);
+		void add(const FFlightModeVelocityState& state);
+		void add(const FDroneSetpoint& setpoint);
+		void add(const FPilotInputBuffer& input_buffer);
+		void add(const FSleepState& sleep_state);
+		void add(const FPropulsionHeldOutputs& held_outputs);
+		void add(const FHeldStageOutputs& held_outputs);
+	};
+
+	struct FStateHashEntry
+	{
+		// Number of substeps run before the hash was computed
+		std::int64_t substep_index = 0;
+
+		std::uint64_t hash = 0;
+
+		bool operator==(const FStateHashEntry& other) const = default;
+	};
+
+	/**
+	 * Hashes recorded every hash_interval substeps.
+	 */
+	struct DRONESIMULATORPHYSICS_API FStateHashLog
+	{
+		// 0 to disable the hashing
+		std::int32_t hash_interval = 0;
+
+		std::vector<FStateHashEntry> entries;
+
+		bool should_hash(std::int64_t substep_index) const
+		{
+			return this->hash_interval > 0 && substep_index % this->hash_interval == 0;
+		}
+
+		void record(std::int64_t substep_index, std::uint64_t hash)
+		{
+			this->entries.push_back(FStateHashEntry { substep_index, hash });
+		}
+	};
+
+	/**
+	 * First recorded substep whose hash differs between two runs, or whose hash is missing from one of them.
+	 * The runs diverged between the previous recorded substep and this one: record again with an interval of 1 to get
+	 * the exact substep.
+	 */
+	DRONESIMULATORPHYSICS_API std::optional<std::int64_t> find_first_divergence(const std::vector<FStateHashEntry>& entries_a,
+		const std::vector<FStateHashEntry>& entries_b);
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+namespace physics
+{
+	/**
+	 * Fast lookup table for Xfoil aerodynamic coefficients.
+	 * Data is stored in contiguous arrays for fast interpolation.
+	 */
+	struct FDroneAirfoilTable
+	{
+		// Reynolds numbers (sorted ascending)
+		std::vector<float> reynolds_numbers;
+
+		// For each Reynolds number, we store angle of attack data
+		// Each entry corresponds to one Reynolds number
+		struct FReynoldsEntry
+		{
+			std::vector<float> angles_of_attack; // In radians, sorted ascending
+			std::vector<float> lift_coefficients;
+			std::vector<float> drag_coefficients;
+		};
+
+		std::vector<FReynoldsEntry> reynolds_entries;
+
+		/** Check if table is valid and ready for use */
+		bool is_valid() const
+		{
+			return !reynolds_numbers.empty() && reynolds_entries.size() == reynolds_numbers.size()
+				&& !reynolds_entries[0].angles_of_attack.empty();
+		}
+	};
+
+	struct FDroneAirfoilSimplified
+	{
+		// Linear lift coefficient: Cl = cl_k_rad * angle_of_attack
+		double cl_k_rad = 5.5;
+
+		// Base drag coefficient (profile drag)
+		double cd_0 = 0.022;
+
+		// Induced drag coefficient multiplier: Cd_induced = cd_k * Cl^2
+		double cd_k = 0.03;
+	};
+
+	// An airfoil can be left unset, in which case the BEMT model falls back to sensible defaults
+	using FDroneAirfoil = std::variant<std::monostate, FDroneAirfoilTable, FDroneAirfoilSimplified>;
+
+	/**
+	 * All properties are in SI units (meters, kilograms, seconds, Newtons) and radians.
+	 */
+	struct FDronePropellerBemt
+	{
+		/** Number of blades */
+		std::int32_t num_blades = 0;
+
+		/** Tip radius, in meters (blade length from hub center). */
+		double radius = 0.0;
+
+		/** Hub (root) radius, in meters – no lift inside this radius. */
+		double hub_radius = 0.0;
+
+		/** Chord, in meters, assumed constant along span. */
+		double chord = 0.0;
+
+		/** Linear twist, in meters. */
+		double pitch = 0.0;
+
+		FDroneAirfoil airfoil;
+	};
+
+	struct FDronePropellerSimplified
+	{
+		// In meters
+		double blade_diameter = 0.0;
+
+		// Thrust coefficient, dimensionless
+		double thrust_coefficient = 0.0;
+
+		// Torque coefficient, dimensionless
+		double torque_coefficient = 0.0;
+	};
+
+	using FDronePropeller = std::variant<FDronePropellerBemt, FDronePropellerSimplified>;
+
+	/**
+	 * One rotor of the frame: a motor and its propeller.
+	 */
+	struct FRotorDescription
+	{
+		// Where the thrust is applied, relative to the center of the drone, in unreal units (centimeters)
+		FVector3 location = FVector3::zero();
+
+		// Direction of the thrust in the drone frame, unit length. Tilted rotors lean away from +Z.
+		FVector3 thrust_axis = FVector3::up();
+
+		// Seen from above. Clockwise props push a counter-clockwise torque on the frame.
+		bool is_clockwise = false;
+	};
+
+	struct FDroneFrame
+	{
+		// Distance in each axis from the center of the drone, in unreal units (centimeters).
+		FVector3 props_extent_front = FVector3(10.0, 10.0, 0.0);
+
+		// Distance in each axis from the center of the drone, in unreal units (centimeters).
+		FVector3 props_extent_back = FVector3(-10.0, 10.0, 0.0);
+
+		// Dimension-less drag coefficient, per axis
+		FVector3 drag_coefficient = FVector3::zero();
+
+		// Area of the frame in m², per axis
+		FVector3 area = FVector3::zero();
+
+		// In kg
+		double mass = 0.0;
+
+		// Rotors of the frame, in the order of the mixer. When empty, the frame is a quad X: its four rotors are placed
+		// at the props extents, see physics::propulsion::compute_rotors.
+		std::vector<FRotorDescription> rotors;
+
+		// One motor per rotor
+		std::size_t get_num_motors() const
+		{
+			return rotors.empty() ? 4 : rotors.size();
+		}
+	};
+
+	struct FDroneMotor
+	{
+		// Motor velocity constant, in radians per second per volt
+		double kv = 0.0;
+
+		// Mass of each motor, in kg
+		double mass = 0.0;
+	};
+
+	struct FDroneBattery
+	{
+		// In volts
+		double voltage = 0.0;
+
+		// In kg
+		double mass = 0.0;
+	};
+}
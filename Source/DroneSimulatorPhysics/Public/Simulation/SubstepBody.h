@@ -0,0 +1,85 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Math/Transform.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+namespace physics
+{
+	struct DRONESIMULATORPHYSICS_API FSubstepBody
+	{
+	// These properties are set at initialization, then should not be updated during the simulation step.
+	public:
+
+		// Transform of the body, all in unreal units.
+		FRigidTransform transform_world;
+
+		// Mass in kg
+		double mass = 0.0;
+
+		// In kg·m^2, in local space.
+		// These are the diagonal coefficients of the matrix, because in local space the matrix is diagonal
+		FVector3 inertia_tensor = FVector3::zero();
+
+	// These properties are updated at the end of each substep, but should not be updated during the substep.
+	public:
+
+		// In m/s
+		FVector3 linear_velocity_world = FVector3::zero();
+
+		// Angular velocity, as a rotation vector:
+		// - the direction of this vector is its axis of rotation
+		// - its magnitude is the rotation speed in rad/s
+		FVector3 angular_velocity_radians_world = FVector3::zero();
+
+	// These properties are accumulated during the substep.
+	public:
+
+		// In N (kg·m/s^2)
+		FVector3 accumulated_force_world = FVector3::zero();
+
+		// In N·m·rad (rad·kg·m^2/s^2), as a rotation vector
+		FVector3 accumulated_torque_world = FVector3::zero();
+
+	public:
+		/**
+		 * Adds a force in Newtons (kg·m/s^2) at the center of gravity
+		 * @param force Force to apply at the center of gravity, in Newtons, in world space
+		 */
+		void add_force(const FVector3& force);
+
+		/**
+		 * Adds a torque in N·m (kg·m^2/s^2) at the center of the object
+		 * @param torque Torque in N·m to apply at the center of the object, as a rotation vector in world space
+		 */
+		void add_torque(const FVector3& torque);
+
+		// force_world in N (kg·m/s^2), location_local in unreal units
+		void add_force_at_point(const FVector3& force_world, const FVector3& point_location_local);
+
+		/**
+		 * Consumes the forces to apply them to the linear and angular velocities, then resets the accumulators.
+		 */
+		void consume_forces_and_torques(double substep_delta_time);
+
+		/**
+		 * Moves the transform with the current velocities.
+		 * Inside Unreal, Chaos integrates the transform, so this is only used when simulating without the engine.
+		 */
+		void integrate_transform(double substep_delta_time);
+
+		FVector3 get_gyroscopic_torque_local() const;
+
+	public:
+
+		// location_local is in unreal units, output is in m/s
+		FVector3 get_velocity_at_location(const FVector3& location_local) const;
+
+	public:
+
+		FSubstepBody() = default;
+
+		FSubstepBody(const FVector3& location_world, const FQuaternion& rotation_world, double in_mass, const FVector3& in_inertia_tensor,
+			const FVector3& in_linear_velocity_world, const FVector3& in_angular_velocity_radians_world);
+	};
+}
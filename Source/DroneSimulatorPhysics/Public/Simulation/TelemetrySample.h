@@ -0,0 +1,127 @@
+#pragma once
+
+#include "DroneSimulatorPhysics/Public/DroneSimulatorPhysics.h"
+#include "DroneSimulatorPhysics/Public/Controller/Setpoint.h"
+#include "DroneSimulatorPhysics/Public/Math/Transform.h"
+#include "DroneSimulatorPhysics/Public/Math/Vector.h"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace physics
+{
+	// Rotors with propulsion details in a telemetry sample, front left, front right, rear left, rear right for a quad
+	inline constexpr std::int32_t telemetry_rotor_count = 4;
+
+	struct FTelemetryRotorValues
+	{
+		// 0..1
+		double throttle = 0.0;
+
+		// In rad/s
+		double angular_speed = 0.0;
+
+		// In N
+		double thrust = 0.0;
+
+		// In N·m
+		double torque = 0.0;
+
+		// In radians
+		double angle_of_attack = 0.0;
+
+		// Range of the Reynolds number along the blade
+		double min_reynolds = 0.0;
+		double max_reynolds = 0.0;
+
+		// In m/s
+		double velocity_axial = 0.0;
+		double velocity_induced = 0.0;
+	};
+
+	/**
+	 * One recorded substep of one drone, at full precision. See FTelemetrySample for the stored form.
+	 */
+	struct FTelemetryValues
+	{
+		// In seconds, on the simulation clock of the drone: strictly increasing, by exactly one substep per substep, so that
+		// fixed rate streams can be indexed by time
+		double time = 0.0;
+
+		// In seconds, the world time the substep maps to
+		double world_time = 0.0;
+
+		FRigidTransform transform_world;
+
+		// In m/s
+		FVector3 linear_velocity_world = FVector3::zero();
+
+		// In rad/s
+		FVector3 angular_velocity_radians_world = FVector3::zero();
+
+		FDronePlayerInput player_input;
+
+		bool has_propulsion = false;
+
+		std::array<FTelemetryRotorValues, telemetry_rotor_count> rotors = {};
+	};
+
+	// Quantized rotor, see the resolutions in TelemetrySample.cpp
+	struct FTelemetryRotor
+	{
+		std::uint16_t throttle = 0;
+		std::uint16_t angular_speed = 0;
+		std::int16_t thrust = 0;
+		std::int16_t torque = 0;
+		std::int16_t angle_of_attack = 0;
+		std::uint16_t min_reynolds = 0;
+		std::uint16_t max_reynolds = 0;
+		std::int16_t velocity_axial = 0;
+		std::int16_t velocity_induced = 0;
+	};
+
+	/**
+	 * One recorded substep of one drone, as stored by the recorder: two cache lines, no heap, trivially copyable, so that
+	 * samples can be copied, queued and written as raw bytes. The location keeps floats, the other channels are
+	 * quantized to fixed steps well below what the sensors and the displays resolve, and saturate out of their range.
+	 *
+	 * The debug strings and the Reynolds number of each blade element are not part of it, the recorder keeps them in an
+	 * optional side stream.
+	 */
+	struct alignas(64) FTelemetrySample
+	{
+		// In seconds, on the simulation clock of the drone, see FTelemetryValues
+		double time = 0.0;
+
+		// World time minus time, in seconds. Mostly constant, it only moves when the simulation falls behind the world.
+		float world_time_offset = 0.0f;
+
+		// In unreal units
+		std::array<float, 3> location = {};
+
+		// Unit quaternion X, Y, Z, W, times 32767
+		std::array<std::int16_t, 4> rotation = {};
+
+		std::array<std::int16_t, 3> linear_velocity = {};
+
+		std::array<std::int16_t, 3> angular_velocity = {};
+
+		// Throttle, yaw, pitch, roll
+		std::array<std::int16_t, 4> player_input = {};
+
+		std::uint8_t has_propulsion = 0;
+
+		std::array<FTelemetryRotor, telemetry_rotor_count> rotors = {};
+	};
+
+	static_assert(sizeof(FTelemetrySample) == 128, "Two cache lines");
+	static_assert(std::is_trivially_copyable_v<FTelemetrySample>);
+}
+
+namespace physics::telemetry
+{
+	DRONESIMULATORPHYSICS_API FTelemetrySample encode(const FTelemetryValues& values);
+
+	DRONESIMULATORPHYSICS_API FTelemetryValues decode(const FTelemetrySample& sample);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace physics
+{
+	/**
+	 * Hands the latest value from one writer thread to one reader thread. Both sides are wait-free: publishing and
+	 * reading are a single atomic exchange, neither side ever waits for the other, and the reader always sees a whole
+	 * value, never one the writer is in the middle of.
+	 *
+	 * The writer owns one slot and the reader another. The third slot holds the last published value: publish swaps it
+	 * with the writer slot, read swaps it with the reader slot if it is newer. Values that are published faster than they
+	 * are read are dropped, only the latest is kept.
+	 */
+	template <typename T>
+	class TTripleBuffer
+	{
+	public:
+
+		// Writer side: the slot to fill before publish. It keeps whatever value was in it, not the last published one.
+		T& get_write_slot()
+		{
+			return this->slots[this->write_index].value;
+		}
+
+		void publish()
+		{
+			const auto previous_state = this->shared_state.exchange(static_cast<std::uint8_t>(this->write_index | new_value_flag),
+				std::memory_order_acq_rel);
+			this->write_index = previous_state & index_mask;
+		}
+
+		void publish(const T& value)
+		{
+			this->get_write_slot() = value;
+			this->publish();
+		}
+
+		// Reader side: whether a value was published since the last read
+		bool has_new_value() const
+		{
+			return (this->shared_state.load(std::memory_order_acquire) & new_value_flag) != 0;
+		}
+
+		// Reader side: the latest published value, or the value read last if nothing was published since. Default
+		// constructed until the first publish.
+		const T& read()
+		{
+			if (this->has_new_value())
+			{
+				const auto previous_state = this->shared_state.exchange(static_cast<std::uint8_t>(this->read_index),
+					std::memory_order_acq_rel);
+				this->read_index = previous_state & index_mask;
+			}
+
+			return this->slots[this->read_index].value;
+		}
+
+	private:
+
+		static constexpr std::uint8_t index_mask = 0x3;
+		static constexpr std::uint8_t new_value_flag = 0x4;
+
+		// One cache line per slot, so that the writer filling its slot doesn't slow down the reader reading its own
+		struct alignas(64) FSlot
+		{
+			T value {};
+		};
+
+		std::array<FSlot, 3> slots;
+
+		// Index of the slot between the two threads, with new_value_flag when it holds a value not read yet
+		alignas(64) std::atomic<std::uint8_t> shared_state { 1 };
+
+		// Only touched by the writer
+		alignas(64) std::uint8_t write_index = 0;
+
+		// Only touched by the reader
+		alignas(64) std::uint8_t read_index = 2;
+	};
+}